@@ -277,3 +277,25 @@ func createTestSongWithTracks() *AHXFile {
 
 	return song
 }
+
+// BenchmarkAHXWaveBank_Generate benchmarks building the shared filtered bank
+func BenchmarkAHXWaveBank_Generate(b *testing.B) {
+	for range b.N {
+		_ = newAHXWaveBank()
+	}
+}
+
+// BenchmarkAHXEngine_WaveBankRender renders one second of wave-bank audio
+// per op in 512-sample blocks and reports the share of one core it takes.
+func BenchmarkAHXEngine_WaveBankRender(b *testing.B) {
+	engine := newWaveBankTestEngine(b)
+	buf := make([]float32, 512)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for range b.N {
+		for range SAMPLE_RATE / len(buf) {
+			engine.RenderMixBlock(buf)
+		}
+	}
+	b.ReportMetric(float64(b.Elapsed())/float64(b.N)/1e9*100, "%core")
+}
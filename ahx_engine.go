@@ -3,10 +3,14 @@
 package main
 
 import (
+	"math"
 	"sync"
 	"sync/atomic"
 )
 
+// ahxBankScale maps four full-volume voices at full scale to ±1.0.
+const ahxBankScale = 1.0 / (4 * 128 * 64)
+
 // AHXEngine manages AHX playback through the SoundChip
 type AHXEngine struct {
 	mutex      sync.Mutex
@@ -25,6 +29,12 @@ type AHXEngine struct {
 	enabled        atomic.Bool
 	channelsInit   bool
 	ahxPlusEnabled bool
+
+	// Wave-bank mode renders the voices from ahxWaveBank itself instead of
+	// driving flex channels.
+	waveBank   bool
+	bankVoices [4]ahxBankVoice
+	wnRandom   uint32
 }
 
 // NewAHXEngine creates a new AHX engine
@@ -106,7 +116,13 @@ func (e *AHXEngine) TickSample() {
 
 	e.mutex.Lock()
 	defer e.mutex.Unlock()
+	e.tickLocked()
+}
 
+func (e *AHXEngine) tickLocked() {
+	if !e.enabled.Load() || !e.playing.Load() {
+		return
+	}
 	if e.tickRateHz > 0 && e.sampleRate > 0 {
 		e.tickAccumulator += e.tickRateHz
 	}
@@ -128,6 +144,110 @@ func (e *AHXEngine) TickSample() {
 	}
 }
 
+// quietTicksLocked returns how many tickLocked calls can pass before the
+// next one runs PlayIRQ.
+func (e *AHXEngine) quietTicksLocked() int {
+	if !e.enabled.Load() || !e.playing.Load() {
+		return math.MaxInt
+	}
+	if e.sampleRate <= e.tickAccumulator {
+		return 0
+	}
+	if e.tickRateHz <= 0 {
+		return math.MaxInt
+	}
+	return (e.sampleRate - e.tickAccumulator - 1) / e.tickRateHz
+}
+
+// MixSample implements SampleMixer for wave-bank mode: one sample of the four
+// bank voices. It returns silence when the engine drives flex channels.
+func (e *AHXEngine) MixSample() float32 {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+	var out [1]float32
+	e.renderBankLocked(out[:])
+	return out[0]
+}
+
+// RenderMixBlock implements SampleBlockRenderer. Between replayer ticks the
+// voice state is fixed, so each tick's span renders voice by voice straight
+// from the bank buffers.
+func (e *AHXEngine) RenderMixBlock(out []float32) {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+	for i := 0; i < len(out); {
+		e.tickLocked()
+		run := 1 + min(len(out)-i-1, e.quietTicksLocked())
+		if n := run - 1; n > 0 && e.enabled.Load() && e.playing.Load() {
+			e.tickAccumulator += e.tickRateHz * n
+			e.currentSample += uint64(n)
+		}
+		span := out[i : i+run]
+		clear(span)
+		e.renderBankLocked(span)
+		i += run
+	}
+}
+
+func (e *AHXEngine) renderBankLocked(out []float32) {
+	if !e.waveBank {
+		return
+	}
+	for i := range e.bankVoices {
+		e.bankVoices[i].render(out, ahxBankScale)
+	}
+}
+
+// SetWaveBankSynthesis switches between classic wave-bank rendering and the
+// default native flex-channel mapping. In wave-bank mode the engine registers
+// itself as the "ahx" sample mixer and leaves the flex channels alone.
+func (e *AHXEngine) SetWaveBankSynthesis(on bool) {
+	e.mutex.Lock()
+	if e.waveBank == on {
+		e.mutex.Unlock()
+		return
+	}
+	if on {
+		e.silenceChannels()
+		e.bankVoices = [4]ahxBankVoice{}
+		e.wnRandom = 0
+	}
+	e.waveBank = on
+	e.channelsInit = false
+	e.mutex.Unlock()
+	if e.sound == nil {
+		return
+	}
+	if on {
+		e.sound.RegisterSampleMixer("ahx", e)
+	} else {
+		e.sound.UnregisterSampleMixer("ahx")
+	}
+}
+
+// WaveBankSynthesis reports whether wave-bank rendering is selected.
+func (e *AHXEngine) WaveBankSynthesis() bool {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+	return e.waveBank
+}
+
+// updateBankVoices loads each voice's bank waveform, pitch and volume after
+// a replayer tick.
+func (e *AHXEngine) updateBankVoices() {
+	bank := ahxWaveBank()
+	for i := range e.bankVoices {
+		voice := &e.replayer.Voices[i]
+		bv := &e.bankVoices[i]
+		bv.load(bank, voice, &e.wnRandom)
+		bv.volume = min(max(voice.VoiceVolume, 0), 64)
+		bv.delta = 0
+		if voice.VoicePeriod > 0 && e.sampleRate > 0 {
+			bv.delta = uint32(AHXPeriod2Freq(voice.VoicePeriod) * 65536 / float64(e.sampleRate))
+		}
+	}
+}
+
 // ensureChannelsInitialized sets up SoundChip channels
 func (e *AHXEngine) ensureChannelsInitialized() {
 	if e.channelsInit || e.sound == nil {
@@ -153,6 +273,10 @@ func (e *AHXEngine) ensureChannelsInitialized() {
 
 // updateChannels transfers voice state to SoundChip
 func (e *AHXEngine) updateChannels() {
+	if e.waveBank {
+		e.updateBankVoices()
+		return
+	}
 	if e.sound == nil {
 		return
 	}
@@ -244,6 +368,12 @@ func (e *AHXEngine) writeChannel(ch int, offset uint32, value uint32) {
 
 // silenceChannels mutes all AHX channels
 func (e *AHXEngine) silenceChannels() {
+	if e.waveBank {
+		for i := range e.bankVoices {
+			e.bankVoices[i].volume = 0
+		}
+		return
+	}
 	if e.sound == nil {
 		return
 	}
@@ -237,3 +237,66 @@ func TestAHXEngine_ChannelMapping(t *testing.T) {
 		}
 	}
 }
+
+func newWaveBankTestEngine(t testing.TB) *AHXEngine {
+	t.Helper()
+	engine := NewAHXEngine(nil, SAMPLE_RATE)
+	if err := engine.LoadSong(createTestSongWithTracks(), 0); err != nil {
+		t.Fatalf("LoadSong failed: %v", err)
+	}
+	engine.SetLoop(true)
+	engine.SetWaveBankSynthesis(true)
+	engine.SetPlaying(true)
+	return engine
+}
+
+// TestAHXEngine_WaveBankBlockMatchesPerSample checks that tick-span block
+// rendering equals TickSample+MixSample per sample.
+func TestAHXEngine_WaveBankBlockMatchesPerSample(t *testing.T) {
+	ref := newWaveBankTestEngine(t)
+	want := make([]float32, SAMPLE_RATE/2)
+	nonZero := false
+	for i := range want {
+		ref.TickSample()
+		want[i] = ref.MixSample()
+		nonZero = nonZero || want[i] != 0
+	}
+	if !nonZero {
+		t.Fatal("wave-bank engine rendered silence")
+	}
+
+	engine := newWaveBankTestEngine(t)
+	got := make([]float32, len(want))
+	for i := 0; i < len(got); {
+		n := min(len(got)-i, 700)
+		engine.RenderMixBlock(got[i : i+n])
+		i += n
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("sample %d = %v, want %v", i, got[i], want[i])
+		}
+	}
+}
+
+// TestAHXEngine_WaveBankMixerRegistration checks the engine only mixes on the
+// chip while wave-bank mode is on.
+func TestAHXEngine_WaveBankMixerRegistration(t *testing.T) {
+	sound, err := NewSoundChip(AUDIO_BACKEND_NULL)
+	if err != nil {
+		t.Fatal(err)
+	}
+	engine := NewAHXEngine(sound, SAMPLE_RATE)
+	registered := func() bool {
+		h, _ := sound.sampleMixer.Load().(*sampleMixerListHolder)
+		return h != nil && h.has(engine)
+	}
+	engine.SetWaveBankSynthesis(true)
+	if !registered() {
+		t.Fatal("wave-bank engine not registered as a block mixer")
+	}
+	engine.SetWaveBankSynthesis(false)
+	if registered() {
+		t.Fatal("engine still registered after leaving wave-bank mode")
+	}
+}
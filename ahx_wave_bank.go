@@ -0,0 +1,224 @@
+// ahx_wave_bank.go - Shared AHX filtered waveform bank and bank voices
+
+/*
+Classic AHX plays every voice from a 0x280-byte Paula buffer filled from a
+bank of pre-filtered waveforms: 31 low-pass sets, the unfiltered set and 31
+high-pass sets, each holding the triangle and sawtooth at all six lengths,
+the 32 square pulse widths and 0x780 bytes of white noise. A voice's
+FilterPos (1-63, 32 neutral) picks the set.
+
+The bank is generated once per process on first use (about 400 KiB) and
+shared read-only by every AHXEngine, so loading another module costs
+nothing. In wave-bank mode the engine renders its four voices straight from
+the bank instead of driving flex channels; see AHXEngine.SetWaveBankSynthesis.
+*/
+
+package main
+
+import "sync"
+
+const (
+	ahxBankTriangle  = 0
+	ahxBankSawtooth  = 0xfc
+	ahxBankSquares   = 0xfc + 0xfc
+	ahxBankNoise     = ahxBankSquares + 0x80*0x20
+	ahxBankSetLen    = ahxBankNoise + 0x280*3
+	ahxBankFilterSet = 31 // low-pass sets before the unfiltered set
+	ahxBankSets      = ahxBankFilterSet*2 + 1
+
+	ahxVoiceBufLen = 0x280
+)
+
+// ahxWaveOffsets locates each WaveLength (0-5) within a triangle or sawtooth
+// section.
+var ahxWaveOffsets = [6]int{0x00, 0x04, 0x04 + 0x08, 0x04 + 0x08 + 0x10, 0x04 + 0x08 + 0x10 + 0x20, 0x04 + 0x08 + 0x10 + 0x20 + 0x40}
+
+// AHXWaveBank holds all filter sets back to back, indexed by FilterPos-1.
+type AHXWaveBank struct {
+	data [ahxBankSets * ahxBankSetLen]int8
+}
+
+// ahxWaveBank returns the process-wide bank, generating it on first use.
+var ahxWaveBank = sync.OnceValue(newAHXWaveBank)
+
+func newAHXWaveBank() *AHXWaveBank {
+	b := &AHXWaveBank{}
+	plain := b.set(ahxBankFilterSet + 1)
+
+	w := NewAHXWaves()
+	for i, src := range [][]int8{w.Triangle04[:], w.Triangle08[:], w.Triangle10[:], w.Triangle20[:], w.Triangle40[:], w.Triangle80[:]} {
+		copy(plain[ahxBankTriangle+ahxWaveOffsets[i]:], src)
+	}
+	for i, src := range [][]int8{w.Sawtooth04[:], w.Sawtooth08[:], w.Sawtooth10[:], w.Sawtooth20[:], w.Sawtooth40[:], w.Sawtooth80[:]} {
+		copy(plain[ahxBankSawtooth+ahxWaveOffsets[i]:], src)
+	}
+	generateAHXSquares(plain[ahxBankSquares:ahxBankNoise])
+	generateAHXWhiteNoise(plain[ahxBankNoise:ahxBankSetLen])
+	b.generateFilterSets(plain)
+	return b
+}
+
+// set returns the waveforms for FilterPos pos (1-63).
+func (b *AHXWaveBank) set(pos int) []int8 {
+	i := min(max(pos, 1), ahxBankSets) - 1
+	return b.data[i*ahxBankSetLen : (i+1)*ahxBankSetLen]
+}
+
+// generateAHXSquares writes the 32 pulse widths, 0x80 bytes each.
+func generateAHXSquares(buf []int8) {
+	pos := 0
+	for i := 1; i <= 0x20; i++ {
+		for range (0x40 - i) * 2 {
+			buf[pos] = -128
+			pos++
+		}
+		for range i * 2 {
+			buf[pos] = 127
+			pos++
+		}
+	}
+}
+
+// generateAHXWhiteNoise reproduces the replayer's noise generator (seed
+// "AYS!"): clipped to full scale whenever bit 8 of the state is set.
+func generateAHXWhiteNoise(buf []int8) {
+	ays := uint32(0x41595321)
+	for i := range buf {
+		s := int8(ays)
+		if ays&0x100 != 0 {
+			s = -128
+			if ays&0x8000 == 0 {
+				s = 127
+			}
+		}
+		buf[i] = s
+
+		ays = ays>>5 | ays<<27
+		ays = ays&0xffffff00 | (ays&0xff ^ 0x9a)
+		bx := uint16(ays)
+		ays = ays<<2 | ays>>30
+		ax := uint16(ays)
+		bx += ax
+		ax ^= bx
+		ays = ays&0xffff0000 | uint32(ax)
+		ays = ays>>3 | ays<<29
+	}
+}
+
+// generateFilterSets runs the unfiltered set through the replayer's
+// state-variable filter at 31 cutoffs. Each waveform is filtered twice and
+// only the second (settled) pass is kept, so the tables loop cleanly.
+func (b *AHXWaveBank) generateFilterSets(plain []int8) {
+	clip := func(x float64) float64 { return min(max(x, -128), 127) }
+	var lens []int
+	for range 2 {
+		lens = append(lens, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80)
+	}
+	for range 0x20 {
+		lens = append(lens, 0x80)
+	}
+	lens = append(lens, 0x280*3)
+
+	freq := 8.0
+	for set := range ahxBankFilterSet {
+		low := b.set(set + 1)
+		high := b.set(ahxBankFilterSet + 2 + set)
+		fre := freq * 1.25 / 100
+		at := 0
+		for _, n := range lens {
+			src := plain[at : at+n]
+			var hi, mid, lo float64
+			for _, v := range src {
+				hi = clip(float64(v) - mid - lo)
+				mid = clip(mid + hi*fre)
+				lo = clip(lo + mid*fre)
+			}
+			for i, v := range src {
+				hi = clip(float64(v) - mid - lo)
+				mid = clip(mid + hi*fre)
+				lo = clip(lo + mid*fre)
+				low[at+i] = int8(lo)
+				high[at+i] = int8(hi)
+			}
+			at += n
+		}
+		freq += 3
+	}
+}
+
+// ahxBankVoice is one voice's Paula-style output state in wave-bank mode.
+type ahxBankVoice struct {
+	buf    [ahxVoiceBufLen]int8
+	pos    uint32 // 16.16 position in buf
+	delta  uint32
+	volume int // 0-64
+	key    ahxBankKey
+	valid  bool
+}
+
+// ahxBankKey identifies the waveform a voice buffer was built from.
+type ahxBankKey struct {
+	waveform, waveLength, filterPos, squarePos int
+}
+
+// load refills the voice buffer from the bank when the voice's waveform
+// changed. Noise refills every tick at a fresh random offset, as in AHX.
+func (bv *ahxBankVoice) load(bank *AHXWaveBank, v *AHXVoice, rnd *uint32) {
+	key := ahxBankKey{v.Waveform, min(max(v.WaveLength, 0), 5), v.FilterPos, v.SquarePos}
+	if bv.valid && key == bv.key && key.waveform != 3 {
+		return
+	}
+	bv.key, bv.valid = key, true
+	set := bank.set(key.filterPos)
+	waveLen := 4 << key.waveLength
+
+	switch key.waveform {
+	case 0, 1:
+		base := ahxBankTriangle
+		if key.waveform == 1 {
+			base = ahxBankSawtooth
+		}
+		src := set[base+ahxWaveOffsets[key.waveLength]:][:waveLen]
+		for i := 0; i < ahxVoiceBufLen; i += waveLen {
+			copy(bv.buf[i:], src)
+		}
+	case 2:
+		x := key.squarePos << (5 - key.waveLength)
+		if x > 0x20 {
+			x = 0x40 - x
+		}
+		x = min(max(x, 1), 0x20)
+		src := set[ahxBankSquares+(x-1)<<7:][:0x80]
+		step := 32 >> key.waveLength
+		for i := range waveLen {
+			bv.buf[i] = src[i*step]
+		}
+		for i := waveLen; i < ahxVoiceBufLen; i += waveLen {
+			copy(bv.buf[i:i+waveLen], bv.buf[:waveLen])
+		}
+	default:
+		off := int(*rnd&(2*ahxVoiceBufLen-1)) &^ 1
+		copy(bv.buf[:], set[ahxBankNoise+off:])
+		*rnd += 2239384
+		*rnd = ((*rnd>>8 | *rnd<<24) + 782323 ^ 75) - 6735
+	}
+}
+
+// render adds len(out) samples of the voice to out at gain per unit of
+// volume. MixSample and RenderMixBlock both go through here so their output
+// is identical.
+func (bv *ahxBankVoice) render(out []float32, scale float32) {
+	if bv.volume == 0 {
+		return
+	}
+	gain := float32(bv.volume) * scale
+	pos, delta := bv.pos, bv.delta
+	const end = ahxVoiceBufLen << 16
+	for i := range out {
+		out[i] += float32(bv.buf[pos>>16]) * gain
+		if pos += delta; pos >= end {
+			pos %= end
+		}
+	}
+	bv.pos = pos
+}
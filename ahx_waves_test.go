@@ -155,3 +155,43 @@ func TestPeriodTable(t *testing.T) {
 		t.Errorf("PeriodTable[60]: expected 0x0071, got 0x%04X", AHXPeriodTable[60])
 	}
 }
+
+// TestAHXWaveBank_Layout checks the unfiltered set against the base tables
+// and that the filter sets actually filter.
+func TestAHXWaveBank_Layout(t *testing.T) {
+	bank := ahxWaveBank()
+	if ahxWaveBank() != bank {
+		t.Fatal("wave bank is not shared")
+	}
+	waves := NewAHXWaves()
+	plain := bank.set(32)
+	for i, v := range waves.Triangle80 {
+		if plain[ahxBankTriangle+ahxWaveOffsets[5]+i] != v {
+			t.Fatalf("unfiltered Triangle80[%d] = %d, want %d", i, plain[ahxBankTriangle+ahxWaveOffsets[5]+i], v)
+		}
+	}
+	for i, v := range waves.Sawtooth10 {
+		if plain[ahxBankSawtooth+ahxWaveOffsets[2]+i] != v {
+			t.Fatalf("unfiltered Sawtooth10[%d] = %d, want %d", i, plain[ahxBankSawtooth+ahxWaveOffsets[2]+i], v)
+		}
+	}
+	// Pulse width 1: 0x7e low bytes then 2 high bytes.
+	if plain[ahxBankSquares+0x7d] != -128 || plain[ahxBankSquares+0x7e] != 127 {
+		t.Fatal("square 1 has the wrong duty cycle")
+	}
+
+	energy := func(set []int8) (e int) {
+		saw := set[ahxBankSawtooth+ahxWaveOffsets[5]:][:0x80]
+		for i := 1; i < len(saw); i++ {
+			d := int(saw[i]) - int(saw[i-1])
+			e += d * d
+		}
+		return e
+	}
+	if lp, flat := energy(bank.set(1)), energy(plain); lp >= flat {
+		t.Fatalf("darkest low-pass sawtooth edge energy %d not below unfiltered %d", lp, flat)
+	}
+	if hp, flat := energy(bank.set(63)), energy(plain); hp == flat {
+		t.Fatal("high-pass set equals unfiltered set")
+	}
+}
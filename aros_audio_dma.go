@@ -56,6 +56,13 @@ type arosAudDMACh struct {
 	active  bool    // DMA running
 }
 
+// arosAudDAC is a pending DAC handoff collected during one TickSample.
+type arosAudDAC struct {
+	sample float32
+	vol    uint32
+	set    bool
+}
+
 // NewArosAudioDMA creates a DMA engine wired to the given bus, SoundChip,
 // and M68K CPU. Call MapIO afterwards to register the MMIO handlers.
 func NewArosAudioDMA(bus *MachineBus, sc *SoundChip, cpu *M68KCPU) (*ArosAudioDMA, error) {
@@ -127,6 +134,7 @@ func (dma *ArosAudioDMA) TickSample() {
 	}
 
 	var assertIRQ bool
+	var dac [4]arosAudDAC
 	dma.mu.Lock()
 	for ch := range 4 {
 		if dma.dmacon&(1<<ch) == 0 {
@@ -189,17 +197,18 @@ func (dma *ArosAudioDMA) TickSample() {
 				// above the legacy slice; bus.Read8 would zero-fill them.
 				sample = dma.bus.ReadPhys8(uint64(addr))
 			}
-			dma.setFlexDACLocked(ch, float32(int8(sample))/128.0, c.lvol)
+			dac[ch] = arosAudDAC{sample: float32(int8(sample)) / 128.0, vol: c.lvol, set: true}
 		} else {
 			c.active = false
 			dma.dmacon &^= 1 << ch
 			dma.status |= 1 << ch
-			dma.setFlexDACLocked(ch, 0, c.lvol)
+			dac[ch] = arosAudDAC{vol: c.lvol, set: true}
 			if dma.intena&(1<<ch) != 0 {
 				assertIRQ = true
 			}
 		}
 	}
+	dma.flushDACsLocked(&dac)
 	dma.enabled.Store(dma.dmacon != 0)
 	cpu := dma.cpu
 	dma.mu.Unlock()
@@ -357,13 +366,40 @@ func (dma *ArosAudioDMA) HandleWrite(addr, value uint32) {
 	}
 }
 
+// flushDACsLocked hands the collected per-channel samples to the flex DACs
+// under a single SoundChip lock.
+func (dma *ArosAudioDMA) flushDACsLocked(dac *[4]arosAudDAC) {
+	if dma.soundChip == nil {
+		return
+	}
+	locked := false
+	for ch := range dac {
+		if !dac[ch].set || ch >= len(dma.soundChip.channels) {
+			continue
+		}
+		if !locked {
+			dma.soundChip.mu.Lock()
+			locked = true
+		}
+		applyArosFlexDAC(dma.soundChip.channels[ch], dac[ch].sample, dac[ch].vol)
+	}
+	if locked {
+		dma.soundChip.mu.Unlock()
+	}
+}
+
 func (dma *ArosAudioDMA) setFlexDACLocked(ch int, sample float32, vol uint32) {
 	if dma.soundChip == nil || ch < 0 || ch >= len(dma.soundChip.channels) {
 		return
 	}
 	dma.soundChip.mu.Lock()
 	defer dma.soundChip.mu.Unlock()
-	flexCh := dma.soundChip.channels[ch]
+	applyArosFlexDAC(dma.soundChip.channels[ch], sample, vol)
+}
+
+// applyArosFlexDAC gates a flex channel into DAC mode with a Paula volume.
+// Caller holds SoundChip.mu.
+func applyArosFlexDAC(flexCh *Channel, sample float32, vol uint32) {
 	if flexCh == nil {
 		return
 	}
@@ -8,5 +8,9 @@ func init() {
 	compiledFeatures = append(compiledFeatures, "aros:embedded")
 }
 
-//go:embed sdk/roms/aros-ie-m68k.rom
+// The ROM is linked in gzip-compressed and unpacked through the asset
+// cache on first use (asset_store.go); "make packed-roms" writes the
+// .gz alongside the image.
+//
+//go:embed sdk/roms/aros-ie-m68k.rom.gz
 var embeddedAROSImage []byte
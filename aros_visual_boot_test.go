@@ -5,6 +5,7 @@ package main
 import (
 	"context"
 	"fmt"
+	"hash/fnv"
 	"os"
 	"path/filepath"
 	"testing"
@@ -34,6 +35,12 @@ func collectFrameStats(frame []byte) frameStats {
 	return stats
 }
 
+func frameHash(frame []byte) uint32 {
+	h := fnv.New32a()
+	_, _ = h.Write(frame)
+	return h.Sum32()
+}
+
 func requireAROSDriveRoot(t *testing.T) string {
 	t.Helper()
 
@@ -37,9 +37,13 @@ Registers: r0-r31 (sp = r31)
 Assembler Syntax (68K-flavored, case-insensitive mnemonics/registers/directives):
 
   CLI:
-    ie64asm [-v] [-list] [-I dir]... [-D NAME[=VALUE]]... input.asm
+    ie64asm [-v] [-list] [-j N] [-incremental] [-I dir]... [-D NAME[=VALUE]]... input.asm...
     -D injects a predefined equate before assembly. `-D FEATURE` means
        FEATURE=1; `-D NAME=0x10` sets an explicit value.
+    Several inputs assemble in parallel (-j N workers, default one per
+       CPU) sharing preprocessed includes; -list then writes <output>.lst.
+    -incremental skips inputs whose source, includes, incbins and options
+       are unchanged since the <output>.ie64dep record was written.
 
   Directives:
     org $addr             - set origin
@@ -160,6 +164,8 @@ type IE64Assembler struct {
 	directiveSawUnresolved bool
 	incbinCache            map[string][]byte
 	written                map[uint32]int
+	includeCache           *ie64IncludeCache // shared across a batch; nil for single files
+	deps                   map[string]bool   // absolute paths of includes and incbins read
 	// internal state for assembly
 	codeOffset   uint32
 	pass         int
@@ -1105,12 +1111,7 @@ func (a *IE64Assembler) preprocess(source string, basePath string, included map[
 				continue
 			}
 			included[absPath] = true
-			data, err := os.ReadFile(includePath)
-			if err != nil {
-				delete(included, absPath)
-				return nil, fmt.Errorf("line %d: failed to include %s: %v", i+1, includePath, err)
-			}
-			subLines, err := a.preprocess(string(data), filepath.Dir(includePath), included)
+			subLines, err := a.preprocessInclude(i+1, includePath, absPath, included)
 			delete(included, absPath)
 			if err != nil {
 				return nil, err
@@ -1788,6 +1789,7 @@ func (a *IE64Assembler) calcIncbinSize(line string) (uint32, error) {
 
 func (a *IE64Assembler) readIncbin(path string) ([]byte, error) {
 	abs, _ := filepath.Abs(path)
+	a.noteDependency(abs)
 	if data, ok := a.incbinCache[abs]; ok {
 		if a.pass == 1 {
 			current, err := os.ReadFile(path)
@@ -1959,6 +1961,7 @@ func (a *IE64Assembler) Assemble(source string) ([]byte, error) {
 	a.imageBaseSet = false
 	a.maxAddr = a.baseAddr
 	a.written = make(map[uint32]int)
+	a.deps = nil
 
 	// Pass 0: preprocessing
 	preprocessed, err := a.preprocess(source, a.basePath, nil)
@@ -3413,32 +3416,43 @@ func (a *IE64Assembler) resolveLabel(name string) (uint32, error) {
 // main
 // ---------------------------------------------------------------------
 
+const ie64asmUsage = "Usage: ie64asm [-v] [-list] [-o output] [-j N] [-incremental] [-Werror] [-Wno-category] [-I dir]... [-D NAME[=VALUE]]... input.asm...\n"
+
 func main() {
-	listMode := false
-	verbose := false
-	var inputFile string
-	var outFile string
-	var includePaths []string
-	asm := NewIE64Assembler()
+	var opts ie64BuildOptions
+	var inputFiles []string
 
 	args := os.Args[1:]
 	for i := 0; i < len(args); i++ {
 		arg := args[i]
 		if arg == "-list" {
-			listMode = true
+			opts.listMode = true
 		} else if arg == "-v" {
-			verbose = true
+			opts.verbose = true
+		} else if arg == "-incremental" {
+			opts.incremental = true
 		} else if arg == "-o" {
 			i++
 			if i >= len(args) {
 				fmt.Fprintf(os.Stderr, "Error: -o requires an output path\n")
 				os.Exit(1)
 			}
-			outFile = args[i]
+			opts.outFile = args[i]
+		} else if arg == "-j" {
+			i++
+			n := 0
+			if i < len(args) {
+				n, _ = strconv.Atoi(args[i])
+			}
+			if i >= len(args) || n < 0 {
+				fmt.Fprintf(os.Stderr, "Error: -j requires a worker count (0 = one per CPU)\n")
+				os.Exit(1)
+			}
+			opts.jobs = n
 		} else if arg == "-Werror" {
-			asm.warningPolicy.Werror = true
+			opts.policy.Werror = true
 		} else if strings.HasPrefix(arg, "-Wno-") {
-			asm.warningPolicy.Suppress(strings.TrimPrefix(arg, "-Wno-"))
+			opts.policy.Suppress(strings.TrimPrefix(arg, "-Wno-"))
 		} else if arg == "-D" {
 			i++
 			if i >= len(args) {
@@ -3450,88 +3464,43 @@ func main() {
 				fmt.Fprintf(os.Stderr, "Error: invalid -D value %q: %v\n", args[i], err)
 				os.Exit(1)
 			}
-			asm.Predefine(name, val)
+			opts.defines = append(opts.defines, ie64Define{name, val})
 		} else if strings.HasPrefix(arg, "-D") {
 			name, val, err := parseCommandLineDefine(arg[2:])
 			if err != nil {
 				fmt.Fprintf(os.Stderr, "Error: invalid -D value %q: %v\n", arg[2:], err)
 				os.Exit(1)
 			}
-			asm.Predefine(name, val)
+			opts.defines = append(opts.defines, ie64Define{name, val})
 		} else if arg == "-I" {
 			i++
 			if i >= len(args) {
 				fmt.Fprintf(os.Stderr, "Error: -I requires a directory argument\n")
 				os.Exit(1)
 			}
-			includePaths = append(includePaths, args[i])
+			opts.includePaths = append(opts.includePaths, args[i])
 		} else if strings.HasPrefix(arg, "-I") {
-			includePaths = append(includePaths, arg[2:])
+			opts.includePaths = append(opts.includePaths, arg[2:])
 		} else if strings.HasPrefix(arg, "-") {
 			fmt.Fprintf(os.Stderr, "Unknown option: %s\n", arg)
-			fmt.Fprintf(os.Stderr, "Usage: ie64asm [-v] [-list] [-o output] [-Werror] [-Wno-category] [-I dir]... [-D NAME[=VALUE]]... input.asm\n")
-			os.Exit(1)
-		} else if inputFile != "" {
-			fmt.Fprintf(os.Stderr, "Error: multiple input files specified\n")
-			fmt.Fprintf(os.Stderr, "Usage: ie64asm [-v] [-list] [-o output] [-Werror] [-Wno-category] [-I dir]... [-D NAME[=VALUE]]... input.asm\n")
+			fmt.Fprint(os.Stderr, ie64asmUsage)
 			os.Exit(1)
 		} else {
-			inputFile = arg
+			inputFiles = append(inputFiles, arg)
 		}
 	}
 
-	if inputFile == "" {
-		fmt.Fprintf(os.Stderr, "Usage: ie64asm [-v] [-list] [-o output] [-Werror] [-Wno-category] [-I dir]... [-D NAME[=VALUE]]... input.asm\n")
+	if len(inputFiles) == 0 {
+		fmt.Fprint(os.Stderr, ie64asmUsage)
 		os.Exit(1)
 	}
-
-	source, err := os.ReadFile(inputFile)
-	if err != nil {
-		fmt.Fprintf(os.Stderr, "Error reading input file: %v\n", err)
+	if len(inputFiles) > 1 && opts.outFile != "" {
+		fmt.Fprintf(os.Stderr, "Error: -o cannot be used with multiple input files\n")
+		fmt.Fprint(os.Stderr, ie64asmUsage)
 		os.Exit(1)
 	}
 
-	asm.basePath = filepath.Dir(inputFile)
-	asm.includePaths = includePaths
-	asm.verbose = verbose
-	asm.SetListingMode(listMode)
-
-	binary, err := asm.Assemble(string(source))
-	if err != nil {
-		fmt.Fprintf(os.Stderr, "Assembly error: %v\n", err)
-		os.Exit(1)
-	}
-
-	// Print warnings to stderr
-	for _, w := range asm.GetWarnings() {
-		fmt.Fprintf(os.Stderr, "Warning: %s\n", w)
-	}
-
-	// Print infos only in verbose mode
-	if verbose {
-		for _, info := range asm.GetInfos() {
-			fmt.Fprintf(os.Stderr, "Info: %s\n", info)
-		}
-	}
-
-	// Write output
-	if outFile == "" {
-		outFile = strings.TrimSuffix(inputFile, filepath.Ext(inputFile)) + ".ie64"
-	}
-	if err := os.WriteFile(outFile, binary, 0644); err != nil {
-		fmt.Fprintf(os.Stderr, "Error writing output file: %v\n", err)
-		os.Exit(1)
-	}
-
-	fmt.Printf("Successfully assembled to %s (%d bytes)\n", outFile, len(binary))
-
-	// Print listing if enabled
-	if listMode {
-		fmt.Println("\n--- Listing ---")
-		for _, line := range asm.GetListing() {
-			fmt.Println(line)
-		}
-	}
+	os.Exit(buildIE64Files(opts, inputFiles, os.Stdout, os.Stderr))
 }
 
 func parseCommandLineDefine(raw string) (string, uint64, error) {
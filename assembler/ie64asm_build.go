@@ -0,0 +1,478 @@
+// ie64asm_build.go - Multi-file, parallel and incremental ie64asm builds
+
+//go:build ie64
+
+/*
+Passing several inputs to ie64asm assembles them as one batch:
+
+  - Each source gets its own IE64Assembler on a worker goroutine (-j N,
+    default one per CPU). Results are reported in input order.
+  - The batch shares an ie64IncludeCache. A preprocessed include (its
+    flattened lines plus the macros it defines) is reused by every source
+    that includes the same file in the same context: identical -D
+    predefines and identical macros in scope at the include site. The
+    common `include "ie64.inc"` at the top of a source therefore parses
+    once per batch instead of once per source.
+  - With -list, each listing is written to <output>.lst instead of stdout.
+
+-incremental keeps a <output>.ie64dep record beside each output holding a
+hash of the options, the source, and every include and incbin the source
+read. A later build whose record still matches skips the source entirely
+and replays its warnings (and listing). Missing or unparsable records just
+rebuild.
+*/
+
+package main
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"runtime"
+	"sort"
+	"strings"
+	"sync"
+)
+
+const ie64DepRecordVersion = 1
+
+// ie64Define is one -D predefine.
+type ie64Define struct {
+	name string
+	val  uint64
+}
+
+// ie64BuildOptions are the command-line options shared by every input.
+type ie64BuildOptions struct {
+	listMode     bool
+	verbose      bool
+	outFile      string
+	includePaths []string
+	defines      []ie64Define
+	policy       WarningPolicy
+	jobs         int
+	incremental  bool
+}
+
+// ---------------------------------------------------------------------
+// Shared include cache
+// ---------------------------------------------------------------------
+
+type ie64IncludeKey struct {
+	path    string
+	context [sha256.Size]byte // predefines and macros in scope
+}
+
+type ie64IncludeEntry struct {
+	lines  []string
+	macros []*Macro // macros the include defined, in definition order
+	deps   []string // absolute paths of every file in the include tree
+}
+
+// ie64IncludeCache holds preprocessed includes for one batch. Entries are
+// immutable once stored, so assemblers on any goroutine may share them.
+type ie64IncludeCache struct {
+	mu      sync.Mutex
+	entries map[ie64IncludeKey]*ie64IncludeEntry
+	hits    int
+}
+
+func newIE64IncludeCache() *ie64IncludeCache {
+	return &ie64IncludeCache{entries: make(map[ie64IncludeKey]*ie64IncludeEntry)}
+}
+
+// includeContext fingerprints the assembler state that preprocessing an
+// include can observe: equates and sets (for if/rept) and defined macros.
+func (a *IE64Assembler) includeContext() [sha256.Size]byte {
+	h := sha256.New()
+	for _, m := range []map[string]uint64{a.equates, a.sets} {
+		names := make([]string, 0, len(m))
+		for name := range m {
+			names = append(names, name)
+		}
+		sort.Strings(names)
+		for _, name := range names {
+			fmt.Fprintf(h, "%s=%d\x00", name, m[name])
+		}
+		h.Write([]byte{1})
+	}
+	names := make([]string, 0, len(a.macros))
+	for name := range a.macros {
+		names = append(names, name)
+	}
+	sort.Strings(names)
+	for _, name := range names {
+		m := a.macros[name]
+		fmt.Fprintf(h, "%s/%d\x00%s\x01", name, m.params, strings.Join(m.body, "\n"))
+	}
+	var sum [sha256.Size]byte
+	h.Sum(sum[:0])
+	return sum
+}
+
+// noteDependency records a file the current assembly read.
+func (a *IE64Assembler) noteDependency(path string) {
+	abs, err := filepath.Abs(path)
+	if err != nil {
+		abs = path
+	}
+	if a.deps == nil {
+		a.deps = make(map[string]bool)
+	}
+	a.deps[abs] = true
+}
+
+// Dependencies returns the absolute paths of every include and incbin file
+// read by the last Assemble, sorted.
+func (a *IE64Assembler) Dependencies() []string {
+	out := make([]string, 0, len(a.deps))
+	for path := range a.deps {
+		out = append(out, path)
+	}
+	sort.Strings(out)
+	return out
+}
+
+// preprocessInclude reads and preprocesses one include, going through the
+// shared include cache when the assembler has one. The cached result is
+// only reused when no file of its tree is already being included, so
+// circular-include handling is unchanged.
+func (a *IE64Assembler) preprocessInclude(line int, includePath, absPath string, included map[string]bool) ([]string, error) {
+	var key ie64IncludeKey
+	if a.includeCache != nil {
+		key = ie64IncludeKey{path: absPath, context: a.includeContext()}
+		a.includeCache.mu.Lock()
+		e := a.includeCache.entries[key]
+		if e != nil && includesAny(included, e.deps, absPath) {
+			e = nil
+		}
+		if e != nil {
+			a.includeCache.hits++
+		}
+		a.includeCache.mu.Unlock()
+		if e != nil {
+			for _, m := range e.macros {
+				a.macros[m.name] = m
+			}
+			for _, dep := range e.deps {
+				a.noteDependency(dep)
+			}
+			return e.lines, nil
+		}
+	}
+
+	data, err := os.ReadFile(includePath)
+	if err != nil {
+		return nil, fmt.Errorf("line %d: failed to include %s: %v", line, includePath, err)
+	}
+	a.noteDependency(absPath)
+	if a.includeCache == nil {
+		return a.preprocess(string(data), filepath.Dir(includePath), included)
+	}
+
+	// Run the include against a fresh dependency set and macro-change log
+	// so the entry captures exactly what this include contributed.
+	outerDeps, outerMacros := a.deps, a.macros
+	a.deps = map[string]bool{absPath: true}
+	a.macros = make(map[string]*Macro, len(outerMacros))
+	for name, m := range outerMacros {
+		a.macros[name] = m
+	}
+	warningsBefore := len(a.warnings)
+	lines, err := a.preprocess(string(data), filepath.Dir(includePath), included)
+	subDeps, subMacros := a.deps, a.macros
+	a.deps, a.macros = outerDeps, outerMacros
+	entry := &ie64IncludeEntry{lines: lines}
+	for dep := range subDeps {
+		a.noteDependency(dep)
+		entry.deps = append(entry.deps, dep)
+	}
+	sort.Strings(entry.deps)
+	names := make([]string, 0, len(subMacros))
+	for name, m := range subMacros {
+		if outerMacros[name] != m {
+			names = append(names, name)
+		}
+	}
+	sort.Strings(names)
+	for _, name := range names {
+		a.macros[name] = subMacros[name]
+		entry.macros = append(entry.macros, subMacros[name])
+	}
+	if err != nil {
+		return nil, err
+	}
+	// An include that warned (a skipped circular include) depends on its
+	// includers, so it is not reusable.
+	if len(a.warnings) == warningsBefore {
+		a.includeCache.mu.Lock()
+		a.includeCache.entries[key] = entry
+		a.includeCache.mu.Unlock()
+	}
+	return lines, nil
+}
+
+func includesAny(included map[string]bool, paths []string, self string) bool {
+	for _, p := range paths {
+		if p != self && included[p] {
+			return true
+		}
+	}
+	return false
+}
+
+// ---------------------------------------------------------------------
+// Incremental build records
+// ---------------------------------------------------------------------
+
+// ie64DepRecord is the JSON stored in <output>.ie64dep.
+type ie64DepRecord struct {
+	Version  int               `json:"version"`
+	Options  string            `json:"options"`
+	Source   string            `json:"source"`
+	Size     int64             `json:"size"`
+	Deps     map[string]string `json:"deps"`
+	Warnings []string          `json:"warnings,omitempty"`
+	Infos    []string          `json:"infos,omitempty"`
+	Listing  []string          `json:"listing,omitempty"`
+}
+
+func hashBytes(data []byte) string {
+	sum := sha256.Sum256(data)
+	return hex.EncodeToString(sum[:])
+}
+
+func hashFile(path string) (string, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return "", err
+	}
+	return hashBytes(data), nil
+}
+
+// optionsFingerprint hashes every option that can change an output.
+func (o *ie64BuildOptions) optionsFingerprint(outFile string) string {
+	var b strings.Builder
+	fmt.Fprintf(&b, "out=%s\x00list=%v\x00werror=%v\x00", outFile, o.listMode, o.policy.Werror)
+	for _, dir := range o.includePaths {
+		abs, _ := filepath.Abs(dir)
+		fmt.Fprintf(&b, "I=%s\x00", abs)
+	}
+	for _, d := range o.defines {
+		fmt.Fprintf(&b, "D=%s=%d\x00", d.name, d.val)
+	}
+	suppressed := make([]string, 0, len(o.policy.suppressed))
+	for cat := range o.policy.suppressed {
+		suppressed = append(suppressed, cat)
+	}
+	sort.Strings(suppressed)
+	fmt.Fprintf(&b, "Wno=%s", strings.Join(suppressed, ","))
+	return hashBytes([]byte(b.String()))
+}
+
+func ie64DepPath(outFile string) string {
+	return outFile + ".ie64dep"
+}
+
+// upToDate returns the stored record when outFile is current for source.
+func upToDate(outFile, options string, source []byte) (*ie64DepRecord, bool) {
+	data, err := os.ReadFile(ie64DepPath(outFile))
+	if err != nil {
+		return nil, false
+	}
+	var rec ie64DepRecord
+	if json.Unmarshal(data, &rec) != nil || rec.Version != ie64DepRecordVersion ||
+		rec.Options != options || rec.Source != hashBytes(source) {
+		return nil, false
+	}
+	info, err := os.Stat(outFile)
+	if err != nil || info.Size() != rec.Size {
+		return nil, false
+	}
+	for path, want := range rec.Deps {
+		if got, err := hashFile(path); err != nil || got != want {
+			return nil, false
+		}
+	}
+	return &rec, true
+}
+
+func writeDepRecord(outFile string, rec *ie64DepRecord) error {
+	data, err := json.MarshalIndent(rec, "", "  ")
+	if err != nil {
+		return err
+	}
+	return os.WriteFile(ie64DepPath(outFile), append(data, '\n'), 0644)
+}
+
+// ---------------------------------------------------------------------
+// Batch driver
+// ---------------------------------------------------------------------
+
+// ie64BuildResult is the buffered output of one input.
+type ie64BuildResult struct {
+	stdout strings.Builder
+	stderr strings.Builder
+	failed bool
+}
+
+// buildIE64Files assembles every input and writes results in input order.
+// It returns the process exit status.
+func buildIE64Files(opts ie64BuildOptions, inputs []string, stdout, stderr io.Writer) int {
+	cache := newIE64IncludeCache()
+	results := make([]ie64BuildResult, len(inputs))
+	jobs := opts.jobs
+	if jobs <= 0 {
+		jobs = runtime.NumCPU()
+	}
+	jobs = min(jobs, len(inputs))
+
+	next := make(chan int)
+	var wg sync.WaitGroup
+	for range jobs {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for i := range next {
+				opts.buildOne(inputs[i], len(inputs) > 1, cache, &results[i])
+			}
+		}()
+	}
+	for i := range inputs {
+		next <- i
+	}
+	close(next)
+	wg.Wait()
+
+	status := 0
+	for i := range results {
+		io.WriteString(stderr, results[i].stderr.String())
+		io.WriteString(stdout, results[i].stdout.String())
+		if results[i].failed {
+			status = 1
+		}
+	}
+	return status
+}
+
+// buildOne assembles a single input into res. In batch mode errors name
+// the input and listings go to <output>.lst.
+func (o *ie64BuildOptions) buildOne(inputFile string, batch bool, cache *ie64IncludeCache, res *ie64BuildResult) {
+	fail := func(format string, args ...interface{}) {
+		if batch {
+			format = inputFile + ": " + format
+		}
+		fmt.Fprintf(&res.stderr, format, args...)
+		res.failed = true
+	}
+
+	source, err := os.ReadFile(inputFile)
+	if err != nil {
+		fail("Error reading input file: %v\n", err)
+		return
+	}
+	outFile := o.outFile
+	if outFile == "" {
+		outFile = strings.TrimSuffix(inputFile, filepath.Ext(inputFile)) + ".ie64"
+	}
+	options := o.optionsFingerprint(outFile)
+
+	if o.incremental {
+		if rec, ok := upToDate(outFile, options, source); ok {
+			o.report(res, batch, outFile, rec.Size, rec.Warnings, rec.Infos, rec.Listing, true)
+			return
+		}
+	}
+
+	asm := NewIE64Assembler()
+	for _, d := range o.defines {
+		asm.Predefine(d.name, d.val)
+	}
+	asm.warningPolicy = o.policy
+	asm.basePath = filepath.Dir(inputFile)
+	asm.includePaths = o.includePaths
+	asm.verbose = o.verbose
+	asm.includeCache = cache
+	asm.SetListingMode(o.listMode)
+
+	binary, err := asm.Assemble(string(source))
+	if err != nil {
+		fail("Assembly error: %v\n", err)
+		return
+	}
+	if err := os.WriteFile(outFile, binary, 0644); err != nil {
+		fail("Error writing output file: %v\n", err)
+		return
+	}
+	o.report(res, batch, outFile, int64(len(binary)), asm.GetWarnings(), asm.GetInfos(), asm.GetListing(), false)
+	if res.failed || !o.incremental {
+		return
+	}
+
+	rec := &ie64DepRecord{
+		Version:  ie64DepRecordVersion,
+		Options:  options,
+		Source:   hashBytes(source),
+		Size:     int64(len(binary)),
+		Deps:     make(map[string]string),
+		Warnings: asm.GetWarnings(),
+		Infos:    asm.GetInfos(),
+		Listing:  asm.GetListing(),
+	}
+	for _, dep := range asm.Dependencies() {
+		sum, err := hashFile(dep)
+		if err != nil {
+			// Leave no record; the next build assembles again.
+			return
+		}
+		rec.Deps[dep] = sum
+	}
+	if err := writeDepRecord(outFile, rec); err != nil {
+		fmt.Fprintf(&res.stderr, "Warning: cannot write %s: %v\n", ie64DepPath(outFile), err)
+	}
+}
+
+// report prints warnings, infos, the success line and the listing. A batch
+// listing file holds what a single-input `-list` run prints to stdout, so
+// tools that parse redirected listings read either.
+func (o *ie64BuildOptions) report(res *ie64BuildResult, batch bool, outFile string, size int64, warnings, infos, listing []string, cached bool) {
+	for _, w := range warnings {
+		fmt.Fprintf(&res.stderr, "Warning: %s\n", w)
+	}
+	if o.verbose {
+		for _, info := range infos {
+			fmt.Fprintf(&res.stderr, "Info: %s\n", info)
+		}
+	}
+	if cached {
+		fmt.Fprintf(&res.stdout, "Up to date: %s (%d bytes)\n", outFile, size)
+	}
+	var out strings.Builder
+	fmt.Fprintf(&out, "Successfully assembled to %s (%d bytes)\n", outFile, size)
+	if o.listMode {
+		out.WriteString("\n--- Listing ---\n")
+		for _, line := range listing {
+			out.WriteString(line)
+			out.WriteByte('\n')
+		}
+	}
+	switch {
+	case batch && o.listMode:
+		lst := strings.TrimSuffix(outFile, filepath.Ext(outFile)) + ".lst"
+		if err := os.WriteFile(lst, []byte(out.String()), 0644); err != nil {
+			fmt.Fprintf(&res.stderr, "Error writing listing file: %v\n", err)
+			res.failed = true
+		}
+		if !cached {
+			fmt.Fprintf(&res.stdout, "Successfully assembled to %s (%d bytes)\n", outFile, size)
+		}
+	case !cached:
+		res.stdout.WriteString(out.String())
+	case o.listMode:
+		res.stdout.WriteString(out.String()[strings.IndexByte(out.String(), '\n')+1:])
+	}
+}
@@ -2279,3 +2279,133 @@ func TestIE64Asm_MFCR_TP(t *testing.T) {
 	want := encodeInstr(opMFCR, 1, 0, 0, 6, 0, 0) // CR_TP = 6
 	assertBytes(t, bin, 0, want, "mfcr r1, tp")
 }
+
+func writeIE64BuildFixture(t *testing.T) (dir string, inputs []string) {
+	t.Helper()
+	dir = t.TempDir()
+	files := map[string]string{
+		"shared.inc": "VALUE equ $1234\nputv macro\n    move.l \\1, #VALUE\n    endm\n",
+		"a.asm":      "include \"shared.inc\"\n    org $1000\n    putv r1\n",
+		"b.asm":      "include \"shared.inc\"\n    org $1000\n    putv r2\n    putv r3\n",
+		"c.asm":      "include \"shared.inc\"\n    org $1000\n    incbin \"blob.bin\"\n",
+		"blob.bin":   "\x01\x02\x03\x04",
+	}
+	for name, body := range files {
+		if err := os.WriteFile(filepath.Join(dir, name), []byte(body), 0644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	for _, name := range []string{"a.asm", "b.asm", "c.asm"} {
+		inputs = append(inputs, filepath.Join(dir, name))
+	}
+	return dir, inputs
+}
+
+func TestIE64Build_BatchMatchesSingleFileAssembly(t *testing.T) {
+	_, inputs := writeIE64BuildFixture(t)
+	var stdout, stderr bytes.Buffer
+	if status := buildIE64Files(ie64BuildOptions{jobs: 3}, inputs, &stdout, &stderr); status != 0 {
+		t.Fatalf("batch build failed: %s", stderr.String())
+	}
+	for _, in := range inputs {
+		src, err := os.ReadFile(in)
+		if err != nil {
+			t.Fatal(err)
+		}
+		asm := NewIE64Assembler()
+		asm.basePath = filepath.Dir(in)
+		want, err := asm.Assemble(string(src))
+		if err != nil {
+			t.Fatalf("%s: %v", in, err)
+		}
+		got, err := os.ReadFile(strings.TrimSuffix(in, ".asm") + ".ie64")
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !bytes.Equal(got, want) {
+			t.Fatalf("%s: batch output differs from single-file assembly", in)
+		}
+	}
+	if lines := strings.Count(stdout.String(), "Successfully assembled"); lines != len(inputs) {
+		t.Fatalf("stdout reported %d builds, want %d:\n%s", lines, len(inputs), stdout.String())
+	}
+}
+
+func TestIE64Build_IncludeCacheSharesMatchingContextsOnly(t *testing.T) {
+	_, inputs := writeIE64BuildFixture(t)
+	cache := newIE64IncludeCache()
+	for _, in := range inputs {
+		src, _ := os.ReadFile(in)
+		asm := NewIE64Assembler()
+		asm.basePath = filepath.Dir(in)
+		asm.includeCache = cache
+		if _, err := asm.Assemble(string(src)); err != nil {
+			t.Fatal(err)
+		}
+	}
+	if cache.hits != len(inputs)-1 {
+		t.Fatalf("include cache hits = %d, want %d", cache.hits, len(inputs)-1)
+	}
+
+	// A different predefine is a different context and must not reuse the
+	// entry: the include's conditional sees another value.
+	dir := t.TempDir()
+	inc := "if FEATURE\n    move.l r1, #1\n    else\n    move.l r1, #2\n    endif\n"
+	if err := os.WriteFile(filepath.Join(dir, "cond.inc"), []byte(inc), 0644); err != nil {
+		t.Fatal(err)
+	}
+	var outs [][]byte
+	for _, feature := range []uint64{1, 0} {
+		asm := NewIE64Assembler()
+		asm.basePath = dir
+		asm.includeCache = cache
+		asm.Predefine("FEATURE", feature)
+		bin, err := asm.Assemble("    org $1000\ninclude \"cond.inc\"\n")
+		if err != nil {
+			t.Fatal(err)
+		}
+		outs = append(outs, bin)
+	}
+	if bytes.Equal(outs[0], outs[1]) {
+		t.Fatalf("include cache ignored the predefine context")
+	}
+}
+
+func TestIE64Build_IncrementalSkipsUnchangedInputs(t *testing.T) {
+	dir, inputs := writeIE64BuildFixture(t)
+	opts := ie64BuildOptions{incremental: true, listMode: true}
+	build := func() string {
+		t.Helper()
+		var stdout, stderr bytes.Buffer
+		if status := buildIE64Files(opts, inputs, &stdout, &stderr); status != 0 {
+			t.Fatalf("build failed: %s", stderr.String())
+		}
+		return stdout.String()
+	}
+
+	if out := build(); strings.Contains(out, "Up to date") {
+		t.Fatalf("first build skipped inputs:\n%s", out)
+	}
+	listing, err := os.ReadFile(filepath.Join(dir, "a.lst"))
+	if err != nil || !strings.Contains(string(listing), "--- Listing ---") {
+		t.Fatalf("batch listing missing: %v", err)
+	}
+	if out := build(); strings.Count(out, "Up to date") != len(inputs) {
+		t.Fatalf("unchanged rebuild assembled again:\n%s", out)
+	}
+
+	// Touching a shared include rebuilds everything; an incbin only its user.
+	if err := os.WriteFile(filepath.Join(dir, "blob.bin"), []byte{9, 9, 9, 9, 9}, 0644); err != nil {
+		t.Fatal(err)
+	}
+	out := build()
+	if strings.Count(out, "Up to date") != 2 || !strings.Contains(out, "Successfully assembled to "+filepath.Join(dir, "c.ie64")+" (5 bytes)") {
+		t.Fatalf("incbin change did not rebuild only c.asm:\n%s", out)
+	}
+	if err := os.WriteFile(filepath.Join(dir, "shared.inc"), []byte("VALUE equ $99\nputv macro\n    move.l \\1, #VALUE\n    endm\n"), 0644); err != nil {
+		t.Fatal(err)
+	}
+	if out := build(); strings.Contains(out, "Up to date") {
+		t.Fatalf("include change left inputs up to date:\n%s", out)
+	}
+}
@@ -0,0 +1,21 @@
+// asset_mmap_other.go - Asset cache files are read onto the heap where mmap is unavailable.
+
+//go:build !linux && !darwin
+
+package main
+
+import (
+	"fmt"
+	"os"
+)
+
+func mapAssetFile(path string, want int) ([]byte, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, err
+	}
+	if len(data) == 0 || (want >= 0 && len(data) != want) {
+		return nil, fmt.Errorf("asset cache file %s has size %d", path, len(data))
+	}
+	return data, nil
+}
@@ -0,0 +1,33 @@
+// asset_mmap_unix.go - Copy-on-write mapping of unpacked asset cache files.
+
+//go:build linux || darwin
+
+package main
+
+import (
+	"fmt"
+	"os"
+
+	"golang.org/x/sys/unix"
+)
+
+// mapAssetFile maps a cache file privately. Pages come from the shared page
+// cache until written, and a stray write stays local to this process. The
+// mapping lives for the rest of the process, like the ROM it holds. want,
+// when non-negative, is the expected size; a mismatch is not mapped.
+func mapAssetFile(path string, want int) ([]byte, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+	st, err := f.Stat()
+	if err != nil {
+		return nil, err
+	}
+	size := st.Size()
+	if size <= 0 || size > assetMaxSize || (want >= 0 && size != int64(want)) {
+		return nil, fmt.Errorf("asset cache file %s has size %d", path, size)
+	}
+	return unix.Mmap(int(f.Fd()), 0, int(size), unix.PROT_READ|unix.PROT_WRITE, unix.MAP_PRIVATE)
+}
@@ -0,0 +1,328 @@
+// asset_store.go - Transparent unpacking and on-disk caching of packed ROM, program and media assets
+
+/*
+ROM images, programs and media files may be stored packed. The embedded AROS
+and EmuTOS ROMs are linked in gzip-compressed, release bundles ship .gz ROM
+images, and Atari ST music arrives ICE- or LHA-packed. Loaders read through
+this layer instead of unpacking ad hoc:
+
+	ReadAsset(path)    reads a file, falling back to path+".gz", and unpacks it
+	UnpackAsset(data)  unpacks bytes already in memory
+	embeddedAsset(b)   unpacks a go:embed image into a private, writable copy
+
+Packing is recognised from content (gzip, ICE!, LHA), never from the file
+name; anything else passes through untouched and uncopied. An LHA archive
+resolves to its first file member, as the PSG player always did.
+
+Unpacked results of at least assetCacheMinBytes are written to a
+content-addressed directory keyed by SHA-256 of the packed bytes and mapped
+back copy-on-write. Later runs skip decompression entirely, and the pages
+are shared, reclaimable page cache rather than private heap. Smaller results,
+and hosts without a usable cache directory, are decoded in memory each time.
+
+Results may be shared between callers and must be treated as read-only.
+*/
+
+package main
+
+import (
+	"bytes"
+	"compress/gzip"
+	"crypto/sha256"
+	"encoding/binary"
+	"encoding/hex"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"strconv"
+	"sync"
+	"time"
+)
+
+const (
+	assetCacheExt             = ".ieasset"
+	assetCacheMinBytes        = 64 << 10
+	assetCacheDefaultMaxBytes = 512 << 20
+	assetMaxSize              = 256 << 20
+)
+
+// assetCodec identifies how an asset is packed.
+type assetCodec uint8
+
+const (
+	assetRaw assetCodec = iota
+	assetGzip
+	assetICE
+	assetLHA
+)
+
+func (c assetCodec) String() string {
+	switch c {
+	case assetGzip:
+		return "gzip"
+	case assetICE:
+		return "ICE"
+	case assetLHA:
+		return "LHA"
+	default:
+		return "raw"
+	}
+}
+
+// detectAssetCodec identifies packed content by its header. gzip also
+// requires the deflate method byte and clear reserved flags, so raw images
+// that happen to start 1F 8B are not mistaken for it.
+func detectAssetCodec(data []byte) assetCodec {
+	switch {
+	case len(data) >= 18 && data[0] == 0x1f && data[1] == 0x8b && data[2] == 8 && data[3]&0xe0 == 0:
+		return assetGzip
+	case isICE(data):
+		return assetICE
+	case isLHAData(data):
+		return assetLHA
+	}
+	return assetRaw
+}
+
+// assetUnpackedSize returns the size recorded in the packed header, or -1
+// when the format does not record it. gzip stores it modulo 2^32.
+func assetUnpackedSize(codec assetCodec, data []byte) int {
+	switch codec {
+	case assetGzip:
+		return int(binary.LittleEndian.Uint32(data[len(data)-4:]))
+	case assetICE:
+		return iceDecrunchedLength(data)
+	}
+	return -1
+}
+
+func decodeAsset(codec assetCodec, data []byte) ([]byte, error) {
+	switch codec {
+	case assetGzip:
+		zr, err := gzip.NewReader(bytes.NewReader(data))
+		if err != nil {
+			return nil, err
+		}
+		// The trailer size is only a hint; cap it before trusting it.
+		buf := bytes.NewBuffer(make([]byte, 0, min(assetUnpackedSize(codec, data), assetMaxSize)))
+		if _, err := io.Copy(buf, io.LimitReader(zr, assetMaxSize+1)); err != nil {
+			return nil, err
+		}
+		if buf.Len() > assetMaxSize {
+			return nil, fmt.Errorf("unpacked size exceeds %d bytes", assetMaxSize)
+		}
+		return buf.Bytes(), nil
+	case assetICE:
+		return UnpackICE(data)
+	case assetLHA:
+		return DecompressLHAData(data)
+	}
+	return data, nil
+}
+
+// AssetStore unpacks assets through an optional on-disk cache.
+type AssetStore struct {
+	dir      string // "" disables the on-disk cache
+	maxBytes int64
+
+	mu     sync.Mutex
+	mapped map[string][]byte // cache files already mapped by this process
+	hits   uint64
+	misses uint64
+}
+
+var (
+	// assetCacheDir is set by -asset-cache; IE_ASSET_CACHE_DIR is the
+	// fallback, then the user cache directory. "off" disables caching.
+	assetCacheDir string
+
+	assetStoreOnce   sync.Once
+	assetStoreShared *AssetStore
+)
+
+// activeAssetStore returns the process-wide store.
+func activeAssetStore() *AssetStore {
+	assetStoreOnce.Do(func() {
+		dir := assetCacheDir
+		if dir == "" {
+			dir = os.Getenv("IE_ASSET_CACHE_DIR")
+		}
+		if dir == "" {
+			if base, err := os.UserCacheDir(); err == nil {
+				dir = filepath.Join(base, "IntuitionEngine", "assets")
+			}
+		}
+		if dir == "off" {
+			dir = ""
+		}
+		maxBytes := int64(assetCacheDefaultMaxBytes)
+		if mb, err := strconv.ParseInt(os.Getenv("IE_ASSET_CACHE_MAX_MB"), 10, 64); err == nil && mb > 0 {
+			maxBytes = mb << 20
+		}
+		assetStoreShared = NewAssetStore(dir, maxBytes)
+	})
+	return assetStoreShared
+}
+
+func NewAssetStore(dir string, maxBytes int64) *AssetStore {
+	if maxBytes <= 0 {
+		maxBytes = assetCacheDefaultMaxBytes
+	}
+	return &AssetStore{dir: dir, maxBytes: maxBytes, mapped: make(map[string][]byte)}
+}
+
+// ReadAsset reads and unpacks a file through the process-wide store.
+func ReadAsset(path string) ([]byte, error) {
+	return activeAssetStore().ReadFile(path)
+}
+
+// UnpackAsset unpacks in-memory data through the process-wide store.
+func UnpackAsset(data []byte) ([]byte, error) {
+	return activeAssetStore().Unpack(data)
+}
+
+// embeddedAsset unpacks a go:embed image into a private copy. A raw image
+// would otherwise alias the embedded variable, and a packed one the store's
+// shared mapping, both of which every reload sees.
+func embeddedAsset(data []byte) ([]byte, error) {
+	out, err := UnpackAsset(data)
+	if err != nil {
+		return nil, err
+	}
+	return bytes.Clone(out), nil
+}
+
+// findAssetFile returns path, or path+".gz" when only the packed copy
+// exists, or "" when neither is a regular file.
+func findAssetFile(path string) string {
+	for _, p := range []string{path, path + ".gz"} {
+		if st, err := os.Stat(p); err == nil && !st.IsDir() {
+			return p
+		}
+	}
+	return ""
+}
+
+// ReadFile reads path, or path+".gz" when path does not exist, and unpacks
+// it. A missing file reports the error for path itself.
+func (s *AssetStore) ReadFile(path string) ([]byte, error) {
+	data, err := os.ReadFile(path)
+	if os.IsNotExist(err) {
+		if packed, gzErr := os.ReadFile(path + ".gz"); gzErr == nil {
+			data, err = packed, nil
+		}
+	}
+	if err != nil {
+		return nil, err
+	}
+	out, err := s.Unpack(data)
+	if err != nil {
+		return nil, fmt.Errorf("%s: %w", path, err)
+	}
+	return out, nil
+}
+
+// Unpack returns data unpacked, or data itself when it is not packed.
+func (s *AssetStore) Unpack(data []byte) ([]byte, error) {
+	codec := detectAssetCodec(data)
+	if codec == assetRaw {
+		return data, nil
+	}
+	size := assetUnpackedSize(codec, data)
+	if s.dir == "" || (size >= 0 && size < assetCacheMinBytes) {
+		return s.decode(codec, data)
+	}
+
+	sum := sha256.Sum256(data)
+	key := hex.EncodeToString(sum[:])
+	s.mu.Lock()
+	if out, ok := s.mapped[key]; ok {
+		s.hits++
+		s.mu.Unlock()
+		return out, nil
+	}
+	s.mu.Unlock()
+
+	path := filepath.Join(s.dir, key+assetCacheExt)
+	if out, err := mapAssetFile(path, size); err == nil {
+		now := time.Now()
+		_ = os.Chtimes(path, now, now)
+		return s.remember(key, out, true), nil
+	}
+
+	out, err := s.decode(codec, data)
+	if err != nil || len(out) < assetCacheMinBytes {
+		return out, err
+	}
+	if s.put(path, out) != nil {
+		return out, nil
+	}
+	if mapped, err := mapAssetFile(path, len(out)); err == nil {
+		// Drop the heap copy in favour of the shared page-cache mapping.
+		out = mapped
+	}
+	return s.remember(key, out, false), nil
+}
+
+func (s *AssetStore) decode(codec assetCodec, data []byte) ([]byte, error) {
+	out, err := decodeAsset(codec, data)
+	if err != nil {
+		return nil, fmt.Errorf("asset: %s unpack failed: %w", codec, err)
+	}
+	return out, nil
+}
+
+// remember records a cached result so repeat loads in this process reuse
+// the same mapping. Another goroutine may have raced us; keep its copy.
+func (s *AssetStore) remember(key string, out []byte, hit bool) []byte {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if hit {
+		s.hits++
+	} else {
+		s.misses++
+	}
+	if prev, ok := s.mapped[key]; ok {
+		return prev
+	}
+	s.mapped[key] = out
+	return out
+}
+
+// put stores an unpacked asset atomically and prunes the directory.
+func (s *AssetStore) put(path string, data []byte) error {
+	if int64(len(data)) > s.maxBytes {
+		return fmt.Errorf("asset larger than cache")
+	}
+	if err := os.MkdirAll(s.dir, 0o755); err != nil {
+		return err
+	}
+	tmp, err := os.CreateTemp(s.dir, "tmp-*")
+	if err != nil {
+		return err
+	}
+	tmpName := tmp.Name()
+	if _, err := tmp.Write(data); err != nil {
+		tmp.Close()
+		os.Remove(tmpName)
+		return err
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmpName)
+		return err
+	}
+	if err := os.Rename(tmpName, path); err != nil {
+		os.Remove(tmpName)
+		return err
+	}
+	pruneCacheDir(s.dir, assetCacheExt, s.maxBytes)
+	return nil
+}
+
+// Stats returns cache lookup counters since process start.
+func (s *AssetStore) Stats() (hits, misses uint64) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	return s.hits, s.misses
+}
@@ -0,0 +1,252 @@
+// asset_store_test.go - Tests for the packed-asset layer
+
+package main
+
+import (
+	"bytes"
+	"compress/gzip"
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+func testGzip(t testing.TB, data []byte) []byte {
+	t.Helper()
+	var buf bytes.Buffer
+	zw, _ := gzip.NewWriterLevel(&buf, gzip.BestCompression)
+	if _, err := zw.Write(data); err != nil {
+		t.Fatal(err)
+	}
+	if err := zw.Close(); err != nil {
+		t.Fatal(err)
+	}
+	return buf.Bytes()
+}
+
+func testAssetCacheFiles(t *testing.T, dir string) []string {
+	t.Helper()
+	files, _ := filepath.Glob(filepath.Join(dir, "*"+assetCacheExt))
+	return files
+}
+
+func TestDetectAssetCodec(t *testing.T) {
+	rom := lhTestCorpus(4096, 1)
+	for _, tc := range []struct {
+		name string
+		data []byte
+		want assetCodec
+	}{
+		{"raw", rom, assetRaw},
+		{"gzip", testGzip(t, rom), assetGzip},
+		{"lha", buildLHALevel0("-lh0-", rom, rom), assetLHA},
+		{"ice", append([]byte("ICE!"), make([]byte, 16)...), assetICE},
+		// 1F 8B with a non-deflate method byte is not gzip.
+		{"1f8b raw", append([]byte{0x1f, 0x8b, 0x00, 0x00}, rom...), assetRaw},
+		{"short", []byte{0x1f, 0x8b, 8}, assetRaw},
+	} {
+		if got := detectAssetCodec(tc.data); got != tc.want {
+			t.Errorf("%s: codec %v, want %v", tc.name, got, tc.want)
+		}
+	}
+}
+
+func TestAssetStore_RawPassesThroughUncopied(t *testing.T) {
+	s := NewAssetStore(t.TempDir(), 0)
+	data := lhTestCorpus(1<<17, 2)
+	got, err := s.Unpack(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if &got[0] != &data[0] {
+		t.Fatal("raw asset was copied")
+	}
+	if files := testAssetCacheFiles(t, s.dir); len(files) != 0 {
+		t.Fatalf("raw asset cached: %v", files)
+	}
+}
+
+func TestAssetStore_GzipCachedAcrossStores(t *testing.T) {
+	dir := t.TempDir()
+	want := lhTestCorpus(1<<18, 3)
+	packed := testGzip(t, want)
+
+	s := NewAssetStore(dir, 0)
+	got, err := s.Unpack(packed)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, want) {
+		t.Fatal("unpacked data mismatch")
+	}
+	if files := testAssetCacheFiles(t, dir); len(files) != 1 {
+		t.Fatalf("cache files = %v, want 1", files)
+	}
+	if again, _ := s.Unpack(packed); &again[0] != &got[0] {
+		t.Error("repeat unpack in one store did not reuse the mapping")
+	}
+	if hits, misses := s.Stats(); hits != 1 || misses != 1 {
+		t.Errorf("stats = %d hits, %d misses, want 1, 1", hits, misses)
+	}
+
+	// A fresh store, as in the next run, maps the cached file.
+	s2 := NewAssetStore(dir, 0)
+	got2, err := s2.Unpack(packed)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got2, want) {
+		t.Fatal("cached data mismatch")
+	}
+	if hits, misses := s2.Stats(); hits != 1 || misses != 0 {
+		t.Errorf("second run stats = %d hits, %d misses, want 1, 0", hits, misses)
+	}
+}
+
+func TestAssetStore_StaleCacheEntryReplaced(t *testing.T) {
+	dir := t.TempDir()
+	want := lhTestCorpus(1<<17, 4)
+	packed := testGzip(t, want)
+	if _, err := NewAssetStore(dir, 0).Unpack(packed); err != nil {
+		t.Fatal(err)
+	}
+	files := testAssetCacheFiles(t, dir)
+	if len(files) != 1 {
+		t.Fatalf("cache files = %v", files)
+	}
+	// Truncated entry, e.g. from a full disk.
+	if err := os.WriteFile(files[0], want[:100], 0o644); err != nil {
+		t.Fatal(err)
+	}
+	got, err := NewAssetStore(dir, 0).Unpack(packed)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, want) {
+		t.Fatal("stale cache entry returned")
+	}
+	if st, err := os.Stat(files[0]); err != nil || st.Size() != int64(len(want)) {
+		t.Fatalf("cache entry not rewritten: %v", err)
+	}
+}
+
+func TestAssetStore_SmallAndUncachedDecodeInMemory(t *testing.T) {
+	small := []byte("tiny asset")
+	dir := t.TempDir()
+	for _, s := range []*AssetStore{NewAssetStore(dir, 0), NewAssetStore("", 0)} {
+		got, err := s.Unpack(testGzip(t, small))
+		if err != nil || !bytes.Equal(got, small) {
+			t.Fatalf("got %q, %v", got, err)
+		}
+	}
+	big := lhTestCorpus(1<<17, 5)
+	if got, err := NewAssetStore("", 0).Unpack(testGzip(t, big)); err != nil || !bytes.Equal(got, big) {
+		t.Fatalf("uncached unpack failed: %v", err)
+	}
+	if files := testAssetCacheFiles(t, dir); len(files) != 0 {
+		t.Fatalf("small asset cached: %v", files)
+	}
+}
+
+func TestAssetStore_CorruptGzipRejected(t *testing.T) {
+	packed := testGzip(t, lhTestCorpus(1<<17, 6))
+	packed[len(packed)/2] ^= 0xff
+	if _, err := NewAssetStore(t.TempDir(), 0).Unpack(packed); err == nil {
+		t.Fatal("expected error for corrupt gzip asset")
+	}
+}
+
+func TestAssetStore_LHAResolvesToFirstMember(t *testing.T) {
+	want := []byte("YM register dump")
+	got, err := NewAssetStore("", 0).Unpack(buildLHALevel0("-lh5-", testCompressLH5(want), want))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, want) {
+		t.Fatalf("got %q, want %q", got, want)
+	}
+}
+
+func TestAssetStore_ReadFileFallsBackToGzip(t *testing.T) {
+	dir := t.TempDir()
+	want := lhTestCorpus(1<<17, 7)
+	rom := filepath.Join(dir, "aros-ie-m68k.rom")
+	if err := os.WriteFile(rom+".gz", testGzip(t, want), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if findAssetFile(rom) != rom+".gz" {
+		t.Fatalf("findAssetFile(%q) = %q", rom, findAssetFile(rom))
+	}
+	s := NewAssetStore(t.TempDir(), 0)
+	got, err := s.ReadFile(rom)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, want) {
+		t.Fatal("data mismatch")
+	}
+	if _, err := s.ReadFile(filepath.Join(dir, "missing.rom")); !os.IsNotExist(err) {
+		t.Fatalf("missing file error = %v, want not-exist", err)
+	}
+}
+
+func TestEmbeddedAssetClonesRawImage(t *testing.T) {
+	embedded := []byte{0x00, 0x10, 0x00, 0x00, 0x00, 0xf8, 0x00, 0x08}
+	got, err := embeddedAsset(embedded)
+	if err != nil {
+		t.Fatal(err)
+	}
+	got[0] = 0xff
+	if embedded[0] != 0 {
+		t.Fatal("embeddedAsset returned the embedded slice itself")
+	}
+}
+
+func TestEmbeddedAssetClonesPackedImage(t *testing.T) {
+	activeAssetStore()
+	prev := assetStoreShared
+	assetStoreShared = NewAssetStore(t.TempDir(), 0)
+	t.Cleanup(func() { assetStoreShared = prev })
+
+	want := lhTestCorpus(1<<18, 4)
+	packed := testGzip(t, want)
+	first, err := embeddedAsset(packed)
+	if err != nil {
+		t.Fatal(err)
+	}
+	first[0] ^= 0xff
+	again, err := embeddedAsset(packed)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(again, want) {
+		t.Fatal("embeddedAsset returned the store's shared mapping")
+	}
+}
+
+func BenchmarkAssetStore_AROSROM(b *testing.B) {
+	rom, err := os.ReadFile("sdk/roms/aros-ie-m68k.rom")
+	if err != nil {
+		b.Skip("AROS ROM not present")
+	}
+	packed := testGzip(b, rom)
+	b.Run("decode", func(b *testing.B) {
+		b.SetBytes(int64(len(rom)))
+		for range b.N {
+			if _, err := decodeAsset(assetGzip, packed); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	dir := b.TempDir()
+	if _, err := NewAssetStore(dir, 0).Unpack(packed); err != nil {
+		b.Fatal(err)
+	}
+	b.Run("cached", func(b *testing.B) {
+		b.SetBytes(int64(len(rom)))
+		for range b.N {
+			if _, err := NewAssetStore(dir, 0).Unpack(packed); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
@@ -24,9 +24,14 @@ import (
 	"github.com/ebitengine/oto/v3"
 	"sync"
 	"sync/atomic"
+	"time"
 	"unsafe"
 )
 
+// otoTelemetryInterval is how often the fill level is sampled and, in
+// adaptive mode, the buffer size reconsidered.
+const otoTelemetryInterval = 100 * time.Millisecond
+
 func init() {
 	compiledFeatures = append(compiledFeatures, "audio:oto")
 }
@@ -39,6 +44,8 @@ type OtoPlayer struct {
 	started   bool
 	closed    bool
 	mutex     sync.Mutex // Only for setup/control operations
+
+	monitorStop chan struct{} // closes the telemetry/adaptive goroutine
 }
 
 func NewOtoPlayer(sampleRate int) (*OtoPlayer, error) {
@@ -99,9 +106,9 @@ func (op *OtoPlayer) Read(p []byte) (n int, err error) {
 	}
 	samples := op.sampleBuf[:numSamples]
 
-	for i := range numSamples {
-		samples[i] = chip.ReadSample()
-	}
+	start := time.Now()
+	chip.ReadSamples(samples)
+	chip.telemetry.recordRender(start, numSamples)
 
 	copy(p[:fullBytes], (*[1 << 30]byte)(unsafe.Pointer(&samples[0]))[:fullBytes])
 	clear(p[fullBytes:])
@@ -115,6 +122,48 @@ func (op *OtoPlayer) Start() {
 	if !op.started && op.player != nil && !op.closed {
 		op.player.Play()
 		op.started = true
+		op.monitorStop = make(chan struct{})
+		go op.monitor(op.player, op.chip.Load(), op.monitorStop)
+	}
+}
+
+// monitor samples the player's queued frames for the telemetry and, with
+// adaptive buffering on, resizes the player buffer from what it sees.
+func (op *OtoPlayer) monitor(player *oto.Player, chip *SoundChip, stop <-chan struct{}) {
+	if chip == nil {
+		return
+	}
+	var ctrl *audioBufferController
+	if audioAdaptiveBufferEnabled.Load() {
+		ctrl = newAudioBufferController()
+		ctrl.trouble = chip.telemetry.deadlineMisses.Load() + chip.telemetry.underruns.Load()
+		player.SetBufferSize(ctrl.frames * 4)
+		chip.telemetry.bufferFrames.Store(int64(ctrl.frames))
+	}
+	tick := time.NewTicker(otoTelemetryInterval)
+	defer tick.Stop()
+	for {
+		select {
+		case <-stop:
+			return
+		case <-tick.C:
+		}
+		chip.telemetry.recordFill(player.BufferedSize()/4, player.IsPlaying())
+		if ctrl == nil {
+			continue
+		}
+		prev := ctrl.frames
+		if frames := ctrl.step(&chip.telemetry); frames != prev {
+			player.SetBufferSize(frames * 4)
+			chip.telemetry.bufferFrames.Store(int64(frames))
+		}
+	}
+}
+
+func (op *OtoPlayer) stopMonitorLocked() {
+	if op.monitorStop != nil {
+		close(op.monitorStop)
+		op.monitorStop = nil
 	}
 }
 
@@ -123,6 +172,7 @@ func (op *OtoPlayer) Stop() {
 	defer op.mutex.Unlock()
 
 	if op.started && op.player != nil && !op.closed {
+		op.stopMonitorLocked()
 		op.player.Pause()
 		op.started = false
 	}
@@ -637,3 +637,53 @@ func BenchmarkPOKEY_VolumeGain_Plus(b *testing.B) {
 		_ = pokeyVolumeGain(level, true)
 	}
 }
+
+// BenchmarkSoundChip_GenerateSample_PSGPlusBandLimited benchmarks PSG+ with
+// band-limited oscillators instead of 4x oversampling
+func BenchmarkSoundChip_GenerateSample_PSGPlusBandLimited(b *testing.B) {
+	chip := createBenchmarkChip(b)
+	setupBenchmarkChannel(chip, 0, WAVE_SQUARE, 440.0)
+	chip.SetPSGPlusEnabled(true)
+	chip.SetPlusBandLimited(true)
+
+	b.ResetTimer()
+	b.ReportAllocs()
+
+	for i := 0; i < b.N; i++ {
+		_ = chip.GenerateSample()
+	}
+}
+
+// benchmarkPlusAliasing renders a ~3.8kHz PSG+ channel and reports the
+// inharmonic (aliased) energy in dB relative to the total.
+func benchmarkPlusAliasing(b *testing.B, wave int, bandLimited bool) {
+	var ratio float64
+	for i := 0; i < b.N; i++ {
+		ratio = plusAliasRatio(renderPlusChannel(wave, bandLimited), plusAliasBin)
+	}
+	b.ReportMetric(10*math.Log10(ratio+1e-12), "alias-dB")
+}
+
+func BenchmarkPlusAliasing_Square_Oversampled(b *testing.B) {
+	benchmarkPlusAliasing(b, WAVE_SQUARE, false)
+}
+
+func BenchmarkPlusAliasing_Square_BandLimited(b *testing.B) {
+	benchmarkPlusAliasing(b, WAVE_SQUARE, true)
+}
+
+func BenchmarkPlusAliasing_Sawtooth_Oversampled(b *testing.B) {
+	benchmarkPlusAliasing(b, WAVE_SAWTOOTH, false)
+}
+
+func BenchmarkPlusAliasing_Sawtooth_BandLimited(b *testing.B) {
+	benchmarkPlusAliasing(b, WAVE_SAWTOOTH, true)
+}
+
+func BenchmarkPlusAliasing_Triangle_Oversampled(b *testing.B) {
+	benchmarkPlusAliasing(b, WAVE_TRIANGLE, false)
+}
+
+func BenchmarkPlusAliasing_Triangle_BandLimited(b *testing.B) {
+	benchmarkPlusAliasing(b, WAVE_TRIANGLE, true)
+}
@@ -241,6 +241,8 @@ const (
 	FILTER_MOD_SOURCE = 0xF082C // Register to set modulation source (channel 0–3)
 	FILTER_MOD_AMOUNT = 0xF0830 // Register to set modulation depth (0–255 → 0.0–1.0)
 
+	AUDIO_PLUS_BANDLIMIT = 0xF0834 // Bit n: channel n's Plus mode uses band-limited oscillators instead of oversampling
+
 	OVERDRIVE_CTRL = 0xF0A40 // Drive amount (0-255 → 0.0-4.0)
 
 	REVERB_MIX   = 0xF0A50 // 0-255 → 0.0-1.0 (dry/wet)
@@ -870,6 +872,7 @@ type Channel struct {
 	sidNoisePhaseLocked  bool // Clock noise LFSR on phase wrap (authentic SID timing)
 	sid6581FilterDistort bool // Enable 6581 filter distortion
 	dacMode              bool // DAC mode: bypass waveform+envelope, output dacValue directly
+	plusBandLimited      bool // Plus modes use one band-limited oscillator sample instead of oversampling
 
 	// SID rate counter state (for authentic ADSR timing)
 	sidEnvLevel         uint8                  // 8-bit envelope level (0-255)
@@ -953,6 +956,9 @@ type SoundChip struct {
 	audioFrozen   atomic.Bool  // When true, ReadSample returns 0 (hard pause)
 	sfx           *SFXTrigger  // Independent trigger-and-forget sample mixer
 
+	writeQueue soundWriteQueue // Emulated-time bus writes (see audio_write_queue.go)
+	mixGraph   mixGraph        // ReadSamples block render state (see audio_mix_graph.go)
+
 	snVoices [4]Channel // Native SN76489 voices, independent from flex channels.
 
 	// Cache line 3+ - Reverb state (cold path)
@@ -964,6 +970,15 @@ type SoundChip struct {
 	output          AudioOutput                    // Audio backend interface
 	sampleRateRecip float32                        // Pre-computed 1.0 / sampleRate
 
+	reverbScratch []float32 // Pre-delayed block for reverbBlockLocked
+
+	// Last global filter cutoff mapping, reused while the cutoff is steady
+	filterCutoffIn     float32
+	filterCutoffCoef   float32
+	filterCutoffCached bool
+
+	telemetry audioTelemetry // Output backend render/underrun/latency stats
+
 	// Byte accumulator/read-back shadow for sub-word flex register writes.
 	flexShadow [NUM_CHANNELS * FLEX_CH_STRIDE]byte
 
@@ -1190,6 +1205,9 @@ func (chip *SoundChip) HandleRegisterRead(addr uint32) uint32 {
 		}
 		return 0
 	}
+	if addr == AUDIO_PLUS_BANDLIMIT {
+		return chip.plusBandLimitMaskLocked()
+	}
 	if addr >= ENV_SHAPE_CH_BASE && addr < ENV_SHAPE_CH_BASE+NUM_CHANNELS*4 && (addr-ENV_SHAPE_CH_BASE)%4 == 0 {
 		chIndex := (addr - ENV_SHAPE_CH_BASE) / 4
 		if chIndex < NUM_CHANNELS && chip.channels[chIndex] != nil {
@@ -1544,6 +1562,8 @@ func (chip *SoundChip) HandleRegisterWrite(addr uint32, value uint32) {
 	case FILTER_MOD_AMOUNT:
 		// Normalise modulation depth to 0.0–1.0
 		chip.filterModAmount = float32(value) / NORMALISE_8BIT
+	case AUDIO_PLUS_BANDLIMIT:
+		chip.setPlusBandLimitMaskLocked(value)
 	case OVERDRIVE_CTRL:
 		chip.overdriveLevel = float32(value) / NORMALISE_8BIT * MAX_OVERDRIVE // 0.0-4.0 gain
 		chip.overdriveGain = 1.0 + (chip.overdriveLevel / 10.0)
@@ -1673,13 +1693,7 @@ func (chip *SoundChip) applyFlexRegister(chIndex uint32, offset uint32, value ui
 			ch.ringModSource = nil
 		}
 	case FLEX_OFF_DAC:
-		ch.dacMode = true
-		signed := int8(byte(value))
-		if signed == -128 {
-			ch.dacValue = -1.0
-		} else {
-			ch.dacValue = float32(signed) / 127.0
-		}
+		ch.setDAC8(int8(byte(value)))
 	case FLEX_OFF_SYNC:
 		if value&0x80 != 0 {
 			srcCh := int(value & 0x0F)
@@ -1696,12 +1710,59 @@ func (chip *SoundChip) applyFlexRegister(chIndex uint32, offset uint32, value ui
 	}
 }
 
+// setDAC8 enters DAC mode with a signed 8-bit sample (FLEX_OFF_DAC semantics).
+func (ch *Channel) setDAC8(signed int8) {
+	ch.dacMode = true
+	if signed == -128 {
+		ch.dacValue = -1.0
+	} else {
+		ch.dacValue = float32(signed) / 127.0
+	}
+}
+
+// WriteFlexDACs performs a FLEX_OFF_DAC register write on each listed channel
+// under a single lock acquisition. Per-sample DMA-style feeders use it instead
+// of one HandleRegisterWrite per channel.
+func (chip *SoundChip) WriteFlexDACs(channels []int, values []int8) {
+	chip.mu.Lock()
+	defer chip.mu.Unlock()
+
+	mem := chip.busMemory
+	for i, chIndex := range channels {
+		if chIndex < 0 || chIndex >= NUM_CHANNELS || i >= len(values) {
+			continue
+		}
+		ch := chip.channels[chIndex]
+		if ch == nil {
+			continue
+		}
+		if addr, ok := flexAddrForChannel(chIndex, FLEX_OFF_DAC); ok && mem != nil && addr+3 < uint32(len(mem)) {
+			mem[addr] = byte(values[i])
+			mem[addr+1] = 0
+			mem[addr+2] = 0
+			mem[addr+3] = 0
+		}
+		ch.setDAC8(values[i])
+	}
+}
+
 // HandleRegisterWrite8 handles byte-level writes to audio registers.
 // For flex channel registers, bytes are accumulated in a shadow buffer.
 // When the 4th byte of a register arrives (offset & 3 == 3), the full
 // 32-bit value is assembled from the shadow and applied via applyFlexRegister.
 // For non-flex addresses, delegates directly to HandleRegisterWrite.
 func (chip *SoundChip) HandleRegisterWrite8(addr uint32, value uint8) {
+	// The band-limit mask spans more than one byte: merge each byte lane
+	// into the current mask so 8-bit CPUs can reach channels 8-9.
+	if addr&^3 == AUDIO_PLUS_BANDLIMIT {
+		chip.mu.Lock()
+		defer chip.mu.Unlock()
+		shift := (addr & 3) * 8
+		mask := chip.plusBandLimitMaskLocked()&^(0xFF<<shift) | uint32(value)<<shift
+		chip.setPlusBandLimitMaskLocked(mask)
+		return
+	}
+
 	// Non-flex addresses: delegate to existing handler (works fine for byte values)
 	chIndex, offset, ok := flexChannelFromAddr(addr)
 	if !ok {
@@ -2351,6 +2412,34 @@ func (ch *Channel) generateWaveSample(sampleRate, sampleRateRecip float32) float
 	return rawSample
 }
 
+// generateBandLimitedSample is generateWaveSample at the output rate with the
+// remaining naive corner (the plain triangle) smoothed by polyBLAMP. Square and
+// sawtooth already carry polyBLEP step correction. SID combined waveforms are
+// left to their 12-bit AND path.
+func (ch *Channel) generateBandLimitedSample(sampleRate, sampleRateRecip float32) float32 {
+	isTriangle := ch.sidWaveMask == SID_WAVE_TRIANGLE || (ch.sidWaveMask == 0 && ch.waveType == WAVE_TRIANGLE)
+	if !isTriangle || ch.sidDACEnabled {
+		return ch.generateWaveSample(sampleRate, sampleRateRecip)
+	}
+	phaseNorm := ch.phase * INV_TWO_PI
+	dt := ch.frequency * sampleRateRecip
+	rawSample := ch.generateWaveSample(sampleRate, sampleRateRecip)
+	if dt <= 0 || dt >= HALF_CYCLE {
+		return rawSample
+	}
+	// Slope changes by +2*TRIANGLE_SLOPE at phase 0 and -2*TRIANGLE_SLOPE at 0.5.
+	upper := phaseNorm + HALF_CYCLE
+	if upper >= 1 {
+		upper -= 1
+	}
+	corr := 2 * TRIANGLE_SLOPE * dt * (polyBLAMP32(phaseNorm, dt) - polyBLAMP32(upper, dt)) * TRIANGLE_NORM
+	if ch.ringModSource != nil && ch.ringModSource.phaseMSB {
+		corr = -corr
+	}
+	ch.prevRawSample = rawSample + corr
+	return rawSample + corr
+}
+
 // computePlusBiquadCoeffs computes Butterworth second-order lowpass biquad coefficients.
 // cutoffHz is the filter cutoff frequency, sampleRate is the effective sample rate
 // (base rate * oversample factor).
@@ -2392,17 +2481,25 @@ func (ch *Channel) processEnhancedSample(
 	transStep *float32,
 	transCounter *int,
 ) float32 {
-	// Oversampling: generate multiple samples at higher rate and average
-	sampleRate := float32(SAMPLE_RATE) * float32(oversample)
-	sampleRateRecip := 1.0 / sampleRate
-	var sum float32
-	for range oversample {
-		sum += ch.generateWaveSample(sampleRate, sampleRateRecip)
+	var rawSample float32
+	sampleRate := float32(SAMPLE_RATE)
+	if ch.plusBandLimited {
+		// One sample at the output rate: polyBLEP square/saw plus polyBLAMP
+		// triangle corners replace oversampling and the decimation biquad.
+		rawSample = ch.generateBandLimitedSample(sampleRate, 1.0/sampleRate)
+	} else {
+		// Oversampling: generate multiple samples at higher rate and average
+		sampleRate *= float32(oversample)
+		sampleRateRecip := 1.0 / sampleRate
+		var sum float32
+		for range oversample {
+			sum += ch.generateWaveSample(sampleRate, sampleRateRecip)
+		}
+		rawSample = sum / float32(oversample)
 	}
-	rawSample := sum / float32(oversample)
 
 	// Second-order biquad lowpass (Butterworth, -12dB/oct) - Direct Form II transposed
-	if ch.plusBqB0 != 0 {
+	if ch.plusBqB0 != 0 && !ch.plusBandLimited {
 		out := ch.plusBqB0*rawSample + *bqZ1
 		*bqZ1 = ch.plusBqB1*rawSample - ch.plusBqA1*out + *bqZ2
 		*bqZ2 = ch.plusBqB2*rawSample - ch.plusBqA2*out
@@ -2712,6 +2809,56 @@ func (ch *Channel) generateSample() float32 {
 	return clampF32(scaledSample, MIN_SAMPLE, MAX_SAMPLE)
 }
 
+// SetChannelPlusBandLimited selects band-limited oscillators instead of
+// oversampling for a channel's PSG+/POKEY+/SID+/TED+/AHX+ processing. Envelope
+// timing is unchanged; only waveform generation and the decimation filter differ.
+// Guests select it through the AUDIO_PLUS_BANDLIMIT channel mask.
+func (chip *SoundChip) SetChannelPlusBandLimited(ch int, enabled bool) {
+	chip.mu.Lock()
+	defer chip.mu.Unlock()
+
+	if ch < 0 || ch >= NUM_CHANNELS {
+		return
+	}
+	channel := chip.channels[ch]
+	if channel == nil {
+		return
+	}
+	channel.plusBandLimited = enabled
+}
+
+// plusBandLimitMaskLocked returns the AUDIO_PLUS_BANDLIMIT view of the
+// per-channel band-limit flags.
+func (chip *SoundChip) plusBandLimitMaskLocked() uint32 {
+	var mask uint32
+	for i, ch := range chip.channels {
+		if ch != nil && ch.plusBandLimited {
+			mask |= 1 << i
+		}
+	}
+	return mask
+}
+
+func (chip *SoundChip) setPlusBandLimitMaskLocked(mask uint32) {
+	for i, ch := range chip.channels {
+		if ch != nil {
+			ch.plusBandLimited = mask&(1<<i) != 0
+		}
+	}
+}
+
+// SetPlusBandLimited applies SetChannelPlusBandLimited to every channel.
+func (chip *SoundChip) SetPlusBandLimited(enabled bool) {
+	chip.mu.Lock()
+	defer chip.mu.Unlock()
+
+	for _, channel := range chip.channels {
+		if channel != nil {
+			channel.plusBandLimited = enabled
+		}
+	}
+}
+
 func (ch *Channel) activeEnhancedOversample() int {
 	switch {
 	case ch.psgPlusEnabled && ch.psgPlusOversample > 1:
@@ -2783,24 +2930,60 @@ func (chip *SoundChip) GenerateSample() float32 {
 		return 0
 	}
 
-	// Take lock and capture all state needed for sample generation to ensure consistency and thread safety
 	chip.mu.Lock()
-	filterType := chip.filterType
+	var f sampleFrame
+	chip.synthFrameLocked(&f)
+	sample := f.pre
+	if chip.sfx != nil {
+		sample = clampF32(sample+chip.sfx.MixSample(), MIN_SAMPLE, MAX_SAMPLE)
+	}
+	if holder, ok := chip.sampleMixer.Load().(*sampleMixerListHolder); ok {
+		for _, mixer := range holder.mixers {
+			if mixer != nil {
+				sample = clampF32(sample+mixer.MixSample(), MIN_SAMPLE, MAX_SAMPLE)
+			}
+		}
+	}
+	sample = chip.finishFrameLocked(&f, sample)
+	chip.mu.Unlock()
+
+	// Clamp final output
+	return clampF32(sample, MIN_SAMPLE, MAX_SAMPLE)
+}
+
+// sampleFrame carries one sample through GenerateSample: the channel mix
+// ahead of the sample mixers plus the effect parameters snapshotted with it.
+type sampleFrame struct {
+	pre              float32 // channel mix, before SFX and sample mixers
+	filterType       int
+	filterCutoff     float32
+	filterModSignal  float32
+	filterModulated  bool
+	filterResonance  float32
+	overdriveLevel   float32
+	overdriveGain    float32
+	reverbMix        float32
+	sidMixerEnabled  bool
+	sidMixerSaturate bool
+	sidMixerDCOffset float32
+}
+
+// synthFrameLocked snapshots effect state and mixes the channels into f.
+// Caller holds chip.mu.
+func (chip *SoundChip) synthFrameLocked(f *sampleFrame) {
+	// Capture all state needed for sample generation to ensure consistency and thread safety
+	f.filterType = chip.filterType
 	const globalFilterSmooth = 0.02
 	chip.filterCutoff += (chip.filterCutoffTarget - chip.filterCutoff) * globalFilterSmooth
 	chip.filterResonance += (chip.filterResonanceTarget - chip.filterResonance) * globalFilterSmooth
-	filterCutoff := chip.filterCutoff
-	filterModSource := chip.filterModSource
-	filterModAmount := chip.filterModAmount
-	filterResonance := chip.filterResonance
-	overdriveLevel := chip.overdriveLevel
-	overdriveGain := chip.overdriveGain
-	reverbMix := chip.reverbMix
-	filterLP := chip.filterLP
-	filterBP := chip.filterBP
-	sidMixerEnabled := chip.sidMixerEnabled
-	sidMixerDCOffset := chip.sidMixerDCOffset
-	sidMixerSaturate := chip.sidMixerSaturate
+	f.filterCutoff = chip.filterCutoff
+	f.filterResonance = chip.filterResonance
+	f.overdriveLevel = chip.overdriveLevel
+	f.overdriveGain = chip.overdriveGain
+	f.reverbMix = chip.reverbMix
+	f.sidMixerEnabled = chip.sidMixerEnabled
+	f.sidMixerDCOffset = chip.sidMixerDCOffset
+	f.sidMixerSaturate = chip.sidMixerSaturate
 
 	// Channel mixing under lock - protects channel fields from concurrent
 	// HandleRegisterWrite on CPU threads
@@ -2820,6 +3003,10 @@ func (chip *SoundChip) GenerateSample() float32 {
 			activeCount++
 		}
 	}
+	if src := chip.filterModSource; src != nil {
+		f.filterModSignal = src.prevRawSample * chip.filterModAmount
+		f.filterModulated = true
+	}
 
 	var sample float32
 	if activeCount == 0 {
@@ -2831,53 +3018,67 @@ func (chip *SoundChip) GenerateSample() float32 {
 		// When multiple channels are active, average their samples.
 		sample = sum / float32(activeCount)
 	}
-	if chip.sfx != nil {
-		sample = clampF32(sample+chip.sfx.MixSample(), MIN_SAMPLE, MAX_SAMPLE)
-	}
-	if holder, ok := chip.sampleMixer.Load().(*sampleMixerListHolder); ok {
-		for _, mixer := range holder.mixers {
-			if mixer != nil {
-				sample = clampF32(sample+mixer.MixSample(), MIN_SAMPLE, MAX_SAMPLE)
-			}
-		}
-	}
+	f.pre = sample
+}
+
+// finishFrameLocked runs the post-mix chain (SID mixer, overdrive, global
+// filter, reverb, master normalizer) on sample using f's snapshot. Caller
+// holds chip.mu; the filter, reverb and normalizer state it advances is
+// audio-thread-only.
+func (chip *SoundChip) finishFrameLocked(f *sampleFrame, sample float32) float32 {
+	sample = chip.preReverbLocked(f, sample)
+
+	// Apply reverb effect and final mix
+	wet := chip.applyReverb(sample)
+	sample = sample*(1-f.reverbMix) + wet*f.reverbMix
 
+	// Apply showreel master gain and transparent safety compression last.
+	return chip.applyMasterNormalizer(sample)
+}
+
+// preReverbLocked applies the SID mixer, overdrive and global filter stages.
+func (chip *SoundChip) preReverbLocked(f *sampleFrame, sample float32) float32 {
 	// Apply SID mixer mode (DC offset and soft saturation)
-	if sidMixerEnabled {
+	if f.sidMixerEnabled {
 		// Add DC offset (characteristic of 6581)
-		sample += sidMixerDCOffset
+		sample += f.sidMixerDCOffset
 
 		// Apply soft saturation for authentic voice mixing
-		if sidMixerSaturate {
+		if f.sidMixerSaturate {
 			sample = sidMixerSoftClip(sample)
 		}
 	}
 
 	// Apply overdrive effect with waveform-specific processing
-	if overdriveLevel > 0 {
-		gain := overdriveGain
+	if f.overdriveLevel > 0 {
+		gain := f.overdriveGain
 
 		// Apply overdrive with tanh for soft clipping
 		sample = fastTanh(sample * gain)
 	}
 
 	// Apply global filter processing
-	if filterType != 0 && filterCutoff > 0 {
+	if f.filterType != 0 && f.filterCutoff > 0 {
 		// Calculate modulated cutoff frequency
-		modulatedCutoff := filterCutoff
-		if filterModSource != nil {
-			modSignal := filterModSource.prevRawSample * filterModAmount
-			modulatedCutoff = filterCutoff + modSignal
+		modulatedCutoff := f.filterCutoff
+		if f.filterModulated {
+			modulatedCutoff = f.filterCutoff + f.filterModSignal
 			modulatedCutoff = clampF32(modulatedCutoff, MIN_FILTER_CUTOFF, MAX_FILTER_CUTOFF)
 		}
 
-		// Apply 2-pole state variable filter with exponential cutoff mapping
-		cutoff := calculateFilterCutoff(modulatedCutoff)
-		resonance := filterResonance * MAX_RESONANCE
+		// Apply 2-pole state variable filter with exponential cutoff mapping.
+		// Once the cutoff ramp settles the mapping is reused.
+		if !chip.filterCutoffCached || modulatedCutoff != chip.filterCutoffIn {
+			chip.filterCutoffCached = true
+			chip.filterCutoffIn = modulatedCutoff
+			chip.filterCutoffCoef = calculateFilterCutoff(modulatedCutoff)
+		}
+		cutoff := chip.filterCutoffCoef
+		resonance := f.filterResonance * MAX_RESONANCE
 
-		lp := filterLP + cutoff*filterBP
-		hp := (sample - lp) - resonance*filterBP
-		bp := filterBP + cutoff*hp
+		lp := chip.filterLP + cutoff*chip.filterBP
+		hp := (sample - lp) - resonance*chip.filterBP
+		bp := chip.filterBP + cutoff*hp
 
 		// Clamp filter outputs
 		lp = clampF32(lp, MIN_SAMPLE, MAX_SAMPLE)
@@ -2896,7 +3097,7 @@ func (chip *SoundChip) GenerateSample() float32 {
 		chip.filterHP = hp
 
 		// Select filter output
-		switch filterType {
+		switch f.filterType {
 		case 1:
 			sample = lp
 		case 2:
@@ -2905,17 +3106,7 @@ func (chip *SoundChip) GenerateSample() float32 {
 			sample = bp
 		}
 	}
-
-	// Apply reverb effect and final mix
-	wet := chip.applyReverb(sample)
-	sample = sample*(1-reverbMix) + wet*reverbMix
-
-	// Apply showreel master gain and transparent safety compression last.
-	sample = chip.applyMasterNormalizer(sample)
-	chip.mu.Unlock()
-
-	// Clamp final output
-	return clampF32(sample, MIN_SAMPLE, MAX_SAMPLE)
+	return sample
 }
 
 func (chip *SoundChip) applyReverb(input float32) float32 {
@@ -2998,6 +3189,7 @@ func (chip *SoundChip) applyReverb(input float32) float32 {
 }
 
 func (chip *SoundChip) ReadSample() float32 {
+	chip.writeQueue.advance()
 	if chip.audioFrozen.Load() {
 		return 0
 	}
@@ -0,0 +1,231 @@
+package main
+
+import "testing"
+
+type timedWriteRecorder struct {
+	chip  *SoundChip
+	addrs []uint32
+	at    []uint64
+}
+
+func (r *timedWriteRecorder) write(addr, value uint32) {
+	r.addrs = append(r.addrs, addr)
+	r.at = append(r.at, r.chip.writeQueue.played.Load()-1)
+}
+
+func newTimedWriteChip(t *testing.T) (*SoundChip, *uint64) {
+	t.Helper()
+	chip, err := NewSoundChip(AUDIO_BACKEND_OTO)
+	if err != nil {
+		t.Fatalf("NewSoundChip failed: %v", err)
+	}
+	t.Cleanup(chip.Stop)
+	cycles := new(uint64)
+	// Ten cycles per output sample keeps the expected offsets exact.
+	chip.SetWriteClock(func() uint64 { return *cycles }, SAMPLE_RATE*10)
+	return chip, cycles
+}
+
+func TestSoundChip_TimedWriteWithoutClockIsImmediate(t *testing.T) {
+	chip, err := NewSoundChip(AUDIO_BACKEND_OTO)
+	if err != nil {
+		t.Fatalf("NewSoundChip failed: %v", err)
+	}
+	t.Cleanup(chip.Stop)
+	calls := 0
+	chip.TimedWrite(func(addr, value uint32) { calls++ })(0x1234, 1)
+	if calls != 1 {
+		t.Fatalf("write without a clock was deferred")
+	}
+}
+
+func TestSoundChip_TimedWritesLandAtCycleOffsets(t *testing.T) {
+	chip, cycles := newTimedWriteChip(t)
+	rec := &timedWriteRecorder{chip: chip}
+	write := chip.TimedWrite(rec.write)
+
+	// One burst: the CPU issues all three writes before any audio runs.
+	for _, c := range []uint64{0, 100, 250} {
+		*cycles = c
+		write(uint32(c), 0)
+	}
+	if len(rec.at) != 0 {
+		t.Fatalf("writes applied before their sample: %v", rec.at)
+	}
+	for range soundWriteQueueLatency + 40 {
+		chip.ReadSample()
+	}
+	want := []uint64{soundWriteQueueLatency, soundWriteQueueLatency + 10, soundWriteQueueLatency + 25}
+	if len(rec.at) != len(want) {
+		t.Fatalf("applied %d writes, want %d", len(rec.at), len(want))
+	}
+	for i := range want {
+		if rec.at[i] != want[i] || rec.addrs[i] != []uint32{0, 100, 250}[i] {
+			t.Fatalf("write %d (addr %d) applied at sample %d, want %d", i, rec.addrs[i], rec.at[i], want[i])
+		}
+	}
+}
+
+func TestSoundChip_TimedWritesReanchorWhenWriterRacesAhead(t *testing.T) {
+	chip, cycles := newTimedWriteChip(t)
+	rec := &timedWriteRecorder{chip: chip}
+	write := chip.TimedWrite(rec.write)
+
+	write(1, 0)
+	// Ten seconds of emulated time in one burst must not push the write
+	// further than the latency window ahead of playback.
+	*cycles = SAMPLE_RATE * 10 * 10
+	write(2, 0)
+	for range 3 * soundWriteQueueLatency {
+		chip.ReadSample()
+	}
+	if len(rec.at) != 2 || rec.at[1] > 2*soundWriteQueueLatency {
+		t.Fatalf("racing write applied at %v", rec.at)
+	}
+}
+
+func TestSoundChip_AudioCtrlAndClearFlushQueue(t *testing.T) {
+	chip, _ := newTimedWriteChip(t)
+	rec := &timedWriteRecorder{chip: chip}
+	write := chip.TimedWrite(rec.write)
+
+	write(7, 0)
+	write(AUDIO_CTRL, 1)
+	if len(rec.addrs) != 2 || rec.addrs[0] != 7 || rec.addrs[1] != AUDIO_CTRL {
+		t.Fatalf("AUDIO_CTRL did not flush in order: %v", rec.addrs)
+	}
+
+	write(8, 0)
+	chip.ClearWriteClock()
+	if len(rec.addrs) != 3 || rec.addrs[2] != 8 {
+		t.Fatalf("ClearWriteClock left writes pending: %v", rec.addrs)
+	}
+	write(9, 0)
+	if len(rec.addrs) != 4 {
+		t.Fatalf("write after ClearWriteClock was deferred")
+	}
+}
+
+func TestSoundChip_TimedWriteQueueOverflowFlushes(t *testing.T) {
+	chip, _ := newTimedWriteChip(t)
+	rec := &timedWriteRecorder{chip: chip}
+	write := chip.TimedWrite(rec.write)
+	for i := range soundWriteQueueMax + 1 {
+		write(uint32(i), 0)
+	}
+	if len(rec.addrs) != soundWriteQueueMax+1 {
+		t.Fatalf("stalled queue held %d writes", soundWriteQueueMax+1-len(rec.addrs))
+	}
+	for i, a := range rec.addrs {
+		if a != uint32(i) {
+			t.Fatalf("overflow flush reordered writes at %d: %d", i, a)
+		}
+	}
+}
+
+func TestSoundChip_TimedWriteDrivesDAC(t *testing.T) {
+	chip, cycles := newTimedWriteChip(t)
+	write := chip.TimedWrite(chip.HandleRegisterWrite)
+	addr, _ := flexAddrForChannel(0, FLEX_OFF_DAC)
+	write(addr, 64)
+	*cycles = 50
+	write(addr, 0xC0) // -64
+	for range soundWriteQueueLatency + 1 {
+		chip.ReadSample()
+	}
+	if got := chip.channels[0].dacValue; got != 64.0/127.0 {
+		t.Fatalf("dac=%f after first write's sample", got)
+	}
+	for range 5 {
+		chip.ReadSample()
+	}
+	if got := chip.channels[0].dacValue; got != -64.0/127.0 {
+		t.Fatalf("dac=%f after second write's sample", got)
+	}
+}
+
+func TestSoundChip_TimedWritesKeepSpacingWhenWriterRacesAhead(t *testing.T) {
+	chip, cycles := newTimedWriteChip(t)
+	rec := &timedWriteRecorder{chip: chip}
+	write := chip.TimedWrite(rec.write)
+
+	// A burst of three latency windows of emulated time, one write every
+	// ten samples, issued before any audio runs.
+	n := 3 * soundWriteQueueLatency / 10
+	for i := range n {
+		*cycles = uint64(i) * 100
+		write(uint32(i), 0)
+	}
+	for range 5 * soundWriteQueueLatency {
+		chip.ReadSample()
+	}
+	if len(rec.at) != n {
+		t.Fatalf("applied %d writes, want %d", len(rec.at), n)
+	}
+	for i := 1; i < n; i++ {
+		if rec.at[i]-rec.at[i-1] != 10 {
+			t.Fatalf("writes %d,%d applied %d samples apart, want 10", i-1, i, rec.at[i]-rec.at[i-1])
+		}
+	}
+
+	// Once the burst has played out, a write still far ahead is pulled
+	// back to one latency window ahead of playback.
+	played := chip.writeQueue.played.Load()
+	*cycles += 10 * SAMPLE_RATE
+	write(uint32(n), 0)
+	for range 2 * soundWriteQueueLatency {
+		chip.ReadSample()
+	}
+	if len(rec.at) != n+1 || rec.at[n] != played+soundWriteQueueLatency {
+		t.Fatalf("write after the burst applied at %v, want sample %d", rec.at[n:], played+soundWriteQueueLatency)
+	}
+}
+
+func TestSoundChip_TimedWritesCalibrateToWriterSpeed(t *testing.T) {
+	chip, cycles := newTimedWriteChip(t)
+	rec := &timedWriteRecorder{chip: chip}
+	write := chip.TimedWrite(rec.write)
+
+	// The writer runs four times faster than its nominal clock: one write
+	// every 4000 cycles, 100 output samples of playback apart. At the
+	// nominal rate those stamps would be 400 samples apart.
+	n := 4 * soundWriteClockCalibration / 100
+	for i := range n {
+		write(uint32(i), 0)
+		*cycles += 4000
+		for range 100 {
+			chip.ReadSample()
+		}
+	}
+	if got := chip.writeQueue.rate; got != SAMPLE_RATE*40 {
+		t.Fatalf("calibrated rate %d, want %d", got, SAMPLE_RATE*40)
+	}
+	// Once calibrated, each write lands one latency window after it was
+	// issued, rather than wherever the pull-back heuristics left it.
+	for i := len(rec.at) - 50; i < len(rec.at); i++ {
+		if lag := rec.at[i] - uint64(rec.addrs[i])*100; lag != soundWriteQueueLatency {
+			t.Fatalf("write %d applied %d samples after it was issued, want %d", rec.addrs[i], lag, soundWriteQueueLatency)
+		}
+	}
+}
+
+func TestSoundChip_WriteClockOnlyFromInterpreter(t *testing.T) {
+	bus := NewMachineBus()
+	r6502 := NewCPU6502Runner(bus, CPU6502Config{})
+	if now, _ := r6502.SoundWriteClock(); now == nil {
+		t.Fatalf("6502 interpreter has no write clock")
+	}
+	r6502.JITEnabled = true
+	if now, _ := r6502.SoundWriteClock(); (now == nil) != jit6502Available {
+		t.Fatalf("6502 JIT write clock=%v with JIT available=%v", now != nil, jit6502Available)
+	}
+
+	rz80 := NewCPUZ80Runner(bus, CPUZ80Config{})
+	if now, _ := rz80.SoundWriteClock(); now == nil {
+		t.Fatalf("Z80 interpreter has no write clock")
+	}
+	rz80 = NewCPUZ80Runner(bus, CPUZ80Config{JITEnabled: true})
+	if now, _ := rz80.SoundWriteClock(); (now == nil) != z80JitAvailable {
+		t.Fatalf("Z80 JIT write clock=%v with JIT available=%v", now != nil, z80JitAvailable)
+	}
+}
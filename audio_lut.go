@@ -135,3 +135,19 @@ func polyBLEP32(t, dt float32) float32 {
 	}
 	return 0.0
 }
+
+// polyBLAMP32 is the integrated polyBLEP residual for a unit slope change, in
+// per-sample units. Multiply by (slope change per cycle) * dt.
+// t is the normalized phase position (0.0-1.0), dt the phase increment per sample.
+//
+//go:nosplit
+func polyBLAMP32(t, dt float32) float32 {
+	if t < dt {
+		x := 1.0 - t/dt
+		return x * x * x * (1.0 / 6.0)
+	} else if t > 1.0-dt {
+		x := 1.0 + (t-1.0)/dt
+		return x * x * x * (1.0 / 6.0)
+	}
+	return 0.0
+}
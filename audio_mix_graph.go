@@ -0,0 +1,254 @@
+// audio_mix_graph.go - Block render graph with parallel sample mixers
+
+/*
+ReadSamples renders a whole output buffer in three stages:
+
+ 1. Self-contained synths render the block into their own buffers on the
+    mix worker pool: the SFX trigger block and every sample mixer that
+    implements SampleBlockRenderer (the MIDI and AHX engines).
+ 2. Meanwhile the calling goroutine runs the serial part per sample: the
+    timed-write queue, the remaining sample tickers, flex/SN channel
+    synthesis, and any plain sample mixer, whose MixSample is stored in its
+    block buffer. The register-mapped chips (SID including the extra
+    NewSIDEngineMulti chips, POKEY, TED, PSG, MOD and WAV) have no mixer of
+    their own: their tickers write the shared flex channels, whose voices are
+    averaged with the SN76489 under chip.mu, so they always stay here.
+ 3. After the join, each sample gets the SFX contribution and then the mixer
+    contributions in registration order, matching GenerateSample, and the
+    effects and master stages run over the block (see audio_reverb_block.go).
+
+Every block renderer writes only its own buffer and the final sum always runs
+in the same order, so output is identical for any worker count, including
+zero (renderers run inline).
+
+BenchmarkSoundChipMixGraph reports max-realtime-chips: how many dense MIDI
+synths, on top of one flex voice and reverb, render 512-sample blocks faster
+than real time. Measured on a single-core Xeon host the figure is 32 with
+the block renderers inline; that host has no mix workers, so the parallel
+figure has to be taken on a multi-core machine.
+*/
+
+package main
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+)
+
+// SampleBlockRenderer is a SampleMixer that touches no SoundChip state and
+// can render a block at once. RenderMixBlock(out) must produce exactly what
+// len(out) rounds of the renderer's own TickSample (if it is also registered
+// as a ticker) followed by MixSample would. ReadSamples then skips its
+// per-sample tick.
+type SampleBlockRenderer interface {
+	SampleMixer
+	RenderMixBlock(out []float32)
+}
+
+// mixWorkerPool runs block renderer jobs for ReadSamples.
+type mixWorkerPool struct {
+	jobs chan mixJob
+}
+
+type mixJob struct {
+	r   SampleBlockRenderer
+	out []float32
+	wg  *sync.WaitGroup
+}
+
+func newMixWorkerPool(workers int) *mixWorkerPool {
+	p := &mixWorkerPool{jobs: make(chan mixJob, workers*2)}
+	for range workers {
+		go func() {
+			for job := range p.jobs {
+				job.r.RenderMixBlock(job.out)
+				job.wg.Done()
+			}
+		}()
+	}
+	return p
+}
+
+// defaultMixWorkers leaves a core for the audio thread and one for the CPU.
+func defaultMixWorkers() int {
+	return max(0, min(runtime.GOMAXPROCS(0)-2, 8))
+}
+
+// mixGraph is the audio-thread scratch state for ReadSamples.
+type mixGraph struct {
+	pool    atomic.Pointer[mixWorkerPool]
+	poolSet atomic.Bool
+	tickers []SampleTicker
+	slots   []mixSlot
+	plain   []int
+	frames  []sampleFrame
+	bufs    [][]float32
+}
+
+// mixSlot is one stage 3 contribution, in mixing order, rendered into the
+// matching bufs entry: by r in stage 1, or per sample by m in stage 2 when
+// the mixer has no block renderer.
+type mixSlot struct {
+	r SampleBlockRenderer
+	m SampleMixer
+}
+
+// has reports whether ticker t is one of the registered mixers, i.e. a block
+// renderer whose ticking happens inside RenderMixBlock.
+func (h *sampleMixerListHolder) has(t SampleTicker) bool {
+	r, ok := t.(SampleBlockRenderer)
+	if !ok {
+		return false
+	}
+	for _, m := range h.mixers {
+		if m == SampleMixer(r) {
+			return true
+		}
+	}
+	return false
+}
+
+// rendersTicker reports whether ticker t is one of this block's renderers,
+// whose ticking happens inside RenderMixBlock.
+func (g *mixGraph) rendersTicker(t SampleTicker) bool {
+	r, ok := t.(SampleBlockRenderer)
+	if !ok {
+		return false
+	}
+	for _, slot := range g.slots {
+		if slot.r == r {
+			return true
+		}
+	}
+	return false
+}
+
+// SetMixWorkers sets how many goroutines render block mixers in parallel.
+// Zero renders them inline on the audio thread. Output does not depend on
+// the setting. Call it while audio is stopped.
+func (chip *SoundChip) SetMixWorkers(workers int) {
+	var p *mixWorkerPool
+	if workers > 0 {
+		p = newMixWorkerPool(workers)
+	}
+	if old := chip.mixGraph.pool.Swap(p); old != nil {
+		close(old.jobs)
+	}
+	chip.mixGraph.poolSet.Store(true)
+}
+
+func (chip *SoundChip) mixPool() *mixWorkerPool {
+	g := &chip.mixGraph
+	if !g.poolSet.Load() {
+		chip.SetMixWorkers(defaultMixWorkers())
+	}
+	return g.pool.Load()
+}
+
+// ReadSamples fills out with consecutive output samples, matching repeated
+// ReadSample calls. The SFX block and block renderers run on the mix workers
+// while channel synthesis runs here.
+func (chip *SoundChip) ReadSamples(out []float32) {
+	holder, _ := chip.sampleMixer.Load().(*sampleMixerListHolder)
+	g := &chip.mixGraph
+	// Mid-block enable/freeze changes would let renderers run ahead of a
+	// silenced chip, so blocks only start on an audible chip.
+	if !chip.enabled.Load() || chip.audioFrozen.Load() {
+		for i := range out {
+			out[i] = chip.ReadSample()
+		}
+		return
+	}
+	var mixers []SampleMixer
+	if holder != nil {
+		mixers = holder.mixers
+	}
+
+	// Stage 1: block renderers, on workers or inline. The SFX block comes
+	// first so that stage 3 adds it ahead of the mixers. A plain mixer's
+	// MixSample may depend on its ticker running in lockstep, so it is left
+	// for stage 2.
+	g.slots = g.slots[:0]
+	g.plain = g.plain[:0]
+	if chip.sfx != nil {
+		g.slots = append(g.slots, mixSlot{r: chip.sfx})
+	}
+	for _, m := range mixers {
+		if m == nil {
+			continue
+		}
+		r, _ := m.(SampleBlockRenderer)
+		if r == nil {
+			g.plain = append(g.plain, len(g.slots))
+		}
+		g.slots = append(g.slots, mixSlot{r: r, m: m})
+	}
+	for len(g.bufs) < len(g.slots) {
+		g.bufs = append(g.bufs, nil)
+	}
+	var wg sync.WaitGroup
+	pool := chip.mixPool()
+	for k, slot := range g.slots {
+		if cap(g.bufs[k]) < len(out) {
+			g.bufs[k] = make([]float32, len(out))
+		}
+		r := slot.r
+		if r == nil {
+			continue
+		}
+		buf := g.bufs[k][:len(out)]
+		if pool == nil {
+			r.RenderMixBlock(buf)
+			continue
+		}
+		wg.Add(1)
+		pool.jobs <- mixJob{r: r, out: buf, wg: &wg}
+	}
+
+	// Stage 2: serial tickers, channel synthesis and plain mixers.
+	g.tickers = g.tickers[:0]
+	if th, ok := chip.sampleTicker.Load().(*sampleTickerListHolder); ok {
+		for _, t := range th.tickers {
+			if t != nil && !g.rendersTicker(t) {
+				g.tickers = append(g.tickers, t)
+			}
+		}
+	}
+	if cap(g.frames) < len(out) {
+		g.frames = make([]sampleFrame, len(out))
+	}
+	frames := g.frames[:len(out)]
+	for j := range frames {
+		chip.writeQueue.advance()
+		for _, t := range g.tickers {
+			t.TickSample()
+		}
+		chip.mu.Lock()
+		chip.synthFrameLocked(&frames[j])
+		for _, k := range g.plain {
+			g.bufs[k][j] = g.slots[k].m.MixSample()
+		}
+		chip.mu.Unlock()
+	}
+	wg.Wait()
+
+	// Stage 3: SFX and mixers in registration order, then the effects chain
+	// over the whole block.
+	for j := range frames {
+		sample := frames[j].pre
+		for k := range g.slots {
+			sample = clampF32(sample+g.bufs[k][j], MIN_SAMPLE, MAX_SAMPLE)
+		}
+		out[j] = sample
+	}
+	chip.mu.Lock()
+	chip.finishBlockLocked(frames, out)
+	chip.mu.Unlock()
+
+	if tap, ok := chip.sampleTap.Load().(*sampleTapHolder); ok && tap.tap != nil {
+		for _, v := range out {
+			tap.tap(v)
+		}
+	}
+}
@@ -0,0 +1,191 @@
+package main
+
+import (
+	"fmt"
+	"testing"
+	"time"
+)
+
+// newMixGraphChip builds an enabled chip with one flex tone plus reverb and
+// `synths` MIDI engines registered as block-rendering mixers and tickers.
+func newMixGraphChip(t testing.TB, synths int) *SoundChip {
+	t.Helper()
+	chip, err := NewSoundChip(AUDIO_BACKEND_NULL)
+	if err != nil {
+		t.Fatal(err)
+	}
+	chip.enabled.Store(true)
+	for _, w := range []struct{ off, val uint32 }{
+		{FLEX_OFF_FREQ, 440 * 256},
+		{FLEX_OFF_VOL, 200},
+		{FLEX_OFF_CTRL, 3},
+	} {
+		addr, _ := flexAddrForChannel(0, w.off)
+		chip.HandleRegisterWrite(addr, w.val)
+	}
+	chip.reverbMix = 0.3
+	for i := range synths {
+		e := NewMIDIEngine(nil, SAMPLE_RATE)
+		e.LoadMIDI(midiTestChordFile(0, 8+i, 1<<40))
+		e.SetPlaying(true)
+		key := fmt.Sprintf("midi%d", i)
+		chip.RegisterSampleTicker(key, e)
+		chip.RegisterSampleMixer(key, e)
+	}
+	return chip
+}
+
+func TestSoundChip_ReadSamplesMatchesReadSample(t *testing.T) {
+	const blocks, blockLen = 6, 512
+	ref := newMixGraphChip(t, 3)
+	want := make([]float32, blocks*blockLen)
+	for i := range want {
+		want[i] = ref.ReadSample()
+	}
+
+	for _, workers := range []int{0, 1, 4} {
+		chip := newMixGraphChip(t, 3)
+		chip.SetMixWorkers(workers)
+		got := make([]float32, blocks*blockLen)
+		for b := range blocks {
+			chip.ReadSamples(got[b*blockLen : (b+1)*blockLen])
+		}
+		for i := range want {
+			if got[i] != want[i] {
+				t.Fatalf("workers=%d sample %d = %v, want %v", workers, i, got[i], want[i])
+			}
+		}
+		chip.SetMixWorkers(0)
+	}
+}
+
+// startMixGraphSFX loops a ramp on two SFX channels at different rates.
+func startMixGraphSFX(chip *SoundChip) {
+	bus := NewMachineBus()
+	chip.AttachBus(bus)
+	const ptr, n = 0x2000, 64
+	for i := range n {
+		bus.memory[ptr+i] = byte(i*4 - 128)
+	}
+	for ch, freq := range []uint32{SAMPLE_RATE / 2, SAMPLE_RATE * 3 / 4} {
+		base := IE_SFX_CH_BASE + uint32(ch)*IE_SFX_CH_STRIDE
+		chip.sfx.HandleWrite(base+SFX_PTR, ptr)
+		chip.sfx.HandleWrite(base+SFX_LEN, n)
+		chip.sfx.HandleWrite(base+SFX_LOOP_PTR, ptr)
+		chip.sfx.HandleWrite(base+SFX_LOOP_LEN, n)
+		chip.sfx.HandleWrite(base+SFX_FREQ, freq)
+		chip.sfx.HandleWrite(base+SFX_VOL, 180)
+		chip.sfx.HandleWrite(base+SFX_CTRL, SFX_CTRL_TRIGGER|SFX_CTRL_LOOP_EN)
+	}
+}
+
+func TestSoundChip_ReadSamplesRendersSFXBlock(t *testing.T) {
+	const blocks, blockLen = 4, 256
+	ref := newMixGraphChip(t, 2)
+	startMixGraphSFX(ref)
+	want := make([]float32, blocks*blockLen)
+	for i := range want {
+		want[i] = ref.ReadSample()
+	}
+
+	for _, workers := range []int{0, 2} {
+		chip := newMixGraphChip(t, 2)
+		startMixGraphSFX(chip)
+		chip.SetMixWorkers(workers)
+		got := make([]float32, blocks*blockLen)
+		for b := range blocks {
+			chip.ReadSamples(got[b*blockLen : (b+1)*blockLen])
+		}
+		for i := range want {
+			if got[i] != want[i] {
+				t.Fatalf("workers=%d sample %d = %v, want %v", workers, i, got[i], want[i])
+			}
+		}
+		if chip.sfx.MixSample() != ref.sfx.MixSample() {
+			t.Fatalf("workers=%d SFX mix = %v, want %v", workers, chip.sfx.MixSample(), ref.sfx.MixSample())
+		}
+		chip.SetMixWorkers(0)
+	}
+}
+
+// lockstepMixer's output depends on its ticker having run for the same sample.
+type lockstepMixer struct{ n int }
+
+func (m *lockstepMixer) TickSample()        { m.n++ }
+func (m *lockstepMixer) MixSample() float32 { return float32(m.n%64) / 256 }
+
+func TestSoundChip_ReadSamplesMixesPlainMixerInLockstep(t *testing.T) {
+	const blocks, blockLen = 4, 256
+	newChip := func() *SoundChip {
+		chip := newMixGraphChip(t, 2)
+		m := &lockstepMixer{}
+		chip.RegisterSampleTicker("plain", m)
+		chip.RegisterSampleMixer("plain", m)
+		chip.RegisterSampleMixer("func", mixerFunc(func() float32 { return 0.01 }))
+		return chip
+	}
+	ref := newChip()
+	want := make([]float32, blocks*blockLen)
+	for i := range want {
+		want[i] = ref.ReadSample()
+	}
+
+	for _, workers := range []int{0, 2} {
+		chip := newChip()
+		chip.SetMixWorkers(workers)
+		got := make([]float32, blocks*blockLen)
+		for b := range blocks {
+			chip.ReadSamples(got[b*blockLen : (b+1)*blockLen])
+		}
+		if len(chip.mixGraph.plain) != 2 {
+			t.Fatalf("workers=%d: %d plain mixers in the graph, want 2", workers, len(chip.mixGraph.plain))
+		}
+		for i := range want {
+			if got[i] != want[i] {
+				t.Fatalf("workers=%d sample %d = %v, want %v", workers, i, got[i], want[i])
+			}
+		}
+		chip.SetMixWorkers(0)
+	}
+}
+
+type mixerFunc func() float32
+
+func (f mixerFunc) MixSample() float32 { return f() }
+
+// BenchmarkSoundChipMixGraph reports how many MIDI synths (each holding a
+// dense chord) ReadSamples sustains in real time, serially and, on hosts
+// with spare cores, with the default worker pool.
+func BenchmarkSoundChipMixGraph(b *testing.B) {
+	const blockLen = 512
+	blockDur := time.Duration(blockLen) * time.Second / SAMPLE_RATE
+	counts := []int{0}
+	if w := defaultMixWorkers(); w > 0 {
+		counts = append(counts, w)
+	}
+	for _, workers := range counts {
+		b.Run(fmt.Sprintf("workers=%d", workers), func(b *testing.B) {
+			maxChips := 0
+			for range b.N {
+				maxChips = 0
+				for n := 1; n <= 256; n *= 2 {
+					chip := newMixGraphChip(b, n)
+					chip.SetMixWorkers(workers)
+					buf := make([]float32, blockLen)
+					chip.ReadSamples(buf) // warm up
+					const reps = 16
+					start := time.Now()
+					for range reps {
+						chip.ReadSamples(buf)
+					}
+					chip.SetMixWorkers(0)
+					if time.Since(start)/reps > blockDur {
+						break
+					}
+					maxChips = n
+				}
+			}
+			b.ReportMetric(float64(maxChips), "max-realtime-chips")
+		})
+	}
+}
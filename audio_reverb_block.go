@@ -0,0 +1,126 @@
+// audio_reverb_block.go - Block processing for the post-mix effects chain
+
+package main
+
+// finishBlockLocked is finishFrameLocked over a block: samples holds the
+// mixed input and receives the clamped output. The SID mixer, overdrive and
+// recursive filter still step per sample; the reverb runs stage by stage
+// over the whole block. Caller holds chip.mu.
+func (chip *SoundChip) finishBlockLocked(frames []sampleFrame, samples []float32) {
+	for j := range samples {
+		samples[j] = chip.preReverbLocked(&frames[j], samples[j])
+	}
+	if cap(chip.reverbScratch) < 2*len(samples) {
+		chip.reverbScratch = make([]float32, 2*len(samples))
+	}
+	wet := chip.reverbScratch[:len(samples)]
+	delayed := chip.reverbScratch[len(samples) : 2*len(samples)]
+	// applyReverb bypasses, without advancing the delay lines, whenever the
+	// mix is zero. A REVERB_MIX write inside the block can flip that, so
+	// the block is split into runs that agree with the per-frame mix.
+	for j := 0; j < len(samples); {
+		bypass := frames[j].reverbMix == 0
+		k := j + 1
+		for k < len(samples) && (frames[k].reverbMix == 0) == bypass {
+			k++
+		}
+		if bypass {
+			copy(wet[j:k], samples[j:k])
+		} else {
+			chip.reverbRunLocked(samples[j:k], wet[j:k], delayed[j:k])
+		}
+		j = k
+	}
+	for j := range samples {
+		mix := frames[j].reverbMix
+		sample := samples[j]*(1-mix) + wet[j]*mix
+		samples[j] = clampF32(chip.applyMasterNormalizer(sample), MIN_SAMPLE, MAX_SAMPLE)
+	}
+}
+
+// reverbBlockLocked computes out[j] = applyReverb(in[j]) for each j in turn,
+// bit-identical to the per-sample path. Every delay line is walked in
+// contiguous runs up to its wrap point; within a run no slot repeats, so the
+// pre-delay is two copies and the comb bank is the combRun kernel. delayed is
+// scratch of len(in).
+func (chip *SoundChip) reverbBlockLocked(in, out, delayed []float32) {
+	if chip.reverbMix == 0 {
+		copy(out, in)
+		return
+	}
+	chip.reverbRunLocked(in, out, delayed)
+}
+
+// reverbRunLocked is reverbBlockLocked without the bypass check.
+func (chip *SoundChip) reverbRunLocked(in, out, delayed []float32) {
+	n := len(in)
+
+	// Pre-delay
+	for j := 0; j < n; {
+		p := chip.preDelayPos
+		run := min(n-j, len(chip.preDelayBuf)-p)
+		copy(delayed[j:j+run], chip.preDelayBuf[p:p+run])
+		copy(chip.preDelayBuf[p:p+run], in[j:j+run])
+		j += run
+		if chip.preDelayPos = p + run; chip.preDelayPos >= len(chip.preDelayBuf) {
+			chip.preDelayPos = 0
+		}
+	}
+
+	// Parallel comb bank, summed in filter order like applyReverb
+	clear(out)
+	for i := range chip.combFilters {
+		comb := &chip.combFilters[i]
+		for j := 0; j < n; {
+			run := min(n-j, len(comb.buffer)-comb.pos)
+			combRun(comb.buffer[comb.pos:comb.pos+run], delayed[j:j+run], out[j:j+run], comb.decay)
+			j += run
+			if comb.pos += run; comb.pos >= len(comb.buffer) {
+				comb.pos = 0
+			}
+		}
+	}
+
+	// Series allpass diffusion; each stage feeds the next sample by sample
+	for i := range chip.allpassBuf {
+		buf := chip.allpassBuf[i]
+		pos := chip.allpassPos[i]
+		for j := range out {
+			aDelay := buf[pos]
+			buf[pos] = out[j] + aDelay*ALLPASS_COEF
+			out[j] = aDelay - out[j]
+			if pos++; pos >= len(buf) {
+				pos = 0
+			}
+		}
+		chip.allpassPos[i] = pos
+	}
+
+	for j := range out {
+		out[j] *= REVERB_ATTENUATION // Attenuate to prevent overflow
+	}
+}
+
+// combRunGo is the portable comb kernel: for each i, feed in[i] into the
+// delay line with feedback and accumulate the delayed tap into out[i].
+func combRunGo(buf, in, out []float32, decay float32) {
+	in = in[:len(buf)]
+	out = out[:len(buf)]
+	i := 0
+	for ; i+4 <= len(buf); i += 4 {
+		d0, d1, d2, d3 := buf[i], buf[i+1], buf[i+2], buf[i+3]
+		buf[i] = in[i] + d0*decay
+		buf[i+1] = in[i+1] + d1*decay
+		buf[i+2] = in[i+2] + d2*decay
+		buf[i+3] = in[i+3] + d3*decay
+		out[i] += d0
+		out[i+1] += d1
+		out[i+2] += d2
+		out[i+3] += d3
+	}
+	for ; i < len(buf); i++ {
+		d := buf[i]
+		buf[i] = in[i] + d*decay
+		out[i] += d
+	}
+}
@@ -0,0 +1,18 @@
+//go:build amd64
+
+package main
+
+// combRunSSE is the SSE comb kernel in audio_reverb_comb_amd64.s; n floats
+// from each pointer, four lanes at a time with a scalar tail.
+//
+//go:noescape
+func combRunSSE(buf, in, out *float32, n int, decay float32)
+
+func combRun(buf, in, out []float32, decay float32) {
+	if len(buf) == 0 {
+		return
+	}
+	_ = in[len(buf)-1]
+	_ = out[len(buf)-1]
+	combRunSSE(&buf[0], &in[0], &out[0], len(buf), decay)
+}
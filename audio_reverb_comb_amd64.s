@@ -0,0 +1,54 @@
+// audio_reverb_comb_amd64.s - SSE comb filter kernel for block reverb
+
+#include "textflag.h"
+
+// func combRunSSE(buf, in, out *float32, n int, decay float32)
+//
+// for i < n: d := buf[i]; buf[i] = in[i] + d*decay; out[i] += d
+// Separate MULPS/ADDPS (no FMA) keeps results identical to the Go path.
+TEXT ·combRunSSE(SB), NOSPLIT, $0-36
+    MOVQ buf+0(FP), DI
+    MOVQ in+8(FP), SI
+    MOVQ out+16(FP), DX
+    MOVQ n+24(FP), CX
+    MOVSS decay+32(FP), X0
+    SHUFPS $0x00, X0, X0
+    XORQ AX, AX
+    MOVQ CX, BX
+    SHRQ $2, BX
+    JZ tail
+
+loop4:
+    MOVUPS (DI)(AX*1), X1
+    MOVUPS (SI)(AX*1), X2
+    MOVAPS X1, X3
+    MULPS X0, X3
+    ADDPS X3, X2
+    MOVUPS X2, (DI)(AX*1)
+    MOVUPS (DX)(AX*1), X4
+    ADDPS X1, X4
+    MOVUPS X4, (DX)(AX*1)
+    ADDQ $16, AX
+    DECQ BX
+    JNZ loop4
+
+tail:
+    ANDQ $3, CX
+    JZ done
+
+loop1:
+    MOVSS (DI)(AX*1), X1
+    MOVSS (SI)(AX*1), X2
+    MOVSS X1, X3
+    MULSS X0, X3
+    ADDSS X3, X2
+    MOVSS X2, (DI)(AX*1)
+    MOVSS (DX)(AX*1), X4
+    ADDSS X1, X4
+    MOVSS X4, (DX)(AX*1)
+    ADDQ $4, AX
+    DECQ CX
+    JNZ loop1
+
+done:
+    RET
@@ -0,0 +1,7 @@
+//go:build !amd64
+
+package main
+
+func combRun(buf, in, out []float32, decay float32) {
+	combRunGo(buf, in, out, decay)
+}
@@ -0,0 +1,210 @@
+// audio_telemetry.go - Audio output render-time, underrun and latency telemetry
+
+/*
+The output backend reports every render callback (how long ReadSamples took
+for how many samples) and periodically samples its output ring fill level.
+From that the telemetry keeps:
+
+  - a log2 histogram of callback render times, with last/max/p50/p99
+  - deadline misses: callbacks that took longer to render than the audio
+    they produced
+  - underruns: fill-level samples that found the ring empty while playing
+  - callback jitter: a running average of how far callback spacing strays
+    from the audio duration of the previous callback
+  - an end-to-end latency estimate: queued frames plus one callback's worth
+
+Counters are atomics written by the audio thread and read by the status bar,
+SYSINFO MMIO and the monitor without locking.
+
+With adaptive buffering (-audio-adaptive) audioBufferController grows the
+output buffer on any miss, underrun or high jitter and shrinks it again after
+a calm stretch, so each host settles near the smallest buffer it can sustain.
+*/
+
+package main
+
+import (
+	"sync/atomic"
+	"time"
+)
+
+const (
+	audioRenderBuckets   = 12 // bucket i < 32µs<<i; last bucket is open-ended
+	audioRenderBucketMin = 32 * time.Microsecond
+	audioTroubleWindow   = 2 * time.Second // status bar XRUN hold time
+
+	audioBufferMinFrames = 256
+	audioBufferMaxFrames = 16384
+	audioBufferInitial   = 2048
+	audioBufferCalmSteps = 50 // controller steps without trouble before shrinking
+)
+
+// audioAdaptiveBufferEnabled selects adaptive output buffering (-audio-adaptive).
+var audioAdaptiveBufferEnabled atomic.Bool
+
+type audioTelemetry struct {
+	callbacks      atomic.Uint64
+	samples        atomic.Uint64
+	deadlineMisses atomic.Uint64
+	underruns      atomic.Uint64
+	renderHist     [audioRenderBuckets]atomic.Uint64
+	renderLastNs   atomic.Int64
+	renderMaxNs    atomic.Int64
+	jitterNs       atomic.Int64
+	chunkFrames    atomic.Int64
+	fillFrames     atomic.Int64
+	bufferFrames   atomic.Int64 // output buffer target; 0 while the backend default applies
+	lastTrouble    atomic.Int64 // UnixNano of the last miss or underrun
+
+	lastCallback int64 // UnixNano; audio thread only
+	lastDuration int64 // ns of audio produced by the previous callback
+}
+
+// AudioTelemetrySnapshot is a point-in-time copy of the output telemetry.
+type AudioTelemetrySnapshot struct {
+	Callbacks      uint64
+	Samples        uint64
+	DeadlineMisses uint64
+	Underruns      uint64
+	RenderLast     time.Duration
+	RenderMax      time.Duration
+	RenderP50      time.Duration
+	RenderP99      time.Duration
+	Jitter         time.Duration
+	FillFrames     int
+	BufferFrames   int
+	Latency        time.Duration
+	Histogram      [audioRenderBuckets]uint64
+}
+
+func audioRenderBucket(d time.Duration) int {
+	i := 0
+	for limit := audioRenderBucketMin; d >= limit && i < audioRenderBuckets-1; limit <<= 1 {
+		i++
+	}
+	return i
+}
+
+// audioRenderBucketLimit is the upper bound of bucket i (the last bucket
+// reports its lower bound).
+func audioRenderBucketLimit(i int) time.Duration {
+	return audioRenderBucketMin << min(i, audioRenderBuckets-2)
+}
+
+// recordRender logs one render callback that produced n samples and took
+// from start until now. Called from the audio thread only.
+func (t *audioTelemetry) recordRender(start time.Time, n int) {
+	now := time.Now()
+	took := now.Sub(start)
+	t.callbacks.Add(1)
+	t.samples.Add(uint64(n))
+	t.renderHist[audioRenderBucket(took)].Add(1)
+	t.renderLastNs.Store(int64(took))
+	if int64(took) > t.renderMaxNs.Load() {
+		t.renderMaxNs.Store(int64(took))
+	}
+	t.chunkFrames.Store(int64(n))
+
+	audio := int64(n) * int64(time.Second) / SAMPLE_RATE
+	if int64(took) > audio {
+		t.deadlineMisses.Add(1)
+		t.lastTrouble.Store(now.UnixNano())
+	}
+	if t.lastCallback != 0 {
+		dev := now.UnixNano() - t.lastCallback - t.lastDuration
+		if dev < 0 {
+			dev = -dev
+		}
+		j := t.jitterNs.Load()
+		t.jitterNs.Store(j + (dev-j)/8)
+	}
+	t.lastCallback = now.UnixNano()
+	t.lastDuration = audio
+}
+
+// recordFill logs a sample of the backend's queued output frames.
+func (t *audioTelemetry) recordFill(frames int, playing bool) {
+	t.fillFrames.Store(int64(frames))
+	if playing && frames == 0 && t.callbacks.Load() > 0 {
+		t.underruns.Add(1)
+		t.lastTrouble.Store(time.Now().UnixNano())
+	}
+}
+
+func (t *audioTelemetry) snapshot() AudioTelemetrySnapshot {
+	s := AudioTelemetrySnapshot{
+		Callbacks:      t.callbacks.Load(),
+		Samples:        t.samples.Load(),
+		DeadlineMisses: t.deadlineMisses.Load(),
+		Underruns:      t.underruns.Load(),
+		RenderLast:     time.Duration(t.renderLastNs.Load()),
+		RenderMax:      time.Duration(t.renderMaxNs.Load()),
+		Jitter:         time.Duration(t.jitterNs.Load()),
+		FillFrames:     int(t.fillFrames.Load()),
+		BufferFrames:   int(t.bufferFrames.Load()),
+	}
+	var total uint64
+	for i := range t.renderHist {
+		s.Histogram[i] = t.renderHist[i].Load()
+		total += s.Histogram[i]
+	}
+	var seen uint64
+	for i, c := range s.Histogram {
+		seen += c
+		if s.RenderP50 == 0 && seen*2 >= total && total > 0 {
+			s.RenderP50 = audioRenderBucketLimit(i)
+		}
+		if seen*100 >= total*99 && total > 0 {
+			s.RenderP99 = audioRenderBucketLimit(i)
+			break
+		}
+	}
+	queued := s.FillFrames + int(t.chunkFrames.Load())
+	s.Latency = time.Duration(queued) * time.Second / SAMPLE_RATE
+	return s
+}
+
+// troubleRecently reports a miss or underrun within audioTroubleWindow.
+func (t *audioTelemetry) troubleRecently() bool {
+	last := t.lastTrouble.Load()
+	return last != 0 && time.Since(time.Unix(0, last)) < audioTroubleWindow
+}
+
+// AudioTelemetry returns the output telemetry for this chip's backend.
+func (chip *SoundChip) AudioTelemetry() AudioTelemetrySnapshot {
+	return chip.telemetry.snapshot()
+}
+
+// audioBufferController sizes the output buffer from observed trouble.
+type audioBufferController struct {
+	frames  int
+	calm    int
+	trouble uint64 // misses+underruns at the previous step
+}
+
+func newAudioBufferController() *audioBufferController {
+	return &audioBufferController{frames: audioBufferInitial}
+}
+
+// step returns the buffer size to use next. Any new miss or underrun, or
+// jitter above a quarter of the buffer, doubles it; a calm stretch with
+// jitter under an eighth shrinks it by a quarter.
+func (c *audioBufferController) step(t *audioTelemetry) int {
+	trouble := t.deadlineMisses.Load() + t.underruns.Load()
+	bufDur := time.Duration(c.frames) * time.Second / SAMPLE_RATE
+	jitter := time.Duration(t.jitterNs.Load())
+	switch {
+	case trouble != c.trouble || jitter > bufDur/4:
+		c.frames = min(c.frames*2, audioBufferMaxFrames)
+		c.calm = 0
+	case jitter < bufDur/8:
+		if c.calm++; c.calm >= audioBufferCalmSteps {
+			c.frames = max(c.frames*3/4, audioBufferMinFrames)
+			c.calm = 0
+		}
+	default:
+		c.calm = 0
+	}
+	c.trouble = trouble
+	return c.frames
+}
@@ -0,0 +1,121 @@
+package main
+
+import (
+	"testing"
+	"time"
+)
+
+func TestAudioTelemetry_RenderHistogramAndPercentiles(t *testing.T) {
+	var tel audioTelemetry
+	now := time.Now()
+	for range 98 {
+		tel.recordRender(now.Add(-40*time.Microsecond), 512)
+	}
+	tel.recordRender(now.Add(-5*time.Millisecond), 512)
+	tel.recordRender(now.Add(-50*time.Millisecond), 512) // longer than 512 samples of audio
+
+	s := tel.snapshot()
+	if s.Callbacks != 100 || s.Samples != 100*512 {
+		t.Fatalf("callbacks=%d samples=%d", s.Callbacks, s.Samples)
+	}
+	if s.DeadlineMisses != 1 {
+		t.Fatalf("deadline misses = %d, want 1", s.DeadlineMisses)
+	}
+	if s.RenderP50 != 64*time.Microsecond {
+		t.Fatalf("p50 = %v, want 64µs bucket", s.RenderP50)
+	}
+	if s.RenderP99 < 4*time.Millisecond || s.RenderP99 > 8192*time.Microsecond {
+		t.Fatalf("p99 = %v, want the 5ms bucket", s.RenderP99)
+	}
+	if s.RenderMax < 50*time.Millisecond {
+		t.Fatalf("max = %v", s.RenderMax)
+	}
+	if !tel.troubleRecently() {
+		t.Fatal("deadline miss not flagged as recent trouble")
+	}
+}
+
+func TestAudioTelemetry_UnderrunsAndLatency(t *testing.T) {
+	var tel audioTelemetry
+	tel.recordFill(0, true)
+	if tel.underruns.Load() != 0 {
+		t.Fatal("empty ring before the first callback counted as an underrun")
+	}
+	tel.recordRender(time.Now(), SAMPLE_RATE/100)
+	tel.recordFill(0, false)
+	tel.recordFill(0, true)
+	tel.recordFill(SAMPLE_RATE/50, true)
+	s := tel.snapshot()
+	if s.Underruns != 1 {
+		t.Fatalf("underruns = %d, want 1", s.Underruns)
+	}
+	if want := 30 * time.Millisecond; s.Latency != want {
+		t.Fatalf("latency = %v, want %v", s.Latency, want)
+	}
+}
+
+func TestAudioBufferController_GrowsOnTroubleAndShrinksWhenCalm(t *testing.T) {
+	var tel audioTelemetry
+	c := newAudioBufferController()
+	tel.underruns.Add(1)
+	if got := c.step(&tel); got != audioBufferInitial*2 {
+		t.Fatalf("after underrun buffer = %d, want %d", got, audioBufferInitial*2)
+	}
+	grown := c.frames
+	for range audioBufferCalmSteps - 1 {
+		if c.step(&tel) != grown {
+			t.Fatal("buffer shrank before a full calm stretch")
+		}
+	}
+	if got := c.step(&tel); got != grown*3/4 {
+		t.Fatalf("after calm stretch buffer = %d, want %d", got, grown*3/4)
+	}
+	for range 100 * audioBufferCalmSteps {
+		c.step(&tel)
+	}
+	if c.frames != audioBufferMinFrames {
+		t.Fatalf("buffer settled at %d, want floor %d", c.frames, audioBufferMinFrames)
+	}
+	tel.jitterNs.Store(int64(time.Second))
+	for range 20 {
+		c.step(&tel)
+	}
+	if c.frames != audioBufferMaxFrames {
+		t.Fatalf("buffer under heavy jitter = %d, want ceiling %d", c.frames, audioBufferMaxFrames)
+	}
+}
+
+func TestSysInfo_AudioTelemetryRegisters(t *testing.T) {
+	chip, err := NewSoundChip(AUDIO_BACKEND_NULL)
+	if err != nil {
+		t.Fatal(err)
+	}
+	prev := runtimeStatus.snapshot().sound
+	runtimeStatus.mu.Lock()
+	runtimeStatus.sound = chip
+	runtimeStatus.mu.Unlock()
+	t.Cleanup(func() {
+		runtimeStatus.mu.Lock()
+		runtimeStatus.sound = prev
+		runtimeStatus.mu.Unlock()
+	})
+
+	bus := NewMachineBus()
+	RegisterSysInfoMMIO(bus, 0, 0)
+	chip.telemetry.underruns.Add(3)
+	chip.telemetry.bufferFrames.Store(1024)
+	if got := bus.Read32(SYSINFO_AUDIO_UNDERRUNS); got != 3 {
+		t.Fatalf("SYSINFO_AUDIO_UNDERRUNS = %d, want 3", got)
+	}
+	if got := bus.Read32(SYSINFO_AUDIO_BUFFER); got != 1024 {
+		t.Fatalf("SYSINFO_AUDIO_BUFFER = %d, want 1024", got)
+	}
+	if indicatorEnabled(t, runtimeAudioStatusIndicators(runtimeStatus.snapshot()), "XRUN") {
+		t.Fatal("XRUN lit without trouble")
+	}
+	chip.telemetry.recordRender(time.Now(), 512)
+	chip.telemetry.recordFill(0, true)
+	if !indicatorEnabled(t, runtimeAudioStatusIndicators(runtimeStatus.snapshot()), "XRUN") {
+		t.Fatal("XRUN not lit after an underrun")
+	}
+}
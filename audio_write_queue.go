@@ -0,0 +1,327 @@
+// audio_write_queue.go - Emulated-time register write queue for SoundChip
+
+/*
+Guest CPUs run in bursts (JIT blocks, scheduler slices), so their MMIO writes
+to the sound registers arrive in clumps relative to the audio thread. Digi
+playback through the flex DACs or SID $D418 then jitters by a whole burst.
+
+When a write clock is attached, bus writes to the sound chips are stamped with
+the writer CPU's cycle counter, mapped to an output sample index and applied by
+ReadSample at that sample rather than whenever the CPU goroutine ran.
+
+None of the CPU cores is throttled to its nominal clock, so cycle deltas are
+converted at a rate calibrated against playback: every
+soundWriteClockCalibration output samples the queue divides the cycles the
+writer ran by the samples played meanwhile. The nominal clock rate is used
+only until the first calibration. Cycles must advance with each instruction,
+so only interpreter cores provide a clock; the 6502 and Z80 JITs commit
+cycles at block exit, which would stamp every write in a block alike.
+
+The cycle→sample mapping is anchored one latency window ahead of playback at
+the first write, and stamps follow the calibrated cycle deltas from there. A
+writer running slower than real time, whose stamps fall behind playback, is
+re-anchored a window ahead again. A writer racing ahead keeps its spacing: a
+stamp more than 2*latency ahead is pulled back to one window ahead only once
+the queue has drained, or when it passes soundWriteQueueMaxAhead. Then the
+pending queue moves back with it as a whole, never earlier than the next
+sample, so only the gap before the queue shrinks. A writer persistently
+faster than real time thus loses spacing only at that gap, and its latency is
+finally bounded by soundWriteQueueMax, which forces a flush.
+
+Register reads always see applied state, so a read-back immediately after a
+queued write returns the old value until the write's sample comes round.
+*/
+
+package main
+
+import (
+	"sync"
+	"sync/atomic"
+)
+
+const (
+	soundWriteQueueLatency = SAMPLE_RATE / 50 // one PAL frame of output samples
+	soundWriteQueueMax     = 8192             // pending writes before the writer flushes synchronously
+
+	// soundWriteQueueMaxAhead bounds how far a racing writer's stamps may run
+	// ahead of playback before the queue is pulled back.
+	soundWriteQueueMaxAhead = 8 * soundWriteQueueLatency
+
+	// soundWriteClockCalibration is the playback span, in output samples,
+	// over which the writer's cycle rate is measured. Spans longer than
+	// soundWriteClockCalibrationMax (the writer was paused or stopped
+	// writing) restart the measurement without changing the rate.
+	soundWriteClockCalibration    = SAMPLE_RATE / 4
+	soundWriteClockCalibrationMax = 2 * SAMPLE_RATE
+)
+
+// audioTimedWritesEnabled gates attaching CPU write clocks (-timed-audio-writes).
+var audioTimedWritesEnabled atomic.Bool
+
+// soundWriteClock reads the writer CPU's cycle counter. now is only called
+// from the writer goroutine, inside the MMIO handler.
+type soundWriteClock struct {
+	now func() uint64
+	hz  uint64
+}
+
+type timedSoundWrite struct {
+	at    uint64 // output sample index the write lands on
+	cycle uint64 // writer cycle count when the write was issued
+	addr  uint32
+	value uint32
+	fn    func(addr, value uint32)
+	fn8   func(addr uint32, value uint8)
+}
+
+func (w *timedSoundWrite) apply() {
+	if w.fn8 != nil {
+		w.fn8(w.addr, uint8(w.value))
+		return
+	}
+	w.fn(w.addr, w.value)
+}
+
+// soundWriteQueue holds stamped writes in sample order. Writes are applied
+// under mu so the writer's synchronous flushes and the audio thread's drain
+// never reorder them. Lock order: mu before any chip or engine mutex.
+type soundWriteQueue struct {
+	mu      sync.Mutex
+	clock   atomic.Pointer[soundWriteClock]
+	pending atomic.Int32
+	played  atomic.Uint64 // output samples generated so far
+	writes  []timedSoundWrite
+	head    int
+
+	anchored    bool
+	anchorCycle uint64
+	anchorAt    uint64
+	lastAt      uint64 // stamps never go backwards, keeping writes FIFO
+
+	rate      uint64 // calibrated writer cycles per second of playback
+	calCycle  uint64
+	calPlayed uint64
+}
+
+// calibrateLocked returns the writer's cycle rate measured against playback,
+// starting from the nominal hz.
+func (q *soundWriteQueue) calibrateLocked(cycle, hz, played uint64) uint64 {
+	if q.rate == 0 || cycle < q.calCycle || played < q.calPlayed {
+		q.rate = max(q.rate, hz)
+		q.calCycle, q.calPlayed = cycle, played
+		return q.rate
+	}
+	span := played - q.calPlayed
+	if span < soundWriteClockCalibration {
+		return q.rate
+	}
+	if span <= soundWriteClockCalibrationMax && cycle > q.calCycle {
+		rate := max((cycle-q.calCycle)*SAMPLE_RATE/span, 1)
+		q.rate = rate
+		q.restampLocked(cycle, played)
+	}
+	q.calCycle, q.calPlayed = cycle, played
+	return q.rate
+}
+
+// restampLocked re-anchors the mapping one window ahead of playback at cycle
+// and recomputes the pending writes' stamps from their cycles at the current
+// rate, so stamps made at a stale rate do not hold the queue back.
+func (q *soundWriteQueue) restampLocked(cycle, played uint64) {
+	q.anchored = true
+	q.anchorCycle = cycle
+	q.anchorAt = played + soundWriteQueueLatency
+	for i := q.head; i < len(q.writes); i++ {
+		back := uint64(soundWriteQueueLatency)
+		if d := cycle - min(q.writes[i].cycle, cycle); d < q.rate {
+			back = min(back, d*SAMPLE_RATE/q.rate)
+		}
+		q.writes[i].at = q.anchorAt - back
+	}
+	q.lastAt = q.anchorAt
+}
+
+// stampLocked maps a writer cycle count to an output sample index.
+func (q *soundWriteQueue) stampLocked(cycle, hz uint64) uint64 {
+	played := q.played.Load()
+	rate := q.calibrateLocked(cycle, hz, played)
+	if q.anchored && cycle >= q.anchorCycle && cycle-q.anchorCycle < rate*4 {
+		at := q.anchorAt + (cycle-q.anchorCycle)*SAMPLE_RATE/rate
+		drained := q.head == len(q.writes)
+		if (drained && at > played+2*soundWriteQueueLatency) || at > played+soundWriteQueueMaxAhead {
+			at = q.pullBackLocked(at, played)
+			q.anchorCycle = cycle
+			q.anchorAt = at
+		}
+		if at >= played {
+			q.lastAt = max(at, q.lastAt)
+			return q.lastAt
+		}
+	}
+	q.anchored = true
+	q.anchorCycle = cycle
+	q.anchorAt = max(played+soundWriteQueueLatency, q.lastAt)
+	q.lastAt = q.anchorAt
+	return q.lastAt
+}
+
+// pullBackLocked moves a stamp that ran too far ahead, and every pending
+// write with it, back toward one window ahead of playback. The earliest
+// pending write may move up to the next sample but not past it, so the
+// shift keeps the queue's order and spacing.
+func (q *soundWriteQueue) pullBackLocked(at, played uint64) uint64 {
+	shift := at - (played + soundWriteQueueLatency)
+	if q.head < len(q.writes) {
+		shift = min(shift, q.writes[q.head].at-min(played, q.writes[q.head].at))
+	}
+	for i := q.head; i < len(q.writes); i++ {
+		q.writes[i].at -= shift
+	}
+	q.lastAt -= min(shift, q.lastAt)
+	return at - shift
+}
+
+// push queues w if a write clock is attached. It returns false when the
+// caller should apply the write directly.
+func (q *soundWriteQueue) push(w timedSoundWrite) bool {
+	clk := q.clock.Load()
+	if clk == nil {
+		return false
+	}
+	q.mu.Lock()
+	defer q.mu.Unlock()
+	if q.clock.Load() != clk {
+		return false
+	}
+	if len(q.writes)-q.head >= soundWriteQueueMax {
+		// Playback is not draining (audio stopped or stalled).
+		q.flushLocked()
+		q.anchored = false
+		return false
+	}
+	w.cycle = clk.now()
+	w.at = q.stampLocked(w.cycle, clk.hz)
+	q.writes = append(q.writes, w)
+	q.pending.Store(int32(len(q.writes) - q.head))
+	return true
+}
+
+// advance applies writes due at the sample about to be generated. Called
+// once per output sample from ReadSample.
+func (q *soundWriteQueue) advance() {
+	now := q.played.Add(1) - 1
+	if q.pending.Load() == 0 {
+		return
+	}
+	q.mu.Lock()
+	for q.head < len(q.writes) && q.writes[q.head].at <= now {
+		q.writes[q.head].apply()
+		q.writes[q.head] = timedSoundWrite{}
+		q.head++
+	}
+	q.compactLocked()
+	q.mu.Unlock()
+}
+
+// flushLocked applies every pending write immediately.
+func (q *soundWriteQueue) flushLocked() {
+	for q.head < len(q.writes) {
+		q.writes[q.head].apply()
+		q.writes[q.head] = timedSoundWrite{}
+		q.head++
+	}
+	q.compactLocked()
+}
+
+func (q *soundWriteQueue) compactLocked() {
+	if q.head == len(q.writes) {
+		q.writes = q.writes[:0]
+		q.head = 0
+	}
+	q.pending.Store(int32(len(q.writes) - q.head))
+}
+
+// SetWriteClock timestamps subsequent TimedWrite bus writes with now(), a
+// cycle counter running at nominal hz, and applies them at the matching
+// output sample. now must advance with every instruction the writer runs.
+func (chip *SoundChip) SetWriteClock(now func() uint64, hz uint64) {
+	if now == nil || hz == 0 {
+		chip.ClearWriteClock()
+		return
+	}
+	q := &chip.writeQueue
+	q.mu.Lock()
+	q.flushLocked()
+	q.anchored = false
+	q.rate = 0
+	q.clock.Store(&soundWriteClock{now: now, hz: hz})
+	q.mu.Unlock()
+}
+
+// ClearWriteClock applies any pending writes and returns to immediate writes.
+func (chip *SoundChip) ClearWriteClock() {
+	q := &chip.writeQueue
+	q.mu.Lock()
+	q.clock.Store(nil)
+	q.flushLocked()
+	q.anchored = false
+	q.mu.Unlock()
+}
+
+// TimedWrite wraps a sound register write handler for bus mapping. With a
+// write clock attached the write is queued to its emulated-time sample;
+// otherwise fn runs immediately. AUDIO_CTRL always applies immediately (after
+// draining the queue) so a frozen or stopped chip can still be restarted.
+func (chip *SoundChip) TimedWrite(fn func(addr, value uint32)) func(addr, value uint32) {
+	return func(addr, value uint32) {
+		if addr == AUDIO_CTRL {
+			chip.flushTimedWrites()
+		} else if chip.writeQueue.push(timedSoundWrite{addr: addr, value: value, fn: fn}) {
+			return
+		}
+		fn(addr, value)
+	}
+}
+
+// TimedWrite8 is TimedWrite for byte-wide bus handlers.
+func (chip *SoundChip) TimedWrite8(fn func(addr uint32, value uint8)) func(addr uint32, value uint8) {
+	return func(addr uint32, value uint8) {
+		if addr == AUDIO_CTRL {
+			chip.flushTimedWrites()
+		} else if chip.writeQueue.push(timedSoundWrite{addr: addr, value: uint32(value), fn8: fn}) {
+			return
+		}
+		fn(addr, value)
+	}
+}
+
+func (chip *SoundChip) flushTimedWrites() {
+	q := &chip.writeQueue
+	if q.pending.Load() == 0 {
+		return
+	}
+	q.mu.Lock()
+	q.flushLocked()
+	q.mu.Unlock()
+}
+
+// soundWriteClockSource is implemented by CPU runners whose cycle counter can
+// timestamp sound register writes. SoundWriteClock returns a nil now when the
+// runner's current core cannot (a JIT that commits cycles per block).
+type soundWriteClockSource interface {
+	SoundWriteClock() (now func() uint64, hz uint64)
+}
+
+// attachSoundWriteClock points chip's write queue at runner's cycle counter
+// when timed writes are enabled and the runner has a usable one; otherwise
+// sound register writes apply immediately.
+func attachSoundWriteClock(chip *SoundChip, runner EmulatorCPU) {
+	if chip == nil {
+		return
+	}
+	if src, ok := runner.(soundWriteClockSource); ok && audioTimedWritesEnabled.Load() {
+		chip.SetWriteClock(src.SoundWriteClock())
+		return
+	}
+	chip.ClearWriteClock()
+}
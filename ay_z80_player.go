@@ -143,6 +143,10 @@ func (p *ayZ80Player) runIRQFrame(budget uint64) {
 	}
 }
 
+func (p *ayZ80Player) renderPerf() (uint64, uint64) {
+	return p.instructionCount, p.cpuExecNanos
+}
+
 // collectEvents returns events for this frame (allocates new slice).
 // DEPRECATED: Use collectEventsInto for zero-allocation path.
 func (p *ayZ80Player) collectEvents(frameBaseSample uint64, startCycle uint64, startIndex int) []PSGEvent {
@@ -26,14 +26,25 @@ func renderAYZ80(data []byte, sampleRate int) (PSGMetadata, []PSGEvent, uint64,
 	return renderAYZ80WithLimit(data, sampleRate, 0)
 }
 
-func renderAYZ80WithLimit(data []byte, sampleRate int, maxFrames int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+// ayZ80RenderPlan holds a primed Z80 player and the frame budget for the default song.
+type ayZ80RenderPlan struct {
+	meta       PSGMetadata
+	player     *ayZ80Player
+	frameCount int
+	frameRate  uint16
+	clockHz    uint32
+	loop       bool
+	loopSample uint64
+}
+
+func prepareAYZ80Render(data []byte, sampleRate int, maxFrames int) (ayZ80RenderPlan, error) {
 	file, err := ParseAYZ80Data(data)
 	if err != nil {
-		return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, err
+		return ayZ80RenderPlan{}, err
 	}
 	songIndex := int(file.Header.FirstSongIndex)
 	if songIndex < 0 || songIndex >= len(file.Songs) {
-		return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("ay z80 default song out of range")
+		return ayZ80RenderPlan{}, fmt.Errorf("ay z80 default song out of range")
 	}
 	song := file.Songs[songIndex]
 	frameRate := uint16(50)
@@ -52,7 +63,7 @@ func renderAYZ80WithLimit(data []byte, sampleRate int, maxFrames int) (PSGMetada
 
 	player, err := newAYZ80Player(file, songIndex, sampleRate, z80Clock, frameRate, nil)
 	if err != nil {
-		return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, err
+		return ayZ80RenderPlan{}, err
 	}
 
 	frameCount := int(song.Data.LengthFrames)
@@ -65,12 +76,48 @@ func renderAYZ80WithLimit(data []byte, sampleRate int, maxFrames int) (PSGMetada
 		}
 		loop = true
 	}
-	events, totalSamples := player.RenderFrames(frameCount)
 
-	meta := PSGMetadata{
-		Title:  song.Name,
-		Author: file.Header.Author,
-		System: ayZ80SystemName(song.Data.PlayerSystem),
+	return ayZ80RenderPlan{
+		meta: PSGMetadata{
+			Title:  song.Name,
+			Author: file.Header.Author,
+			System: ayZ80SystemName(song.Data.PlayerSystem),
+		},
+		player:     player,
+		frameCount: frameCount,
+		frameRate:  frameRate,
+		clockHz:    clockHz,
+		loop:       loop,
+		loopSample: loopSample,
+	}, nil
+}
+
+func renderAYZ80WithLimit(data []byte, sampleRate int, maxFrames int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+	plan, err := prepareAYZ80Render(data, sampleRate, maxFrames)
+	if err != nil {
+		return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, err
+	}
+	player := plan.player
+	events, totalSamples := player.RenderFrames(plan.frameCount)
+	return plan.meta, events, totalSamples, plan.clockHz, plan.frameRate, plan.loop, plan.loopSample, player.instructionCount, player.cpuExecNanos, nil
+}
+
+// streamAYZ80 starts a background event stream for the default song,
+// primed with its first chunk, instead of rendering the whole tune.
+func streamAYZ80(data []byte, sampleRate int) (PSGMetadata, *musicEventStream[PSGEvent], uint64, uint32, uint16, bool, uint64, error) {
+	plan, err := prepareAYZ80Render(data, sampleRate, 0)
+	if err != nil {
+		return PSGMetadata{}, nil, 0, 0, 0, false, 0, err
+	}
+	totalSamples := musicStreamTotalSamples(plan.frameCount, sampleRate, plan.frameRate)
+	reopen := func() (musicFrameRenderer[PSGEvent], error) {
+		next, err := prepareAYZ80Render(data, sampleRate, 0)
+		if err != nil {
+			return nil, err
+		}
+		return next.player, nil
 	}
-	return meta, events, totalSamples, clockHz, frameRate, loop, loopSample, player.instructionCount, player.cpuExecNanos, nil
+	stream := newMusicEventStream[PSGEvent](plan.player, reopen, plan.frameCount, plan.loop, plan.loopSample, func(ev *PSGEvent) uint64 { return ev.Sample })
+	stream.prime()
+	return plan.meta, stream, totalSamples, plan.clockHz, plan.frameRate, plan.loop, plan.loopSample, nil
 }
@@ -8,6 +8,7 @@ import (
 	"path/filepath"
 	"runtime"
 	"sort"
+	"strings"
 
 	"github.com/intuitionamiga/IntuitionEngine/internal/interp6502meta"
 )
@@ -28,6 +29,12 @@ func main() {
 	if err := os.WriteFile(filepath.Join(root, "cpu_6502_interp_fusion_dispatch_generated_amd64.s"), mustGenFusionAsm(), 0o644); err != nil {
 		fail(err)
 	}
+	if err := os.WriteFile(filepath.Join(root, "cpu_6502_fusion_generated.go"), mustGenIdiomGo(), 0o644); err != nil {
+		fail(err)
+	}
+	if err := os.WriteFile(filepath.Join(root, "jit_6502_fusion_generated.go"), mustGenIdiomJIT(), 0o644); err != nil {
+		fail(err)
+	}
 }
 
 func mustGenGo() []byte {
@@ -119,6 +126,146 @@ func mustGenFusionAsm() []byte {
 	return buf.Bytes()
 }
 
+// idiomOffsets returns the byte offset of each step and the idiom length.
+func idiomOffsets(idiom interp6502meta.IdiomMeta) ([]int, int) {
+	var lengths [256]int
+	for _, op := range interp6502meta.Opcodes {
+		lengths[op.Opcode] = int(op.Length)
+	}
+	offsets := make([]int, len(idiom.Steps))
+	n := 0
+	for i, step := range idiom.Steps {
+		if lengths[step.Opcode] == 0 {
+			fail(fmt.Errorf("idiom %s: opcode $%02X has no length", idiom.Name, step.Opcode))
+		}
+		if step.Operand != interp6502meta.OperandAny && lengths[step.Opcode] < 2 {
+			fail(fmt.Errorf("idiom %s: step %d constrains a missing operand", idiom.Name, i))
+		}
+		if (step.Operand == interp6502meta.OperandSameAs || step.Operand == interp6502meta.OperandNextOf) && (step.Ref < 0 || step.Ref >= i) {
+			fail(fmt.Errorf("idiom %s: step %d refers forward to step %d", idiom.Name, i, step.Ref))
+		}
+		offsets[i] = n
+		n += lengths[step.Opcode]
+	}
+	return offsets, n
+}
+
+func mustGenIdiomGo() []byte {
+	operandKinds := map[interp6502meta.IdiomOperand]string{
+		interp6502meta.OperandAny:    "fusion6502OperandAny",
+		interp6502meta.OperandEqual:  "fusion6502OperandEqual",
+		interp6502meta.OperandSameAs: "fusion6502OperandSameAs",
+		interp6502meta.OperandNextOf: "fusion6502OperandNextOf",
+	}
+	var buf bytes.Buffer
+	buf.WriteString("// Code generated by cmd/gen_interp6502; DO NOT EDIT.\n")
+	buf.WriteString("package main\n\n")
+	buf.WriteString("// FusionID enumerates the fused 6502 idioms of interp6502meta.Idioms.\n")
+	buf.WriteString("type FusionID int\n\n")
+	buf.WriteString("const (\n")
+	buf.WriteString("\tFusionNone FusionID = iota\n")
+	for _, idiom := range interp6502meta.Idioms {
+		fmt.Fprintf(&buf, "\tFusion%s // %s\n", idiom.Name, idiom.Doc)
+	}
+	buf.WriteString("\tfusion6502Count\n")
+	buf.WriteString(")\n\n")
+
+	maxInstrs := 0
+	var byOpcode [256][]int
+	buf.WriteString("var fusion6502Patterns = [fusion6502Count]fusion6502Pattern{\n")
+	for i, idiom := range interp6502meta.Idioms {
+		offsets, length := idiomOffsets(idiom)
+		maxInstrs = max(maxInstrs, len(idiom.Steps))
+		byOpcode[idiom.Steps[0].Opcode] = append(byOpcode[idiom.Steps[0].Opcode], i)
+		fmt.Fprintf(&buf, "\tFusion%s: {name: %q, length: %d, jit: %t, steps: []fusion6502Step{\n", idiom.Name, idiom.Name, length, idiom.JIT != "")
+		for j, step := range idiom.Steps {
+			fmt.Fprintf(&buf, "\t\t{offset: %d, opcode: 0x%02X", offsets[j], step.Opcode)
+			switch step.Operand {
+			case interp6502meta.OperandEqual:
+				fmt.Fprintf(&buf, ", operand: %s, value: 0x%02X", operandKinds[step.Operand], step.Value)
+			case interp6502meta.OperandSameAs, interp6502meta.OperandNextOf:
+				fmt.Fprintf(&buf, ", operand: %s, ref: %d", operandKinds[step.Operand], step.Ref)
+			}
+			buf.WriteString("},\n")
+		}
+		buf.WriteString("\t}},\n")
+	}
+	buf.WriteString("}\n\n")
+	fmt.Fprintf(&buf, "// fusion6502MaxInstrs is the longest idiom, in instructions.\nconst fusion6502MaxInstrs = %d\n\n", maxInstrs)
+
+	buf.WriteString("// fusion6502ByOpcode lists the idioms starting with each opcode, longest first.\n")
+	buf.WriteString("var fusion6502ByOpcode = [256][]FusionID{\n")
+	for opcode, ids := range byOpcode {
+		if len(ids) == 0 {
+			continue
+		}
+		sort.SliceStable(ids, func(a, b int) bool {
+			return len(interp6502meta.Idioms[ids[a]].Steps) > len(interp6502meta.Idioms[ids[b]].Steps)
+		})
+		fmt.Fprintf(&buf, "\t0x%02X: {", opcode)
+		for k, id := range ids {
+			if k > 0 {
+				buf.WriteString(", ")
+			}
+			fmt.Fprintf(&buf, "Fusion%s", interp6502meta.Idioms[id].Name)
+		}
+		buf.WriteString("},\n")
+	}
+	buf.WriteString("}\n\n")
+
+	buf.WriteString("// execFusion6502 runs the interpreter fast path for id at pc. It returns\n")
+	buf.WriteString("// the number of instructions retired, or 0 when the fuser declined.\n")
+	buf.WriteString("func (cpu_6502 *CPU_6502) execFusion6502(id FusionID, ram *[0x10000]byte, io *[256]bool, pc uint16) int {\n")
+	buf.WriteString("\tswitch id {\n")
+	for _, idiom := range interp6502meta.Idioms {
+		fmt.Fprintf(&buf, "\tcase Fusion%s:\n\t\treturn cpu_6502.fused%s(ram, io, pc)\n", idiom.Name, idiom.Name)
+	}
+	buf.WriteString("\t}\n")
+	buf.WriteString("\treturn 0\n")
+	buf.WriteString("}\n")
+
+	out, err := format.Source(buf.Bytes())
+	if err != nil {
+		fail(err)
+	}
+	return out
+}
+
+func mustGenIdiomJIT() []byte {
+	var templates []string
+	cases := map[string][]string{}
+	for _, idiom := range interp6502meta.Idioms {
+		if idiom.JIT == "" {
+			continue
+		}
+		if _, ok := cases[idiom.JIT]; !ok {
+			templates = append(templates, idiom.JIT)
+		}
+		cases[idiom.JIT] = append(cases[idiom.JIT], "Fusion"+idiom.Name)
+	}
+
+	var buf bytes.Buffer
+	buf.WriteString("// Code generated by cmd/gen_interp6502; DO NOT EDIT.\n\n")
+	buf.WriteString("//go:build amd64 && (linux || windows || darwin)\n\n")
+	buf.WriteString("package main\n\n")
+	buf.WriteString("// emit6502Fusion emits the JIT template for the idiom headed at site.\n")
+	buf.WriteString("func emit6502Fusion(id FusionID, site *j65FusionSite) {\n")
+	buf.WriteString("\tswitch id {\n")
+	for _, name := range templates {
+		fmt.Fprintf(&buf, "\tcase %s:\n\t\temit6502Fused%s(site)\n", strings.Join(cases[name], ", "), name)
+	}
+	buf.WriteString("\tdefault:\n")
+	buf.WriteString("\t\tpanic(\"emit6502Fusion: idiom has no JIT template\")\n")
+	buf.WriteString("\t}\n")
+	buf.WriteString("}\n")
+
+	out, err := format.Source(buf.Bytes())
+	if err != nil {
+		fail(err)
+	}
+	return out
+}
+
 func fail(err error) {
 	fmt.Fprintln(os.Stderr, err)
 	os.Exit(1)
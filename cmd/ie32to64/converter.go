@@ -36,6 +36,12 @@ type Converter struct {
 	divGuard    bool
 	divLabelSeq int
 	errors      int
+
+	// optLevel selects the optimising lowering (optimize.go); prog holds
+	// its per-file analysis and curLine the input line being converted.
+	optLevel int
+	prog     *ie32Program
+	curLine  int
 }
 
 // NewConverter creates a Converter with default settings.
@@ -318,6 +324,10 @@ func (c *Converter) ConvertLine(rawLine string) []string {
 		if comment != "" && len(lines) > 0 {
 			lines[0] = lines[0] + commentSuffix
 		}
+		if comment != "" && len(lines) == 0 {
+			// Optimised away; keep the comment.
+			return []string{indent.String() + "; " + comment}
+		}
 		return lines
 	}
 
@@ -336,6 +346,10 @@ func (c *Converter) convertInstruction(code string, indent string) []string {
 
 	sz := c.sizeSuffix
 
+	if out, ok := c.optimizeInstruction(indent); ok {
+		return out
+	}
+
 	// --- Zero-operand instructions ---
 	switch mnemonic {
 	case "NOP":
@@ -490,10 +504,8 @@ func (c *Converter) convertLoad(destReg, operand, indent, sz string) []string {
 
 	case OpDirect:
 		addr := strings.TrimSpace(operand[1:]) // strip @
-		return []string{
-			indent + "la r17, " + addr,
-			indent + "load" + sz + " " + destReg + ", (r17)",
-		}
+		prefix, ref := c.directRef(addr, indent)
+		return append(prefix, indent+"load"+sz+" "+destReg+", "+ref)
 
 	case OpRegIndirect:
 		reg, offset, err := c.parseRegIndirect(operand)
@@ -524,10 +536,8 @@ func (c *Converter) convertGenericLoad(destReg, operand, indent, sz string) []st
 
 	case OpDirect:
 		addr := strings.TrimSpace(operand[1:])
-		return []string{
-			indent + "la r17, " + addr,
-			indent + "load" + sz + " " + destReg + ", (r17)",
-		}
+		prefix, ref := c.directRef(addr, indent)
+		return append(prefix, indent+"load"+sz+" "+destReg+", "+ref)
 
 	case OpRegIndirect:
 		reg, offset, err := c.parseRegIndirect(operand)
@@ -561,10 +571,8 @@ func (c *Converter) convertStore(srcReg, operand, indent, sz, sourceText string)
 
 	case OpDirect:
 		addr := strings.TrimSpace(operand[1:])
-		return []string{
-			indent + "la r17, " + addr,
-			indent + "store" + sz + " " + srcReg + ", (r17)",
-		}
+		prefix, ref := c.directRef(addr, indent)
+		return append(prefix, indent+"store"+sz+" "+srcReg+", "+ref)
 
 	case OpRegIndirect:
 		reg, offset, err := c.parseRegIndirect(operand)
@@ -578,10 +586,8 @@ func (c *Converter) convertStore(srcReg, operand, indent, sz, sourceText string)
 
 	default: // OpBare - STORE always writes to memory
 		addr := operand
-		return []string{
-			indent + "la r17, " + addr,
-			indent + "store" + sz + " " + srcReg + ", (r17)",
-		}
+		prefix, ref := c.directRef(addr, indent)
+		return append(prefix, indent+"store"+sz+" "+srcReg+", "+ref)
 	}
 }
 
@@ -603,11 +609,11 @@ func (c *Converter) convertALU(ie32mn, ie64op, destReg, operand, indent, sz stri
 
 	case OpDirect:
 		addr := strings.TrimSpace(operand[1:])
-		return []string{
-			indent + "la r17, " + addr,
-			indent + "load" + sz + " r17, (r17)",
-			indent + ie64op + sz + " " + destReg + ", " + destReg + ", r17",
-		}
+		prefix, ref := c.directRef(addr, indent)
+		return append(prefix,
+			indent+"load"+sz+" r17, "+ref,
+			indent+ie64op+sz+" "+destReg+", "+destReg+", r17",
+		)
 
 	case OpRegIndirect:
 		reg, offset, err := c.parseRegIndirect(operand)
@@ -659,10 +665,8 @@ func (c *Converter) convertDivMod(ie64op, destReg, operand, indent, sz string) [
 
 	case OpDirect:
 		addr := strings.TrimSpace(operand[1:])
-		prefix := []string{
-			indent + "la r17, " + addr,
-			indent + "load" + sz + " r17, (r17)",
-		}
+		prefix, ref := c.directRef(addr, indent)
+		prefix = append(prefix, indent+"load"+sz+" r17, "+ref)
 		return c.emitDivModGuard(ie64op, destReg, "r17", prefix, indent, sz)
 
 	case OpRegIndirect:
@@ -729,12 +733,12 @@ func (c *Converter) convertIncDec(ie64op, operand, indent, sz string) []string {
 
 	case OpDirect:
 		addr := strings.TrimSpace(operand[1:])
-		return []string{
-			indent + "la r17, " + addr,
-			indent + "load" + sz + " r18, (r17)",
-			indent + ie64op + sz + " r18, r18, #1",
-			indent + "store" + sz + " r18, (r17)",
-		}
+		prefix, ref := c.directRef(addr, indent)
+		return append(prefix,
+			indent+"load"+sz+" r18, "+ref,
+			indent+ie64op+sz+" r18, r18, #1",
+			indent+"store"+sz+" r18, "+ref,
+		)
 
 	case OpRegIndirect:
 		reg, offset, err := c.parseRegIndirect(operand)
@@ -791,12 +795,19 @@ func (c *Converter) ConvertFile(input string) string {
 	lines := strings.Split(input, "\n")
 	var output []string
 
+	c.prog = nil
+	if c.optLevel > 0 && c.sizeSuffix == ".l" {
+		c.prog = c.analyzeProgram(lines)
+	}
+	defer func() { c.prog = nil }()
+
 	if !c.noHeader {
 		output = append(output, "; Converted from IE32 by ie32to64")
 		output = append(output, "")
 	}
 
-	for _, line := range lines {
+	for i, line := range lines {
+		c.curLine = i
 		converted := c.ConvertLine(line)
 		output = append(output, converted...)
 	}
@@ -804,6 +815,30 @@ func (c *Converter) ConvertFile(input string) string {
 	return strings.Join(output, "\n")
 }
 
+// CountInstructions counts the IE64 instruction lines in converted output:
+// everything except blanks, comments, labels and directives.
+func CountInstructions(output string) int {
+	n := 0
+	for _, line := range strings.Split(output, "\n") {
+		code, _ := SplitComment(strings.TrimSpace(line))
+		code = strings.TrimSpace(code)
+		if code == "" || strings.HasSuffix(code, ":") {
+			continue
+		}
+		first := strings.ToLower(strings.Fields(code)[0])
+		if len(strings.Fields(code)) > 1 && strings.ToLower(strings.Fields(code)[1]) == "equ" {
+			continue
+		}
+		switch {
+		case first == "org", first == "include", first == "incbin",
+			strings.HasPrefix(first, "dc."), strings.HasPrefix(first, "ds."):
+			continue
+		}
+		n++
+	}
+	return n
+}
+
 // ConvertFileFromPath reads a file and converts it.
 func (c *Converter) ConvertFileFromPath(path string) (string, error) {
 	data, err := os.ReadFile(path)
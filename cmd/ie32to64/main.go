@@ -15,6 +15,7 @@ func main() {
 	noHeader := flag.Bool("no-header", false, "Omit header comment")
 	noDivGuard := flag.Bool("no-div-guard", false, "Disable DIV/MOD zero guards")
 	stats := flag.Bool("stats", false, "Print conversion statistics")
+	optLevel := flag.Int("O", 0, "Optimisation level: 0 mechanical, 1 width analysis and address folding, 2 adds idiom fusion")
 	flag.Usage = func() {
 		fmt.Fprintf(os.Stderr, "Usage: ie32to64 [options] input.asm\n\nConverts IE32 assembly source to IE64 assembly.\n\nOptions:\n")
 		flag.PrintDefaults()
@@ -22,6 +23,7 @@ func main() {
 		fmt.Fprintf(os.Stderr, "  ie32to64 sdk/examples/asm/rotozoomer.asm\n")
 		fmt.Fprintf(os.Stderr, "  ie32to64 -o output.asm sdk/examples/asm/rotozoomer.asm\n")
 		fmt.Fprintf(os.Stderr, "  ie32to64 -size .q program.asm\n")
+		fmt.Fprintf(os.Stderr, "  ie32to64 -O2 program.asm\n")
 	}
 	flag.Parse()
 
@@ -37,9 +39,19 @@ func main() {
 		os.Exit(1)
 	}
 
+	if *optLevel < 0 || *optLevel > 2 {
+		fmt.Fprintf(os.Stderr, "error: -O must be 0, 1 or 2\n")
+		os.Exit(1)
+	}
+	if *optLevel > 0 && *sizeSuffix != ".l" {
+		fmt.Fprintf(os.Stderr, "error: -O%d requires -size .l\n", *optLevel)
+		os.Exit(1)
+	}
+
 	conv := NewConverter()
 	conv.sizeSuffix = *sizeSuffix
 	conv.noHeader = *noHeader
+	conv.optLevel = *optLevel
 	if *noDivGuard {
 		conv.divGuard = false
 	}
@@ -64,7 +76,7 @@ func main() {
 		inputLines := strings.Count(string(mustReadFile(inputPath)), "\n") + 1
 		outputLines := strings.Count(output, "\n") + 1
 		fmt.Printf("Input:  %s (%d lines)\n", inputPath, inputLines)
-		fmt.Printf("Output: %s (%d lines)\n", outputPath, outputLines)
+		fmt.Printf("Output: %s (%d lines, %d instructions)\n", outputPath, outputLines, CountInstructions(output))
 		if conv.errors > 0 {
 			fmt.Printf("Errors: %d (search for '; ERROR:' in output)\n", conv.errors)
 		}
@@ -0,0 +1,879 @@
+package main
+
+import (
+	"fmt"
+	"strings"
+)
+
+// ============================================================================
+// Optimising conversion (-O1, -O2)
+// ============================================================================
+//
+// At -O0 every IE32 instruction lowers on its own. The optimising levels
+// first parse the whole file into ie32Op records, build the control-flow
+// graph from labels and branches, and run two analyses over it:
+//
+//   - register width: a forward pass that tracks, per IE32 register, whether
+//     the value is a known constant or known to have bit 31 clear. IE64
+//     branches compare all 64 bits while .l results are zero-extended, so a
+//     signed IE32 branch (JGT/JGE/JLT/JLE) on a value that may have bit 31 set
+//     needs a sext.l first; when the analysis proves bit 31 clear the plain
+//     IE64 branch is exact. Known constants also fold branches and remove
+//     DIV/MOD zero guards;
+//   - liveness: a backward pass over the 16 IE32 registers, used by -O2 to
+//     fuse instruction pairs whose intermediate result nothing reads.
+//
+// JSR, RTS, RTI, HALT, directives and branches to labels outside the file
+// are barriers: every register is live and nothing is known afterwards.
+// Labels whose address is taken anywhere other than as a JMP/Jcc target
+// start with nothing known.
+//
+// -O1 rewrites single instructions: direct (@addr) operands become addr(r0)
+// displacements instead of la r17 + (r17), identity ALU ops (ADD #0, MUL #1,
+// AND #$FFFFFFFF, ...) disappear, and signed branches get the width fix
+// above. -O2 adds the idioms: runs of ADD/SUB immediates on one register
+// merge, LOAD R,S / SUB R,T / Jcc R compare-branch sequences become one
+// IE64 compare-and-branch when R is dead, and register-only loads and ALU
+// ops whose result is dead are dropped. Memory operands are never removed
+// or merged; they may be MMIO.
+//
+// Optimisation assumes the .l register model and is off for -size .q.
+
+const ie32RegCount = 16
+
+const ie32AllLive = uint16(0xFFFF)
+
+// ie32ValKind is the register-width lattice, from most to least precise.
+type ie32ValKind uint8
+
+const (
+	valTop     ie32ValKind = iota // no path reaches here yet
+	valConst                      // known 32-bit constant
+	valNonNeg                     // bit 31 known clear
+	valUnknown                    // anything
+)
+
+type ie32Val struct {
+	kind ie32ValKind
+	c    uint32
+}
+
+var ie32Unknown = ie32Val{kind: valUnknown}
+
+func ie32Const(c uint32) ie32Val { return ie32Val{kind: valConst, c: c} }
+
+func (v ie32Val) nonNeg() bool {
+	return v.kind == valNonNeg || (v.kind == valConst && v.c < 1<<31)
+}
+
+func meetVal(a, b ie32Val) ie32Val {
+	switch {
+	case a.kind == valTop:
+		return b
+	case b.kind == valTop:
+		return a
+	case a.kind == valConst && b.kind == valConst && a.c == b.c:
+		return a
+	case a.nonNeg() && b.nonNeg():
+		return ie32Val{kind: valNonNeg}
+	}
+	return ie32Unknown
+}
+
+type ie32State [ie32RegCount]ie32Val
+
+func meetState(a, b *ie32State) (ie32State, bool) {
+	var out ie32State
+	changed := false
+	for r := range out {
+		out[r] = meetVal(a[r], b[r])
+		if out[r] != a[r] {
+			changed = true
+		}
+	}
+	return out, changed
+}
+
+func unknownState() ie32State {
+	var s ie32State
+	for r := range s {
+		s[r] = ie32Unknown
+	}
+	return s
+}
+
+// ie32Op is one IE32 instruction, or a directive barrier, in the
+// optimiser's view.
+type ie32Op struct {
+	line   int
+	mnem   string // LDx/STx normalised to LOAD/STORE; "." for a directive
+	reg    int    // first-operand register, -1 if none
+	kind   OperandType
+	src    int // OpRegister source or OpRegIndirect base, -1 otherwise
+	imm    uint32
+	immOK  bool   // numeric OpImmediate/OpBare operand
+	off    string // OpRegIndirect offset text
+	target string // JMP/Jcc/JSR target, scoped like ie64asm local labels
+	leader bool   // a label precedes it
+
+	succ    []int // successor op indices; -1 means leaves the analysed code
+	barrier bool  // all registers live before it, nothing known after
+}
+
+// ie32Program is the per-file analysis the optimising levels consult.
+type ie32Program struct {
+	ops    []ie32Op
+	byLine map[int]int
+	in     []ie32State // register values on entry to each op
+	liveIn []uint16
+	live   []uint16 // live after each op
+	skip   map[int]bool
+	plan   map[int][]string // replacement lines (no indent), by op index
+
+	enterUnknown []bool // entry reachable from outside the modelled CFG
+	branchRefs   []int  // JMP/Jcc edges into each op
+}
+
+func isBranch(m string) bool {
+	switch m {
+	case "JZ", "JNZ", "JGT", "JGE", "JLT", "JLE":
+		return true
+	}
+	return false
+}
+
+func regBit(r int) uint16 {
+	if r < 0 {
+		return 0
+	}
+	return 1 << uint(r)
+}
+
+// regIndex maps an IE32 register name, or its mapped IE64 name, to 0..15.
+func (c *Converter) regIndex(name string) int {
+	mapped, err := c.MapRegister(name)
+	if err != nil {
+		mapped = name
+	}
+	var n int
+	if _, err := fmt.Sscanf(mapped, "r%d", &n); err != nil || n < 1 || n > ie32RegCount {
+		return -1
+	}
+	return n - 1
+}
+
+func (c *Converter) regName(r int) string {
+	return fmt.Sprintf("r%d", r+1)
+}
+
+func scopedLabel(scope, name string) string {
+	if strings.HasPrefix(name, ".") {
+		return scope + name
+	}
+	return name
+}
+
+func isIdentChar(ch byte) bool {
+	return ch == '_' || ch == '.' || ch >= '0' && ch <= '9' || ch >= 'a' && ch <= 'z' || ch >= 'A' && ch <= 'Z'
+}
+
+// identifiers returns the identifier-like tokens in s.
+func identifiers(s string) []string {
+	var out []string
+	start := -1
+	for i := 0; i <= len(s); i++ {
+		if i < len(s) && isIdentChar(s[i]) {
+			if start < 0 {
+				start = i
+			}
+			continue
+		}
+		if start >= 0 {
+			out = append(out, s[start:i])
+			start = -1
+		}
+	}
+	return out
+}
+
+// ie32Simple are the instructions without register operands; anything
+// else the optimiser does not recognise is treated as a barrier.
+var ie32Simple = map[string]bool{
+	"NOP": true, "HALT": true, "RTS": true, "SEI": true, "CLI": true, "RTI": true, "WAIT": true,
+}
+
+var ie32TwoOperand = map[string]bool{
+	"LOAD": true, "STORE": true, "ADD": true, "SUB": true, "MUL": true, "DIV": true, "MOD": true,
+	"AND": true, "OR": true, "XOR": true, "SHL": true, "SHR": true,
+}
+
+// parseOp builds the optimiser record for one instruction's code text.
+func (c *Converter) parseOp(code string, line int, scope string) (ie32Op, bool) {
+	op := ie32Op{line: line, reg: -1, src: -1}
+	fields := strings.Fields(code)
+	mn := strings.ToUpper(fields[0])
+	rest := strings.TrimSpace(code[len(fields[0]):])
+	parts := splitOperands(rest)
+	operand := ""
+
+	switch {
+	case mn == "JMP" || mn == "JSR":
+		op.mnem = mn
+		op.target = scopedLabel(scope, strings.TrimSpace(rest))
+		return op, true
+	case isBranch(mn):
+		if len(parts) != 2 {
+			return op, false
+		}
+		op.mnem = mn
+		op.reg = c.regIndex(parts[0])
+		op.target = scopedLabel(scope, parts[1])
+		return op, op.reg >= 0
+	case len(mn) == 3 && (strings.HasPrefix(mn, "LD") || strings.HasPrefix(mn, "ST")) && c.isRegister(mn[2:]):
+		op.mnem = map[string]string{"LD": "LOAD", "ST": "STORE"}[mn[:2]]
+		op.reg = c.regIndex(mn[2:])
+		operand = rest
+	case mn == "PUSH" || mn == "POP" || mn == "NOT" || mn == "INC" || mn == "DEC":
+		op.mnem = mn
+		operand = rest
+		if mn != "INC" && mn != "DEC" {
+			op.reg = c.regIndex(rest)
+			return op, op.reg >= 0
+		}
+	case len(parts) == 2:
+		op.mnem = mn
+		op.reg = c.regIndex(parts[0])
+		operand = parts[1]
+		if op.reg < 0 {
+			return op, false
+		}
+	default:
+		op.mnem = mn
+		return op, ie32Simple[mn]
+	}
+	if !ie32TwoOperand[op.mnem] && op.mnem != "INC" && op.mnem != "DEC" {
+		return op, false
+	}
+
+	op.kind = c.ClassifyOperandWithReg(operand)
+	switch op.kind {
+	case OpRegister:
+		op.src = c.regIndex(operand)
+	case OpRegIndirect:
+		base, off, err := c.parseRegIndirect(operand)
+		if err != nil {
+			return op, false
+		}
+		op.src, op.off = c.regIndex(base), off
+	case OpImmediate, OpBare:
+		if v, ok := tryParseConstantInt(operand); ok {
+			op.imm, op.immOK = uint32(v), true
+		}
+	}
+	return op, true
+}
+
+// analyzeProgram parses the file and runs the width and liveness passes.
+func (c *Converter) analyzeProgram(lines []string) *ie32Program {
+	p := &ie32Program{byLine: map[int]int{}, skip: map[int]bool{}, plan: map[int][]string{}}
+	labels := map[string]int{}
+	dupLabels := map[string]bool{}
+	scope := ""
+	pendingLabel := false
+	var refs []string // label-like tokens outside branch targets
+
+	for i, raw := range lines {
+		code, _ := SplitComment(strings.TrimSpace(raw))
+		code = strings.TrimSpace(code)
+		for code != "" && ClassifyLine(code) == LineLabel {
+			label, rest, ok := splitInlineLabel(code)
+			if !ok {
+				break
+			}
+			name := strings.TrimSuffix(label, ":")
+			if !strings.HasPrefix(name, ".") {
+				scope = name
+			}
+			name = scopedLabel(scope, name)
+			if _, seen := labels[name]; seen {
+				dupLabels[name] = true
+			}
+			labels[name] = len(p.ops)
+			pendingLabel = true
+			code = rest
+		}
+		if code == "" {
+			continue
+		}
+		var op ie32Op
+		if ClassifyLine(code) == LineDirective {
+			op = ie32Op{line: i, mnem: ".", reg: -1, src: -1, barrier: true}
+			refs = append(refs, identifiers(code)...)
+		} else {
+			var ok bool
+			op, ok = c.parseOp(code, i, scope)
+			if !ok {
+				op.mnem, op.barrier = ".", true
+			}
+			if op.target == "" {
+				refs = append(refs, identifiers(code)...)
+			}
+		}
+		op.leader = pendingLabel
+		pendingLabel = false
+		p.byLine[i] = len(p.ops)
+		p.ops = append(p.ops, op)
+	}
+
+	addrTaken := map[string]bool{}
+	for _, r := range refs {
+		addrTaken[r] = true
+	}
+	target := func(name string) int {
+		idx, ok := labels[name]
+		if !ok || dupLabels[name] || idx >= len(p.ops) {
+			return -1
+		}
+		return idx
+	}
+	enterUnknown := make([]bool, len(p.ops)+1)
+	p.branchRefs = make([]int, len(p.ops))
+	enterUnknown[0] = true
+	for name, idx := range labels {
+		if addrTaken[name] || dupLabels[name] || strings.HasPrefix(name, "__ie32to64_") {
+			enterUnknown[idx] = true
+		}
+	}
+	for i := range p.ops {
+		op := &p.ops[i]
+		next := i + 1
+		if next >= len(p.ops) {
+			next = -1
+		}
+		if t := target(op.target); t >= 0 && (op.mnem == "JMP" || isBranch(op.mnem)) {
+			p.branchRefs[t]++
+		}
+		switch {
+		case op.mnem == "JMP":
+			op.succ = []int{target(op.target)}
+		case isBranch(op.mnem):
+			op.succ = []int{target(op.target), next}
+		case op.mnem == "JSR":
+			if t := target(op.target); t >= 0 {
+				enterUnknown[t] = true
+			}
+			op.barrier = true
+			op.succ = []int{next}
+		case op.mnem == "RTS", op.mnem == "RTI", op.mnem == "HALT":
+			op.barrier = true
+		default:
+			op.succ = []int{next}
+		}
+		if op.barrier && next >= 0 {
+			enterUnknown[next] = true
+		}
+	}
+
+	p.enterUnknown = enterUnknown
+	p.in = c.widthPass(p.ops, enterUnknown)
+	p.liveIn, p.live = livenessPass(p.ops)
+	if c.optLevel >= 2 {
+		c.planIdioms(p)
+	}
+	return p
+}
+
+// widthPass propagates register values forward to a fixed point.
+func (c *Converter) widthPass(ops []ie32Op, enterUnknown []bool) []ie32State {
+	in := make([]ie32State, len(ops))
+	reached := make([]bool, len(ops))
+	work := []int{}
+	for i := range ops {
+		if enterUnknown[i] {
+			in[i], reached[i] = unknownState(), true
+			work = append(work, i)
+		}
+	}
+	for len(work) > 0 {
+		i := work[len(work)-1]
+		work = work[:len(work)-1]
+		out := in[i]
+		if ops[i].barrier {
+			out = unknownState()
+		} else {
+			c.transfer(&ops[i], &out)
+		}
+		for _, s := range ops[i].succ {
+			if s < 0 {
+				continue
+			}
+			if !reached[s] {
+				in[s], reached[s] = out, true
+				work = append(work, s)
+				continue
+			}
+			if merged, changed := meetState(&in[s], &out); changed {
+				in[s] = merged
+				work = append(work, s)
+			}
+		}
+	}
+	return in
+}
+
+// evalALU computes an IE32 ALU op on 32-bit constants.
+func evalALU(mn string, a, b uint32) (uint32, bool) {
+	switch mn {
+	case "ADD":
+		return a + b, true
+	case "SUB":
+		return a - b, true
+	case "MUL":
+		return a * b, true
+	case "AND":
+		return a & b, true
+	case "OR":
+		return a | b, true
+	case "XOR":
+		return a ^ b, true
+	case "SHL":
+		if b < 32 {
+			return a << b, true
+		}
+	case "SHR":
+		if b < 32 {
+			return a >> b, true
+		}
+	case "DIV":
+		if b != 0 {
+			return a / b, true
+		}
+	case "MOD":
+		if b != 0 {
+			return a % b, true
+		}
+	}
+	return 0, false
+}
+
+// operandVal is the value an op's second operand resolves to.
+func operandVal(op *ie32Op, st *ie32State) ie32Val {
+	switch {
+	case op.kind == OpRegister && op.src >= 0:
+		return st[op.src]
+	case (op.kind == OpImmediate || op.kind == OpBare) && op.immOK:
+		return ie32Const(op.imm)
+	}
+	return ie32Unknown
+}
+
+func (c *Converter) transfer(op *ie32Op, st *ie32State) {
+	r := op.reg
+	switch op.mnem {
+	case "LOAD":
+		if op.kind == OpRegister || op.kind == OpImmediate || op.kind == OpBare {
+			st[r] = operandVal(op, st)
+		} else {
+			st[r] = ie32Unknown
+		}
+	case "POP":
+		st[r] = ie32Unknown
+	case "NOT":
+		if st[r].kind == valConst {
+			st[r] = ie32Const(^st[r].c)
+		} else {
+			st[r] = ie32Unknown
+		}
+	case "INC", "DEC":
+		if op.kind != OpRegister || op.src < 0 {
+			return
+		}
+		d := uint32(1)
+		if op.mnem == "DEC" {
+			d = ^uint32(0)
+		}
+		if v := st[op.src]; v.kind == valConst {
+			st[op.src] = ie32Const(v.c + d)
+		} else {
+			st[op.src] = ie32Unknown
+		}
+	case "ADD", "SUB", "MUL", "DIV", "MOD", "AND", "OR", "XOR", "SHL", "SHR":
+		if r < 0 {
+			return
+		}
+		a, b := st[r], operandVal(op, st)
+		if a.kind == valConst && b.kind == valConst {
+			if v, ok := evalALU(op.mnem, a.c, b.c); ok {
+				st[r] = ie32Const(v)
+				return
+			}
+		}
+		nonNeg := false
+		switch op.mnem {
+		case "AND":
+			nonNeg = a.nonNeg() || b.nonNeg()
+		case "OR", "XOR":
+			nonNeg = a.nonNeg() && b.nonNeg()
+		case "DIV":
+			nonNeg = a.nonNeg() || (b.kind == valConst && b.c > 1)
+		case "MOD":
+			nonNeg = a.nonNeg() || b.nonNeg()
+		case "SHR":
+			nonNeg = a.nonNeg() || (b.kind == valConst && b.c >= 1)
+		}
+		if nonNeg {
+			st[r] = ie32Val{kind: valNonNeg}
+		} else {
+			st[r] = ie32Unknown
+		}
+	}
+}
+
+// uses and defs return the register sets an op reads and writes.
+func (op *ie32Op) uses() uint16 {
+	if op.barrier {
+		return ie32AllLive
+	}
+	u := regBit(op.src)
+	switch op.mnem {
+	case "STORE", "PUSH", "NOT", "ADD", "SUB", "MUL", "DIV", "MOD", "AND", "OR", "XOR", "SHL", "SHR":
+		u |= regBit(op.reg)
+	}
+	if isBranch(op.mnem) {
+		u |= regBit(op.reg)
+	}
+	return u
+}
+
+func (op *ie32Op) defs() uint16 {
+	switch op.mnem {
+	case "LOAD", "POP", "NOT", "ADD", "SUB", "MUL", "DIV", "MOD", "AND", "OR", "XOR", "SHL", "SHR":
+		return regBit(op.reg)
+	case "INC", "DEC":
+		if op.kind == OpRegister {
+			return regBit(op.src)
+		}
+	}
+	return 0
+}
+
+// livenessPass returns the registers live before and after each op.
+func livenessPass(ops []ie32Op) (liveIn, liveOut []uint16) {
+	liveIn = make([]uint16, len(ops))
+	liveOut = make([]uint16, len(ops))
+	for changed := true; changed; {
+		changed = false
+		for i := len(ops) - 1; i >= 0; i-- {
+			op := &ops[i]
+			var out uint16
+			if len(op.succ) == 0 {
+				out = ie32AllLive
+			}
+			for _, s := range op.succ {
+				if s < 0 {
+					out = ie32AllLive
+				} else {
+					out |= liveIn[s]
+				}
+			}
+			in := op.uses() | out&^op.defs()
+			if op.barrier {
+				in = ie32AllLive
+			}
+			if in != liveIn[i] || out != liveOut[i] {
+				liveIn[i], liveOut[i], changed = in, out, true
+			}
+		}
+	}
+	return liveIn, liveOut
+}
+
+// planIdioms records the -O2 multi-instruction rewrites: merged ADD/SUB
+// immediates, compare-branch fusion and dead register-only ops.
+func (c *Converter) planIdioms(p *ie32Program) {
+	sz := c.sizeSuffix
+	follows := func(i int) bool { return i < len(p.ops) && !p.ops[i].leader && !p.skip[i] }
+	for i := 0; i < len(p.ops); i++ {
+		op := &p.ops[i]
+		if p.skip[i] || op.barrier {
+			continue
+		}
+		if end := c.planCountedLoop(p, i); end > i {
+			i = end
+			continue
+		}
+		dead := op.reg >= 0 && p.live[i]&regBit(op.reg) == 0
+
+		// Register-only ops nobody reads. DIV/MOD keep their zero trap.
+		if dead && op.kind != OpDirect && op.kind != OpRegIndirect {
+			switch op.mnem {
+			case "LOAD", "NOT", "ADD", "SUB", "MUL", "AND", "OR", "XOR", "SHL", "SHR":
+				p.plan[i] = nil
+				continue
+			}
+		}
+
+		// ADD/SUB #a, ADD/SUB #b, ... on one register.
+		if (op.mnem == "ADD" || op.mnem == "SUB") && op.immOK {
+			delta := signedImm(op)
+			j := i + 1
+			for follows(j) && p.ops[j].reg == op.reg && (p.ops[j].mnem == "ADD" || p.ops[j].mnem == "SUB") && p.ops[j].immOK {
+				delta += signedImm(&p.ops[j])
+				p.skip[j] = true
+				j++
+			}
+			if j > i+1 {
+				switch {
+				case delta == 0:
+					p.plan[i] = nil
+				case delta < 1<<31:
+					p.plan[i] = []string{fmt.Sprintf("add%s %s, %s, #%d", sz, c.regName(op.reg), c.regName(op.reg), delta)}
+				default:
+					p.plan[i] = []string{fmt.Sprintf("sub%s %s, %s, #%d", sz, c.regName(op.reg), c.regName(op.reg), -delta)}
+				}
+				i = j - 1
+				continue
+			}
+		}
+
+		// [LOAD R, S] [SUB R, T] JZ/JNZ R, L with R dead afterwards.
+		j := i
+		lhs := op.reg
+		if op.mnem == "LOAD" && op.kind == OpRegister && op.src >= 0 && op.src != op.reg {
+			lhs = op.src
+			j++
+		}
+		var cmp *ie32Op
+		if j < len(p.ops) && (j == i || follows(j)) && p.ops[j].mnem == "SUB" && p.ops[j].reg == op.reg &&
+			(p.ops[j].kind == OpRegister && p.ops[j].src != op.reg || p.ops[j].immOK) {
+			cmp = &p.ops[j]
+			j++
+		}
+		if j == i || !follows(j) || (p.ops[j].mnem != "JZ" && p.ops[j].mnem != "JNZ") || p.ops[j].reg != op.reg ||
+			p.live[j]&regBit(op.reg) != 0 {
+			continue
+		}
+		br := map[string]string{"JZ": "beq", "JNZ": "bne"}[p.ops[j].mnem]
+		var fused []string
+		switch {
+		case cmp == nil:
+			fused = []string{fmt.Sprintf("%sz %s, %s", br, c.regName(lhs), p.ops[j].target)}
+		case cmp.kind == OpRegister:
+			fused = []string{fmt.Sprintf("%s %s, %s, %s", br, c.regName(lhs), c.regName(cmp.src), p.ops[j].target)}
+		case cmp.imm == 0:
+			fused = []string{fmt.Sprintf("%sz %s, %s", br, c.regName(lhs), p.ops[j].target)}
+		case lhs != op.reg:
+			fused = []string{
+				fmt.Sprintf("move%s r17, #%d", sz, cmp.imm),
+				fmt.Sprintf("%s %s, r17, %s", br, c.regName(lhs), p.ops[j].target),
+			}
+		default:
+			continue // SUB R,#k; Jcc R is already two instructions
+		}
+		p.plan[i] = fused
+		for k := i + 1; k <= j; k++ {
+			p.skip[k] = true
+		}
+		i = j
+	}
+}
+
+// signedImm is an ADD/SUB immediate as a 32-bit delta.
+func signedImm(op *ie32Op) uint32 {
+	if op.mnem == "SUB" {
+		return -op.imm
+	}
+	return op.imm
+}
+
+// currentOp returns the analysed op for the line being converted, or nil
+// at -O0 and for lines the optimiser does not model.
+func (c *Converter) currentOp() (int, *ie32Op) {
+	if c.prog == nil {
+		return -1, nil
+	}
+	i, ok := c.prog.byLine[c.curLine]
+	if !ok {
+		return -1, nil
+	}
+	return i, &c.prog.ops[i]
+}
+
+// optimizeInstruction returns the lines for the current instruction when
+// the optimiser rewrites it; handled is false to fall back to the
+// mechanical lowering.
+func (c *Converter) optimizeInstruction(indent string) (out []string, handled bool) {
+	i, op := c.currentOp()
+	if op == nil || op.barrier {
+		return nil, false
+	}
+	if c.prog.skip[i] {
+		return nil, true
+	}
+	if plan, ok := c.prog.plan[i]; ok {
+		for _, l := range plan {
+			out = append(out, indent+l)
+		}
+		return out, true
+	}
+	st := &c.prog.in[i]
+
+	// Identity ALU ops.
+	if op.immOK {
+		switch {
+		case op.imm == 0 && (op.mnem == "ADD" || op.mnem == "SUB" || op.mnem == "OR" || op.mnem == "XOR" || op.mnem == "SHL" || op.mnem == "SHR"),
+			op.imm == 1 && (op.mnem == "MUL" || op.mnem == "DIV"),
+			op.imm == 0xFFFFFFFF && op.mnem == "AND":
+			return nil, true
+		}
+	}
+	if op.mnem == "LOAD" && op.kind == OpRegister && op.src == op.reg {
+		return nil, true
+	}
+
+	if isBranch(op.mnem) {
+		v := st[op.reg]
+		if v.kind == valConst {
+			if branchTaken(op.mnem, int32(v.c)) {
+				return []string{indent + "bra " + op.target}, true
+			}
+			return nil, true
+		}
+		if op.mnem == "JZ" || op.mnem == "JNZ" || v.nonNeg() {
+			return nil, false
+		}
+		ie64 := map[string]string{"JGT": "bgtz", "JGE": "bgez", "JLT": "bltz", "JLE": "blez"}[op.mnem]
+		return []string{
+			indent + "sext.l r17, " + c.regName(op.reg),
+			indent + ie64 + " r17, " + op.target,
+		}, true
+	}
+
+	// DIV/MOD by a register holding a known non-zero constant.
+	if (op.mnem == "DIV" || op.mnem == "MOD") && op.kind == OpRegister && op.src >= 0 {
+		if v := st[op.src]; v.kind == valConst && v.c != 0 {
+			ie64op := map[string]string{"DIV": "divu", "MOD": "mod"}[op.mnem]
+			r := c.regName(op.reg)
+			return []string{indent + ie64op + c.sizeSuffix + " " + r + ", " + r + ", " + c.regName(op.src)}, true
+		}
+	}
+	return nil, false
+}
+
+func branchTaken(mn string, v int32) bool {
+	switch mn {
+	case "JZ":
+		return v == 0
+	case "JNZ":
+		return v != 0
+	case "JGT":
+		return v > 0
+	case "JGE":
+		return v >= 0
+	case "JLT":
+		return v < 0
+	}
+	return v <= 0
+}
+
+// directRef returns the lines that materialise a direct (@addr) operand
+// and the IE64 memory reference that reads it. The optimising levels use
+// the absolute displacement form; la is lea addr(r0), so the effective
+// address is the same.
+func (c *Converter) directRef(addr, indent string) ([]string, string) {
+	if c.prog != nil {
+		return nil, addr + "(r0)"
+	}
+	return []string{indent + "la r17, " + addr}, "(r17)"
+}
+
+// planCountedLoop unrolls a memcpy/memset-shaped loop twice when its trip
+// count is a known even constant on entry:
+//
+//	L:  LOAD/STORE R, [P]        ; one or more, no offsets
+//	    ADD P, #s                ; per pointer, after its accesses
+//	    SUB C, #1
+//	    JNZ C, L
+//
+// The second copy addresses s(P) before the bumps, which become ADD P,#2s,
+// and the counter steps by two. Accesses keep their order and width. It
+// returns the index of the loop's JNZ, or -1.
+func (c *Converter) planCountedLoop(p *ie32Program, head int) int {
+	ops := p.ops
+	if !ops[head].leader || head == 0 || p.enterUnknown[head] || p.branchRefs[head] != 1 {
+		return -1
+	}
+	i := head
+	bumped := map[int]uint32{}
+	var body []*ie32Op
+	for ; i < len(ops) && (ops[i].mnem == "LOAD" || ops[i].mnem == "STORE") && ops[i].kind == OpRegIndirect; i++ {
+		if ops[i].off != "" || ops[i].src < 0 || (i > head && ops[i].leader) {
+			return -1
+		}
+		body = append(body, &ops[i])
+	}
+	for ; i < len(ops) && ops[i].mnem == "ADD" && ops[i].immOK && !ops[i].leader; i++ {
+		if _, dup := bumped[ops[i].reg]; dup {
+			return -1
+		}
+		bumped[ops[i].reg] = ops[i].imm
+	}
+	if len(body) == 0 || len(bumped) == 0 || i+1 >= len(ops) {
+		return -1
+	}
+	sub, br := &ops[i], &ops[i+1]
+	if sub.mnem != "SUB" || !sub.immOK || sub.imm != 1 || sub.leader || br.leader ||
+		br.mnem != "JNZ" || br.reg != sub.reg || len(br.succ) == 0 || br.succ[0] != head {
+		return -1
+	}
+	counter := sub.reg
+	if _, ok := bumped[counter]; ok {
+		return -1
+	}
+	for _, op := range body {
+		if _, ok := bumped[op.src]; !ok || op.reg == counter || op.src == counter {
+			return -1
+		}
+		if _, ok := bumped[op.reg]; ok {
+			return -1 // the second copy would see the pointer before its bump
+		}
+	}
+
+	// Trip count as the loop is entered by falling in from above.
+	pre := &ops[head-1]
+	if pre.barrier || pre.mnem == "JMP" || isBranch(pre.mnem) {
+		return -1
+	}
+	entry := p.in[head-1]
+	c.transfer(pre, &entry)
+	if n := entry[counter]; n.kind != valConst || n.c == 0 || n.c%2 != 0 {
+		return -1
+	}
+
+	sz := c.sizeSuffix
+	access := func(op *ie32Op, disp string) string {
+		mn := map[string]string{"LOAD": "load", "STORE": "store"}[op.mnem]
+		return fmt.Sprintf("%s%s %s, %s(%s)", mn, sz, c.regName(op.reg), disp, c.regName(op.src))
+	}
+	var lines []string
+	for _, op := range body {
+		lines = append(lines, access(op, ""))
+	}
+	for _, op := range body {
+		lines = append(lines, access(op, fmt.Sprint(bumped[op.src])))
+	}
+	for r := 0; r < ie32RegCount; r++ {
+		if s, ok := bumped[r]; ok {
+			lines = append(lines, fmt.Sprintf("add%s %s, %s, #%d", sz, c.regName(r), c.regName(r), 2*s))
+		}
+	}
+	lines = append(lines,
+		fmt.Sprintf("sub%s %s, %s, #2", sz, c.regName(counter), c.regName(counter)),
+		fmt.Sprintf("bnez %s, %s", c.regName(counter), br.target),
+	)
+	p.plan[head] = lines
+	for k := head + 1; k <= i+1; k++ {
+		p.skip[k] = true
+	}
+	return i + 1
+}
@@ -0,0 +1,198 @@
+package main
+
+import (
+	"strings"
+	"testing"
+)
+
+// optLines converts src at the given -O level and returns the non-blank,
+// non-comment output lines with indentation stripped.
+func optLines(t *testing.T, level int, src string) []string {
+	t.Helper()
+	c := NewConverter()
+	c.noHeader = true
+	c.optLevel = level
+	out := c.ConvertFile(src)
+	if c.errors > 0 {
+		t.Fatalf("conversion errors:\n%s", out)
+	}
+	var lines []string
+	for _, l := range strings.Split(out, "\n") {
+		l = strings.TrimSpace(l)
+		if l != "" && !strings.HasPrefix(l, ";") {
+			lines = append(lines, l)
+		}
+	}
+	return lines
+}
+
+// ============================================================================
+// -O1: Width Analysis and Address Folding
+// ============================================================================
+
+func TestOptimize_O0Unchanged(t *testing.T) {
+	src := "LDA @0x5000\nADD A, #0\nJLT A, out\nout:\nHALT"
+	c := NewConverter()
+	c.noHeader = true
+	want := c.ConvertFile(src)
+	c = NewConverter()
+	c.noHeader = true
+	c.optLevel = 0
+	if got := c.ConvertFile(src); got != want {
+		t.Fatalf("-O0 output differs from the mechanical conversion:\n%s\nwant:\n%s", got, want)
+	}
+}
+
+func TestOptimize_DirectAddressFold(t *testing.T) {
+	got := optLines(t, 1, "LDA @0x5000\nSTA @VIDEO_CTRL\nADD A, @0x5004\nHALT")
+	expectLines(t, got, []string{
+		"load.l r1, 0x5000(r0)",
+		"store.l r1, VIDEO_CTRL(r0)",
+		"load.l r17, 0x5004(r0)",
+		"add.l r1, r1, r17",
+		"halt",
+	})
+}
+
+func TestOptimize_IdentityRemoved(t *testing.T) {
+	got := optLines(t, 1, "LDA [B]\nADD A, #0\nOR A, #0\nSHL A, #0\nLDB B\nHALT")
+	expectLines(t, got, []string{"load.l r1, (r5)", "halt"})
+}
+
+func TestOptimize_SignedBranchSignExtends(t *testing.T) {
+	got := optLines(t, 1, "LDA [B]\nJLT A, neg\nneg:\nHALT")
+	expectLines(t, got, []string{
+		"load.l r1, (r5)",
+		"sext.l r17, r1",
+		"bltz r17, neg",
+		"neg:",
+		"halt",
+	})
+}
+
+func TestOptimize_SignedBranchKnownNonNegative(t *testing.T) {
+	// A zero-extended byte load cannot have bit 31 set.
+	got := optLines(t, 1, "LDA [B]\nAND A, #0xFF\nJGT A, pos\npos:\nHALT")
+	expectLines(t, got, []string{
+		"load.l r1, (r5)",
+		"and.l r1, r1, #0xFF",
+		"bgtz r1, pos",
+		"pos:",
+		"halt",
+	})
+}
+
+func TestOptimize_ConstantBranchFolded(t *testing.T) {
+	got := optLines(t, 1, "LDA #0x80000000\nJLT A, neg\nLDB #1\nneg:\nJZ A, never\nHALT\nnever:\nHALT")
+	expectLines(t, got, []string{
+		"move.l r1, #0x80000000",
+		"bra neg",
+		"move.l r5, #1",
+		"neg:",
+		"halt",
+		"never:",
+		"halt",
+	})
+}
+
+func TestOptimize_DivGuardDroppedForKnownDivisor(t *testing.T) {
+	got := optLines(t, 1, "LDA [B]\nLDX #3\nDIV A, X\nHALT")
+	expectLines(t, got, []string{
+		"load.l r1, (r5)",
+		"move.l r2, #3",
+		"divu.l r1, r1, r2",
+		"halt",
+	})
+	// A divisor that may be zero keeps its guard.
+	got = optLines(t, 1, "LDA [B]\nLDX [C]\nDIV A, X\nHALT")
+	if !strings.Contains(strings.Join(got, "\n"), "beqz r2, __ie32to64_div_zero_0") {
+		t.Fatalf("divide guard missing:\n%s", strings.Join(got, "\n"))
+	}
+}
+
+func TestOptimize_QuadSizeDisablesAnalysis(t *testing.T) {
+	c := NewConverter()
+	c.noHeader = true
+	c.optLevel = 2
+	c.sizeSuffix = ".q"
+	out := c.ConvertFile("LDA @0x5000\nADD A, #0\nHALT")
+	if !strings.Contains(out, "la r17, 0x5000") || !strings.Contains(out, "add.q r1, r1, #0") {
+		t.Fatalf("-size .q output was optimised:\n%s", out)
+	}
+}
+
+// ============================================================================
+// -O2: Idiom Fusion
+// ============================================================================
+
+func TestOptimize_ImmediateRunsMerged(t *testing.T) {
+	got := optLines(t, 2, "LDA [B]\nADD A, #3\nADD A, #4\nSUB A, #2\nSTA [C]\nHALT")
+	expectLines(t, got, []string{
+		"load.l r1, (r5)",
+		"add.l r1, r1, #5",
+		"store.l r1, (r6)",
+		"halt",
+	})
+}
+
+func TestOptimize_CompareBranchFused(t *testing.T) {
+	// A is overwritten after the loop exits, so the subtract folds into the
+	// compare.
+	src := "LDB #0\nloop:\nINC B\nLDA B\nSUB A, #100\nJNZ A, loop\nLDA #0\nHALT"
+	got := optLines(t, 2, src)
+	expectLines(t, got, []string{
+		"move.l r5, #0",
+		"loop:",
+		"add.l r5, r5, #1",
+		"move.l r17, #100",
+		"bne r5, r17, loop",
+		"move.l r1, #0",
+		"halt",
+	})
+	// With A live after the branch the subtract has to stay.
+	got = optLines(t, 2, "LDB #0\nloop:\nINC B\nLDA B\nSUB A, #100\nJNZ A, loop\nHALT")
+	if !strings.Contains(strings.Join(got, "\n"), "sub.l r1, r1, #100") {
+		t.Fatalf("live compare result removed:\n%s", strings.Join(got, "\n"))
+	}
+}
+
+func TestOptimize_CopyLoopUnrolled(t *testing.T) {
+	src := "LDX #0x4000\nLDY #0x4200\nLDC #64\ncopy:\nLDA [X]\nSTA [Y]\nADD X, #4\nADD Y, #4\nSUB C, #1\nJNZ C, copy\nHALT"
+	got := optLines(t, 2, src)
+	expectLines(t, got, []string{
+		"move.l r2, #0x4000",
+		"move.l r3, #0x4200",
+		"move.l r6, #64",
+		"copy:",
+		"load.l r1, (r2)",
+		"store.l r1, (r3)",
+		"load.l r1, 4(r2)",
+		"store.l r1, 4(r3)",
+		"add.l r2, r2, #8",
+		"add.l r3, r3, #8",
+		"sub.l r6, r6, #2",
+		"bnez r6, copy",
+		"halt",
+	})
+}
+
+func TestOptimize_CopyLoopNotUnrolled(t *testing.T) {
+	for name, src := range map[string]string{
+		"odd count":      "LDX #0x4000\nLDC #63\nfill:\nSTA [X]\nADD X, #4\nSUB C, #1\nJNZ C, fill\nHALT",
+		"stores pointer": "LDX #0x4000\nLDC #64\nfill:\nSTX [X]\nADD X, #4\nSUB C, #1\nJNZ C, fill\nHALT",
+		"stores counter": "LDX #0x4000\nLDC #64\nfill:\nSTC [X]\nADD X, #4\nSUB C, #1\nJNZ C, fill\nHALT",
+		"unknown count":  "LDX #0x4000\nLDC [Y]\nfill:\nSTA [X]\nADD X, #4\nSUB C, #1\nJNZ C, fill\nHALT",
+	} {
+		got := strings.Join(optLines(t, 2, src), "\n")
+		if strings.Contains(got, "4(r2)") || strings.Contains(got, "#8") {
+			t.Errorf("%s: loop unrolled:\n%s", name, got)
+		}
+	}
+}
+
+func TestCountInstructions(t *testing.T) {
+	out := "; header\ninclude \"ie64.inc\"\nFOO equ 1\n    org 0x1000\nloop:\n    add.l r1, r1, #1\n    bnez r1, loop ; again\n    dc.l 1,2\n    ds.b 4\n\n    halt\n"
+	if n := CountInstructions(out); n != 3 {
+		t.Fatalf("CountInstructions = %d, want 3", n)
+	}
+}
@@ -194,7 +194,8 @@ TEXTURE_BASE equ 0x600000
 TEX_TR equ 0x600200
 TEX_BL equ 0x620000
 TEX_BR equ 0x620200
-BACK_BUFFER equ 0x900000
+BACK_BUFFER_A equ 0x900000
+BACK_BUFFER_B equ 0xB00000
 RENDER_W equ 640
 RENDER_H equ 480
 TEX_STRIDE equ 1024
@@ -249,6 +250,7 @@ VAR_CA equ 0x46C28
 VAR_SA equ 0x46C2C
 VAR_U0 equ 0x46C30
 VAR_V0 equ 0x46C34
+VAR_DRAW_FB equ 0x46C38
 
 ; ============================================================================
 ; PROGRAM ENTRY POINT
@@ -272,6 +274,9 @@ start:
     move.l r1, #0
     la r17, VIDEO_MODE
     store.l r1, (r17)
+    move.l r1, #VRAM_START
+    la r17, VIDEO_FB_BASE
+    store.l r1, (r17)
 
     ; --- Load Texture ---
     ; Copy the 256x256 RGBA texture (embedded via .incbin) to TEXTURE_BASE
@@ -289,6 +294,9 @@ start:
     store.l r1, (r17)
     la r17, VAR_SCALE_ACC
     store.l r1, (r17)
+    move.l r1, #BACK_BUFFER_A
+    la r17, VAR_DRAW_FB
+    store.l r1, (r17)
 
     ; --- Start AHX Music Playback ---
     ; AHX (Abyss' Highest eXperience) is an Amiga-heritage tracker format.
@@ -323,30 +331,30 @@ start:
 ; 2. render_mode7:       Program the blitter with those parameters and
 ;                        trigger a full-screen affine warp into the back
 ;                        buffer at 0x900000.
-; 3. blit_to_front:      Copy the completed back buffer to VRAM (0x100000)
-;                        so the display shows the new frame.
-; 4. wait_vsync:         Synchronise with the vertical blank to prevent
+; 3. wait_vsync:         Synchronise with the vertical blank to prevent
 ;                        visual tearing.
-; 5. advance_animation:  Increment the angle and scale accumulators for
+; 4. present_frame:      Point the VideoChip at the completed render buffer.
+; 5. swap_draw_buffer:   Select the other render buffer for the next frame.
+; 6. advance_animation:  Increment the angle and scale accumulators for
 ;                        the next frame.
 ;
 ; WHY THIS ORDER?
-; We compute+render+copy BEFORE waiting for vsync. This means all the
+; We compute and render before waiting for vsync. This means all the
 ; heavy work happens during the active display period (while the previous
-; frame is being shown). The vsync wait then ensures the completed blit
-; becomes visible at the start of the next refresh cycle. This maximises
-; the time available for rendering without introducing tearing.
+; frame is being shown). The vblank edge then presents the completed buffer
+; by updating VIDEO_FB_BASE.
 ; ============================================================================
 main_loop:
     jsr compute_frame
     jsr render_mode7
-    jsr blit_to_front
     jsr wait_vsync
+    jsr present_frame
+    jsr swap_draw_buffer
     jsr advance_animation
     bra main_loop
 
 ; ============================================================================
-; WAIT FOR VSYNC (Two-Phase Synchronization)
+; WAIT FOR VSYNC (Two-Phase Synchronisation)
 ; ============================================================================
 ; Ensures exactly one frame passes between iterations of the main loop.
 ;
@@ -758,18 +766,15 @@ m240_done:
 ; affine texture warp, then triggers the blit and waits for completion.
 ;
 ; WHY DOUBLE BUFFERING?
-; The Mode7 blit writes to the BACK BUFFER at 0x900000, NOT directly to
-; VRAM (0x100000). If we wrote directly to VRAM, the display would show
-; a partially-rendered frame (tearing) because the blit takes multiple
-; scanline periods to complete. By rendering to an off-screen buffer
-; and then copying the result to VRAM in a single fast blit (blit_to_front),
-; we ensure the display always shows a complete frame.
+; The Mode7 blit writes to the current off-screen render buffer, not the
+; buffer currently being scanned out. At vblank, VIDEO_FB_BASE is updated
+; to present the completed frame, then the other render buffer is selected.
 ;
 ; === BLITTER PARAMETER SETUP ===
 ;
 ;   BLT_OP = 5                    Mode7 affine texture mapping operation
 ;   BLT_SRC = TEXTURE_BASE        Source texture at 0x600000
-;   BLT_DST = BACK_BUFFER         Destination at 0x900000
+;   BLT_DST = VAR_DRAW_FB         Current off-screen render buffer
 ;   BLT_WIDTH = 640               Output width in pixels
 ;   BLT_HEIGHT = 480              Output height in pixels
 ;   BLT_SRC_STRIDE = 1024         Texture row stride (256 px * 4 bytes)
@@ -808,7 +813,8 @@ render_mode7:
     move.l r1, #TEXTURE_BASE
     la r17, BLT_SRC
     store.l r1, (r17)
-    move.l r1, #BACK_BUFFER
+    la r17, VAR_DRAW_FB
+    load.l r1, (r17)
     la r17, BLT_DST
     store.l r1, (r17)
 
@@ -884,52 +890,34 @@ rm7_wait:
     rts
 
 ; ============================================================================
-; BLIT BACK BUFFER TO FRONT (VRAM)
+; PRESENT COMPLETED FRAME
 ; ============================================================================
-; Copies the completed Mode7 render from the back buffer (0x900000)
-; to VRAM (0x100000) using the blitter's COPY operation (BLT_OP=0).
-;
-; WHY NOT JUST RENDER DIRECTLY TO VRAM?
-; Direct rendering causes tearing: the display refreshes at 60 Hz and
-; reads VRAM continuously. If we write to VRAM while it's being scanned
-; out, the top half of the screen might show the new frame while the
-; bottom still shows the old frame. Double buffering eliminates this by
-; completing the full render off-screen, then swapping instantaneously.
-;
-; The copy blit itself is fast enough to complete within the vblank
-; interval, so the buffer swap appears atomic to the viewer.
+; Points the VideoChip at the completed render buffer. No full-screen copy is
+; needed, so the blitter is free for the next Mode7 render.
 ; ============================================================================
-blit_to_front:
-    move.l r1, #0
-    la r17, BLT_OP
-    store.l r1, (r17)
-    move.l r1, #BACK_BUFFER
-    la r17, BLT_SRC
-    store.l r1, (r17)
-    move.l r1, #VRAM_START
-    la r17, BLT_DST
-    store.l r1, (r17)
-    move.l r1, #RENDER_W
-    la r17, BLT_WIDTH
-    store.l r1, (r17)
-    move.l r1, #RENDER_H
-    la r17, BLT_HEIGHT
-    store.l r1, (r17)
-    move.l r1, #LINE_BYTES_V
-    la r17, BLT_SRC_STRIDE
-    store.l r1, (r17)
-    la r17, BLT_DST_STRIDE
-    store.l r1, (r17)
-    move.l r1, #1
-    la r17, BLT_CTRL
+present_frame:
+    la r17, VAR_DRAW_FB
+    load.l r1, (r17)
+    la r17, VIDEO_FB_BASE
     store.l r1, (r17)
+    rts
 
-btf_wait:
-    la r17, BLT_CTRL
+; ============================================================================
+; SWAP DRAW BUFFER
+; ============================================================================
+swap_draw_buffer:
+    la r17, VAR_DRAW_FB
     load.l r1, (r17)
-    and.l r1, r1, #2
-    bnez r1, btf_wait
-
+    sub.l r1, r1, #BACK_BUFFER_A
+    bnez r1, use_buffer_a
+    move.l r1, #BACK_BUFFER_B
+    la r17, VAR_DRAW_FB
+    store.l r1, (r17)
+    rts
+use_buffer_a:
+    move.l r1, #BACK_BUFFER_A
+    la r17, VAR_DRAW_FB
+    store.l r1, (r17)
     rts
 
 ; ============================================================================
@@ -76,6 +76,22 @@ type Converter struct {
 	// empty by default; projects may opt in for platform ABI calls they provide
 	// as native labels.
 	directJSR map[string]string
+
+	// Chunked translation (translate_parallel.go). jobs caps the worker
+	// goroutines (0 = one per CPU, 1 = in-order single pass); cacheDir, when
+	// set, persists per-chunk results; timings collects per-phase durations
+	// for -timings. chunkConsts is non-nil only on a chunk worker's clone,
+	// where addFPConst hands out placeholders resolved at merge.
+	jobs        int
+	cacheDir    string
+	timings     *phaseTimings
+	chunkConsts *[]fpConstEntry
+	cacheHits   int
+	chunkCount  int
+
+	// peephole runs PeepholeIE64 over the finished output (peephole.go).
+	peephole      bool
+	peepholeStats PeepholeStats
 }
 
 type addrRange struct {
@@ -122,22 +138,44 @@ func (c *Converter) ConvertLines(input []string) (string, int) {
 		e.sb.WriteString("; Converted from m68k by m68kto64\n\n")
 	}
 	// Pre-lex all lines so peephole fuse can look ahead.
-	lines := make([]Line, len(input))
-	for i, r := range input {
-		lines[i] = LexLine(r)
-	}
+	done := c.timings.phase("lex")
+	lines := lexLinesParallel(input, c.workers())
+	done()
+	// Split at labels into independently translatable chunks; both
+	// liveness passes and emission run per chunk (translate_parallel.go).
+	chunks := splitTranslationChunks(lines)
 	// Compute ShadowFPCC liveness across the routine.
-	c.fpccLiveAt = computeFPCCLiveness(lines)
-	if c.flagLiveness {
-		c.intCCLiveAt = computeIntegerCCLiveness(lines)
-	} else {
-		c.intCCLiveAt = nil
-	}
+	done = c.timings.phase("liveness")
+	c.fpccLiveAt, c.intCCLiveAt = computeChunkedLiveness(lines, chunks, c.flagLiveness, c.workers())
+	done()
 	// Phase-2 RTE-walkback: partition the line stream into handler regions
 	// when -fp-irq-wrap is enabled. No-op when disabled.
+	done = c.timings.phase("irq-scan")
 	c.scanRTEHandlerBlocks(lines)
-	i := 0
-	for i < len(lines) {
+	done()
+	done = c.timings.phase("emit")
+	if c.fpIrqWrap || (c.workers() == 1 && c.cacheDir == "") {
+		// Handler entry stubs read needsFP56Save/needsFP7Save as emission
+		// goes, so -fp-irq-wrap keeps the single in-order pass.
+		c.emitRange(e, lines, 0, len(lines))
+	} else {
+		c.emitChunks(e, input, lines, chunks)
+	}
+	done()
+	c.emitFPFooter(e)
+	out := e.String()
+	if c.peephole {
+		done = c.timings.phase("peephole")
+		out, c.peepholeStats = PeepholeIE64(out)
+		done()
+	}
+	return out, c.errors
+}
+
+// emitRange lowers lines[start:end] into e.
+func (c *Converter) emitRange(e *Emit, lines []Line, start, end int) {
+	i := start
+	for i < end {
 		c.curLineIdx = i
 		l := lines[i]
 		// Peephole fuse: CMP/TST + Bcc on adjacent lines.
@@ -165,8 +203,6 @@ func (c *Converter) ConvertLines(input []string) (string, int) {
 		c.convertLexed(e, l)
 		i++
 	}
-	c.emitFPFooter(e)
-	return e.String(), c.errors
 }
 
 // laterIntegerCCConsumerBeforeProducer reports whether flags from a candidate
@@ -16,6 +16,9 @@ type Emit struct {
 	// own Emit) don't collide when kmake.sh concatenates two transpiled TUs
 	// into one ie64asm input. Set via Emit.SetLabelSalt before lowering.
 	labelSalt string
+	// deferLabels makes NewLabel emit sequence placeholders instead of
+	// numbers; a chunk merge renumbers them (translate_parallel.go).
+	deferLabels bool
 }
 
 // SetLabelSalt namespaces NewLabel output. Empty salt keeps the
@@ -45,6 +48,9 @@ func (e *Emit) Label(name string) {
 // so the same prefix in different TUs cannot collide post-concat.
 func (e *Emit) NewLabel(prefix string) string {
 	e.labelSeq++
+	if e.deferLabels {
+		return fmt.Sprintf("__m68kto64_%s%s_%c%d%c", saltPrefix(e.labelSalt), prefix, chunkLabelMark, e.labelSeq, chunkLabelMark)
+	}
 	if e.labelSalt != "" {
 		return fmt.Sprintf("__m68kto64_%s_%s_%d", e.labelSalt, prefix, e.labelSeq)
 	}
@@ -2,6 +2,7 @@ package main
 
 import (
 	"fmt"
+	"sort"
 	"strings"
 )
 
@@ -420,6 +421,9 @@ type fpConstEntry struct {
 }
 
 func (c *Converter) addFPConst(d string, comment string) string {
+	if c.chunkConsts != nil {
+		return c.addChunkFPConst(d, comment)
+	}
 	if c.fpConsts == nil {
 		c.fpConsts = map[string]fpConstEntry{}
 	}
@@ -892,7 +896,18 @@ func (c *Converter) emitFPFooter(e *Emit) {
 		e.Label(FPSlotFP7Save)
 		e.L("dc.q 0    ; FP7 spill around ftanh hyperbolic helper (Phase F1)")
 	}
+	// Pool order follows first use, so output is reproducible run to run.
+	pool := make([]fpConstEntry, 0, len(c.fpConsts))
 	for _, ent := range c.fpConsts {
+		pool = append(pool, ent)
+	}
+	sort.Slice(pool, func(i, j int) bool {
+		if len(pool[i].Label) != len(pool[j].Label) {
+			return len(pool[i].Label) < len(pool[j].Label)
+		}
+		return pool[i].Label < pool[j].Label
+	})
+	for _, ent := range pool {
 		e.Label(ent.Label)
 		e.Lf("dc.d %s   ; %s", ent.DCD, ent.Comment)
 	}
@@ -30,20 +30,8 @@ import "strings"
 // =====================================================================
 
 func computeFPCCLiveness(lines []Line) map[int]bool {
-	live := false
 	out := map[int]bool{}
-	for i := len(lines) - 1; i >= 0; i-- {
-		l := lines[i]
-		if isFPCCConsumer(l) {
-			live = true
-		} else if isFPCCProducer(l) {
-			out[i] = live
-			live = false
-		}
-		if l.Label != "" || l.Kind == LineLabelOnly {
-			live = true
-		}
-	}
+	ccLivenessRange(lines, 0, len(lines), false, isFPCCConsumer, isFPCCProducer, out)
 	return out
 }
 
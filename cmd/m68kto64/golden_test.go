@@ -1,6 +1,7 @@
 package main
 
 import (
+	"fmt"
 	"os"
 	"os/exec"
 	"path/filepath"
@@ -85,3 +86,45 @@ func findRepoRoot() (string, error) {
 		dir = parent
 	}
 }
+
+// BenchmarkConvertGoldenCorpus translates every golden input, repeated to a
+// realistic file size, through the single in-order pass and the chunked
+// parallel path.
+func BenchmarkConvertGoldenCorpus(b *testing.B) {
+	srcs, err := filepath.Glob("golden/*.s")
+	if err != nil || len(srcs) == 0 {
+		b.Fatalf("no golden inputs found: %v", err)
+	}
+	var corpus []string
+	for _, src := range srcs {
+		data, err := os.ReadFile(src)
+		if err != nil {
+			b.Fatal(err)
+		}
+		// Golden files share label names; rename per copy so the
+		// concatenation stays a valid program.
+		for rep := 0; rep < 50; rep++ {
+			text := string(data)
+			for _, l := range strings.Split(text, "\n") {
+				if ll := LexLine(l); ll.Label != "" && !strings.HasPrefix(ll.Label, ".") {
+					text = strings.ReplaceAll(text, ll.Label, fmt.Sprintf("%s_%d", ll.Label, rep))
+				}
+			}
+			corpus = append(corpus, strings.Split(text, "\n")...)
+		}
+	}
+	for _, bc := range []struct {
+		name string
+		jobs int
+	}{{"serial", 1}, {"parallel", 0}} {
+		b.Run(bc.name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				c := NewConverter()
+				c.noHeader = true
+				c.jobs = bc.jobs
+				c.ConvertLines(corpus)
+			}
+		})
+	}
+}
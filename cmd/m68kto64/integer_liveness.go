@@ -36,13 +36,22 @@ import "strings"
 // is true iff some integer-flag consumer reads the flags produced at
 // line i before any subsequent producer overwrites them.
 func computeIntegerCCLiveness(lines []Line) map[int]bool {
-	live := false
 	out := map[int]bool{}
-	for i := len(lines) - 1; i >= 0; i-- {
+	ccLivenessRange(lines, 0, len(lines), false, isIntegerCCConsumer, isIntegerCCProducer, out)
+	return out
+}
+
+// ccLivenessRange runs the backward liveness pass over lines[start:end],
+// entering with liveAfter as the state past end, and records producers in
+// out. Any label resets the state to live, so ranges that end just before a
+// labelled line (liveAfter = true) are independent of everything after them.
+func ccLivenessRange(lines []Line, start, end int, liveAfter bool, consumer, producer func(Line) bool, out map[int]bool) {
+	live := liveAfter
+	for i := end - 1; i >= start; i-- {
 		l := lines[i]
-		if isIntegerCCConsumer(l) {
+		if consumer(l) {
 			live = true
-		} else if isIntegerCCProducer(l) {
+		} else if producer(l) {
 			out[i] = live
 			live = false
 		}
@@ -50,7 +59,6 @@ func computeIntegerCCLiveness(lines []Line) map[int]bool {
 			live = true
 		}
 	}
-	return out
 }
 
 // isIntegerCCConsumer reports whether `l` reads any of N/Z/C/V/X.
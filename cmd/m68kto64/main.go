@@ -223,6 +223,10 @@ func run(args []string, stderrW io.Writer) int {
 	sizeFlag := fs.String("size", ".l", "Default size suffix (.l or .q)")
 	labelSalt := fs.String("label-salt", "", "Namespace __m68kto64_* labels with this salt (prevents collisions in multi-TU concat builds)")
 	flagLiveness := fs.Bool("flag-liveness", false, "Phase H: elide shadow N/Z/C/V/X emission when no downstream consumer reads them (opt-in)")
+	jobs := fs.Int("j", 0, "Worker goroutines for per-function liveness and emit (0 = one per CPU, 1 = single in-order pass)")
+	cacheDir := fs.String("cache", "", "Persist per-function translation results in DIR and reuse them on later runs")
+	peephole := fs.Bool("peephole", false, "Optimise the emitted IE64: drop dead shadow-CCR updates and moves, fold immediates and address modes")
+	timings := fs.Bool("timings", false, "Report per-phase wall-clock times on stderr")
 	var mmioRanges []addrRange
 
 	opts := DefaultPreprocOpts()
@@ -260,6 +264,12 @@ func run(args []string, stderrW io.Writer) int {
 	c.flagLiveness = *flagLiveness
 	c.mmioRanges = mmioRanges
 	c.directJSR = directJSR
+	c.jobs = *jobs
+	c.peephole = *peephole
+	c.cacheDir = *cacheDir
+	if *timings {
+		c.timings = &phaseTimings{}
+	}
 	source, errs := c.ConvertFile(in, opts, stderrW)
 	if errs > 0 && source == "" {
 		// Pure preprocessor failure (e.g. read error or lone-CR rejection);
@@ -271,10 +281,13 @@ func run(args []string, stderrW io.Writer) int {
 	if out == "" {
 		out = strings.TrimSuffix(in, ".s") + "_ie64.s"
 	}
+	done := c.timings.phase("write")
 	if err := os.WriteFile(out, []byte(source), 0o644); err != nil {
 		fmt.Fprintf(stderrW, "error writing %s: %v\n", out, err)
 		return 1
 	}
+	done()
+	c.timings.report(stderrW, c)
 	if errs > 0 {
 		fmt.Fprintf(stderrW, "%d conversion error(s); search for '; ERROR:' in %s\n", errs, out)
 		return 1
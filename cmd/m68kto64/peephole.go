@@ -0,0 +1,790 @@
+package main
+
+import (
+	"fmt"
+	"strconv"
+	"strings"
+)
+
+// =====================================================================
+// Post-emit IE64 peephole pass (-peephole)
+//
+// Runs over the finished IE64 text, after chunk merge and the FPU footer,
+// so it sees exactly what ie64asm will assemble. Lines are parsed into a
+// def/use form and a backward register-liveness pass runs over the whole
+// control-flow graph: fall-through, conditional and unconditional branches
+// to labels defined in the file. Anything the pass cannot model — jmp, jsr,
+// rts, syscalls, stack ops, directives, conditional assembly, branches to
+// labels outside the file — is a barrier where every register is live, so
+// m68k ABI conventions such as returning a status in the CCR keep working.
+// The one refinement: scratch registers r16..r23 never carry a value from
+// one m68k instruction's lowering into the next, so at the points where
+// control leaves at an m68k instruction boundary (jmp, rti, halt,
+// conditional-assembly directives, end of file) only the scratch registers
+// the barrier itself names are live. syscall keeps all of them: host
+// services take arguments in scratch registers (TAS passes r16/r17).
+//
+// Rewrites, repeated to a fixed point:
+//
+//   - dead definitions: a pure register op (move/ALU/lea/la/sext/...)
+//     whose destination is not live afterwards is deleted. This is what
+//     removes shadow N/Z/V/C/X updates (r24..r28) that every path
+//     overwrites before a consumer, across basic blocks;
+//   - self-moves (move.q rX,rX);
+//   - constant propagation within a basic block: an op whose inputs are
+//     all known becomes one move of the result, or disappears when the
+//     register already holds it (repeated shadow clears, constant masks);
+//   - immediate folding: a known register in the third operand of an ALU
+//     op becomes that op's immediate form;
+//   - address-mode folding: lea rT,d(rB) / la rT,sym feeding the next
+//     load/store/dload/dstore through (rT) becomes d(rB) / sym(r0).
+//
+// Loads are never deleted (MMIO reads have side effects) and guest stores
+// are never merged: whether two adjacent stores may become one wider
+// access depends on MMIO ranges and alignment the emitted text no longer
+// records.
+// =====================================================================
+
+const (
+	ieRegSP   = 31
+	ieAllRegs = ^uint32(1) // r1..r31; r0 reads as zero and ignores writes
+	ieScratch = uint32(0xFF) << 16
+	ieExitLiv = ieAllRegs &^ ieScratch
+)
+
+type ieLineKind int
+
+const (
+	ieLineOther   ieLineKind = iota // blank, comment: no effect
+	ieLineLabel                     // "name:"
+	ieLineInsn                      // modelled instruction
+	ieLineBarrier                   // unmodelled: all registers live
+	ieLineExit                      // leaves at an m68k boundary: scratch dead
+)
+
+// ieLine is one line of emitted IE64 with its dataflow summary.
+type ieLine struct {
+	text    string
+	kind    ieLineKind
+	label   string // ieLineLabel: scoped label name
+	mnem    string // base mnemonic, lower case
+	size    string // ".l", ".q", ... or ""
+	ops     []string
+	comment string
+
+	def      int    // destination register, -1 if none
+	kill     bool   // def overwrites the whole register
+	uses     uint32 // registers read
+	pure     bool   // deletable when def is dead
+	target   string // branch target (scoped), "" if none
+	cond     bool   // conditional branch: also falls through
+	jump     bool   // unconditional branch
+	deleted  bool
+	modified bool
+}
+
+// PeepholeStats reports the instruction count before and after the pass.
+type PeepholeStats struct {
+	Before, After int
+}
+
+var ieALU3 = map[string]bool{
+	"add": true, "sub": true, "mulu": true, "muls": true, "mulhu": true, "mulhs": true,
+	"and": true, "or": true, "eor": true, "lsl": true, "lsr": true, "asr": true,
+	"rol": true, "ror": true,
+}
+
+var ieALU2 = map[string]bool{
+	"neg": true, "not": true, "sext": true, "clz": true, "ctz": true, "popcnt": true, "bswap": true,
+}
+
+var ieCondBranch = map[string]int{
+	"beq": 2, "bne": 2, "blt": 2, "bge": 2, "bgt": 2, "ble": 2, "bhi": 2, "bls": 2,
+	"beqz": 1, "bnez": 1, "bltz": 1, "bgez": 1, "bgtz": 1, "blez": 1,
+}
+
+// ieFoldImm lists ALU ops whose third operand may be an immediate.
+var ieFoldImm = map[string]bool{
+	"add": true, "sub": true, "mulu": true, "muls": true,
+	"and": true, "or": true, "eor": true, "lsl": true, "lsr": true, "asr": true,
+}
+
+// ieExits are barriers at m68k instruction boundaries.
+var ieExits = map[string]bool{
+	"jmp": true, "rti": true, "halt": true,
+	"if": true, "else": true, "elseif": true, "endif": true,
+}
+
+var ieFoldMem = map[string]bool{"load": true, "store": true, "dload": true, "dstore": true}
+
+// ieReg parses r0..r31 / sp.
+func ieReg(s string) (int, bool) {
+	s = strings.ToLower(strings.TrimSpace(s))
+	if s == "sp" {
+		return ieRegSP, true
+	}
+	if len(s) < 2 || len(s) > 3 || s[0] != 'r' {
+		return 0, false
+	}
+	n := 0
+	for _, ch := range s[1:] {
+		if ch < '0' || ch > '9' {
+			return 0, false
+		}
+		n = n*10 + int(ch-'0')
+	}
+	if n > 31 || (len(s) == 3 && s[1] == '0') {
+		return 0, false
+	}
+	return n, true
+}
+
+func regBit(r int) uint32 {
+	if r <= 0 {
+		return 0
+	}
+	return 1 << uint(r)
+}
+
+// ieMemBase splits "disp(rN)" / "(rN)" into its displacement text and base
+// register.
+func ieMemBase(op string) (disp string, base int, ok bool) {
+	op = strings.TrimSpace(op)
+	if !strings.HasSuffix(op, ")") {
+		return "", 0, false
+	}
+	open := strings.LastIndexByte(op, '(')
+	if open < 0 {
+		return "", 0, false
+	}
+	base, ok = ieReg(op[open+1 : len(op)-1])
+	return strings.TrimSpace(op[:open]), base, ok
+}
+
+// ieOperandRegs returns every register an operand names, bare or as a
+// memory base.
+func ieOperandRegs(op string) uint32 {
+	if r, ok := ieReg(op); ok {
+		return regBit(r)
+	}
+	if _, base, ok := ieMemBase(op); ok {
+		return regBit(base)
+	}
+	return 0
+}
+
+// scopeLabel applies ie64asm's local-label rule: ".x" belongs to the last
+// global label, where __m68kto64_* labels do not open a new scope.
+func scopeLabel(scope, name string) string {
+	if strings.HasPrefix(name, ".") {
+		return scope + name
+	}
+	return name
+}
+
+func parseIELines(text string) []ieLine {
+	raw := strings.Split(text, "\n")
+	lines := make([]ieLine, len(raw))
+	scope := ""
+	for i, t := range raw {
+		lines[i] = parseIELine(t, &scope)
+	}
+	return lines
+}
+
+func parseIELine(text string, scope *string) ieLine {
+	l := ieLine{text: text, def: -1}
+	body := text
+	if semi := strings.IndexByte(body, ';'); semi >= 0 {
+		l.comment = strings.TrimSpace(body[semi+1:])
+		body = body[:semi]
+	}
+	trimmed := strings.TrimSpace(body)
+	if trimmed == "" {
+		return l
+	}
+	if strings.ContainsAny(text, "'\"") {
+		// A quote may hide a ';' the comment split got wrong.
+		l.kind = ieLineBarrier
+		return l
+	}
+	if text[0] != '\t' && text[0] != ' ' {
+		name, ok := strings.CutSuffix(trimmed, ":")
+		if !ok || strings.ContainsAny(name, " \t") {
+			l.kind = ieLineBarrier
+			return l
+		}
+		if !strings.HasPrefix(name, ".") && !strings.HasPrefix(name, "__m68kto64_") {
+			*scope = name
+		}
+		l.kind = ieLineLabel
+		l.label = scopeLabel(*scope, name)
+		return l
+	}
+	l.kind = ieLineBarrier
+	mnem, rest, _ := strings.Cut(trimmed, " ")
+	mnem = strings.ToLower(mnem)
+	if dot := strings.IndexByte(mnem, '.'); dot >= 0 {
+		l.size = mnem[dot:]
+		mnem = mnem[:dot]
+	}
+	l.mnem = mnem
+	if rest = strings.TrimSpace(rest); rest != "" {
+		l.ops = splitIEOperands(rest)
+	}
+	switch {
+	case mnem == "nop" && len(l.ops) == 0:
+		l.kind = ieLineInsn
+	case mnem == "move" || mnem == "moveq" || mnem == "movt" || mnem == "li":
+		if len(l.ops) != 2 {
+			return l
+		}
+		rd, ok := ieReg(l.ops[0])
+		rs, rsOK := ieReg(l.ops[1])
+		if !ok || (!rsOK && !strings.HasPrefix(l.ops[1], "#")) {
+			return l
+		}
+		l.setDef(rd)
+		if rsOK {
+			l.uses |= regBit(rs)
+		}
+		if mnem == "movt" {
+			l.uses |= regBit(rd)
+		}
+	case mnem == "lea" || mnem == "la":
+		if len(l.ops) != 2 {
+			return l
+		}
+		rd, ok := ieReg(l.ops[0])
+		if !ok {
+			return l
+		}
+		if mnem == "lea" {
+			_, base, ok := ieMemBase(l.ops[1])
+			if !ok {
+				return l
+			}
+			l.uses |= regBit(base)
+		}
+		l.setDef(rd)
+	case ieALU3[mnem] || ieALU2[mnem]:
+		want := 3
+		if ieALU2[mnem] {
+			want = 2
+		}
+		if len(l.ops) != want {
+			return l
+		}
+		rd, ok := ieReg(l.ops[0])
+		if !ok {
+			return l
+		}
+		for _, op := range l.ops[1:] {
+			if rs, ok := ieReg(op); ok {
+				l.uses |= regBit(rs)
+			} else if !strings.HasPrefix(op, "#") {
+				return l
+			}
+		}
+		l.setDef(rd)
+	case mnem == "load" || mnem == "store":
+		if len(l.ops) != 2 {
+			return l
+		}
+		rd, ok := ieReg(l.ops[0])
+		_, base, bok := ieMemBase(l.ops[1])
+		if !ok || !bok {
+			return l
+		}
+		l.kind = ieLineInsn
+		l.uses = regBit(base)
+		if mnem == "load" {
+			l.def, l.kill = rd, rd != 0
+		} else {
+			l.uses |= regBit(rd)
+		}
+	case ieCondBranch[mnem] > 0:
+		n := ieCondBranch[mnem]
+		if len(l.ops) != n+1 {
+			return l
+		}
+		for _, op := range l.ops[:n] {
+			rs, ok := ieReg(op)
+			if !ok {
+				return l
+			}
+			l.uses |= regBit(rs)
+		}
+		l.kind = ieLineInsn
+		l.cond = true
+		l.target = scopeLabel(*scope, l.ops[n])
+	case mnem == "bra":
+		if len(l.ops) != 1 {
+			return l
+		}
+		l.kind = ieLineInsn
+		l.jump = true
+		l.target = scopeLabel(*scope, l.ops[0])
+	case ieExits[mnem]:
+		l.kind = ieLineExit
+		for _, op := range l.ops {
+			l.uses |= ieOperandRegs(op)
+		}
+	case isIEFPUMnemonic(mnem):
+		// FPU ops touch integer registers only through the operands they
+		// name (memory bases, dcmp/fmov* transfers); none is killed.
+		l.kind = ieLineInsn
+		for _, op := range l.ops {
+			l.uses |= ieOperandRegs(op)
+		}
+	}
+	return l
+}
+
+// splitIEOperands splits on commas outside parentheses.
+func splitIEOperands(s string) []string {
+	var ops []string
+	depth, start := 0, 0
+	for i := 0; i < len(s); i++ {
+		switch s[i] {
+		case '(':
+			depth++
+		case ')':
+			depth--
+		case ',':
+			if depth == 0 {
+				ops = append(ops, strings.TrimSpace(s[start:i]))
+				start = i + 1
+			}
+		}
+	}
+	return append(ops, strings.TrimSpace(s[start:]))
+}
+
+func (l *ieLine) setDef(rd int) {
+	l.kind = ieLineInsn
+	l.def = rd
+	l.kill = rd != 0
+	l.pure = rd != 0 && rd != ieRegSP
+}
+
+// isIEFPUMnemonic matches the f*/d* FPU families, excluding the integer
+// divides and data directives that share the letters.
+func isIEFPUMnemonic(m string) bool {
+	switch m {
+	case "divu", "divs", "dc", "ds", "dcb":
+		return false
+	}
+	return len(m) > 1 && (m[0] == 'f' || m[0] == 'd')
+}
+
+// ieLiveness computes the registers live after each line.
+func ieLiveness(lines []ieLine) []uint32 {
+	labels := map[string]int{}
+	for i := range lines {
+		if lines[i].kind != ieLineLabel {
+			continue
+		}
+		if _, dup := labels[lines[i].label]; dup {
+			labels[lines[i].label] = -1 // ambiguous (e.g. if/else arms)
+		} else {
+			labels[lines[i].label] = i
+		}
+	}
+	targetOf := make([]int, len(lines))
+	for i := range lines {
+		targetOf[i] = -1
+		if lines[i].target != "" {
+			targetOf[i] = -2 // outside the file or ambiguous: all live
+			if t, ok := labels[lines[i].target]; ok && t >= 0 {
+				targetOf[i] = t
+			}
+		}
+	}
+	in := make([]uint32, len(lines))
+	out := make([]uint32, len(lines))
+	for changed := true; changed; {
+		changed = false
+		for i := len(lines) - 1; i >= 0; i-- {
+			l := &lines[i]
+			if l.deleted {
+				next := ieExitLiv
+				if i+1 < len(lines) {
+					next = in[i+1]
+				}
+				if in[i] != next {
+					in[i], changed = next, true
+				}
+				continue
+			}
+			var o uint32
+			switch l.kind {
+			case ieLineBarrier:
+				o = ieAllRegs
+			case ieLineExit:
+				o = ieExitLiv
+			default:
+				if !l.jump {
+					if i+1 < len(lines) {
+						o = in[i+1]
+					} else {
+						o = ieExitLiv
+					}
+				}
+				switch t := targetOf[i]; {
+				case t >= 0:
+					o |= in[t]
+				case t < -1:
+					o = ieAllRegs
+				}
+			}
+			n := o
+			if l.kill {
+				n &^= regBit(l.def)
+			}
+			n |= l.uses
+			switch l.kind {
+			case ieLineBarrier:
+				n = ieAllRegs
+			case ieLineExit:
+				n = ieExitLiv | l.uses
+			}
+			out[i] = o
+			if in[i] != n {
+				in[i], changed = n, true
+			}
+		}
+	}
+	return out
+}
+
+// nextInsn returns the index of the next live instruction after i within
+// the same basic block, or -1.
+func nextInsn(lines []ieLine, i int) int {
+	for j := i + 1; j < len(lines); j++ {
+		switch {
+		case lines[j].deleted || lines[j].kind == ieLineOther:
+			continue
+		case lines[j].kind == ieLineInsn:
+			return j
+		default:
+			return -1
+		}
+	}
+	return -1
+}
+
+// foldPairs folds lea/la feeding the next memory access into its
+// displacement. live is the
+// liveness from the previous round; a fold deletes its feeder only when
+// the feeder's register is dead after the consumer.
+func foldPairs(lines []ieLine, live []uint32) bool {
+	changed := false
+	for i := range lines {
+		a := &lines[i]
+		if a.deleted || a.kind != ieLineInsn || !a.pure {
+			continue
+		}
+		j := nextInsn(lines, i)
+		if j < 0 || a.target != "" {
+			continue
+		}
+		b := &lines[j]
+		rt := a.def
+		switch {
+		case (a.mnem == "lea" || a.mnem == "la") && ieFoldMem[b.mnem] && len(b.ops) == 2:
+			disp, base, ok := ieMemBase(b.ops[1])
+			if !ok || base != rt || (disp != "" && disp != "0") {
+				continue
+			}
+			if v, vok := ieReg(b.ops[0]); vok && v == rt && b.mnem != "load" {
+				continue // the address itself is being stored
+			}
+			if live[j]&regBit(rt) != 0 && !(b.kill && b.def == rt) {
+				continue
+			}
+			if a.mnem == "lea" {
+				b.ops[1] = a.ops[1]
+				_, ab, _ := ieMemBase(a.ops[1])
+				b.uses = b.uses&^regBit(rt) | regBit(ab)
+			} else {
+				b.ops[1] = a.ops[1] + "(r0)"
+				b.uses &^= regBit(rt)
+			}
+			if vr, ok := ieReg(b.ops[0]); ok && b.mnem != "load" {
+				b.uses |= regBit(vr)
+			}
+			b.modified = true
+			a.deleted = true
+			changed = true
+		}
+	}
+	return changed
+}
+
+// simplifyBlocks removes dead pure definitions and propagates constants
+// within each basic block: an op whose inputs are all known becomes a
+// single move of the result (or is dropped when the register already holds
+// it), and a known register in an ALU op's third operand becomes an
+// immediate.
+func simplifyBlocks(lines []ieLine, live []uint32) bool {
+	changed := false
+	known := map[int]uint64{}
+	for i := range lines {
+		l := &lines[i]
+		if l.deleted || l.kind == ieLineOther {
+			continue
+		}
+		if l.kind != ieLineInsn {
+			clear(known) // labels are merge points; barriers clobber anything
+			continue
+		}
+		if l.pure && live[i]&regBit(l.def) == 0 {
+			l.deleted, changed = true, true
+			continue
+		}
+		if l.mnem == "move" && (l.size == ".q" || l.size == "") && l.ops[1] == l.ops[0] {
+			l.deleted, changed = true, true
+			continue
+		}
+		if ieFoldImm[l.mnem] && len(l.ops) == 3 {
+			if r, ok := ieReg(l.ops[2]); ok && r != 0 {
+				if v, ok := known[r]; ok && v <= 0xFFFFFFFF {
+					l.ops[2] = ieImmText(v)
+					l.uses = 0
+					if rs, ok := ieReg(l.ops[1]); ok {
+						l.uses = regBit(rs)
+					}
+					l.modified, changed = true, true
+				}
+			}
+		}
+		if l.pure {
+			if v, ok := evalIEConst(l, known); ok {
+				if cur, held := known[l.def]; held && cur == v {
+					l.deleted, changed = true, true
+					continue
+				}
+				if setIEConst(l, v) {
+					changed = true
+				}
+				known[l.def] = v
+				continue
+			}
+		}
+		if l.kill {
+			delete(known, l.def)
+		} else if l.uses != 0 && isIEFPUMnemonic(l.mnem) {
+			// FPU transfers may write a named register.
+			for r := range known {
+				if l.uses&regBit(r) != 0 {
+					delete(known, r)
+				}
+			}
+		}
+	}
+	return changed
+}
+
+var ieSizeMask = map[string]uint64{".b": 0xFF, ".w": 0xFFFF, ".l": 0xFFFFFFFF, ".q": ^uint64(0), "": ^uint64(0)}
+
+// ieImm parses a numeric "#imm" operand as the CPU sees it: the assembler
+// keeps the low 32 bits and the ALU zero-extends them.
+func ieImm(op string) (uint64, bool) {
+	s, ok := strings.CutPrefix(op, "#")
+	if !ok {
+		return 0, false
+	}
+	s = strings.TrimSpace(s)
+	neg := strings.HasPrefix(s, "-")
+	s = strings.TrimPrefix(s, "-")
+	var v uint64
+	var err error
+	switch {
+	case strings.HasPrefix(s, "$"):
+		v, err = strconv.ParseUint(s[1:], 16, 64)
+	case strings.HasPrefix(s, "0x") || strings.HasPrefix(s, "0X"):
+		v, err = strconv.ParseUint(s[2:], 16, 64)
+	case strings.HasPrefix(s, "%"):
+		v, err = strconv.ParseUint(s[1:], 2, 64)
+	default:
+		v, err = strconv.ParseUint(s, 10, 64)
+	}
+	if err != nil {
+		return 0, false
+	}
+	if neg {
+		v = -v
+	}
+	return uint64(uint32(v)), true
+}
+
+// ieValue returns the value of a register or immediate operand if known.
+func ieValue(op string, known map[int]uint64) (uint64, bool) {
+	if r, ok := ieReg(op); ok {
+		if r == 0 {
+			return 0, true
+		}
+		v, ok := known[r]
+		return v, ok
+	}
+	return ieImm(op)
+}
+
+// evalIEConst computes l's result when every input is known, with the
+// interpreter's semantics (cpu_ie64.go).
+func evalIEConst(l *ieLine, known map[int]uint64) (uint64, bool) {
+	mask, ok := ieSizeMask[l.size]
+	if !ok {
+		return 0, false
+	}
+	switch l.mnem {
+	case "move":
+		v, ok := ieValue(l.ops[1], known)
+		return v & mask, ok
+	case "moveq":
+		v, ok := ieImm(l.ops[1])
+		return uint64(int64(int32(uint32(v)))), ok
+	case "add", "sub", "and", "or", "eor", "lsl", "lsr":
+		a, ok1 := ieValue(l.ops[1], known)
+		b, ok2 := ieValue(l.ops[2], known)
+		if !ok1 || !ok2 {
+			return 0, false
+		}
+		var v uint64
+		switch l.mnem {
+		case "add":
+			v = a + b
+		case "sub":
+			v = a - b
+		case "and":
+			v = a & b
+		case "or":
+			v = a | b
+		case "eor":
+			v = a ^ b
+		case "lsl":
+			v = a << (b & 63)
+		case "lsr":
+			v = a >> (b & 63)
+		}
+		return v & mask, true
+	case "not", "neg", "sext":
+		a, ok := ieValue(l.ops[1], known)
+		if !ok {
+			return 0, false
+		}
+		switch l.mnem {
+		case "not":
+			return ^a & mask, true
+		case "neg":
+			return uint64(-int64(a)) & mask, true
+		}
+		switch l.size {
+		case ".b":
+			return uint64(int64(int8(a))), true
+		case ".w":
+			return uint64(int64(int16(a))), true
+		case ".l":
+			return uint64(int64(int32(a))), true
+		}
+		return a, true
+	}
+	return 0, false
+}
+
+// setIEConst rewrites l as a single-instruction load of v when it is not
+// one already. It reports whether l changed.
+func setIEConst(l *ieLine, v uint64) bool {
+	var mnem, size, imm string
+	switch {
+	case v <= 0xFFFFFFFF:
+		mnem, size, imm = "move", ".l", ieImmText(v)
+	case int64(v) >= -0x80000000 && int64(v) < 0:
+		mnem, imm = "moveq", fmt.Sprintf("#%d", int64(v))
+	default:
+		return false
+	}
+	if l.mnem == "moveq" || l.mnem == "move" && strings.HasPrefix(l.ops[1], "#") {
+		return false // already a single immediate load
+	}
+	l.mnem, l.size = mnem, size
+	l.ops = []string{l.ops[0], imm}
+	l.uses = 0
+	l.modified = true
+	return true
+}
+
+func (l *ieLine) render() string {
+	var sb strings.Builder
+	sb.WriteByte('\t')
+	sb.WriteString(l.mnem)
+	sb.WriteString(l.size)
+	if len(l.ops) > 0 {
+		sb.WriteByte(' ')
+		sb.WriteString(strings.Join(l.ops, ", "))
+	}
+	if l.comment != "" {
+		sb.WriteString(" ; ")
+		sb.WriteString(l.comment)
+	}
+	return sb.String()
+}
+
+var ieDirectives = map[string]bool{
+	"dc": true, "ds": true, "dcb": true, "if": true, "else": true, "endif": true,
+	"align": true, "org": true, "include": true, "incbin": true, "equ": true, "set": true,
+}
+
+func countIEInsns(lines []ieLine) int {
+	n := 0
+	for i := range lines {
+		l := &lines[i]
+		if !l.deleted && (l.kind == ieLineInsn || (l.kind == ieLineBarrier || l.kind == ieLineExit) && l.mnem != "" && !ieDirectives[l.mnem]) {
+			n++
+		}
+	}
+	return n
+}
+
+// PeepholeIE64 optimises emitted IE64 source. The result assembles to the
+// same observable behaviour at every barrier.
+func PeepholeIE64(text string) (string, PeepholeStats) {
+	lines := parseIELines(text)
+	stats := PeepholeStats{Before: countIEInsns(lines)}
+	for round := 0; round < 16; round++ {
+		live := ieLiveness(lines)
+		changed := foldPairs(lines, live)
+		if changed {
+			live = ieLiveness(lines)
+		}
+		if !simplifyBlocks(lines, live) && !changed {
+			break
+		}
+	}
+	stats.After = countIEInsns(lines)
+	var sb strings.Builder
+	sb.Grow(len(text))
+	for i := range lines {
+		l := &lines[i]
+		switch {
+		case l.deleted:
+			continue
+		case l.modified:
+			sb.WriteString(l.render())
+		default:
+			sb.WriteString(l.text)
+		}
+		if i < len(lines)-1 {
+			sb.WriteByte('\n')
+		}
+	}
+	return sb.String(), stats
+}
+
+func ieImmText(v uint64) string {
+	if v < 10 {
+		return fmt.Sprintf("#%d", v)
+	}
+	return fmt.Sprintf("#$%X", v)
+}
@@ -0,0 +1,169 @@
+package main
+
+import (
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+// peepLines runs PeepholeIE64 over tab-indented IE64 instructions and
+// returns the surviving non-blank lines, trimmed.
+func peepLines(t *testing.T, src string) []string {
+	t.Helper()
+	out, st := PeepholeIE64(src)
+	if st.After > st.Before {
+		t.Fatalf("peephole grew the program: %d -> %d", st.Before, st.After)
+	}
+	var lines []string
+	for _, l := range strings.Split(out, "\n") {
+		if l = strings.TrimSpace(l); l != "" {
+			lines = append(lines, l)
+		}
+	}
+	return lines
+}
+
+func wantPeep(t *testing.T, src string, want ...string) {
+	t.Helper()
+	got := peepLines(t, src)
+	if strings.Join(got, "\n") != strings.Join(want, "\n") {
+		t.Fatalf("peephole output:\n%s\nwant:\n%s", strings.Join(got, "\n"), strings.Join(want, "\n"))
+	}
+}
+
+func TestPeephole_DeadShadowAcrossBlocks(t *testing.T) {
+	// The N/Z shadows written before the loop are overwritten on every
+	// path before anything reads them; the ones in the loop reach the
+	// end of the file and stay.
+	wantPeep(t, `
+	sext.l r24, r1
+	move.l r25, r1
+.loop:
+	sub.l r2, r2, #1
+	sext.l r24, r2
+	move.l r25, r2
+	bnez r2, .loop
+`,
+		".loop:",
+		"sub.l r2, r2, #1",
+		"sext.l r24, r2",
+		"move.l r25, r2",
+		"bnez r2, .loop")
+}
+
+func TestPeephole_BarriersKeepRegistersLive(t *testing.T) {
+	// A computed jump may land anywhere: guest registers and shadows stay.
+	wantPeep(t, "\tmove.l r24, #0\n\tmove.l r16, #1\n\tjmp (r17)\n",
+		"move.l r24, #0", "jmp (r17)")
+	// syscall arguments travel in scratch registers.
+	wantPeep(t, "\tmove.l r16, #1\n\tsyscall #20\n",
+		"move.l r16, #1", "syscall #20")
+	// Branches to labels defined elsewhere, or defined twice, are opaque.
+	for _, target := range []string{"elsewhere", "twice"} {
+		got := peepLines(t, "\tmove.l r5, #1\n\tbra "+target+"\ntwice:\n\tmove.l r5, #2\ntwice:\n\thalt\n")
+		if got[0] != "move.l r5, #1" {
+			t.Fatalf("bra %s: live write deleted:\n%s", target, strings.Join(got, "\n"))
+		}
+	}
+}
+
+func TestPeephole_LocalLabelScope(t *testing.T) {
+	// .next in f2 is a different label from .next in f1: the write to r5
+	// before f1's branch reaches f1's .next, which reads it.
+	got := peepLines(t, `
+f1:
+	move.l r5, #7
+	bra .next
+.next:
+	add.l r6, r6, r5
+	halt
+f2:
+.next:
+	move.l r5, #0
+	halt
+`)
+	if got[1] != "move.l r5, #7" {
+		t.Fatalf("scoped branch target lost:\n%s", strings.Join(got, "\n"))
+	}
+}
+
+func TestPeephole_AddressModeFold(t *testing.T) {
+	wantPeep(t, "\tlea r16, 8(r10)\n\tstore.b r17, (r16)\n\thalt\n",
+		"store.b r17, 8(r10)", "halt")
+	wantPeep(t, "\tla r16, table\n\tload.l r17, (r16)\n\tmove.l r1, r17\n\thalt\n",
+		"load.l r17, table(r0)", "move.l r1, r17", "halt")
+	// Storing the address register itself needs its value.
+	wantPeep(t, "\tlea r16, 4(r10)\n\tstore.l r16, (r16)\n\thalt\n",
+		"lea r16, 4(r10)", "store.l r16, (r16)", "halt")
+	// The address is still needed after the access.
+	wantPeep(t, "\tlea r9, 4(r10)\n\tload.l r1, (r9)\n\thalt\n",
+		"lea r9, 4(r10)", "load.l r1, (r9)", "halt")
+}
+
+func TestPeephole_ConstantFolding(t *testing.T) {
+	// A known third operand becomes an immediate; .w moves mask.
+	wantPeep(t, "\tmove.l r17, #1\n\tadd.l r1, r1, r17\n\thalt\n",
+		"add.l r1, r1, #1", "halt")
+	wantPeep(t, "\tmove.w r17, #$12345\n\tand.l r1, r1, r17\n\thalt\n",
+		"and.l r1, r1, #$2345", "halt")
+	// moveq sign-extends: the constant does not fit an immediate field.
+	wantPeep(t, "\tmoveq r17, #-1\n\tand.q r1, r1, r17\n\thalt\n",
+		"moveq r17, #-1", "and.q r1, r1, r17", "halt")
+	// A copy of a known value becomes an immediate load; the overwritten
+	// first write is dead.
+	wantPeep(t, "\tmove.l r26, #0\n\tmove.l r27, #0\n\tmove.l r26, r27\n\thalt\n",
+		"move.l r27, #0", "move.l r26, #0", "halt")
+	// Loads are never removed, even when their result is dead.
+	wantPeep(t, "\tload.l r16, (r10)\n\thalt\n",
+		"load.l r16, (r10)", "halt")
+}
+
+// TestPeephole_Corpus runs the golden corpus and the synthetic program
+// with -peephole and checks the output shrinks and still assembles.
+func TestPeephole_Corpus(t *testing.T) {
+	srcs := map[string]string{"synthetic": chunkedProgram(8)}
+	golden, _ := filepath.Glob("golden/*.s")
+	for _, path := range golden {
+		data, err := os.ReadFile(path)
+		if err != nil {
+			t.Fatal(err)
+		}
+		srcs[strings.TrimSuffix(filepath.Base(path), ".s")] = string(data)
+	}
+	asm := ""
+	if root, err := findRepoRoot(); err == nil {
+		p := filepath.Join(root, "sdk", "bin", "ie64asm")
+		if _, err := os.Stat(p); err == nil {
+			asm = p
+		}
+	}
+	for name, src := range srcs {
+		t.Run(name, func(t *testing.T) {
+			c, out, errs := convertWith(t, src, 1, "", func(c *Converter) { c.peephole = true })
+			if errs > 0 {
+				t.Fatalf("conversion errors:\n%s", out)
+			}
+			st := c.peepholeStats
+			if st.After >= st.Before {
+				t.Fatalf("peephole did not shrink %s: %d -> %d", name, st.Before, st.After)
+			}
+			t.Logf("%s: %d -> %d instructions", name, st.Before, st.After)
+			if again, _ := PeepholeIE64(out); again != out {
+				t.Fatalf("peephole is not idempotent:\n%s\n--- second pass ---\n%s", out, again)
+			}
+			if asm == "" || strings.Contains(src, "ifd") {
+				return
+			}
+			tmp := t.TempDir()
+			ie64s := filepath.Join(tmp, name+".ie64.s")
+			if err := os.WriteFile(ie64s, []byte(out), 0o644); err != nil {
+				t.Fatal(err)
+			}
+			if combined, err := exec.Command(asm, ie64s, "-o", filepath.Join(tmp, name+".bin")).CombinedOutput(); err != nil {
+				t.Fatalf("ie64asm rejected peephole output:\n%s\n--- ie64asm ---\n%s", out, combined)
+			}
+		})
+	}
+}
@@ -549,7 +549,9 @@ func (c *Converter) ConvertFile(path string, opts PreprocOpts, stderrW io.Writer
 		fmt.Fprintf(stderrW, "error reading %s: %v\n", path, err)
 		return "", 1
 	}
+	done := c.timings.phase("preprocess")
 	pre, perrs := Preprocess(data, path, opts, stderrW)
+	done()
 	if perrs > 0 {
 		return "", perrs
 	}
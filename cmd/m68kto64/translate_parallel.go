@@ -0,0 +1,439 @@
+package main
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"runtime"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// =====================================================================
+// Chunked translation: per-function parallelism and result cache
+//
+// Both liveness passes reset to "all live" at every label, and neither
+// fuse pattern pairs across a labelled line, so a run of lines that starts
+// at a global label translates the same way no matter what surrounds it.
+// ConvertLines splits the lexed input at global labels into chunks and:
+//
+//   - runs the backward liveness passes per chunk on worker goroutines,
+//     entering every chunk but the last with live = true;
+//   - lowers each chunk on its own Emit from a shallow Converter clone.
+//     NewLabel and addFPConst hand out placeholders (chunkLabelMark /
+//     chunkConstMark delimited local indices) that the in-order merge
+//     rewrites into the exact numbering a single pass produces;
+//   - with -cache DIR, stores each chunk's lowered text under a SHA-256 of
+//     the options, the chunk's source lines and the per-line context it
+//     reads from outside the chunk (liveness bits, the fuse lookahead, and
+//     ifd/ifnd symbol presence).
+//
+// -fp-irq-wrap keeps the single in-order pass: handler entry stubs read
+// needsFP56Save/needsFP7Save while emission is still in progress.
+// =====================================================================
+
+const (
+	chunkLabelMark = '\x01' // brackets a chunk-local NewLabel sequence number
+	chunkConstMark = '\x02' // brackets a chunk-local FP constant index
+
+	// minChunkLines merges tiny functions into their successor so worker
+	// hand-off does not dominate.
+	minChunkLines = 32
+
+	chunkCacheVersion = 2
+)
+
+// translationChunk is a [start, end) range of lexed lines.
+type translationChunk struct {
+	start, end int
+}
+
+// phaseTimings collects wall-clock durations of the conversion phases for
+// -timings. A nil *phaseTimings records nothing.
+type phaseTimings struct {
+	names []string
+	durs  []time.Duration
+}
+
+// phase starts timing name and returns the function that stops it.
+func (t *phaseTimings) phase(name string) func() {
+	if t == nil {
+		return func() {}
+	}
+	start := time.Now()
+	return func() {
+		t.names = append(t.names, name)
+		t.durs = append(t.durs, time.Since(start))
+	}
+}
+
+// report writes one line per phase plus the total and chunk statistics.
+func (t *phaseTimings) report(w io.Writer, c *Converter) {
+	if t == nil {
+		return
+	}
+	var total time.Duration
+	for i, name := range t.names {
+		fmt.Fprintf(w, "m68kto64: %-10s %10.3fms\n", name, float64(t.durs[i].Microseconds())/1000)
+		total += t.durs[i]
+	}
+	fmt.Fprintf(w, "m68kto64: %-10s %10.3fms (%d worker(s), %d chunk(s), %d cached)\n",
+		"total", float64(total.Microseconds())/1000, c.workers(), c.chunkCount, c.cacheHits)
+	if c.peephole {
+		st := c.peepholeStats
+		fmt.Fprintf(w, "m68kto64: peephole   %d -> %d instructions\n", st.Before, st.After)
+	}
+}
+
+// workers returns the goroutine count for chunked phases; jobs <= 0 means
+// one per CPU.
+func (c *Converter) workers() int {
+	if c.jobs > 0 {
+		return c.jobs
+	}
+	return runtime.NumCPU()
+}
+
+// saltPrefix returns the "<salt>_" infix NewLabel puts after __m68kto64_.
+func saltPrefix(salt string) string {
+	if salt == "" {
+		return ""
+	}
+	return salt + "_"
+}
+
+// forEachIndex calls fn(0..n-1) on up to workers goroutines.
+func forEachIndex(n, workers int, fn func(int)) {
+	if workers > n {
+		workers = n
+	}
+	if workers <= 1 {
+		for i := 0; i < n; i++ {
+			fn(i)
+		}
+		return
+	}
+	var next atomic.Int64
+	var wg sync.WaitGroup
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				i := int(next.Add(1)) - 1
+				if i >= n {
+					return
+				}
+				fn(i)
+			}
+		}()
+	}
+	wg.Wait()
+}
+
+// lexLinesParallel lexes input, splitting the work into contiguous blocks.
+func lexLinesParallel(input []string, workers int) []Line {
+	lines := make([]Line, len(input))
+	const block = 1024
+	forEachIndex((len(input)+block-1)/block, workers, func(b int) {
+		end := min((b+1)*block, len(input))
+		for i := b * block; i < end; i++ {
+			lines[i] = LexLine(input[i])
+		}
+	})
+	return lines
+}
+
+// splitTranslationChunks cuts lines before every global (non-".") label,
+// folding chunks shorter than minChunkLines into the next one.
+func splitTranslationChunks(lines []Line) []translationChunk {
+	var chunks []translationChunk
+	start := 0
+	for i := 1; i < len(lines); i++ {
+		l := lines[i]
+		if l.Label == "" || strings.HasPrefix(l.Label, ".") || i-start < minChunkLines {
+			continue
+		}
+		chunks = append(chunks, translationChunk{start, i})
+		start = i
+	}
+	if start < len(lines) {
+		chunks = append(chunks, translationChunk{start, len(lines)})
+	}
+	return chunks
+}
+
+// computeChunkedLiveness is computeFPCCLiveness plus (when flagLiveness is
+// set) computeIntegerCCLiveness, run per chunk. The integer map is nil when
+// flagLiveness is off.
+func computeChunkedLiveness(lines []Line, chunks []translationChunk, flagLiveness bool, workers int) (fpcc, intCC map[int]bool) {
+	fpParts := make([]map[int]bool, len(chunks))
+	intParts := make([]map[int]bool, len(chunks))
+	forEachIndex(len(chunks), workers, func(k int) {
+		ch := chunks[k]
+		liveAfter := k != len(chunks)-1
+		fpParts[k] = map[int]bool{}
+		ccLivenessRange(lines, ch.start, ch.end, liveAfter, isFPCCConsumer, isFPCCProducer, fpParts[k])
+		if flagLiveness {
+			intParts[k] = map[int]bool{}
+			ccLivenessRange(lines, ch.start, ch.end, liveAfter, isIntegerCCConsumer, isIntegerCCProducer, intParts[k])
+		}
+	})
+	fpcc = mergeLiveness(fpParts)
+	if flagLiveness {
+		intCC = mergeLiveness(intParts)
+	}
+	return fpcc, intCC
+}
+
+func mergeLiveness(parts []map[int]bool) map[int]bool {
+	n := 0
+	for _, p := range parts {
+		n += len(p)
+	}
+	out := make(map[int]bool, n)
+	for _, p := range parts {
+		for i, live := range p {
+			out[i] = live
+		}
+	}
+	return out
+}
+
+// addChunkFPConst is addFPConst on a chunk worker: constants are numbered
+// within the chunk and the returned label is a placeholder.
+func (c *Converter) addChunkFPConst(d string, comment string) string {
+	idx := -1
+	for i, ent := range *c.chunkConsts {
+		if ent.DCD == d {
+			idx = i
+			break
+		}
+	}
+	if idx < 0 {
+		idx = len(*c.chunkConsts)
+		*c.chunkConsts = append(*c.chunkConsts, fpConstEntry{DCD: d, Comment: comment})
+	}
+	return fmt.Sprintf("%c%d%c", chunkConstMark, idx, chunkConstMark)
+}
+
+// chunkResult is one chunk's lowering with placeholders unresolved. It is
+// also the on-disk cache record.
+type chunkResult struct {
+	Text            string
+	Labels          int
+	Errors          int
+	FPUsed          bool
+	UsesFPConstPool bool
+	NeedsFP56Save   bool
+	NeedsFP7Save    bool
+	Consts          []fpConstEntry
+}
+
+// emitChunks lowers every chunk, in parallel and through the cache when
+// one is configured, then merges the results into e in source order.
+func (c *Converter) emitChunks(e *Emit, input []string, lines []Line, chunks []translationChunk) {
+	results := make([]chunkResult, len(chunks))
+	var hits atomic.Int64
+	forEachIndex(len(chunks), c.workers(), func(k int) {
+		ch := chunks[k]
+		var key string
+		if c.cacheDir != "" {
+			key = c.chunkCacheKey(input, lines, ch)
+			if r, ok := c.loadChunk(key); ok {
+				results[k] = r
+				hits.Add(1)
+				return
+			}
+		}
+		results[k] = c.lowerChunk(lines, ch)
+		if c.cacheDir != "" {
+			c.storeChunk(key, results[k])
+		}
+	})
+	c.chunkCount = len(chunks)
+	c.cacheHits = int(hits.Load())
+
+	for _, r := range results {
+		consts := make([]string, len(r.Consts))
+		for j, ent := range r.Consts {
+			consts[j] = c.addFPConst(ent.DCD, ent.Comment)
+		}
+		e.sb.WriteString(resolveChunkText(r.Text, e.labelSeq, consts))
+		e.labelSeq += r.Labels
+		c.errors += r.Errors
+		c.fpUsed = c.fpUsed || r.FPUsed
+		c.usesFPConstPool = c.usesFPConstPool || r.UsesFPConstPool
+		c.needsFP56Save = c.needsFP56Save || r.NeedsFP56Save
+		c.needsFP7Save = c.needsFP7Save || r.NeedsFP7Save
+	}
+}
+
+// lowerChunk runs emitRange over one chunk on a clone of c whose emission
+// state starts empty.
+func (c *Converter) lowerChunk(lines []Line, ch translationChunk) chunkResult {
+	var consts []fpConstEntry
+	w := *c
+	w.errors = 0
+	w.fpUsed, w.usesFPConstPool, w.needsFP56Save, w.needsFP7Save = false, false, false, false
+	w.fpConsts = nil
+	w.chunkConsts = &consts
+	e := &Emit{labelSalt: c.labelSalt, deferLabels: true}
+	w.emitRange(e, lines, ch.start, ch.end)
+	return chunkResult{
+		Text:            e.String(),
+		Labels:          e.labelSeq,
+		Errors:          w.errors,
+		FPUsed:          w.fpUsed,
+		UsesFPConstPool: w.usesFPConstPool,
+		NeedsFP56Save:   w.needsFP56Save,
+		NeedsFP7Save:    w.needsFP7Save,
+		Consts:          consts,
+	}
+}
+
+// resolveChunkText replaces label placeholders with labelBase+n and constant
+// placeholders with their pool labels.
+func resolveChunkText(text string, labelBase int, consts []string) string {
+	if !strings.ContainsAny(text, string([]byte{chunkLabelMark, chunkConstMark})) {
+		return text
+	}
+	var sb strings.Builder
+	sb.Grow(len(text) + len(text)/8)
+	for {
+		i := strings.IndexAny(text, string([]byte{chunkLabelMark, chunkConstMark}))
+		if i < 0 {
+			sb.WriteString(text)
+			return sb.String()
+		}
+		mark := text[i]
+		sb.WriteString(text[:i])
+		text = text[i+1:]
+		j := strings.IndexByte(text, mark)
+		n, _ := strconv.Atoi(text[:j])
+		if mark == chunkLabelMark {
+			sb.WriteString(strconv.Itoa(labelBase + n))
+		} else {
+			sb.WriteString(consts[n])
+		}
+		text = text[j+1:]
+	}
+}
+
+// chunkCacheKey hashes everything the lowering of ch depends on.
+func (c *Converter) chunkCacheKey(input []string, lines []Line, ch translationChunk) string {
+	h := sha256.New()
+	fmt.Fprintf(h, "m68kto64 chunk v%d\x00%s\x00%t\x00%t\x00%t\x00%s\x00%t\x00",
+		chunkCacheVersion, c.defaultSize, c.strict, c.noFlagsFuse, c.werrorUnknownMnem, c.labelSalt, c.flagLiveness)
+	for _, r := range c.mmioRanges {
+		fmt.Fprintf(h, "mmio %x-%x\x00", r.start, r.end)
+	}
+	jsr := make([]string, 0, len(c.directJSR))
+	for from, to := range c.directJSR {
+		jsr = append(jsr, from+"="+to)
+	}
+	sort.Strings(jsr)
+	for _, r := range jsr {
+		fmt.Fprintf(h, "jsr %s\x00", r)
+	}
+	if ch.start > 0 && lines[ch.start-1].Kind == LineLabelOnly {
+		h.Write([]byte("after-label\x00"))
+	}
+	ctx := make([]byte, 0, ch.end-ch.start)
+	for i := ch.start; i < ch.end; i++ {
+		h.Write([]byte(input[i]))
+		h.Write([]byte{'\n'})
+		l := lines[i]
+		var b byte
+		if c.fpccLiveAt[i] {
+			b |= 1
+		}
+		if c.intCCLiveAt[i] {
+			b |= 2
+		}
+		if fusableProducer(l) && laterIntegerCCConsumerBeforeProducer(lines, i+2) {
+			b |= 4
+		}
+		if l.Kind == LineDirective && (l.Mnemonic == "ifd" || l.Mnemonic == "ifnd") && len(l.Operands) == 1 &&
+			c.symtab != nil && c.symtab.Has(strings.TrimSpace(l.Operands[0])) {
+			b |= 8
+		}
+		ctx = append(ctx, b)
+	}
+	h.Write(ctx)
+	// Directive lowering evaluates equates that may be bound in other
+	// chunks (dcb/ds/blk counts), so their values are part of the key.
+	for _, ref := range c.chunkSymbolRefs(input[ch.start:ch.end]) {
+		fmt.Fprintf(h, "sym %s\x00", ref)
+	}
+	return hex.EncodeToString(h.Sum(nil))
+}
+
+// chunkSymbolRefs returns "name=value" for every symtab binding named in
+// src, sorted. Identifiers that are not symbols (mnemonics, registers, hex
+// digits after '$') are skipped by the lookup.
+func (c *Converter) chunkSymbolRefs(src []string) []string {
+	if c.symtab == nil {
+		return nil
+	}
+	seen := map[string]bool{}
+	var refs []string
+	for _, line := range src {
+		for i := 0; i < len(line); {
+			if !isIdentStart(line[i]) {
+				i++
+				continue
+			}
+			j := i + 1
+			for j < len(line) && isIdentCont(line[j]) {
+				j++
+			}
+			name := line[i:j]
+			i = j
+			if seen[name] {
+				continue
+			}
+			seen[name] = true
+			if v, ok := c.symtab.Get(name); ok {
+				refs = append(refs, fmt.Sprintf("%s=%d", name, v))
+			}
+		}
+	}
+	sort.Strings(refs)
+	return refs
+}
+
+func (c *Converter) loadChunk(key string) (chunkResult, bool) {
+	var r chunkResult
+	data, err := os.ReadFile(filepath.Join(c.cacheDir, key))
+	if err != nil || json.Unmarshal(data, &r) != nil {
+		return chunkResult{}, false
+	}
+	return r, true
+}
+
+// storeChunk writes a cache record atomically. Failures only cost a later
+// cache miss.
+func (c *Converter) storeChunk(key string, r chunkResult) {
+	data, err := json.Marshal(r)
+	if err != nil || os.MkdirAll(c.cacheDir, 0o755) != nil {
+		return
+	}
+	tmp, err := os.CreateTemp(c.cacheDir, key+".tmp*")
+	if err != nil {
+		return
+	}
+	_, werr := tmp.Write(data)
+	cerr := tmp.Close()
+	if werr != nil || cerr != nil || os.Rename(tmp.Name(), filepath.Join(c.cacheDir, key)) != nil {
+		os.Remove(tmp.Name())
+	}
+}
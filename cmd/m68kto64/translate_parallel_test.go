@@ -0,0 +1,189 @@
+package main
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+// chunkedProgram builds a source with many functions exercising the state
+// chunk merging must reproduce: NewLabel sequences, FP constants shared
+// across functions, fusable and unfusable CMP/Bcc pairs, ifd and FPCC.
+func chunkedProgram(funcs int) string {
+	var sb strings.Builder
+	sb.WriteString("\tmove.l #1,d0\n")
+	for f := 0; f < funcs; f++ {
+		fmt.Fprintf(&sb, "func%d:\n", f)
+		fmt.Fprintf(&sb, "\tmoveq #%d,d1\n", f&63)
+		sb.WriteString(".loop:\n")
+		sb.WriteString("\tadd.l d1,d0\n\tsubq.l #1,d1\n\tcmp.l #0,d1\n\tbne .loop\n")
+		sb.WriteString("\ttst.l d0\n\tbeq .zero\n\tbmi .zero\n")
+		fmt.Fprintf(&sb, "\tfmovecr fp%d,#$%02x\n", f%4, []int{0x0b, 0x0c, 0x33, 0x0f}[f%4])
+		sb.WriteString("\tfcmp.x fp0,fp1\n\tfbgt .zero\n")
+		sb.WriteString("\tifd IS_IE\n\tmove.l d0,(a0)+\n\tendif\n")
+		sb.WriteString("\tdbra d1,.loop\n")
+		sb.WriteString(".zero:\n\tscc d2\n\tcmp.l d0,d1\n")
+		if f == funcs-1 {
+			sb.WriteString("\trts\n")
+		}
+	}
+	return sb.String()
+}
+
+func convertWith(t testing.TB, src string, jobs int, cacheDir string, setup func(*Converter)) (*Converter, string, int) {
+	t.Helper()
+	c := NewConverter()
+	c.jobs = jobs
+	c.cacheDir = cacheDir
+	if setup != nil {
+		setup(c)
+	}
+	out, errs := c.ConvertSource(src)
+	return c, out, errs
+}
+
+// TestChunkedTranslation_MatchesSinglePass asserts that chunked, parallel
+// emission is byte-identical to the single in-order pass.
+func TestChunkedTranslation_MatchesSinglePass(t *testing.T) {
+	srcs := map[string]string{"synthetic": chunkedProgram(40)}
+	golden, _ := filepath.Glob("golden/*.s")
+	for _, path := range golden {
+		data, err := os.ReadFile(path)
+		if err != nil {
+			t.Fatal(err)
+		}
+		srcs[strings.TrimSuffix(filepath.Base(path), ".s")] = string(data)
+	}
+	variants := map[string]func(*Converter){
+		"default":  nil,
+		"salted":   func(c *Converter) { c.labelSalt = "tu1" },
+		"liveness": func(c *Converter) { c.flagLiveness = true },
+		"nofuse":   func(c *Converter) { c.noFlagsFuse = true },
+	}
+	for name, src := range srcs {
+		for vname, setup := range variants {
+			t.Run(name+"/"+vname, func(t *testing.T) {
+				_, want, wantErrs := convertWith(t, src, 1, "", setup)
+				c, got, gotErrs := convertWith(t, src, 4, "", setup)
+				if got != want || gotErrs != wantErrs {
+					t.Fatalf("chunked output differs (errors %d vs %d)\n--- single pass ---\n%s\n--- chunked ---\n%s",
+						wantErrs, gotErrs, want, got)
+				}
+				if strings.ContainsAny(got, "\x01\x02") {
+					t.Fatalf("unresolved chunk placeholder in output:\n%s", got)
+				}
+				if name == "synthetic" && c.chunkCount < 2 {
+					t.Fatalf("chunkCount = %d, want the program split", c.chunkCount)
+				}
+			})
+		}
+	}
+}
+
+func TestChunkedLiveness_MatchesWholeProgram(t *testing.T) {
+	lines := lexLinesParallel(strings.Split(chunkedProgram(20), "\n"), 4)
+	chunks := splitTranslationChunks(lines)
+	fpcc, intCC := computeChunkedLiveness(lines, chunks, true, 4)
+	wantFP, wantInt := computeFPCCLiveness(lines), computeIntegerCCLiveness(lines)
+	if len(fpcc) != len(wantFP) || len(intCC) != len(wantInt) {
+		t.Fatalf("map sizes differ: fpcc %d/%d intCC %d/%d", len(fpcc), len(wantFP), len(intCC), len(wantInt))
+	}
+	for i, live := range wantFP {
+		if fpcc[i] != live {
+			t.Errorf("fpcc line %d: got %v want %v", i, fpcc[i], live)
+		}
+	}
+	for i, live := range wantInt {
+		if intCC[i] != live {
+			t.Errorf("intCC line %d: got %v want %v", i, intCC[i], live)
+		}
+	}
+	if _, intCC = computeChunkedLiveness(lines, chunks, false, 4); intCC != nil {
+		t.Fatalf("intCC should be nil with flag liveness off")
+	}
+}
+
+// TestChunkCache_RoundTrip asserts cached chunks reproduce the uncached
+// output, and that an edit to one function only misses that function.
+func TestChunkCache_RoundTrip(t *testing.T) {
+	dir := t.TempDir()
+	src := chunkedProgram(40)
+	_, want, _ := convertWith(t, src, 1, "", nil)
+
+	c, cold, _ := convertWith(t, src, 4, dir, nil)
+	if cold != want || c.cacheHits != 0 {
+		t.Fatalf("cold run: hits=%d, output matches=%v", c.cacheHits, cold == want)
+	}
+	c, warm, _ := convertWith(t, src, 4, dir, nil)
+	if warm != want || c.cacheHits != c.chunkCount {
+		t.Fatalf("warm run: hits=%d of %d, output matches=%v", c.cacheHits, c.chunkCount, warm == want)
+	}
+
+	edited := strings.Replace(src, "func20:\n\tmoveq #20,d1", "func20:\n\tmoveq #21,d1", 1)
+	_, wantEdited, _ := convertWith(t, edited, 1, "", nil)
+	c, got, _ := convertWith(t, edited, 4, dir, nil)
+	if got != wantEdited {
+		t.Fatalf("edited output differs from uncached translation")
+	}
+	if c.cacheHits != c.chunkCount-1 {
+		t.Fatalf("edited run: hits=%d of %d, want all but one", c.cacheHits, c.chunkCount)
+	}
+
+	// Options are part of the key.
+	c, _, _ = convertWith(t, src, 4, dir, func(c *Converter) { c.labelSalt = "other" })
+	if c.cacheHits != 0 {
+		t.Fatalf("salted run reused %d unsalted chunks", c.cacheHits)
+	}
+}
+
+// TestChunkCache_KeyTracksEquates asserts a chunk whose lowering reads an
+// equate bound in another chunk misses the cache when that value changes.
+func TestChunkCache_KeyTracksEquates(t *testing.T) {
+	dir := t.TempDir()
+	src := filepath.Join(dir, "prog.s")
+	convert := func(count, jobs int, cacheDir string) (*Converter, string) {
+		t.Helper()
+		prog := fmt.Sprintf("COUNT equ %d\n", count) + chunkedProgram(40) + "table:\n\tdcb.b COUNT,$FF\n"
+		if err := os.WriteFile(src, []byte(prog), 0o644); err != nil {
+			t.Fatal(err)
+		}
+		c := NewConverter()
+		c.jobs = jobs
+		c.cacheDir = cacheDir
+		var stderr strings.Builder
+		out, errs := c.ConvertFile(src, DefaultPreprocOpts(), &stderr)
+		if errs != 0 {
+			t.Fatalf("ConvertFile: %d errors\n%s", errs, stderr.String())
+		}
+		return c, out
+	}
+	cache := filepath.Join(dir, "cache")
+	convert(4, 4, cache)
+	_, want := convert(8, 1, "")
+	c, got := convert(8, 4, cache)
+	if got != want {
+		t.Fatalf("cached output after changing COUNT differs from uncached translation")
+	}
+	if c.cacheHits == 0 || c.cacheHits == c.chunkCount {
+		t.Fatalf("hits=%d of %d, want only the chunks naming COUNT to miss", c.cacheHits, c.chunkCount)
+	}
+}
+
+func TestRun_TimingsReport(t *testing.T) {
+	dir := t.TempDir()
+	in := filepath.Join(dir, "prog.s")
+	if err := os.WriteFile(in, []byte(chunkedProgram(4)), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	var stderr strings.Builder
+	if code := run([]string{"-timings", "-j", "2", "-cache", filepath.Join(dir, "cache"), in}, &stderr); code != 0 {
+		t.Fatalf("run = %d: %s", code, stderr.String())
+	}
+	for _, phase := range []string{"preprocess", "lex", "liveness", "emit", "write", "total"} {
+		if !strings.Contains(stderr.String(), "m68kto64: "+phase) {
+			t.Errorf("timings report missing %q:\n%s", phase, stderr.String())
+		}
+	}
+}
@@ -33,6 +33,9 @@ var (
 func TestMain(m *testing.M) {
 	var err error
 
+	// Keep tests out of the user's asset cache; cache tests use their own store.
+	assetCacheDir = "off"
+
 	// Initialize sound
 	chip, err = NewSoundChip(AUDIO_BACKEND_OTO)
 	if err != nil {
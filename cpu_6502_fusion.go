@@ -0,0 +1,426 @@
+// cpu_6502_fusion.go - Table-driven 6502 idiom fusion: matcher and
+// interpreter fast paths.
+//
+// The idiom table lives in internal/interp6502meta (Idioms); go generate
+// turns it into cpu_6502_fusion_generated.go (IDs, step patterns, a
+// first-opcode index and the execFusion6502 dispatch) and
+// jit_6502_fusion_generated.go (the JIT template dispatch). Adding an
+// idiom means a table row, a fused<Name> method here and, optionally, an
+// emit6502Fused<Template> in jit_6502_fusion_match.go.
+//
+// Interpreter fast path: stepFused retires a whole idiom in one
+// dispatch against a host's plain RAM, skipping the per-instruction
+// Step overhead (interrupt polling, bus interface calls, opcode table
+// dispatch). It is observably identical to stepping: fusers decline
+// before touching state when any operand lands on an I/O page, the host
+// is told each instruction's cycles separately, and the caller bounds
+// the idiom's worst-case cycles so no interrupt or frame boundary can
+// fall inside it.
+
+package main
+
+// fusion6502Operand constrains the first operand byte of a step.
+type fusion6502Operand uint8
+
+const (
+	fusion6502OperandAny fusion6502Operand = iota
+	fusion6502OperandEqual
+	fusion6502OperandSameAs
+	fusion6502OperandNextOf
+)
+
+type fusion6502Step struct {
+	offset  uint8 // byte offset of the opcode from the idiom start
+	opcode  byte
+	operand fusion6502Operand
+	value   byte  // fusion6502OperandEqual
+	ref     uint8 // fusion6502OperandSameAs / NextOf: earlier step index
+}
+
+type fusion6502Pattern struct {
+	name      string
+	length    uint8 // idiom length in bytes
+	jit       bool  // has a JIT emit template
+	maxCycles uint8 // worst case, page crossings and taken branches included
+	steps     []fusion6502Step
+}
+
+// accepts reports whether operand satisfies the step's constraint given
+// the first operand bytes of the earlier steps.
+func (s *fusion6502Step) accepts(operand byte, prev []byte) bool {
+	switch s.operand {
+	case fusion6502OperandEqual:
+		return operand == s.value
+	case fusion6502OperandSameAs:
+		return operand == prev[s.ref]
+	case fusion6502OperandNextOf:
+		return prev[s.ref] != 0xFF && operand == prev[s.ref]+1
+	}
+	return true
+}
+
+// match reports whether the idiom's bytes are at mem[pc:].
+func (p *fusion6502Pattern) match(mem *[0x10000]byte, pc uint16) bool {
+	var operands [fusion6502MaxInstrs]byte
+	for i := range p.steps {
+		s := &p.steps[i]
+		at := pc + uint16(s.offset)
+		if mem[at] != s.opcode {
+			return false
+		}
+		operand := mem[at+1]
+		if !s.accepts(operand, operands[:i]) {
+			return false
+		}
+		operands[i] = operand
+	}
+	return true
+}
+
+func init() {
+	for id := range fusion6502Patterns {
+		p := &fusion6502Patterns[id]
+		var cycles int
+		for _, s := range p.steps {
+			cycles += int(jit6502BaseCycles[s.opcode])
+			switch {
+			case s.opcode&0x1F == 0x10: // branch: +1 taken, +1 page cross
+				cycles += 2
+			case s.opcode&0x1F == 0x11 || s.opcode&0x1F == 0x19 || s.opcode&0x1C == 0x1C: // indexed page cross
+				cycles++
+			}
+		}
+		p.maxCycles = uint8(cycles)
+	}
+}
+
+// matchFusion6502 returns the longest idiom at mem[pc:], or FusionNone.
+func matchFusion6502(mem *[0x10000]byte, pc uint16) FusionID {
+	for _, id := range fusion6502ByOpcode[mem[pc]] {
+		if fusion6502Patterns[id].match(mem, pc) {
+			return id
+		}
+	}
+	return FusionNone
+}
+
+// fusion6502Host is implemented by buses whose RAM fused idioms may read
+// and write directly.
+type fusion6502Host interface {
+	// fusionRAM returns the 64KB RAM image and the pages that must go
+	// through Read/Write instead.
+	fusionRAM() (ram *[0x10000]byte, io *[256]bool)
+	// fusionHorizon returns how many more cycles may elapse before the
+	// bus could raise an interrupt.
+	fusionHorizon() int
+}
+
+// stepFused retires the idiom at PC in one dispatch. It returns the
+// number of instructions retired, with their cycles in fusedCycles[:n]
+// (Cycles already includes them), or 0 when the caller must Step
+// instead. The idiom only runs when its worst-case cycles fit within
+// limit and the host's interrupt horizon.
+func (cpu_6502 *CPU_6502) stepFused(host fusion6502Host, limit int) int {
+	ram, io := host.fusionRAM()
+	pc := cpu_6502.PC
+	if io[pc>>8] || pc < 0x100 {
+		return 0
+	}
+	cands := fusion6502ByOpcode[ram[pc]]
+	if len(cands) == 0 {
+		return 0
+	}
+	if cpu_6502.Debug || cpu_6502.debugBreakIn != nil || cpu_6502.fastAdapter != nil ||
+		!cpu_6502.running.Load() || cpu_6502.resetting.Load() || !cpu_6502.rdyLine.Load() ||
+		cpu_6502.nmiPending.Load() || (cpu_6502.irqPending.Load() && cpu_6502.SR&INTERRUPT_FLAG == 0) {
+		return 0
+	}
+	for _, id := range cands {
+		p := &fusion6502Patterns[id]
+		if !p.match(ram, pc) {
+			continue
+		}
+		end := pc + uint16(p.length) - 1
+		if end < pc || io[end>>8] || int(p.maxCycles) > limit || int(p.maxCycles) > host.fusionHorizon() {
+			return 0
+		}
+		n := cpu_6502.execFusion6502(id, ram, io, pc)
+		for _, c := range cpu_6502.fusedCycles[:n] {
+			cpu_6502.Cycles += uint64(c)
+		}
+		return n
+	}
+	return 0
+}
+
+// fusedBranchCycles mirrors branch(): +1 when taken, +1 more when the
+// target is on another page than the next instruction.
+func fusedBranchCycles(taken bool, next, target uint16) uint8 {
+	if !taken {
+		return 0
+	}
+	if next&0xFF00 != target&0xFF00 {
+		return 2
+	}
+	return 1
+}
+
+// fusedAbsIndexed returns base+index and the page-cross penalty.
+func fusedAbsIndexed(ram *[0x10000]byte, at uint16, index byte) (uint16, uint8) {
+	base := uint16(ram[at]) | uint16(ram[at+1])<<8
+	addr := base + uint16(index)
+	if base&0xFF00 != addr&0xFF00 {
+		return addr, 1
+	}
+	return addr, 0
+}
+
+// fuse6502DexBne executes one (DEX; BNE rel) iteration and returns the
+// new X, SR and PC. rel is the signed displacement at pc+2.
+func fuse6502DexBne(x byte, sr byte, pc uint16, rel int8) (newX byte, newSR byte, newPC uint16) {
+	newX = x - 1
+	newSR = sr & ^byte(0x82) // clear N, Z
+	if newX == 0 {
+		newSR |= 0x02 // Z
+	}
+	if newX&0x80 != 0 {
+		newSR |= 0x80 // N
+	}
+	// DEX (1B) + BNE rel (2B) = 3B idiom; resume PC is pc+3, and the
+	// taken target is computed relative to the post-idiom PC per the
+	// 6502 branch encoding.
+	if newX != 0 {
+		newPC = uint16(int32(pc) + 3 + int32(rel))
+	} else {
+		newPC = pc + 3
+	}
+	return
+}
+
+// fuse6502DeyBne is the DEY; BNE analog.
+func fuse6502DeyBne(y byte, sr byte, pc uint16, rel int8) (newY byte, newSR byte, newPC uint16) {
+	newY = y - 1
+	newSR = sr & ^byte(0x82)
+	if newY == 0 {
+		newSR |= 0x02
+	}
+	if newY&0x80 != 0 {
+		newSR |= 0x80
+	}
+	if newY != 0 {
+		newPC = uint16(int32(pc) + 3 + int32(rel))
+	} else {
+		newPC = pc + 3
+	}
+	return
+}
+
+// fuse6502InxBne is the INX; BNE analog. INY; BNE reuses it.
+func fuse6502InxBne(x byte, sr byte, pc uint16, rel int8) (newX byte, newSR byte, newPC uint16) {
+	newX = x + 1
+	newSR = sr & ^byte(0x82)
+	if newX == 0 {
+		newSR |= 0x02
+	}
+	if newX&0x80 != 0 {
+		newSR |= 0x80
+	}
+	if newX != 0 {
+		newPC = uint16(int32(pc) + 3 + int32(rel))
+	} else {
+		newPC = pc + 3
+	}
+	return
+}
+
+// fuse6502LdaImmStaZp executes (LDA #imm; STA $zp). Writes the immediate
+// to zero-page memory[zp] and returns updated A + SR. Caller advances PC
+// by 4 bytes.
+func fuse6502LdaImmStaZp(memory []byte, sr byte, imm byte, zp byte) (newA byte, newSR byte) {
+	newA = imm
+	memory[zp] = imm
+	newSR = sr & ^byte(0x82)
+	if newA == 0 {
+		newSR |= 0x02
+	}
+	if newA&0x80 != 0 {
+		newSR |= 0x80
+	}
+	return
+}
+
+// ---------------------------------------------------------------------------
+// Interpreter fast paths, one per idiom, dispatched by execFusion6502.
+// Each returns the instruction count and fills fusedCycles, or returns
+// 0 without side effects.
+// ---------------------------------------------------------------------------
+
+func (cpu_6502 *CPU_6502) fusedDexBne(ram *[0x10000]byte, _ *[256]bool, pc uint16) int {
+	cpu_6502.X, cpu_6502.SR, cpu_6502.PC = fuse6502DexBne(cpu_6502.X, cpu_6502.SR, pc, int8(ram[pc+2]))
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = fusedBranchCycles(cpu_6502.X != 0, pc+3, cpu_6502.PC)
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedDeyBne(ram *[0x10000]byte, _ *[256]bool, pc uint16) int {
+	cpu_6502.Y, cpu_6502.SR, cpu_6502.PC = fuse6502DeyBne(cpu_6502.Y, cpu_6502.SR, pc, int8(ram[pc+2]))
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = fusedBranchCycles(cpu_6502.Y != 0, pc+3, cpu_6502.PC)
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedInxBne(ram *[0x10000]byte, _ *[256]bool, pc uint16) int {
+	cpu_6502.X, cpu_6502.SR, cpu_6502.PC = fuse6502InxBne(cpu_6502.X, cpu_6502.SR, pc, int8(ram[pc+2]))
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = fusedBranchCycles(cpu_6502.X != 0, pc+3, cpu_6502.PC)
+	return 2
+}
+
+// fusedInyBne reuses the INX; BNE fuser: both just increment.
+func (cpu_6502 *CPU_6502) fusedInyBne(ram *[0x10000]byte, _ *[256]bool, pc uint16) int {
+	cpu_6502.Y, cpu_6502.SR, cpu_6502.PC = fuse6502InxBne(cpu_6502.Y, cpu_6502.SR, pc, int8(ram[pc+2]))
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = fusedBranchCycles(cpu_6502.Y != 0, pc+3, cpu_6502.PC)
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedLdaImmStaZp(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	if io[0] {
+		return 0
+	}
+	cpu_6502.A, cpu_6502.SR = fuse6502LdaImmStaZp(ram[:], cpu_6502.SR, ram[pc+1], ram[pc+3])
+	cpu_6502.PC = pc + 4
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = 3
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedClcAdcImm(ram *[0x10000]byte, _ *[256]bool, pc uint16) int {
+	cpu_6502.SR &^= CARRY_FLAG
+	cpu_6502.adc(ram[pc+2])
+	cpu_6502.PC = pc + 3
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = 2
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedClcAdcZp(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	if io[0] {
+		return 0
+	}
+	cpu_6502.SR &^= CARRY_FLAG
+	cpu_6502.adc(ram[ram[pc+2]])
+	cpu_6502.PC = pc + 3
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = 3
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedSecSbcImm(ram *[0x10000]byte, _ *[256]bool, pc uint16) int {
+	cpu_6502.SR |= CARRY_FLAG
+	cpu_6502.sbc(ram[pc+2])
+	cpu_6502.PC = pc + 3
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = 2
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedSecSbcZp(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	if io[0] {
+		return 0
+	}
+	cpu_6502.SR |= CARRY_FLAG
+	cpu_6502.sbc(ram[ram[pc+2]])
+	cpu_6502.PC = pc + 3
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = 3
+	return 2
+}
+
+// fusedInc16Zp bumps a zero-page pointer: the high byte is only touched
+// when the low byte wraps, exactly as the BNE skips it.
+func (cpu_6502 *CPU_6502) fusedInc16Zp(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	if io[0] {
+		return 0
+	}
+	zp := uint16(ram[pc+1])
+	ram[zp]++
+	cpu_6502.updateNZ(ram[zp])
+	cpu_6502.fusedCycles[0] = 5
+	if ram[zp] != 0 {
+		cpu_6502.PC = pc + 6
+		cpu_6502.fusedCycles[1] = fusedBranchCycles(true, pc+4, pc+6)
+		return 2
+	}
+	ram[zp+1]++
+	cpu_6502.updateNZ(ram[zp+1])
+	cpu_6502.PC = pc + 6
+	cpu_6502.fusedCycles[1] = 0
+	cpu_6502.fusedCycles[2] = 5
+	return 3
+}
+
+// fusedAdd16Zp adds a 16-bit immediate to a zero-page word. A, flags and
+// memory end as after the seven-instruction sequence; the low-byte ADC's
+// carry feeds the high-byte ADC, decimal mode included.
+func (cpu_6502 *CPU_6502) fusedAdd16Zp(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	if io[0] {
+		return 0
+	}
+	zp := uint16(ram[pc+2])
+	cpu_6502.SR &^= CARRY_FLAG
+	cpu_6502.A = ram[zp]
+	cpu_6502.adc(ram[pc+4])
+	ram[zp] = cpu_6502.A
+	cpu_6502.A = ram[zp+1]
+	cpu_6502.adc(ram[pc+10])
+	ram[zp+1] = cpu_6502.A
+	cpu_6502.PC = pc + 13
+	cpu_6502.fusedCycles = [fusion6502MaxInstrs]uint8{2, 3, 2, 3, 3, 2, 3}
+	return 7
+}
+
+func (cpu_6502 *CPU_6502) fusedCopy(ram *[0x10000]byte, io *[256]bool, pc uint16, index byte) int {
+	src, cross := fusedAbsIndexed(ram, pc+1, index)
+	dst, _ := fusedAbsIndexed(ram, pc+4, index)
+	if io[src>>8] || io[dst>>8] {
+		return 0
+	}
+	cpu_6502.A = ram[src]
+	cpu_6502.updateNZ(cpu_6502.A)
+	ram[dst] = cpu_6502.A
+	cpu_6502.PC = pc + 6
+	cpu_6502.fusedCycles[0] = 4 + cross
+	cpu_6502.fusedCycles[1] = 5
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedCopyAbsX(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	return cpu_6502.fusedCopy(ram, io, pc, cpu_6502.X)
+}
+
+func (cpu_6502 *CPU_6502) fusedCopyAbsY(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	return cpu_6502.fusedCopy(ram, io, pc, cpu_6502.Y)
+}
+
+func (cpu_6502 *CPU_6502) fusedLookup(ram *[0x10000]byte, io *[256]bool, pc uint16, index *byte) int {
+	addr, cross := fusedAbsIndexed(ram, pc+2, cpu_6502.A)
+	if io[addr>>8] {
+		return 0
+	}
+	*index = cpu_6502.A
+	cpu_6502.A = ram[addr]
+	cpu_6502.updateNZ(cpu_6502.A)
+	cpu_6502.PC = pc + 4
+	cpu_6502.fusedCycles[0] = 2
+	cpu_6502.fusedCycles[1] = 4 + cross
+	return 2
+}
+
+func (cpu_6502 *CPU_6502) fusedLookupAbsX(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	return cpu_6502.fusedLookup(ram, io, pc, &cpu_6502.X)
+}
+
+func (cpu_6502 *CPU_6502) fusedLookupAbsY(ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	return cpu_6502.fusedLookup(ram, io, pc, &cpu_6502.Y)
+}
@@ -0,0 +1,151 @@
+// Code generated by cmd/gen_interp6502; DO NOT EDIT.
+package main
+
+// FusionID enumerates the fused 6502 idioms of interp6502meta.Idioms.
+type FusionID int
+
+const (
+	FusionNone        FusionID = iota
+	FusionDexBne               // DEX; BNE rel
+	FusionDeyBne               // DEY; BNE rel
+	FusionInxBne               // INX; BNE rel
+	FusionLdaImmStaZp          // LDA #imm; STA zp
+	FusionInyBne               // INY; BNE rel
+	FusionClcAdcImm            // CLC; ADC #imm
+	FusionClcAdcZp             // CLC; ADC zp
+	FusionSecSbcImm            // SEC; SBC #imm
+	FusionSecSbcZp             // SEC; SBC zp
+	FusionInc16Zp              // INC zp; BNE *+4; INC zp+1
+	FusionAdd16Zp              // CLC; LDA zp; ADC #lo; STA zp; LDA zp+1; ADC #hi; STA zp+1
+	FusionCopyAbsX             // LDA abs,X; STA abs,X
+	FusionCopyAbsY             // LDA abs,Y; STA abs,Y
+	FusionLookupAbsX           // TAX; LDA abs,X
+	FusionLookupAbsY           // TAY; LDA abs,Y
+	fusion6502Count
+)
+
+var fusion6502Patterns = [fusion6502Count]fusion6502Pattern{
+	FusionDexBne: {name: "DexBne", length: 3, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xCA},
+		{offset: 1, opcode: 0xD0},
+	}},
+	FusionDeyBne: {name: "DeyBne", length: 3, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0x88},
+		{offset: 1, opcode: 0xD0},
+	}},
+	FusionInxBne: {name: "InxBne", length: 3, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xE8},
+		{offset: 1, opcode: 0xD0},
+	}},
+	FusionLdaImmStaZp: {name: "LdaImmStaZp", length: 4, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xA9},
+		{offset: 2, opcode: 0x85},
+	}},
+	FusionInyBne: {name: "InyBne", length: 3, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xC8},
+		{offset: 1, opcode: 0xD0},
+	}},
+	FusionClcAdcImm: {name: "ClcAdcImm", length: 3, jit: true, steps: []fusion6502Step{
+		{offset: 0, opcode: 0x18},
+		{offset: 1, opcode: 0x69},
+	}},
+	FusionClcAdcZp: {name: "ClcAdcZp", length: 3, jit: true, steps: []fusion6502Step{
+		{offset: 0, opcode: 0x18},
+		{offset: 1, opcode: 0x65},
+	}},
+	FusionSecSbcImm: {name: "SecSbcImm", length: 3, jit: true, steps: []fusion6502Step{
+		{offset: 0, opcode: 0x38},
+		{offset: 1, opcode: 0xE9},
+	}},
+	FusionSecSbcZp: {name: "SecSbcZp", length: 3, jit: true, steps: []fusion6502Step{
+		{offset: 0, opcode: 0x38},
+		{offset: 1, opcode: 0xE5},
+	}},
+	FusionInc16Zp: {name: "Inc16Zp", length: 6, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xE6},
+		{offset: 2, opcode: 0xD0, operand: fusion6502OperandEqual, value: 0x02},
+		{offset: 4, opcode: 0xE6, operand: fusion6502OperandNextOf, ref: 0},
+	}},
+	FusionAdd16Zp: {name: "Add16Zp", length: 13, jit: true, steps: []fusion6502Step{
+		{offset: 0, opcode: 0x18},
+		{offset: 1, opcode: 0xA5},
+		{offset: 3, opcode: 0x69},
+		{offset: 5, opcode: 0x85, operand: fusion6502OperandSameAs, ref: 1},
+		{offset: 7, opcode: 0xA5, operand: fusion6502OperandNextOf, ref: 1},
+		{offset: 9, opcode: 0x69},
+		{offset: 11, opcode: 0x85, operand: fusion6502OperandSameAs, ref: 4},
+	}},
+	FusionCopyAbsX: {name: "CopyAbsX", length: 6, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xBD},
+		{offset: 3, opcode: 0x9D},
+	}},
+	FusionCopyAbsY: {name: "CopyAbsY", length: 6, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xB9},
+		{offset: 3, opcode: 0x99},
+	}},
+	FusionLookupAbsX: {name: "LookupAbsX", length: 4, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xAA},
+		{offset: 1, opcode: 0xBD},
+	}},
+	FusionLookupAbsY: {name: "LookupAbsY", length: 4, jit: false, steps: []fusion6502Step{
+		{offset: 0, opcode: 0xA8},
+		{offset: 1, opcode: 0xB9},
+	}},
+}
+
+// fusion6502MaxInstrs is the longest idiom, in instructions.
+const fusion6502MaxInstrs = 7
+
+// fusion6502ByOpcode lists the idioms starting with each opcode, longest first.
+var fusion6502ByOpcode = [256][]FusionID{
+	0x18: {FusionAdd16Zp, FusionClcAdcImm, FusionClcAdcZp},
+	0x38: {FusionSecSbcImm, FusionSecSbcZp},
+	0x88: {FusionDeyBne},
+	0xA8: {FusionLookupAbsY},
+	0xA9: {FusionLdaImmStaZp},
+	0xAA: {FusionLookupAbsX},
+	0xB9: {FusionCopyAbsY},
+	0xBD: {FusionCopyAbsX},
+	0xC8: {FusionInyBne},
+	0xCA: {FusionDexBne},
+	0xE6: {FusionInc16Zp},
+	0xE8: {FusionInxBne},
+}
+
+// execFusion6502 runs the interpreter fast path for id at pc. It returns
+// the number of instructions retired, or 0 when the fuser declined.
+func (cpu_6502 *CPU_6502) execFusion6502(id FusionID, ram *[0x10000]byte, io *[256]bool, pc uint16) int {
+	switch id {
+	case FusionDexBne:
+		return cpu_6502.fusedDexBne(ram, io, pc)
+	case FusionDeyBne:
+		return cpu_6502.fusedDeyBne(ram, io, pc)
+	case FusionInxBne:
+		return cpu_6502.fusedInxBne(ram, io, pc)
+	case FusionLdaImmStaZp:
+		return cpu_6502.fusedLdaImmStaZp(ram, io, pc)
+	case FusionInyBne:
+		return cpu_6502.fusedInyBne(ram, io, pc)
+	case FusionClcAdcImm:
+		return cpu_6502.fusedClcAdcImm(ram, io, pc)
+	case FusionClcAdcZp:
+		return cpu_6502.fusedClcAdcZp(ram, io, pc)
+	case FusionSecSbcImm:
+		return cpu_6502.fusedSecSbcImm(ram, io, pc)
+	case FusionSecSbcZp:
+		return cpu_6502.fusedSecSbcZp(ram, io, pc)
+	case FusionInc16Zp:
+		return cpu_6502.fusedInc16Zp(ram, io, pc)
+	case FusionAdd16Zp:
+		return cpu_6502.fusedAdd16Zp(ram, io, pc)
+	case FusionCopyAbsX:
+		return cpu_6502.fusedCopyAbsX(ram, io, pc)
+	case FusionCopyAbsY:
+		return cpu_6502.fusedCopyAbsY(ram, io, pc)
+	case FusionLookupAbsX:
+		return cpu_6502.fusedLookupAbsX(ram, io, pc)
+	case FusionLookupAbsY:
+		return cpu_6502.fusedLookupAbsY(ram, io, pc)
+	}
+	return 0
+}
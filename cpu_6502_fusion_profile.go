@@ -0,0 +1,173 @@
+// cpu_6502_fusion_profile.go - Mining candidate fusion idioms from real
+// 6502 programs.
+//
+// A fusion6502Profile watches every instruction a player retires and
+// counts the straight-line opcode sequences (2 to
+// fusion6502ProfileMaxLen instructions) that end at it. A sequence
+// restarts whenever control flow is not sequential, and a branch or jump
+// only ever ends one, matching the shapes fusion can handle. The report
+// ranks sequences by the dispatches fusing them would save and names
+// the interp6502meta.Idioms entry already covering each, so new rows
+// for the table can be read straight off a corpus run
+// (TestSID6502FusionProfile).
+
+package main
+
+import (
+	"fmt"
+	"io"
+	"slices"
+	"strings"
+)
+
+const fusion6502ProfileMaxLen = 4
+
+type fusion6502Sequence struct {
+	n   uint8
+	ops [fusion6502ProfileMaxLen]byte
+}
+
+type fusion6502Profile struct {
+	window [fusion6502ProfileMaxLen]byte
+	depth  int
+	nextPC uint16
+	total  uint64
+	counts map[fusion6502Sequence]uint64
+}
+
+func newFusion6502Profile() *fusion6502Profile {
+	return &fusion6502Profile{counts: make(map[fusion6502Sequence]uint64)}
+}
+
+// observe records the instruction about to execute at pc.
+func (p *fusion6502Profile) observe(ram *[0x10000]byte, pc uint16) {
+	op := ram[pc]
+	p.total++
+	if p.depth == 0 || pc != p.nextPC {
+		p.depth = 0
+	}
+	if p.depth == fusion6502ProfileMaxLen {
+		copy(p.window[:], p.window[1:])
+		p.depth--
+	}
+	p.window[p.depth] = op
+	p.depth++
+	p.nextPC = pc + uint16(jit6502InstrLengths[op])
+
+	for n := 2; n <= p.depth; n++ {
+		var seq fusion6502Sequence
+		seq.n = uint8(n)
+		copy(seq.ops[:], p.window[p.depth-n:p.depth])
+		p.counts[seq]++
+	}
+	if fusion6502EndsSequence(op) {
+		p.depth = 0
+	}
+}
+
+func fusion6502EndsSequence(op byte) bool {
+	switch op {
+	case 0x00, 0x20, 0x40, 0x4C, 0x60, 0x6C:
+		return true
+	}
+	return op&0x1F == 0x10 // Bcc
+}
+
+// fusion6502SequenceCount is one report row.
+type fusion6502SequenceCount struct {
+	seq   fusion6502Sequence
+	count uint64
+	saved uint64 // dispatches saved if fused: count * (n-1)
+	idiom FusionID
+}
+
+// top returns the n sequences whose fusion would save the most
+// dispatches.
+func (p *fusion6502Profile) top(n int) []fusion6502SequenceCount {
+	rows := make([]fusion6502SequenceCount, 0, len(p.counts))
+	for seq, count := range p.counts {
+		rows = append(rows, fusion6502SequenceCount{
+			seq:   seq,
+			count: count,
+			saved: count * uint64(seq.n-1),
+			idiom: fusion6502IdiomFor(seq),
+		})
+	}
+	slices.SortFunc(rows, func(a, b fusion6502SequenceCount) int {
+		if a.saved != b.saved {
+			if a.saved > b.saved {
+				return -1
+			}
+			return 1
+		}
+		return strings.Compare(a.seq.String(), b.seq.String())
+	})
+	return rows[:min(n, len(rows))]
+}
+
+// fusion6502IdiomFor returns the idiom with exactly seq's opcodes,
+// ignoring operand constraints, or FusionNone.
+func fusion6502IdiomFor(seq fusion6502Sequence) FusionID {
+	for _, id := range fusion6502ByOpcode[seq.ops[0]] {
+		steps := fusion6502Patterns[id].steps
+		if len(steps) != int(seq.n) {
+			continue
+		}
+		match := true
+		for k := range steps {
+			if steps[k].opcode != seq.ops[k] {
+				match = false
+				break
+			}
+		}
+		if match {
+			return id
+		}
+	}
+	return FusionNone
+}
+
+// report writes the n most profitable sequences.
+func (p *fusion6502Profile) report(w io.Writer, n int) {
+	fmt.Fprintf(w, "%d instructions profiled\n", p.total)
+	fmt.Fprintf(w, "%10s %6s  %-40s %s\n", "count", "share", "sequence", "idiom")
+	for _, row := range p.top(n) {
+		idiom := "-"
+		if row.idiom != FusionNone {
+			idiom = fusion6502Patterns[row.idiom].name
+		}
+		fmt.Fprintf(w, "%10d %5.1f%%  %-40s %s\n", row.count,
+			100*float64(row.saved)/float64(max(p.total, 1)), row.seq, idiom)
+	}
+}
+
+var fusion6502ModeSuffix = [...]string{
+	am6502Imp:     "",
+	am6502Acc:     " A",
+	am6502Imm:     " #",
+	am6502Zp:      " zp",
+	am6502ZpX:     " zp,X",
+	am6502ZpY:     " zp,Y",
+	am6502Abs:     " abs",
+	am6502AbsX:    " abs,X",
+	am6502AbsY:    " abs,Y",
+	am6502Ind:     " (abs)",
+	am6502IndX:    " (zp,X)",
+	am6502IndY:    " (zp),Y",
+	am6502AbsIndX: " (abs,X)",
+	am6502Rel:     " rel",
+	am6502ZpRel:   " zp,rel",
+}
+
+func (s fusion6502Sequence) String() string {
+	parts := make([]string, s.n)
+	for k := range parts {
+		info := opcodes6502[s.ops[k]]
+		if info.name == "" {
+			parts[k] = fmt.Sprintf("$%02X", s.ops[k])
+			continue
+		}
+		parts[k] = info.name + fusion6502ModeSuffix[info.mode]
+	}
+	return strings.Join(parts, "; ")
+}
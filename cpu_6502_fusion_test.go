@@ -0,0 +1,237 @@
+// cpu_6502_fusion_test.go - Idiom fusion: every fused idiom must leave
+// registers, memory and per-instruction cycles exactly as stepping its
+// instructions one by one, and whole SID renders must not change.
+
+package main
+
+import (
+	"bytes"
+	"math"
+	"math/rand"
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+func newFusionTestCPU(bus *SIDPlaybackBus6502) *CPU_6502 {
+	return (&SID6502Player{bus: bus}).createCPU()
+}
+
+// fusionTestIdiom assembles a random instance of the idiom: free
+// operands are random, zero-page operands never wrap and absolute
+// operands point into plain RAM.
+func fusionTestIdiom(rng *rand.Rand, p *fusion6502Pattern) []byte {
+	code := make([]byte, p.length)
+	var operands [fusion6502MaxInstrs]byte
+	for k := range p.steps {
+		s := &p.steps[k]
+		at := int(s.offset) + 1
+		code[s.offset] = s.opcode
+		switch {
+		case s.operand == fusion6502OperandEqual:
+			code[at] = s.value
+		case s.operand == fusion6502OperandSameAs:
+			code[at] = operands[s.ref]
+		case s.operand == fusion6502OperandNextOf:
+			code[at] = operands[s.ref] + 1
+		case jit6502InstrLengths[s.opcode] == 3:
+			code[at] = byte(rng.Intn(256))
+			code[at+1] = byte(0x20 + rng.Intn(0xA0))
+		default:
+			code[at] = byte(rng.Intn(0xFF))
+		}
+		operands[k] = code[at]
+	}
+	return code
+}
+
+func TestCPU6502Fusion_MatchesStep(t *testing.T) {
+	rng := rand.New(rand.NewSource(6502))
+	var image [0x10000]byte
+	rng.Read(image[:])
+
+	for id := FusionID(1); id < fusion6502Count; id++ {
+		p := &fusion6502Patterns[id]
+		t.Run(p.name, func(t *testing.T) {
+			for iter := range 200 {
+				code := fusionTestIdiom(rng, p)
+				fusedBus, steppedBus := newSIDPlaybackBus6502(false), newSIDPlaybackBus6502(false)
+				fusedBus.ram, steppedBus.ram = image, image
+				copy(fusedBus.ram[0x1000:], code)
+				copy(steppedBus.ram[0x1000:], code)
+				fused, stepped := newFusionTestCPU(fusedBus), newFusionTestCPU(steppedBus)
+				a, x, y, sr := byte(rng.Intn(256)), byte(rng.Intn(256)), byte(rng.Intn(256)), byte(rng.Intn(256))|UNUSED_FLAG
+				for _, cpu := range []*CPU_6502{fused, stepped} {
+					cpu.PC, cpu.A, cpu.X, cpu.Y, cpu.SR = 0x1000, a, x, y, sr
+				}
+
+				if got := matchFusion6502(&fusedBus.ram, 0x1000); got != id {
+					t.Fatalf("iter %d: %X matched %d, want %d", iter, code, got, id)
+				}
+				n := fused.stepFused(fusedBus, math.MaxInt)
+				if n == 0 || n > len(p.steps) || (n < len(p.steps) && id != FusionInc16Zp) {
+					t.Fatalf("iter %d: %X retired %d instructions", iter, code, n)
+				}
+				for k := range n {
+					if c := stepped.Step(); c != int(fused.fusedCycles[k]) {
+						t.Fatalf("iter %d: %X instruction %d took %d cycles, fused says %d",
+							iter, code, k, c, fused.fusedCycles[k])
+					}
+				}
+				if fused.PC != stepped.PC || fused.A != stepped.A || fused.X != stepped.X ||
+					fused.Y != stepped.Y || fused.SP != stepped.SP || fused.SR != stepped.SR ||
+					fused.Cycles != stepped.Cycles {
+					t.Fatalf("iter %d: %X (A=%02X X=%02X Y=%02X SR=%02X)\nfused   PC=%04X A=%02X X=%02X Y=%02X SP=%02X SR=%02X cyc=%d\nstepped PC=%04X A=%02X X=%02X Y=%02X SP=%02X SR=%02X cyc=%d",
+						iter, code, a, x, y, sr,
+						fused.PC, fused.A, fused.X, fused.Y, fused.SP, fused.SR, fused.Cycles,
+						stepped.PC, stepped.A, stepped.X, stepped.Y, stepped.SP, stepped.SR, stepped.Cycles)
+				}
+				if !bytes.Equal(fusedBus.ram[:], steppedBus.ram[:]) {
+					t.Fatalf("iter %d: %X memory differs", iter, code)
+				}
+			}
+		})
+	}
+}
+
+func TestCPU6502Fusion_DeclinesIO(t *testing.T) {
+	bus := newSIDPlaybackBus6502(false)
+	copy(bus.ram[0x1000:], []byte{
+		0xBD, 0x1B, 0xD4, // LDA $D41B,X  (SID OSC3)
+		0x9D, 0x00, 0x20, // STA $2000,X
+	})
+	cpu := newFusionTestCPU(bus)
+	cpu.PC = 0x1000
+	if n := cpu.stepFused(bus, math.MaxInt); n != 0 {
+		t.Fatalf("stepFused over SID read retired %d instructions", n)
+	}
+	if cpu.PC != 0x1000 || cpu.Cycles != 0 || bus.ram[0x2000] != 0 {
+		t.Fatalf("declined idiom changed state: PC=%04X cycles=%d", cpu.PC, cpu.Cycles)
+	}
+}
+
+func TestCPU6502Fusion_RespectsHorizon(t *testing.T) {
+	bus := newSIDPlaybackBus6502(false)
+	copy(bus.ram[0x1000:], []byte{
+		0xCA, 0xD0, 0xFD, // DEX; BNE $1000
+	})
+	copy(bus.ram[0x1100:], []byte{
+		0x18, 0xA5, 0x10, 0x69, 0x01, 0x85, 0x10, // CLC; LDA $10; ADC #1; STA $10
+		0xA5, 0x11, 0x69, 0x00, 0x85, 0x11, // LDA $11; ADC #0; STA $11
+	})
+	bus.ciaLatchA, bus.ciaTimerA, bus.ciaCtrlA = 100, 5, 0x01
+	cpu := newFusionTestCPU(bus)
+	cpu.X = 3
+
+	cpu.PC = 0x1000
+	if n := cpu.stepFused(bus, 3); n != 0 {
+		t.Fatalf("DEX; BNE fused within a 3-cycle limit")
+	}
+	if n := cpu.stepFused(bus, math.MaxInt); n != 2 {
+		t.Fatalf("DEX; BNE (worst case 4 cycles) not fused 5 cycles before a timer underflow: n=%d", n)
+	}
+	cpu.PC = 0x1100
+	if n := cpu.stepFused(bus, math.MaxInt); n != 0 {
+		t.Fatalf("16-bit add (18 cycles) fused 5 cycles before a timer underflow")
+	}
+	bus.ciaCtrlA = 0
+	if n := cpu.stepFused(bus, math.MaxInt); n != 7 {
+		t.Fatalf("16-bit add not fused with the timer stopped: n=%d", n)
+	}
+}
+
+func fusionSIDCorpus(tb testing.TB) []string {
+	dir := os.Getenv("IE_SID_CORPUS")
+	if dir == "" {
+		dir = filepath.Join("sdk", "examples", "assets", "music")
+	}
+	paths, _ := filepath.Glob(filepath.Join(dir, "*.sid"))
+	if len(paths) == 0 {
+		tb.Skipf("no .sid files in %s", dir)
+	}
+	return paths
+}
+
+func newFusionCorpusPlayer(tb testing.TB, path string, fuse bool) *SID6502Player {
+	file, err := ParseSIDFile(path)
+	if err != nil {
+		tb.Skipf("%s: %v", path, err)
+	}
+	player, err := newSID6502Player(file, 0, 44100)
+	if err != nil {
+		tb.Skipf("%s: %v", path, err)
+	}
+	player.fuse = fuse
+	return player
+}
+
+// TestSID6502Fusion_RenderUnchanged renders every corpus tune with and
+// without fusion; the SID event streams must be identical.
+func TestSID6502Fusion_RenderUnchanged(t *testing.T) {
+	for _, path := range fusionSIDCorpus(t) {
+		t.Run(filepath.Base(path), func(t *testing.T) {
+			plain := newFusionCorpusPlayer(t, path, false)
+			fused := newFusionCorpusPlayer(t, path, true)
+			for frame := range 250 {
+				want, _ := plain.RenderFrames(1)
+				got, _ := fused.RenderFrames(1)
+				if len(got) != len(want) {
+					t.Fatalf("frame %d: %d events fused, %d stepped", frame, len(got), len(want))
+				}
+				for i := range want {
+					if got[i] != want[i] {
+						t.Fatalf("frame %d event %d: fused %+v, stepped %+v", frame, i, got[i], want[i])
+					}
+				}
+			}
+			if plain.cpu.Cycles != fused.cpu.Cycles || plain.instructionCount != fused.instructionCount {
+				t.Fatalf("cycles/instructions: fused %d/%d, stepped %d/%d",
+					fused.cpu.Cycles, fused.instructionCount, plain.cpu.Cycles, plain.instructionCount)
+			}
+		})
+	}
+}
+
+// TestSID6502FusionProfile mines the corpus for frequent straight-line
+// sequences. Opt-in: IE_SID_FUSION_PROFILE=1 (IE_SID_CORPUS selects the
+// directory). Rows without an idiom are candidates for
+// interp6502meta.Idioms.
+func TestSID6502FusionProfile(t *testing.T) {
+	if os.Getenv("IE_SID_FUSION_PROFILE") == "" {
+		t.Skip("IE_SID_FUSION_PROFILE not set")
+	}
+	profile := newFusion6502Profile()
+	for _, path := range fusionSIDCorpus(t) {
+		player := newFusionCorpusPlayer(t, path, false)
+		player.profile = profile
+		player.RenderFrames(50 * 60)
+	}
+	var report bytes.Buffer
+	profile.report(&report, 40)
+	t.Logf("\n%s", report.String())
+}
+
+// BenchmarkSID6502Render_Corpus renders ten seconds of every corpus
+// tune per iteration, stepped and fused:
+//
+//	go test -run '^$' -bench SID6502Render_Corpus -count 10 | benchstat -col /mode -
+func BenchmarkSID6502Render_Corpus(b *testing.B) {
+	paths := fusionSIDCorpus(b)
+	for _, mode := range []struct {
+		name string
+		fuse bool
+	}{{"mode=step", false}, {"mode=fused", true}} {
+		b.Run(mode.name, func(b *testing.B) {
+			players := make([]*SID6502Player, len(paths))
+			for i, path := range paths {
+				players[i] = newFusionCorpusPlayer(b, path, mode.fuse)
+			}
+			b.ResetTimer()
+			for range b.N {
+				for _, player := range players {
+					player.RenderFrames(50 * 10)
+				}
+			}
+		})
+	}
+}
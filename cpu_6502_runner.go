@@ -113,6 +113,16 @@ func (r *CPU6502Runner) IsRunning() bool {
 	return r.cpu.Running()
 }
 
+// SoundWriteClock exposes the cycle counter used to timestamp sound register
+// writes (see SoundChip.SetWriteClock). Only called from the CPU goroutine.
+// The JIT adds a block's cycles when the block exits, so it has no clock.
+func (r *CPU6502Runner) SoundWriteClock() (func() uint64, uint64) {
+	if r.JITEnabled && jit6502Available {
+		return nil, 0
+	}
+	return func() uint64 { return r.cpu.Cycles }, SID_CLOCK_PAL
+}
+
 func (r *CPU6502Runner) StartExecution() {
 	r.execMu.Lock()
 	defer r.execMu.Unlock()
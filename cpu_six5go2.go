@@ -264,6 +264,9 @@ type CPU_6502 struct {
 	codePageBitmap   [256]byte // self-mod detection: one byte per 6502 page
 	directPageBitmap [256]byte // JIT fast-path: 0=memDirect ok, 1=bail to interpreter
 	directPageReady  bool      // set true once initDirectPageBitmap has been called for this run
+
+	// Idiom fusion: per-instruction cycles of the last stepFused idiom
+	fusedCycles [fusion6502MaxInstrs]uint8
 }
 
 // Running returns the execution state (thread-safe)
@@ -242,6 +242,8 @@ func (c *CPU_X86) Reset() {
 
 // syncJITRegsFromNamed copies named register fields into the jitRegs array
 // (x86 encoding order: EAX=0, ECX=1, EDX=2, EBX=3, ESP=4, EBP=5, ESI=6, EDI=7).
+// Segment registers travel with them: both native code (LES/LDS) and
+// interpreter steps inside the JIT loop can write them.
 func (c *CPU_X86) syncJITRegsFromNamed() {
 	c.jitRegs[0] = c.EAX
 	c.jitRegs[1] = c.ECX
@@ -251,6 +253,7 @@ func (c *CPU_X86) syncJITRegsFromNamed() {
 	c.jitRegs[5] = c.EBP
 	c.jitRegs[6] = c.ESI
 	c.jitRegs[7] = c.EDI
+	c.syncJITSegRegsFromNamed()
 }
 
 // syncJITRegsToNamed copies the jitRegs array back into named register fields.
@@ -263,6 +266,7 @@ func (c *CPU_X86) syncJITRegsToNamed() {
 	c.EBP = c.jitRegs[5]
 	c.ESI = c.jitRegs[6]
 	c.EDI = c.jitRegs[7]
+	c.syncJITSegRegsToNamed()
 }
 
 // syncJITSegRegsFromNamed copies named segment register fields into the jitSegRegs array.
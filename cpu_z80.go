@@ -94,8 +94,9 @@ type CPU_Z80 struct {
 	jitCtx           any        // *Z80JITContext
 	jitTurboCache    any        // map[uint16]*z80TurboBlock on JIT builds
 	jitTurboStats    any        // *z80TurboStats on JIT builds
+	jitBankState     any        // *z80BankJITState on JIT builds
 	codePageBitmap   [256]byte  // self-mod detection (one byte per 256-byte Z80 page)
-	directPageBitmap [256]byte  // JIT fast-path (0=direct mem, 1=bail to interp)
+	directPageBitmap [256]byte  // JIT fast-path (0=direct mem, 1=bail to interp, 2=banked via PageXlat)
 	Debug            bool       // disable JIT when debugging
 }
 
@@ -80,6 +80,13 @@ type Z80BusAdapter struct {
 	bank1Enable bool   // Bank 1 enabled
 	bank2Enable bool   // Bank 2 enabled
 	bank3Enable bool   // Bank 3 enabled
+
+	// JIT self-modification tracking: MachineBus pages holding compiled
+	// code, and those written through this adapter since the JIT last
+	// looked. Nil when the JIT is not running.
+	jitCodePages  map[uint32]struct{}
+	jitDirtyPages []uint32
+
 	debugAccess *DebugAccessService
 	debugCPUID  int
 }
@@ -172,11 +179,29 @@ func (b *Z80BusAdapter) readBus8(addr uint32) byte {
 func (b *Z80BusAdapter) writeBus8(addr uint32, value byte) {
 	b.bus.Write8(addr, value)
 	b.debugOnWrite(addr, 1, 0, uint64(value))
+	if b.jitCodePages != nil {
+		b.noteJITCodeWrite(addr)
+	}
 }
 
 func (b *Z80BusAdapter) writeMemoryDirect(addr uint32, value byte) {
 	b.bus.WriteMemoryDirect(addr, value)
 	b.debugOnWrite(addr, 1, 0, uint64(value))
+	if b.jitCodePages != nil {
+		b.noteJITCodeWrite(addr)
+	}
+}
+
+// noteJITCodeWrite queues the page of addr for invalidation if the JIT has
+// compiled code from it.
+func (b *Z80BusAdapter) noteJITCodeWrite(addr uint32) {
+	page := addr &^ 0xFF
+	if _, ok := b.jitCodePages[page]; !ok {
+		return
+	}
+	if n := len(b.jitDirtyPages); n == 0 || b.jitDirtyPages[n-1] != page {
+		b.jitDirtyPages = append(b.jitDirtyPages, page)
+	}
 }
 
 func (b *Z80BusAdapter) ResetIOState() {
@@ -906,6 +931,16 @@ func (r *CPUZ80Runner) IsRunning() bool {
 	return r.cpu.Running()
 }
 
+// SoundWriteClock exposes the cycle counter used to timestamp sound register
+// writes (see SoundChip.SetWriteClock). Only called from the CPU goroutine.
+// The JIT adds a block's cycles when the block exits, so it has no clock.
+func (r *CPUZ80Runner) SoundWriteClock() (func() uint64, uint64) {
+	if r.cpu.jitEnabled && z80JitAvailable {
+		return nil, 0
+	}
+	return func() uint64 { return r.cpu.Cycles }, z80CPUClock
+}
+
 func (r *CPUZ80Runner) StartExecution() {
 	r.execMu.Lock()
 	defer r.execMu.Unlock()
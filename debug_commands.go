@@ -329,6 +329,8 @@ func (m *MachineMonitor) executeCommand(input string) bool {
 		return m.cmdFreezeAudio(cmd)
 	case "ta":
 		return m.cmdThawAudio(cmd)
+	case "at":
+		return m.cmdAudioTelemetry(cmd)
 	case "save":
 		return m.cmdSaveMemory(cmd)
 	case "load":
@@ -1994,6 +1996,37 @@ func (m *MachineMonitor) cmdThawAudio(_ MonitorCommand) bool {
 	return false
 }
 
+func (m *MachineMonitor) cmdAudioTelemetry(_ MonitorCommand) bool {
+	if m.soundChip == nil {
+		m.appendOutput("No sound chip available", colorRed)
+		return false
+	}
+	t := m.soundChip.AudioTelemetry()
+	m.appendOutput(fmt.Sprintf("Callbacks: %d  Samples: %d", t.Callbacks, t.Samples), colorCyan)
+	m.appendOutput(fmt.Sprintf("Render: last %v  p50 <%v  p99 <%v  max %v", t.RenderLast, t.RenderP50, t.RenderP99, t.RenderMax), colorCyan)
+	color := uint32(colorCyan)
+	if t.DeadlineMisses > 0 || t.Underruns > 0 {
+		color = colorRed
+	}
+	m.appendOutput(fmt.Sprintf("Deadline misses: %d  Underruns: %d", t.DeadlineMisses, t.Underruns), color)
+	buffer := "default"
+	if t.BufferFrames > 0 {
+		buffer = fmt.Sprintf("%d frames", t.BufferFrames)
+	}
+	m.appendOutput(fmt.Sprintf("Queued: %d frames  Buffer: %s  Latency: %v  Jitter: %v", t.FillFrames, buffer, t.Latency, t.Jitter), colorCyan)
+	for i, n := range t.Histogram {
+		if n == 0 {
+			continue
+		}
+		bound := "<" + audioRenderBucketLimit(i).String()
+		if i == audioRenderBuckets-1 {
+			bound = ">=" + audioRenderBucketLimit(i).String()
+		}
+		m.appendOutput(fmt.Sprintf("  %-8s %d", bound, n), colorWhite)
+	}
+	return false
+}
+
 type monitorHelpEntry struct {
 	Name     string
 	Summary  string
@@ -2056,6 +2089,7 @@ func monitorHelpRegistry() []monitorHelpEntry {
 		{Name: "sl", Summary: "Load a CPU-local state snapshot", Syntax: []string{"sl [file]"}, Examples: []string{"sl", "sl before.iem", "sl step.iem"}},
 		{Name: "fa", Summary: "Freeze audio output", Syntax: []string{"fa"}, Examples: []string{"fa", "fa; s 10", "fa; ta"}},
 		{Name: "ta", Summary: "Thaw audio output", Syntax: []string{"ta"}, Examples: []string{"ta", "fa; ta", "ta; g"}},
+		{Name: "at", Summary: "Show audio output telemetry: render times, misses, underruns, latency", Syntax: []string{"at"}, Examples: []string{"at", "fa; at", "ta; at"}},
 		{Name: "script", Summary: "Run a monitor command script", Syntax: []string{"script <file>"}, Examples: []string{"script bringup.imon", "script tests/boot.imon", "script repro.imon"}},
 		{Name: "macro", Summary: "Define a semicolon-separated command macro", Syntax: []string{"macro <name> <cmds..>"}, Examples: []string{"macro regs r;d", "macro boot b main;g", "macro mm map;pg list"}},
 	}
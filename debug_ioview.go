@@ -89,6 +89,7 @@ var ioDevices = map[string]*IODeviceDesc{
 			{"FILTER_TYPE", 0xF0828, 4, "RW"},
 			{"FILTER_MOD_SOURCE", 0xF082C, 4, "RW"},
 			{"FILTER_MOD_AMOUNT", 0xF0830, 4, "RW"},
+			{"PLUS_BANDLIMIT", 0xF0834, 4, "RW"},
 			// Square channel
 			{"SQUARE_FREQ", 0xF0900, 4, "RW"},
 			{"SQUARE_VOL", 0xF0904, 4, "RW"},
@@ -853,6 +854,12 @@ var ioDevices = map[string]*IODeviceDesc{
 			{"SYSINFO_TOTAL_RAM_HI", SYSINFO_TOTAL_RAM_HI, 4, "RO"},
 			{"SYSINFO_ACTIVE_RAM_LO", SYSINFO_ACTIVE_RAM_LO, 4, "RO"},
 			{"SYSINFO_ACTIVE_RAM_HI", SYSINFO_ACTIVE_RAM_HI, 4, "RO"},
+			{"SYSINFO_AUDIO_UNDERRUNS", SYSINFO_AUDIO_UNDERRUNS, 4, "RO"},
+			{"SYSINFO_AUDIO_MISSES", SYSINFO_AUDIO_MISSES, 4, "RO"},
+			{"SYSINFO_AUDIO_RENDER_P99", SYSINFO_AUDIO_RENDER_P99, 4, "RO"},
+			{"SYSINFO_AUDIO_LATENCY_US", SYSINFO_AUDIO_LATENCY_US, 4, "RO"},
+			{"SYSINFO_AUDIO_BUFFER", SYSINFO_AUDIO_BUFFER, 4, "RO"},
+			{"SYSINFO_AUDIO_JITTER_US", SYSINFO_AUDIO_JITTER_US, 4, "RO"},
 		},
 	},
 }
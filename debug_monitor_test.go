@@ -2051,6 +2051,30 @@ func TestMonitorTaCommand(t *testing.T) {
 	}
 }
 
+func TestMonitorAtCommand(t *testing.T) {
+	chip, err := NewSoundChip(AUDIO_BACKEND_OTO)
+	if err != nil {
+		t.Fatalf("NewSoundChip: %v", err)
+	}
+	chip.telemetry.recordRender(time.Now().Add(-700*time.Microsecond), 512)
+
+	mon, _ := newTestMonitor()
+	mon.soundChip = chip
+	mon.outputLines = nil
+	mon.ExecuteCommand("at")
+
+	var text strings.Builder
+	for _, line := range mon.outputLines {
+		text.WriteString(line.Text + "\n")
+	}
+	out := text.String()
+	for _, want := range []string{"Callbacks: 1  Samples: 512", "Deadline misses: 0", "<1.024ms"} {
+		if !strings.Contains(out, want) {
+			t.Errorf("at output missing %q:\n%s", want, out)
+		}
+	}
+}
+
 // ===========================================================================
 // Worker Control Model (Step 2)
 // ===========================================================================
@@ -8,5 +8,9 @@ func init() {
 	compiledFeatures = append(compiledFeatures, "emutos:embedded")
 }
 
-//go:embed sdk/examples/prebuilt/etos256us.img
+// The ROM is linked in gzip-compressed and unpacked through the asset
+// cache on first use (asset_store.go); "make packed-roms" writes the
+// .gz alongside the image.
+//
+//go:embed sdk/examples/prebuilt/etos256us.img.gz
 var embeddedEmuTOSImage []byte
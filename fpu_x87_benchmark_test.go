@@ -375,3 +375,40 @@ func BenchmarkX87_MulAdd_Pipeline(b *testing.B) {
 		}
 	}
 }
+
+func BenchmarkX87_Horner_Pipeline(b *testing.B) {
+	cpu, bus := setupX87BenchCPU()
+	addrX := uint32(0x0D00)
+	addrC := uint32(0x0D08) // c3, c2, c1, c0
+	addrR := uint32(0x0D28) // result
+	x87BenchWrite64(bus, addrX, 1.5)
+	for i, c := range []float64{2.0, -3.0, 0.5, 7.0} {
+		x87BenchWrite64(bus, addrC+uint32(i*8), c)
+	}
+	m := func(op, modrm byte, addr uint32) []byte {
+		return []byte{op, modrm, byte(addr), byte(addr >> 8), byte(addr >> 16), byte(addr >> 24)}
+	}
+
+	// Register-stack heavy: x stays in ST(1) while the polynomial is
+	// accumulated in ST(0), then FXCH/FSTP ST(0) discard it.
+	var code []byte
+	code = append(code, m(0xDD, 0x05, addrX)...) // FLD m64 x
+	code = append(code, m(0xDD, 0x05, addrC)...) // FLD m64 c3
+	for i := uint32(1); i < 4; i++ {
+		code = append(code, 0xD8, 0xC9)                  // FMUL ST(0),ST(1)
+		code = append(code, m(0xDC, 0x05, addrC+i*8)...) // FADD m64 ci
+	}
+	code = append(code, 0xD9, 0xC9)              // FXCH ST(1)
+	code = append(code, 0xDD, 0xD8)              // FSTP ST(0)
+	code = append(code, m(0xDD, 0x1D, addrR)...) // FSTP m64 result
+	x87BenchWriteCode(bus, 0x1000, code...)
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		cpu.EIP = 0x1000
+		cpu.FPU.Reset()
+		for range 11 {
+			cpu.Step()
+		}
+	}
+}
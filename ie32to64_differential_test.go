@@ -0,0 +1,217 @@
+// ie32to64_differential_test.go - differential harness for cmd/ie32to64.
+//
+// Each program is assembled with ie32asm and run on the IE32 interpreter,
+// then converted with ie32to64 at every -O level, assembled with ie64asm
+// and run on CPU64. Registers A..W must match r1..r16 and the scratch
+// region must match byte for byte at HALT. The workloads mirror
+// ie32_benchmark_test.go (ALU, memory, mixed, call) plus the idioms the
+// optimising levels target; the test logs retired instructions and wall
+// time per level so the conversion speedup can be read off -v output.
+
+package main
+
+import (
+	"bytes"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+	"testing"
+	"time"
+)
+
+const ie32DiffScratch = 0x4000
+
+type ie32DiffProgram struct {
+	name string
+	src  string
+	// signed programs branch on values with bit 31 set; -O0 compares all
+	// 64 bits of the zero-extended register and is not expected to match.
+	signed bool
+}
+
+var ie32DiffPrograms = []ie32DiffProgram{
+	{name: "alu", src: `
+.org 0x1000
+    LOAD B, #256
+loop:
+    ADD A, #1
+    SUB A, #1
+    AND A, #0xFF
+    XOR A, #0
+    SUB B, #1
+    JNZ B, loop
+    HALT
+`},
+	{name: "memory", src: `
+.org 0x1000
+    LOAD B, #256
+loop:
+    LOAD A, @0x4000
+    STORE A, @0x4000
+    ADD A, #1
+    SUB B, #1
+    JNZ B, loop
+    HALT
+`},
+	{name: "mixed", src: `
+.org 0x1000
+    LOAD B, #256
+loop:
+    LOAD A, @0x4100
+    ADD A, #7
+    XOR A, #0x55
+    AND A, #0xFF
+    STORE A, @0x4100
+    SUB B, #1
+    JNZ B, loop
+    HALT
+`},
+	{name: "call", src: `
+.org 0x1000
+    LOAD B, #256
+loop:
+    JSR callee
+    SUB B, #1
+    JNZ B, loop
+    HALT
+callee:
+    ADD A, #1
+    RTS
+`},
+	{name: "idioms", src: `
+.org 0x1000
+    LDX #0x4000
+    LDC #64
+fill:
+    STC [X]
+    ADD X, #4
+    SUB C, #1
+    JNZ C, fill
+    LDX #0x4000
+    LDY #0x4200
+    LDC #64
+copy:
+    LDA [X]
+    STA [Y]
+    ADD X, #4
+    ADD Y, #4
+    SUB C, #1
+    JNZ C, copy
+    LDD #0
+count:
+    INC D
+    LDA D
+    SUB A, #100
+    JNZ A, count
+    LDF X
+    SUB F, Y
+    JZ F, done
+    LDE #9
+    DIV E, D
+done:
+    HALT
+`},
+	{name: "signed", signed: true, src: `
+.org 0x1000
+    LDA #0x80000000
+    LDB #0
+    JLT A, neg
+    LDB #1
+neg:
+    LDC #5
+down:
+    SUB C, #1
+    ADD B, #2
+    JGE C, down
+    HALT
+`},
+}
+
+func buildIE32To64(t *testing.T) string {
+	t.Helper()
+	bin := filepath.Join(t.TempDir(), "ie32to64")
+	cmd := exec.Command("go", "build", "-o", bin, "./cmd/ie32to64")
+	cmd.Dir = rotozoomerRepoRoot(t)
+	if out, err := cmd.CombinedOutput(); err != nil {
+		t.Fatalf("failed to build ie32to64: %v\n%s", err, out)
+	}
+	return bin
+}
+
+func runTool(t *testing.T, name string, args ...string) {
+	t.Helper()
+	if out, err := exec.Command(name, args...).CombinedOutput(); err != nil {
+		t.Fatalf("%s %s: %v\n%s", filepath.Base(name), strings.Join(args, " "), err, out)
+	}
+}
+
+func readBin(t *testing.T, path string) []byte {
+	t.Helper()
+	data, err := os.ReadFile(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	return data
+}
+
+// runIE32ToHalt steps the IE32 interpreter until HALT.
+func runIE32ToHalt(t *testing.T, bin []byte) (*CPU, int, time.Duration) {
+	t.Helper()
+	cpu := NewCPU(NewMachineBus())
+	cpu.LoadProgramBytes(bin)
+	cpu.PC = PROG_START
+	const maxSteps = 10_000_000
+	start := time.Now()
+	steps := 0
+	for ; steps < maxSteps && cpu.memory[cpu.PC] != HALT; steps++ {
+		cpu.StepOne()
+	}
+	if steps >= maxSteps {
+		t.Fatalf("IE32 program did not halt (PC=%#x)", cpu.PC)
+	}
+	return cpu, steps, time.Since(start)
+}
+
+func TestIE32To64_Differential(t *testing.T) {
+	dir := t.TempDir()
+	ie32asm := buildIE32Assembler(t)
+	ie64asm := buildIE64Assembler(t)
+	conv := buildIE32To64(t)
+
+	for _, prog := range ie32DiffPrograms {
+		t.Run(prog.name, func(t *testing.T) {
+			src := filepath.Join(dir, prog.name+".asm")
+			if err := os.WriteFile(src, []byte(prog.src), 0o644); err != nil {
+				t.Fatal(err)
+			}
+			bin32 := filepath.Join(dir, prog.name+".iex")
+			runTool(t, ie32asm, "-o", bin32, src)
+			ref, refSteps, refTime := runIE32ToHalt(t, readBin(t, bin32))
+			t.Logf("%-7s IE32   %6d instructions %v", prog.name, refSteps, refTime)
+
+			for _, level := range []string{"0", "1", "2"} {
+				if prog.signed && level == "0" {
+					continue
+				}
+				out := filepath.Join(dir, prog.name+"_O"+level+".asm")
+				runTool(t, conv, "-O="+level, "-o", out, src)
+				bin64 := filepath.Join(dir, prog.name+"_O"+level+".ie64")
+				runTool(t, ie64asm, "-o", bin64, out)
+
+				cpu, steps, elapsed := timeToHalt(t, readBin(t, bin64), 10_000_000)
+				for r := range 16 {
+					if got, want := cpu.regs[r+1], uint64(*ref.regs[r]); got != want {
+						t.Errorf("-O%s: r%d = %#x, IE32 register %d = %#x", level, r+1, got, r, want)
+					}
+				}
+				lo, hi := ie32DiffScratch, ie32DiffScratch+0x400
+				if !bytes.Equal(cpu.memory[lo:hi], ref.memory[lo:hi]) {
+					t.Errorf("-O%s: scratch memory differs from IE32", level)
+				}
+				t.Logf("%-7s IE64 -O%s %6d instructions %v (%.2fx IE32 wall time)",
+					prog.name, level, steps, elapsed, refTime.Seconds()/elapsed.Seconds())
+			}
+		})
+	}
+}
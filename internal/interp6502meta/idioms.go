@@ -0,0 +1,80 @@
+package interp6502meta
+
+// IdiomOperand constrains the first operand byte of an idiom step.
+type IdiomOperand uint8
+
+const (
+	OperandAny    IdiomOperand = iota // any operand
+	OperandEqual                      // operand == Value
+	OperandSameAs                     // operand == operand of step Ref
+	OperandNextOf                     // operand == operand of step Ref + 1, without zero-page wrap
+)
+
+// IdiomStep is one instruction of a fused idiom.
+type IdiomStep struct {
+	Opcode  byte
+	Operand IdiomOperand
+	Value   byte
+	Ref     int
+}
+
+// IdiomMeta describes a recurring 6502 instruction sequence that the
+// Go interpreter executes in one dispatch and, when JIT names a
+// template, the 6502 JIT compiles as a single unit.
+//
+// IDs are positional (index+1) and the first four are the original
+// Phase 7a idioms; append new entries rather than reordering.
+type IdiomMeta struct {
+	Name  string
+	Doc   string
+	Steps []IdiomStep
+	JIT   string // emit6502Fused<JIT> template; "" keeps per-instruction JIT code
+}
+
+func op(opcode byte) IdiomStep { return IdiomStep{Opcode: opcode} }
+
+func opEq(opcode, value byte) IdiomStep {
+	return IdiomStep{Opcode: opcode, Operand: OperandEqual, Value: value}
+}
+
+func opSame(opcode byte, ref int) IdiomStep {
+	return IdiomStep{Opcode: opcode, Operand: OperandSameAs, Ref: ref}
+}
+
+func opNext(opcode byte, ref int) IdiomStep {
+	return IdiomStep{Opcode: opcode, Operand: OperandNextOf, Ref: ref}
+}
+
+// Idioms is the fusion pattern table. Shapes beyond the original four
+// come from mining SID player routines (see
+// TestSID6502FusionProfile): loop counters, carry-cleared arithmetic,
+// 16-bit pointer bumps and indexed table copies.
+var Idioms = []IdiomMeta{
+	{Name: "DexBne", Doc: "DEX; BNE rel", Steps: []IdiomStep{op(0xCA), op(0xD0)}},
+	{Name: "DeyBne", Doc: "DEY; BNE rel", Steps: []IdiomStep{op(0x88), op(0xD0)}},
+	{Name: "InxBne", Doc: "INX; BNE rel", Steps: []IdiomStep{op(0xE8), op(0xD0)}},
+	{Name: "LdaImmStaZp", Doc: "LDA #imm; STA zp", Steps: []IdiomStep{op(0xA9), op(0x85)}},
+	{Name: "InyBne", Doc: "INY; BNE rel", Steps: []IdiomStep{op(0xC8), op(0xD0)}},
+	{Name: "ClcAdcImm", Doc: "CLC; ADC #imm", Steps: []IdiomStep{op(0x18), op(0x69)}, JIT: "ClcAdc"},
+	{Name: "ClcAdcZp", Doc: "CLC; ADC zp", Steps: []IdiomStep{op(0x18), op(0x65)}, JIT: "ClcAdc"},
+	{Name: "SecSbcImm", Doc: "SEC; SBC #imm", Steps: []IdiomStep{op(0x38), op(0xE9)}, JIT: "SecSbc"},
+	{Name: "SecSbcZp", Doc: "SEC; SBC zp", Steps: []IdiomStep{op(0x38), op(0xE5)}, JIT: "SecSbc"},
+	{
+		Name:  "Inc16Zp",
+		Doc:   "INC zp; BNE *+4; INC zp+1",
+		Steps: []IdiomStep{op(0xE6), opEq(0xD0, 0x02), opNext(0xE6, 0)},
+	},
+	{
+		Name: "Add16Zp",
+		Doc:  "CLC; LDA zp; ADC #lo; STA zp; LDA zp+1; ADC #hi; STA zp+1",
+		Steps: []IdiomStep{
+			op(0x18), op(0xA5), op(0x69), opSame(0x85, 1),
+			opNext(0xA5, 1), op(0x69), opSame(0x85, 4),
+		},
+		JIT: "Add16Zp",
+	},
+	{Name: "CopyAbsX", Doc: "LDA abs,X; STA abs,X", Steps: []IdiomStep{op(0xBD), op(0x9D)}},
+	{Name: "CopyAbsY", Doc: "LDA abs,Y; STA abs,Y", Steps: []IdiomStep{op(0xB9), op(0x99)}},
+	{Name: "LookupAbsX", Doc: "TAX; LDA abs,X", Steps: []IdiomStep{op(0xAA), op(0xBD)}},
+	{Name: "LookupAbsY", Doc: "TAY; LDA abs,Y", Steps: []IdiomStep{op(0xA8), op(0xB9)}},
+}
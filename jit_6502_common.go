@@ -135,12 +135,14 @@ type JIT6502Instr struct {
 	operand  uint16 // 0, 1, or 2 byte operand (zero-extended)
 	length   byte   // 1, 2, or 3
 	pcOffset uint16 // byte offset from block start
-	fused    uint8  // turbo-only synthetic behavior markers
+	fused    uint8  // synthetic behavior markers (turbo leaf calls, idiom tails)
+	idiom    uint8  // FusionID whose JIT template starts here; 0 = none
 }
 
 const (
 	p65FusedJSRLeafCall uint8 = 1 << iota
 	p65FusedRTSLeafReturn
+	p65FusedIdiomTail // emitted by the preceding idiom head's template
 )
 
 // ===========================================================================
@@ -1864,21 +1864,31 @@ func emit6502ADCFlags(cb *CodeBuffer) {
 	// Zero-extend result
 	amd64MOVZX_B(cb, j65RegA, j65RegA) // EBX = zero-extended BL
 
+	emit6502MergeCV(cb, false)
+
+	// N/Z deferred — caller sets j65MaybeSetNZPending(&nz, j65RegA, live, i)
+}
+
+// emit6502MergeCV folds the carry in CL and overflow in DL, captured by
+// SETC/SETO straight after an 8-bit add or subtract, into SR C and V.
+// borrow inverts CL first: after SUB/SBB x86 CF is a borrow, the
+// opposite of the 6502 carry.
+func emit6502MergeCV(cb *CodeBuffer, borrow bool) {
 	// Clear C, V in SR (preserve N, Z for lazy deferral; also preserve I, D, B, U)
 	amd64AND_reg_imm32_32bit(cb, j65RegSR, 0xBE) // ~(0x01|0x40) = 0xBE
 
-	// Set C from CL
+	if borrow {
+		cb.EmitBytes(0x80, modRM(3, 6, amd64RCX), 0x01) // XOR CL, 1
+	}
 	amd64MOVZX_B(cb, amd64RCX, amd64RCX)
 	emitREX(cb, false, amd64RCX, j65RegSR)
 	cb.EmitBytes(0x09, modRM(3, amd64RCX, j65RegSR)) // OR R15D, ECX
 
-	// Set V from DL (shift to bit 6)
+	// V from DL (shift to bit 6)
 	amd64MOVZX_B(cb, amd64RDX, amd64RDX)
 	amd64SHL_imm32(cb, amd64RDX, 6)
 	emitREX(cb, false, amd64RDX, j65RegSR)
 	cb.EmitBytes(0x09, modRM(3, amd64RDX, j65RegSR)) // OR R15D, EDX
-
-	// N/Z deferred — caller sets j65MaybeSetNZPending(&nz, j65RegA, live, i)
 }
 
 // emit6502DecimalBailCheck emits a check for decimal mode (D flag).
@@ -1914,21 +1924,7 @@ func emit6502SBCFlags(cb *CodeBuffer) {
 	// Zero-extend result
 	amd64MOVZX_B(cb, j65RegA, j65RegA)
 
-	// Clear C, V in SR (preserve N, Z for lazy deferral; also preserve I, D, B, U)
-	amd64AND_reg_imm32_32bit(cb, j65RegSR, 0xBE) // ~(0x01|0x40) = 0xBE
-
-	// C = !borrow = !CL (6502: C=1 if no borrow)
-	// XOR CL, 1
-	cb.EmitBytes(0x80, modRM(3, 6, amd64RCX), 0x01) // XOR CL, 1
-	amd64MOVZX_B(cb, amd64RCX, amd64RCX)
-	emitREX(cb, false, amd64RCX, j65RegSR)
-	cb.EmitBytes(0x09, modRM(3, amd64RCX, j65RegSR))
-
-	// V from DL (shift to bit 6)
-	amd64MOVZX_B(cb, amd64RDX, amd64RDX)
-	amd64SHL_imm32(cb, amd64RDX, 6)
-	emitREX(cb, false, amd64RDX, j65RegSR)
-	cb.EmitBytes(0x09, modRM(3, amd64RDX, j65RegSR))
+	emit6502MergeCV(cb, true)
 
 	// N/Z deferred — caller sets j65MaybeSetNZPending(&nz, j65RegA, live, i)
 }
@@ -2102,6 +2098,9 @@ func compileBlock6502WithOptions(instrs []JIT6502Instr, startPC uint16, execMem
 			}
 		}
 	}
+	if jit6502FusionEnabled {
+		p65MarkFusedIdioms(instrs, branchTargets)
+	}
 
 	for i := range instrs {
 		// Flush pending cycles and materialize deferred N/Z at branch targets
@@ -2114,6 +2113,17 @@ func compileBlock6502WithOptions(instrs []JIT6502Instr, startPC uint16, execMem
 		instrOffsets[i] = cb.Len() // record native code offset for this instruction
 
 		ji := &instrs[i]
+		if ji.fused&p65FusedIdiomTail != 0 {
+			continue // emitted with its idiom head
+		}
+		if ji.idiom != 0 {
+			emit6502Fusion(FusionID(ji.idiom), &j65FusionSite{
+				cb: cb, instrs: instrs, idx: i, startPC: startPC,
+				pendingCycles: &pendingCycles, bails: &bails, invals: &invals,
+				nz: &nz, live: live, opts: opts,
+			})
+			continue
+		}
 		instrPC := startPC + ji.pcOffset
 		baseCycles := uint32(jit6502BaseCycles[ji.opcode])
 		nextPC := uint32(instrPC) + uint32(ji.length)
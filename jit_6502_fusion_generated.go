@@ -0,0 +1,19 @@
+// Code generated by cmd/gen_interp6502; DO NOT EDIT.
+
+//go:build amd64 && (linux || windows || darwin)
+
+package main
+
+// emit6502Fusion emits the JIT template for the idiom headed at site.
+func emit6502Fusion(id FusionID, site *j65FusionSite) {
+	switch id {
+	case FusionClcAdcImm, FusionClcAdcZp:
+		emit6502FusedClcAdc(site)
+	case FusionSecSbcImm, FusionSecSbcZp:
+		emit6502FusedSecSbc(site)
+	case FusionAdd16Zp:
+		emit6502FusedAdd16Zp(site)
+	default:
+		panic("emit6502Fusion: idiom has no JIT template")
+	}
+}
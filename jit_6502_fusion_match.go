@@ -1,44 +1,37 @@
-// jit_6502_fusion_match.go - Phase 7a 6502 universal-idiom fusion match
-// (scaffold).
+// jit_6502_fusion_match.go - 6502 idiom fusion in the JIT: block-level
+// matching and the emit templates named by interp6502meta.Idioms.
 //
-// Restricted to FusionIDs 1-4 per plan: the four truly universal 2-byte
-// 6502 idioms (DexBne, DeyBne, InxBne, LdaImmStaZp). Bench-shaped IDs 5-9
-// and full-program kernels 10-14 are out of scope per the plan's
-// scope-narrowing rule.
+// The idiom table, IDs and interpreter fusers live in cpu_6502_fusion.go
+// and its generated companion. Here the scanned instruction list is
+// matched against the same patterns; an idiom whose table row names a
+// JIT template has its head marked with the FusionID and its remaining
+// instructions marked p65FusedIdiomTail, and compileBlock6502WithOptions
+// hands the head to emit6502Fusion instead of the per-instruction
+// switch.
 //
-// Mechanism: exit-and-resume. The JIT block scanner detects an idiom
-// match at block-entry; the compiled block becomes a short prologue that
-// spills mapped registers and returns a JITExitFusion<ID> exit reason.
-// jit_6502_exec.go switches on the new reasons and runs the plain-Go
-// fuser, advances PC, then resumes JIT execution.
+// Only idioms that genuinely beat per-instruction code get a template:
+// CLC/SEC folded into a carry-less ADD/SUB, and the 16-bit zero-page add
+// done as one 16-bit ADD. Loop-counter idioms (DEX; BNE and friends)
+// already compile to two native instructions and keep the ordinary path.
 //
-// This file is the matcher and the four Go fusers. Wiring into the
-// emitter and exec loop is the second-half deliverable of Phase 7a; this
-// scaffold provides the matcher, the fuser bodies, and the exit-reason
-// constants so the wiring patch is small and reviewable.
-//
-// Risk: per the plan, this whole sub-phase is OPTIONAL — drop if bench
-// delta on Mixed is <2%.
+// Every template keeps the per-instruction contract at its edges: bails
+// resume at the idiom head with the head's pending cycles and NZ state,
+// a self-modifying store exits past the whole idiom, and NZ is left
+// pending on the same register the constituent instructions would have
+// used.
 
 //go:build amd64 && (linux || windows || darwin)
 
 package main
 
-// FusionID enumerates the universal 6502 fusion idioms covered by Phase 7a.
-type FusionID int
-
-const (
-	FusionNone        FusionID = 0
-	FusionDexBne      FusionID = 1 // CA D0 — DEX; BNE rel
-	FusionDeyBne      FusionID = 2 // 88 D0 — DEY; BNE rel
-	FusionInxBne      FusionID = 3 // E8 D0 — INX; BNE rel
-	FusionLdaImmStaZp FusionID = 4 // A9 imm 85 zp — LDA #imm; STA $zp
-)
+// jit6502FusionEnabled gates idiom templates at compile time. Default
+// true; flip to false to compile every instruction individually.
+var jit6502FusionEnabled = true
 
 // MatchFusionAtPC returns the FusionID matching the bytes at memory[pc:],
 // or FusionNone. The matcher is byte-precise — it does not consult
 // adjacency rules or live-flag state, because those are the JIT scanner's
-// job; the matcher only answers "do the next 2-4 bytes look like idiom X?"
+// job; the matcher only answers "do the next bytes look like idiom X?"
 //
 // memory must be the full guest address space (caller already resolved
 // banking). pc is wrapped at 16 bits before reads to mirror 6502 PC
@@ -47,119 +40,165 @@ func MatchFusionAtPC(memory []byte, pc uint16) FusionID {
 	if len(memory) < 0x10000 {
 		return FusionNone
 	}
-	b0 := memory[pc]
-	b1 := memory[uint16(pc+1)]
-	switch b0 {
-	case 0xCA: // DEX
-		if b1 == 0xD0 {
-			return FusionDexBne
-		}
-	case 0x88: // DEY
-		if b1 == 0xD0 {
-			return FusionDeyBne
-		}
-	case 0xE8: // INX
-		if b1 == 0xD0 {
-			return FusionInxBne
+	return matchFusion6502((*[0x10000]byte)(memory), pc)
+}
+
+// matchInstrs reports whether the idiom's steps are instrs[i:] laid out
+// back to back, none already claimed by another fusion.
+func (p *fusion6502Pattern) matchInstrs(instrs []JIT6502Instr, i int) bool {
+	if i+len(p.steps) > len(instrs) {
+		return false
+	}
+	base := instrs[i].pcOffset
+	var operands [fusion6502MaxInstrs]byte
+	for k := range p.steps {
+		s := &p.steps[k]
+		ji := &instrs[i+k]
+		if ji.opcode != s.opcode || ji.pcOffset != base+uint16(s.offset) || ji.fused != 0 {
+			return false
 		}
-	case 0xA9: // LDA #imm
-		if memory[uint16(pc+2)] == 0x85 {
-			return FusionLdaImmStaZp
+		operand := byte(ji.operand)
+		if !s.accepts(operand, operands[:k]) {
+			return false
 		}
+		operands[k] = operand
 	}
-	return FusionNone
+	return true
 }
 
-// FusionExitReason is the JITExitReason value the emitted prologue returns
-// when a fusion is dispatched. Distinct from the I/O-bail and MMU-bail
-// exit reasons so the dispatcher can route to the correct fuser without
-// re-decoding.
-//
-// Wired into jit_6502_common.go's exit-reason enum in the second-half
-// patch.
-type FusionExitReason int
-
-const (
-	FusionExitNone        FusionExitReason = 0
-	FusionExitDexBne      FusionExitReason = 1
-	FusionExitDeyBne      FusionExitReason = 2
-	FusionExitInxBne      FusionExitReason = 3
-	FusionExitLdaImmStaZp FusionExitReason = 4
-)
-
-// fuse6502DexBne executes one (DEX; BNE rel) iteration in plain Go and
-// returns the new PC and CPU state. Consumed by jit_6502_exec.go's
-// fusion-exit switch.
-//
-// rel is the signed 8-bit branch displacement read from memory[pc+1].
-func fuse6502DexBne(x byte, sr byte, pc uint16, rel int8) (newX byte, newSR byte, newPC uint16) {
-	newX = x - 1
-	newSR = sr & ^byte(0x82) // clear N, Z
-	if newX == 0 {
-		newSR |= 0x02 // Z
-	}
-	if newX&0x80 != 0 {
-		newSR |= 0x80 // N
+// p65MarkFusedIdioms marks every JIT-templated idiom in instrs. An idiom
+// is only taken when no branch lands inside it, since its interior
+// instructions have no native code of their own.
+func p65MarkFusedIdioms(instrs []JIT6502Instr, branchTargets []bool) {
+	for i := range instrs {
+		instrs[i].idiom = 0
+		instrs[i].fused &^= p65FusedIdiomTail
 	}
-	// DEX (1B) + BNE rel (2B) = 3B idiom; resume PC is pc+3, and the
-	// taken target is computed relative to the post-idiom PC per the
-	// 6502 branch encoding.
-	if newX != 0 {
-		newPC = uint16(int32(pc) + 3 + int32(rel))
-	} else {
-		newPC = pc + 3
+	for i := 0; i < len(instrs); i++ {
+	candidates:
+		for _, id := range fusion6502ByOpcode[instrs[i].opcode] {
+			p := &fusion6502Patterns[id]
+			if !p.jit || !p.matchInstrs(instrs, i) {
+				continue
+			}
+			n := len(p.steps)
+			for k := 1; k < n; k++ {
+				if branchTargets[i+k] {
+					continue candidates
+				}
+			}
+			instrs[i].idiom = uint8(id)
+			for k := 1; k < n; k++ {
+				instrs[i+k].fused |= p65FusedIdiomTail
+			}
+			i += n - 1
+			break
+		}
 	}
-	return
 }
 
-// fuse6502DeyBne is the DEY; BNE analog.
-func fuse6502DeyBne(y byte, sr byte, pc uint16, rel int8) (newY byte, newSR byte, newPC uint16) {
-	newY = y - 1
-	newSR = sr & ^byte(0x82)
-	if newY == 0 {
-		newSR |= 0x02
-	}
-	if newY&0x80 != 0 {
-		newSR |= 0x80
-	}
-	if newY != 0 {
-		newPC = uint16(int32(pc) + 3 + int32(rel))
-	} else {
-		newPC = pc + 3
-	}
-	return
+// j65FusionSite is the compile-loop state an idiom template reads and
+// advances. idx is the head instruction; the template accounts for all
+// of the idiom's instructions.
+type j65FusionSite struct {
+	cb            *CodeBuffer
+	instrs        []JIT6502Instr
+	idx           int
+	startPC       uint16
+	pendingCycles *uint32
+	bails         *[]bailInfo
+	invals        *[]invalInfo
+	nz            *j65NZState
+	live          []bool
+	opts          p65CompileOptions
 }
 
-// fuse6502InxBne is the INX; BNE analog.
-func fuse6502InxBne(x byte, sr byte, pc uint16, rel int8) (newX byte, newSR byte, newPC uint16) {
-	newX = x + 1
-	newSR = sr & ^byte(0x82)
-	if newX == 0 {
-		newSR |= 0x02
-	}
-	if newX&0x80 != 0 {
-		newSR |= 0x80
-	}
-	if newX != 0 {
-		newPC = uint16(int32(pc) + 3 + int32(rel))
-	} else {
-		newPC = pc + 3
+func (s *j65FusionSite) instrPC(k int) uint32 {
+	return uint32(s.startPC + s.instrs[s.idx+k].pcOffset)
+}
+
+// bailToHead records a bail that re-executes the whole idiom in the
+// interpreter.
+func (s *j65FusionSite) bailToHead(offsets ...int) {
+	*s.bails = append(*s.bails, bailInfo{offsets, s.instrPC(0), s.idx, *s.pendingCycles, s.nz.nzPending, s.nz.nzReg})
+}
+
+// cycles returns the base cycles of the idiom's n instructions.
+func (s *j65FusionSite) cycles(n int) uint32 {
+	var c uint32
+	for k := 0; k < n; k++ {
+		c += uint32(jit6502BaseCycles[s.instrs[s.idx+k].opcode])
 	}
-	return
+	return c
+}
+
+// emit6502FusedClcAdc compiles CLC; ADC #imm/zp as a single ADD: the
+// known-clear carry needs neither the CLC nor the BT that loads C.
+func emit6502FusedClcAdc(s *j65FusionSite) {
+	emit6502FusedCarrylessArith(s, 0x02, false) // ADD r/m8→r8
+}
+
+// emit6502FusedSecSbc compiles SEC; SBC #imm/zp as a single SUB.
+func emit6502FusedSecSbc(s *j65FusionSite) {
+	emit6502FusedCarrylessArith(s, 0x2A, true) // SUB r/m8→r8
 }
 
-// fuse6502LdaImmStaZp executes (LDA #imm; STA $zp). Writes the immediate
-// to zero-page memory[zp] and returns updated A + SR. Caller advances PC
-// by 4 bytes.
-func fuse6502LdaImmStaZp(memory []byte, sr byte, imm byte, zp byte) (newA byte, newSR byte) {
-	newA = imm
-	memory[zp] = imm
-	newSR = sr & ^byte(0x82)
-	if newA == 0 {
-		newSR |= 0x02
+func emit6502FusedCarrylessArith(s *j65FusionSite, aluOp byte, borrow bool) {
+	cb := s.cb
+	arith := &s.instrs[s.idx+1]
+	s.bailToHead(emit6502DecimalBailCheck(cb))
+	emit6502LoadOperandToEAX(cb, arith.opcode, arith.operand,
+		s.instrPC(0), s.idx, *s.pendingCycles, s.bails, false, s.nz.nzPending, s.nz.nzReg, s.opts)
+	cb.EmitBytes(aluOp, modRM(3, regBits(j65RegA), regBits(amd64RAX))) // ADD/SUB BL, AL
+	cb.EmitBytes(0x0F, 0x92, modRM(3, 0, amd64RCX))                    // SETC CL
+	cb.EmitBytes(0x0F, 0x90, modRM(3, 0, amd64RDX))                    // SETO DL
+	amd64MOVZX_B(cb, j65RegA, j65RegA)
+	emit6502MergeCV(cb, borrow)
+	j65MaybeSetNZPending(s.nz, j65RegA, s.live, s.idx+1)
+	*s.pendingCycles += s.cycles(2)
+}
+
+// emit6502FusedAdd16Zp compiles
+//
+//	CLC; LDA zp; ADC #lo; STA zp; LDA zp+1; ADC #hi; STA zp+1
+//
+// as a 16-bit load, ADD AX, imm16 and 16-bit store. The x86 CF/OF of the
+// word add are exactly the 6502 C/V of the high-byte ADC, and A ends up
+// holding the high byte.
+func emit6502FusedAdd16Zp(s *j65FusionSite) {
+	cb := s.cb
+	zp := byte(s.instrs[s.idx+1].operand)
+	lo := byte(s.instrs[s.idx+2].operand)
+	hi := byte(s.instrs[s.idx+5].operand)
+
+	s.bailToHead(emit6502DecimalBailCheck(cb))
+	if !s.opts.turboDirectMemory {
+		s.bailToHead(emit6502ZPPageCheck(cb, 0))
 	}
-	if newA&0x80 != 0 {
-		newSR |= 0x80
+
+	amd64MOVZX_W_mem(cb, amd64RAX, j65RegMem, int32(zp)) // EAX = word [zp]
+	cb.EmitBytes(0x66, 0x05, lo, hi)                     // ADD AX, imm16
+	cb.EmitBytes(0x0F, 0x92, modRM(3, 0, amd64RCX))      // SETC CL
+	cb.EmitBytes(0x0F, 0x90, modRM(3, 0, amd64RDX))      // SETO DL
+	cb.EmitBytes(0x66)                                   // MOV word [RSI+zp], AX
+	emitREX(cb, false, amd64RAX, j65RegMem)
+	cb.EmitBytes(0x89, modRM(2, regBits(amd64RAX), regBits(j65RegMem)))
+	cb.Emit32(uint32(zp))
+	amd64MOV_reg_reg32(cb, j65RegA, amd64RAX)
+	amd64SHR_imm32(cb, j65RegA, 8) // A = high byte (EAX bits 16-31 are clear)
+	emit6502MergeCV(cb, false)
+
+	// Both bytes are on page 0, so one self-modification check covers
+	// the word store.
+	emit6502AddrZP(cb, zp)
+	invalOff := emit6502SelfModCheck(cb)
+	for _, k := range []int{1, 2, 4, 5} { // LDA, ADC, LDA, ADC
+		j65MaybeSetNZPending(s.nz, j65RegA, s.live, s.idx+k)
 	}
-	return
+	cycles := s.cycles(7)
+	*s.invals = append(*s.invals, invalInfo{
+		offsets: []int{invalOff}, nextPC: s.instrPC(6) + 2, instrIdx: s.idx + 7,
+		pendingCycles: *s.pendingCycles + cycles, nzPending: s.nz.nzPending, nzReg: s.nz.nzReg,
+	})
+	*s.pendingCycles += cycles
 }
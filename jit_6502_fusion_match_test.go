@@ -100,3 +100,80 @@ func TestFuse6502LdaImmStaZp_StoresAndFlags(t *testing.T) {
 	}
 	_ = a
 }
+
+func TestP65MarkFusedIdioms_SkipsBranchTargets(t *testing.T) {
+	mem := make([]byte, 0x10000)
+	copy(mem[0x0600:], []byte{
+		0x18, 0x69, 0x01, // CLC; ADC #1          (fused)
+		0x38, 0xE9, 0x01, // SEC; SBC #1          (SBC is a branch target)
+		0xD0, 0xFD, // BNE $0604
+		0x00,
+	})
+	instrs := jit6502ScanBlock(mem, 0x0600, len(mem))
+	targets := make([]bool, len(instrs))
+	targets[3] = true
+	p65MarkFusedIdioms(instrs, targets)
+	if FusionID(instrs[0].idiom) != FusionClcAdcImm || instrs[1].fused&p65FusedIdiomTail == 0 {
+		t.Errorf("CLC; ADC not marked: idiom=%d tail=%v", instrs[0].idiom, instrs[1].fused)
+	}
+	if instrs[2].idiom != 0 || instrs[3].fused&p65FusedIdiomTail != 0 {
+		t.Errorf("SEC; SBC fused across a branch target")
+	}
+}
+
+// TestJIT6502Fusion_MatchesPerInstruction compiles each templated idiom
+// with and without fusion and compares the resulting machine state.
+func TestJIT6502Fusion_MatchesPerInstruction(t *testing.T) {
+	programs := map[string][]byte{
+		"ClcAdcImm": {0x18, 0x69, 0x7F, 0x00},
+		"ClcAdcZp":  {0x18, 0x65, 0x10, 0x00},
+		"SecSbcImm": {0x38, 0xE9, 0x81, 0x00},
+		"SecSbcZp":  {0x38, 0xE5, 0x11, 0x00},
+		"Add16Zp": {
+			0x18, 0xA5, 0x10, 0x69, 0xC0, 0x85, 0x10,
+			0xA5, 0x11, 0x69, 0x7F, 0x85, 0x11, 0x00,
+		},
+		// A consumer of N/Z after the idiom keeps NZ live.
+		"Add16ZpBmi": {
+			0x18, 0xA5, 0x10, 0x69, 0x40, 0x85, 0x10,
+			0xA5, 0x11, 0x69, 0x00, 0x85, 0x11,
+			0x30, 0x01, 0xE8, 0x00, // BMI +1; INX; BRK
+		},
+	}
+	type result struct {
+		a, x, sr  byte
+		lo, hi    byte
+		pc, count uint32
+		cycles    uint64
+	}
+	run := func(t *testing.T, program []byte, a, sr, lo, hi byte, fuse bool) result {
+		saved := jit6502FusionEnabled
+		jit6502FusionEnabled = fuse
+		defer func() { jit6502FusionEnabled = saved }()
+		rig := newJIT6502TestRig(t)
+		defer rig.cleanup()
+		rig.cpu.A, rig.cpu.SR, rig.cpu.PC = a, sr, 0x0600
+		rig.bus.Write8(0x10, lo)
+		rig.bus.Write8(0x11, hi)
+		rig.compileAndRun(t, program, 0x0600)
+		return result{rig.cpu.A, rig.cpu.X, rig.cpu.SR, rig.bus.Read8(0x10), rig.bus.Read8(0x11),
+			rig.ctx.RetPC, rig.ctx.RetCount, rig.ctx.RetCycles}
+	}
+	for name, program := range programs {
+		t.Run(name, func(t *testing.T) {
+			for _, v := range []struct{ a, sr, lo, hi byte }{
+				{0x00, 0x20, 0x00, 0x00},
+				{0x7F, 0x21, 0x40, 0x7F},
+				{0x80, 0xE3, 0xFF, 0xFF},
+				{0x3C, 0x60, 0x7F, 0x80},
+			} {
+				want := run(t, program, v.a, v.sr, v.lo, v.hi, false)
+				got := run(t, program, v.a, v.sr, v.lo, v.hi, true)
+				if got != want {
+					t.Errorf("A=%02X SR=%02X [10]=%02X [11]=%02X: fused %+v, per-instruction %+v",
+						v.a, v.sr, v.lo, v.hi, got, want)
+				}
+			}
+		})
+	}
+}
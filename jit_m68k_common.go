@@ -965,13 +965,14 @@ func m68kIsJITHelperSupportedFPU(opcode uint16) bool {
 	return !m68kGroupFTerminatesBlock(opcode)
 }
 
-// m68kFPUNativeOp identifies a register-to-register 68881 arithmetic operation
-// the JIT can emit natively in SSE2 scalar double. The FP register file is
-// stored as float64 (fpu_m68881.go), and Go's float64 arithmetic lowers to the
-// same SSE2 scalar-double instructions, so native emission is bit-identical to
-// the interpreter — provided FMA fusion is never used (it would change rounding).
-// Transcendentals, EA-operand forms, control/FMOVEM and non-general Line-F
-// instructions are excluded and stay on the FPU helper path.
+// m68kFPUNativeOp identifies a 68881 arithmetic operation the JIT can emit
+// natively in SSE2 scalar double. The FP register file is stored as float64
+// (fpu_m68881.go), and Go's float64 arithmetic lowers to the same SSE2
+// scalar-double instructions, so native emission is bit-identical to the
+// interpreter — provided FMA fusion is never used (it would change rounding).
+// The transcendentals FSIN/FCOS/FETOX/FLOGN are polynomial kernels modelled in
+// jit_m68k_fpu_transcendental.go. Extended/packed operands, control/FMOVEM and
+// non-general Line-F instructions are excluded and stay on the FPU helper path.
 type m68kFPUNativeOp uint8
 
 const (
@@ -988,6 +989,10 @@ const (
 	m68kFPUNativeFTST    // test source, no result store
 	m68kFPUNativeFSGLDIV // single-precision divide (operands rounded to float32 first)
 	m68kFPUNativeFSGLMUL // single-precision multiply
+	m68kFPUNativeFSIN    // transcendental kernels; inputs outside
+	m68kFPUNativeFCOS    // m68kFPUNativeDomains take the helper
+	m68kFPUNativeFETOX
+	m68kFPUNativeFLOGN
 )
 
 // m68kFPUConditionBits computes the FPSR condition-code bits (N/Z/I/NAN) for a
@@ -1037,8 +1042,14 @@ func m68kDecodeNativeFPURegToReg(opcode, cmdWord uint16) (op m68kFPUNativeOp, sr
 	}
 	src = int((cmdWord >> 10) & 0x7)
 	dst = int((cmdWord >> 7) & 0x7)
-	baseOp, prec := m68kFPUDecodePrecisionOpmode(cmdWord & 0x7F)
-	precision = prec
+	op, precision, ok = m68kDecodeNativeFPUOpmode(cmdWord & 0x7F)
+	return
+}
+
+// m68kDecodeNativeFPUOpmode maps a command-word opmode to its native op and
+// result precision.
+func m68kDecodeNativeFPUOpmode(opmode uint16) (op m68kFPUNativeOp, precision int, ok bool) {
+	baseOp, precision := m68kFPUDecodePrecisionOpmode(opmode)
 	switch baseOp {
 	case FPU_OP_FMOVE:
 		op = m68kFPUNativeFMOVE
@@ -1075,13 +1086,64 @@ func m68kDecodeNativeFPURegToReg(opcode, cmdWord uint16) (op m68kFPUNativeOp, sr
 		op = m68kFPUNativeFSGLDIV
 	case FPU_OP_FSGLMUL:
 		op = m68kFPUNativeFSGLMUL
+	case FPU_OP_FSIN:
+		op = m68kFPUNativeFSIN
+	case FPU_OP_FCOS:
+		op = m68kFPUNativeFCOS
+	case FPU_OP_FETOX:
+		op = m68kFPUNativeFETOX
+	case FPU_OP_FLOGN:
+		op = m68kFPUNativeFLOGN
 	default:
-		return // transcendental / unsupported reg-to-reg op → helper
+		return // other transcendental / unsupported op → helper
 	}
 	ok = true
 	return
 }
 
+// m68kFPUNativeEA is the source operand of an EA-sourced native FPU op.
+type m68kFPUNativeEA struct {
+	mode, reg uint16
+	format    uint16 // 0=L 1=S 4=W 5=D 6=B
+}
+
+// m68kDecodeNativeFPUEAToReg decodes a general FPU instruction whose source
+// is an effective address (R/M=1, dir=0) and reports whether the JIT can
+// emit it natively. It mirrors execFPUEAToReg: integer, single and double
+// operands from Dn (where the format fits), #imm, (An), (An)+, -(An),
+// (d16,An), absolute and (d16,PC). Extended and packed operands, FMOVECR and
+// indexed modes stay on the helper.
+func m68kDecodeNativeFPUEAToReg(opcode, cmdWord uint16) (op m68kFPUNativeOp, ea m68kFPUNativeEA, dst, precision int, ok bool) {
+	if (opcode>>6)&0x7 != 0 || cmdWord&0xE000 != 0x4000 {
+		return // not general, or not EA → FPn
+	}
+	if cmdWord&0xFC00 == 0x5C00 {
+		return // FMOVECR
+	}
+	ea = m68kFPUNativeEA{mode: (opcode >> 3) & 7, reg: opcode & 7, format: (cmdWord >> 10) & 7}
+	switch ea.format {
+	case 0, 1, 4, 6:
+	case 5:
+		if ea.mode == 0 {
+			return // a double does not fit in Dn
+		}
+	default:
+		return // extended, packed
+	}
+	switch ea.mode {
+	case 0, 2, 3, 4, 5:
+	case 7:
+		if ea.reg > 2 && ea.reg != 4 {
+			return
+		}
+	default:
+		return // An direct is illegal; indexed modes stay on the helper
+	}
+	dst = int((cmdWord >> 7) & 0x7)
+	op, precision, ok = m68kDecodeNativeFPUOpmode(cmdWord & 0x7F)
+	return
+}
+
 // m68kNeedsFallback returns true if the block's first instruction requires
 // the interpreter and can't be JIT-compiled.
 func m68kNeedsFallback(instrs []M68KJITInstr) bool {
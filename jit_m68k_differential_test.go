@@ -3208,6 +3208,10 @@ func TestM68KJIT_Differential_FPUHelperOpcodes(t *testing.T) {
 	if !m68kJitAvailable {
 		t.Skip("M68K JIT not available")
 	}
+	// Interpreter parity is bit-exact, so keep FSIN/FCOS/FETOX/FLOGN on the
+	// helper rather than the polynomial kernels.
+	defer func(exact bool) { m68kJITFPUExactTranscendentals = exact }(m68kJITFPUExactTranscendentals)
+	m68kJITFPUExactTranscendentals = true
 
 	for _, tc := range m68kFPUDiffCases() {
 		t.Run(tc.name, func(t *testing.T) {
@@ -5068,14 +5072,16 @@ func runM68KJITDifferentialFPUHelperSingle(t *testing.T, tc m68kFPUDiffCase) {
 	rig.ctx.NeedHelper = m68kJITHelperNone
 	rig.ctx.HelperPC = 0
 
-	// Register-to-register arithmetic ops are now emitted inline (native SSE2)
-	// rather than routed through the FPU helper. Detect that and assert the
-	// appropriate path: native ops update the FP state directly with no helper
-	// request; everything else still drives the helper.
+	// Register-to-register and EA-to-register arithmetic ops are now emitted
+	// inline (native SSE2) rather than routed through the FPU helper. Detect
+	// that and assert the appropriate path: native ops update the FP state
+	// directly with no helper request; everything else still drives the helper.
 	nativeEligible := false
 	if len(tc.words) >= 2 {
 		if op, _, _, _, ok := m68kDecodeNativeFPURegToReg(tc.words[0], tc.words[1]); ok {
 			nativeEligible = m68kFPUNativeOpEmittable(op)
+		} else if op, _, _, _, ok := m68kDecodeNativeFPUEAToReg(tc.words[0], tc.words[1]); ok {
+			nativeEligible = m68kFPUNativeOpEmittable(op)
 		}
 	}
 
@@ -12140,16 +12140,20 @@ func m68kEmitInstructionFull(cb *CodeBuffer, ji *M68KJITInstr, blockStartPC uint
 		m68kEmitEpilogue(cb, br)
 		return
 
-	case 0xF: // FPU: native reg-to-reg arithmetic, else helper, else interpreter.
+	case 0xF: // FPU: native reg-to-reg / EA-to-reg arithmetic, else helper, else interpreter.
 		instrPC := blockStartPC + ji.pcOffset
-		// Native path: register-to-register arithmetic emitted inline in SSE2.
-		// The command word is the second instruction word at instrPC+2.
+		// Native path: arithmetic emitted inline in SSE2. The command word is
+		// the second instruction word at instrPC+2.
 		if cmdAddr := int(instrPC) + 2; cmdAddr+1 < len(memory) {
 			cmdWord := uint16(memory[cmdAddr])<<8 | uint16(memory[cmdAddr+1])
 			if op, src, dst, precision, ok := m68kDecodeNativeFPURegToReg(opcode, cmdWord); ok {
 				if m68kEmitNativeFPUInstr(cb, op, src, dst, precision, instrPC, br, instrIdx) {
 					return
 				}
+			} else if op, ea, dst, precision, ok := m68kDecodeNativeFPUEAToReg(opcode, cmdWord); ok {
+				if m68kEmitNativeFPUEAInstr(cb, op, ea, dst, precision, memory, instrPC, br, instrIdx) {
+					return
+				}
 			}
 		}
 		if m68kIsJITHelperSupportedFPU(opcode) {
@@ -2,6 +2,8 @@
 
 package main
 
+import "math"
+
 // SSE2 scalar-double encoders for the native M68K FPU JIT path. The 68881 FP
 // register file is stored as float64 (fpu_m68881.go); these instructions are
 // exactly what Go's float64 arithmetic lowers to, so emitting them is
@@ -139,6 +141,32 @@ func amd64MOVQ_xmm_reg(cb *CodeBuffer, xmm, gpr byte) {
 	cb.EmitBytes(0x0F, 0x6E, modRM(3, xmm, gpr))
 }
 
+// amd64SSEsdCvt64 emits a scalar-double conversion with a 64-bit integer
+// operand (F2 REX.W 0F xx /r): CVTSI2SD xmm, r64 and CVT(T)SD2SI r64, xmm.
+func amd64SSEsdCvt64(cb *CodeBuffer, opcode, reg, rm byte) {
+	cb.EmitBytes(0xF2)
+	emitREX(cb, true, reg, rm)
+	cb.EmitBytes(0x0F, opcode, modRM(3, reg, rm))
+}
+
+// amd64CVTSI2SDQ_rr converts a signed 64-bit GPR to double (exact below 2^53).
+func amd64CVTSI2SDQ_rr(cb *CodeBuffer, xmm, gpr byte) { amd64SSEsdCvt64(cb, 0x2A, xmm, gpr) }
+
+// amd64CVTSD2SIQ_rr converts a double to int64 in the MXCSR rounding mode
+// (round-to-nearest-even under Go), i.e. int64(math.RoundToEven(x)).
+func amd64CVTSD2SIQ_rr(cb *CodeBuffer, gpr, xmm byte) { amd64SSEsdCvt64(cb, 0x2D, gpr, xmm) }
+
+// amd64CVTTSD2SIQ_rr converts a double to int64 truncating toward zero, as
+// Go's int64(x) / uint64(x) for x < 2^63.
+func amd64CVTTSD2SIQ_rr(cb *CodeBuffer, gpr, xmm byte) { amd64SSEsdCvt64(cb, 0x2C, gpr, xmm) }
+
+// amd64BSWAP64 byte-swaps a full 64-bit register (REX.W 0F C8+r). Loads a
+// big-endian double from guest memory.
+func amd64BSWAP64(cb *CodeBuffer, reg byte) {
+	emitREX(cb, true, 0, reg)
+	cb.EmitBytes(0x0F, 0xC8+regBits(reg))
+}
+
 // amd64SSEpd_rr emits a packed-double SSE op (66 0F xx /r). Used for ANDPD/XORPD
 // against a sign-bit mask to implement FABS/FNEG.
 func amd64SSEpd_rr(cb *CodeBuffer, opcode, dst, src byte) {
@@ -240,9 +268,11 @@ func m68kEmitNativeFPURegToReg(cb *CodeBuffer, op m68kFPUNativeOp, src, dst, pre
 }
 
 // m68kFPUNativeOpEmittable reports whether the native FPU emitter implements op.
-// Covers all SSE2-cleanly-mappable register-to-register ops; transcendentals,
-// FINT/FINTRZ (need SSE4.1 roundsd / rounding-mode state), FMOD/FREM,
-// FGETEXP/FGETMAN/FSCALE and EA-operand forms remain on the FPU helper.
+// Covers all SSE2-cleanly-mappable ops plus FSIN/FCOS/FETOX/FLOGN, whose
+// polynomial kernels (jit_m68k_fpu_transcendental.go) are used unless
+// m68kJITFPUExactTranscendentals is set. The remaining transcendentals,
+// FINT/FINTRZ (need SSE4.1 roundsd / rounding-mode state), FMOD/FREM and
+// FGETEXP/FGETMAN/FSCALE remain on the FPU helper.
 func m68kFPUNativeOpEmittable(op m68kFPUNativeOp) bool {
 	switch op {
 	case m68kFPUNativeFMOVE, m68kFPUNativeFADD, m68kFPUNativeFSUB,
@@ -250,6 +280,8 @@ func m68kFPUNativeOpEmittable(op m68kFPUNativeOp) bool {
 		m68kFPUNativeFABS, m68kFPUNativeFNEG, m68kFPUNativeFSGLDIV,
 		m68kFPUNativeFSGLMUL, m68kFPUNativeFCMP, m68kFPUNativeFTST:
 		return true
+	case m68kFPUNativeFSIN, m68kFPUNativeFCOS, m68kFPUNativeFETOX, m68kFPUNativeFLOGN:
+		return !m68kJITFPUExactTranscendentals
 	default:
 		return false
 	}
@@ -339,16 +371,48 @@ func m68kEmitNativeFPUInstr(cb *CodeBuffer, op m68kFPUNativeOp, src, dst, precis
 	// this instruction (m68kInstrNeedsCCRMaterialization returns true for group
 	// 0xF), so the host EFLAGS are free to clobber here: a following Bcc reads
 	// the materialized CCR from R14, not the flags the code below leaves behind.
+	m68kEmitNativeFPUGuard(cb, instrPC, br, instrIdx)
+
+	var helperBails []int
+	if _, ok := m68kFPUNativeDomains[op]; ok {
+		amd64MOV_reg_mem(cb, amd64RCX, fpuBaseGPR, int32(src*8))
+		m68kEmitNativeFPUDomainCheck(cb, op, amd64RCX, &helperBails)
+	}
+	m68kEmitNativeFPUOp(cb, op, src, dst, precision, instrPC)
+	m68kEmitNativeFPUHelperBails(cb, helperBails, instrPC, br, instrIdx)
+	return true
+}
 
-	// FPU-presence guard. The FP register pointer is zero when cpu.FPU == nil;
-	// in that case bail to the helper (which raises Line-F) instead of
-	// dereferencing a null pointer.
+// m68kEmitNativeFPUGuard emits the FPU-presence guard and leaves fpuBaseGPR
+// = &fp[0]. The FP register pointer is zero when cpu.FPU == nil; in that case
+// bail to the helper (which raises Line-F) instead of dereferencing a null
+// pointer.
+func m68kEmitNativeFPUGuard(cb *CodeBuffer, instrPC uint32, br *m68kBlockRegs, instrIdx int) {
 	amd64MOV_reg_mem(cb, fpuBaseGPR, m68kAMD64RegCtx, int32(m68kCtxOffFPRegsPtr))
 	amd64TEST_reg_reg(cb, fpuBaseGPR, fpuBaseGPR)
 	jnzNative := amd64Jcc_rel32(cb, amd64CondNE)
 	m68kEmitHelperAtInstr(cb, instrPC, br, instrIdx, m68kJITHelperFPU)
 	patchRel32(cb, jnzNative, cb.Len())
+}
+
+// m68kEmitNativeFPUHelperBails emits the out-of-line helper exit that the
+// given jumps (operands outside a kernel's domain) land on. The helper
+// re-executes the whole instruction, so nothing may be committed before them.
+func m68kEmitNativeFPUHelperBails(cb *CodeBuffer, bails []int, instrPC uint32, br *m68kBlockRegs, instrIdx int) {
+	if len(bails) == 0 {
+		return
+	}
+	done := amd64JMP_rel32(cb)
+	for _, j := range bails {
+		patchRel32(cb, j, cb.Len())
+	}
+	m68kEmitHelperAtInstr(cb, instrPC, br, instrIdx, m68kJITHelperFPU)
+	patchRel32(cb, done, cb.Len())
+}
 
+// m68kEmitNativeFPUOp emits the body of a native FPU data operation with
+// fpuBaseGPR = &fp[0]: FPIAR, the arithmetic and the condition codes.
+func m68kEmitNativeFPUOp(cb *CodeBuffer, op m68kFPUNativeOp, src, dst, precision int, instrPC uint32) {
 	// FPIAR = instruction address (data operations only; all native ops have
 	// cmdWord bit 15 == 0). Mirrors ExecFPUInstruction.
 	amd64MOV_reg_mem(cb, amd64RCX, m68kAMD64RegCtx, int32(m68kCtxOffFPIARPtr))
@@ -361,13 +425,200 @@ func m68kEmitNativeFPUInstr(cb *CodeBuffer, op m68kFPUNativeOp, src, dst, precis
 		// FTST sets CC from the source operand; no result is stored.
 		amd64MOVSD_load(cb, fpuWorkXMM, fpuBaseGPR, int32(src*8))
 		m68kEmitNativeFPUSetCC(cb)
+	case m68kFPUNativeFSIN, m68kFPUNativeFCOS, m68kFPUNativeFETOX, m68kFPUNativeFLOGN:
+		m68kEmitNativeFPUTranscendental(cb, op, src, dst, precision)
+		m68kEmitNativeFPUSetCC(cb)
 	default:
 		m68kEmitNativeFPURegToReg(cb, op, src, dst, precision)
 		m68kEmitNativeFPUSetCC(cb)
 	}
+}
+
+// fpuSrcXMM receives an EA-sourced operand; fpuSaveXMM preserves the FP
+// register the operand is staged through. The transcendental kernels leave
+// both alone.
+const (
+	fpuSrcXMM  = 2
+	fpuSaveXMM = 3
+)
+
+// m68kEmitNativeFPUEAInstr emits an EA-sourced FPU data operation
+// (execFPUEAToReg → applyFPUEAValue). The operand is converted to float64 in
+// fpuSrcXMM; FMOVE stores it directly, every other op stages it through the
+// interpreter's scratch register (FP7, or FP6 when the destination is FP7),
+// runs the register-to-register body, and restores the scratch. Reads that
+// miss RAM leave the block for the interpreter with An untouched; (An)+ and
+// -(An) are committed only once nothing can bail. Returns false, having
+// emitted nothing, if op has no native form or the operand runs past memory.
+func m68kEmitNativeFPUEAInstr(cb *CodeBuffer, op m68kFPUNativeOp, ea m68kFPUNativeEA, dst, precision int,
+	memory []byte, instrPC uint32, br *m68kBlockRegs, instrIdx int) bool {
+	if !m68kFPUNativeOpEmittable(op) {
+		return false
+	}
+	extPC := instrPC + 4
+	if extPC+m68kNativeFPUEAExtBytes(ea) > uint32(len(memory)) {
+		return false
+	}
+	m68kEmitNativeFPUGuard(cb, instrPC, br, instrIdx)
+	m68kEmitNativeFPULoadEA(cb, ea, memory, instrPC, br, instrIdx)
+
+	var helperBails []int
+	if _, ok := m68kFPUNativeDomains[op]; ok {
+		amd64MOVQ_reg_xmm(cb, amd64RCX, fpuSrcXMM)
+		m68kEmitNativeFPUDomainCheck(cb, op, amd64RCX, &helperBails)
+	}
+
+	step, _ := m68kFPUAddressStepBytes(ea.format, ea.reg)
+	switch ea.mode {
+	case 3: // (An)+
+		amd64ALU_reg_imm32_32bit(cb, 0, amd64R10, int32(step))
+		m68kStoreAddrReg(cb, ea.reg, amd64R10)
+	case 4: // -(An): R10 already holds An - step
+		m68kStoreAddrReg(cb, ea.reg, amd64R10)
+	}
+
+	amd64MOV_reg_mem(cb, fpuBaseGPR, m68kAMD64RegCtx, int32(m68kCtxOffFPRegsPtr))
+	if op == m68kFPUNativeFMOVE {
+		amd64MOV_reg_mem(cb, amd64RCX, m68kAMD64RegCtx, int32(m68kCtxOffFPIARPtr))
+		amd64MOV_mem_imm32(cb, amd64RCX, 0, instrPC)
+		amd64MOVSD_rr(cb, fpuWorkXMM, fpuSrcXMM)
+		if precision == m68kFPURoundSingle {
+			amd64CVTSD2SS_rr(cb, fpuWorkXMM, fpuWorkXMM)
+			amd64CVTSS2SD_rr(cb, fpuWorkXMM, fpuWorkXMM)
+		}
+		amd64MOVSD_store(cb, fpuBaseGPR, int32(dst*8), fpuWorkXMM)
+		m68kEmitNativeFPUSetCC(cb)
+	} else {
+		scratch := 7
+		if dst == 7 {
+			scratch = 6
+		}
+		amd64MOVSD_load(cb, fpuSaveXMM, fpuBaseGPR, int32(scratch*8))
+		amd64MOVSD_store(cb, fpuBaseGPR, int32(scratch*8), fpuSrcXMM)
+		m68kEmitNativeFPUOp(cb, op, scratch, dst, precision, instrPC)
+		amd64MOV_reg_mem(cb, fpuBaseGPR, m68kAMD64RegCtx, int32(m68kCtxOffFPRegsPtr))
+		amd64MOVSD_store(cb, fpuBaseGPR, int32(scratch*8), fpuSaveXMM)
+	}
+	m68kEmitNativeFPUHelperBails(cb, helperBails, instrPC, br, instrIdx)
 	return true
 }
 
+// m68kNativeFPUEAExtBytes returns the extension bytes an EA operand occupies
+// after the command word.
+func m68kNativeFPUEAExtBytes(ea m68kFPUNativeEA) uint32 {
+	switch {
+	case ea.mode == 5, ea.mode == 7 && (ea.reg == 0 || ea.reg == 2):
+		return 2
+	case ea.mode == 7 && ea.reg == 1:
+		return 4
+	case ea.mode == 7 && ea.reg == 4:
+		n, _ := m68kFPUOperandFormatBytes(ea.format)
+		return max(n, 2) // a byte immediate occupies a whole word
+	}
+	return 0
+}
+
+// m68kEmitNativeFPULoadEA converts the operand to float64 in fpuSrcXMM,
+// exactly as execFPUEAToReg does. Memory operands leave their address in R10.
+func m68kEmitNativeFPULoadEA(cb *CodeBuffer, ea m68kFPUNativeEA, memory []byte, instrPC uint32, br *m68kBlockRegs, instrIdx int) {
+	extPC := instrPC + 4
+	switch {
+	case ea.mode == 0: // Dn
+		r := m68kResolveDataReg(cb, ea.reg, amd64RCX)
+		m68kEmitNativeFPUConvert(cb, ea.format, r)
+		return
+	case ea.mode == 7 && ea.reg == 4: // #imm, converted at compile time
+		var raw uint64
+		for i := uint32(0); i < m68kNativeFPUEAExtBytes(ea); i++ {
+			raw = raw<<8 | uint64(memory[extPC+i])
+		}
+		var value float64
+		switch ea.format {
+		case 0:
+			value = float64(int32(raw))
+		case 1:
+			value = float64(math.Float32frombits(uint32(raw)))
+		case 4:
+			value = float64(int16(raw))
+		case 5:
+			value = math.Float64frombits(raw)
+		case 6:
+			value = float64(int8(raw))
+		}
+		amd64MOV_reg_imm64(cb, amd64RCX, math.Float64bits(value))
+		amd64MOVQ_xmm_reg(cb, fpuSrcXMM, amd64RCX)
+		return
+	}
+
+	switch ea.mode {
+	case 2, 3:
+		r := m68kResolveAddrReg(cb, ea.reg, amd64R10)
+		if r != amd64R10 {
+			amd64MOV_reg_reg32(cb, amd64R10, r)
+		}
+	case 4:
+		step, _ := m68kFPUAddressStepBytes(ea.format, ea.reg)
+		r := m68kResolveAddrReg(cb, ea.reg, amd64R10)
+		if r != amd64R10 {
+			amd64MOV_reg_reg32(cb, amd64R10, r)
+		}
+		amd64ALU_reg_imm32_32bit(cb, 5, amd64R10, int32(step))
+	default: // (d16,An), (xxx).W, (xxx).L, (d16,PC)
+		m68kEmitComputeEAAddr(cb, ea.mode, ea.reg, memory, extPC, instrPC, amd64R10)
+	}
+
+	switch ea.format {
+	case 4:
+		m68kEmitMemRead(cb, amd64R10, amd64RCX, M68K_SIZE_WORD, nil)
+	case 5:
+		m68kEmitNativeFPUReadDouble(cb, amd64R10, amd64RCX)
+	case 6:
+		m68kEmitMemRead(cb, amd64R10, amd64RCX, M68K_SIZE_BYTE, nil)
+	default:
+		m68kEmitMemRead(cb, amd64R10, amd64RCX, M68K_SIZE_LONG, nil)
+	}
+	m68kEmitExitIfIOFallback(cb, instrPC, uint32(instrIdx), br)
+	m68kEmitNativeFPUConvert(cb, ea.format, amd64RCX)
+}
+
+// m68kEmitNativeFPUConvert converts the raw operand in gpr (low bits per
+// format) to float64 in fpuSrcXMM. Clobbers RCX.
+func m68kEmitNativeFPUConvert(cb *CodeBuffer, format uint16, gpr byte) {
+	switch format {
+	case 0: // Long: float64(int32)
+		amd64MOVSXD(cb, amd64RCX, gpr)
+		amd64CVTSI2SDQ_rr(cb, fpuSrcXMM, amd64RCX)
+	case 1: // Single: float64(float32frombits)
+		amd64MOVD_xmm_reg(cb, fpuSrcXMM, gpr)
+		amd64CVTSS2SD_rr(cb, fpuSrcXMM, fpuSrcXMM)
+	case 4: // Word: float64(int16)
+		amd64MOVSX_W(cb, amd64RCX, gpr)
+		amd64CVTSI2SDQ_rr(cb, fpuSrcXMM, amd64RCX)
+	case 5: // Double: raw bits
+		amd64MOVQ_xmm_reg(cb, fpuSrcXMM, gpr)
+	case 6: // Byte: float64(int8)
+		amd64MOVSX_B(cb, amd64RCX, gpr)
+		amd64CVTSI2SDQ_rr(cb, fpuSrcXMM, amd64RCX)
+	}
+}
+
+// m68kEmitNativeFPUReadDouble loads the big-endian double at [addrReg] into
+// dstReg, with m68kEmitMemRead's bail contract: an out-of-range or I/O
+// access sets NeedIOFallback instead. Preserves R10.
+func m68kEmitNativeFPUReadDouble(cb *CodeBuffer, addrReg, dstReg byte) {
+	bailSites := make([]int, 0, 4)
+	amd64MOV_reg_imm32(cb, amd64RDX, 8)
+	m68kEmitMemRangeBailChecks(cb, addrReg, amd64RDX, &bailSites)
+	emitMemOpSIB(cb, true, 0x8B, dstReg, m68kAMD64RegMemBase, addrReg, 0) // MOV dst, [RSI+addr]
+	amd64BSWAP64(cb, dstReg)
+	doneOff := amd64JMP_rel32(cb)
+	for _, off := range bailSites {
+		patchRel32(cb, off, cb.Len())
+	}
+	amd64MOV_mem_imm32(cb, m68kAMD64RegCtx, int32(m68kCtxOffNeedIOFallback), 1)
+	patchRel32(cb, doneOff, cb.Len())
+}
+
 // m68kEmitNativeFCMP emits FCMP FPsrc,FPdst: compare fp[dst] against fp[src] and
 // set the FPSR condition codes — NAN if either operand is NaN, Z if equal, N if
 // dst < src; nothing is stored. This mirrors (*M68881FPU).FCMP, which differs
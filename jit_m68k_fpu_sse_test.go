@@ -136,3 +136,25 @@ func TestAMD64_UCOMISD(t *testing.T) {
 		t.Errorf("ucomisd: got % X, want % X", got, want)
 	}
 }
+
+func TestAMD64_SSEcvt64AndBSWAP64(t *testing.T) {
+	cases := []struct {
+		name string
+		emit func(cb *CodeBuffer)
+		want []byte
+	}{
+		// cvtsi2sd xmm, r64 / cvt(t)sd2si r64, xmm: F2 REX.W 0F 2A/2D/2C /r
+		{"cvtsi2sd xmm2,rcx", func(cb *CodeBuffer) { amd64CVTSI2SDQ_rr(cb, 2, amd64RCX) }, []byte{0xF2, 0x48, 0x0F, 0x2A, 0xD1}},
+		{"cvtsi2sd xmm9,r11", func(cb *CodeBuffer) { amd64CVTSI2SDQ_rr(cb, 9, amd64R11) }, []byte{0xF2, 0x4D, 0x0F, 0x2A, 0xCB}},
+		{"cvtsd2si rcx,xmm1", func(cb *CodeBuffer) { amd64CVTSD2SIQ_rr(cb, amd64RCX, 1) }, []byte{0xF2, 0x48, 0x0F, 0x2D, 0xC9}},
+		{"cvttsd2si rcx,xmm1", func(cb *CodeBuffer) { amd64CVTTSD2SIQ_rr(cb, amd64RCX, 1) }, []byte{0xF2, 0x48, 0x0F, 0x2C, 0xC9}},
+		// bswap r64: REX.W 0F C8+r
+		{"bswap rcx", func(cb *CodeBuffer) { amd64BSWAP64(cb, amd64RCX) }, []byte{0x48, 0x0F, 0xC9}},
+		{"bswap r10", func(cb *CodeBuffer) { amd64BSWAP64(cb, amd64R10) }, []byte{0x49, 0x0F, 0xCA}},
+	}
+	for _, c := range cases {
+		if got := emitToBytes(c.emit); !bytes.Equal(got, c.want) {
+			t.Errorf("%s: got % X, want % X", c.name, got, c.want)
+		}
+	}
+}
@@ -0,0 +1,195 @@
+// jit_m68k_fpu_transcendental.go - Reference models of the M68K JIT's native
+// FSIN/FCOS/FETOX/FLOGN kernels.
+//
+// The interpreter computes the 68881 transcendentals with math.Sin/Cos/Exp/Log
+// (fpu_m68881.go), which the JIT can only reach by leaving the block through
+// the FPU helper. The native kernels (jit_m68k_fpu_transcendental_amd64.go)
+// instead evaluate table-free fdlibm/Cephes polynomials inline in SSE2. Each
+// function here is the exact operation sequence the emitted code performs —
+// one IEEE rounding per Go operation, with products wrapped in float64() so
+// the compiler never fuses them into FMA — so JIT output can be checked bit
+// for bit against the model, and the model against package math.
+//
+// Against package math on amd64 over each kernel's domain (randomized sweeps,
+// TestM68KFastTranscendentals_Accuracy):
+//
+//	FSIN, FCOS   Cephes sin/cos, as math/sin.go     bit-identical, tested to 1 ulp
+//	FLOGN        fdlibm log, as math/log.go         bit-identical, tested to 1 ulp
+//	FETOX        fdlibm exp (math.Exp is Shibata)   within 2 ulp
+//
+// Inputs outside a kernel's domain (NaN, infinities, |x| ≥ 2^29 for sin/cos,
+// |x| > 708 for exp, zero/negative/denormal for log) take the FPU helper, so
+// special cases stay exactly the interpreter's.
+
+package main
+
+import "math"
+
+// m68kJITFPUExactTranscendentals keeps FSIN/FCOS/FETOX/FLOGN on the FPU
+// helper, making JIT results bit-identical to the interpreter. Default
+// false; parity tests that compare transcendental results exactly set it.
+var m68kJITFPUExactTranscendentals = false
+
+// m68kFPUNativeDomain is the range of raw (or, with abs, sign-cleared)
+// float64 bit patterns [lo, hi) a native kernel accepts.
+type m68kFPUNativeDomain struct {
+	abs    bool
+	lo, hi uint64
+}
+
+var m68kFPUNativeDomains = map[m68kFPUNativeOp]m68kFPUNativeDomain{
+	m68kFPUNativeFSIN:  {abs: true, lo: 0, hi: 0x41C0000000000000}, // |x| < 2^29
+	m68kFPUNativeFCOS:  {abs: true, lo: 0, hi: 0x41C0000000000000}, // |x| < 2^29
+	m68kFPUNativeFETOX: {abs: true, lo: 0, hi: 0x4086200000000001}, // |x| ≤ 708
+	m68kFPUNativeFLOGN: {lo: 0x0010000000000000, hi: 0x7FF0000000000000},
+}
+
+// m68kFPUNativeInDomain reports whether the native kernel for op handles x.
+func m68kFPUNativeInDomain(op m68kFPUNativeOp, x float64) bool {
+	d, ok := m68kFPUNativeDomains[op]
+	if !ok {
+		return false
+	}
+	b := math.Float64bits(x)
+	if d.abs {
+		b &^= 1 << 63
+	}
+	return b-d.lo < d.hi-d.lo
+}
+
+const (
+	m68kFastLn2Hi = 6.93147180369123816490e-01 // 3fe62e42 fee00000
+	m68kFastLn2Lo = 1.90821492927058770002e-10 // 3dea39ef 35793c76
+	m68kFastLog2e = 1.44269504088896338700e+00
+
+	// fdlibm exp remainder polynomial.
+	m68kFastExpP1 = 1.66666666666666657415e-01
+	m68kFastExpP2 = -2.77777777770155933842e-03
+	m68kFastExpP3 = 6.61375632143793436117e-05
+	m68kFastExpP4 = -1.65339022054652515390e-06
+	m68kFastExpP5 = 4.13813679705723846039e-08
+
+	// fdlibm log polynomial in s^2.
+	m68kFastLogL1 = 6.666666666666735130e-01
+	m68kFastLogL2 = 3.999999999940941908e-01
+	m68kFastLogL3 = 2.857142874366239149e-01
+	m68kFastLogL4 = 2.222219843214978396e-01
+	m68kFastLogL5 = 1.818357216161805012e-01
+	m68kFastLogL6 = 1.531383769920937332e-01
+	m68kFastLogL7 = 1.479819860511658591e-01
+
+	// Pi/4 in three parts for Cody-Waite reduction.
+	m68kFastPi4A       = 7.85398125648498535156e-1
+	m68kFastPi4B       = 3.77489470793079817668e-8
+	m68kFastPi4C       = 2.69515142907905952645e-15
+	m68kFastFourOverPi = 4 / math.Pi
+)
+
+// Cephes sin/cos coefficients, highest order first.
+var (
+	m68kFastSinCoeffs = [...]float64{
+		1.58962301576546568060e-10,
+		-2.50507477628578072866e-8,
+		2.75573136213857245213e-6,
+		-1.98412698295895385996e-4,
+		8.33333333332211858878e-3,
+		-1.66666666666666307295e-1,
+	}
+	m68kFastCosCoeffs = [...]float64{
+		-1.13585365213876817300e-11,
+		2.08757008419747316778e-9,
+		-2.75573141792967388112e-7,
+		2.48015872888517045348e-5,
+		-1.38888888888730564116e-3,
+		4.16666666666665929218e-2,
+	}
+)
+
+// m68kFastExp models the FETOX kernel: k = round(x·log2e), r = x - k·ln2 in
+// two parts, e^r from fdlibm's rational form, scaled by an exact 2^k.
+func m68kFastExp(x float64) float64 {
+	ki := int64(math.RoundToEven(float64(x * m68kFastLog2e)))
+	k := float64(ki)
+	hi := x - float64(k*m68kFastLn2Hi)
+	lo := float64(k * m68kFastLn2Lo)
+	r := hi - lo
+	t := float64(r * r)
+	p := float64(t * m68kFastExpP5)
+	p = float64(t * (p + m68kFastExpP4))
+	p = float64(t * (p + m68kFastExpP3))
+	p = float64(t * (p + m68kFastExpP2))
+	p = float64(t * (p + m68kFastExpP1))
+	c := r - p
+	y := 1 - ((lo - float64(r*c)/(2-c)) - hi)
+	return y * math.Float64frombits(uint64(ki+1023)<<52)
+}
+
+// m68kFastLog models the FLOGN kernel (x positive and normal): x = 2^k·m
+// with m in [√½, √2), then fdlibm's log1p(m-1) polynomial.
+func m68kFastLog(x float64) float64 {
+	bits := math.Float64bits(x)
+	ki := int64(bits>>52) - 1023
+	m := bits&(1<<52-1) | 0x3FF0000000000000
+	if m >= math.Float64bits(math.Sqrt2) {
+		m -= 1 << 52
+		ki++
+	}
+	f := math.Float64frombits(m) - 1
+	k := float64(ki)
+	s := f / (2 + f)
+	s2 := float64(s * s)
+	s4 := float64(s2 * s2)
+	t1 := float64(s4 * m68kFastLogL7)
+	t1 = float64(s4 * (t1 + m68kFastLogL5))
+	t1 = float64(s4 * (t1 + m68kFastLogL3))
+	t1 = float64(s2 * (t1 + m68kFastLogL1))
+	t2 := float64(s4 * m68kFastLogL6)
+	t2 = float64(s4 * (t2 + m68kFastLogL4))
+	t2 = float64(s4 * (t2 + m68kFastLogL2))
+	R := t1 + t2
+	hfsq := float64(float64(0.5*f) * f)
+	return float64(k*m68kFastLn2Hi) - ((hfsq - (float64(s*(hfsq+R)) + float64(k*m68kFastLn2Lo))) - f)
+}
+
+// m68kFastSinCos models the FSIN (cos false) and FCOS kernels for |x| < 2^29:
+// reduce to an even octant of π/4, pick the sine or cosine polynomial by
+// quadrant, and set the sign from the quadrant (and, for sine, x).
+func m68kFastSinCos(x float64, cos bool) float64 {
+	bits := math.Float64bits(x)
+	var sign uint64
+	if !cos {
+		sign = bits >> 63
+	}
+	x = math.Float64frombits(bits &^ (1 << 63))
+
+	j := uint64(float64(x * m68kFastFourOverPi))
+	j += j & 1
+	y := float64(j)
+	q := j >> 1
+	if cos {
+		q++
+	}
+	z := ((x - float64(y*m68kFastPi4A)) - float64(y*m68kFastPi4B)) - float64(y*m68kFastPi4C)
+	zz := float64(z * z)
+
+	var r float64
+	if q&1 == 0 {
+		p := float64(m68kFastSinCoeffs[0] * zz)
+		for _, c := range m68kFastSinCoeffs[1:5] {
+			p = float64((p + c) * zz)
+		}
+		p += m68kFastSinCoeffs[5]
+		r = z + float64(float64(z*zz)*p)
+	} else {
+		p := float64(m68kFastCosCoeffs[0] * zz)
+		for _, c := range m68kFastCosCoeffs[1:5] {
+			p = float64((p + c) * zz)
+		}
+		p += m68kFastCosCoeffs[5]
+		r = (1.0 - float64(0.5*zz)) + float64(float64(zz*zz)*p)
+	}
+	if ((q>>1)&1)^sign != 0 {
+		r = -r
+	}
+	return r
+}
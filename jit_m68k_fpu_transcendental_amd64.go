@@ -0,0 +1,270 @@
+//go:build amd64 && (linux || windows || darwin)
+
+package main
+
+import "math"
+
+// SSE2 kernels for the native FSIN/FCOS/FETOX/FLOGN path. Each is the
+// instruction-for-instruction lowering of its model in
+// jit_m68k_fpu_transcendental.go: the input arrives in fpuWorkXMM, the result
+// is left there, and constants are materialized through R11 into xmm6. The
+// kernels use xmm0-2 and xmm4-7 and RCX/RDX/R10/R11, leaving fpuSaveXMM and
+// fpuBaseGPR intact.
+
+const fpuConstXMM = 6
+
+// m68kEmitFPUConst loads the float64 constant v into xmm.
+func m68kEmitFPUConst(cb *CodeBuffer, xmm byte, v float64) {
+	amd64MOV_reg_imm64(cb, amd64R11, math.Float64bits(v))
+	amd64MOVQ_xmm_reg(cb, xmm, amd64R11)
+}
+
+// m68kEmitFPUConstOp emits <op> xmm, v for a scalar-double opcode.
+func m68kEmitFPUConstOp(cb *CodeBuffer, opcode, xmm byte, v float64) {
+	m68kEmitFPUConst(cb, fpuConstXMM, v)
+	amd64SSEsd_rr(cb, opcode, xmm, fpuConstXMM)
+}
+
+// m68kEmitNativeFPUDomainCheck emits the range test on the operand bits in
+// bitsReg and appends a jump to bails taken when the kernel for op does not
+// cover the operand. Clobbers RDX and R11.
+func m68kEmitNativeFPUDomainCheck(cb *CodeBuffer, op m68kFPUNativeOp, bitsReg byte, bails *[]int) {
+	d := m68kFPUNativeDomains[op]
+	amd64MOV_reg_reg(cb, amd64RDX, bitsReg)
+	if d.abs {
+		amd64SHL_imm(cb, amd64RDX, 1)
+		amd64SHR_imm(cb, amd64RDX, 1)
+	}
+	if d.lo != 0 {
+		amd64MOV_reg_imm64(cb, amd64R11, d.lo)
+		amd64ALU_reg_reg(cb, 0x29, amd64RDX, amd64R11) // SUB
+	}
+	amd64MOV_reg_imm64(cb, amd64R11, d.hi-d.lo)
+	amd64ALU_reg_reg(cb, 0x39, amd64RDX, amd64R11) // CMP
+	*bails = append(*bails, amd64Jcc_rel32(cb, amd64CondAE))
+}
+
+// m68kEmitNativeFPUTranscendental emits fp[dst] = f(fp[src]) for an operand
+// already known to be inside the kernel's domain, rounding single-precision
+// opmodes through float32. Expects fpuBaseGPR = &fp[0]; the result stays in
+// fpuWorkXMM for the condition codes.
+func m68kEmitNativeFPUTranscendental(cb *CodeBuffer, op m68kFPUNativeOp, src, dst, precision int) {
+	amd64MOVSD_load(cb, fpuWorkXMM, fpuBaseGPR, int32(src*8))
+	switch op {
+	case m68kFPUNativeFSIN:
+		m68kEmitFastSinCos(cb, false)
+	case m68kFPUNativeFCOS:
+		m68kEmitFastSinCos(cb, true)
+	case m68kFPUNativeFETOX:
+		m68kEmitFastExp(cb)
+	case m68kFPUNativeFLOGN:
+		m68kEmitFastLog(cb)
+	}
+	if precision == m68kFPURoundSingle {
+		amd64CVTSD2SS_rr(cb, fpuWorkXMM, fpuWorkXMM)
+		amd64CVTSS2SD_rr(cb, fpuWorkXMM, fpuWorkXMM)
+	}
+	amd64MOVSD_store(cb, fpuBaseGPR, int32(dst*8), fpuWorkXMM)
+}
+
+// m68kEmitFastExp lowers m68kFastExp.
+func m68kEmitFastExp(cb *CodeBuffer) {
+	const x, k, t, hi, lo, r = 0, 1, 2, 4, 5, 7
+
+	amd64MOVSD_rr(cb, k, x)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, k, m68kFastLog2e)
+	amd64CVTSD2SIQ_rr(cb, amd64RCX, k) // ki
+	amd64CVTSI2SDQ_rr(cb, k, amd64RCX)
+
+	amd64MOVSD_rr(cb, t, k)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, t, m68kFastLn2Hi)
+	amd64MOVSD_rr(cb, hi, x)
+	amd64SUBSD_rr(cb, hi, t)
+	amd64MOVSD_rr(cb, lo, k)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, lo, m68kFastLn2Lo)
+	amd64MOVSD_rr(cb, r, hi)
+	amd64SUBSD_rr(cb, r, lo)
+
+	// p in xmm1 (k is dead), t = r*r in xmm2.
+	const p, c = 1, 2
+	amd64MOVSD_rr(cb, t, r)
+	amd64MULSD_rr(cb, t, r)
+	m68kEmitFPUConst(cb, p, m68kFastExpP5)
+	amd64MULSD_rr(cb, p, t)
+	for _, coef := range []float64{m68kFastExpP4, m68kFastExpP3, m68kFastExpP2, m68kFastExpP1} {
+		m68kEmitFPUConstOp(cb, sseOpADDSD, p, coef)
+		amd64MULSD_rr(cb, p, t)
+	}
+	amd64MOVSD_rr(cb, c, r)
+	amd64SUBSD_rr(cb, c, p)
+
+	// y = 1 - ((lo - r*c/(2-c)) - hi)
+	amd64MOVSD_rr(cb, p, r)
+	amd64MULSD_rr(cb, p, c)
+	m68kEmitFPUConst(cb, fpuConstXMM, 2)
+	amd64SUBSD_rr(cb, fpuConstXMM, c)
+	amd64DIVSD_rr(cb, p, fpuConstXMM)
+	amd64SUBSD_rr(cb, lo, p)
+	amd64SUBSD_rr(cb, lo, hi)
+	m68kEmitFPUConst(cb, x, 1)
+	amd64SUBSD_rr(cb, x, lo)
+
+	// × 2^ki, built directly in the exponent field.
+	amd64ALU_reg_imm32(cb, 0, amd64RCX, 1023)
+	amd64SHL_imm(cb, amd64RCX, 52)
+	amd64MOVQ_xmm_reg(cb, fpuConstXMM, amd64RCX)
+	amd64MULSD_rr(cb, x, fpuConstXMM)
+}
+
+// m68kEmitFastLog lowers m68kFastLog.
+func m68kEmitFastLog(cb *CodeBuffer) {
+	const x, f, s4, s, s2, k = 0, 1, 2, 4, 5, 7
+
+	// RDX = ki, RCX = mantissa bits with the exponent of 1.0.
+	amd64MOVQ_reg_xmm(cb, amd64RCX, x)
+	amd64MOV_reg_reg(cb, amd64RDX, amd64RCX)
+	amd64SHR_imm(cb, amd64RDX, 52)
+	amd64ALU_reg_imm32(cb, 5, amd64RDX, 1023)
+	amd64MOV_reg_imm64(cb, amd64R11, 1<<52-1)
+	amd64ALU_reg_reg(cb, 0x21, amd64RCX, amd64R11) // AND
+	amd64MOV_reg_imm64(cb, amd64R11, 0x3FF0000000000000)
+	amd64ALU_reg_reg(cb, 0x09, amd64RCX, amd64R11) // OR
+	amd64MOV_reg_imm64(cb, amd64R11, math.Float64bits(math.Sqrt2))
+	amd64ALU_reg_reg(cb, 0x39, amd64RCX, amd64R11) // CMP
+	jb := amd64Jcc_rel32(cb, amd64CondB)
+	amd64MOV_reg_imm64(cb, amd64R11, 1<<52)
+	amd64ALU_reg_reg(cb, 0x29, amd64RCX, amd64R11) // SUB
+	amd64ALU_reg_imm32(cb, 0, amd64RDX, 1)
+	patchRel32(cb, jb, cb.Len())
+
+	amd64MOVQ_xmm_reg(cb, f, amd64RCX)
+	m68kEmitFPUConstOp(cb, sseOpSUBSD, f, 1)
+	amd64CVTSI2SDQ_rr(cb, k, amd64RDX)
+
+	m68kEmitFPUConst(cb, s4, 2)
+	amd64ADDSD_rr(cb, s4, f)
+	amd64MOVSD_rr(cb, s, f)
+	amd64DIVSD_rr(cb, s, s4)
+	amd64MOVSD_rr(cb, s2, s)
+	amd64MULSD_rr(cb, s2, s)
+	amd64MOVSD_rr(cb, s4, s2)
+	amd64MULSD_rr(cb, s4, s2)
+
+	// t1 in xmm0, then t2 in xmm5 once s2 is dead.
+	const t1, t2 = 0, 5
+	m68kEmitFPUConst(cb, t1, m68kFastLogL7)
+	amd64MULSD_rr(cb, t1, s4)
+	m68kEmitFPUConstOp(cb, sseOpADDSD, t1, m68kFastLogL5)
+	amd64MULSD_rr(cb, t1, s4)
+	m68kEmitFPUConstOp(cb, sseOpADDSD, t1, m68kFastLogL3)
+	amd64MULSD_rr(cb, t1, s4)
+	m68kEmitFPUConstOp(cb, sseOpADDSD, t1, m68kFastLogL1)
+	amd64MULSD_rr(cb, t1, s2)
+	m68kEmitFPUConst(cb, t2, m68kFastLogL6)
+	amd64MULSD_rr(cb, t2, s4)
+	m68kEmitFPUConstOp(cb, sseOpADDSD, t2, m68kFastLogL4)
+	amd64MULSD_rr(cb, t2, s4)
+	m68kEmitFPUConstOp(cb, sseOpADDSD, t2, m68kFastLogL2)
+	amd64MULSD_rr(cb, t2, s4)
+	amd64ADDSD_rr(cb, t1, t2) // R
+
+	// k*ln2Hi - ((hfsq - (s*(hfsq+R) + k*ln2Lo)) - f)
+	const hfsq = 2
+	amd64MOVSD_rr(cb, hfsq, f)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, hfsq, 0.5)
+	amd64MULSD_rr(cb, hfsq, f)
+	amd64ADDSD_rr(cb, t1, hfsq)
+	amd64MULSD_rr(cb, t1, s)
+	amd64MOVSD_rr(cb, t2, k)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, t2, m68kFastLn2Lo)
+	amd64ADDSD_rr(cb, t1, t2)
+	amd64SUBSD_rr(cb, hfsq, t1)
+	amd64SUBSD_rr(cb, hfsq, f)
+	amd64MOVSD_rr(cb, x, k)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, x, m68kFastLn2Hi)
+	amd64SUBSD_rr(cb, x, hfsq)
+}
+
+// m68kEmitFastSinCos lowers m68kFastSinCos.
+func m68kEmitFastSinCos(cb *CodeBuffer, cos bool) {
+	const z, zz, p, tmp, tmp2 = 0, 1, 2, 4, 5
+
+	// RDX = sign of x (sine only); xmm0 = |x|.
+	amd64MOVQ_reg_xmm(cb, amd64RCX, z)
+	if cos {
+		amd64XOR_reg_reg32(cb, amd64RDX, amd64RDX)
+	} else {
+		amd64MOV_reg_reg(cb, amd64RDX, amd64RCX)
+		amd64SHR_imm(cb, amd64RDX, 63)
+	}
+	amd64SHL_imm(cb, amd64RCX, 1)
+	amd64SHR_imm(cb, amd64RCX, 1)
+	amd64MOVQ_xmm_reg(cb, z, amd64RCX)
+
+	// j = uint64(|x|*4/π) rounded up to even; y = float64(j); q = j>>1 (+1).
+	const y = zz
+	amd64MOVSD_rr(cb, y, z)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, y, m68kFastFourOverPi)
+	amd64CVTTSD2SIQ_rr(cb, amd64RCX, y)
+	amd64MOV_reg_reg(cb, amd64R10, amd64RCX)
+	amd64ALU_reg_imm32(cb, 4, amd64R10, 1)
+	amd64ALU_reg_reg(cb, 0x01, amd64RCX, amd64R10)
+	amd64CVTSI2SDQ_rr(cb, y, amd64RCX)
+	amd64SHR_imm(cb, amd64RCX, 1)
+	if cos {
+		amd64ALU_reg_imm32(cb, 0, amd64RCX, 1)
+	}
+	for _, part := range []float64{m68kFastPi4A, m68kFastPi4B, m68kFastPi4C} {
+		amd64MOVSD_rr(cb, tmp, y)
+		m68kEmitFPUConstOp(cb, sseOpMULSD, tmp, part)
+		amd64SUBSD_rr(cb, z, tmp)
+	}
+	amd64MOVSD_rr(cb, zz, z)
+	amd64MULSD_rr(cb, zz, z)
+
+	// R10 = result sign = ((q>>1)&1) ^ sign.
+	amd64MOV_reg_reg(cb, amd64R10, amd64RCX)
+	amd64SHR_imm(cb, amd64R10, 1)
+	amd64ALU_reg_imm32(cb, 4, amd64R10, 1)
+	amd64ALU_reg_reg(cb, 0x31, amd64R10, amd64RDX) // XOR
+
+	amd64ALU_reg_imm32(cb, 4, amd64RCX, 1) // q&1 selects the cosine polynomial
+	jnzCos := amd64Jcc_rel32(cb, amd64CondNE)
+
+	m68kEmitFastPoly(cb, p, zz, m68kFastSinCoeffs[:])
+	amd64MOVSD_rr(cb, tmp, z)
+	amd64MULSD_rr(cb, tmp, zz)
+	amd64MULSD_rr(cb, tmp, p)
+	amd64ADDSD_rr(cb, z, tmp)
+	done := amd64JMP_rel32(cb)
+
+	patchRel32(cb, jnzCos, cb.Len())
+	m68kEmitFastPoly(cb, p, zz, m68kFastCosCoeffs[:])
+	amd64MOVSD_rr(cb, tmp, zz)
+	amd64MULSD_rr(cb, tmp, zz)
+	amd64MULSD_rr(cb, tmp, p)
+	amd64MOVSD_rr(cb, tmp2, zz)
+	m68kEmitFPUConstOp(cb, sseOpMULSD, tmp2, 0.5)
+	m68kEmitFPUConst(cb, z, 1)
+	amd64SUBSD_rr(cb, z, tmp2)
+	amd64ADDSD_rr(cb, z, tmp)
+	patchRel32(cb, done, cb.Len())
+
+	amd64TEST_reg_reg(cb, amd64R10, amd64R10)
+	jz := amd64Jcc_rel32(cb, amd64CondE)
+	m68kEmitFPUConst(cb, fpuConstXMM, math.Copysign(0, -1))
+	amd64XORPD_rr(cb, z, fpuConstXMM)
+	patchRel32(cb, jz, cb.Len())
+}
+
+// m68kEmitFastPoly evaluates the six-coefficient sin/cos polynomial in zz
+// into dst: ((c0·zz + c1)·zz + … + c4)·zz + c5.
+func m68kEmitFastPoly(cb *CodeBuffer, dst, zz byte, coeffs []float64) {
+	m68kEmitFPUConst(cb, dst, coeffs[0])
+	amd64MULSD_rr(cb, dst, zz)
+	for _, c := range coeffs[1:5] {
+		m68kEmitFPUConstOp(cb, sseOpADDSD, dst, c)
+		amd64MULSD_rr(cb, dst, zz)
+	}
+	m68kEmitFPUConstOp(cb, sseOpADDSD, dst, coeffs[5])
+}
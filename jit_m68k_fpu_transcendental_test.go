@@ -0,0 +1,85 @@
+package main
+
+import (
+	"math"
+	"math/rand"
+	"testing"
+)
+
+// m68kULPDiff returns the distance in units in the last place between two
+// finite doubles of the same sign.
+func m68kULPDiff(a, b float64) uint64 {
+	x, y := math.Float64bits(a), math.Float64bits(b)
+	if x > y {
+		return x - y
+	}
+	return y - x
+}
+
+// TestM68KFastTranscendentals_Accuracy holds the native kernels' models to
+// the precision documented in jit_m68k_fpu_transcendental.go across each
+// kernel's domain.
+func TestM68KFastTranscendentals_Accuracy(t *testing.T) {
+	rng := rand.New(rand.NewSource(68881))
+	cases := []struct {
+		name  string
+		op    m68kFPUNativeOp
+		fast  func(float64) float64
+		exact func(float64) float64
+		gen   func() float64
+		ulps  uint64
+	}{
+		{"sin", m68kFPUNativeFSIN, func(x float64) float64 { return m68kFastSinCos(x, false) }, math.Sin,
+			func() float64 { return (rng.Float64()*2 - 1) * math.Ldexp(1, rng.Intn(40)-10) }, 1},
+		{"cos", m68kFPUNativeFCOS, func(x float64) float64 { return m68kFastSinCos(x, true) }, math.Cos,
+			func() float64 { return (rng.Float64()*2 - 1) * math.Ldexp(1, rng.Intn(40)-10) }, 1},
+		{"exp", m68kFPUNativeFETOX, m68kFastExp, math.Exp,
+			func() float64 { return (rng.Float64()*2 - 1) * 708 }, 2},
+		{"log", m68kFPUNativeFLOGN, m68kFastLog, math.Log,
+			func() float64 {
+				return math.Float64frombits(0x0010000000000000 + uint64(rng.Int63n(0x7FE0000000000000)))
+			}, 1},
+	}
+	for _, c := range cases {
+		for i := 0; i < 200000; i++ {
+			x := c.gen()
+			if !m68kFPUNativeInDomain(c.op, x) {
+				t.Fatalf("%s: generated %v outside the kernel domain", c.name, x)
+			}
+			got, want := c.fast(x), c.exact(x)
+			if math.Signbit(got) != math.Signbit(want) || m68kULPDiff(got, want) > c.ulps {
+				t.Fatalf("%s(%v) = %v, math says %v (> %d ulp)", c.name, x, got, want, c.ulps)
+			}
+		}
+	}
+}
+
+func TestM68KFastTranscendentals_Domains(t *testing.T) {
+	cases := []struct {
+		op  m68kFPUNativeOp
+		in  []float64
+		out []float64
+	}{
+		{m68kFPUNativeFSIN, []float64{0, math.Copysign(0, -1), -1e8, math.Ldexp(1, 29) - 1},
+			[]float64{math.Ldexp(1, 29), -math.Ldexp(1, 29), math.Inf(1), math.NaN()}},
+		{m68kFPUNativeFETOX, []float64{708, -708, 5e-324},
+			[]float64{math.Nextafter(708, 709), math.Nextafter(-708, -709), math.Inf(-1), math.NaN()}},
+		{m68kFPUNativeFLOGN, []float64{math.SmallestNonzeroFloat64 * (1 << 52), 1, math.MaxFloat64},
+			[]float64{0, math.Copysign(0, -1), 5e-324, -1, math.Inf(1), math.NaN()}},
+	}
+	for _, c := range cases {
+		for _, x := range c.in {
+			if !m68kFPUNativeInDomain(c.op, x) {
+				t.Errorf("op %d: %v should be native", c.op, x)
+			}
+		}
+		for _, x := range c.out {
+			if m68kFPUNativeInDomain(c.op, x) {
+				t.Errorf("op %d: %v should take the helper", c.op, x)
+			}
+		}
+	}
+	if m68kFPUNativeInDomain(m68kFPUNativeFADD, 1) {
+		t.Error("FADD has no transcendental kernel domain")
+	}
+}
@@ -748,15 +748,6 @@ func x86NeedsFallback(instrs []X86JITInstr) bool {
 		return true
 	}
 
-	// Segment-override-prefixed first instruction: the compile loop bails
-	// at the segment-prefix gate without emitting anything, which post
-	// Phase-8 surfaces as a "no instructions compiled" panic. Route to
-	// single-instruction Step bail instead so the fast-path stays correct
-	// without growing per-segment native-emit support.
-	if instrs[0].prefixes&x86PrefSeg != 0 {
-		return true
-	}
-
 	opcode := instrs[0].opcode
 
 	if x86ShouldStepInInterpreter(instrs[0]) {
@@ -782,11 +773,10 @@ func x86NeedsFallback(instrs []X86JITInstr) bool {
 	case 0xCF: // IRET
 		return true
 
-	// Load segment + pointer
-	case 0xC4: // LES
-		return true
-	case 0xC5: // LDS
-		return true
+	// Load segment + pointer: only the 16:32 memory form compiles
+	case 0xC4, 0xC5: // LES, LDS
+		ji := instrs[0]
+		return !ji.hasModRM || ji.modrm>>6 == 3 || ji.prefixes&x86PrefOpSize != 0
 
 	// PUSH/POP segment registers
 	case 0x06, 0x07: // PUSH/POP ES
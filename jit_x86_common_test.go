@@ -850,6 +850,22 @@ func TestX86NeedsFallback(t *testing.T) {
 		t.Error("LES should need fallback")
 	}
 
+	// The 16:32 memory forms of LDS/LES compile natively
+	ldsMem := X86JITInstr{opcode: 0x00C5, hasModRM: true, modrm: 0x06}
+	if x86NeedsFallback([]X86JITInstr{ldsMem}) {
+		t.Error("LDS r32, m16:32 should not need fallback")
+	}
+	les16 := X86JITInstr{opcode: 0x00C4, hasModRM: true, modrm: 0x06, prefixes: x86PrefOpSize}
+	if !x86NeedsFallback([]X86JITInstr{les16}) {
+		t.Error("LES r16, m16:16 should need fallback")
+	}
+
+	// Segment-override prefixes do not force a fallback
+	fsLoad := X86JITInstr{opcode: 0x008B, hasModRM: true, modrm: 0x46, prefixes: x86PrefSeg}
+	if x86NeedsFallback([]X86JITInstr{fsLoad}) {
+		t.Error("FS: MOV r32, m32 should not need fallback")
+	}
+
 	// Normal ALU should not need fallback
 	addInstr := X86JITInstr{opcode: 0x0001} // ADD
 	if x86NeedsFallback([]X86JITInstr{addInstr}) {
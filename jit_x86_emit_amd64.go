@@ -161,6 +161,10 @@ type x86CompileState struct {
 	// the compile loop. Patched bidirectionally by x86PatchCompatibleChainsTo
 	// once the target block is in the cache.
 	chainExits *[]x86ChainExitInfo
+
+	// fpu models the x87 stack across the current run of x87 instructions
+	// (see jit_x86_fpu_amd64.go). Written back by x86EmitFPUFlush.
+	fpu x86FPUCache
 }
 
 // x86DefaultRegMap returns the Tier 1 fixed register mapping.
@@ -433,10 +437,11 @@ func readLE32Signed(memory []byte, pc uint32) int32 {
 
 // x86DeferredBail records a deferred bail site to be resolved at end of block.
 type x86DeferredBail struct {
-	jccOffset int    // offset of the Jcc rel32 displacement in CodeBuffer
-	retPC     uint32 // guest PC to return to
-	instrIdx  int    // instruction count at bail point
-	kind      byte   // 0 = IO bail, 1 = self-mod bail
+	jccOffset int         // offset of the Jcc rel32 displacement in CodeBuffer
+	retPC     uint32      // guest PC to return to
+	instrIdx  int         // instruction count at bail point
+	kind      byte        // 0 = IO bail, 1 = self-mod bail
+	fpu       x86FPUCache // x87 stack model to write back before exiting
 }
 
 // x86TryConstantEA returns (address, true) if the instruction's EA is a compile-time
@@ -519,6 +524,7 @@ func x86EmitIOCheck(cb *CodeBuffer, addrReg byte, retPC uint32, instrCount int)
 	if x86CurrentBails != nil {
 		*x86CurrentBails = append(*x86CurrentBails, x86DeferredBail{
 			jccOffset: jccOff, retPC: retPC, instrIdx: instrCount, kind: 0,
+			fpu: x86CurrentFPUCache(),
 		})
 	}
 	// Fast path continues inline (no jump-over needed)
@@ -527,6 +533,14 @@ func x86EmitIOCheck(cb *CodeBuffer, addrReg byte, retPC uint32, instrCount int)
 // x86CurrentBails collects deferred bail sites during block compilation.
 var x86CurrentBails *[]x86DeferredBail
 
+// x86CurrentFPUCache snapshots the x87 stack model at a bail site.
+func x86CurrentFPUCache() x86FPUCache {
+	if x86CurrentCS == nil {
+		return x86FPUCache{}
+	}
+	return x86CurrentCS.fpu
+}
+
 // x86EmitDeferredBails emits the shared slow path stubs at the end of the block.
 // Each bail site gets a tiny stub (write RetPC/RetCount) that falls through to
 // a single shared exit sequence.
@@ -547,6 +561,9 @@ func x86EmitDeferredBails(cb *CodeBuffer) {
 		// Patch the Jcc to jump here
 		patchRel32(cb, bail.jccOffset, stubLabel)
 
+		// Write back any x87 stack cached at the bail site
+		x86EmitFPUWriteBack(cb, &bail.fpu)
+
 		// Write RetPC and RetCount
 		x86EmitRetPC(cb, bail.retPC, uint32(bail.instrIdx))
 
@@ -592,6 +609,7 @@ func x86EmitSelfModCheck(cb *CodeBuffer, addrReg byte, nextPC uint32, instrCount
 	if x86CurrentBails != nil {
 		*x86CurrentBails = append(*x86CurrentBails, x86DeferredBail{
 			jccOffset: jccOff, retPC: nextPC, instrIdx: instrCount, kind: 1,
+			fpu: x86CurrentFPUCache(),
 		})
 	}
 }
@@ -907,7 +925,7 @@ func x86FlagAnalysisCanCompileInstruction(ji *X86JITInstr) bool {
 	if ji == nil {
 		return false
 	}
-	if ji.prefixes&x86PrefSeg != 0 || x86ShouldStepInInterpreter(*ji) {
+	if x86ShouldStepInInterpreter(*ji) {
 		return false
 	}
 	if ji.prefixes&(x86PrefAddrSize|x86PrefLock) != 0 {
@@ -988,6 +1006,8 @@ func x86FlagAnalysisCanCompileInstruction(ji *X86JITInstr) bool {
 		return true
 	case op == 0x8C:
 		return ji.hasModRM && ji.modrm>>6 == 3 && ((ji.modrm>>3)&7) <= 5
+	case op == 0xC4 || op == 0xC5:
+		return ji.hasModRM && ji.modrm>>6 != 3
 	case op == 0xC6 || op == 0xC7:
 		return ji.hasModRM && ji.grpOp == 0
 	case op == 0xE2:
@@ -1105,6 +1125,12 @@ func x86EmitRetPC(cb *CodeBuffer, pc uint32, count uint32) {
 func x86EmitInstruction(cb *CodeBuffer, ji *X86JITInstr, memory []byte, startPC uint32, cs *x86CompileState, instrIdx int) bool {
 	opcode := ji.opcode
 
+	// A run of x87 instructions keeps the register stack in XMM registers;
+	// anything else sees FPU_X87 in memory.
+	if opcode < 0xD8 || opcode > 0xDF {
+		x86EmitFPUFlush(cb, cs)
+	}
+
 	// Handle two-byte opcodes (0x0F xx) first to avoid low-byte collisions
 	if opcode >= 0x0F00 {
 		op2 := byte(opcode)
@@ -1340,6 +1366,12 @@ func x86EmitInstruction(cb *CodeBuffer, ji *X86JITInstr, memory []byte, startPC
 	case op == 0x8C:
 		return x86EmitMOV_Ev_Sw(cb, ji)
 
+	// LES/LDS Gv, Mp (0xC4/0xC5)
+	case op == 0xC4:
+		return x86EmitLxS(cb, ji, memory, x86SegES, instrIdx)
+	case op == 0xC5:
+		return x86EmitLxS(cb, ji, memory, x86SegDS, instrIdx)
+
 	// PUSHF (0x9C) / POPF (0x9D)
 	case op == 0x9C:
 		return x86EmitPUSHF(cb, ji, cs, instrIdx)
@@ -1374,7 +1406,7 @@ func x86EmitInstruction(cb *CodeBuffer, ji *X86JITInstr, memory []byte, startPC
 
 	// x87 FPU escapes (D8-DF)
 	case op >= 0xD8 && op <= 0xDF:
-		return x86EmitFPU(cb, ji, memory, instrIdx)
+		return x86EmitFPU(cb, ji, memory, cs, instrIdx)
 
 	// MOVS/STOS string ops
 	case op == 0xA4: // MOVSB (single or REP)
@@ -1497,7 +1529,7 @@ func x86EmitMOV_EAX_moffs32(cb *CodeBuffer, ji *X86JITInstr, memory []byte, inst
 	if ji.length < 5 {
 		return false
 	}
-	addr := readLE32(memory, ji.opcodePC+1)
+	addr := readLE32(memory, x86MoffsDispPC(ji))
 	amd64MOV_reg_imm32(cb, amd64R10, addr)
 	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
 	x86EmitMemLoad32(cb, amd64R8, amd64R10)
@@ -1509,7 +1541,7 @@ func x86EmitMOV_moffs32_EAX(cb *CodeBuffer, ji *X86JITInstr, memory []byte, inst
 	if ji.length < 5 {
 		return false
 	}
-	addr := readLE32(memory, ji.opcodePC+1)
+	addr := readLE32(memory, x86MoffsDispPC(ji))
 	amd64MOV_reg_imm32(cb, amd64R10, addr)
 	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
 	x86EmitLoadGuestReg32(cb, amd64R8, 0) // EAX
@@ -2715,6 +2747,44 @@ func x86EmitMOV_Ev_Sw(cb *CodeBuffer, ji *X86JITInstr) bool {
 		cb.EmitBytes(modRM(1, amd64R8, amd64RAX), byte(segIdx*2))
 	}
 
+	// Register destinations take the selector in the low word only,
+	// matching opMOV_Ev_Sw's writeRM16.
+	x86EmitLoadGuestReg32(cb, amd64R10, dstReg)
+	amd64ALU_reg_imm32_32bit(cb, 4, amd64R10, -0x10000) // AND R10d, 0xFFFF0000
+	amd64ALU_reg_reg32(cb, 0x09, amd64R8, amd64R10)     // OR R8d, R10d
+	x86EmitStoreGuestReg32(cb, dstReg, amd64R8)
+	return true
+}
+
+// ===========================================================================
+// LES/LDS (0xC4/0xC5) -- Load far pointer
+// ===========================================================================
+
+// x86EmitLxS loads a 16:32 far pointer: the offset dword goes to the reg
+// operand and the selector word at EA+4 to jitSegRegs[segIdx]. The exec
+// loop syncs jitSegRegs with the named fields around every interpreter
+// step, so later interpreted instructions see the new selector.
+func x86EmitLxS(cb *CodeBuffer, ji *X86JITInstr, memory []byte, segIdx byte, instrIdx int) bool {
+	if !ji.hasModRM || ji.modrm>>6 == 3 || ji.prefixes&x86PrefOpSize != 0 {
+		return false
+	}
+	dstReg := (ji.modrm >> 3) & 7
+
+	if !x86EmitComputeEA(cb, ji, memory, amd64R10) {
+		return false
+	}
+	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
+	// Read both halves before writing dstReg, which may be the base register.
+	x86EmitMemLoad32(cb, amd64R8, amd64R10)
+	amd64ALU_reg_imm32_32bit(cb, 0, amd64R10, 4) // ADD R10d, 4
+	x86EmitMemLoad16(cb, amd64R11, amd64R10)
+
+	// MOV WORD [jitSegRegs + segIdx*2], R11w
+	amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffSegRegsPtr))
+	cb.EmitBytes(0x66)
+	emitREX(cb, false, amd64R11, amd64RAX)
+	cb.EmitBytes(0x89, modRM(1, amd64R11, amd64RAX), segIdx*2)
+
 	x86EmitStoreGuestReg32(cb, dstReg, amd64R8)
 	return true
 }
@@ -3042,480 +3112,6 @@ func x86EmitLOOP(cb *CodeBuffer, ji *X86JITInstr, memory []byte, instrIdx int) b
 	return true
 }
 
-// ===========================================================================
-// x87 FPU Emitters (Tier 1: SSE2 on x86-64 host)
-// ===========================================================================
-
-// FPU_X87 struct field offsets
-const (
-	fpuOffRegs = 0  // regs [8]float64 at offset 0
-	fpuOffFCW  = 64 // FCW uint16
-	fpuOffFSW  = 66 // FSW uint16
-	fpuOffFTW  = 68 // FTW uint16
-)
-
-// x86EmitFPU dispatches x87 FPU instructions (D8-DF).
-func x86EmitFPU(cb *CodeBuffer, ji *X86JITInstr, memory []byte, instrIdx int) bool {
-	if !ji.hasModRM {
-		return false
-	}
-	escape := byte(ji.opcode)
-	modrm := ji.modrm
-	mod := modrm >> 6
-	regOp := (modrm >> 3) & 7
-	rm := modrm & 7
-
-	// Load FPU pointer
-	amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffFPUPtr))
-
-	switch escape {
-	case 0xD8: // FADD/FMUL/FCOM/FCOMP/FSUB/FSUBR/FDIV/FDIVR ST(0), ST(i)
-		if mod == 3 {
-			switch regOp {
-			case 0: // FADD ST(0), ST(i)
-				return x86EmitFPUBinaryOp(cb, rm, 0x58, ji.opcodePC, instrIdx) // ADDSD
-			case 1: // FMUL ST(0), ST(i)
-				return x86EmitFPUBinaryOp(cb, rm, 0x59, ji.opcodePC, instrIdx) // MULSD
-			case 4: // FSUB ST(0), ST(i)
-				return x86EmitFPUBinaryOp(cb, rm, 0x5C, ji.opcodePC, instrIdx) // SUBSD
-			case 6: // FDIV ST(0), ST(i)
-				return x86EmitFPUBinaryOp(cb, rm, 0x5E, ji.opcodePC, instrIdx) // DIVSD
-			}
-		}
-
-	case 0xD9:
-		if mod == 3 {
-			if modrm >= 0xC0 && modrm <= 0xC7 { // FLD ST(i)
-				return x86EmitFLD_STi(cb, rm)
-			}
-			if modrm >= 0xC8 && modrm <= 0xCF { // FXCH ST(i)
-				return x86EmitFXCH(cb, rm)
-			}
-			if modrm == 0xE0 { // FCHS
-				return x86EmitFCHS(cb)
-			}
-			if modrm == 0xE1 { // FABS
-				return x86EmitFABS(cb)
-			}
-		} else {
-			// D9 /0: FLD mem32 (single-precision)
-			if regOp == 0 {
-				return x86EmitFLD_mem32(cb, ji, memory, instrIdx)
-			}
-		}
-
-	case 0xDD:
-		if mod == 3 {
-			if modrm >= 0xD8 && modrm <= 0xDF { // FSTP ST(i)
-				return x86EmitFSTP_STi(cb, rm)
-			}
-			if modrm >= 0xD0 && modrm <= 0xD7 { // FST ST(i)
-				return x86EmitFST_STi(cb, rm)
-			}
-		} else {
-			if regOp == 0 { // FLD mem64 (double-precision)
-				return x86EmitFLD_mem64(cb, ji, memory, instrIdx)
-			}
-			if regOp == 3 { // FSTP mem64
-				return x86EmitFSTP_mem64(cb, ji, memory, instrIdx)
-			}
-			if regOp == 2 { // FST mem64
-				return x86EmitFST_mem64(cb, ji, memory, instrIdx)
-			}
-		}
-	}
-
-	return false
-}
-
-// x86EmitFPUReadTOP emits code to read the FPU TOP field into the given register.
-// RAX must point to FPU_X87 struct.
-func x86EmitFPUReadTOP(cb *CodeBuffer, dstReg byte) {
-	emitREX(cb, false, dstReg, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, dstReg, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, dstReg, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, dstReg, 7)
-}
-
-// x86EmitFPUCheckTag emits a tag check for a physical FPU register.
-// physRegReg holds the physical register index (0-7).
-// If the tag equals badTag, bails to interpreter.
-// RAX must point to FPU_X87 struct.
-func x86EmitFPUCheckTag(cb *CodeBuffer, physRegReg byte, badTag uint16, retPC uint32, instrIdx int) {
-	// FTW is at fpuOffFTW. Tag for phys reg i is bits (i*2+1):(i*2) of FTW.
-	// Load FTW
-	emitREX(cb, false, amd64R11, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64R11, amd64RAX), byte(fpuOffFTW)) // MOVZX R11, [RAX+FTW]
-
-	// Shift right by physReg*2: SHR R11, CL (save/restore CL)
-	amd64MOV_reg_reg32(cb, amd64R8, amd64RCX) // save RCX
-	amd64MOV_reg_reg32(cb, amd64RCX, physRegReg)
-	amd64SHL_imm32(cb, amd64RCX, 1) // *2
-	amd64SHR_CL32(cb, amd64R11)
-	amd64MOV_reg_reg32(cb, amd64RCX, amd64R8)    // restore RCX
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64R11, 3) // AND R11, 3
-
-	// CMP R11, badTag
-	amd64ALU_reg_imm32_32bit(cb, 7, amd64R11, int32(badTag))
-	// JE -> bail
-	bailOff := amd64Jcc_rel32(cb, amd64CondE)
-	skipOff := amd64JMP_rel32(cb)
-
-	bailLabel := cb.Len()
-	patchRel32(cb, bailOff, bailLabel)
-	// Bail to interpreter
-	amd64MOV_mem_imm32(cb, x86AMD64RegCtx, int32(x86CtxOffNeedIOFallback), 1)
-	x86EmitRetPC(cb, retPC, uint32(instrIdx))
-	x86EmitLightweightEpilogue(cb)
-	x86EmitFullEpilogueEnd(cb)
-
-	skipLabel := cb.Len()
-	patchRel32(cb, skipOff, skipLabel)
-}
-
-// x86EmitFPUBinaryOp emits FADD/FMUL/FSUB/FDIV ST(0), ST(i) using SSE2.
-// sseOp is the SSE2 opcode byte (0x58=ADDSD, 0x59=MULSD, 0x5C=SUBSD, 0x5E=DIVSD).
-func x86EmitFPUBinaryOp(cb *CodeBuffer, stIdx byte, sseOp byte, retPC uint32, instrIdx int) bool {
-	_, _ = retPC, instrIdx // available for future tag checks
-	// RAX = FPUPtr (already loaded by caller)
-	x86EmitFPUReadTOP(cb, amd64RCX)
-	// Note: tag checks omitted to match interpreter behavior (operates regardless of tags)
-
-	// physST0 = TOP & 7 (already in ECX)
-	// physSTi = (TOP + i) & 7
-	amd64MOV_reg_reg32(cb, amd64RDX, amd64RCX)
-	if stIdx != 0 {
-		amd64ALU_reg_imm32_32bit(cb, 0, amd64RDX, int32(stIdx))
-		amd64ALU_reg_imm32_32bit(cb, 4, amd64RDX, 7)
-	}
-
-	// Load ST(0) into XMM0: MOVSD XMM0, [RAX + ECX*8]
-	// SHL ECX, 3 to get byte offset
-	amd64SHL_imm32(cb, amd64RCX, 3)
-	// MOVSD XMM0, [RAX + RCX] (F2 0F 10 04 08)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-
-	// Load ST(i) into XMM1: MOVSD XMM1, [RAX + EDX*8]
-	amd64SHL_imm32(cb, amd64RDX, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 1, 4), sibByte(0, amd64RDX, amd64RAX))
-
-	// Perform SSE2 op: XMM0 = XMM0 op XMM1
-	cb.EmitBytes(0xF2, 0x0F, sseOp, modRM(3, 0, 1))
-
-	// Store result back to ST(0): MOVSD [RAX + RCX], XMM0
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-
-	return true
-}
-
-// x86EmitFLD_STi emits FLD ST(i) -- push ST(i) onto stack.
-func x86EmitFLD_STi(cb *CodeBuffer, stIdx byte) bool {
-	// RAX = FPUPtr (already loaded)
-	// Read TOP
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	// physSTi = (TOP + i) & 7
-	amd64MOV_reg_reg32(cb, amd64RDX, amd64RCX)
-	amd64ALU_reg_imm32_32bit(cb, 0, amd64RDX, int32(stIdx))
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RDX, 7)
-
-	// Load ST(i) value: MOVSD XMM0, [RAX + RDX*8]
-	amd64SHL_imm32(cb, amd64RDX, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64RDX, amd64RAX))
-
-	// newTOP = (TOP - 1) & 7
-	amd64ALU_reg_imm32_32bit(cb, 5, amd64RCX, 1) // SUB ECX, 1
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7) // AND ECX, 7
-
-	// Update FSW with new TOP
-	x86EmitUpdateFSWTop(cb, amd64RCX)
-
-	// Store value to new ST(0) = regs[newTOP]
-	amd64SHL_imm32(cb, amd64RCX, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-
-	return true
-}
-
-// x86EmitFSTP_STi emits FSTP ST(i) -- copy ST(0) to ST(i), then pop.
-func x86EmitFSTP_STi(cb *CodeBuffer, stIdx byte) bool {
-	// RAX = FPUPtr
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	// Load ST(0): MOVSD XMM0, [RAX + TOP*8]
-	amd64MOV_reg_reg32(cb, amd64R8, amd64RCX)
-	amd64SHL_imm32(cb, amd64R8, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64R8, amd64RAX))
-
-	// physSTi = (TOP + i) & 7
-	amd64MOV_reg_reg32(cb, amd64RDX, amd64RCX)
-	amd64ALU_reg_imm32_32bit(cb, 0, amd64RDX, int32(stIdx))
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RDX, 7)
-	amd64SHL_imm32(cb, amd64RDX, 3)
-
-	// Store to ST(i)
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RDX, amd64RAX))
-
-	// Pop: TOP = (TOP + 1) & 7
-	amd64ALU_reg_imm32_32bit(cb, 0, amd64RCX, 1)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-	x86EmitUpdateFSWTop(cb, amd64RCX)
-
-	return true
-}
-
-// x86EmitFST_STi emits FST ST(i) -- copy ST(0) to ST(i), no pop.
-func x86EmitFST_STi(cb *CodeBuffer, stIdx byte) bool {
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	amd64MOV_reg_reg32(cb, amd64R8, amd64RCX)
-	amd64SHL_imm32(cb, amd64R8, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64R8, amd64RAX))
-
-	amd64MOV_reg_reg32(cb, amd64RDX, amd64RCX)
-	amd64ALU_reg_imm32_32bit(cb, 0, amd64RDX, int32(stIdx))
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RDX, 7)
-	amd64SHL_imm32(cb, amd64RDX, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RDX, amd64RAX))
-
-	return true
-}
-
-// x86EmitFXCH emits FXCH ST(i) -- swap ST(0) and ST(i).
-func x86EmitFXCH(cb *CodeBuffer, stIdx byte) bool {
-	// RAX = FPUPtr
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	// physST0 offset
-	amd64MOV_reg_reg32(cb, amd64R8, amd64RCX)
-	amd64SHL_imm32(cb, amd64R8, 3)
-
-	// physSTi offset
-	amd64MOV_reg_reg32(cb, amd64RDX, amd64RCX)
-	amd64ALU_reg_imm32_32bit(cb, 0, amd64RDX, int32(stIdx))
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RDX, 7)
-	amd64SHL_imm32(cb, amd64RDX, 3)
-
-	// XMM0 = ST(0), XMM1 = ST(i)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64R8, amd64RAX))
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 1, 4), sibByte(0, amd64RDX, amd64RAX))
-
-	// ST(0) = XMM1, ST(i) = XMM0
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 1, 4), sibByte(0, amd64R8, amd64RAX))
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RDX, amd64RAX))
-
-	return true
-}
-
-// x86EmitFCHS emits FCHS -- negate ST(0).
-func x86EmitFCHS(cb *CodeBuffer) bool {
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	amd64SHL_imm32(cb, amd64RCX, 3)
-	// Load ST(0) into XMM0
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-
-	// XOR with sign bit mask: XORPD XMM0, [sign_mask]
-	// Use PXOR + shift to create sign mask, or use subtraction from 0
-	// Simplest: XORPD with -0.0 loaded into XMM1
-	// Load -0.0 into XMM1 via integer path: MOV R8, 0x8000000000000000; MOVQ XMM1, R8
-	amd64MOV_reg_imm64(cb, amd64R8, 0x8000000000000000)
-	// MOVQ XMM1, R8: 66 49 0F 6E C8
-	cb.EmitBytes(0x66)
-	emitREX(cb, true, 1, amd64R8)
-	cb.EmitBytes(0x0F, 0x6E, modRM(3, 1, amd64R8))
-	// XORPD XMM0, XMM1: 66 0F 57 C1
-	cb.EmitBytes(0x66, 0x0F, 0x57, modRM(3, 0, 1))
-
-	// Store back
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-	return true
-}
-
-// x86EmitFABS emits FABS -- absolute value of ST(0).
-func x86EmitFABS(cb *CodeBuffer) bool {
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	amd64SHL_imm32(cb, amd64RCX, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-
-	// AND with abs mask (clear sign bit)
-	amd64MOV_reg_imm64(cb, amd64R8, 0x7FFFFFFFFFFFFFFF)
-	cb.EmitBytes(0x66)
-	emitREX(cb, true, 1, amd64R8)
-	cb.EmitBytes(0x0F, 0x6E, modRM(3, 1, amd64R8))
-	// ANDPD XMM0, XMM1: 66 0F 54 C1
-	cb.EmitBytes(0x66, 0x0F, 0x54, modRM(3, 0, 1))
-
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-	return true
-}
-
-// x86EmitFLD_mem64 emits FLD qword [mem] -- push double from memory.
-func x86EmitFLD_mem64(cb *CodeBuffer, ji *X86JITInstr, memory []byte, instrIdx int) bool {
-	// Compute EA
-	if !x86EmitComputeEA(cb, ji, memory, amd64R10) {
-		return false
-	}
-	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
-
-	// RAX = FPUPtr (reload since IOCheck may have clobbered)
-	amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffFPUPtr))
-
-	// Load double from [memBase + R10] into XMM0
-	// MOVSD XMM0, [RSI + R10]
-	cb.EmitBytes(0xF2)
-	emitREX_SIB(cb, false, 0, amd64R10, x86AMD64RegMemBase)
-	cb.EmitBytes(0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64R10, x86AMD64RegMemBase))
-
-	// Read TOP, decrement, push
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-	amd64ALU_reg_imm32_32bit(cb, 5, amd64RCX, 1) // TOP - 1
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7) // & 7
-
-	x86EmitUpdateFSWTop(cb, amd64RCX)
-
-	// Store to regs[newTOP]
-	amd64SHL_imm32(cb, amd64RCX, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-
-	return true
-}
-
-// x86EmitFLD_mem32 emits FLD dword [mem] -- push single from memory, convert to double.
-func x86EmitFLD_mem32(cb *CodeBuffer, ji *X86JITInstr, memory []byte, instrIdx int) bool {
-	if !x86EmitComputeEA(cb, ji, memory, amd64R10) {
-		return false
-	}
-	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
-
-	amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffFPUPtr))
-
-	// Load float32 from [memBase + R10] into XMM0: MOVSS XMM0, [RSI+R10]
-	cb.EmitBytes(0xF3)
-	emitREX_SIB(cb, false, 0, amd64R10, x86AMD64RegMemBase)
-	cb.EmitBytes(0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64R10, x86AMD64RegMemBase))
-
-	// Convert float32 to float64: CVTSS2SD XMM0, XMM0
-	cb.EmitBytes(0xF3, 0x0F, 0x5A, modRM(3, 0, 0))
-
-	// Push onto FPU stack (same as FLD_mem64 from here)
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-	amd64ALU_reg_imm32_32bit(cb, 5, amd64RCX, 1)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-	x86EmitUpdateFSWTop(cb, amd64RCX)
-	amd64SHL_imm32(cb, amd64RCX, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64RCX, amd64RAX))
-
-	return true
-}
-
-// x86EmitFSTP_mem64 emits FSTP qword [mem] -- store double to memory, pop.
-func x86EmitFSTP_mem64(cb *CodeBuffer, ji *X86JITInstr, memory []byte, instrIdx int) bool {
-	if !x86EmitComputeEA(cb, ji, memory, amd64R10) {
-		return false
-	}
-	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
-
-	amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffFPUPtr))
-
-	// Read TOP
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	// Load ST(0): MOVSD XMM0, [RAX + TOP*8]
-	amd64MOV_reg_reg32(cb, amd64R8, amd64RCX)
-	amd64SHL_imm32(cb, amd64R8, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64R8, amd64RAX))
-
-	// Store to [memBase + R10]: MOVSD [RSI+R10], XMM0
-	cb.EmitBytes(0xF2)
-	emitREX_SIB(cb, false, 0, amd64R10, x86AMD64RegMemBase)
-	cb.EmitBytes(0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64R10, x86AMD64RegMemBase))
-
-	// Pop: TOP = (TOP + 1) & 7
-	amd64ALU_reg_imm32_32bit(cb, 0, amd64RCX, 1)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-	x86EmitUpdateFSWTop(cb, amd64RCX)
-
-	return true
-}
-
-// x86EmitFST_mem64 emits FST qword [mem] -- store double to memory, no pop.
-func x86EmitFST_mem64(cb *CodeBuffer, ji *X86JITInstr, memory []byte, instrIdx int) bool {
-	if !x86EmitComputeEA(cb, ji, memory, amd64R10) {
-		return false
-	}
-	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
-
-	amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffFPUPtr))
-
-	emitREX(cb, false, amd64RCX, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64RCX, amd64RAX), byte(fpuOffFSW))
-	amd64SHR_imm32(cb, amd64RCX, 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
-
-	amd64MOV_reg_reg32(cb, amd64R8, amd64RCX)
-	amd64SHL_imm32(cb, amd64R8, 3)
-	cb.EmitBytes(0xF2, 0x0F, 0x10, modRM(0, 0, 4), sibByte(0, amd64R8, amd64RAX))
-
-	cb.EmitBytes(0xF2)
-	emitREX_SIB(cb, false, 0, amd64R10, x86AMD64RegMemBase)
-	cb.EmitBytes(0x0F, 0x11, modRM(0, 0, 4), sibByte(0, amd64R10, x86AMD64RegMemBase))
-
-	return true
-}
-
-// x86EmitUpdateFSWTop updates the TOP field in FSW. topReg has the new TOP value (0-7).
-// RAX must point to FPU_X87 struct.
-func x86EmitUpdateFSWTop(cb *CodeBuffer, topReg byte) {
-	// FSW = (FSW & ~TOPMask) | (newTOP << 11)
-	// Load current FSW into R11
-	emitREX(cb, false, amd64R11, amd64RAX)
-	cb.EmitBytes(0x0F, 0xB7, modRM(1, amd64R11, amd64RAX), byte(fpuOffFSW)) // MOVZX R11w, [RAX+FSW]
-
-	// Clear TOP bits: AND R11, ~(7 << 11)
-	amd64ALU_reg_imm32_32bit(cb, 4, amd64R11, int32(0xFFFF&^(7<<11))) // AND R11d, ~TOPMask
-
-	// Shift new TOP into position: SHL topReg_copy, 11
-	amd64MOV_reg_reg32(cb, amd64R8, topReg)
-	amd64SHL_imm32(cb, amd64R8, 11)
-
-	// OR into FSW
-	amd64ALU_reg_reg32(cb, 0x09, amd64R11, amd64R8) // OR R11, R8
-
-	// Store back: MOV WORD [RAX + FSW], R11w
-	cb.EmitBytes(0x66) // 16-bit prefix
-	emitREX(cb, false, amd64R11, amd64RAX)
-	cb.EmitBytes(0x89, modRM(1, amd64R11, amd64RAX), byte(fpuOffFSW))
-}
-
 // ===========================================================================
 // REP String Operation Emitters
 // ===========================================================================
@@ -4831,18 +4427,12 @@ func x86CompileBlock(instrs []X86JITInstr, startPC uint32, execMem *ExecMem, mem
 	for i := range instrs {
 		ji := &instrs[i]
 
-		// Segment-override prefix (FS/GS/DS/ES/CS/SS) bails to interp.
-		// The current native emitters compute effective addresses as
-		// flat offsets and do not add a segment base; running a
-		// prefixed instr through them would produce different memory
-		// addresses than the interpreter (which honors prefixSeg via
-		// readSegBase). End the block here so the dispatcher steps the
-		// prefixed instr via cpu.Step(), which correctly applies the
-		// segment base. Slice 3+ may add native segment-base support
-		// for FS:/GS: TLS-style access.
-		if ji.prefixes&x86PrefSeg != 0 {
-			break
-		}
+		// Segment-override prefixes (FS/GS/DS/ES/CS/SS) compile natively.
+		// The guest is flat: every segment base is zero and prefixSeg
+		// only selects lastEASeg for the x87 FDS record, so the emitters'
+		// flat effective addresses are the interpreter's addresses.
+		// x86FindModRMPC and the length-relative operand readers skip
+		// the prefix bytes.
 
 		// Stack/control instructions: stop before the instruction so the
 		// dispatcher executes it through the interpreter. Native emitters
@@ -4877,6 +4467,7 @@ func x86CompileBlock(instrs []X86JITInstr, startPC uint32, execMem *ExecMem, mem
 					cb.Emit32(retAddr)
 				}
 
+				x86EmitFPUFlush(cb, cs)
 				info := x86EmitChainExit(cb, targetPC, uint32(instrCount))
 				chainExits = append(chainExits, info)
 				goto done
@@ -4921,6 +4512,7 @@ func x86CompileBlock(instrs []X86JITInstr, startPC uint32, execMem *ExecMem, mem
 	if instrCount == 0 {
 		return nil, fmt.Errorf("no instructions compiled")
 	}
+	x86EmitFPUFlush(cb, cs)
 
 	// Non-terminator exit: emit RetPC/RetCount + full epilogue. The
 	// dispatcher accounting reads RetCount when nonzero and ignores
@@ -5060,6 +4652,8 @@ emitBlocks:
 				lastEmitted = true
 			}
 		}
+		// Block labels are jump targets; nothing stays cached across them.
+		x86EmitFPUFlush(cb, cs)
 
 		// Handle block terminator
 		if len(block) > 0 {
@@ -6,6 +6,8 @@ package main
 
 import (
 	"bytes"
+	"encoding/binary"
+	"math"
 	"testing"
 	"unsafe"
 )
@@ -1253,6 +1255,52 @@ func TestX86JIT_FPU_FABS(t *testing.T) {
 	}
 }
 
+func TestX86JIT_FPU_StackRun(t *testing.T) {
+	r := newX86JITTestRig(t)
+	r.cpu.FPU.Reset()
+
+	// One cached run: pushes, pops and FXCH only reach FPU_X87 at the flush.
+	r.compileAndRun(t, 0x1000,
+		0xD9, 0xE8, // FLD1
+		0xD9, 0xE8, // FLD1
+		0xDE, 0xC1, // FADDP ST(1), ST(0)
+		0xD9, 0xEE, // FLDZ
+		0xD9, 0xC9, // FXCH ST(1)
+		0xDD, 0xD9, // FSTP ST(1)
+	)
+
+	if top := r.cpu.FPU.top(); top != 7 {
+		t.Fatalf("TOP = %d, want 7", top)
+	}
+	if r.cpu.FPU.ST(0) != 2.0 {
+		t.Errorf("ST(0) = %f, want 2.0", r.cpu.FPU.ST(0))
+	}
+	if r.cpu.FPU.FTW != 0x3FFF {
+		t.Errorf("FTW = %04X, want 3FFF (only physical 7 valid)", r.cpu.FPU.FTW)
+	}
+}
+
+func TestX86JIT_FPU_MemoryRun(t *testing.T) {
+	r := newX86JITTestRig(t)
+	r.cpu.FPU.Reset()
+	binary.LittleEndian.PutUint64(r.cpu.memory[0x2000:], math.Float64bits(3.0))
+	binary.LittleEndian.PutUint32(r.cpu.memory[0x2010:], math.Float32bits(0.5))
+
+	r.compileAndRun(t, 0x1000,
+		0xDD, 0x05, 0x00, 0x20, 0x00, 0x00, // FLD qword [0x2000]
+		0xD8, 0x0D, 0x10, 0x20, 0x00, 0x00, // FMUL dword [0x2010]
+		0xDC, 0x2D, 0x00, 0x20, 0x00, 0x00, // FSUBR qword [0x2000]
+		0xDD, 0x1D, 0x08, 0x20, 0x00, 0x00, // FSTP qword [0x2008]
+	)
+
+	if got := math.Float64frombits(binary.LittleEndian.Uint64(r.cpu.memory[0x2008:])); got != 1.5 {
+		t.Errorf("result = %f, want 1.5", got)
+	}
+	if top := r.cpu.FPU.top(); top != 0 || r.cpu.FPU.FTW != 0xFFFF {
+		t.Errorf("TOP/FTW = %d/%04X, want 0/FFFF", top, r.cpu.FPU.FTW)
+	}
+}
+
 // ===========================================================================
 // SETcc / CMOVcc / BSF Tests
 // ===========================================================================
@@ -133,14 +133,12 @@ func (cpu *CPU_X86) X86ExecuteJIT() {
 	// Sync named CPU fields -> jitRegs ONCE at JIT entry.
 	// jitRegs is the canonical state during JIT execution.
 	cpu.syncJITRegsFromNamed()
-	cpu.syncJITSegRegsFromNamed()
 
 	bounded := cpu.x86BudgetActive
 	var budgetPrevCount uint64
 	for cpu.Running() && !cpu.Halted {
 		cpu.syncJITRegsToNamed()
 		if cpu.debugHandleBreakIn(uint64(cpu.EIP)) {
-			cpu.syncJITSegRegsToNamed()
 			return
 		}
 		cpu.syncJITRegsFromNamed()
@@ -150,7 +148,6 @@ func (cpu *CPU_X86) X86ExecuteJIT() {
 			cpu.x86InstrBudget -= int64(delta)
 			if cpu.x86InstrBudget <= 0 {
 				cpu.syncJITRegsToNamed()
-				cpu.syncJITSegRegsToNamed()
 				return
 			}
 		}
@@ -519,7 +516,6 @@ func (cpu *CPU_X86) X86ExecuteJIT() {
 
 	// Sync jitRegs -> named fields ONCE at JIT exit
 	cpu.syncJITRegsToNamed()
-	cpu.syncJITSegRegsToNamed()
 }
 
 // x86RegMapToUint64 packs a [8]byte regMap into a uint64 for runtime
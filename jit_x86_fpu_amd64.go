@@ -0,0 +1,450 @@
+// jit_x86_fpu_amd64.go - x87 FPU emitters with block-level register stack caching
+//
+// (c) 2024-2026 Zayn Otley - GPLv3 or later
+
+//go:build amd64 && (linux || windows || darwin)
+
+/*
+x87 Register Stack Caching
+
+The x87 escapes (D8-DF) are lowered to scalar SSE2 (Tier 1). Rather than
+reading FSW.TOP and addressing FPU_X87.regs[] on every instruction, a run of
+consecutive x87 instructions is compiled against a compile-time model of the
+register stack:
+
+  - TOP is tracked as a delta from its value at the start of the run, so
+    ST(i) resolves to a fixed slot, (delta + i) & 7, at compile time.
+  - Each slot lives in an XMM register (XMM2-XMM9). A slot is loaded from
+    regs[] on first use; FXCH only swaps the slot-to-XMM mapping.
+  - FSW.TOP in memory keeps the run's base TOP until write-back, which is how
+    first-use loads find regs[].
+
+The run is written back (dirty values, tags, TOP) before any non-x87
+instruction, at block and region exits, and in each deferred bail stub
+raised from inside the run, using the cache snapshot taken when the bail was
+recorded. XMM0/XMM1 stay free as scratch. Exception flags are not modelled;
+like the earlier memory-based emitters, results match the interpreter for
+in-range operands.
+*/
+
+package main
+
+import "math"
+
+// FPU_X87 struct field offsets
+const (
+	fpuOffRegs = 0  // regs [8]float64 at offset 0
+	fpuOffFCW  = 64 // FCW uint16
+	fpuOffFSW  = 66 // FSW uint16
+	fpuOffFTW  = 68 // FTW uint16
+)
+
+// x86FPUCacheXMMBase is the first of the eight XMM registers holding slots.
+const x86FPUCacheXMMBase = 2
+
+// x86FPUCache is the compile-time model of the x87 stack for the current run.
+// Slots are indexed relative to the run's base TOP; bit s of each mask refers
+// to slot s.
+type x86FPUCache struct {
+	active bool
+	delta  byte    // (current TOP - base TOP) & 7
+	xmm    [8]byte // slot -> XMM register
+	loaded byte    // slot holds the guest value
+	dirty  byte    // slot value must be stored to regs[]
+	retag  byte    // slot tag must be reclassified from its value
+	empty  byte    // slot was popped; tag becomes empty
+}
+
+// begin opens a run if none is open.
+func (c *x86FPUCache) begin() {
+	if c.active {
+		return
+	}
+	*c = x86FPUCache{active: true}
+	for s := range c.xmm {
+		c.xmm[s] = x86FPUCacheXMMBase + byte(s)
+	}
+}
+
+// slot returns the slot holding ST(i).
+func (c *x86FPUCache) slot(i byte) byte {
+	return (c.delta + i) & 7
+}
+
+// written records that the slot's XMM register now holds a new ST value.
+func (c *x86FPUCache) written(s byte) {
+	bit := byte(1) << s
+	c.loaded |= bit
+	c.dirty |= bit
+	c.retag |= bit
+	c.empty &^= bit
+}
+
+// push decrements TOP and returns the slot of the new ST(0).
+func (c *x86FPUCache) push() byte {
+	c.delta = (c.delta - 1) & 7
+	return c.delta
+}
+
+// pop marks ST(0) empty and increments TOP. Like FPU_X87.pop the value
+// itself is left in place.
+func (c *x86FPUCache) pop() {
+	bit := byte(1) << c.delta
+	c.empty |= bit
+	c.retag &^= bit
+	c.delta = (c.delta + 1) & 7
+}
+
+// x86EmitFPUFlush writes back and closes the current run, if any.
+func x86EmitFPUFlush(cb *CodeBuffer, cs *x86CompileState) {
+	if cs == nil || !cs.fpu.active {
+		return
+	}
+	x86EmitFPUWriteBack(cb, &cs.fpu)
+	cs.fpu = x86FPUCache{}
+}
+
+// x86EmitFPUWriteBack stores dirty slots to regs[], rewrites the affected
+// FTW tags and moves FSW.TOP to the run's current TOP. c is not modified, so
+// a bail stub can write back a snapshot while the run continues inline.
+// Clobbers RAX, RCX, RDX, R8, R10, R11 and host EFLAGS.
+func x86EmitFPUWriteBack(cb *CodeBuffer, c *x86FPUCache) {
+	tags := c.retag | c.empty
+	if !c.active || (c.dirty == 0 && tags == 0 && c.delta == 0) {
+		return
+	}
+	// RAX = FPU, EDX = base TOP (still in FSW)
+	amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffFPUPtr))
+	amd64MOVZX_W_mem(cb, amd64RDX, amd64RAX, fpuOffFSW)
+	amd64SHR_imm32(cb, amd64RDX, x87FSW_TOPShift)
+	amd64ALU_reg_imm32_32bit(cb, 4, amd64RDX, 7)
+
+	for s := byte(0); s < 8; s++ {
+		if c.dirty&(1<<s) != 0 {
+			x86EmitFPUSlotIndexFromBase(cb, s)
+			x86EmitFPURegsAccess(cb, sseOpMOVSDstore, c.xmm[s])
+		}
+	}
+
+	if tags != 0 {
+		amd64MOVZX_W_mem(cb, amd64R11, amd64RAX, fpuOffFTW)
+		for s := byte(0); s < 8; s++ {
+			if tags&(1<<s) == 0 {
+				continue
+			}
+			if c.empty&(1<<s) != 0 {
+				amd64MOV_reg_imm32(cb, amd64R8, uint32(x87TagEmpty))
+			} else {
+				x86EmitFPUClassifyTag(cb, c.xmm[s])
+			}
+			// FTW = FTW &^ (3 << phys*2) | tag << phys*2
+			x86EmitFPUSlotIndexFromBase(cb, s)
+			amd64ALU_reg_reg32(cb, 0x01, amd64RCX, amd64RCX) // ADD ECX, ECX
+			amd64SHL_CL32(cb, amd64R8)
+			amd64MOV_reg_imm32(cb, amd64R10, 3)
+			amd64SHL_CL32(cb, amd64R10)
+			amd64NOT(cb, amd64R10)
+			amd64ALU_reg_reg32(cb, 0x21, amd64R11, amd64R10) // AND R11d, R10d
+			amd64ALU_reg_reg32(cb, 0x09, amd64R11, amd64R8)  // OR R11d, R8d
+		}
+		x86EmitFPUStoreWord(cb, amd64R11, fpuOffFTW)
+	}
+
+	if c.delta != 0 {
+		amd64MOVZX_W_mem(cb, amd64R11, amd64RAX, fpuOffFSW)
+		amd64ALU_reg_imm32_32bit(cb, 4, amd64R11, int32(0xFFFF&^x87FSW_TOPMask))
+		x86EmitFPUSlotIndexFromBase(cb, c.delta)
+		amd64SHL_imm32(cb, amd64RCX, x87FSW_TOPShift)
+		amd64ALU_reg_reg32(cb, 0x09, amd64R11, amd64RCX) // OR R11d, ECX
+		x86EmitFPUStoreWord(cb, amd64R11, fpuOffFSW)
+	}
+}
+
+// x86EmitFPUSlotIndexFromBase sets ECX = (EDX + slot) & 7, the physical
+// register of a slot given the base TOP in EDX.
+func x86EmitFPUSlotIndexFromBase(cb *CodeBuffer, slot byte) {
+	amd64LEA_reg_memDisp32(cb, amd64RCX, amd64RDX, int32(slot))
+	amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
+}
+
+// x86EmitFPURegsAccess emits MOVSD between an XMM register and
+// regs[RCX] (opcode sseOpMOVSDload or sseOpMOVSDstore). RAX = FPU.
+func x86EmitFPURegsAccess(cb *CodeBuffer, opcode, xmm byte) {
+	cb.EmitBytes(0xF2)
+	emitREX_SIB(cb, false, xmm, amd64RCX, amd64RAX)
+	cb.EmitBytes(0x0F, opcode, modRM(0, xmm, 4), sibByte(3, amd64RCX, amd64RAX))
+}
+
+// x86EmitFPUStoreWord emits MOV WORD [RAX+off], src.
+func x86EmitFPUStoreWord(cb *CodeBuffer, src byte, off byte) {
+	cb.EmitBytes(0x66)
+	emitREX(cb, false, src, amd64RAX)
+	cb.EmitBytes(0x89, modRM(1, src, amd64RAX), off)
+}
+
+// x86EmitFPUClassifyTag sets R8d to the FTW tag classifyTag would give the
+// double in xmm.
+func x86EmitFPUClassifyTag(cb *CodeBuffer, xmm byte) {
+	amd64MOVQ_reg_xmm(cb, amd64R8, xmm)
+	amd64SHL_imm(cb, amd64R8, 1) // drop the sign; ZF = ±0
+	zeroJmp := amd64Jcc_rel32(cb, amd64CondE)
+	amd64SHR_imm(cb, amd64R8, 53) // biased exponent; ZF = subnormal
+	denormJmp := amd64Jcc_rel32(cb, amd64CondE)
+	amd64ALU_reg_imm32_32bit(cb, 7, amd64R8, 0x7FF) // CMP: NaN/Inf
+	specialJmp := amd64Jcc_rel32(cb, amd64CondE)
+	amd64MOV_reg_imm32(cb, amd64R8, uint32(x87TagValid))
+	validDone := amd64JMP_rel32(cb)
+
+	patchRel32(cb, zeroJmp, cb.Len())
+	amd64MOV_reg_imm32(cb, amd64R8, uint32(x87TagZero))
+	zeroDone := amd64JMP_rel32(cb)
+
+	patchRel32(cb, denormJmp, cb.Len())
+	patchRel32(cb, specialJmp, cb.Len())
+	amd64MOV_reg_imm32(cb, amd64R8, uint32(x87TagSpecial))
+
+	patchRel32(cb, validDone, cb.Len())
+	patchRel32(cb, zeroDone, cb.Len())
+}
+
+// x86EmitFPUUse makes sure ST(i) is in its XMM register and returns that
+// register. Clobbers RAX and RCX on a first use.
+func x86EmitFPUUse(cb *CodeBuffer, c *x86FPUCache, i byte) byte {
+	s := c.slot(i)
+	if c.loaded&(1<<s) == 0 {
+		// FSW.TOP still holds the base TOP while the run is open.
+		amd64MOV_reg_mem(cb, amd64RAX, x86AMD64RegCtx, int32(x86CtxOffFPUPtr))
+		amd64MOVZX_W_mem(cb, amd64RCX, amd64RAX, fpuOffFSW)
+		amd64SHR_imm32(cb, amd64RCX, x87FSW_TOPShift)
+		if s != 0 {
+			amd64ALU_reg_imm32_32bit(cb, 0, amd64RCX, int32(s))
+		}
+		amd64ALU_reg_imm32_32bit(cb, 4, amd64RCX, 7)
+		x86EmitFPURegsAccess(cb, sseOpMOVSDload, c.xmm[s])
+		c.loaded |= 1 << s
+	}
+	return c.xmm[s]
+}
+
+// x86FPUArith maps an x87 arithmetic reg field (x87BinaryOpTable order) to
+// its SSE2 opcode. reverse selects FSUBR/FDIVR operand order.
+var x86FPUArith = [8]struct {
+	sseOp   byte
+	reverse bool
+	ok      bool
+}{
+	0: {sseOpADDSD, false, true},
+	1: {sseOpMULSD, false, true},
+	4: {sseOpSUBSD, false, true},
+	5: {sseOpSUBSD, true, true},
+	6: {sseOpDIVSD, false, true},
+	7: {sseOpDIVSD, true, true},
+}
+
+// amd64MOVAPD_rr emits MOVAPD dst, src (66 0F 28), a full register copy
+// without MOVSD's merge dependency on dst.
+func amd64MOVAPD_rr(cb *CodeBuffer, dst, src byte) { amd64SSEpd_rr(cb, 0x28, dst, src) }
+
+// x86EmitFPUArith emits ST(dst) = ST(dst) op src, where src is an XMM
+// register.
+func x86EmitFPUArith(cb *CodeBuffer, c *x86FPUCache, op byte, dst byte, src byte) {
+	d := x86EmitFPUUse(cb, c, dst)
+	a := x86FPUArith[op]
+	if a.reverse {
+		amd64MOVAPD_rr(cb, 1, src)
+		amd64SSEsd_rr(cb, a.sseOp, 1, d)
+		amd64MOVAPD_rr(cb, d, 1)
+	} else {
+		amd64SSEsd_rr(cb, a.sseOp, d, src)
+	}
+	c.written(c.slot(dst))
+}
+
+// x86EmitFPU dispatches x87 FPU instructions (D8-DF). Unsupported forms
+// return false without emitting code or touching the stack model.
+func x86EmitFPU(cb *CodeBuffer, ji *X86JITInstr, memory []byte, cs *x86CompileState, instrIdx int) bool {
+	if !ji.hasModRM {
+		return false
+	}
+	escape := byte(ji.opcode)
+	modrm := ji.modrm
+	mod := modrm >> 6
+	regOp := (modrm >> 3) & 7
+	rm := modrm & 7
+	c := &cs.fpu
+
+	if mod == 3 {
+		switch escape {
+		case 0xD8: // FADD/FMUL/FSUB/FSUBR/FDIV/FDIVR ST(0), ST(i)
+			if x86FPUArith[regOp].ok {
+				c.begin()
+				x86EmitFPUArith(cb, c, regOp, 0, x86EmitFPUUse(cb, c, rm))
+				return true
+			}
+		case 0xDC, 0xDE: // op ST(i), ST(0) / opP ST(i), ST(0)
+			if x86FPUArith[regOp].ok {
+				op := regOp
+				if op >= 4 {
+					op ^= 1 // SUB/SUBR and DIV/DIVR are swapped in these forms
+				}
+				c.begin()
+				x86EmitFPUArith(cb, c, op, rm, x86EmitFPUUse(cb, c, 0))
+				if escape == 0xDE {
+					c.pop()
+				}
+				return true
+			}
+		case 0xD9:
+			switch {
+			case modrm <= 0xC7: // FLD ST(i)
+				c.begin()
+				src := x86EmitFPUUse(cb, c, rm)
+				s := c.push()
+				amd64MOVAPD_rr(cb, c.xmm[s], src)
+				c.written(s)
+				return true
+			case modrm <= 0xCF: // FXCH ST(i)
+				c.begin()
+				x86EmitFPUUse(cb, c, 0)
+				x86EmitFPUUse(cb, c, rm)
+				s0, si := c.slot(0), c.slot(rm)
+				c.xmm[s0], c.xmm[si] = c.xmm[si], c.xmm[s0]
+				c.written(s0)
+				c.written(si)
+				return true
+			case modrm == 0xE0: // FCHS
+				c.begin()
+				x86EmitFPUSignOp(cb, c, 0x57, 0x8000000000000000) // XORPD
+				return true
+			case modrm == 0xE1: // FABS
+				c.begin()
+				x86EmitFPUSignOp(cb, c, 0x54, 0x7FFFFFFFFFFFFFFF) // ANDPD
+				return true
+			case modrm == 0xE8: // FLD1
+				c.begin()
+				s := c.push()
+				amd64MOV_reg_imm64(cb, amd64R8, math.Float64bits(1.0))
+				amd64MOVQ_xmm_reg(cb, c.xmm[s], amd64R8)
+				c.written(s)
+				return true
+			case modrm == 0xEE: // FLDZ
+				c.begin()
+				s := c.push()
+				amd64XORPD_rr(cb, c.xmm[s], c.xmm[s])
+				c.written(s)
+				return true
+			}
+		case 0xDD:
+			if modrm >= 0xD0 && modrm <= 0xDF { // FST / FSTP ST(i)
+				c.begin()
+				x86EmitFPUStoreST(cb, c, rm)
+				if modrm >= 0xD8 {
+					c.pop()
+				}
+				return true
+			}
+		}
+		return false
+	}
+
+	switch {
+	case (escape == 0xD8 || escape == 0xDC) && x86FPUArith[regOp].ok: // op ST(0), m32/m64
+		return x86EmitFPUArithMem(cb, ji, memory, c, regOp, escape == 0xD8, instrIdx)
+	case (escape == 0xD9 || escape == 0xDD) && regOp == 0: // FLD m32/m64
+		return x86EmitFPULoadMem(cb, ji, memory, c, escape == 0xD9, instrIdx)
+	case (escape == 0xD9 || escape == 0xDD) && (regOp == 2 || regOp == 3): // FST/FSTP m32/m64
+		return x86EmitFPUStoreMem(cb, ji, memory, c, escape == 0xD9, regOp == 3, instrIdx)
+	}
+	return false
+}
+
+// x86EmitFPUSignOp applies a sign-bit mask to ST(0) with ANDPD/XORPD.
+func x86EmitFPUSignOp(cb *CodeBuffer, c *x86FPUCache, opcode byte, mask uint64) {
+	x := x86EmitFPUUse(cb, c, 0)
+	amd64MOV_reg_imm64(cb, amd64R8, mask)
+	amd64MOVQ_xmm_reg(cb, 0, amd64R8)
+	amd64SSEpd_rr(cb, opcode, x, 0)
+	c.written(c.slot(0))
+}
+
+// x86EmitFPUStoreST emits FST ST(i): ST(i) = ST(0).
+func x86EmitFPUStoreST(cb *CodeBuffer, c *x86FPUCache, i byte) {
+	src := x86EmitFPUUse(cb, c, 0)
+	s := c.slot(i)
+	if i != 0 {
+		amd64MOVAPD_rr(cb, c.xmm[s], src)
+	}
+	c.written(s)
+}
+
+// x86EmitFPUMemEA computes the operand address into R10 and emits the I/O
+// check. Bails taken here write back the stack as it was before this
+// instruction.
+func x86EmitFPUMemEA(cb *CodeBuffer, ji *X86JITInstr, memory []byte, instrIdx int) bool {
+	if !x86EmitComputeEA(cb, ji, memory, amd64R10) {
+		return false
+	}
+	x86EmitIOCheckMaybeElide(cb, amd64R10, ji, memory, instrIdx)
+	return true
+}
+
+// x86EmitFPUMemAccess emits MOVSD/MOVSS between xmm and [memBase + R10].
+func x86EmitFPUMemAccess(cb *CodeBuffer, opcode, xmm byte, single bool) {
+	if single {
+		cb.EmitBytes(0xF3)
+	} else {
+		cb.EmitBytes(0xF2)
+	}
+	emitREX_SIB(cb, false, xmm, amd64R10, x86AMD64RegMemBase)
+	cb.EmitBytes(0x0F, opcode, modRM(0, xmm, 4), sibByte(0, amd64R10, x86AMD64RegMemBase))
+}
+
+// x86EmitFPULoadOperand loads a float32/float64 memory operand into xmm as a double.
+func x86EmitFPULoadOperand(cb *CodeBuffer, xmm byte, single bool) {
+	x86EmitFPUMemAccess(cb, sseOpMOVSDload, xmm, single)
+	if single {
+		amd64CVTSS2SD_rr(cb, xmm, xmm)
+	}
+}
+
+// x86EmitFPULoadMem emits FLD m32/m64.
+func x86EmitFPULoadMem(cb *CodeBuffer, ji *X86JITInstr, memory []byte, c *x86FPUCache, single bool, instrIdx int) bool {
+	c.begin()
+	if !x86EmitFPUMemEA(cb, ji, memory, instrIdx) {
+		return false
+	}
+	s := c.push()
+	x86EmitFPULoadOperand(cb, c.xmm[s], single)
+	c.written(s)
+	return true
+}
+
+// x86EmitFPUArithMem emits FADD/FMUL/FSUB/FSUBR/FDIV/FDIVR ST(0), m32/m64.
+func x86EmitFPUArithMem(cb *CodeBuffer, ji *X86JITInstr, memory []byte, c *x86FPUCache, op byte, single bool, instrIdx int) bool {
+	c.begin()
+	if !x86EmitFPUMemEA(cb, ji, memory, instrIdx) {
+		return false
+	}
+	x86EmitFPULoadOperand(cb, 0, single)
+	x86EmitFPUArith(cb, c, op, 0, 0)
+	return true
+}
+
+// x86EmitFPUStoreMem emits FST/FSTP m32/m64.
+func x86EmitFPUStoreMem(cb *CodeBuffer, ji *X86JITInstr, memory []byte, c *x86FPUCache, single, pop bool, instrIdx int) bool {
+	c.begin()
+	if !x86EmitFPUMemEA(cb, ji, memory, instrIdx) {
+		return false
+	}
+	x := x86EmitFPUUse(cb, c, 0)
+	if single {
+		amd64CVTSD2SS_rr(cb, 0, x)
+		x = 0
+	}
+	x86EmitFPUMemAccess(cb, sseOpMOVSDstore, x, single)
+	if pop {
+		c.pop()
+	}
+	x86EmitSelfModCheckMaybeElide(cb, amd64R10, ji, memory, ji.opcodePC+uint32(ji.length), instrIdx+1)
+	return true
+}
@@ -1,6 +1,6 @@
-// jit_x86_segment_test.go - Slice-3 segment-override prefix correctness.
-// Verifies that JIT-compiled blocks bail prefixed memory ops to the
-// interpreter so segment base addition matches.
+// jit_x86_segment_test.go - Segment-override prefix and far-pointer
+// correctness. Prefixed memory ops and LES/LDS compile natively; the
+// results must match the interpreter's flat segmentation.
 //
 // (c) 2024-2026 Zayn Otley - GPLv3 or later
 
@@ -20,8 +20,7 @@ import (
 //
 // With prefixSeg = DS and DS = 0 (the IE default at boot), the segment
 // base is 0 and the effective address equals the flat offset — the
-// JIT's bail-to-interp path must produce the same result as a plain
-// MOV without the prefix.
+// native prefixed MOV must produce the same result as a plain MOV.
 func TestX86JIT_SegmentOverride_DSExplicit(t *testing.T) {
 	// 0x10000: MOV ECX, 0x12345678            (B9 78 56 34 12)
 	// 0x10005: DS: MOV [ESI+0x10], ECX        (3E 89 4E 10)
@@ -46,8 +45,8 @@ func TestX86JIT_SegmentOverride_DSExplicit(t *testing.T) {
 }
 
 // TestX86JIT_SegmentOverride_FSAccess verifies FS-prefixed access with
-// FS=0 (default). Both interp and JIT should agree (interp resolves
-// via prefixSeg → readSegBase(FS), which is 0; JIT bails to interp).
+// FS=0 (default). Both interp and JIT should agree: segment bases are
+// always zero, so the prefix does not change the effective address.
 func TestX86JIT_SegmentOverride_FSAccess(t *testing.T) {
 	if !x86JitAvailable {
 		t.Skip("x86 JIT not available")
@@ -171,6 +170,90 @@ func TestX86JIT_SegmentOverride_GSAccess(t *testing.T) {
 	}
 }
 
+// TestX86JIT_SegmentOverride_CompilesNatively checks that prefixed
+// instructions no longer end the block: every instruction before HLT
+// must be compiled.
+func TestX86JIT_SegmentOverride_CompilesNatively(t *testing.T) {
+	r := newX86JITTestRig(t)
+	code := []byte{
+		0x64, 0x89, 0x4E, 0x20, // FS: MOV [ESI+0x20], ECX
+		0x65, 0x8B, 0x46, 0x20, // GS: MOV EAX, [ESI+0x20]
+		0x64, 0xA1, 0x20, 0x00, 0x02, 0x00, // FS: MOV EAX, [0x20020]
+		0x2E, 0x01, 0xC3, // CS: ADD EBX, EAX (prefix has no effect)
+		0xF4, // HLT
+	}
+	copy(r.cpu.memory[0x1000:], code)
+	instrs := x86ScanBlock(r.cpu.memory, 0x1000)
+	if len(instrs) != 5 {
+		t.Fatalf("scanned %d instructions, want 5", len(instrs))
+	}
+	block, err := x86CompileBlock(instrs[:4], 0x1000, r.execMem, r.cpu.memory)
+	if err != nil {
+		t.Fatalf("x86CompileBlock: %v", err)
+	}
+	if block.instrCount != 4 {
+		t.Errorf("compiled %d instructions, want 4", block.instrCount)
+	}
+}
+
+// TestX86JIT_SegmentOverride_Moffs covers the A1/A3 moffs32 forms, whose
+// address follows any prefix bytes (the common FS:[imm32] TLS pattern).
+func TestX86JIT_SegmentOverride_Moffs(t *testing.T) {
+	code := []byte{
+		0xB9, 0x44, 0x33, 0x22, 0x11, // MOV ECX, 0x11223344
+		0x89, 0x0D, 0x40, 0x00, 0x02, 0x00, // MOV [0x20040], ECX
+		0x64, 0xA1, 0x40, 0x00, 0x02, 0x00, // FS: MOV EAX, [0x20040]
+		0x65, 0xA3, 0x48, 0x00, 0x02, 0x00, // GS: MOV [0x20048], EAX
+		0xF4, // HLT
+	}
+	interp, jit := x86CallRetHarness(t, code)
+	if interp.EAX != 0x11223344 {
+		t.Errorf("interp EAX = 0x%X, want 0x11223344", interp.EAX)
+	}
+	if interp.EAX != jit.EAX {
+		t.Errorf("EAX mismatch: interp=%08X jit=%08X", interp.EAX, jit.EAX)
+	}
+	if !memEqual(interp.memory[0x20048:0x2004C], jit.memory[0x20048:0x2004C]) {
+		t.Errorf("memory diff: interp=%X jit=%X",
+			interp.memory[0x20048:0x2004C], jit.memory[0x20048:0x2004C])
+	}
+}
+
+// TestX86JIT_LESLDS loads far pointers natively and reads the selectors
+// back with MOV r/m, Sreg, which also runs natively from jitSegRegs.
+func TestX86JIT_LESLDS(t *testing.T) {
+	code := []byte{
+		0xC5, 0x06, // LDS EAX, [ESI]
+		0xC4, 0x56, 0x08, // LES EDX, [ESI+8]
+		0x8C, 0xD9, // MOV ECX, DS
+		0x8C, 0xC3, // MOV EBX, ES
+		0xF4, // HLT
+	}
+	interp, jit := x86CallRetHarnessWithSetup(t, code, func(cpu *CPU_X86) {
+		copy(cpu.memory[0x20000:], []byte{0x78, 0x56, 0x34, 0x12, 0x23, 0x00})
+		copy(cpu.memory[0x20008:], []byte{0xEF, 0xBE, 0xAD, 0xDE, 0x2B, 0x00})
+	})
+	if interp.EAX != 0x12345678 || interp.DS != 0x23 || interp.EDX != 0xDEADBEEF || interp.ES != 0x2B {
+		t.Fatalf("interp EAX/DS/EDX/ES = %08X/%04X/%08X/%04X (program is broken)",
+			interp.EAX, interp.DS, interp.EDX, interp.ES)
+	}
+	for _, c := range []struct {
+		name     string
+		got, exp uint32
+	}{
+		{"EAX", jit.EAX, interp.EAX},
+		{"EDX", jit.EDX, interp.EDX},
+		{"ECX", jit.ECX, interp.ECX},
+		{"EBX", jit.EBX, interp.EBX},
+		{"DS", uint32(jit.DS), uint32(interp.DS)},
+		{"ES", uint32(jit.ES), uint32(interp.ES)},
+	} {
+		if c.got != c.exp {
+			t.Errorf("%s mismatch: interp=%X jit=%X", c.name, c.exp, c.got)
+		}
+	}
+}
+
 func memEqual(a, b []byte) bool {
 	if len(a) != len(b) {
 		return false
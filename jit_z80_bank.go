@@ -0,0 +1,309 @@
+// jit_z80_bank.go - Bank-configuration-aware Z80 JIT code cache
+//
+// The IE80 bank windows ($2000-$7FFF in 8KB banks, $8000-$BFFF as the
+// VRAM window) are resolved per 256-byte page into Z80JITContext.PageXlat.
+// A window page whose current target is plain RAM is marked z80PageBanked
+// in directPageBitmap: native loads and stores translate through PageXlat
+// instead of bailing, and code on the page is scanned and compiled from
+// its physical bytes.
+//
+// Compiled blocks are keyed by (PC, physical page). A banked block never
+// leaves its page, so when a window is switched only the blocks on its
+// pages are retired, and they are parked rather than discarded: switching
+// the bank back re-installs them once their source bytes are verified.
+//
+// Self-modification is tracked by physical page. codePageBitmap flags every
+// Z80 page currently mapped onto a page holding compiled code, so native
+// writes through any alias raise NeedInval, and the bus adapter reports
+// interpreter writes to such pages.
+
+//go:build (amd64 && (linux || windows || darwin)) || (arm64 && linux)
+
+package main
+
+// directPageBitmap entries.
+const (
+	z80PageDirect = 0 // identity-mapped RAM, accessed at MemPtr + addr
+	z80PageSlow   = 1 // I/O or untranslatable, bail to the interpreter
+	z80PageBanked = 2 // bank window onto RAM, accessed via PageXlat
+)
+
+// z80NoPhysPage marks a PageXlat entry with no RAM behind it.
+const z80NoPhysPage = 0xFFFFFFFF
+
+// Z80 pages covered by the bank and VRAM windows.
+const (
+	z80BankFirstPage = Z80_BANK1_WINDOW_BASE >> 8
+	z80BankLastPage  = (Z80_VRAM_BANK_WINDOW_BASE+Z80_VRAM_BANK_WINDOW_SIZE)>>8 - 1
+)
+
+// z80MaxParkedBlocks bounds the retired-block pool. Parked code stays in
+// ExecMem until the next full flush, so the pool is simply dropped when
+// it fills.
+const z80MaxParkedBlocks = 4096
+
+// z80BankMapping captures every adapter field that decides where the
+// window pages point.
+type z80BankMapping struct {
+	bank        [3]uint32
+	enable      [3]bool
+	vramBank    uint32
+	vramEnabled bool
+	vgaVramBank byte
+}
+
+func z80CurrentBankMapping(a *Z80BusAdapter) z80BankMapping {
+	return z80BankMapping{
+		bank:        [3]uint32{a.bank1, a.bank2, a.bank3},
+		enable:      [3]bool{a.bank1Enable, a.bank2Enable, a.bank3Enable},
+		vramBank:    a.vramBank,
+		vramEnabled: a.vramEnabled,
+		vgaVramBank: a.vgaVramBank,
+	}
+}
+
+type z80BankedKey struct {
+	pc   uint16
+	phys uint32
+}
+
+type z80ParkedBlock struct {
+	block *JITBlock
+	src   []byte // guest bytes the block was compiled from
+}
+
+// z80BankJITState is the JIT's view of the bank configuration.
+type z80BankJITState struct {
+	mapping z80BankMapping
+	synced  bool
+	parked  map[z80BankedKey]*z80ParkedBlock
+	scan    []byte // 64KB scan image; only the page being compiled is filled
+}
+
+// z80BankedScanFence stops a banked scan at its own page boundary.
+var z80BankedScanFence = func() (f [256]byte) {
+	for i := range f {
+		f[i] = z80PageSlow
+	}
+	return
+}()
+
+func (cpu *CPU_Z80) z80BankState() *z80BankJITState {
+	if st, ok := cpu.jitBankState.(*z80BankJITState); ok {
+		return st
+	}
+	st := &z80BankJITState{parked: make(map[z80BankedKey]*z80ParkedBlock)}
+	cpu.jitBankState = st
+	return st
+}
+
+// z80JITResolvePage returns the directPageBitmap kind and MachineBus page
+// base of a window page under the adapter's current bank registers,
+// mirroring Z80BusAdapter.Read/Write.
+func z80JITResolvePage(a *Z80BusAdapter, mem []byte, page int) (byte, uint32) {
+	addr := uint16(page) << 8
+	phys, ok := a.translateExtendedBank(addr)
+	if ok {
+		if last, _ := a.translateExtendedBank(addr | 0xFF); last != phys+0xFF {
+			return z80PageSlow, z80NoPhysPage
+		}
+	} else if a.vgaEngine != nil && a.vgaVramBank&0x80 != 0 && addr >= Z80_VRAM_BANK_WINDOW_BASE {
+		return z80PageSlow, z80NoPhysPage // VGA planes go through the engine
+	} else if phys, ok = a.translateVRAM(addr); !ok {
+		phys = translateIO8Bit(addr)
+	}
+	if uint64(phys)+0x100 > uint64(len(mem)) {
+		return z80PageSlow, z80NoPhysPage
+	}
+	if io := a.bus.ioPageBitmap; int(phys>>8) < len(io) && io[phys>>8] {
+		return z80PageSlow, z80NoPhysPage
+	}
+	if phys == uint32(addr) {
+		return z80PageDirect, phys
+	}
+	return z80PageBanked, phys
+}
+
+// z80JITSyncBanks brings directPageBitmap, PageXlat and the code cache in
+// line with the adapter's bank registers, and applies interpreter writes
+// to compiled code. Called before every dispatch; both checks are cheap
+// when nothing changed.
+func (cpu *CPU_Z80) z80JITSyncBanks(adapter *Z80BusAdapter, ctx *Z80JITContext, mem []byte) {
+	if len(adapter.jitDirtyPages) != 0 {
+		for _, phys := range adapter.jitDirtyPages {
+			cpu.z80JITInvalidatePhys(adapter, ctx, phys)
+		}
+		adapter.jitDirtyPages = adapter.jitDirtyPages[:0]
+	}
+
+	st := cpu.z80BankState()
+	m := z80CurrentBankMapping(adapter)
+	if st.synced && m == st.mapping {
+		return
+	}
+	st.mapping, st.synced = m, true
+
+	var kinds [256]byte
+	var xlat [256]uint32
+	var changed [256]bool
+	remapped := false
+	for page := z80BankFirstPage; page <= z80BankLastPage; page++ {
+		kinds[page], xlat[page] = z80JITResolvePage(adapter, mem, page)
+		if kinds[page] != cpu.directPageBitmap[page] || xlat[page] != ctx.PageXlat[page] {
+			changed[page] = true
+			remapped = true
+		}
+	}
+	if !remapped {
+		return
+	}
+
+	// Park banked blocks on remapped pages before they are invalidated.
+	for _, block := range cpu.jitCache.blocks {
+		page := block.startPC >> 8
+		if !changed[page] || cpu.directPageBitmap[page] != z80PageBanked {
+			continue
+		}
+		if len(st.parked) >= z80MaxParkedBlocks {
+			clear(st.parked)
+		}
+		phys := ctx.PageXlat[page] + uint32(block.startPC&0xFF)
+		src := append([]byte(nil), mem[phys:phys+uint32(block.endPC-block.startPC)]...)
+		for _, slot := range block.chainSlots {
+			PatchRel32At(slot.patchAddr, slot.patchAddr+4)
+		}
+		st.parked[z80BankedKey{pc: uint16(block.startPC), phys: ctx.PageXlat[page]}] = &z80ParkedBlock{block: block, src: src}
+	}
+
+	for lo := z80BankFirstPage; lo <= z80BankLastPage; {
+		if !changed[lo] {
+			lo++
+			continue
+		}
+		hi := lo
+		for hi <= z80BankLastPage && changed[hi] {
+			cpu.directPageBitmap[hi] = kinds[hi]
+			ctx.PageXlat[hi] = xlat[hi]
+			cpu.codePageBitmap[hi] = 0
+			if _, ok := adapter.jitCodePages[xlat[hi]]; ok {
+				cpu.codePageBitmap[hi] = 1
+			}
+			hi++
+		}
+		cpu.jitCache.UnpatchChainsInRange(uint64(lo)<<8, uint64(hi)<<8)
+		cpu.jitCache.InvalidateRange(uint64(lo)<<8, uint64(hi)<<8)
+		lo = hi
+	}
+	cpu.z80JITClearDispatchCaches(ctx)
+}
+
+// z80JITClearDispatchCaches drops the RET target and turbo caches, which
+// may refer to blocks that were just removed.
+func (cpu *CPU_Z80) z80JITClearDispatchCaches(ctx *Z80JITContext) {
+	ctx.RTSCache0PC = 0
+	ctx.RTSCache0Addr = 0
+	ctx.RTSCache1PC = 0
+	ctx.RTSCache1Addr = 0
+	cpu.jitTurboCache = nil
+}
+
+// z80JITInvalidatePage handles NeedInval for a Z80 page: every page
+// aliasing the same physical page loses its blocks.
+func (cpu *CPU_Z80) z80JITInvalidatePage(adapter *Z80BusAdapter, ctx *Z80JITContext, page uint32) {
+	if phys := ctx.PageXlat[page&0xFF]; phys != z80NoPhysPage {
+		cpu.z80JITInvalidatePhys(adapter, ctx, phys)
+		return
+	}
+	lo := uint64(page) << 8
+	cpu.jitCache.UnpatchChainsInRange(lo, lo+256)
+	cpu.jitCache.InvalidateRange(lo, lo+256)
+	cpu.z80JITClearDispatchCaches(ctx)
+}
+
+// z80JITInvalidatePhys removes every block compiled from the physical
+// page phys. Parked blocks are left alone; they are re-verified against
+// memory before reuse.
+func (cpu *CPU_Z80) z80JITInvalidatePhys(adapter *Z80BusAdapter, ctx *Z80JITContext, phys uint32) {
+	for page := range ctx.PageXlat {
+		if ctx.PageXlat[page] != phys {
+			continue
+		}
+		lo := uint64(page) << 8
+		cpu.jitCache.UnpatchChainsInRange(lo, lo+256)
+		cpu.jitCache.InvalidateRange(lo, lo+256)
+	}
+	delete(adapter.jitCodePages, phys)
+	cpu.z80JITClearDispatchCaches(ctx)
+}
+
+// z80JITScanBanked scans a block on a banked page from its physical bytes.
+func (cpu *CPU_Z80) z80JITScanBanked(ctx *Z80JITContext, mem []byte, pc uint16) []JITZ80Instr {
+	st := cpu.z80BankState()
+	if st.scan == nil {
+		st.scan = make([]byte, 0x10000)
+	}
+	base := pc &^ 0xFF
+	phys := ctx.PageXlat[pc>>8]
+	copy(st.scan[base:uint32(base)+0x100], mem[phys:phys+0x100])
+	return z80JITScanBlock(st.scan, pc, len(st.scan), &z80BankedScanFence)
+}
+
+// z80JITUnparkBlock returns the parked block for pc under the current
+// mapping of its page, provided its source bytes are unchanged.
+func (cpu *CPU_Z80) z80JITUnparkBlock(ctx *Z80JITContext, mem []byte, pc uint16) *JITBlock {
+	st := cpu.z80BankState()
+	key := z80BankedKey{pc: pc, phys: ctx.PageXlat[pc>>8]}
+	pb := st.parked[key]
+	if pb == nil {
+		return nil
+	}
+	delete(st.parked, key)
+	phys := key.phys + uint32(pc&0xFF)
+	if string(mem[phys:phys+uint32(len(pb.src))]) != string(pb.src) {
+		return nil
+	}
+	return pb.block
+}
+
+// z80JITInstallBlock caches block, links chains in both directions and
+// records the physical pages its code came from.
+func (cpu *CPU_Z80) z80JITInstallBlock(adapter *Z80BusAdapter, ctx *Z80JITContext, block *JITBlock) {
+	cpu.jitCache.Put(block)
+	if block.chainEntry != 0 {
+		cpu.jitCache.PatchChainsTo(block.startPC, block.chainEntry)
+	}
+	for i := range block.chainSlots {
+		slot := &block.chainSlots[i]
+		if target := cpu.jitCache.Get(slot.targetPC); target != nil && target.chainEntry != 0 {
+			PatchRel32At(slot.patchAddr, target.chainEntry)
+		}
+	}
+
+	if adapter.jitCodePages == nil {
+		adapter.jitCodePages = make(map[uint32]struct{})
+	}
+	for page := block.startPC >> 8; page <= (block.endPC-1)>>8 && page < 0x100; page++ {
+		phys := ctx.PageXlat[page]
+		if phys == z80NoPhysPage {
+			continue
+		}
+		if _, ok := adapter.jitCodePages[phys]; ok {
+			continue
+		}
+		adapter.jitCodePages[phys] = struct{}{}
+		for alias := range ctx.PageXlat {
+			if ctx.PageXlat[alias] == phys {
+				cpu.codePageBitmap[alias] = 1
+			}
+		}
+	}
+}
+
+// z80JITResetBankState forgets parked blocks and code-page ownership.
+// Called on a full flush, when ExecMem is recycled.
+func (cpu *CPU_Z80) z80JITResetBankState(adapter *Z80BusAdapter) {
+	if st, ok := cpu.jitBankState.(*z80BankJITState); ok {
+		clear(st.parked)
+	}
+	clear(adapter.jitCodePages)
+}
@@ -38,6 +38,11 @@ type Z80JITContext struct {
 	ChainCycles         uint64  // 120: accumulated T-states across chained blocks
 	ChainRIncrements    uint32  // 128: accumulated R register increments across chain
 	CycleBudget         uint32  // 132: max cycles before forced Go return (interrupt budget)
+
+	// PageXlat maps each Z80 page to the MachineBus address of its first
+	// byte under the current bank configuration. Native code consults it
+	// for pages marked z80PageBanked in directPageBitmap.
+	PageXlat [256]uint32 // 136: physical page base per Z80 page
 }
 
 // Z80JITContext field offsets (must match struct layout above).
@@ -64,6 +69,7 @@ const (
 	jzCtxOffChainCycles         = 120
 	jzCtxOffChainRIncrements    = 128
 	jzCtxOffCycleBudget         = 132
+	jzCtxOffPageXlat            = 136
 )
 
 // CPU_Z80 struct field offsets (from CpuPtr). Must match cpu_z80.go layout.
@@ -1455,6 +1461,13 @@ func newZ80JITContext(cpu *CPU_Z80, adapter *Z80BusAdapter) *Z80JITContext {
 		ParityTablePtr:      uintptr(unsafe.Pointer(&z80ParityTable[0])),
 		DAATablePtr:         uintptr(unsafe.Pointer(&z80DAATable[0])),
 	}
+	for page := range ctx.PageXlat {
+		if cpu.directPageBitmap[page] == z80PageDirect {
+			ctx.PageXlat[page] = uint32(page) << 8
+		} else {
+			ctx.PageXlat[page] = z80NoPhysPage
+		}
+	}
 	return ctx
 }
 
@@ -43,6 +43,7 @@ func TestZ80JITContext_FieldOffsets(t *testing.T) {
 		{"ChainCycles", uintptr(unsafe.Pointer(&ctx.ChainCycles)) - base, jzCtxOffChainCycles},
 		{"ChainRIncrements", uintptr(unsafe.Pointer(&ctx.ChainRIncrements)) - base, jzCtxOffChainRIncrements},
 		{"CycleBudget", uintptr(unsafe.Pointer(&ctx.CycleBudget)) - base, jzCtxOffCycleBudget},
+		{"PageXlat", uintptr(unsafe.Pointer(&ctx.PageXlat)) - base, jzCtxOffPageXlat},
 	}
 
 	for _, tt := range tests {
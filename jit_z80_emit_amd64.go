@@ -263,32 +263,69 @@ func z80EmitWritePair16(buf *CodeBuffer, pairCode byte) {
 // Memory Access Helpers
 // ===========================================================================
 
+// z80EmitBankedXlat emits the banked-page leg of a checked memory access.
+// On entry ECX = Z80 page, AL = offset within it and kindReg holds the
+// page's directPageBitmap entry (known non-zero). Pages other than
+// z80PageBanked jump to bailLabel; banked pages leave the MachineBus
+// address in kindReg, read from ctx.PageXlat.
+func z80EmitBankedXlat(buf *CodeBuffer, kindReg byte, bailLabel string) {
+	// CMP kindReg, z80PageBanked; JNE bail
+	emitREX(buf, false, 0, kindReg)
+	buf.EmitBytes(0x83, modRM(3, 7, kindReg), z80PageBanked)
+	buf.EmitBytes(0x0F, 0x85)
+	buf.FixupRel32(bailLabel, buf.Len()+4)
+	// MOVZX kindReg, AL
+	emitREX(buf, false, kindReg, z80Scratch1)
+	buf.EmitBytes(0x0F, 0xB6, modRM(3, kindReg, z80Scratch1))
+	// ADD kindReg, [R15 + PageXlat + RCX*4]
+	emitREX_SIB(buf, false, kindReg, z80Scratch2, z80RegCtx)
+	buf.EmitBytes(0x03, modRM(2, kindReg, 4), sibByte(2, z80Scratch2, z80RegCtx))
+	buf.Emit32(uint32(jzCtxOffPageXlat))
+}
+
 // z80EmitMemRead emits code to read a byte from Z80 address in AX into AL,
-// with direct page bitmap check. If the page is non-direct, jumps to the
-// bail label. addrReg must be z80Scratch1 (RAX).
-// After call: AL = byte read, addrReg preserved in ECX.
+// with direct page bitmap check. Banked pages are translated through
+// ctx.PageXlat; any other non-direct page jumps to the bail label.
+// addrReg must be z80Scratch1 (RAX).
+// After call: AL = byte read, page number in ECX.
 func z80EmitMemRead(buf *CodeBuffer, bailLabel string) {
-	off, ok := emitAMD64FastPathBitmapProbe(buf, FPBitmapZeroPageStyle, z80RegDPB, z80Scratch1, z80Scratch2, z80Scratch3, false)
+	directLabel := fmt.Sprintf("mr_direct_%d", buf.Len())
+	off, ok := emitAMD64FastPathBitmapProbe(buf, FPBitmapZeroPageStyle, z80RegDPB, z80Scratch1, z80Scratch2, z80Scratch3, true)
 	if !ok {
 		panic("z80 direct-page bitmap probe unavailable")
 	}
-	buf.FixupExistingRel32(bailLabel, off)
-	// MOVZX EAX, BYTE [RSI + RAX] (direct memory read)
+	buf.FixupExistingRel32(directLabel, off)
+	z80EmitBankedXlat(buf, z80Scratch3, bailLabel)
+	buf.EmitBytes(0x89, 0xD0) // MOV EAX, EDX (MachineBus address)
+	buf.Label(directLabel)
+	// MOVZX EAX, BYTE [RSI + RAX]
 	amd64MOVZX_B_memSIB(buf, z80Scratch1, z80RegMem, z80Scratch1)
 }
 
 // z80EmitMemWrite emits code to write DL to Z80 address in AX,
-// with direct page check and self-mod detection.
+// with direct page check and self-mod detection. Banked pages are
+// translated through ctx.PageXlat; AX keeps the Z80 address so the
+// code-page check stays Z80-page indexed.
 func z80EmitMemWrite(buf *CodeBuffer, bailLabel, selfModLabel string) {
-	off, ok := emitAMD64FastPathBitmapProbe(buf, FPBitmapZeroPageStyle, z80RegDPB, z80Scratch1, z80Scratch2, z80Scratch4, false)
+	directLabel := fmt.Sprintf("mw_direct_%d", buf.Len())
+	checkLabel := fmt.Sprintf("mw_check_%d", buf.Len())
+	off, ok := emitAMD64FastPathBitmapProbe(buf, FPBitmapZeroPageStyle, z80RegDPB, z80Scratch1, z80Scratch2, z80Scratch4, true)
 	if !ok {
 		panic("z80 direct-page bitmap probe unavailable")
 	}
-	buf.FixupExistingRel32(bailLabel, off)
+	buf.FixupExistingRel32(directLabel, off)
+	z80EmitBankedXlat(buf, z80Scratch4, bailLabel)
+	// MOV [RSI + R10], DL
+	emitREXForByteSIB(buf, z80Scratch3, z80Scratch4, z80RegMem)
+	buf.EmitBytes(0x88, modRM(0, z80Scratch3, 4), sibByte(0, z80Scratch4, z80RegMem))
+	buf.EmitBytes(0xE9) // JMP check
+	buf.FixupRel32(checkLabel, buf.Len()+4)
+	buf.Label(directLabel)
 	// Direct write FIRST (always — even if self-mod detected)
 	// MOV [RSI + RAX], DL
 	emitREXForByteSIB(buf, z80Scratch3, z80Scratch1, z80RegMem)
 	buf.EmitBytes(0x88, modRM(0, z80Scratch3, 4), sibByte(0, z80Scratch1, z80RegMem))
+	buf.Label(checkLabel)
 	// Check code page (self-mod detection) AFTER write
 	off, ok = emitAMD64FastPathBitmapProbe(buf, FPBitmapCodePageDirty, z80RegCPB, z80Scratch1, z80Scratch2, z80Scratch4, false)
 	if !ok {
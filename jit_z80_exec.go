@@ -50,6 +50,7 @@ func (cpu *CPU_Z80) initZ80JIT(adapter *Z80BusAdapter) error {
 	cpu.jitExecMem = execMem
 	cpu.jitCache = NewCodeCache()
 	cpu.jitCtx = newZ80JITContext(cpu, adapter)
+	cpu.jitBankState = nil
 	cpu.z80InitTurboJIT()
 	return nil
 }
@@ -70,6 +71,11 @@ func (cpu *CPU_Z80) freeZ80JIT() {
 	cpu.jitCtx = nil
 	cpu.jitTurboCache = nil
 	cpu.jitTurboStats = nil
+	cpu.jitBankState = nil
+	if adapter, ok := cpu.bus.(*Z80BusAdapter); ok {
+		adapter.jitCodePages = nil
+		adapter.jitDirtyPages = nil
+	}
 }
 
 // interpretZ80One executes one Z80 instruction at cpu.PC using the interpreter.
@@ -83,21 +89,21 @@ func (cpu *CPU_Z80) interpretZ80One() {
 }
 
 // z80JITFlushAll performs a full cache flush: unpatch all chains, clear all
-// blocks, reset executable memory, clear RTS cache, and clear code page bitmap.
+// blocks (parked banked blocks included), reset executable memory, clear
+// RTS cache, and clear code page bitmap.
 func (cpu *CPU_Z80) z80JITFlushAll(ctx *Z80JITContext) {
 	cpu.jitCache.UnpatchChainsInRange(0, 0x10000)
 	cpu.jitCache.Invalidate()
 	if em := cpu.getZ80JITExecMem(); em != nil {
 		em.Reset()
 	}
-	ctx.RTSCache0PC = 0
-	ctx.RTSCache0Addr = 0
-	ctx.RTSCache1PC = 0
-	ctx.RTSCache1Addr = 0
-	cpu.jitTurboCache = nil
+	cpu.z80JITClearDispatchCaches(ctx)
 	for i := range cpu.codePageBitmap {
 		cpu.codePageBitmap[i] = 0
 	}
+	if adapter, ok := cpu.bus.(*Z80BusAdapter); ok {
+		cpu.z80JITResetBankState(adapter)
+	}
 }
 
 // z80BankWindowsEnabled returns true if any Z80 bank window is active,
@@ -192,19 +198,22 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 			if !cpu.running.Load() {
 				break
 			}
-			// Banked-write aliasing guard (same as NeedBail path below)
-			if z80BankWindowsEnabled(adapter) {
-				cpu.z80JITFlushAll(ctx)
-			}
 			continue
 		}
 
+		// ── Bank mapping / interpreter-write sync ──
+		// Interpreted instructions may have switched a bank window or
+		// written to compiled code; retire exactly the affected blocks.
+		cpu.z80JITSyncBanks(adapter, ctx, mem)
+
 		// ── PC page safety check ──
-		// If the current PC is on a non-direct page (banked, VRAM, I/O),
-		// the JIT scanner can't safely read opcodes from raw MachineBus memory.
-		// Fall back to interpreter for this instruction.
+		// If the current PC is on a slow page (I/O, untranslatable window),
+		// the JIT scanner can't read opcodes from MachineBus memory.
+		// Fall back to interpreter for this instruction. Banked pages are
+		// scanned through PageXlat below.
 		pc := cpu.PC
-		if cpu.directPageBitmap[pc>>8] != 0 {
+		pageKind := cpu.directPageBitmap[pc>>8]
+		if pageKind != z80PageDirect && pageKind != z80PageBanked {
 			if matched, retired, rInc := cpu.tryFastZ80MMIOPollLoop(adapter); matched {
 				if rInc > 0 {
 					r := cpu.R
@@ -223,9 +232,6 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 			if !cpu.running.Load() {
 				break
 			}
-			if z80BankWindowsEnabled(adapter) {
-				cpu.z80JITFlushAll(ctx)
-			}
 			continue
 		}
 
@@ -251,6 +257,12 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 			cpu.jitCache.InvalidateRange(uint64(pc), uint64(pc)+1)
 			block = nil
 		}
+		if block == nil && pageKind == z80PageBanked {
+			if block = cpu.z80JITUnparkBlock(ctx, mem, pc); block != nil {
+				cpu.z80JITInstallBlock(adapter, ctx, block)
+				diagCacheHits++
+			}
+		}
 		if block == nil {
 			if cpu.z80TurboJITEnabled() {
 				if turboBlock := cpu.z80ProbeTurboBlock(pc, adapter, mem); turboBlock != nil {
@@ -271,8 +283,13 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 				}
 			}
 
-			// Scan block from raw memory (safe: PC is on a direct page)
-			instrs := z80JITScanBlock(mem, pc, memSize, &cpu.directPageBitmap)
+			// Scan block from raw memory (safe: PC is on a direct or banked page)
+			var instrs []JITZ80Instr
+			if pageKind == z80PageBanked {
+				instrs = cpu.z80JITScanBanked(ctx, mem, pc)
+			} else {
+				instrs = z80JITScanBlock(mem, pc, memSize, &cpu.directPageBitmap)
+			}
 
 			if len(instrs) == 0 {
 				// First instruction needs fallback (I/O, HALT, etc.)
@@ -284,9 +301,6 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 				if !cpu.running.Load() {
 					break
 				}
-				if z80BankWindowsEnabled(adapter) {
-					cpu.z80JITFlushAll(ctx)
-				}
 				continue
 			}
 
@@ -310,18 +324,8 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 					continue
 				}
 			}
-			cpu.jitCache.Put(block)
-
-			// Bidirectional chain patching
-			if block.chainEntry != 0 {
-				cpu.jitCache.PatchChainsTo(block.startPC, block.chainEntry)
-			}
-			for i := range block.chainSlots {
-				slot := &block.chainSlots[i]
-				if target := cpu.jitCache.Get(slot.targetPC); target != nil && target.chainEntry != 0 {
-					PatchRel32At(slot.patchAddr, target.chainEntry)
-				}
-			}
+			// Cache, chain in both directions, record code pages
+			cpu.z80JITInstallBlock(adapter, ctx, block)
 
 			diagCacheMisses++
 		} else {
@@ -361,22 +365,13 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 
 		// ── Handle NeedInval (self-mod: page-granular invalidation) ──
 		if ctx.NeedInval != 0 {
-			page := ctx.InvalPage
-			lo := page << 8
-			hi := lo + 256
-			// Unpatch chain slots targeting invalidated range, then remove blocks
-			cpu.jitCache.UnpatchChainsInRange(uint64(lo), uint64(hi))
-			cpu.jitCache.InvalidateRange(uint64(lo), uint64(hi))
-			cpu.jitTurboCache = nil
+			// Removes blocks on every Z80 page aliasing the written physical
+			// page, and clears the RTS/turbo caches that may point at them.
+			cpu.z80JITInvalidatePage(adapter, ctx, ctx.InvalPage)
 			if st, ok := cpu.jitTurboStats.(*z80TurboStats); ok {
 				st.selfModInvalid++
 			}
 			ctx.NeedInval = 0
-			// Clear RTS cache (invalidated blocks may have had chain entries)
-			ctx.RTSCache0PC = 0
-			ctx.RTSCache0Addr = 0
-			ctx.RTSCache1PC = 0
-			ctx.RTSCache1Addr = 0
 		}
 
 		// ── Handle NeedBail (re-execute current instruction via interpreter) ──
@@ -388,12 +383,8 @@ func (cpu *CPU_Z80) ExecuteJITZ80() {
 			if !cpu.running.Load() {
 				break
 			}
-			// Banked-write aliasing guard: if any bank window is enabled,
-			// the interpreter's Write() may have aliased a physical page
-			// that has JIT-compiled code. Flush everything conservatively.
-			if z80BankWindowsEnabled(adapter) {
-				cpu.z80JITFlushAll(ctx)
-			}
+			// Bank switches and writes to compiled code made by the
+			// interpreter are picked up by z80JITSyncBanks on the next pass.
 		}
 
 		// ── Update R register ──
@@ -2020,6 +2020,105 @@ func TestZ80JIT_Exec_BankedWriteAlias(t *testing.T) {
 	}
 }
 
+func TestZ80JIT_Exec_BankedDataMatchesInterpreter(t *testing.T) {
+	// Loads through the $2000 window run natively via PageXlat and must see
+	// the bank selected by the interpreted bank-register write.
+	prog, startPC, images := buildZ80BankedDataProgram(3)
+
+	rJIT := newZ80JITTestRig()
+	loadZ80BankedImages(rJIT.bus, images)
+	rJIT.loadAndRun(t, startPC, prog, 2*time.Second)
+
+	rInterp := newZ80JITTestRig()
+	rInterp.cpu.jitEnabled = false
+	loadZ80BankedImages(rInterp.bus, images)
+	rInterp.runInterpreter(t, startPC, prog, 2*time.Second)
+
+	want := byte(0)
+	for _, img := range images {
+		for _, b := range img.data {
+			want += 3 * b
+		}
+	}
+	if rInterp.cpu.C != want {
+		t.Fatalf("interp C = 0x%02X, want 0x%02X (program is broken)", rInterp.cpu.C, want)
+	}
+	if rJIT.cpu.C != rInterp.cpu.C || rJIT.cpu.F != rInterp.cpu.F {
+		t.Errorf("C/F: JIT=%02X/%02X, Interp=%02X/%02X", rJIT.cpu.C, rJIT.cpu.F, rInterp.cpu.C, rInterp.cpu.F)
+	}
+	if rJIT.cpu.Cycles != rInterp.cpu.Cycles {
+		t.Errorf("Cycles: JIT=%d, Interp=%d", rJIT.cpu.Cycles, rInterp.cpu.Cycles)
+	}
+}
+
+func TestZ80JIT_Exec_BankedCodeParksPerBank(t *testing.T) {
+	// Two routines share $6000 in banks 10 and 11. Each must run natively,
+	// and switching banks must park the other routine rather than drop it.
+	if !z80JitAvailable {
+		t.Skip("Z80 JIT not available on this platform")
+	}
+	prog, startPC, images := buildZ80BankedCodeProgram(5)
+
+	r := newZ80JITTestRig()
+	r.cpu.jitPersist = true
+	t.Cleanup(func() {
+		r.cpu.jitPersist = false
+		r.cpu.freeZ80JIT()
+	})
+	loadZ80BankedImages(r.bus, images)
+	r.loadAndRun(t, startPC, prog, 2*time.Second)
+
+	if r.cpu.A != 5*48 {
+		t.Errorf("A = %d, want %d", r.cpu.A, 5*48)
+	}
+	if r.cpu.directPageBitmap[0x60] != z80PageBanked {
+		t.Fatalf("page $60 kind = %d, want banked", r.cpu.directPageBitmap[0x60])
+	}
+	block := r.cpu.jitCache.Get(0x6000)
+	if block == nil {
+		t.Fatal("no compiled block for $6000")
+	}
+	st := r.cpu.z80BankState()
+	parked := st.parked[z80BankedKey{pc: 0x6000, phys: 10 * Z80_BANK_WINDOW_SIZE}]
+	if parked == nil {
+		t.Fatal("bank 10 routine was not parked when bank 11 was selected")
+	}
+	if parked.block == block {
+		t.Error("parked and live $6000 blocks are the same block")
+	}
+}
+
+func TestZ80JIT_Exec_BankedWriteInvalidatesAlias(t *testing.T) {
+	// A native store through bank1=0 at $2301 aliases $0301, the operand
+	// of an already compiled LD A,n at $0300. The block must be recompiled.
+	if !z80JitAvailable {
+		t.Skip("Z80 JIT not available on this platform")
+	}
+	r := newZ80JITTestRig()
+	r.bus.Write8(0x0300, 0x3E) // LD A, $11
+	r.bus.Write8(0x0301, 0x11)
+	r.bus.Write8(0x0302, 0xC9) // RET
+
+	program := []byte{
+		0xCD, 0x00, 0x03, // CALL $0300
+		0x47,       // LD B, A
+		0x3E, 0x00, // LD A, 0
+		0x32, 0x00, 0xF7, // LD ($F700), A  ; bank1 = 0
+		0x3E, 0x99, // LD A, $99
+		0x32, 0x01, 0x23, // LD ($2301), A
+		0xCD, 0x00, 0x03, // CALL $0300
+		0x76, // HALT
+	}
+	r.loadAndRun(t, 0x0100, program, 500*time.Millisecond)
+
+	if r.cpu.B != 0x11 {
+		t.Errorf("B = 0x%02X, want 0x11", r.cpu.B)
+	}
+	if r.cpu.A != 0x99 {
+		t.Errorf("A = 0x%02X, want 0x99 (stale block after aliased write)", r.cpu.A)
+	}
+}
+
 // ===========================================================================
 // Phase A — Chain Correctness Tests
 // ===========================================================================
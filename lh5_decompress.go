@@ -1,12 +1,20 @@
 // lh5_decompress.go - Pure Go LH5 (Lempel-Ziv-Huffman) decompressor.
-// Used for VTX file format decompression.
+// Used for VTX file format decompression and LHA archive members.
 //
 // LH5 uses a 13-bit sliding window (8KB dictionary) with
 // block-based adaptive Huffman coding.
+//
+// Decoding is table driven: each block's code lengths are expanded into
+// packed lookup entries holding the symbol and its code length, so a
+// symbol costs one table load from a 64-bit bit buffer. Literal entries
+// whose code leaves room in the lookup width also carry the following
+// literal, decoding two bytes per lookup. Codes longer than the table
+// width fall back to the overflow tree.
 
 package main
 
 import (
+	"encoding/binary"
 	"fmt"
 )
 
@@ -25,6 +33,17 @@ const (
 	lh5CTableSize = 1 << lh5CTableBits // 4096
 	lh5PTableSize = 1 << lh5PTableBits // 256
 	lh5TreeNodes  = 2 * lh5NC          // Max tree nodes for overflow codes
+	lh5MaxMatch   = lh5NC - 1 - 256 + lh5Threshold
+)
+
+// Packed lookup entry layout.
+const (
+	lh5EntrySym     = 0x3FF   // bits 0-9: symbol, or overflow tree node
+	lh5EntryLenPos  = 10      // bits 10-14: code length
+	lh5EntryTree    = 1 << 15 // code is longer than the table: walk the tree
+	lh5EntryPair    = 1 << 16 // a second literal follows within the table width
+	lh5EntrySym2Pos = 17      // bits 17-24: second literal
+	lh5EntryLen2Pos = 25      // bits 25-29: combined code length
 )
 
 type lh5Decoder struct {
@@ -34,7 +53,7 @@ type lh5Decoder struct {
 
 	// Bit buffer: bits are MSB-aligned in bitBuf.
 	// bitsAvail is the number of valid bits starting from the MSB.
-	bitBuf    uint32
+	bitBuf    uint64
 	bitsAvail int
 
 	cTable [lh5CTableSize]uint16
@@ -42,6 +61,9 @@ type lh5Decoder struct {
 	pTable [lh5PTableSize]uint16
 	pLen   [lh5NT]uint8 // sized for max(NT=19, NP=14)
 
+	cFast [lh5CTableSize]uint32
+	pFast [lh5PTableSize]uint32
+
 	left  [lh5TreeNodes]uint16
 	right [lh5TreeNodes]uint16
 
@@ -50,11 +72,12 @@ type lh5Decoder struct {
 	// Parameterized dictionary size: dicBit and np vary by method (LH4=12, LH5=13, LH6=15, LH7=16).
 	dicBit int
 	np     int
+
+	// remaining counts output bytes still to be produced for the member.
+	remaining int
 }
 
-// decompressLH decompresses LH4/LH5/LH6/LH7 data with a parameterized dictionary size.
-// dicBit controls the sliding window: LH4=12, LH5=13, LH6=15, LH7=16.
-func decompressLH(src []byte, origSize, dicBit int) ([]byte, error) {
+func newLHDecoder(src []byte, origSize, dicBit int) (*lh5Decoder, error) {
 	if dicBit < 1 || dicBit > 16 {
 		return nil, fmt.Errorf("lh: invalid dicBit %d (must be 1..16)", dicBit)
 	}
@@ -67,63 +90,215 @@ func decompressLH(src []byte, origSize, dicBit int) ([]byte, error) {
 	if len(src) == 0 {
 		return nil, fmt.Errorf("lh: empty compressed data")
 	}
+	return &lh5Decoder{src: src, dicBit: dicBit, np: dicBit + 1, remaining: origSize}, nil
+}
 
-	dicSize := 1 << dicBit
-	np := dicBit + 1
+// decompressLH decompresses LH4/LH5/LH6/LH7 data with a parameterized dictionary size.
+// dicBit controls the sliding window: LH4=12, LH5=13, LH6=15, LH7=16.
+func decompressLH(src []byte, origSize, dicBit int) ([]byte, error) {
+	d, err := newLHDecoder(src, origSize, dicBit)
+	if err != nil {
+		return nil, err
+	}
+	out := make([]byte, origSize)
+	if _, err := d.decode(out, 0, origSize); err != nil {
+		return nil, err
+	}
+	return out, nil
+}
 
-	d := &lh5Decoder{src: src, dicBit: dicBit, np: np}
+// decompressLH5 decompresses LH5-compressed data (8KB window, 13-bit dictionary).
+func decompressLH5(src []byte, origSize int) ([]byte, error) {
+	return decompressLH(src, origSize, lh5DicBit)
+}
 
-	out := make([]byte, origSize)
-	dict := make([]byte, dicSize)
-	dictMask := dicSize - 1
-	dictPos := 0
-	outPos := 0
+// decode produces output into buf from pos until it reaches end or the
+// member is complete, and returns the new position. buf[:pos] must hold
+// the most recent output (at least one dictionary of it, once that much
+// has been produced). Matches are copied whole, so a caller stopping
+// short of the member end leaves lh5MaxMatch bytes of buf past end.
+func (d *lh5Decoder) decode(buf []byte, pos, end int) (int, error) {
+	for pos < end && d.remaining > 0 {
+		if d.blockRemaining <= 0 {
+			if err := d.readBlockHeader(); err != nil {
+				return pos, err
+			}
+		}
+		d.refill()
+		if d.bitsAvail == 0 {
+			return pos, fmt.Errorf("lh5: unexpected EOF while reading %d bits", lh5CTableBits)
+		}
+
+		e := d.cFast[d.bitBuf>>(64-lh5CTableBits)]
+		if e&lh5EntryPair != 0 && d.blockRemaining >= 2 && d.remaining >= 2 {
+			if n := int(e>>lh5EntryLen2Pos) & 31; n <= d.bitsAvail {
+				d.bitBuf <<= uint(n)
+				d.bitsAvail -= n
+				d.blockRemaining -= 2
+				d.remaining -= 2
+				buf[pos] = byte(e)
+				buf[pos+1] = byte(e >> lh5EntrySym2Pos)
+				pos += 2
+				continue
+			}
+		}
 
-	for outPos < origSize {
-		c, err := d.decodeC()
-		if err != nil {
-			return nil, err
+		c := int(e & lh5EntrySym)
+		n := int(e>>lh5EntryLenPos) & 31
+		if e&lh5EntryTree != 0 {
+			var err error
+			if c, err = d.walkTree(c, lh5NC, lh5CTableBits); err != nil {
+				return pos, fmt.Errorf("lh5: invalid character tree")
+			}
+			n = int(d.cLen[c])
 		}
+		if n > d.bitsAvail {
+			return pos, fmt.Errorf("lh5: invalid bit drop %d with %d available", n, d.bitsAvail)
+		}
+		d.bitBuf <<= uint(n)
+		d.bitsAvail -= n
+		d.blockRemaining--
+
 		if c < 256 {
-			dict[dictPos] = byte(c)
-			dictPos = (dictPos + 1) & dictMask
-			out[outPos] = byte(c)
-			outPos++
-		} else {
-			matchLen := c - 256 + lh5Threshold
-			p, err := d.decodeP()
-			if err != nil {
-				return nil, err
+			buf[pos] = byte(c)
+			pos++
+			d.remaining--
+			continue
+		}
+
+		p, err := d.decodeP()
+		if err != nil {
+			return pos, err
+		}
+		dicSize := 1 << d.dicBit
+		if p < 0 || p >= dicSize {
+			return pos, fmt.Errorf("lh: invalid match offset %d for dictionary size %d", p, dicSize)
+		}
+		matchLen := min(c-256+lh5Threshold, d.remaining)
+		from := pos - p - 1
+		switch {
+		case from < 0:
+			// Reaches back before the start of the member, where the
+			// dictionary is zero-filled.
+			for i := range matchLen {
+				if from+i < 0 {
+					buf[pos+i] = 0
+				} else {
+					buf[pos+i] = buf[from+i]
+				}
 			}
-			if p < 0 || p >= dicSize {
-				return nil, fmt.Errorf("lh: invalid match offset %d for dictionary size %d", p, dicSize)
+		case p+1 >= matchLen:
+			copy(buf[pos:pos+matchLen], buf[from:from+matchLen])
+		default:
+			// Overlapping run: the output repeats with period p+1, so copy
+			// what is already there, doubling the span each pass.
+			for n := 0; n < matchLen; {
+				n += copy(buf[pos+n:pos+matchLen], buf[from:pos+n])
 			}
-			matchPos := (dictPos - p - 1) & dictMask
-			for i := 0; i < matchLen && outPos < origSize; i++ {
-				b := dict[matchPos]
-				dict[dictPos] = b
-				dictPos = (dictPos + 1) & dictMask
-				matchPos = (matchPos + 1) & dictMask
-				out[outPos] = b
-				outPos++
+		}
+		pos += matchLen
+		d.remaining -= matchLen
+	}
+	return pos, nil
+}
+
+// readBlockHeader reads the block size and the three Huffman trees that
+// start every block, and rebuilds the packed lookup tables.
+func (d *lh5Decoder) readBlockHeader() error {
+	d.blockRemaining = int(d.getBits(16))
+	if d.err != nil {
+		return d.err
+	}
+	if d.blockRemaining == 0 {
+		return fmt.Errorf("lh5: invalid zero-length block")
+	}
+	if err := d.readPTLen(lh5NT, lh5TBit, 3); err != nil {
+		return err
+	}
+	if err := d.readCLen(); err != nil {
+		return err
+	}
+	np := d.np
+	if np == 0 {
+		np = lh5NP // fallback for zero-value struct
+	}
+	if err := d.readPTLen(np, lh5PBit, -1); err != nil {
+		return err
+	}
+	buildLH5Fast(d.cFast[:], d.cTable[:], d.cLen[:], lh5NC, lh5CTableBits, true)
+	buildLH5Fast(d.pFast[:], d.pTable[:], d.pLen[:], np, lh5PTableBits, false)
+	return nil
+}
+
+// buildLH5Fast packs a symbol table and its code lengths into lookup
+// entries. With pairs set, a literal entry also records the literal that
+// the remaining lookup bits decode to, when its code fits as well.
+func buildLH5Fast(fast []uint32, table []uint16, lens []uint8, nsym, tableBits int, pairs bool) {
+	mask := len(fast) - 1
+	for i := range fast {
+		s := table[i]
+		if int(s) >= nsym {
+			fast[i] = uint32(s)&lh5EntrySym | lh5EntryTree
+			continue
+		}
+		l := int(lens[s])
+		e := uint32(s) | uint32(l)<<lh5EntryLenPos
+		if pairs && s < 256 && l > 0 && l < tableBits {
+			s2 := table[(i<<uint(l))&mask]
+			if s2 < 256 {
+				if l2 := int(lens[s2]); l2 > 0 && l+l2 <= tableBits {
+					e |= lh5EntryPair | uint32(s2)<<lh5EntrySym2Pos | uint32(l+l2)<<lh5EntryLen2Pos
+				}
 			}
 		}
+		fast[i] = e
 	}
+}
 
-	return out, nil
+// walkTree resolves an overflow-tree node using the bits after the
+// lookup-table prefix.
+func (d *lh5Decoder) walkTree(j, nsym, tableBits int) (int, error) {
+	mask := uint64(1) << uint(64-tableBits-1)
+	for j >= nsym {
+		if mask == 0 || j >= len(d.left) {
+			return 0, fmt.Errorf("lh5: invalid tree")
+		}
+		if d.bitBuf&mask != 0 {
+			j = int(d.right[j])
+		} else {
+			j = int(d.left[j])
+		}
+		mask >>= 1
+	}
+	return j, nil
 }
 
-// decompressLH5 decompresses LH5-compressed data (8KB window, 13-bit dictionary).
-func decompressLH5(src []byte, origSize int) ([]byte, error) {
-	return decompressLH(src, origSize, lh5DicBit)
+// refill tops the bit buffer up to at least 57 bits while input remains,
+// a whole 8-byte word at a time away from the end of the input.
+func (d *lh5Decoder) refill() {
+	if d.bitsAvail > 56 {
+		return
+	}
+	if d.srcPos+8 <= len(d.src) {
+		// Bits below the new bitsAvail are the true next input bits, so
+		// OR-ing the same byte in again later is harmless.
+		d.bitBuf |= binary.BigEndian.Uint64(d.src[d.srcPos:]) >> uint(d.bitsAvail)
+		n := (64 - d.bitsAvail) >> 3
+		d.srcPos += n
+		d.bitsAvail += n << 3
+		return
+	}
+	for d.bitsAvail <= 56 && d.srcPos < len(d.src) {
+		d.bitBuf |= uint64(d.src[d.srcPos]) << uint(56-d.bitsAvail)
+		d.srcPos++
+		d.bitsAvail += 8
+	}
 }
 
 // ensureBits fills the bit buffer to have at least n valid bits.
 func (d *lh5Decoder) ensureBits(n int) error {
-	for d.bitsAvail < n && d.srcPos < len(d.src) {
-		d.bitBuf |= uint32(d.src[d.srcPos]) << uint(24-d.bitsAvail)
-		d.srcPos++
-		d.bitsAvail += 8
+	if d.bitsAvail < n {
+		d.refill()
 	}
 	if d.bitsAvail < n {
 		if d.err == nil {
@@ -134,21 +309,10 @@ func (d *lh5Decoder) ensureBits(n int) error {
 	return nil
 }
 
-func (d *lh5Decoder) ensureLookupBits(n int) error {
-	if err := d.ensureBits(n); err != nil {
-		if d.srcPos == len(d.src) && d.bitsAvail > 0 {
-			d.err = nil
-			return nil
-		}
-		return err
-	}
-	return nil
-}
-
 // peekBits returns the top n bits without consuming them.
 func (d *lh5Decoder) peekBits(n int) uint16 {
 	_ = d.ensureBits(n)
-	return uint16(d.bitBuf >> uint(32-n))
+	return uint16(d.bitBuf >> uint(64-n))
 }
 
 // dropBits consumes n bits from the buffer.
@@ -170,80 +334,26 @@ func (d *lh5Decoder) getBits(n int) uint16 {
 	return v
 }
 
-func (d *lh5Decoder) decodeC() (int, error) {
-	if d.blockRemaining <= 0 {
-		d.blockRemaining = int(d.getBits(16))
-		if d.err != nil {
-			return 0, d.err
-		}
-		if d.blockRemaining == 0 {
-			return 0, fmt.Errorf("lh5: invalid zero-length block")
-		}
-		if err := d.readPTLen(lh5NT, lh5TBit, 3); err != nil {
-			return 0, err
-		}
-		if err := d.readCLen(); err != nil {
-			return 0, err
-		}
-		np := d.np
-		if np == 0 {
-			np = lh5NP // fallback for zero-value struct
-		}
-		if err := d.readPTLen(np, lh5PBit, -1); err != nil {
-			return 0, err
-		}
-	}
-	d.blockRemaining--
-
-	if err := d.ensureLookupBits(lh5CTableBits); err != nil {
-		return 0, err
-	}
-	j := d.cTable[d.bitBuf>>uint(32-lh5CTableBits)]
-	if int(j) >= lh5NC {
-		mask := uint32(1) << uint(32-lh5CTableBits-1)
-		for int(j) >= lh5NC {
-			if mask == 0 || int(j) >= len(d.left) {
-				return 0, fmt.Errorf("lh5: invalid character tree")
-			}
-			if d.bitBuf&mask != 0 {
-				j = d.right[j]
-			} else {
-				j = d.left[j]
-			}
-			mask >>= 1
-		}
-	}
-	d.dropBits(int(d.cLen[j]))
-	if d.err != nil {
-		return 0, d.err
-	}
-	return int(j), nil
-}
-
 func (d *lh5Decoder) decodeP() (int, error) {
 	np := d.np
 	if np == 0 {
 		np = lh5NP
 	}
-	if err := d.ensureLookupBits(lh5PTableBits); err != nil {
-		return 0, err
+	d.refill()
+	if d.bitsAvail == 0 {
+		return 0, fmt.Errorf("lh5: unexpected EOF while reading %d bits", lh5PTableBits)
 	}
-	j := d.pTable[d.bitBuf>>uint(32-lh5PTableBits)]
-	if int(j) >= np {
-		mask := uint32(1) << uint(32-lh5PTableBits-1)
-		for int(j) >= np {
-			if mask == 0 || int(j) >= len(d.left) {
-				return 0, fmt.Errorf("lh5: invalid position tree")
-			}
-			if d.bitBuf&mask != 0 {
-				j = d.right[j]
-			} else {
-				j = d.left[j]
-			}
-			mask >>= 1
+	e := d.pFast[d.bitBuf>>(64-lh5PTableBits)]
+	j := int(e & lh5EntrySym)
+	n := int(e>>lh5EntryLenPos) & 31
+	if e&lh5EntryTree != 0 {
+		var err error
+		if j, err = d.walkTree(j, np, lh5PTableBits); err != nil {
+			return 0, fmt.Errorf("lh5: invalid position tree")
 		}
+		n = int(d.pLen[j])
 	}
-	d.dropBits(int(d.pLen[j]))
+	d.dropBits(n)
 	if d.err != nil {
 		return 0, d.err
 	}
@@ -251,7 +361,7 @@ func (d *lh5Decoder) decodeP() (int, error) {
 	if j == 0 {
 		return 0, nil
 	}
-	extra := int(d.getBits(int(j) - 1))
+	extra := int(d.getBits(j - 1))
 	if d.err != nil {
 		return 0, d.err
 	}
@@ -285,10 +395,10 @@ func (d *lh5Decoder) readPTLen(nn, nBit, iSpecial int) error {
 		}
 		c := int(d.peekBits(3))
 		if c == 7 {
-			if err := d.ensureBits(4); err != nil {
-				return err
-			}
-			mask := uint32(1) << uint(32-4)
+			// The unary run can reach bit 16, so top the buffer up rather
+			// than relying on the three bits already checked.
+			d.refill()
+			mask := uint64(1) << uint(64-4)
 			for mask&d.bitBuf != 0 {
 				c++
 				mask >>= 1
@@ -350,22 +460,15 @@ func (d *lh5Decoder) readCLen() error {
 
 	i := 0
 	for i < n && i < lh5NC {
-		if err := d.ensureBits(lh5PTableBits); err != nil {
-			return err
+		d.refill()
+		if d.bitsAvail == 0 {
+			return fmt.Errorf("lh5: unexpected EOF while reading %d bits", lh5PTableBits)
 		}
-		c := int(d.pTable[d.bitBuf>>uint(32-lh5PTableBits)])
+		c := int(d.pTable[d.bitBuf>>uint(64-lh5PTableBits)])
 		if c >= lh5NT {
-			mask := uint32(1) << uint(32-lh5PTableBits-1)
-			for c >= lh5NT {
-				if mask == 0 || c >= len(d.left) {
-					return fmt.Errorf("lh5: invalid code-length tree")
-				}
-				if d.bitBuf&mask != 0 {
-					c = int(d.right[c])
-				} else {
-					c = int(d.left[c])
-				}
-				mask >>= 1
+			var err error
+			if c, err = d.walkTree(c, lh5NT, lh5PTableBits); err != nil {
+				return fmt.Errorf("lh5: invalid code-length tree")
 			}
 		}
 		d.dropBits(int(d.pLen[c]))
@@ -464,13 +567,16 @@ func (d *lh5Decoder) makeTable(nchar int, bitLen []uint8, tableBits int, table [
 			}
 			start[l] += uint32(fillCount)
 		} else {
-			// Code longer than table: build overflow tree
-			idx := int(start[l] >> uint(l-tableBits))
+			// Code longer than table: build overflow tree. start[l] is
+			// still in 16-bit units here; its top tableBits bits index
+			// the table and the following bits steer the tree.
+			k := start[l]
+			idx := int(k >> m)
 			if idx >= tableSize {
-				continue
+				return fmt.Errorf("lh5: huffman table overflow")
 			}
 			p := &table[idx]
-			for i := tableBits + 1; i <= l; i++ {
+			for i := l - tableBits; i > 0; i-- {
 				if *p == 0 {
 					if int(avail) >= len(left) {
 						return fmt.Errorf("lh5: huffman tree overflow")
@@ -480,15 +586,15 @@ func (d *lh5Decoder) makeTable(nchar int, bitLen []uint8, tableBits int, table [
 					*p = avail
 					avail++
 				}
-				bit := (start[l] >> uint(l-i)) & 1
-				if bit != 0 {
+				if k&(1<<uint(15-tableBits)) != 0 {
 					p = &right[*p]
 				} else {
 					p = &left[*p]
 				}
+				k <<= 1
 			}
 			*p = uint16(ch)
-			start[l] += weight[l] >> m
+			start[l] += weight[l]
 		}
 	}
 
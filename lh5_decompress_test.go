@@ -2,6 +2,10 @@ package main
 
 import (
 	"bytes"
+	"math/bits"
+	"math/rand"
+	"os"
+	"path/filepath"
 	"testing"
 )
 
@@ -184,6 +188,60 @@ func TestLH5MakeTableAcceptsMaxLengthCanonicalTree(t *testing.T) {
 	}
 }
 
+func TestLH5MakeTableLongCodes(t *testing.T) {
+	// Lengths 1..16 plus a second 16: a complete code where everything
+	// past 8 bits lives in the overflow tree.
+	lengths := make([]uint8, 17)
+	for i := range 16 {
+		lengths[i] = uint8(i + 1)
+	}
+	lengths[16] = 16
+	d := &lh5Decoder{}
+	if err := d.makeTable(len(lengths), lengths, lh5PTableBits, d.pTable[:], d.left[:], d.right[:]); err != nil {
+		t.Fatal(err)
+	}
+	codes := testCanonicalCodes(lengths)
+	for sym, l := range lengths {
+		d.bitBuf = uint64(codes[sym]) << uint(64-l)
+		got := int(d.pTable[d.bitBuf>>(64-lh5PTableBits)])
+		if got >= len(lengths) {
+			var err error
+			if got, err = d.walkTree(got, len(lengths), lh5PTableBits); err != nil {
+				t.Fatalf("symbol %d: %v", sym, err)
+			}
+		}
+		if got != sym {
+			t.Errorf("%d-bit code %0*b decodes to %d, want %d", l, l, codes[sym], got, sym)
+		}
+	}
+}
+
+func TestLH5ReadPTLenLongUnaryAtEveryAlignment(t *testing.T) {
+	// Lengths past 7 are sent in unary; a run that straddles the end of the
+	// buffered bits must not be cut short.
+	lengths := []uint8{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 13}
+	for pad := range 64 {
+		w := &testBitWriter{}
+		for p := pad; p > 0; p -= min(p, 16) {
+			w.putBits(min(p, 16), 0)
+		}
+		testPutPTLen(w, lengths, lh5PBit, -1)
+		w.putBits(16, 0)
+		w.flush()
+
+		d := &lh5Decoder{src: w.buf}
+		for p := pad; p > 0; p -= min(p, 16) {
+			d.getBits(min(p, 16))
+		}
+		if err := d.readPTLen(len(lengths), lh5PBit, -1); err != nil {
+			t.Fatalf("pad %d: %v", pad, err)
+		}
+		if !bytes.Equal(d.pLen[:len(lengths)], lengths) {
+			t.Fatalf("pad %d: lengths %v, want %v", pad, d.pLen[:len(lengths)], lengths)
+		}
+	}
+}
+
 func TestDecompressLH5_YMRegisterData(t *testing.T) {
 	// Simulate 3 frames of 14 AY registers (interleaved like YM3)
 	// In YM3 interleaved format: all values for reg 0, then reg 1, etc.
@@ -283,3 +341,379 @@ func TestDecompressLH5_StillWorks(t *testing.T) {
 		t.Errorf("decompressLH5 wrapper data mismatch")
 	}
 }
+
+// testCompressLHHuffman is a real LH4/LH5 encoder: greedy hash-chain LZ77
+// matching and per-block canonical Huffman codes, so decoding exercises
+// back-references, long codes and multi-block streams. The 4-bit position
+// count field limits it to dicBit <= 14. short caps code lengths at the
+// lookup-table widths (12 bits for characters, 8 for the others), which
+// is all the reference decoder handles.
+func testCompressLHHuffman(data []byte, dicBit int, short bool) []byte {
+	cMax, ptMax := 16, 16
+	if short {
+		cMax, ptMax = lh5CTableBits, lh5PTableBits
+	}
+	const blockTokens = 16384
+	type token struct{ c, p int } // c: literal or 256+len-3; p: distance-1
+	dicSize := 1 << dicBit
+	head := make([]int32, 1<<15)
+	for i := range head {
+		head[i] = -1
+	}
+	prev := make([]int32, len(data))
+	insert := func(k int) {
+		if k+3 <= len(data) {
+			h := (uint32(data[k])<<10 ^ uint32(data[k+1])<<5 ^ uint32(data[k+2])) & (1<<15 - 1)
+			prev[k] = head[h]
+			head[h] = int32(k)
+		}
+	}
+
+	var toks []token
+	for i := 0; i < len(data); {
+		bestLen, bestDist := 0, 0
+		if i+3 <= len(data) {
+			h := (uint32(data[i])<<10 ^ uint32(data[i+1])<<5 ^ uint32(data[i+2])) & (1<<15 - 1)
+			for j, n := int(head[h]), 0; j >= 0 && i-j <= dicSize && n < 64; j, n = int(prev[j]), n+1 {
+				l := 0
+				for l < lh5MaxMatch && i+l < len(data) && data[j+l] == data[i+l] {
+					l++
+				}
+				if l > bestLen {
+					bestLen, bestDist = l, i-j
+				}
+			}
+		}
+		if bestLen < lh5Threshold {
+			bestLen = 1
+			toks = append(toks, token{c: int(data[i])})
+		} else {
+			toks = append(toks, token{c: 256 + bestLen - lh5Threshold, p: bestDist - 1})
+		}
+		for k := i; k < i+bestLen; k++ {
+			insert(k)
+		}
+		i += bestLen
+	}
+
+	w := &testBitWriter{}
+	np := dicBit + 1
+	for len(toks) > 0 {
+		blk := toks[:min(len(toks), blockTokens)]
+		toks = toks[len(blk):]
+
+		cFreq := make([]int, lh5NC)
+		pFreq := make([]int, np)
+		for _, tk := range blk {
+			cFreq[tk.c]++
+			if tk.c >= 256 {
+				pFreq[bits.Len(uint(tk.p))]++
+			}
+		}
+		w.putBits(16, uint32(len(blk)))
+
+		cLens, cConst := testHuffLengths(cFreq, cMax)
+		var tCodes []uint32
+		var tLens []uint8
+		if cConst >= 0 {
+			w.putBits(lh5TBit, 0)
+			w.putBits(lh5TBit, 0)
+			w.putBits(lh5CBit, 0)
+			w.putBits(lh5CBit, uint32(cConst))
+		} else {
+			// Code lengths, as code-length-code symbols plus extra bits.
+			type tsym struct{ s, extraBits, extra int }
+			var seq []tsym
+			n := len(cLens)
+			for n > 0 && cLens[n-1] == 0 {
+				n--
+			}
+			for i := 0; i < n; {
+				if cLens[i] != 0 {
+					seq = append(seq, tsym{s: int(cLens[i]) + 2})
+					i++
+					continue
+				}
+				k := 0
+				for i+k < n && cLens[i+k] == 0 {
+					k++
+				}
+				switch {
+				case k <= 2:
+					for range k {
+						seq = append(seq, tsym{s: 0})
+					}
+				case k <= 18:
+					seq = append(seq, tsym{1, 4, k - 3})
+				case k == 19:
+					seq = append(seq, tsym{s: 0}, tsym{1, 4, 15})
+				default:
+					seq = append(seq, tsym{2, lh5CBit, k - 20})
+				}
+				i += k
+			}
+			tFreq := make([]int, lh5NT)
+			for _, ts := range seq {
+				tFreq[ts.s]++
+			}
+			var tConst int
+			tLens, tConst = testHuffLengths(tFreq, ptMax)
+			if tConst >= 0 {
+				w.putBits(lh5TBit, 0)
+				w.putBits(lh5TBit, uint32(tConst))
+			} else {
+				testPutPTLen(w, tLens, lh5TBit, 3)
+				tCodes = testCanonicalCodes(tLens)
+			}
+			w.putBits(lh5CBit, uint32(n))
+			for _, ts := range seq {
+				if tCodes != nil {
+					w.putBits(int(tLens[ts.s]), tCodes[ts.s])
+				}
+				if ts.extraBits > 0 {
+					w.putBits(ts.extraBits, uint32(ts.extra))
+				}
+			}
+		}
+
+		pLens, pConst := testHuffLengths(pFreq, ptMax)
+		if pConst >= 0 {
+			w.putBits(lh5PBit, 0)
+			w.putBits(lh5PBit, uint32(pConst))
+		} else {
+			testPutPTLen(w, pLens, lh5PBit, -1)
+		}
+
+		cCodes := testCanonicalCodes(cLens)
+		pCodes := testCanonicalCodes(pLens)
+		for _, tk := range blk {
+			if cConst < 0 {
+				w.putBits(int(cLens[tk.c]), cCodes[tk.c])
+			}
+			if tk.c < 256 {
+				continue
+			}
+			j := bits.Len(uint(tk.p))
+			if pConst < 0 {
+				w.putBits(int(pLens[j]), pCodes[j])
+			}
+			if j > 1 {
+				w.putBits(j-1, uint32(tk.p-1<<(j-1)))
+			}
+		}
+	}
+	w.flush()
+	return w.buf
+}
+
+// testHuffLengths returns Huffman code lengths of at most limit bits for
+// the given frequencies, or the symbol to send as a constant tree when
+// fewer than two symbols occur.
+func testHuffLengths(freq []int, limit int) ([]uint8, int) {
+	used, last := 0, 0
+	for s, f := range freq {
+		if f > 0 {
+			used++
+			last = s
+		}
+	}
+	if used < 2 {
+		return make([]uint8, len(freq)), last
+	}
+	f := append([]int(nil), freq...)
+	for {
+		type node struct{ w, l, r, sym int }
+		var nodes []node
+		var idx []int // live (unmerged) nodes
+		for s, w := range f {
+			if w > 0 {
+				idx = append(idx, len(nodes))
+				nodes = append(nodes, node{w, -1, -1, s})
+			}
+		}
+		for len(idx) > 1 {
+			a, b := 0, 1
+			if nodes[idx[b]].w < nodes[idx[a]].w {
+				a, b = b, a
+			}
+			for k := 2; k < len(idx); k++ {
+				switch w := nodes[idx[k]].w; {
+				case w < nodes[idx[a]].w:
+					a, b = k, a
+				case w < nodes[idx[b]].w:
+					b = k
+				}
+			}
+			nodes = append(nodes, node{nodes[idx[a]].w + nodes[idx[b]].w, idx[a], idx[b], -1})
+			hi, lo := max(a, b), min(a, b)
+			idx = append(idx[:hi], idx[hi+1:]...)
+			idx[lo] = len(nodes) - 1
+		}
+		lens := make([]uint8, len(freq))
+		maxLen := 0
+		var walk func(n, depth int)
+		walk = func(n, depth int) {
+			if nodes[n].sym >= 0 {
+				lens[nodes[n].sym] = uint8(depth)
+				maxLen = max(maxLen, depth)
+				return
+			}
+			walk(nodes[n].l, depth+1)
+			walk(nodes[n].r, depth+1)
+		}
+		walk(idx[0], 0)
+		if maxLen <= limit {
+			return lens, -1
+		}
+		for s := range f {
+			if f[s] > 0 {
+				f[s] = (f[s] + 1) / 2
+			}
+		}
+	}
+}
+
+// testCanonicalCodes assigns canonical codes in the order makeTable expects:
+// shorter codes first, ascending symbol within a length.
+func testCanonicalCodes(lens []uint8) []uint32 {
+	codes := make([]uint32, len(lens))
+	code := uint32(0)
+	for l := uint8(1); l <= 16; l++ {
+		for s, sl := range lens {
+			if sl == l {
+				codes[s] = code
+				code++
+			}
+		}
+		code <<= 1
+	}
+	return codes
+}
+
+// testPutPTLen writes code lengths in readPTLen's format: 3 bits below 7,
+// otherwise 7 followed by a unary extension, with the 2-bit zero-run field
+// after index iSpecial-1.
+func testPutPTLen(w *testBitWriter, lens []uint8, nBit, iSpecial int) {
+	n := len(lens)
+	for n > 0 && lens[n-1] == 0 {
+		n--
+	}
+	w.putBits(nBit, uint32(n))
+	for i := 0; i < n; {
+		l := int(lens[i])
+		if l < 7 {
+			w.putBits(3, uint32(l))
+		} else {
+			w.putBits(3, 7)
+			for range l - 7 {
+				w.putBits(1, 1)
+			}
+			w.putBits(1, 0)
+		}
+		i++
+		if i == iSpecial {
+			gap := 0
+			for gap < 3 && i+gap < n && lens[i+gap] == 0 {
+				gap++
+			}
+			w.putBits(2, uint32(gap))
+			i += gap
+		}
+	}
+}
+
+// lhTestCorpus returns size bytes of mixed text-like, run-length and noisy
+// data, the mix seen in demo and music archives.
+func lhTestCorpus(size int, seed int64) []byte {
+	rng := rand.New(rand.NewSource(seed))
+	words := []string{"intuition ", "engine ", "copper ", "blitter ", "sprite ", "AROS ", "dos.library ", "\n", "0x1000 ", "move.l ", "d0,", "(a0)+"}
+	out := make([]byte, 0, size)
+	for len(out) < size {
+		switch rng.Intn(8) {
+		case 0:
+			out = append(out, bytes.Repeat([]byte{byte(rng.Intn(256))}, 4+rng.Intn(300))...)
+		case 1:
+			for range 1 + rng.Intn(64) {
+				out = append(out, byte(rng.Intn(256)))
+			}
+		default:
+			for range 1 + rng.Intn(16) {
+				out = append(out, words[rng.Intn(len(words))]...)
+			}
+		}
+	}
+	return out[:size]
+}
+
+func TestDecompressLH_HuffmanRoundTrip(t *testing.T) {
+	cases := map[string][]byte{
+		"corpus":   lhTestCorpus(300_000, 1),
+		"zeros":    make([]byte, 100_000),
+		"overlap":  bytes.Repeat([]byte("ab"), 40_000),
+		"single":   []byte{42},
+		"boundary": lhTestCorpus(lh5DicSize*3+17, 2),
+	}
+	noise := make([]byte, 50_000)
+	rand.New(rand.NewSource(3)).Read(noise)
+	cases["random"] = noise
+	for name, original := range cases {
+		for _, dicBit := range []int{12, 13} {
+			compressed := testCompressLHHuffman(original, dicBit, false)
+			got, err := decompressLH(compressed, len(original), dicBit)
+			if err != nil {
+				t.Fatalf("%s dicBit=%d: %v", name, dicBit, err)
+			}
+			if !bytes.Equal(got, original) {
+				t.Fatalf("%s dicBit=%d: round trip mismatch", name, dicBit)
+			}
+		}
+	}
+}
+
+func TestDecompressLH_MatchesReferenceDecoder(t *testing.T) {
+	inputs := [][]byte{
+		testCompressLH5([]byte("Hello, World! This is a test of LH5 decompression.")),
+		testCompressLH5(make([]byte, 70_000)),
+		testCompressLHHuffman(lhTestCorpus(100_000, 4), lh5DicBit, true),
+	}
+	sizes := []int{51, 70_000, 100_000}
+	paths, _ := filepath.Glob("sdk/examples/assets/music/*.ym")
+	for _, path := range paths {
+		data, err := os.ReadFile(path)
+		if err != nil {
+			t.Fatal(err)
+		}
+		hdr, err := parseLHAHeader(data)
+		if err != nil || hdr.method != "-lh5-" {
+			continue
+		}
+		inputs = append(inputs, data[hdr.headerSize:hdr.headerSize+hdr.compressedSize])
+		sizes = append(sizes, hdr.originalSize)
+	}
+	for i, src := range inputs {
+		want, wantErr := decompressLHRef(src, sizes[i], lh5DicBit)
+		got, err := decompressLH(src, sizes[i], lh5DicBit)
+		if (err != nil) != (wantErr != nil) {
+			t.Fatalf("input %d: error %v, reference error %v", i, err, wantErr)
+		}
+		if !bytes.Equal(got, want) {
+			t.Fatalf("input %d: output differs from the reference decoder", i)
+		}
+	}
+}
+
+func benchmarkLHDecode(b *testing.B, decode func([]byte, int, int) ([]byte, error)) {
+	original := lhTestCorpus(8<<20, 6)
+	compressed := testCompressLHHuffman(original, lh5DicBit, true)
+	b.SetBytes(int64(len(original)))
+	b.ResetTimer()
+	for range b.N {
+		if _, err := decode(compressed, len(original), lh5DicBit); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkDecompressLH5_Table(b *testing.B) { benchmarkLHDecode(b, decompressLH) }
+
+func BenchmarkDecompressLH5_Reference(b *testing.B) { benchmarkLHDecode(b, decompressLHRef) }
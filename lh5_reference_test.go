@@ -0,0 +1,475 @@
+// lh5_reference_test.go - the original bit-at-a-time LH4-LH7 decoder, kept
+// as the differential-test oracle and benchmark baseline for the
+// table-driven decoder in lh5_decompress.go.
+
+package main
+
+import (
+	"fmt"
+)
+
+type lh5RefDecoder struct {
+	src    []byte
+	srcPos int
+	err    error
+
+	// Bit buffer: bits are MSB-aligned in bitBuf.
+	// bitsAvail is the number of valid bits starting from the MSB.
+	bitBuf    uint32
+	bitsAvail int
+
+	cTable [lh5CTableSize]uint16
+	cLen   [lh5NC]uint8
+	pTable [lh5PTableSize]uint16
+	pLen   [lh5NT]uint8 // sized for max(NT=19, NP=14)
+
+	left  [lh5TreeNodes]uint16
+	right [lh5TreeNodes]uint16
+
+	blockRemaining int
+
+	// Parameterized dictionary size: dicBit and np vary by method (LH4=12, LH5=13, LH6=15, LH7=16).
+	dicBit int
+	np     int
+}
+
+// decompressLHRef is decompressLH as it was before the table-driven decoder.
+func decompressLHRef(src []byte, origSize, dicBit int) ([]byte, error) {
+	if dicBit < 1 || dicBit > 16 {
+		return nil, fmt.Errorf("lh: invalid dicBit %d (must be 1..16)", dicBit)
+	}
+	if origSize <= 0 {
+		return nil, fmt.Errorf("lh: invalid original size %d", origSize)
+	}
+	if origSize > lhaMaxSize {
+		return nil, fmt.Errorf("lh: original size %d exceeds maximum %d", origSize, lhaMaxSize)
+	}
+	if len(src) == 0 {
+		return nil, fmt.Errorf("lh: empty compressed data")
+	}
+
+	dicSize := 1 << dicBit
+	np := dicBit + 1
+
+	d := &lh5RefDecoder{src: src, dicBit: dicBit, np: np}
+
+	out := make([]byte, origSize)
+	dict := make([]byte, dicSize)
+	dictMask := dicSize - 1
+	dictPos := 0
+	outPos := 0
+
+	for outPos < origSize {
+		c, err := d.decodeC()
+		if err != nil {
+			return nil, err
+		}
+		if c < 256 {
+			dict[dictPos] = byte(c)
+			dictPos = (dictPos + 1) & dictMask
+			out[outPos] = byte(c)
+			outPos++
+		} else {
+			matchLen := c - 256 + lh5Threshold
+			p, err := d.decodeP()
+			if err != nil {
+				return nil, err
+			}
+			if p < 0 || p >= dicSize {
+				return nil, fmt.Errorf("lh: invalid match offset %d for dictionary size %d", p, dicSize)
+			}
+			matchPos := (dictPos - p - 1) & dictMask
+			for i := 0; i < matchLen && outPos < origSize; i++ {
+				b := dict[matchPos]
+				dict[dictPos] = b
+				dictPos = (dictPos + 1) & dictMask
+				matchPos = (matchPos + 1) & dictMask
+				out[outPos] = b
+				outPos++
+			}
+		}
+	}
+
+	return out, nil
+}
+
+// ensureBits fills the bit buffer to have at least n valid bits.
+func (d *lh5RefDecoder) ensureBits(n int) error {
+	for d.bitsAvail < n && d.srcPos < len(d.src) {
+		d.bitBuf |= uint32(d.src[d.srcPos]) << uint(24-d.bitsAvail)
+		d.srcPos++
+		d.bitsAvail += 8
+	}
+	if d.bitsAvail < n {
+		if d.err == nil {
+			d.err = fmt.Errorf("lh5: unexpected EOF while reading %d bits", n)
+		}
+		return d.err
+	}
+	return nil
+}
+
+func (d *lh5RefDecoder) ensureLookupBits(n int) error {
+	if err := d.ensureBits(n); err != nil {
+		if d.srcPos == len(d.src) && d.bitsAvail > 0 {
+			d.err = nil
+			return nil
+		}
+		return err
+	}
+	return nil
+}
+
+// peekBits returns the top n bits without consuming them.
+func (d *lh5RefDecoder) peekBits(n int) uint16 {
+	_ = d.ensureBits(n)
+	return uint16(d.bitBuf >> uint(32-n))
+}
+
+// dropBits consumes n bits from the buffer.
+func (d *lh5RefDecoder) dropBits(n int) {
+	if n < 0 || n > d.bitsAvail {
+		if d.err == nil {
+			d.err = fmt.Errorf("lh5: invalid bit drop %d with %d available", n, d.bitsAvail)
+		}
+		return
+	}
+	d.bitBuf <<= uint(n)
+	d.bitsAvail -= n
+}
+
+// getBits reads and consumes n bits.
+func (d *lh5RefDecoder) getBits(n int) uint16 {
+	v := d.peekBits(n)
+	d.dropBits(n)
+	return v
+}
+
+func (d *lh5RefDecoder) decodeC() (int, error) {
+	if d.blockRemaining <= 0 {
+		d.blockRemaining = int(d.getBits(16))
+		if d.err != nil {
+			return 0, d.err
+		}
+		if d.blockRemaining == 0 {
+			return 0, fmt.Errorf("lh5: invalid zero-length block")
+		}
+		if err := d.readPTLen(lh5NT, lh5TBit, 3); err != nil {
+			return 0, err
+		}
+		if err := d.readCLen(); err != nil {
+			return 0, err
+		}
+		np := d.np
+		if np == 0 {
+			np = lh5NP // fallback for zero-value struct
+		}
+		if err := d.readPTLen(np, lh5PBit, -1); err != nil {
+			return 0, err
+		}
+	}
+	d.blockRemaining--
+
+	if err := d.ensureLookupBits(lh5CTableBits); err != nil {
+		return 0, err
+	}
+	j := d.cTable[d.bitBuf>>uint(32-lh5CTableBits)]
+	if int(j) >= lh5NC {
+		mask := uint32(1) << uint(32-lh5CTableBits-1)
+		for int(j) >= lh5NC {
+			if mask == 0 || int(j) >= len(d.left) {
+				return 0, fmt.Errorf("lh5: invalid character tree")
+			}
+			if d.bitBuf&mask != 0 {
+				j = d.right[j]
+			} else {
+				j = d.left[j]
+			}
+			mask >>= 1
+		}
+	}
+	d.dropBits(int(d.cLen[j]))
+	if d.err != nil {
+		return 0, d.err
+	}
+	return int(j), nil
+}
+
+func (d *lh5RefDecoder) decodeP() (int, error) {
+	np := d.np
+	if np == 0 {
+		np = lh5NP
+	}
+	if err := d.ensureLookupBits(lh5PTableBits); err != nil {
+		return 0, err
+	}
+	j := d.pTable[d.bitBuf>>uint(32-lh5PTableBits)]
+	if int(j) >= np {
+		mask := uint32(1) << uint(32-lh5PTableBits-1)
+		for int(j) >= np {
+			if mask == 0 || int(j) >= len(d.left) {
+				return 0, fmt.Errorf("lh5: invalid position tree")
+			}
+			if d.bitBuf&mask != 0 {
+				j = d.right[j]
+			} else {
+				j = d.left[j]
+			}
+			mask >>= 1
+		}
+	}
+	d.dropBits(int(d.pLen[j]))
+	if d.err != nil {
+		return 0, d.err
+	}
+
+	if j == 0 {
+		return 0, nil
+	}
+	extra := int(d.getBits(int(j) - 1))
+	if d.err != nil {
+		return 0, d.err
+	}
+	return (1 << uint(j-1)) + extra, nil
+}
+
+// readPTLen reads a Huffman tree for position/temp decoding.
+func (d *lh5RefDecoder) readPTLen(nn, nBit, iSpecial int) error {
+	n := int(d.getBits(nBit))
+	if d.err != nil {
+		return d.err
+	}
+	if n == 0 {
+		c := d.getBits(nBit)
+		if d.err != nil {
+			return d.err
+		}
+		for i := range nn {
+			d.pLen[i] = 0
+		}
+		for i := range lh5PTableSize {
+			d.pTable[i] = c
+		}
+		return nil
+	}
+
+	i := 0
+	for i < n && i < nn {
+		if err := d.ensureBits(3); err != nil {
+			return err
+		}
+		c := int(d.peekBits(3))
+		if c == 7 {
+			// Load the whole unary run (up to 13 bits past the first three),
+			// not just the 4 bits that ensureBits would guarantee.
+			for d.bitsAvail <= 24 && d.srcPos < len(d.src) {
+				d.bitBuf |= uint32(d.src[d.srcPos]) << uint(24-d.bitsAvail)
+				d.srcPos++
+				d.bitsAvail += 8
+			}
+			mask := uint32(1) << uint(32-4)
+			for mask&d.bitBuf != 0 {
+				c++
+				mask >>= 1
+				if c > 16 {
+					return fmt.Errorf("lh5: invalid code length")
+				}
+			}
+		}
+		if c < 7 {
+			d.dropBits(3)
+		} else {
+			d.dropBits(c - 3)
+		}
+		if d.err != nil {
+			return d.err
+		}
+		d.pLen[i] = uint8(c)
+		i++
+
+		if i == iSpecial {
+			gap := int(d.getBits(2))
+			if d.err != nil {
+				return d.err
+			}
+			for gap > 0 && i < nn {
+				d.pLen[i] = 0
+				i++
+				gap--
+			}
+		}
+	}
+	for i < nn {
+		d.pLen[i] = 0
+		i++
+	}
+
+	return d.makeTable(nn, d.pLen[:nn], lh5PTableBits, d.pTable[:], d.left[:], d.right[:])
+}
+
+// readCLen reads the character Huffman tree using the temp tree (in pTable/pLen).
+func (d *lh5RefDecoder) readCLen() error {
+	n := int(d.getBits(lh5CBit))
+	if d.err != nil {
+		return d.err
+	}
+	if n == 0 {
+		c := d.getBits(lh5CBit)
+		if d.err != nil {
+			return d.err
+		}
+		for i := range lh5NC {
+			d.cLen[i] = 0
+		}
+		for i := range lh5CTableSize {
+			d.cTable[i] = c
+		}
+		return nil
+	}
+
+	i := 0
+	for i < n && i < lh5NC {
+		if err := d.ensureBits(lh5PTableBits); err != nil {
+			return err
+		}
+		c := int(d.pTable[d.bitBuf>>uint(32-lh5PTableBits)])
+		if c >= lh5NT {
+			mask := uint32(1) << uint(32-lh5PTableBits-1)
+			for c >= lh5NT {
+				if mask == 0 || c >= len(d.left) {
+					return fmt.Errorf("lh5: invalid code-length tree")
+				}
+				if d.bitBuf&mask != 0 {
+					c = int(d.right[c])
+				} else {
+					c = int(d.left[c])
+				}
+				mask >>= 1
+			}
+		}
+		d.dropBits(int(d.pLen[c]))
+		if d.err != nil {
+			return d.err
+		}
+
+		if c <= 2 {
+			var runLen int
+			switch c {
+			case 0:
+				runLen = 1
+			case 1:
+				runLen = int(d.getBits(4)) + 3
+			case 2:
+				runLen = int(d.getBits(lh5CBit)) + 20
+			}
+			if d.err != nil {
+				return d.err
+			}
+			for runLen > 0 && i < lh5NC {
+				d.cLen[i] = 0
+				i++
+				runLen--
+			}
+		} else {
+			d.cLen[i] = uint8(c - 2)
+			i++
+		}
+	}
+	for i < lh5NC {
+		d.cLen[i] = 0
+		i++
+	}
+
+	return d.makeTable(lh5NC, d.cLen[:], lh5CTableBits, d.cTable[:], d.left[:], d.right[:])
+}
+
+// makeTable builds a Huffman lookup table from code lengths.
+func (d *lh5RefDecoder) makeTable(nchar int, bitLen []uint8, tableBits int, table []uint16, left, right []uint16) error {
+	tableSize := 1 << uint(tableBits)
+
+	var count [17]uint32
+	for i := range nchar {
+		if bitLen[i] > 16 {
+			return fmt.Errorf("lh5: code length %d exceeds 16", bitLen[i])
+		}
+		count[bitLen[i]]++
+	}
+
+	// Calculate starting codes using weight-based approach
+	var weight [17]uint32
+	for i := 1; i <= 16; i++ {
+		weight[i] = 1 << uint(16-i)
+	}
+
+	total := uint32(0)
+	var start [18]uint32
+	for i := 1; i <= 16; i++ {
+		start[i] = total
+		total += uint32(count[i]) * weight[i]
+		if total > 1<<16 {
+			return fmt.Errorf("lh5: oversubscribed huffman table")
+		}
+	}
+	if total != 1<<16 {
+		return fmt.Errorf("lh5: incomplete huffman table")
+	}
+
+	// Shift start values for table-sized codes
+	m := uint(16 - tableBits)
+	for i := 1; i <= tableBits; i++ {
+		start[i] >>= m
+	}
+
+	avail := uint16(nchar)
+
+	for i := range tableSize {
+		table[i] = 0
+	}
+
+	for ch := range nchar {
+		l := int(bitLen[ch])
+		if l == 0 {
+			continue
+		}
+
+		if l <= tableBits {
+			fillCount := 1 << uint(tableBits-l)
+			idx := int(start[l])
+			if idx < 0 || idx+fillCount > tableSize {
+				return fmt.Errorf("lh5: huffman table overflow")
+			}
+			for k := 0; k < fillCount; k++ {
+				table[idx+k] = uint16(ch)
+			}
+			start[l] += uint32(fillCount)
+		} else {
+			// Code longer than table: build overflow tree
+			idx := int(start[l] >> uint(l-tableBits))
+			if idx >= tableSize {
+				continue
+			}
+			p := &table[idx]
+			for i := tableBits + 1; i <= l; i++ {
+				if *p == 0 {
+					if int(avail) >= len(left) {
+						return fmt.Errorf("lh5: huffman tree overflow")
+					}
+					left[avail] = 0
+					right[avail] = 0
+					*p = avail
+					avail++
+				}
+				bit := (start[l] >> uint(l-i)) & 1
+				if bit != 0 {
+					p = &right[*p]
+				} else {
+					p = &left[*p]
+				}
+			}
+			*p = uint16(ch)
+			start[l] += weight[l] >> m
+		}
+	}
+
+	return nil
+}
@@ -10,6 +10,8 @@
 //   - Call:    Subroutine call/return (JSR + RTS) measuring block-exit cost
 //   - Branch:  Conditional branches with mixed taken/not-taken patterns
 //   - Mixed:   Interleaved ALU, memory, and branches
+//   - FPU:     68881 memory/Dn operands and FSIN/FCOS/FETOX/FLOGN, with the
+//     JIT's polynomial kernels (mode=fast) and the exact helper path (mode=exact)
 //
 // Usage:
 //
@@ -467,3 +469,81 @@ func BenchmarkM68K_LazyCCR_CMP_Bcc_Interpreter(b *testing.B) {
 	b.ReportMetric(float64(totalInstrs), "instructions/op")
 	ReportMIPSHostNormalized(b, totalInstrs)
 }
+
+// ===========================================================================
+// FPU Benchmark: EA operands and transcendentals
+// ===========================================================================
+
+// buildM68KFPUProgram loops over the native FPU parity scenarios: memory and
+// Dn operands feeding FSIN/FCOS/FETOX/FLOGN and arithmetic.
+func buildM68KFPUProgram(cpu *M68KCPU) (startPC uint32, instrPerIter int) {
+	startPC = 0x1000
+	writeM68KProgram(cpu, m68kBenchDataAddr, fpuDoubleWords(0.75)...)
+	writeM68KProgram(cpu, m68kBenchDataAddr+8, fpuDoubleWords(1.25)...)
+
+	pc := writeM68KProgram(cpu, startPC, 0x41F9, uint16(m68kBenchDataAddr>>16), uint16(m68kBenchDataAddr&0xFFFF)) // LEA data,A0
+	pc = writeM68KProgram(cpu, pc, 0x3E3C, uint16(m68kBenchIterations-1))                                         // MOVE.W #iter-1,D7
+
+	loopTop := pc
+	pc = writeM68KProgram(cpu, pc, fpuEAProgram(FPU_OP_FMOVE, 5, 2, 0, 0)...)         // FMOVE.D (A0),FP0
+	pc = writeM68KProgram(cpu, pc, fpuRegToRegProgram(FPU_OP_FSIN, 0, 1)...)          // FSIN FP0,FP1
+	pc = writeM68KProgram(cpu, pc, fpuRegToRegProgram(FPU_OP_FCOS, 0, 2)...)          // FCOS FP0,FP2
+	pc = writeM68KProgram(cpu, pc, fpuRegToRegProgram(FPU_OP_FMUL, 2, 1)...)          // FMUL FP2,FP1
+	pc = writeM68KProgram(cpu, pc, fpuEAProgram(FPU_OP_FETOX, 5, 5, 0, 3, 0x0008)...) // FETOX.D 8(A0),FP3
+	pc = writeM68KProgram(cpu, pc, fpuRegToRegProgram(FPU_OP_FLOGN, 3, 4)...)         // FLOGN FP3,FP4
+	pc = writeM68KProgram(cpu, pc, fpuEAProgram(FPU_OP_FADD, 4, 0, 7, 5)...)          // FADD.W D7,FP5
+	pc = writeM68KProgram(cpu, pc, fpuRegToRegProgram(FPU_OP_FADD, 1, 5)...)          // FADD FP1,FP5
+
+	disp := int16(int32(loopTop) - int32(pc) - 2)
+	pc = writeM68KProgram(cpu, pc, 0x51CF, uint16(disp)) // DBRA D7,loop
+	writeM68KProgram(cpu, pc, 0x4E72, 0x2700)            // STOP
+
+	return startPC, 9
+}
+
+func BenchmarkM68K_FPU_Interpreter(b *testing.B) {
+	cpu := setupM68KJITBenchCPU()
+	startPC, instrPerIter := buildM68KFPUProgram(cpu)
+	totalInstrs := m68kBenchIterations * instrPerIter
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		runM68KBenchInterpreter(cpu, startPC)
+	}
+	b.ReportMetric(float64(totalInstrs), "instructions/op")
+	ReportMIPSHostNormalized(b, totalInstrs)
+}
+
+// BenchmarkM68K_FPU_JIT compares the native transcendental kernels against
+// the exact (helper) mode:
+//
+//	go test -tags headless -run '^$' -bench 'M68K_FPU_JIT' -count 10 | benchstat -col /mode -
+func BenchmarkM68K_FPU_JIT(b *testing.B) {
+	if !m68kJitAvailable {
+		b.Skip("M68K JIT not available on this platform")
+	}
+	defer func(exact bool) { m68kJITFPUExactTranscendentals = exact }(m68kJITFPUExactTranscendentals)
+	for _, mode := range []struct {
+		name  string
+		exact bool
+	}{{"mode=fast", false}, {"mode=exact", true}} {
+		b.Run(mode.name, func(b *testing.B) {
+			m68kJITFPUExactTranscendentals = mode.exact
+			cpu := setupM68KJITBenchCPU()
+			startPC, instrPerIter := buildM68KFPUProgram(cpu)
+			totalInstrs := m68kBenchIterations * instrPerIter
+
+			cpu.m68kJitEnabled = true
+			cpu.m68kJitForceNative = true
+			cpu.m68kJitPersist = true
+			runM68KBenchJIT(cpu, startPC)
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				runM68KBenchJIT(cpu, startPC)
+			}
+			b.ReportMetric(float64(totalInstrs), "instructions/op")
+			ReportMIPSHostNormalized(b, totalInstrs)
+		})
+	}
+}
@@ -5,8 +5,9 @@ import "testing"
 // Slice 1 of native M68K FPU JIT: the pure register-to-register decode/eligibility
 // predicate. It must mirror execFPURegToReg + m68kFPUDecodePrecisionOpmode exactly
 // (src/dst/precision) so the native path and the interpreter never disagree.
-// Only the SSE2-cleanly-mappable arithmetic ops are eligible; transcendentals,
-// EA-operand forms, control/FMOVEM and non-general Line-F stay on the helper.
+// The SSE2-cleanly-mappable arithmetic ops and FSIN/FCOS/FETOX/FLOGN are
+// eligible; other transcendentals, extended/packed and indexed EA operands,
+// control/FMOVEM and non-general Line-F stay on the helper.
 
 // fpuRegToRegCmd builds a general FPU register-to-register command word.
 func fpuRegToRegCmd(src, dst int, op uint16) uint16 {
@@ -30,6 +31,10 @@ func TestM68KDecodeNativeFPU_ArithmeticRegToReg(t *testing.T) {
 		{"FABS", FPU_OP_FABS, m68kFPUNativeFABS, m68kFPURoundExtended},
 		{"FNEG", FPU_OP_FNEG, m68kFPUNativeFNEG, m68kFPURoundExtended},
 		{"FSQRT", FPU_OP_FSQRT, m68kFPUNativeFSQRT, m68kFPURoundExtended},
+		{"FSIN", FPU_OP_FSIN, m68kFPUNativeFSIN, m68kFPURoundExtended},
+		{"FCOS", FPU_OP_FCOS, m68kFPUNativeFCOS, m68kFPURoundExtended},
+		{"FETOX", FPU_OP_FETOX, m68kFPUNativeFETOX, m68kFPURoundExtended},
+		{"FLOGN", FPU_OP_FLOGN, m68kFPUNativeFLOGN, m68kFPURoundExtended},
 	}
 	for _, c := range cases {
 		cmd := fpuRegToRegCmd(2, 3, c.op)
@@ -67,7 +72,7 @@ func TestM68KDecodeNativeFPU_RejectsNonNative(t *testing.T) {
 		opcode uint16
 		cmd    uint16
 	}{
-		{"FSIN (transcendental)", fpuGeneralOpcode, fpuRegToRegCmd(2, 3, 0x0E)},
+		{"FTAN (transcendental)", fpuGeneralOpcode, fpuRegToRegCmd(2, 3, FPU_OP_FTAN)},
 		{"FSINCOS", fpuGeneralOpcode, fpuRegToRegCmd(2, 3, 0x30)},
 		{"R/M=1 EA source", fpuGeneralOpcode, fpuRegToRegCmd(2, 3, FPU_OP_FADD) | 0x4000},
 		{"control/FMOVEM", fpuGeneralOpcode, fpuRegToRegCmd(2, 3, FPU_OP_FADD) | 0x8000},
@@ -87,3 +92,55 @@ func TestM68KDecodeNativeFPU_RejectsNonNative(t *testing.T) {
 		}
 	}
 }
+
+// fpuEACmd builds a general FPU <ea>,FPn command word (R/M=1).
+func fpuEACmd(format uint16, dst int, op uint16) uint16 {
+	return 0x4000 | (format&7)<<10 | uint16(dst&7)<<7 | (op & 0x7F)
+}
+
+func TestM68KDecodeNativeFPU_EAToReg(t *testing.T) {
+	cases := []struct {
+		name   string
+		opcode uint16
+		cmd    uint16
+		want   m68kFPUNativeOp
+		ea     m68kFPUNativeEA
+	}{
+		{"fmove.l d3", fpuGeneralOpcode | 0x03, fpuEACmd(0, 1, FPU_OP_FMOVE), m68kFPUNativeFMOVE, m68kFPUNativeEA{0, 3, 0}},
+		{"fadd.s (a2)", fpuGeneralOpcode | 0x12, fpuEACmd(1, 1, FPU_OP_FADD), m68kFPUNativeFADD, m68kFPUNativeEA{2, 2, 1}},
+		{"fmul.d (a0)+", fpuGeneralOpcode | 0x18, fpuEACmd(5, 1, FPU_OP_FMUL), m68kFPUNativeFMUL, m68kFPUNativeEA{3, 0, 5}},
+		{"fsub.w -(a1)", fpuGeneralOpcode | 0x21, fpuEACmd(4, 1, FPU_OP_FSUB), m68kFPUNativeFSUB, m68kFPUNativeEA{4, 1, 4}},
+		{"fcmp.b d16(a5)", fpuGeneralOpcode | 0x2D, fpuEACmd(6, 1, FPU_OP_FCMP), m68kFPUNativeFCMP, m68kFPUNativeEA{5, 5, 6}},
+		{"fsin.d abs.l", fpuGeneralOpcode | 0x39, fpuEACmd(5, 1, FPU_OP_FSIN), m68kFPUNativeFSIN, m68kFPUNativeEA{7, 1, 5}},
+		{"fetox.d d16(pc)", fpuGeneralOpcode | 0x3A, fpuEACmd(5, 1, FPU_OP_FETOX), m68kFPUNativeFETOX, m68kFPUNativeEA{7, 2, 5}},
+		{"fdiv.l #imm", fpuGeneralOpcode | 0x3C, fpuEACmd(0, 1, FPU_OP_FDIV), m68kFPUNativeFDIV, m68kFPUNativeEA{7, 4, 0}},
+	}
+	for _, c := range cases {
+		op, ea, dst, _, ok := m68kDecodeNativeFPUEAToReg(c.opcode, c.cmd)
+		if !ok || op != c.want || ea != c.ea || dst != 1 {
+			t.Errorf("%s: op=%v ea=%+v dst=%d ok=%v, want %v %+v 1 true", c.name, op, ea, dst, ok, c.want, c.ea)
+		}
+	}
+
+	rej := []struct {
+		name   string
+		opcode uint16
+		cmd    uint16
+	}{
+		{"fmove.d d0 (does not fit)", fpuGeneralOpcode, fpuEACmd(5, 1, FPU_OP_FMOVE)},
+		{"fmove.x (a0)", fpuGeneralOpcode | 0x10, fpuEACmd(2, 1, FPU_OP_FMOVE)},
+		{"fmove.p (a0)", fpuGeneralOpcode | 0x10, fpuEACmd(3, 1, FPU_OP_FMOVE)},
+		{"a0 direct", fpuGeneralOpcode | 0x08, fpuEACmd(0, 1, FPU_OP_FMOVE)},
+		{"d8(a0,d0)", fpuGeneralOpcode | 0x30, fpuEACmd(0, 1, FPU_OP_FMOVE)},
+		{"d8(pc,d0)", fpuGeneralOpcode | 0x3B, fpuEACmd(0, 1, FPU_OP_FMOVE)},
+		{"FMOVECR", fpuGeneralOpcode, 0x5C00 | 1<<7},
+		{"FTAN.d (a0)", fpuGeneralOpcode | 0x10, fpuEACmd(5, 1, FPU_OP_FTAN)},
+		{"fmove fp1,(a0)", fpuGeneralOpcode | 0x10, 0x6000 | 5<<10 | 1<<7},
+		{"reg-to-reg", fpuGeneralOpcode, fpuRegToRegCmd(2, 3, FPU_OP_FADD)},
+	}
+	for _, c := range rej {
+		if op, _, _, _, ok := m68kDecodeNativeFPUEAToReg(c.opcode, c.cmd); ok {
+			t.Errorf("%s: ok=true op=%v, want not native-eligible", c.name, op)
+		}
+	}
+}
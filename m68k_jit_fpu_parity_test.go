@@ -64,6 +64,10 @@ func runM68KFPUParity(t *testing.T, name string, opcodes []uint16, preset func(*
 	if jit.FPU.FPIAR != interp.FPU.FPIAR {
 		t.Fatalf("%s: FPIAR got=%#08x want=%#08x", name, jit.FPU.FPIAR, interp.FPU.FPIAR)
 	}
+	// EA operands: (An)+ / -(An) must step exactly as the interpreter does.
+	if jit.DataRegs != interp.DataRegs || jit.AddrRegs != interp.AddrRegs {
+		t.Fatalf("%s: D=%08X A=%08X, want D=%08X A=%08X", name, jit.DataRegs, jit.AddrRegs, interp.DataRegs, interp.AddrRegs)
+	}
 
 	if jit.m68kJitNativeBlocksExecuted.Load() == 0 {
 		t.Fatalf("%s: block did not execute natively", name)
@@ -131,3 +135,137 @@ func TestM68KJIT_NativeFPU_CompareParity(t *testing.T) {
 		})
 	}
 }
+
+// fpuEAProgram builds <op>.<format> <ea>,FPdst followed by the EA's extension
+// words.
+func fpuEAProgram(op, format uint16, mode, reg uint16, dst int, ext ...uint16) []uint16 {
+	return append([]uint16{0xF200 | mode<<3 | reg, 0x4000 | format<<10 | uint16(dst&7)<<7 | (op & 0x7F)}, ext...)
+}
+
+// fpuDoubleWords splits a double into its four big-endian extension words.
+func fpuDoubleWords(v float64) []uint16 {
+	b := math.Float64bits(v)
+	return []uint16{uint16(b >> 48), uint16(b >> 32), uint16(b >> 16), uint16(b)}
+}
+
+func TestM68KJIT_NativeFPU_EAParity(t *testing.T) {
+	const data = uint32(0x3000)
+	preset := func(cpu *M68KCPU) {
+		cpu.FPU.SetFP64(1, 10.0)
+		cpu.FPU.SetFP64(6, 6.5) // scratch when the destination is FP7
+		cpu.FPU.SetFP64(7, -2.25)
+		cpu.DataRegs[0] = 0xFFFFFFF9            // long -7
+		cpu.DataRegs[1] = 0x1234FFFE            // word -2
+		cpu.DataRegs[2] = 0x00000080            // byte -128
+		cpu.DataRegs[3] = math.Float32bits(1.5) // single
+		cpu.AddrRegs[0] = data                  // double 1/3
+		cpu.AddrRegs[1] = data + 0x12           // -(A1) word → data+0x10
+		cpu.AddrRegs[2] = data + 0x20           // d16(A2)
+		cpu.AddrRegs[7] = data + 0x40           // (A7)+ byte steps by 2
+		writeM68KWords(cpu, data, fpuDoubleWords(1.0/3)...)
+		writeM68KWords(cpu, data+0x10, 0x8000) // word -32768
+		writeM68KWords(cpu, data+0x28, fpuDoubleWords(1e300)...)
+		writeM68KWords(cpu, data+0x30, uint16(math.Float32bits(-0.1)>>16), uint16(math.Float32bits(-0.1)))
+		writeM68KWords(cpu, data+0x40, 0x7F00)         // byte 127
+		writeM68KWords(cpu, data+0x50, 0x0001, 0x0000) // long 65536
+	}
+	cases := []struct {
+		name string
+		prog []uint16
+	}{
+		{"fmove.l d0", fpuEAProgram(FPU_OP_FMOVE, 0, 0, 0, 1)},
+		{"fadd.w d1", fpuEAProgram(FPU_OP_FADD, 4, 0, 1, 1)},
+		{"fmul.b d2", fpuEAProgram(FPU_OP_FMUL, 6, 0, 2, 1)},
+		{"fdiv.s d3", fpuEAProgram(FPU_OP_FDIV, 1, 0, 3, 1)},
+		{"fsub.l #", fpuEAProgram(FPU_OP_FSUB, 0, 7, 4, 1, 0x8000, 0x0000)},
+		{"fadd.w #", fpuEAProgram(FPU_OP_FADD, 4, 7, 4, 7, 0xFFFF)},
+		{"fcmp.b #", fpuEAProgram(FPU_OP_FCMP, 6, 7, 4, 1, 0x000A)},
+		{"fsmove.d #", fpuEAProgram(FPU_OP_FMOVE|0x40, 5, 7, 4, 1, fpuDoubleWords(math.Pi)...)},
+		{"fmove.d (a0)", fpuEAProgram(FPU_OP_FMOVE, 5, 2, 0, 1)},
+		{"fadd.d (a0)+", fpuEAProgram(FPU_OP_FADD, 5, 3, 0, 1)},
+		{"fsub.w -(a1)", fpuEAProgram(FPU_OP_FSUB, 4, 4, 1, 7)},
+		{"fmul.b (a7)+", fpuEAProgram(FPU_OP_FMUL, 6, 3, 7, 1)},
+		{"fsmul.d d16(a2)", fpuEAProgram(FPU_OP_FMUL|0x40, 5, 5, 2, 1, 0x0008)},
+		{"fdiv.s abs.w", fpuEAProgram(FPU_OP_FDIV, 1, 7, 0, 1, uint16(data+0x30))},
+		{"fmove.l abs.l", fpuEAProgram(FPU_OP_FMOVE, 0, 7, 1, 1, uint16(data>>16), uint16(data+0x50))},
+		{"ftst.d d16(pc)", fpuEAProgram(FPU_OP_FTST, 5, 7, 2, 1, uint16(data+0x28-0x1004))},
+		{"fsqrt.d (a0)", fpuEAProgram(FPU_OP_FSQRT, 5, 2, 0, 1)},
+	}
+	for _, c := range cases {
+		runM68KFPUParity(t, c.name, c.prog, preset)
+	}
+}
+
+// fpuTranscendentalInputs mixes in-domain operands with ones the native
+// kernels leave to the helper (NaN, infinities, huge/zero/negative).
+var fpuTranscendentalInputs = []float64{
+	0.5, -1.25, math.Pi / 3, 100.25, -708, 1e-300, 2, 1e300,
+	0, math.Copysign(0, -1), -1, 1e10, 709.5, -745, math.Inf(1), math.Inf(-1), math.NaN(),
+}
+
+var fpuTranscendentalOps = []struct {
+	name   string
+	opmode uint16
+	op     m68kFPUNativeOp
+	exact  func(float64) float64
+	fast   func(float64) float64
+}{
+	{"FSIN", FPU_OP_FSIN, m68kFPUNativeFSIN, math.Sin, func(x float64) float64 { return m68kFastSinCos(x, false) }},
+	{"FCOS", FPU_OP_FCOS, m68kFPUNativeFCOS, math.Cos, func(x float64) float64 { return m68kFastSinCos(x, true) }},
+	{"FETOX", FPU_OP_FETOX, m68kFPUNativeFETOX, math.Exp, m68kFastExp},
+	{"FLOGN", FPU_OP_FLOGN, m68kFPUNativeFLOGN, math.Log, m68kFastLog},
+}
+
+// TestM68KJIT_NativeFPU_TranscendentalFast checks the polynomial kernels
+// against their Go models bit for bit, and that out-of-domain operands reach
+// the interpreter's package-math result through the helper.
+func TestM68KJIT_NativeFPU_TranscendentalFast(t *testing.T) {
+	if !m68kJitAvailable {
+		t.Skip("M68K JIT not available")
+	}
+	for _, o := range fpuTranscendentalOps {
+		for _, x := range fpuTranscendentalInputs {
+			for _, prog := range [][]uint16{
+				fpuRegToRegProgram(o.opmode, 2, 3),
+				fpuEAProgram(o.opmode, 5, 7, 4, 3, fpuDoubleWords(x)...),
+			} {
+				cpu := newM68KTestProgramCPU(t, 0x1000)
+				cpu.m68kJitEnabled = true
+				cpu.FPU.SetFP64(2, x)
+				writeM68KStopProgram(cpu, 0x1000, prog...)
+				runM68KJITUntilStopped(t, cpu)
+
+				want := o.exact(x)
+				if m68kFPUNativeInDomain(o.op, x) {
+					want = o.fast(x)
+				}
+				got := cpu.FPU.GetFP64(3)
+				if math.Float64bits(got) != math.Float64bits(want) {
+					t.Fatalf("%s(%v) [%04X]: got %v (%#016x), want %v (%#016x)",
+						o.name, x, prog[0], got, math.Float64bits(got), want, math.Float64bits(want))
+				}
+				if cc, wantCC := cpu.FPU.FPSR&fpuCCMask, m68kFPUConditionBits(math.Float64bits(want)); cc != wantCC {
+					t.Fatalf("%s(%v): FPSR cc=%#08x, want %#08x", o.name, x, cc, wantCC)
+				}
+				if cpu.FPU.GetFP64(2) != x && !math.IsNaN(x) {
+					t.Fatalf("%s(%v): source FP2 clobbered", o.name, x)
+				}
+			}
+		}
+	}
+}
+
+// TestM68KJIT_NativeFPU_TranscendentalExactParity pins the exact mode: with
+// m68kJITFPUExactTranscendentals set the JIT is bit-identical to the
+// interpreter for every operand.
+func TestM68KJIT_NativeFPU_TranscendentalExactParity(t *testing.T) {
+	defer func(exact bool) { m68kJITFPUExactTranscendentals = exact }(m68kJITFPUExactTranscendentals)
+	m68kJITFPUExactTranscendentals = true
+	for _, o := range fpuTranscendentalOps {
+		for _, x := range fpuTranscendentalInputs {
+			runM68KFPUParity(t, o.name, fpuRegToRegProgram(o.opmode, 2, 3), func(cpu *M68KCPU) {
+				cpu.FPU.SetFP64(2, x)
+			})
+		}
+	}
+}
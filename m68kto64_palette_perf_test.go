@@ -12,6 +12,7 @@
 package main
 
 import (
+	"bytes"
 	"testing"
 	"time"
 )
@@ -83,3 +84,79 @@ func TestPalettePerf_PureDbraThroughput(t *testing.T) {
 			itersPerSec)
 	}
 }
+
+// timeToHalt is runToHalt that also reports the step count and wall time;
+// running out of steps is fatal here.
+func timeToHalt(t *testing.T, bin []byte, maxSteps int) (*CPU64, int, time.Duration) {
+	t.Helper()
+	bus := NewMachineBus()
+	cpu := NewCPU64(bus)
+	cpu.LoadProgramBytes(bin)
+	cpu.PC = PROG_START
+	start := time.Now()
+	steps := 0
+	for steps < maxSteps && cpu.PC != 0 && cpu.memory[cpu.PC] != OP_HALT64 {
+		cpu.StepOne()
+		steps++
+	}
+	elapsed := time.Since(start)
+	if steps >= maxSteps {
+		t.Fatalf("program did not halt in %d steps (last PC=%#x)", maxSteps, cpu.PC)
+	}
+	return cpu, steps, elapsed
+}
+
+// TestPalettePerf_Peephole runs the palette loop and a copy loop with and
+// without -peephole, checks guest registers and shadow CCR agree at HALT,
+// and reports the retired-instruction and wall-time reduction.
+func TestPalettePerf_Peephole(t *testing.T) {
+	if testing.Short() {
+		t.Skip("perf test; skipped with -short")
+	}
+	progs := map[string]string{
+		"palette": `
+		move.w #255,d6
+.outer:
+		move.w #255,d7
+		moveq #0,d0
+.inner:
+		addq.l #1,d0
+		dbra d7,.inner
+		dbra d6,.outer
+	`,
+		"copy": `
+		lea $20000,a0
+		lea $30000,a1
+		move.w #4095,d7
+.copy:
+		move.l (a0)+,d0
+		move.b d0,8(a1)
+		move.l d0,(a1)+
+		dbra d7,.copy
+	`,
+	}
+	for name, src := range progs {
+		t.Run(name, func(t *testing.T) {
+			base, baseSteps, baseTime := timeToHalt(t, transpileAndAssemble(t, src), 50_000_000)
+			opt, optSteps, optTime := timeToHalt(t, transpileAndAssembleWithArgs(t, src, "-peephole"), 50_000_000)
+			for r := 1; r <= 15; r++ {
+				if base.regs[r] != opt.regs[r] {
+					t.Errorf("r%d: baseline %#x, peephole %#x", r, base.regs[r], opt.regs[r])
+				}
+			}
+			for r := 24; r <= 28; r++ {
+				if base.regs[r] != opt.regs[r] {
+					t.Errorf("shadow r%d: baseline %#x, peephole %#x", r, base.regs[r], opt.regs[r])
+				}
+			}
+			if !bytes.Equal(base.memory[0x30000:0x34010], opt.memory[0x30000:0x34010]) {
+				t.Errorf("copy destination differs between baseline and peephole")
+			}
+			t.Logf("%s: %d -> %d instructions retired (%.1f%%), %v -> %v",
+				name, baseSteps, optSteps, 100*float64(baseSteps-optSteps)/float64(baseSteps), baseTime, optTime)
+			if optSteps >= baseSteps {
+				t.Errorf("peephole retired %d instructions, baseline %d", optSteps, baseSteps)
+			}
+		})
+	}
+}
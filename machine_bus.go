@@ -1367,6 +1367,22 @@ func (bus *MachineBus) GetMemory() []byte {
 	return bus.memory
 }
 
+// RAMSpan returns bus.memory[addr:addr+n] when the whole range is plain RAM
+// on pages with no MMIO mapping, else nil. Access through the span bypasses
+// debug hooks and JIT invalidation, so it is for bulk reads.
+func (bus *MachineBus) RAMSpan(addr uint32, n int) []byte {
+	if n <= 0 || addr >= 0xFFFF0000 || uint64(addr)+uint64(n) > uint64(len(bus.memory)) {
+		return nil
+	}
+	bitmap := bus.currentMapSnapshot().ioPageBitmap
+	for page := addr >> 8; page <= (addr+uint32(n)-1)>>8; page++ {
+		if page < uint32(len(bitmap)) && bitmap[page] {
+			return nil
+		}
+	}
+	return bus.memory[addr : addr+uint32(n)]
+}
+
 // IsIOAddress reports whether addr resolves to a mapped MMIO region.
 func (bus *MachineBus) IsIOAddress(addr uint32) bool {
 	if addr >= 0xFFFF0000 {
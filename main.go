@@ -221,6 +221,35 @@ func registerHostIOTraceFlags(flagSet *flag.FlagSet) {
 	flagSet.StringVar(&hostIOTraceFile, "trace-host-io-file", "", "Append host-backed media and file I/O trace lines to this file")
 }
 
+func registerMusicRenderFlags(flagSet *flag.FlagSet) {
+	flagSet.BoolFunc("stream-render", "Stream SID/SAP/AY/SNDH guest player output instead of pre-rendering the whole tune", func(v string) error {
+		enabled, err := strconv.ParseBool(v)
+		if err != nil {
+			return err
+		}
+		musicStreamRenderEnabled.Store(enabled)
+		return nil
+	})
+	flagSet.BoolFunc("timed-audio-writes", "Apply Z80/6502 sound register writes at their emulated cycle time instead of when the CPU burst runs (interpreter only; ignored with the JIT)", func(v string) error {
+		enabled, err := strconv.ParseBool(v)
+		if err != nil {
+			return err
+		}
+		audioTimedWritesEnabled.Store(enabled)
+		return nil
+	})
+	flagSet.BoolFunc("audio-adaptive", "Grow or shrink the audio output buffer from observed underruns and callback jitter", func(v string) error {
+		enabled, err := strconv.ParseBool(v)
+		if err != nil {
+			return err
+		}
+		audioAdaptiveBufferEnabled.Store(enabled)
+		return nil
+	})
+	flagSet.StringVar(&musicRenderCacheDir, "render-cache", "", "Directory for the SID/SAP/AY/SNDH rendered event cache (IE_RENDER_CACHE_DIR; size via IE_RENDER_CACHE_MAX_MB)")
+	flagSet.StringVar(&assetCacheDir, "asset-cache", "", "Directory for unpacked ROM/media assets, or \"off\" (IE_ASSET_CACHE_DIR; default: user cache dir; size via IE_ASSET_CACHE_MAX_MB)")
+}
+
 func (config hostHelperFlagConfig) HostHelperConfig() HostHelperConfig {
 	return HostHelperConfig{
 		Enabled:    config.enabled,
@@ -287,6 +316,7 @@ func main() {
 		tedPlus         bool
 		modeAHX         bool
 		ahxPlus         bool
+		ahxWaveBank     bool
 		modeMOD         bool
 		modeWAV         bool
 		modeMIDI        bool
@@ -341,6 +371,7 @@ func main() {
 	flagSet.BoolVar(&tedPlus, "ted+", false, "Enable TED+ enhancements")
 	flagSet.BoolVar(&modeAHX, "ahx", false, "Play AHX file (Amiga AHX module)")
 	flagSet.BoolVar(&ahxPlus, "ahx+", false, "Enable AHX+ enhanced mode")
+	flagSet.BoolVar(&ahxWaveBank, "ahx-wavebank", false, "Render AHX voices from the classic filtered waveform bank")
 	flagSet.BoolVar(&modeMOD, "mod", false, "Play ProTracker MOD file (Amiga 4-channel)")
 	flagSet.BoolVar(&modeWAV, "wav", false, "Play WAV file (PCM audio)")
 	flagSet.StringVar(&midiFile, "midi", "", "Play MIDI file (.mid, .midi, or Doom .mus)")
@@ -354,6 +385,7 @@ func main() {
 	flagSet.BoolVar(&scriptOwnedTerm, "script-owned-term", false, "Disable host terminal I/O; the script drives TerminalMMIO directly. Use with -script in PRM/test harness mode.")
 	registerHostHelperFlags(flagSet, &hostHelperFlags)
 	registerHostIOTraceFlags(flagSet)
+	registerMusicRenderFlags(flagSet)
 	registerCoprocServiceFlags(flagSet, &coprocSvc)
 	var emutosDrive string
 	flagSet.StringVar(&emutosDrive, "emutos-drive", "", "Host directory to map as GEMDOS drive U: (default: ~/)")
@@ -431,7 +463,7 @@ func main() {
 	if tedPlus && !modeTED {
 		modeTED = true
 	}
-	if ahxPlus && !modeAHX {
+	if (ahxPlus || ahxWaveBank) && !modeAHX {
 		modeAHX = true
 	}
 	// -basic-image implies -basic mode
@@ -713,7 +745,9 @@ func main() {
 		if perfMode {
 			instrCount, cpuName, execNanos := psgPlayer.RenderPerf()
 			if cpuName != "" {
-				if execNanos > 0 {
+				if psgPlayer.RenderCacheHit() {
+					fmt.Printf("PSG (%s): render cache hit (%d instructions skipped)\n", cpuName, instrCount)
+				} else if execNanos > 0 {
 					secs := float64(execNanos) / 1e9
 					mips := float64(instrCount) / secs / 1e6
 					fmt.Printf("PSG (%s): %.2f MIPS (%d instructions in %.3fs)\n",
@@ -760,7 +794,9 @@ func main() {
 		if perfMode {
 			instrCount, cpuName, execNanos := sidPlayer.RenderPerf()
 			if cpuName != "" {
-				if execNanos > 0 {
+				if sidPlayer.RenderCacheHit() {
+					fmt.Printf("SID (%s): render cache hit (%d instructions skipped)\n", cpuName, instrCount)
+				} else if execNanos > 0 {
 					secs := float64(execNanos) / 1e9
 					mips := float64(instrCount) / secs / 1e6
 					fmt.Printf("SID (%s): %.2f MIPS (%d instructions in %.3fs)\n",
@@ -809,7 +845,9 @@ func main() {
 		if perfMode {
 			instrCount, cpuName, execNanos := pokeyPlayer.RenderPerf()
 			if cpuName != "" {
-				if execNanos > 0 {
+				if pokeyPlayer.RenderCacheHit() {
+					fmt.Printf("SAP (%s): render cache hit (%d instructions skipped)\n", cpuName, instrCount)
+				} else if execNanos > 0 {
 					secs := float64(execNanos) / 1e9
 					mips := float64(instrCount) / secs / 1e6
 					fmt.Printf("SAP (%s): %.2f MIPS (%d instructions in %.3fs)\n",
@@ -895,6 +933,9 @@ func main() {
 		if ahxPlus {
 			ahxPlayer.engine.SetAHXPlusEnabled(true)
 		}
+		if ahxWaveBank {
+			ahxPlayer.engine.SetWaveBankSynthesis(true)
+		}
 		data, err := os.ReadFile(filename)
 		if err != nil {
 			fmt.Printf("Error reading AHX file: %v\n", err)
@@ -1149,16 +1190,16 @@ func main() {
 	// so that every CPU mode (including EmuTOS) can access the full hardware.
 	sysBus.MapIO(AUDIO_CTRL, AUDIO_REG_END,
 		soundChip.HandleRegisterRead,
-		soundChip.HandleRegisterWrite)
-	sysBus.MapIOByte(AUDIO_CTRL, AUDIO_REG_END, soundChip.HandleRegisterWrite8)
+		soundChip.TimedWrite(soundChip.HandleRegisterWrite))
+	sysBus.MapIOByte(AUDIO_CTRL, AUDIO_REG_END, soundChip.TimedWrite8(soundChip.HandleRegisterWrite8))
 	sysBus.MapIO(SID2_FLEX_BASE, SID2_FLEX_END,
 		soundChip.HandleRegisterRead,
-		soundChip.HandleRegisterWrite)
-	sysBus.MapIOByte(SID2_FLEX_BASE, SID2_FLEX_END, soundChip.HandleRegisterWrite8)
+		soundChip.TimedWrite(soundChip.HandleRegisterWrite))
+	sysBus.MapIOByte(SID2_FLEX_BASE, SID2_FLEX_END, soundChip.TimedWrite8(soundChip.HandleRegisterWrite8))
 	sysBus.MapIO(SID3_FLEX_BASE, SID3_FLEX_END,
 		soundChip.HandleRegisterRead,
-		soundChip.HandleRegisterWrite)
-	sysBus.MapIOByte(SID3_FLEX_BASE, SID3_FLEX_END, soundChip.HandleRegisterWrite8)
+		soundChip.TimedWrite(soundChip.HandleRegisterWrite))
+	sysBus.MapIOByte(SID3_FLEX_BASE, SID3_FLEX_END, soundChip.TimedWrite8(soundChip.HandleRegisterWrite8))
 	sysBus.MapIO(IE_SFX_REGION_BASE, IE_SFX_REGION_END,
 		soundChip.sfx.HandleRead,
 		soundChip.sfx.HandleWrite)
@@ -1184,8 +1225,8 @@ func main() {
 	// Map PSG registers
 	sysBus.MapIO(PSG_BASE, PSG_END,
 		psgEngine.HandleRead,
-		psgEngine.HandleWrite)
-	sysBus.MapIOByte(PSG_BASE, PSG_END, psgEngine.HandleWrite8)
+		soundChip.TimedWrite(psgEngine.HandleWrite))
+	sysBus.MapIOByte(PSG_BASE, PSG_END, soundChip.TimedWrite8(psgEngine.HandleWrite8))
 	sysBus.MapIOWideWriteFanout(PSG_BASE, PSG_END)
 	sysBus.MapIO(PSG_PLUS_CTRL, PSG_PLUS_CTRL,
 		psgEngine.HandlePSGPlusRead,
@@ -1203,8 +1244,8 @@ func main() {
 	// Map SID registers
 	sysBus.MapIO(SID_BASE, SID_END,
 		sidEngine.HandleRead,
-		sidEngine.HandleWrite)
-	sysBus.MapIOByte(SID_BASE, SID_END, sidEngine.HandleWrite8)
+		soundChip.TimedWrite(sidEngine.HandleWrite))
+	sysBus.MapIOByte(SID_BASE, SID_END, soundChip.TimedWrite8(sidEngine.HandleWrite8))
 	sysBus.MapIOWideWriteFanout(SID_BASE, SID_END)
 	sysBus.MapIO(SID_PLAY_PTR, SID_SUBSONG,
 		sidPlayer.HandlePlayRead,
@@ -1213,13 +1254,13 @@ func main() {
 	// Map SID2/SID3 registers for multi-SID playback
 	sysBus.MapIO(SID2_BASE, SID2_END,
 		sid2Engine.HandleRead,
-		sid2Engine.HandleWrite)
-	sysBus.MapIOByte(SID2_BASE, SID2_END, sid2Engine.HandleWrite8)
+		soundChip.TimedWrite(sid2Engine.HandleWrite))
+	sysBus.MapIOByte(SID2_BASE, SID2_END, soundChip.TimedWrite8(sid2Engine.HandleWrite8))
 	sysBus.MapIOWideWriteFanout(SID2_BASE, SID2_END)
 	sysBus.MapIO(SID3_BASE, SID3_END,
 		sid3Engine.HandleRead,
-		sid3Engine.HandleWrite)
-	sysBus.MapIOByte(SID3_BASE, SID3_END, sid3Engine.HandleWrite8)
+		soundChip.TimedWrite(sid3Engine.HandleWrite))
+	sysBus.MapIOByte(SID3_BASE, SID3_END, soundChip.TimedWrite8(sid3Engine.HandleWrite8))
 	sysBus.MapIOWideWriteFanout(SID3_BASE, SID3_END)
 
 	// Map TED audio registers
@@ -1228,7 +1269,7 @@ func main() {
 	tedPlayer.AttachBus(sysBus)
 	sysBus.MapIO(TED_BASE, TED_END,
 		tedEngine.HandleRead,
-		tedEngine.HandleWrite)
+		soundChip.TimedWrite(tedEngine.HandleWrite))
 	sysBus.MapIO(TED_PLAY_PTR, TED_PLAY_STATUS+3,
 		tedPlayer.HandlePlayRead,
 		tedPlayer.HandlePlayWrite)
@@ -1280,8 +1321,8 @@ func main() {
 	pokeyPlayer.AttachBus(sysBus)
 	sysBus.MapIO(POKEY_BASE, POKEY_END,
 		pokeyEngine.HandleRead,
-		pokeyEngine.HandleWrite)
-	sysBus.MapIOByte(POKEY_BASE, POKEY_END, pokeyEngine.HandleWrite8)
+		soundChip.TimedWrite(pokeyEngine.HandleWrite))
+	sysBus.MapIOByte(POKEY_BASE, POKEY_END, soundChip.TimedWrite8(pokeyEngine.HandleWrite8))
 	sysBus.MapIOWideWriteFanout(POKEY_BASE, POKEY_END)
 	sysBus.MapIO(SAP_PLAY_PTR, SAP_SUBSONG,
 		pokeyPlayer.HandlePlayRead,
@@ -1664,27 +1705,31 @@ func main() {
 
 	loadEmuTOSImage := func() ([]byte, string, error) {
 		if emutosImage != "" {
-			b, err := os.ReadFile(emutosImage)
+			b, err := ReadAsset(emutosImage)
 			if err != nil {
 				return nil, "", fmt.Errorf("failed to read EmuTOS image %s: %w", emutosImage, err)
 			}
 			return b, emutosImage, nil
 		}
 		if filename != "" {
-			b, err := os.ReadFile(filename)
+			b, err := ReadAsset(filename)
 			if err != nil {
 				return nil, "", fmt.Errorf("failed to read EmuTOS image %s: %w", filename, err)
 			}
 			return b, filename, nil
 		}
 		if len(embeddedEmuTOSImage) > 0 {
-			return append([]byte(nil), embeddedEmuTOSImage...), "", nil
+			b, err := embeddedAsset(embeddedEmuTOSImage)
+			if err != nil {
+				return nil, "", fmt.Errorf("failed to unpack embedded EmuTOS image: %w", err)
+			}
+			return b, "", nil
 		}
 		autoPath := resolveDefaultEmuTOSImagePath()
 		if autoPath == "" {
 			return nil, "", fmt.Errorf("EmuTOS not embedded and no local ROM image found")
 		}
-		b, err := os.ReadFile(autoPath)
+		b, err := ReadAsset(autoPath)
 		if err != nil {
 			return nil, "", fmt.Errorf("failed to read fallback EmuTOS image %s: %w", autoPath, err)
 		}
@@ -1693,27 +1738,31 @@ func main() {
 
 	loadAROSImage := func() ([]byte, string, error) {
 		if arosImage != "" {
-			b, err := os.ReadFile(arosImage)
+			b, err := ReadAsset(arosImage)
 			if err != nil {
 				return nil, "", fmt.Errorf("failed to read AROS image %s: %w", arosImage, err)
 			}
 			return b, arosImage, nil
 		}
 		if filename != "" {
-			b, err := os.ReadFile(filename)
+			b, err := ReadAsset(filename)
 			if err != nil {
 				return nil, "", fmt.Errorf("failed to read AROS image %s: %w", filename, err)
 			}
 			return b, filename, nil
 		}
 		if len(embeddedAROSImage) > 0 {
-			return append([]byte(nil), embeddedAROSImage...), "", nil
+			b, err := embeddedAsset(embeddedAROSImage)
+			if err != nil {
+				return nil, "", fmt.Errorf("failed to unpack embedded AROS image: %w", err)
+			}
+			return b, "", nil
 		}
 		autoPath := resolveDefaultAROSImagePath()
 		if autoPath == "" {
 			return nil, "", fmt.Errorf("AROS not embedded and no ROM image specified")
 		}
-		b, err := os.ReadFile(autoPath)
+		b, err := ReadAsset(autoPath)
 		if err != nil {
 			return nil, "", fmt.Errorf("failed to read AROS image %s: %w", autoPath, err)
 		}
@@ -1738,7 +1787,7 @@ func main() {
 		return b, paths.Image, nil
 	}
 	machine := NewMachine(MachineDeps{
-		ReadFile:             os.ReadFile,
+		ReadFile:             ReadAsset,
 		ModeFromExtension:    modeFromExtension,
 		LoadBasicBootImage:   loadBasicBootImage,
 		LoadIntuitionOSImage: loadIntuitionOSImage,
@@ -2274,6 +2323,7 @@ func main() {
 
 	// Set global state for cross-module access
 	activeCPU = cpuRunner
+	attachSoundWriteClock(soundChip, cpuRunner)
 	activeVideoChip = videoChip
 
 	// Wire monitor overlay to the video output
@@ -2379,6 +2429,7 @@ func main() {
 		}
 		cpuRunner = newRunner
 		activeCPU = newRunner
+		attachSoundWriteClock(soundChip, newRunner)
 
 		// Re-register CPU with the monitor (old adapters are stale after recreate)
 		machine.UpdateRuntimeCPU(mode, newRunner, runtimeStatus, progExec)
@@ -2780,8 +2831,8 @@ func resolveDefaultAROSImagePath() string {
 		"sdk/roms/aros-ie-m68k.rom",
 	}
 	for _, p := range candidates {
-		if st, err := os.Stat(p); err == nil && !st.IsDir() {
-			return p
+		if found := findAssetFile(p); found != "" {
+			return found
 		}
 	}
 	return ""
@@ -2795,8 +2846,8 @@ func resolveDefaultEmuTOSImagePath() string {
 		"bin/emutos.img",
 	}
 	for _, p := range candidates {
-		if st, err := os.Stat(p); err == nil && !st.IsDir() {
-			return p
+		if found := findAssetFile(p); found != "" {
+			return found
 		}
 	}
 	return ""
@@ -169,7 +169,7 @@ func (m *MediaLoader) loadAndStart(reqGen uint64, fileName, fullPath string, typ
 		}
 	}()
 
-	data, err := os.ReadFile(fullPath)
+	data, err := ReadAsset(fullPath)
 	traceHostIO("MEDIA", "READ", fileName, fullPath, err, len(data))
 	if err != nil {
 		m.mu.Lock()
@@ -317,7 +317,7 @@ func (m *MediaLoader) loadAndStart(reqGen uint64, fileName, fullPath string, typ
 	// request cannot interleave and leave stale playback running.
 	m.stopPlayersOnly()
 
-	// All formats use direct loading — data is already in memory from os.ReadFile.
+	// All formats use direct loading — data is already in memory, unpacked, from ReadAsset.
 	// Release lock during potentially slow decoding (Z80 emulation, SID parsing, etc.).
 	var loadErr error
 	switch typ {
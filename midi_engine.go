@@ -5,7 +5,18 @@ import (
 	"sync"
 )
 
-const midiMaxVoices = 10
+const (
+	// midiMaxVoices is the preallocated voice pool size. Dense GM files
+	// routinely hold 30-50 notes including release tails.
+	midiMaxVoices = 64
+
+	// midiMixHeadroom divides the voice sum. It is independent of the pool
+	// size so raising polyphony does not make sparse tunes quieter.
+	midiMixHeadroom = 10
+
+	// midiRenderBlockSize is the chunk size used by RenderMIDIFile.
+	midiRenderBlockSize = 256
+)
 
 type rawlandMiniPatch struct {
 	waveform   int
@@ -147,6 +158,17 @@ type midiVoice struct {
 	releaseStartLevel float32
 	patch             rawlandMiniPatch
 	live              bool
+
+	// noise is the voice's own LFSR, so voice-major block rendering
+	// consumes it in the same order as the per-sample path.
+	noise uint32
+
+	// Per-note constants derived from patch and freq by primeVoiceLocked;
+	// releaseLen == 0 means not yet primed.
+	inc        float32
+	attackLen  int
+	decayLen   int
+	releaseLen int
 }
 
 type midiChannelState struct {
@@ -172,13 +194,12 @@ type MIDIEngine struct {
 	liveState  midiChannelState
 	voices     [midiMaxVoices]midiVoice
 	order      int64
-	noiseState uint32
 	currentBPM int
 	liveActive bool
 }
 
 func NewMIDIEngine(sound *SoundChip, sampleRate int) *MIDIEngine {
-	e := &MIDIEngine{sound: sound, sampleRate: sampleRate, volume: 255, noiseState: 1, currentBPM: 120}
+	e := &MIDIEngine{sound: sound, sampleRate: sampleRate, volume: 255, currentBPM: 120}
 	e.resetChannelStateLocked()
 	return e
 }
@@ -326,6 +347,10 @@ func (e *MIDIEngine) HasActiveNote(note uint8) bool {
 func (e *MIDIEngine) TickSample() {
 	e.mu.Lock()
 	defer e.mu.Unlock()
+	e.tickLocked()
+}
+
+func (e *MIDIEngine) tickLocked() {
 	if !e.playing || e.paused || e.file == nil {
 		return
 	}
@@ -336,21 +361,27 @@ func (e *MIDIEngine) TickSample() {
 	e.currentBPM = e.file.TempoBPMAtSample(e.position)
 	e.position++
 	if e.playbackCompleteLocked() {
-		if e.loop {
-			e.position = 0
-			e.eventIndex = 0
-			e.clearFileVoicesLocked()
-			e.resetFileChannelStateLocked()
-		} else {
-			e.playing = false
-			e.clearFileVoicesLocked()
-			if e.sound != nil && !e.liveActive {
-				go func() {
-					e.sound.UnregisterSampleTicker("midi")
-					e.sound.UnregisterSampleMixer("midi")
-				}()
-			}
-		}
+		e.endOfFileLocked()
+	}
+}
+
+// endOfFileLocked loops or stops file playback once it is complete. A
+// stopped engine with no live notes unregisters itself from the sound chip.
+func (e *MIDIEngine) endOfFileLocked() {
+	if e.loop {
+		e.position = 0
+		e.eventIndex = 0
+		e.clearFileVoicesLocked()
+		e.resetFileChannelStateLocked()
+		return
+	}
+	e.playing = false
+	e.clearFileVoicesLocked()
+	if e.sound != nil && !e.liveActive {
+		go func() {
+			e.sound.UnregisterSampleTicker("midi")
+			e.sound.UnregisterSampleMixer("midi")
+		}()
 	}
 }
 
@@ -367,6 +398,19 @@ func (e *MIDIEngine) playbackCompleteLocked() bool {
 func (e *MIDIEngine) MixSample() float32 {
 	e.mu.Lock()
 	defer e.mu.Unlock()
+	return e.mixLocked()
+}
+
+// RenderMixBlock implements SampleBlockRenderer with the block renderer, so
+// live playback on a mix worker renders voice-major between events exactly
+// like RenderBlock.
+func (e *MIDIEngine) RenderMixBlock(out []float32) {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	e.renderLocked(out)
+}
+
+func (e *MIDIEngine) mixLocked() float32 {
 	if !e.playing && !e.liveActive {
 		return 0
 	}
@@ -390,7 +434,7 @@ func (e *MIDIEngine) MixSample() float32 {
 	if active == 0 {
 		return 0
 	}
-	return clampF32(sum/float32(midiMaxVoices), -0.8, 0.8)
+	return clampF32(sum/float32(midiMixHeadroom), -0.8, 0.8)
 }
 
 func (e *MIDIEngine) applyEventLocked(ev MIDIEvent, live bool) {
@@ -437,7 +481,19 @@ func (e *MIDIEngine) startNoteLocked(ch, note, velocity uint8, live bool) {
 		freq:       freq,
 		patch:      patch,
 		live:       live,
+		noise:      uint32(e.order*2654435761)&NOISE_LFSR_MASK | 1,
 	}
+	e.primeVoiceLocked(&e.voices[idx])
+}
+
+// primeVoiceLocked caches the phase increment and envelope stage lengths so
+// the per-sample path does no float-to-int conversions.
+func (e *MIDIEngine) primeVoiceLocked(v *midiVoice) {
+	sr := float32(e.sampleRate)
+	v.inc = v.freq / sr
+	v.attackLen = max(1, int(v.patch.attack*sr))
+	v.decayLen = max(1, int(v.patch.decay*sr))
+	v.releaseLen = max(1, int(v.patch.release*sr))
 }
 
 func (e *MIDIEngine) releaseNoteLocked(ch, note uint8, live bool) {
@@ -509,37 +565,53 @@ func midiPriority(ch, note, velocity uint8) int {
 	return p
 }
 
-func (e *MIDIEngine) voiceSampleLocked(v *midiVoice) float32 {
+// voiceGainLocked is the envelope-independent gain of v: velocity, channel
+// volume, expression, master volume and patch level.
+func (e *MIDIEngine) voiceGainLocked(v *midiVoice) float32 {
 	state := e.channelStateLocked(v.live)
 	vol := float32(v.velocity) / 127.0
 	vol *= float32(state.chanVolume[v.channel]) / 127.0
 	vol *= float32(state.expression[v.channel]) / 127.0
 	vol *= float32(e.volume) / 255.0
-	vol *= v.patch.volume
+	return vol * v.patch.volume
+}
+
+func (e *MIDIEngine) voiceSampleLocked(v *midiVoice) float32 {
+	return e.voiceStepLocked(v, e.voiceGainLocked(v))
+}
+
+// voiceStepLocked advances v by one sample and returns its output at gain.
+// A voice whose release completes is cleared and contributes silence.
+func (e *MIDIEngine) voiceStepLocked(v *midiVoice, gain float32) float32 {
+	if v.releaseLen == 0 {
+		e.primeVoiceLocked(v)
+	}
 	envLevel := e.voiceEnvelopeLevelLocked(v)
 	if v.releasing {
-		releaseSamples := max(1, int(v.patch.release*float32(e.sampleRate)))
 		v.releasePos++
-		if v.releasePos >= releaseSamples {
+		if v.releasePos >= v.releaseLen {
 			*v = midiVoice{}
 			return 0
 		}
 	}
-	vol *= envLevel
-	inc := v.freq / float32(e.sampleRate)
-	v.phase += inc
+	vol := gain * envLevel
+	v.phase += v.inc
 	v.ageSamples++
-	for v.phase >= 1 {
-		v.phase -= 1
+	if v.phase >= 1 {
+		v.phase -= float32(int(v.phase))
 	}
 	switch v.patch.waveform {
 	case WAVE_TRIANGLE:
-		return (4*float32(math.Abs(float64(v.phase-0.5))) - 1) * vol
+		d := v.phase - 0.5
+		if d < 0 {
+			d = -d
+		}
+		return (4*d - 1) * vol
 	case WAVE_SAWTOOTH:
 		return (2*v.phase - 1) * vol
 	case WAVE_NOISE:
-		e.noiseState = stepNoiseLFSR(NOISE_MODE_WHITE, e.noiseState)
-		return (float32(e.noiseState&1)*2 - 1) * vol
+		v.noise = stepNoiseLFSR(NOISE_MODE_WHITE, v.noise)
+		return (float32(v.noise&1)*2 - 1) * vol
 	default:
 		if v.phase < 0.5 {
 			return vol
@@ -552,24 +624,113 @@ func (e *MIDIEngine) voiceEnvelopeLevelLocked(v *midiVoice) float32 {
 	if v.patch.volume <= 0 {
 		return 0
 	}
+	if v.releaseLen == 0 {
+		e.primeVoiceLocked(v)
+	}
 	if v.releasing {
-		releaseSamples := max(1, int(v.patch.release*float32(e.sampleRate)))
-		level := v.releaseStartLevel * (1 - float32(v.releasePos)/float32(releaseSamples))
+		level := v.releaseStartLevel * (1 - float32(v.releasePos)/float32(v.releaseLen))
 		return clampF32(level, 0, 1)
 	}
-	attackSamples := max(1, int(v.patch.attack*float32(e.sampleRate)))
-	decaySamples := max(1, int(v.patch.decay*float32(e.sampleRate)))
-	if v.ageSamples < attackSamples {
-		return clampF32(float32(v.ageSamples)/float32(attackSamples), 0, 1)
+	if v.ageSamples < v.attackLen {
+		return clampF32(float32(v.ageSamples)/float32(v.attackLen), 0, 1)
 	}
-	decayPos := v.ageSamples - attackSamples
-	if decayPos < decaySamples {
-		t := float32(decayPos) / float32(decaySamples)
+	decayPos := v.ageSamples - v.attackLen
+	if decayPos < v.decayLen {
+		t := float32(decayPos) / float32(v.decayLen)
 		return clampF32(1-(1-v.patch.sustain)*t, 0, 1)
 	}
 	return clampF32(v.patch.sustain, 0, 1)
 }
 
+// RenderBlock renders len(out) mono samples of file playback without a
+// SoundChip. Events are applied at their exact sample positions and voices are
+// rendered voice-major in runs between events, producing the same output as
+// the TickSample/MixSample pair. It returns the number of samples rendered
+// before playback stopped; the rest of out is zeroed.
+func (e *MIDIEngine) RenderBlock(out []float32) int {
+	e.mu.Lock()
+	defer e.mu.Unlock()
+	return e.renderLocked(out)
+}
+
+// renderLocked is the block renderer behind RenderBlock and RenderMixBlock.
+// While the file is paused or stopped only live voices sound, and rendering
+// ends early only when nothing can sound at all.
+func (e *MIDIEngine) renderLocked(out []float32) int {
+	i := 0
+	for i < len(out) {
+		advancing := e.playing && !e.paused && e.file != nil
+		if !advancing && !e.liveActive {
+			clear(out[i:])
+			return i
+		}
+		run := int64(len(out) - i)
+		if advancing {
+			events := e.file.Events
+			for e.eventIndex < len(events) && events[e.eventIndex].SampleTime <= e.position {
+				e.applyEventLocked(events[e.eventIndex], false)
+				e.eventIndex++
+			}
+			if e.eventIndex < len(events) {
+				run = min(run, events[e.eventIndex].SampleTime-e.position)
+			}
+			if e.file.DurationSamples > 0 {
+				run = min(run, e.file.DurationSamples+1-e.position)
+			}
+			run = max(run, 1)
+		}
+
+		seg := out[i : i+int(run)]
+		clear(seg)
+		for vi := range e.voices {
+			v := &e.voices[vi]
+			if !v.active || (e.paused && !v.live) {
+				continue
+			}
+			gain := e.voiceGainLocked(v)
+			for j := range seg {
+				seg[j] += e.voiceStepLocked(v, gain)
+				if !v.active {
+					break
+				}
+			}
+		}
+		for j := range seg {
+			seg[j] = clampF32(seg[j]/float32(midiMixHeadroom), -0.8, 0.8)
+		}
+		i += int(run)
+
+		if advancing {
+			e.position += run
+			e.currentBPM = e.file.TempoBPMAtSample(e.position - 1)
+			if e.playbackCompleteLocked() {
+				e.endOfFileLocked()
+			}
+		}
+	}
+	return i
+}
+
+// RenderMIDIFile renders file offline at sampleRate and returns mono samples
+// in the same scale as the live mixer output.
+func RenderMIDIFile(file *MIDIFile, sampleRate int) []float32 {
+	e := NewMIDIEngine(nil, sampleRate)
+	e.LoadMIDI(file)
+	e.mu.Lock()
+	e.playing = true
+	e.mu.Unlock()
+
+	var out []float32
+	block := make([]float32, midiRenderBlockSize)
+	for {
+		n := e.RenderBlock(block)
+		out = append(out, block[:n]...)
+		if n < len(block) {
+			return out
+		}
+	}
+}
+
 func (e *MIDIEngine) clearVoicesLocked() {
 	for i := range e.voices {
 		e.voices[i] = midiVoice{}
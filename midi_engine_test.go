@@ -53,14 +53,14 @@ func TestMIDIEngine_NoteVolumePitchLoopPauseStopAndVoiceStealing(t *testing.T) {
 	}
 
 	dense := &MIDIFile{DurationSamples: 2048}
-	for i := 0; i < 12; i++ {
+	for i := 0; i < midiMaxVoices+2; i++ {
 		dense.Events = append(dense.Events, MIDIEvent{Kind: MIDIEventNoteOn, Note: uint8(48 + i), Velocity: 90})
 	}
 	engine.LoadMIDI(dense)
 	engine.SetPlaying(true)
 	engine.TickSample()
-	if got := engine.ActiveVoiceCount(); got != 10 {
-		t.Fatalf("active voices after dense chord=%d, want 10", got)
+	if got := engine.ActiveVoiceCount(); got != midiMaxVoices {
+		t.Fatalf("active voices after dense chord=%d, want %d", got, midiMaxVoices)
 	}
 	if engine.HasActiveNote(48) || engine.HasActiveNote(49) {
 		t.Fatal("deterministic voice stealing should remove oldest low-priority voices first")
@@ -410,3 +410,124 @@ func findMIDITestVoiceLocked(engine *MIDIEngine, note uint8, live bool) *midiVoi
 	}
 	return nil
 }
+
+func midiTestChordFile(program uint8, notes int, duration int64) *MIDIFile {
+	file := &MIDIFile{DurationSamples: duration}
+	for ch := uint8(0); ch < 8; ch++ {
+		file.Events = append(file.Events, MIDIEvent{Kind: MIDIEventProgramChange, Channel: ch, Program: program})
+	}
+	for i := 0; i < notes; i++ {
+		at := int64(i * 37)
+		ch := uint8(i % 8)
+		note := uint8(36 + i%60)
+		file.Events = append(file.Events,
+			MIDIEvent{Kind: MIDIEventNoteOn, Channel: ch, Note: note, Velocity: uint8(60 + i%60), SampleTime: at},
+			MIDIEvent{Kind: MIDIEventNoteOff, Channel: ch, Note: note, SampleTime: at + 3000 + int64(i%7)*101},
+		)
+	}
+	sortMIDITestEvents(file.Events)
+	return file
+}
+
+func sortMIDITestEvents(events []MIDIEvent) {
+	for i := 1; i < len(events); i++ {
+		for j := i; j > 0 && events[j].SampleTime < events[j-1].SampleTime; j-- {
+			events[j], events[j-1] = events[j-1], events[j]
+		}
+	}
+}
+
+func TestMIDIEngine_RenderBlockMatchesPerSamplePath(t *testing.T) {
+	const duration = 6000
+	file := midiTestChordFile(0, 80, duration) // program 0: piano
+
+	perSample := NewMIDIEngine(nil, 44100)
+	perSample.LoadMIDI(file)
+	perSample.SetPlaying(true)
+	want := make([]float32, 0, duration)
+	for perSample.IsPlaying() {
+		perSample.TickSample()
+		if !perSample.IsPlaying() {
+			break
+		}
+		want = append(want, perSample.MixSample())
+	}
+
+	got := RenderMIDIFile(file, 44100)
+	if len(got) != len(want)+1 {
+		t.Fatalf("rendered %d samples, per-sample path produced %d (+1 final)", len(got), len(want))
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("sample %d = %v, want %v", i, got[i], want[i])
+		}
+	}
+}
+
+func TestMIDIEngine_RenderBlockAppliesEventsSampleAccurately(t *testing.T) {
+	file := &MIDIFile{DurationSamples: 2000, Events: []MIDIEvent{
+		{Kind: MIDIEventProgramChange, Program: 80}, // square lead
+		{Kind: MIDIEventNoteOn, Note: 69, Velocity: 127, SampleTime: 1000},
+	}}
+	out := RenderMIDIFile(file, 44100)
+	for i := 0; i <= 1000; i++ {
+		if out[i] != 0 {
+			t.Fatalf("sample %d = %v before note-on took effect", i, out[i])
+		}
+	}
+	if out[1001] == 0 {
+		t.Fatal("note-on at sample 1000 produced no output at 1001")
+	}
+}
+
+func TestMIDIEngine_RenderMixBlockMatchesPerSamplePathLive(t *testing.T) {
+	notes := []MIDIEvent{
+		{Kind: MIDIEventNoteOn, Channel: 0, Note: 60, Velocity: 100},
+		{Kind: MIDIEventNoteOn, Channel: 9, Note: 38, Velocity: 120}, // snare: noise
+		{Kind: MIDIEventNoteOn, Channel: 9, Note: 42, Velocity: 90},  // hi-hat: noise
+	}
+	perSample := NewMIDIEngine(nil, 44100)
+	block := NewMIDIEngine(nil, 44100)
+	for _, ev := range notes {
+		perSample.ApplyLiveEvent(ev)
+		block.ApplyLiveEvent(ev)
+	}
+
+	got := make([]float32, 4096)
+	for i := 0; i < len(got); i += 512 {
+		block.RenderMixBlock(got[i : i+512])
+	}
+	for i := range got {
+		perSample.TickSample()
+		if want := perSample.MixSample(); got[i] != want {
+			t.Fatalf("sample %d = %v, want %v", i, got[i], want)
+		}
+	}
+}
+
+func TestMIDIEngine_PoolHoldsDenseGMPolyphony(t *testing.T) {
+	e := NewMIDIEngine(nil, 44100)
+	e.LoadMIDI(midiTestChordFile(48, 48, 100000))
+	e.SetPlaying(true)
+	block := make([]float32, 48*37)
+	e.RenderBlock(block)
+	if got := e.ActiveVoiceCount(); got != 48 {
+		t.Fatalf("active voices = %d, want all 48 held notes", got)
+	}
+}
+
+func BenchmarkMIDIRenderBlockDense(b *testing.B) {
+	file := midiTestChordFile(48, midiMaxVoices, 1<<40)
+	e := NewMIDIEngine(nil, 44100)
+	e.LoadMIDI(file)
+	e.SetPlaying(true)
+	block := make([]float32, midiRenderBlockSize)
+	for e.ActiveVoiceCount() < midiMaxVoices {
+		e.RenderBlock(block)
+	}
+	b.SetBytes(int64(len(block) * 4))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		e.RenderBlock(block)
+	}
+}
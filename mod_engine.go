@@ -43,8 +43,19 @@ type MODEngine struct {
 	ledA1, ledA2        float32 // LED biquad denominator
 
 	config atomic.Pointer[engineConfig]
+
+	// DAC block: output samples rendered ahead up to the next replayer tick,
+	// consumed one per TickSample. Cleared whenever replayer, filter or
+	// playback state changes underneath it.
+	dacBlock    [modDACBlockLen][modChannels]int8
+	dacBlockLen int
+	dacBlockPos int
+	chBlock     [][modDACBlockLen]int16 // per replayer channel scaled samples
 }
 
+// modDACBlockLen bounds how many output samples are rendered per block.
+const modDACBlockLen = 64
+
 type engineConfig struct {
 	filterModel int
 	loop        bool
@@ -87,6 +98,7 @@ func (e *MODEngine) LoadMOD(mod *MODFile) {
 	e.samplesPerTickQ = samplesPerTickQ(e.sampleRate, modDefaultBPM)
 	e.tickAccumQ = e.samplesPerTickQ
 	e.currentSample = 0
+	e.dacBlockLen, e.dacBlockPos = 0, 0
 	e.enabled.Store(true)
 
 	// Reset channel state
@@ -137,6 +149,7 @@ func (e *MODEngine) SetFilterModel(model int) {
 	e.mu.Lock()
 	e.filterModel = model
 	e.computeFilterCoefficients()
+	e.dacBlockLen, e.dacBlockPos = 0, 0
 	e.publishConfigLocked()
 	e.mu.Unlock()
 	if wasPlaying {
@@ -188,6 +201,7 @@ func (e *MODEngine) TickSample() {
 		// Sync LED filter state from replayer
 		e.ledFilter = e.replayer.ledFilter
 		e.publishConfigLocked()
+		e.dacBlockLen, e.dacBlockPos = 0, 0
 	}
 
 	e.currentSample++
@@ -252,58 +266,87 @@ func (e *MODEngine) ensureChannelsInitialized() {
 	e.channelsInit = true
 }
 
-// updateDAC reads sample data for each channel and writes to SoundChip DAC registers.
+// updateDAC writes the next block entry to the SoundChip DAC registers,
+// rendering a new block when the current one is used up.
 func (e *MODEngine) updateDAC() {
 	if e.sound == nil {
 		return
 	}
-	cfg := e.configSnapshot()
+	if e.dacBlockPos >= e.dacBlockLen {
+		e.renderDACBlock()
+	}
+	vals := e.dacBlock[e.dacBlockPos]
+	e.dacBlockPos++
+	e.sound.WriteFlexDACs(e.channels[:], vals[:])
+}
 
-	sums := [modChannels]int{}
-	counts := [modChannels]int{}
-	active := [modChannels]bool{}
+// renderDACBlock renders DAC output for the samples remaining before the next
+// replayer tick. Sample reads run channel by channel over the whole block;
+// filtering and mixing then run sample by sample in the same order as a
+// per-sample render, so the output is identical.
+func (e *MODEngine) renderDACBlock() {
+	n := modDACBlockLen
+	if e.samplesPerTickQ > 0 {
+		left := uint64(1)
+		if e.tickAccumQ < e.samplesPerTickQ {
+			left = (e.samplesPerTickQ - e.tickAccumQ + 1<<32 - 1) >> 32
+		}
+		n = int(min(left, uint64(modDACBlockLen)))
+	}
+	e.dacBlockLen, e.dacBlockPos = n, 0
 
+	nch := len(e.replayer.channels)
+	if len(e.chBlock) < nch {
+		e.chBlock = make([][modDACBlockLen]int16, nch)
+	}
+	counts := [modChannels]int{}
 	for i := range e.replayer.channels {
 		mc := &e.replayer.channels[i]
-		out := i % modChannels
-		counts[out]++
-
+		counts[i%modChannels]++
+		buf := e.chBlock[i][:n]
 		if !mc.active || mc.sample == nil || len(mc.sample.Data) == 0 || mc.period == 0 {
+			for j := range buf {
+				buf[j] = modNoSample
+			}
 			continue
 		}
-
-		// Read sample byte
-		sampleByte, sampleActive := mc.ReadSample()
-		if !sampleActive {
-			continue
-		}
-
-		// Scale by ProTracker volume (0-64)
-		scaledVol := clampVolume(mc.volume + mc.tremoloDelta)
-		scaled := int(sampleByte) * scaledVol / 64
-
-		// Apply Amiga filter if model is set
-		if cfg.filterModel != 0 {
-			scaledF := float32(scaled) / 128.0
-			scaledF = e.applyAmigaFilter(out, scaledF)
-			scaled = int(clampF32(scaledF*128.0, -128.0, 127.0))
-		}
-		sums[out] += scaled
-		active[out] = true
+		// Scale by ProTracker volume (0-64); fixed until the next tick
+		mc.ReadBlock(buf, clampVolume(mc.volume+mc.tremoloDelta))
 	}
 
-	for i := range modChannels {
-		scaled := 0
-		if active[i] && counts[i] > 0 {
-			scaled = sums[i] / counts[i]
+	filtered := e.configSnapshot().filterModel != 0
+	for j := range n {
+		sums := [modChannels]int{}
+		active := [modChannels]bool{}
+		for i := range nch {
+			s := e.chBlock[i][j]
+			if s == modNoSample {
+				continue
+			}
+			out := i % modChannels
+			scaled := int(s)
+			// Apply Amiga filter if model is set
+			if filtered {
+				scaledF := float32(scaled) / 128.0
+				scaledF = e.applyAmigaFilter(out, scaledF)
+				scaled = int(clampF32(scaledF*128.0, -128.0, 127.0))
+			}
+			sums[out] += scaled
+			active[out] = true
 		}
-		// Clamp to int8 range and write to DAC
-		if scaled > 127 {
-			scaled = 127
-		} else if scaled < -128 {
-			scaled = -128
+		for i := range modChannels {
+			scaled := 0
+			if active[i] && counts[i] > 0 {
+				scaled = sums[i] / counts[i]
+			}
+			// Clamp to int8 range
+			if scaled > 127 {
+				scaled = 127
+			} else if scaled < -128 {
+				scaled = -128
+			}
+			e.dacBlock[j][i] = int8(scaled)
 		}
-		e.writeChannel(e.channels[i], FLEX_OFF_DAC, uint32(byte(int8(scaled))))
 	}
 }
 
@@ -362,6 +405,7 @@ func (e *MODEngine) computeFilterCoefficients() {
 
 // silenceChannels writes zero to all DAC channels.
 func (e *MODEngine) silenceChannels() {
+	e.dacBlockLen, e.dacBlockPos = 0, 0
 	if e.sound == nil {
 		return
 	}
@@ -937,6 +937,43 @@ func (mc *MODChannel) ReadSample() (int8, bool) {
 	return val, true
 }
 
+// modNoSample marks a block slot where the channel produced no output.
+const modNoSample = math.MinInt16
+
+// ReadBlock fills dst with successive ReadSample results scaled by vol/64,
+// storing modNoSample where ReadSample reports no output. Reads that stay
+// inside the sample body or loop take a direct path; loop wraps, clamps and
+// end-of-sample fall back to ReadSample so their behaviour is unchanged.
+func (mc *MODChannel) ReadBlock(dst []int16, vol int) {
+	if mc.sample == nil {
+		for j := range dst {
+			dst[j] = modNoSample
+		}
+		return
+	}
+	data := mc.sample.Data
+	limit := len(data)
+	if mc.looping && mc.sample.LoopLength > 2 {
+		limit = mc.sample.LoopStart + mc.sample.LoopLength
+		if mc.sample.LoopStart >= len(data) || limit > len(data) {
+			limit = 0
+		}
+	}
+	for j := range dst {
+		if pos := int(mc.phase); mc.active && pos >= 0 && pos < limit {
+			dst[j] = int16(int(data[pos]) * vol / 64)
+			mc.phase += mc.phaseInc
+			continue
+		}
+		val, ok := mc.ReadSample()
+		if !ok {
+			dst[j] = modNoSample
+			continue
+		}
+		dst[j] = int16(int(val) * vol / 64)
+	}
+}
+
 // SamplesPerTick computes the number of audio samples per tracker tick.
 func SamplesPerTick(sampleRate, bpm int) int {
 	return sampleRate * 5 / (bpm * 2)
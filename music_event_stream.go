@@ -0,0 +1,223 @@
+// music_event_stream.go - Bounded look-ahead event streaming for guest-CPU music renderers
+
+/*
+The SID, SAP, ZXAYEMUL and SNDH renderers run a guest player routine frame by
+frame and historically materialised the whole tune before playback started.
+musicEventStream runs the same RenderFrames loop on a background goroutine and
+hands fixed-size chunks of events to the engine through a bounded channel, so
+playback starts after the first chunk and memory stays at the look-ahead depth.
+
+Looping is handled incrementally: when a pass reaches its frame count the
+producer re-opens the player and renders the next pass, dropping events before
+the loop sample. The engine bumps its pass counter when it wraps and discards
+any chunks still queued from the previous pass.
+*/
+
+package main
+
+import (
+	"os"
+	"sync"
+	"sync/atomic"
+)
+
+const (
+	// musicStreamChunkFrames is the number of player frames rendered per chunk.
+	musicStreamChunkFrames = 16
+
+	// musicStreamLookaheadChunks bounds the queue between producer and engine
+	// (32 chunks x 16 frames = ~10s at 50Hz).
+	musicStreamLookaheadChunks = 32
+)
+
+// musicStreamRenderEnabled selects streaming render for guest-CPU music formats.
+// Set by -stream-render or IE_STREAM_RENDER=1.
+var musicStreamRenderEnabled atomic.Bool
+
+func musicStreamRenderActive() bool {
+	return musicStreamRenderEnabled.Load() || os.Getenv("IE_STREAM_RENDER") == "1"
+}
+
+// musicFrameRenderer is implemented by the guest-CPU players that capture
+// sound chip writes frame by frame.
+type musicFrameRenderer[E any] interface {
+	RenderFrames(numFrames int) ([]E, uint64)
+	renderPerf() (instructions uint64, execNanos uint64)
+}
+
+type musicEventChunk[E any] struct {
+	events []E
+	pass   uint32
+}
+
+type musicEventStream[E any] struct {
+	chunks   chan musicEventChunk[E]
+	quit     chan struct{}
+	done     chan struct{}
+	wake     chan struct{}
+	stopOnce sync.Once
+
+	loop       atomic.Bool
+	loopSample atomic.Uint64
+
+	instructions atomic.Uint64
+	execNanos    atomic.Uint64
+
+	// pending is only touched by the consuming engine under its own lock.
+	pending    musicEventChunk[E]
+	hasPending bool
+}
+
+// newMusicEventStream starts a producer goroutine rendering totalFrames per
+// pass from first. reopen builds a fresh player for loop passes; sampleOf
+// returns the absolute sample position of an event.
+func newMusicEventStream[E any](first musicFrameRenderer[E], reopen func() (musicFrameRenderer[E], error), totalFrames int, loop bool, loopSample uint64, sampleOf func(*E) uint64) *musicEventStream[E] {
+	s := &musicEventStream[E]{
+		chunks: make(chan musicEventChunk[E], musicStreamLookaheadChunks),
+		quit:   make(chan struct{}),
+		done:   make(chan struct{}),
+		wake:   make(chan struct{}, 1),
+	}
+	s.loop.Store(loop)
+	s.loopSample.Store(loopSample)
+	// Seed with the INIT cost already spent while preparing the player.
+	instr, nanos := first.renderPerf()
+	s.instructions.Store(instr)
+	s.execNanos.Store(nanos)
+	go s.produce(first, reopen, totalFrames, sampleOf)
+	return s
+}
+
+func (s *musicEventStream[E]) produce(r musicFrameRenderer[E], reopen func() (musicFrameRenderer[E], error), totalFrames int, sampleOf func(*E) uint64) {
+	defer close(s.done)
+	for pass := uint32(0); ; pass++ {
+		if pass > 0 {
+			if !s.awaitLoop() || reopen == nil {
+				return
+			}
+			next, err := reopen()
+			if err != nil {
+				return
+			}
+			r = next
+		}
+		loopSample := s.loopSample.Load()
+		for remaining := totalFrames; remaining > 0; {
+			n := min(remaining, musicStreamChunkFrames)
+			remaining -= n
+
+			instrBefore, nanosBefore := r.renderPerf()
+			events, _ := r.RenderFrames(n)
+			instrAfter, nanosAfter := r.renderPerf()
+			s.instructions.Add(instrAfter - instrBefore)
+			s.execNanos.Add(nanosAfter - nanosBefore)
+
+			// Players reuse their frame buffers, so the chunk takes a copy.
+			out := make([]E, 0, len(events))
+			for i := range events {
+				if pass > 0 && sampleOf(&events[i]) < loopSample {
+					continue
+				}
+				out = append(out, events[i])
+			}
+			if len(out) == 0 {
+				continue
+			}
+			select {
+			case s.chunks <- musicEventChunk[E]{events: out, pass: pass}:
+			case <-s.quit:
+				return
+			}
+		}
+	}
+}
+
+// awaitLoop blocks until looping is enabled or the stream is closed.
+func (s *musicEventStream[E]) awaitLoop() bool {
+	for !s.loop.Load() {
+		select {
+		case <-s.quit:
+			return false
+		case <-s.wake:
+		}
+	}
+	select {
+	case <-s.quit:
+		return false
+	default:
+		return true
+	}
+}
+
+// setLoop updates the loop point used for subsequent passes.
+func (s *musicEventStream[E]) setLoop(loop bool, loopSample uint64) {
+	s.loopSample.Store(loopSample)
+	s.loop.Store(loop)
+	select {
+	case s.wake <- struct{}{}:
+	default:
+	}
+}
+
+// prime blocks until the first chunk is queued or the producer finishes, so
+// callers can start playback with events already available.
+func (s *musicEventStream[E]) prime() {
+	if s.hasPending {
+		return
+	}
+	select {
+	case c := <-s.chunks:
+		s.pending = c
+		s.hasPending = true
+	case <-s.done:
+	}
+}
+
+// next returns the next chunk for pass without blocking. Chunks from earlier
+// passes are dropped; a chunk from a later pass is held until the engine wraps.
+func (s *musicEventStream[E]) next(pass uint32) ([]E, bool) {
+	for {
+		var c musicEventChunk[E]
+		if s.hasPending {
+			c = s.pending
+			s.hasPending = false
+		} else {
+			select {
+			case c = <-s.chunks:
+			default:
+				return nil, false
+			}
+		}
+		if c.pass < pass {
+			continue
+		}
+		if c.pass > pass {
+			s.pending = c
+			s.hasPending = true
+			return nil, false
+		}
+		return c.events, true
+	}
+}
+
+// perf reports the guest CPU cost spent by the producer so far.
+func (s *musicEventStream[E]) perf() (uint64, uint64) {
+	return s.instructions.Load(), s.execNanos.Load()
+}
+
+// Close stops the producer. It does not wait for an in-flight RenderFrames call.
+func (s *musicEventStream[E]) Close() {
+	if s == nil {
+		return
+	}
+	s.stopOnce.Do(func() { close(s.quit) })
+}
+
+// musicStreamTotalSamples mirrors the frame accumulator used by the Z80 and
+// 68K players: floor(frames * sampleRate / frameRate).
+func musicStreamTotalSamples(frames int, sampleRate int, frameRate uint16) uint64 {
+	if frames <= 0 || frameRate == 0 {
+		return 0
+	}
+	return uint64(frames) * uint64(sampleRate) / uint64(frameRate)
+}
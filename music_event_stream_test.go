@@ -0,0 +1,159 @@
+// music_event_stream_test.go - Tests for streaming guest-CPU music rendering
+
+package main
+
+import (
+	"testing"
+	"time"
+)
+
+// fakeFrameRenderer emits one event per frame at a fixed sample spacing.
+type fakeFrameRenderer struct {
+	frame       int
+	spacing     uint64
+	buf         []SIDEvent
+	instruction uint64
+}
+
+func (r *fakeFrameRenderer) RenderFrames(numFrames int) ([]SIDEvent, uint64) {
+	r.buf = r.buf[:0]
+	for range numFrames {
+		r.buf = append(r.buf, SIDEvent{Sample: uint64(r.frame) * r.spacing, Value: uint8(r.frame)})
+		r.frame++
+		r.instruction += 10
+	}
+	return r.buf, uint64(r.frame) * r.spacing
+}
+
+func (r *fakeFrameRenderer) renderPerf() (uint64, uint64) {
+	return r.instruction, 0
+}
+
+func sidEventSample(ev *SIDEvent) uint64 { return ev.Sample }
+
+// drainStreamPass collects want events for pass, waiting up to a second.
+func drainStreamPass(t *testing.T, s *musicEventStream[SIDEvent], pass uint32, want int) []SIDEvent {
+	t.Helper()
+	var got []SIDEvent
+	deadline := time.Now().Add(time.Second)
+	for len(got) < want {
+		chunk, ok := s.next(pass)
+		if ok {
+			got = append(got, chunk...)
+			continue
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("pass %d: got %d events before timeout, want %d", pass, len(got), want)
+		}
+		time.Sleep(time.Millisecond)
+	}
+	return got
+}
+
+func TestMusicEventStreamMatchesWholeRender(t *testing.T) {
+	const frames = 100
+	want, _ := (&fakeFrameRenderer{spacing: 882}).RenderFrames(frames)
+
+	s := newMusicEventStream[SIDEvent](&fakeFrameRenderer{spacing: 882}, nil, frames, false, 0, sidEventSample)
+	defer s.Close()
+	s.prime()
+
+	got := drainStreamPass(t, s, 0, frames)
+	if len(got) != len(want) {
+		t.Fatalf("streamed %d events, want %d", len(got), len(want))
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("event %d = %+v, want %+v", i, got[i], want[i])
+		}
+	}
+	if instr, _ := s.perf(); instr != frames*10 {
+		t.Fatalf("perf instructions = %d, want %d", instr, frames*10)
+	}
+}
+
+func TestMusicEventStreamLoopPassSkipsStaleChunksAndFiltersLoopSample(t *testing.T) {
+	const frames = 40
+	const loopSample = 882 * 10
+	reopen := func() (musicFrameRenderer[SIDEvent], error) {
+		return &fakeFrameRenderer{spacing: 882}, nil
+	}
+	s := newMusicEventStream[SIDEvent](&fakeFrameRenderer{spacing: 882}, reopen, frames, true, loopSample, sidEventSample)
+	defer s.Close()
+	s.prime()
+
+	// Consume only part of pass 0, then wrap as the engine would.
+	drainStreamPass(t, s, 0, musicStreamChunkFrames)
+	got := drainStreamPass(t, s, 1, frames-10)
+	if got[0].Sample != loopSample {
+		t.Fatalf("first pass-1 event at sample %d, want %d", got[0].Sample, loopSample)
+	}
+	for _, ev := range got {
+		if ev.Sample < loopSample {
+			t.Fatalf("pass-1 event at sample %d precedes loop sample %d", ev.Sample, loopSample)
+		}
+	}
+}
+
+func TestMusicEventStreamWithoutLoopStopsAfterFirstPass(t *testing.T) {
+	s := newMusicEventStream[SIDEvent](&fakeFrameRenderer{spacing: 882}, nil, 8, false, 0, sidEventSample)
+	s.prime()
+	drainStreamPass(t, s, 0, 8)
+	select {
+	case <-s.done:
+	case <-time.After(time.Second):
+		t.Fatal("producer still running after a non-looping pass")
+	}
+	s.Close()
+}
+
+func TestMusicEventStreamCloseStopsBlockedProducer(t *testing.T) {
+	s := newMusicEventStream[SIDEvent](&fakeFrameRenderer{spacing: 1}, nil, 1<<20, false, 0, sidEventSample)
+	s.prime()
+	s.Close()
+	select {
+	case <-s.done:
+	case <-time.After(time.Second):
+		t.Fatal("producer did not exit after Close")
+	}
+}
+
+func TestStreamSIDMatchesPreRender(t *testing.T) {
+	data := buildSIDHeader("PSID", 2, 0x1000, 0x1000, 0x1001, 1, 1, 0, 0)
+	copy(data[0x7C:], []byte{
+		0x60,             // INIT: RTS
+		0xEE, 0x00, 0x11, // PLAY: INC $1100
+		0xAD, 0x00, 0x11, // LDA $1100
+		0x8D, 0x00, 0xD4, // STA $D400
+		0x60, // RTS
+	})
+
+	const frames = 200
+	_, want, wantTotal, _, _, _, _, _, _, err := renderSIDWithLimit(data, 44100, frames, 1, false, false)
+	if err != nil {
+		t.Fatalf("renderSIDWithLimit: %v", err)
+	}
+	if len(want) == 0 {
+		t.Fatal("pre-render produced no events")
+	}
+
+	start := time.Now()
+	_, stream, total, _, _, _, err := streamSIDWithLimit(data, 44100, frames, 1, false, false)
+	if err != nil {
+		t.Fatalf("streamSIDWithLimit: %v", err)
+	}
+	defer stream.Close()
+	if elapsed := time.Since(start); elapsed > 500*time.Millisecond {
+		t.Fatalf("stream setup took %v", elapsed)
+	}
+	if total != wantTotal {
+		t.Fatalf("stream totalSamples = %d, want %d", total, wantTotal)
+	}
+
+	got := drainStreamPass(t, stream, 0, len(want))
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("event %d = %+v, want %+v", i, got[i], want[i])
+		}
+	}
+}
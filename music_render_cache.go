@@ -0,0 +1,567 @@
+// music_render_cache.go - Content-addressed on-disk cache for rendered music event streams
+
+/*
+SID, SAP and PSG-family loads run a guest player (or a native tracker replay)
+to turn a file into a timestamped register-write stream. The result depends
+only on the file bytes and a handful of render parameters, so it is cached on
+disk keyed by SHA-256 of (format, file hash, subsong, video standard, sample
+rate). Repeat plays of the same tune skip rendering entirely.
+
+Entry layout (little endian, varint = encoding/binary uvarint/varint):
+
+	"IERC" | version u8 | kind u8
+	uvarint clockHz | uvarint frameRate | u8 loop | uvarint loopSample
+	uvarint totalSamples | uvarint flags | uvarint instructions | uvarint execNanos
+	uvarint nStrings | { uvarint len | bytes }...
+	uvarint nEvents | { varint dSample | varint dCycle | reg u8 | value u8 | chip u8 }...
+	crc32(IEEE) of everything above, u32
+
+Sample and cycle are delta-encoded against the previous event with zigzag
+varints, so typical streams shrink to 4-6 bytes per event. The directory is
+bounded by total size; hits refresh the file mtime and pruning removes the
+oldest entries first.
+*/
+
+package main
+
+import (
+	"bytes"
+	"crypto/sha256"
+	"encoding/binary"
+	"encoding/hex"
+	"errors"
+	"fmt"
+	"hash/crc32"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"sync"
+	"time"
+)
+
+const (
+	renderCacheMagic   = "IERC"
+	renderCacheVersion = 1
+	renderCacheExt     = ".ierc"
+
+	renderCacheDefaultMaxBytes = 256 << 20
+
+	renderCacheKindSID   = 1
+	renderCacheKindSAP   = 2
+	renderCacheKindPSG   = 3
+	renderCacheMaxEvents = 1 << 26
+)
+
+var errRenderCacheCorrupt = errors.New("render cache entry corrupt")
+
+// renderCacheEvent is the format-neutral form of SIDEvent, SAPPOKEYEvent and PSGEvent.
+type renderCacheEvent struct {
+	Cycle  uint64
+	Sample uint64
+	Reg    uint8
+	Value  uint8
+	Chip   uint8
+}
+
+// renderCacheEntry is one rendered stream plus the playback parameters
+// needed to start it without re-running the renderer.
+type renderCacheEntry struct {
+	Kind         uint8
+	ClockHz      uint32
+	FrameRate    uint16
+	Loop         bool
+	LoopSample   uint64
+	TotalSamples uint64
+	Flags        uint64
+	Instructions uint64
+	ExecNanos    uint64
+	Strings      []string
+	Events       []renderCacheEvent
+}
+
+// renderCache is a size-bounded LRU directory of encoded entries.
+type renderCache struct {
+	dir      string
+	maxBytes int64
+
+	mu     sync.Mutex
+	hits   uint64
+	misses uint64
+}
+
+var (
+	// musicRenderCacheDir is set by -render-cache; IE_RENDER_CACHE_DIR is the fallback.
+	musicRenderCacheDir string
+
+	renderCacheOnce   sync.Once
+	renderCacheShared *renderCache
+)
+
+// activeRenderCache returns the process-wide cache, or nil when caching is off.
+func activeRenderCache() *renderCache {
+	renderCacheOnce.Do(func() {
+		dir := musicRenderCacheDir
+		if dir == "" {
+			dir = os.Getenv("IE_RENDER_CACHE_DIR")
+		}
+		if dir == "" {
+			return
+		}
+		maxBytes := int64(renderCacheDefaultMaxBytes)
+		if mb, err := strconv.ParseInt(os.Getenv("IE_RENDER_CACHE_MAX_MB"), 10, 64); err == nil && mb > 0 {
+			maxBytes = mb << 20
+		}
+		renderCacheShared = newRenderCache(dir, maxBytes)
+	})
+	return renderCacheShared
+}
+
+func newRenderCache(dir string, maxBytes int64) *renderCache {
+	if maxBytes <= 0 {
+		maxBytes = renderCacheDefaultMaxBytes
+	}
+	return &renderCache{dir: dir, maxBytes: maxBytes}
+}
+
+// renderCacheKey hashes the format kind, file contents and render parameters.
+func renderCacheKey(kind uint8, data []byte, params ...uint64) string {
+	fileHash := sha256.Sum256(data)
+	h := sha256.New()
+	h.Write([]byte{renderCacheVersion, kind})
+	h.Write(fileHash[:])
+	var buf [8]byte
+	for _, p := range params {
+		binary.LittleEndian.PutUint64(buf[:], p)
+		h.Write(buf[:])
+	}
+	return hex.EncodeToString(h.Sum(nil))
+}
+
+func (c *renderCache) path(key string) string {
+	return filepath.Join(c.dir, key+renderCacheExt)
+}
+
+// Get loads an entry and refreshes its LRU timestamp. Corrupt entries are removed.
+func (c *renderCache) Get(key string) (renderCacheEntry, bool) {
+	if c == nil {
+		return renderCacheEntry{}, false
+	}
+	path := c.path(key)
+	raw, err := os.ReadFile(path)
+	if err != nil {
+		c.countLookup(false)
+		return renderCacheEntry{}, false
+	}
+	entry, err := decodeRenderCacheEntry(raw)
+	if err != nil {
+		_ = os.Remove(path)
+		c.countLookup(false)
+		return renderCacheEntry{}, false
+	}
+	now := time.Now()
+	_ = os.Chtimes(path, now, now)
+	c.countLookup(true)
+	return entry, true
+}
+
+// Put stores an entry atomically and prunes the directory to maxBytes.
+func (c *renderCache) Put(key string, entry renderCacheEntry) error {
+	if c == nil {
+		return nil
+	}
+	if err := os.MkdirAll(c.dir, 0o755); err != nil {
+		return err
+	}
+	encoded := encodeRenderCacheEntry(entry)
+	if int64(len(encoded)) > c.maxBytes {
+		return nil
+	}
+	tmp, err := os.CreateTemp(c.dir, "tmp-*")
+	if err != nil {
+		return err
+	}
+	tmpName := tmp.Name()
+	if _, err := tmp.Write(encoded); err != nil {
+		tmp.Close()
+		os.Remove(tmpName)
+		return err
+	}
+	if err := tmp.Close(); err != nil {
+		os.Remove(tmpName)
+		return err
+	}
+	if err := os.Rename(tmpName, c.path(key)); err != nil {
+		os.Remove(tmpName)
+		return err
+	}
+	c.prune()
+	return nil
+}
+
+// Stats returns lookup counters since process start.
+func (c *renderCache) Stats() (hits, misses uint64) {
+	if c == nil {
+		return 0, 0
+	}
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.hits, c.misses
+}
+
+func (c *renderCache) countLookup(hit bool) {
+	c.mu.Lock()
+	if hit {
+		c.hits++
+	} else {
+		c.misses++
+	}
+	c.mu.Unlock()
+}
+
+// prune deletes least-recently-used entries until the directory fits.
+func (c *renderCache) prune() {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	pruneCacheDir(c.dir, renderCacheExt, c.maxBytes)
+}
+
+// pruneCacheDir deletes the oldest files with extension ext in dir until
+// their total size is at most maxBytes. Callers refresh mtime on hits.
+func pruneCacheDir(dir, ext string, maxBytes int64) {
+	entries, err := os.ReadDir(dir)
+	if err != nil {
+		return
+	}
+	type cacheFile struct {
+		path string
+		size int64
+		mod  time.Time
+	}
+	var files []cacheFile
+	var total int64
+	for _, de := range entries {
+		if de.IsDir() || filepath.Ext(de.Name()) != ext {
+			continue
+		}
+		info, err := de.Info()
+		if err != nil {
+			continue
+		}
+		files = append(files, cacheFile{filepath.Join(dir, de.Name()), info.Size(), info.ModTime()})
+		total += info.Size()
+	}
+	if total <= maxBytes {
+		return
+	}
+	sort.Slice(files, func(i, j int) bool { return files[i].mod.Before(files[j].mod) })
+	for _, f := range files {
+		if total <= maxBytes {
+			break
+		}
+		if os.Remove(f.path) == nil {
+			total -= f.size
+		}
+	}
+}
+
+func encodeRenderCacheEntry(e renderCacheEntry) []byte {
+	buf := make([]byte, 0, 64+len(e.Events)*6)
+	buf = append(buf, renderCacheMagic...)
+	buf = append(buf, renderCacheVersion, e.Kind)
+	buf = binary.AppendUvarint(buf, uint64(e.ClockHz))
+	buf = binary.AppendUvarint(buf, uint64(e.FrameRate))
+	if e.Loop {
+		buf = append(buf, 1)
+	} else {
+		buf = append(buf, 0)
+	}
+	buf = binary.AppendUvarint(buf, e.LoopSample)
+	buf = binary.AppendUvarint(buf, e.TotalSamples)
+	buf = binary.AppendUvarint(buf, e.Flags)
+	buf = binary.AppendUvarint(buf, e.Instructions)
+	buf = binary.AppendUvarint(buf, e.ExecNanos)
+	buf = binary.AppendUvarint(buf, uint64(len(e.Strings)))
+	for _, s := range e.Strings {
+		buf = binary.AppendUvarint(buf, uint64(len(s)))
+		buf = append(buf, s...)
+	}
+	buf = binary.AppendUvarint(buf, uint64(len(e.Events)))
+	var prevSample, prevCycle uint64
+	for _, ev := range e.Events {
+		buf = binary.AppendVarint(buf, int64(ev.Sample-prevSample))
+		buf = binary.AppendVarint(buf, int64(ev.Cycle-prevCycle))
+		buf = append(buf, ev.Reg, ev.Value, ev.Chip)
+		prevSample, prevCycle = ev.Sample, ev.Cycle
+	}
+	return binary.LittleEndian.AppendUint32(buf, crc32.ChecksumIEEE(buf))
+}
+
+// renderCacheReader walks an encoded entry, latching the first error.
+type renderCacheReader struct {
+	buf []byte
+	err error
+}
+
+func (r *renderCacheReader) uvarint() uint64 {
+	if r.err != nil {
+		return 0
+	}
+	v, n := binary.Uvarint(r.buf)
+	if n <= 0 {
+		r.err = errRenderCacheCorrupt
+		return 0
+	}
+	r.buf = r.buf[n:]
+	return v
+}
+
+func (r *renderCacheReader) varint() int64 {
+	if r.err != nil {
+		return 0
+	}
+	v, n := binary.Varint(r.buf)
+	if n <= 0 {
+		r.err = errRenderCacheCorrupt
+		return 0
+	}
+	r.buf = r.buf[n:]
+	return v
+}
+
+func (r *renderCacheReader) bytes(n uint64) []byte {
+	if r.err != nil {
+		return nil
+	}
+	if n > uint64(len(r.buf)) {
+		r.err = errRenderCacheCorrupt
+		return nil
+	}
+	b := r.buf[:n]
+	r.buf = r.buf[n:]
+	return b
+}
+
+func decodeRenderCacheEntry(raw []byte) (renderCacheEntry, error) {
+	var e renderCacheEntry
+	if len(raw) < len(renderCacheMagic)+2+4 || !bytes.HasPrefix(raw, []byte(renderCacheMagic)) {
+		return e, errRenderCacheCorrupt
+	}
+	body := raw[:len(raw)-4]
+	if crc32.ChecksumIEEE(body) != binary.LittleEndian.Uint32(raw[len(raw)-4:]) {
+		return e, errRenderCacheCorrupt
+	}
+	if body[len(renderCacheMagic)] != renderCacheVersion {
+		return e, fmt.Errorf("render cache version %d unsupported", body[len(renderCacheMagic)])
+	}
+	e.Kind = body[len(renderCacheMagic)+1]
+	r := &renderCacheReader{buf: body[len(renderCacheMagic)+2:]}
+	e.ClockHz = uint32(r.uvarint())
+	e.FrameRate = uint16(r.uvarint())
+	if b := r.bytes(1); len(b) == 1 {
+		e.Loop = b[0] != 0
+	}
+	e.LoopSample = r.uvarint()
+	e.TotalSamples = r.uvarint()
+	e.Flags = r.uvarint()
+	e.Instructions = r.uvarint()
+	e.ExecNanos = r.uvarint()
+	nStrings := r.uvarint()
+	if nStrings > 64 {
+		return e, errRenderCacheCorrupt
+	}
+	for range nStrings {
+		e.Strings = append(e.Strings, string(r.bytes(r.uvarint())))
+	}
+	nEvents := r.uvarint()
+	// Every event takes at least five bytes, which bounds the allocation.
+	if r.err != nil || nEvents > renderCacheMaxEvents || nEvents*5 > uint64(len(r.buf)) {
+		return e, errRenderCacheCorrupt
+	}
+	e.Events = make([]renderCacheEvent, nEvents)
+	var sample, cycle uint64
+	for i := range e.Events {
+		sample += uint64(r.varint())
+		cycle += uint64(r.varint())
+		regs := r.bytes(3)
+		if r.err != nil {
+			return e, r.err
+		}
+		e.Events[i] = renderCacheEvent{Cycle: cycle, Sample: sample, Reg: regs[0], Value: regs[1], Chip: regs[2]}
+	}
+	if r.err != nil {
+		return e, r.err
+	}
+	return e, nil
+}
+
+func renderCacheStringAt(strs []string, i int) string {
+	if i < len(strs) {
+		return strs[i]
+	}
+	return ""
+}
+
+func sidEventsToCache(events []SIDEvent) []renderCacheEvent {
+	out := make([]renderCacheEvent, len(events))
+	for i, ev := range events {
+		out[i] = renderCacheEvent{Cycle: ev.Cycle, Sample: ev.Sample, Reg: ev.Reg, Value: ev.Value, Chip: ev.Chip}
+	}
+	return out
+}
+
+func sidEventsFromCache(events []renderCacheEvent) []SIDEvent {
+	out := make([]SIDEvent, len(events))
+	for i, ev := range events {
+		out[i] = SIDEvent{Cycle: ev.Cycle, Sample: ev.Sample, Reg: ev.Reg, Value: ev.Value, Chip: ev.Chip}
+	}
+	return out
+}
+
+func sapEventsToCache(events []SAPPOKEYEvent) []renderCacheEvent {
+	out := make([]renderCacheEvent, len(events))
+	for i, ev := range events {
+		out[i] = renderCacheEvent{Cycle: ev.Cycle, Sample: ev.Sample, Reg: ev.Reg, Value: ev.Value, Chip: uint8(ev.Chip)}
+	}
+	return out
+}
+
+func sapEventsFromCache(events []renderCacheEvent) []SAPPOKEYEvent {
+	out := make([]SAPPOKEYEvent, len(events))
+	for i, ev := range events {
+		out[i] = SAPPOKEYEvent{Cycle: ev.Cycle, Sample: ev.Sample, Reg: ev.Reg, Value: ev.Value, Chip: int(ev.Chip)}
+	}
+	return out
+}
+
+func psgEventsToCache(events []PSGEvent) []renderCacheEvent {
+	out := make([]renderCacheEvent, len(events))
+	for i, ev := range events {
+		out[i] = renderCacheEvent{Sample: ev.Sample, Reg: ev.Reg, Value: ev.Value}
+	}
+	return out
+}
+
+func psgEventsFromCache(events []renderCacheEvent) []PSGEvent {
+	out := make([]PSGEvent, len(events))
+	for i, ev := range events {
+		out[i] = PSGEvent{Sample: ev.Sample, Reg: ev.Reg, Value: ev.Value}
+	}
+	return out
+}
+
+// Format tags mixed into PSG cache keys; the PSG kind covers several renderers.
+// Tracker modules have no reliable magic, so each extension gets its own tag.
+const (
+	renderCachePSGAYZ80 = 1
+	renderCachePSGSNDH  = 2
+	renderCachePSGYM    = 3
+	renderCachePSGVTX   = 4
+	renderCachePSGPT3   = 5
+	renderCachePSGPT2   = 6
+	renderCachePSGPT1   = 7
+	renderCachePSGSTC   = 8
+	renderCachePSGSQT   = 9
+	renderCachePSGASC   = 10
+	renderCachePSGFTC   = 11
+)
+
+const (
+	renderCacheSAPStereo = 1 << 0
+	renderCacheSAPNTSC   = 1 << 1
+)
+
+func renderCacheBool(b bool) uint64 {
+	if b {
+		return 1
+	}
+	return 0
+}
+
+// renderSIDCached wraps renderSIDWithLimit (full-length render) with the
+// on-disk cache. The final bool reports a cache hit.
+func renderSIDCached(data []byte, sampleRate int, subsong int, forcePAL bool, forceNTSC bool) (SIDMetadata, []SIDEvent, uint64, uint32, bool, uint64, uint64, uint64, bool, error) {
+	cache := activeRenderCache()
+	key := renderCacheKey(renderCacheKindSID, data, uint64(int64(subsong)), renderCacheBool(forcePAL), renderCacheBool(forceNTSC), uint64(sampleRate))
+	if e, ok := cache.Get(key); ok && e.Kind == renderCacheKindSID {
+		meta := SIDMetadata{Title: renderCacheStringAt(e.Strings, 0), Author: renderCacheStringAt(e.Strings, 1), Released: renderCacheStringAt(e.Strings, 2)}
+		return meta, sidEventsFromCache(e.Events), e.TotalSamples, e.ClockHz, e.Loop, e.LoopSample, e.Instructions, e.ExecNanos, true, nil
+	}
+	meta, events, total, clockHz, frameRate, loop, loopSample, instr, nanos, err := renderSIDWithLimit(data, sampleRate, 0, subsong, forcePAL, forceNTSC)
+	if err != nil {
+		return meta, nil, 0, 0, false, 0, 0, 0, false, err
+	}
+	if cache != nil {
+		_ = cache.Put(key, renderCacheEntry{
+			Kind: renderCacheKindSID, ClockHz: clockHz, FrameRate: frameRate, Loop: loop, LoopSample: loopSample,
+			TotalSamples: total, Instructions: instr, ExecNanos: nanos,
+			Strings: []string{meta.Title, meta.Author, meta.Released},
+			Events:  sidEventsToCache(events),
+		})
+	}
+	return meta, events, total, clockHz, loop, loopSample, instr, nanos, false, nil
+}
+
+// renderSAPCached wraps renderSAPWithLimit (full-length render) with the on-disk cache.
+func renderSAPCached(data []byte, sampleRate int, subsong int) (SAPMetadata, []SAPPOKEYEvent, uint64, uint32, bool, uint64, uint64, uint64, bool, error) {
+	cache := activeRenderCache()
+	key := renderCacheKey(renderCacheKindSAP, data, uint64(int64(subsong)), uint64(sampleRate))
+	if e, ok := cache.Get(key); ok && e.Kind == renderCacheKindSAP {
+		meta := SAPMetadata{
+			Title:  renderCacheStringAt(e.Strings, 0),
+			Author: renderCacheStringAt(e.Strings, 1),
+			Date:   renderCacheStringAt(e.Strings, 2),
+			Songs:  int(e.Flags >> 8),
+			Stereo: e.Flags&renderCacheSAPStereo != 0,
+			NTSC:   e.Flags&renderCacheSAPNTSC != 0,
+		}
+		return meta, sapEventsFromCache(e.Events), e.TotalSamples, e.ClockHz, e.Loop, e.LoopSample, e.Instructions, e.ExecNanos, true, nil
+	}
+	meta, events, total, clockHz, frameRate, loop, loopSample, instr, nanos, err := renderSAPWithLimit(data, sampleRate, 0, subsong)
+	if err != nil {
+		return meta, nil, 0, 0, false, 0, 0, 0, false, err
+	}
+	if cache != nil {
+		flags := uint64(meta.Songs) << 8
+		if meta.Stereo {
+			flags |= renderCacheSAPStereo
+		}
+		if meta.NTSC {
+			flags |= renderCacheSAPNTSC
+		}
+		_ = cache.Put(key, renderCacheEntry{
+			Kind: renderCacheKindSAP, ClockHz: clockHz, FrameRate: frameRate, Loop: loop, LoopSample: loopSample,
+			TotalSamples: total, Flags: flags, Instructions: instr, ExecNanos: nanos,
+			Strings: []string{meta.Title, meta.Author, meta.Date},
+			Events:  sapEventsToCache(events),
+		})
+	}
+	return meta, events, total, clockHz, loop, loopSample, instr, nanos, false, nil
+}
+
+type psgGuestRenderFunc func(data []byte, sampleRate int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error)
+
+// renderPSGCached wraps a PSG renderer (the guest-CPU renderAYZ80/renderSNDH,
+// the Z80 and native tracker players, or a YM/VTX frame expansion) with the
+// on-disk cache. format distinguishes renderers sharing the PSG kind.
+func renderPSGCached(format uint64, render psgGuestRenderFunc, data []byte, sampleRate int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, bool, error) {
+	cache := activeRenderCache()
+	key := renderCacheKey(renderCacheKindPSG, data, format, uint64(sampleRate))
+	if e, ok := cache.Get(key); ok && e.Kind == renderCacheKindPSG {
+		meta := PSGMetadata{Title: renderCacheStringAt(e.Strings, 0), Author: renderCacheStringAt(e.Strings, 1), System: renderCacheStringAt(e.Strings, 2)}
+		return meta, psgEventsFromCache(e.Events), e.TotalSamples, e.ClockHz, e.FrameRate, e.Loop, e.LoopSample, e.Instructions, e.ExecNanos, true, nil
+	}
+	meta, events, total, clockHz, frameRate, loop, loopSample, instr, nanos, err := render(data, sampleRate)
+	if err != nil {
+		return meta, nil, 0, 0, 0, false, 0, 0, 0, false, err
+	}
+	if cache != nil {
+		_ = cache.Put(key, renderCacheEntry{
+			Kind: renderCacheKindPSG, ClockHz: clockHz, FrameRate: frameRate, Loop: loop, LoopSample: loopSample,
+			TotalSamples: total, Instructions: instr, ExecNanos: nanos,
+			Strings: []string{meta.Title, meta.Author, meta.System},
+			Events:  psgEventsToCache(events),
+		})
+	}
+	return meta, events, total, clockHz, frameRate, loop, loopSample, instr, nanos, false, nil
+}
@@ -0,0 +1,163 @@
+// music_render_cache_test.go - Tests for the on-disk rendered event cache
+
+package main
+
+import (
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+	"time"
+)
+
+func testRenderCacheEntry() renderCacheEntry {
+	return renderCacheEntry{
+		Kind:         renderCacheKindSID,
+		ClockHz:      985248,
+		FrameRate:    50,
+		Loop:         true,
+		LoopSample:   8820,
+		TotalSamples: 44100 * 3,
+		Flags:        0x305,
+		Instructions: 123456,
+		ExecNanos:    7890,
+		Strings:      []string{"Title", "Author", ""},
+		Events: []renderCacheEvent{
+			{Cycle: 10, Sample: 0, Reg: 0x18, Value: 0x0F},
+			{Cycle: 19705, Sample: 882, Reg: 0x04, Value: 0x41, Chip: 1},
+			{Cycle: 19700, Sample: 881, Reg: 0x04, Value: 0x40, Chip: 2}, // out of order
+			{Cycle: 1 << 40, Sample: 1 << 33, Reg: 0xFF, Value: 0xFF},
+		},
+	}
+}
+
+func TestRenderCacheEncodeDecodeRoundTrip(t *testing.T) {
+	want := testRenderCacheEntry()
+	got, err := decodeRenderCacheEntry(encodeRenderCacheEntry(want))
+	if err != nil {
+		t.Fatalf("decode: %v", err)
+	}
+	if !reflect.DeepEqual(got, want) {
+		t.Fatalf("round trip mismatch:\n got %+v\nwant %+v", got, want)
+	}
+}
+
+func TestRenderCacheDecodeRejectsCorruption(t *testing.T) {
+	raw := encodeRenderCacheEntry(testRenderCacheEntry())
+	for _, i := range []int{0, 5, len(raw) / 2, len(raw) - 1} {
+		bad := append([]byte(nil), raw...)
+		bad[i] ^= 0x5A
+		if _, err := decodeRenderCacheEntry(bad); err == nil {
+			t.Fatalf("flipping byte %d was not detected", i)
+		}
+	}
+	if _, err := decodeRenderCacheEntry(raw[:len(raw)-1]); err == nil {
+		t.Fatal("truncated entry was not detected")
+	}
+}
+
+func TestRenderCacheKeyDependsOnParams(t *testing.T) {
+	data := []byte("PSID tune")
+	base := renderCacheKey(renderCacheKindSID, data, 1, 0, 0, 44100)
+	for name, other := range map[string]string{
+		"kind":    renderCacheKey(renderCacheKindSAP, data, 1, 0, 0, 44100),
+		"data":    renderCacheKey(renderCacheKindSID, []byte("PSID tunf"), 1, 0, 0, 44100),
+		"subsong": renderCacheKey(renderCacheKindSID, data, 2, 0, 0, 44100),
+		"pal":     renderCacheKey(renderCacheKindSID, data, 1, 1, 0, 44100),
+		"rate":    renderCacheKey(renderCacheKindSID, data, 1, 0, 0, 48000),
+	} {
+		if other == base {
+			t.Fatalf("key ignores %s", name)
+		}
+	}
+	if renderCacheKey(renderCacheKindSID, data, 1, 0, 0, 44100) != base {
+		t.Fatal("key is not deterministic")
+	}
+}
+
+func TestRenderCacheGetPutAndCorruptFileIsMiss(t *testing.T) {
+	c := newRenderCache(t.TempDir(), 1<<20)
+	want := testRenderCacheEntry()
+	if _, ok := c.Get("k"); ok {
+		t.Fatal("hit on empty cache")
+	}
+	if err := c.Put("k", want); err != nil {
+		t.Fatalf("Put: %v", err)
+	}
+	got, ok := c.Get("k")
+	if !ok || !reflect.DeepEqual(got, want) {
+		t.Fatalf("Get = %+v, %v", got, ok)
+	}
+
+	path := c.path("k")
+	if err := os.WriteFile(path, []byte("IERC\x01garbage"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if _, ok := c.Get("k"); ok {
+		t.Fatal("corrupt entry served as a hit")
+	}
+	if _, err := os.Stat(path); !os.IsNotExist(err) {
+		t.Fatal("corrupt entry was not removed")
+	}
+	if hits, misses := c.Stats(); hits != 1 || misses != 2 {
+		t.Fatalf("stats = %d hits, %d misses; want 1, 2", hits, misses)
+	}
+}
+
+func TestRenderCachePrunesLeastRecentlyUsed(t *testing.T) {
+	dir := t.TempDir()
+	entry := testRenderCacheEntry()
+	size := int64(len(encodeRenderCacheEntry(entry)))
+	c := newRenderCache(dir, size*2)
+
+	old := time.Now().Add(-time.Hour)
+	for i, key := range []string{"a", "b"} {
+		if err := c.Put(key, entry); err != nil {
+			t.Fatal(err)
+		}
+		stamp := old.Add(time.Duration(i) * time.Minute)
+		os.Chtimes(c.path(key), stamp, stamp)
+	}
+	// Touch "a" so "b" becomes the oldest.
+	if _, ok := c.Get("a"); !ok {
+		t.Fatal("miss on a")
+	}
+	if err := c.Put("c", entry); err != nil {
+		t.Fatal(err)
+	}
+
+	names, _ := filepath.Glob(filepath.Join(dir, "*"+renderCacheExt))
+	if len(names) != 2 {
+		t.Fatalf("cache holds %d entries, want 2", len(names))
+	}
+	if _, err := os.Stat(c.path("b")); !os.IsNotExist(err) {
+		t.Fatal("least recently used entry survived pruning")
+	}
+}
+
+func TestRenderSIDCachedServesSecondLoadFromCache(t *testing.T) {
+	data := buildSIDHeader("PSID", 2, 0x1000, 0x1000, 0x1001, 1, 1, 0, 0)
+	copy(data[0x7C:], []byte{
+		0x60,             // INIT: RTS
+		0xEE, 0x00, 0x11, // PLAY: INC $1100
+		0xAD, 0x00, 0x11, // LDA $1100
+		0x8D, 0x00, 0xD4, // STA $D400
+		0x60, // RTS
+	})
+
+	renderCacheShared = newRenderCache(t.TempDir(), 1<<24)
+	renderCacheOnce.Do(func() {})
+	t.Cleanup(func() { renderCacheShared = nil })
+
+	_, first, total1, _, _, _, _, _, hit1, err := renderSIDCached(data, 44100, 1, false, false)
+	if err != nil || hit1 {
+		t.Fatalf("first load: hit=%v err=%v", hit1, err)
+	}
+	_, second, total2, _, _, _, _, _, hit2, err := renderSIDCached(data, 44100, 1, false, false)
+	if err != nil || !hit2 {
+		t.Fatalf("second load: hit=%v err=%v", hit2, err)
+	}
+	if total1 != total2 || !reflect.DeepEqual(first, second) {
+		t.Fatalf("cached render differs: %d/%d events, %d/%d samples", len(first), len(second), total1, total2)
+	}
+}
@@ -366,3 +366,136 @@ func TestAHXPlusAffectsOutput(t *testing.T) {
 		t.Fatal("expected AHX+ sample to differ from baseline")
 	}
 }
+
+// --- Band-limited oscillator tests ---
+
+const (
+	plusAliasN   = 4096
+	plusAliasBin = 350 // ~3768 Hz, exact bin so harmonics and their aliases land on bins
+)
+
+func plusAliasFreq() float32 {
+	return float32(plusAliasBin) * SAMPLE_RATE / plusAliasN
+}
+
+// plusAliasRatio returns the fraction of non-DC energy in s that lies outside
+// the harmonic series of bin k. len(s) must be plusAliasN.
+func plusAliasRatio(s []float32, k int) float64 {
+	n := len(s)
+	cosT := make([]float64, n)
+	sinT := make([]float64, n)
+	for i := range n {
+		w := 2 * math.Pi * float64(i) / float64(n)
+		cosT[i], sinT[i] = math.Cos(w), math.Sin(w)
+	}
+	var harm, total float64
+	for bin := 1; bin <= n/2; bin++ {
+		var re, im float64
+		idx := 0
+		for _, v := range s {
+			re += float64(v) * cosT[idx]
+			im -= float64(v) * sinT[idx]
+			idx += bin
+			if idx >= n {
+				idx -= n
+			}
+		}
+		p := re*re + im*im
+		total += p
+		if bin%k == 0 {
+			harm += p
+		}
+	}
+	if total == 0 {
+		return 0
+	}
+	return (total - harm) / total
+}
+
+// renderPlusChannel renders plusAliasN samples of channel 0 after settling,
+// with PSG+ enabled and the given oscillator selection.
+func renderPlusChannel(wave int, bandLimited bool) []float32 {
+	chip := newTestSoundChip()
+	chip.mu.Lock()
+	ch := chip.channels[0]
+	ch.frequency = plusAliasFreq()
+	ch.volume = 0.5
+	ch.enabled = true
+	ch.gate = true
+	ch.waveType = wave
+	ch.envelopePhase = ENV_SUSTAIN
+	ch.envelopeLevel = 1.0
+	ch.sustainLevel = 1.0
+	chip.mu.Unlock()
+	chip.SetPSGPlusEnabled(true)
+	chip.SetChannelPlusBandLimited(0, bandLimited)
+
+	for range 1024 {
+		ch.generateSample()
+	}
+	out := make([]float32, plusAliasN)
+	for i := range out {
+		out[i] = ch.generateSample()
+	}
+	return out
+}
+
+func TestPlusBandLimitedTriangleReducesAliasing(t *testing.T) {
+	render := func(bl bool) []float32 {
+		ch := &Channel{waveType: WAVE_TRIANGLE, frequency: plusAliasFreq()}
+		out := make([]float32, plusAliasN)
+		recip := float32(1.0 / SAMPLE_RATE)
+		for i := range out {
+			if bl {
+				out[i] = ch.generateBandLimitedSample(SAMPLE_RATE, recip)
+			} else {
+				out[i] = ch.generateWaveSample(SAMPLE_RATE, recip)
+			}
+		}
+		return out
+	}
+	naive := plusAliasRatio(render(false), plusAliasBin)
+	bl := plusAliasRatio(render(true), plusAliasBin)
+	if bl >= naive {
+		t.Fatalf("polyBLAMP triangle alias ratio %.3g, naive %.3g; want a reduction", bl, naive)
+	}
+}
+
+func TestPlusBandLimitedRunsOscillatorAtOutputRate(t *testing.T) {
+	out := renderPlusChannel(WAVE_SAWTOOTH, true)
+	// The fundamental must stay at the configured pitch: the harmonic series
+	// of plusAliasBin carries nearly all of the energy.
+	if r := plusAliasRatio(out, plusAliasBin); r > 0.05 {
+		t.Fatalf("band-limited PSG+ saw alias ratio %.3g; oscillator not at output rate?", r)
+	}
+}
+
+func TestPlusBandLimitedIsPerChannel(t *testing.T) {
+	chip := newTestSoundChip()
+	chip.SetChannelPlusBandLimited(1, true)
+	if chip.channels[0].plusBandLimited || !chip.channels[1].plusBandLimited {
+		t.Fatal("SetChannelPlusBandLimited must only affect the selected channel")
+	}
+	chip.SetPlusBandLimited(false)
+	if chip.channels[1].plusBandLimited {
+		t.Fatal("SetPlusBandLimited(false) did not clear the channel")
+	}
+}
+
+func TestPlusBandLimitedRegisterMask(t *testing.T) {
+	chip := newTestSoundChip()
+	chip.HandleRegisterWrite(AUDIO_PLUS_BANDLIMIT, 1<<1|1<<8)
+	if chip.channels[0].plusBandLimited || !chip.channels[1].plusBandLimited || !chip.channels[8].plusBandLimited {
+		t.Fatal("AUDIO_PLUS_BANDLIMIT write did not select channels 1 and 8")
+	}
+	if got := chip.HandleRegisterRead(AUDIO_PLUS_BANDLIMIT); got != 1<<1|1<<8 {
+		t.Fatalf("AUDIO_PLUS_BANDLIMIT reads 0x%X, want 0x102", got)
+	}
+
+	// Byte lanes merge, so 8-bit CPUs can set channels 8-9 separately.
+	chip.HandleRegisterWrite8(AUDIO_PLUS_BANDLIMIT, 0x01)
+	chip.HandleRegisterWrite8(AUDIO_PLUS_BANDLIMIT+1, 0x02)
+	if got := chip.HandleRegisterRead(AUDIO_PLUS_BANDLIMIT); got != 1<<0|1<<9 {
+		t.Fatalf("AUDIO_PLUS_BANDLIMIT after byte writes reads 0x%X, want 0x201", got)
+	}
+}
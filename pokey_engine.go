@@ -54,6 +54,8 @@ type POKEYEngine struct {
 	loop          bool
 	loopSample    uint64
 	forceLoop     bool
+	stream        *musicEventStream[SAPPOKEYEvent] // streaming render source (nil for pre-rendered events)
+	streamPass    uint32
 
 	busMemory []byte // mirror register writes for Machine Monitor visibility
 }
@@ -792,6 +794,7 @@ func (e *POKEYEngine) Reset() {
 	baseChannel := e.baseChannel
 
 	// Reset playback state
+	e.closeStreamLocked()
 	e.events = nil
 	e.eventIndex = 0
 	e.currentSample = 0
@@ -823,6 +826,7 @@ func (e *POKEYEngine) SetEvents(events []SAPPOKEYEvent, totalSamples uint64, loo
 	e.mutex.Lock()
 	defer e.mutex.Unlock()
 
+	e.closeStreamLocked()
 	e.events = events
 	e.eventIndex = 0
 	e.totalSamples = totalSamples
@@ -832,6 +836,46 @@ func (e *POKEYEngine) SetEvents(events []SAPPOKEYEvent, totalSamples uint64, loo
 	e.playing.Store(false)
 }
 
+// SetEventStream sets a background render stream as the event source.
+// The engine takes ownership of the stream.
+func (e *POKEYEngine) SetEventStream(stream *musicEventStream[SAPPOKEYEvent], totalSamples uint64, loop bool, loopSample uint64) {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+
+	e.closeStreamLocked()
+	e.stream = stream
+	e.streamPass = 0
+	e.events = nil
+	e.eventIndex = 0
+	e.totalSamples = totalSamples
+	e.currentSample = 0
+	e.loop = loop
+	e.loopSample = loopSample
+	e.playing.Store(false)
+}
+
+func (e *POKEYEngine) closeStreamLocked() {
+	if e.stream != nil {
+		e.stream.Close()
+		e.stream = nil
+	}
+}
+
+// refillFromStreamLocked swaps in the next streamed chunk once the current
+// one is consumed. Returns false when the producer has nothing ready yet.
+func (e *POKEYEngine) refillFromStreamLocked() bool {
+	if e.stream == nil || e.eventIndex < len(e.events) {
+		return false
+	}
+	chunk, ok := e.stream.next(e.streamPass)
+	if !ok {
+		return false
+	}
+	e.events = chunk
+	e.eventIndex = 0
+	return true
+}
+
 // SetPlaying starts or stops event-based playback
 func (e *POKEYEngine) SetPlaying(playing bool) {
 	e.mutex.Lock()
@@ -858,6 +902,9 @@ func (e *POKEYEngine) SetForceLoop(enable bool) {
 	if enable {
 		e.loop = true
 		e.loopSample = 0
+		if e.stream != nil {
+			e.stream.setLoop(true, 0)
+		}
 	}
 	e.forceLoop = enable
 }
@@ -867,6 +914,7 @@ func (e *POKEYEngine) StopPlayback() {
 	e.mutex.Lock()
 	defer e.mutex.Unlock()
 	e.playing.Store(false)
+	e.closeStreamLocked()
 	e.events = nil
 	e.eventIndex = 0
 	e.currentSample = 0
@@ -881,14 +929,20 @@ func (e *POKEYEngine) TickSample() {
 
 	e.mutex.Lock()
 
-	if len(e.events) == 0 {
+	if len(e.events) == 0 && e.stream == nil {
 		e.mutex.Unlock()
 		return
 	}
 
 	drained := make([]SAPPOKEYEvent, 0, 4)
 	// Process all events at current sample position
-	for e.eventIndex < len(e.events) && e.events[e.eventIndex].Sample <= e.currentSample {
+	for {
+		if e.eventIndex >= len(e.events) && !e.refillFromStreamLocked() {
+			break
+		}
+		if e.events[e.eventIndex].Sample > e.currentSample {
+			break
+		}
 		drained = append(drained, e.events[e.eventIndex])
 		e.eventIndex++
 	}
@@ -900,10 +954,17 @@ func (e *POKEYEngine) TickSample() {
 	if e.totalSamples > 0 && e.currentSample >= e.totalSamples {
 		if e.loop {
 			e.currentSample = e.loopSample
-			// Find event index for loop position
-			e.eventIndex = 0
-			for e.eventIndex < len(e.events) && e.events[e.eventIndex].Sample < e.loopSample {
-				e.eventIndex++
+			if e.stream != nil {
+				// The producer re-renders the next pass from loopSample.
+				e.events = nil
+				e.eventIndex = 0
+				e.streamPass++
+			} else {
+				// Find event index for loop position
+				e.eventIndex = 0
+				for e.eventIndex < len(e.events) && e.events[e.eventIndex].Sample < e.loopSample {
+					e.eventIndex++
+				}
 			}
 		} else {
 			e.playing.Store(false)
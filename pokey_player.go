@@ -24,6 +24,8 @@ type POKEYPlayer struct {
 	renderInstructions uint64
 	renderCPU          string
 	renderExecNanos    uint64
+	stream             *musicEventStream[SAPPOKEYEvent] // non-nil while streaming render is active
+	renderCacheHit     bool                             // events came from the on-disk render cache
 }
 
 // NewPOKEYPlayer creates a new POKEY player
@@ -55,24 +57,62 @@ func (p *POKEYPlayer) LoadDataWithSubsong(data []byte, subsong int) error {
 	// Stop any current playback
 	p.engine.StopPlayback()
 
-	// Render SAP to POKEY events
-	meta, events, totalSamples, clockHz, _, loop, loopSample, instrCount, execNanos, err := renderSAPWithLimit(data, SAMPLE_RATE, 0, subsong)
+	// Render SAP to POKEY events, or stream them when streaming render is on
+	r, err := renderSAPSource(data, subsong)
 	if err != nil {
 		return err
 	}
+	p.applyRenderLocked(r)
+	return nil
+}
+
+// sapRender is a rendered or streaming SAP tune ready to install.
+type sapRender struct {
+	meta                  SAPMetadata
+	events                []SAPPOKEYEvent
+	stream                *musicEventStream[SAPPOKEYEvent]
+	totalSamples          uint64
+	clockHz               uint32
+	loop                  bool
+	loopSample            uint64
+	instrCount, execNanos uint64
+	cacheHit              bool
+}
+
+// renderSAPSource renders data for playback: a background event stream when
+// streaming render is active, otherwise the full render through the on-disk
+// cache. Both the file loaders and POKEY_PLAY use it.
+func renderSAPSource(data []byte, subsong int) (sapRender, error) {
+	var (
+		r   sapRender
+		err error
+	)
+	if musicStreamRenderActive() {
+		r.meta, r.stream, r.totalSamples, r.clockHz, r.loop, r.loopSample, err = streamSAPWithLimit(data, SAMPLE_RATE, 0, subsong)
+	} else {
+		r.meta, r.events, r.totalSamples, r.clockHz, r.loop, r.loopSample, r.instrCount, r.execNanos, r.cacheHit, err = renderSAPCached(data, SAMPLE_RATE, subsong)
+	}
+	return r, err
+}
 
-	p.metadata = meta
-	p.renderInstructions = instrCount
+// applyRenderLocked installs r on the engine. Caller holds p.mu.
+func (p *POKEYPlayer) applyRenderLocked(r sapRender) {
+	p.metadata = r.meta
+	p.stream = r.stream
+	p.renderCacheHit = r.cacheHit
+	p.renderInstructions = r.instrCount
 	p.renderCPU = "6502"
-	p.renderExecNanos = execNanos
-	p.configureStereo(meta.Stereo)
+	p.renderExecNanos = r.execNanos
+	p.configureStereo(r.meta.Stereo)
 
 	// Set POKEY clock and events
-	p.engine.SetClockHz(clockHz)
+	p.engine.SetClockHz(r.clockHz)
 	p.syncStereoClock()
-	p.engine.SetEvents(events, totalSamples, loop, loopSample)
-
-	return nil
+	if r.stream != nil {
+		p.engine.SetEventStream(r.stream, r.totalSamples, r.loop, r.loopSample)
+	} else {
+		p.engine.SetEvents(r.events, r.totalSamples, r.loop, r.loopSample)
+	}
 }
 
 // Play starts playback
@@ -103,9 +143,18 @@ func (p *POKEYPlayer) Metadata() SAPMetadata {
 
 // DurationSeconds returns the duration in seconds
 func (p *POKEYPlayer) RenderPerf() (uint64, string, uint64) {
+	if p.stream != nil {
+		instr, nanos := p.stream.perf()
+		return instr, p.renderCPU, nanos
+	}
 	return p.renderInstructions, p.renderCPU, p.renderExecNanos
 }
 
+// RenderCacheHit reports whether the last load was served from the render cache.
+func (p *POKEYPlayer) RenderCacheHit() bool {
+	return p.renderCacheHit
+}
+
 func (p *POKEYPlayer) DurationSeconds() float64 {
 	p.engine.mutex.Lock()
 	defer p.engine.mutex.Unlock()
@@ -217,14 +266,15 @@ type pokeyAsyncStartRequest struct {
 }
 
 func (p *POKEYPlayer) startAsync(req pokeyAsyncStartRequest) {
-	meta, events, totalSamples, clockHz, _, loop, loopSample, instrCount, execNanos, err := renderSAPWithLimit(
-		req.data, SAMPLE_RATE, 0, req.subsong,
-	)
+	r, err := renderSAPSource(req.data, req.subsong)
 
 	p.mu.Lock()
 	defer p.mu.Unlock()
 
 	if req.gen != p.PlayGen {
+		if r.stream != nil {
+			r.stream.Close()
+		}
 		return
 	}
 
@@ -234,16 +284,8 @@ func (p *POKEYPlayer) startAsync(req pokeyAsyncStartRequest) {
 		return
 	}
 
-	p.metadata = meta
-	p.renderInstructions = instrCount
-	p.renderCPU = "6502"
-	p.renderExecNanos = execNanos
-	p.configureStereo(meta.Stereo)
-
 	p.engine.StopPlayback()
-	p.engine.SetClockHz(clockHz)
-	p.syncStereoClock()
-	p.engine.SetEvents(events, totalSamples, loop, loopSample)
+	p.applyRenderLocked(r)
 	if req.forceLoop {
 		p.engine.SetForceLoop(true)
 	}
@@ -333,7 +333,7 @@ func (e *ProgramExecutor) startHardReset() {
 }
 
 func (e *ProgramExecutor) executeAsync(session uint32, fullPath string, typ uint32) {
-	data, err := os.ReadFile(fullPath)
+	data, err := ReadAsset(fullPath)
 	if err != nil {
 		e.failSession(session, EXEC_ERR_LOAD_FAILED)
 		return
@@ -37,6 +37,8 @@ type PSGEngine struct {
 	loop            bool
 	loopSample      uint64
 	loopEventIndex  int
+	stream          *musicEventStream[PSGEvent] // streaming render source (nil for pre-rendered events)
+	streamPass      uint32
 	playing         bool
 	enabled         atomic.Bool
 	psgPlusEnabled  bool
@@ -185,18 +187,8 @@ func (e *PSGEngine) ApplyFrame(frame []uint8) error {
 func (e *PSGEngine) SetEvents(events []PSGEvent, totalSamples uint64, loop bool, loopSample uint64) {
 	e.mutex.Lock()
 	defer e.mutex.Unlock()
-	// Reset register state to prevent stale values from previous playback
-	// (e.g. mixer reg 7 from SNDH disabling tone channels in a subsequent VGM).
-	e.regs = [PSG_REG_COUNT]uint8{}
-	e.envLevel = 15
-	e.envDirection = -1
-	e.envSampleCounter = 0
-	e.envContinue = false
-	e.envAlternate = false
-	e.envAttack = false
-	e.envHoldRequest = false
-	e.envHoldActive = false
-	e.updateEnvPeriodSamples()
+	e.closeStreamLocked()
+	e.resetPlaybackRegsLocked()
 	e.events = events
 	e.eventIndex = 0
 	e.currentSample = 0
@@ -215,6 +207,63 @@ func (e *PSGEngine) SetEvents(events []PSGEvent, totalSamples uint64, loop bool,
 	}
 }
 
+// SetEventStream plays events from a background render stream instead of a
+// pre-rendered slice. The engine takes ownership of the stream.
+func (e *PSGEngine) SetEventStream(stream *musicEventStream[PSGEvent], totalSamples uint64, loop bool, loopSample uint64) {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+	e.closeStreamLocked()
+	e.resetPlaybackRegsLocked()
+	e.stream = stream
+	e.streamPass = 0
+	e.events = nil
+	e.eventIndex = 0
+	e.currentSample = 0
+	e.totalSamples = totalSamples
+	e.loop = loop
+	e.loopSample = loopSample
+	e.loopEventIndex = 0
+	e.playing = true
+	e.enabled.Store(true)
+}
+
+func (e *PSGEngine) closeStreamLocked() {
+	if e.stream != nil {
+		e.stream.Close()
+		e.stream = nil
+	}
+}
+
+// refillFromStreamLocked swaps in the next streamed chunk once the current
+// one is consumed. Returns false when the producer has nothing ready yet.
+func (e *PSGEngine) refillFromStreamLocked() bool {
+	if e.stream == nil || e.eventIndex < len(e.events) {
+		return false
+	}
+	chunk, ok := e.stream.next(e.streamPass)
+	if !ok {
+		return false
+	}
+	e.events = chunk
+	e.eventIndex = 0
+	return true
+}
+
+func (e *PSGEngine) resetPlaybackRegsLocked() {
+	// Reset register state to prevent stale values from previous playback
+	// (e.g. mixer reg 7 from SNDH disabling tone channels in a subsequent VGM).
+	e.regs = [PSG_REG_COUNT]uint8{}
+	e.envLevel = 15
+	e.envDirection = -1
+	e.envSampleCounter = 0
+	e.envContinue = false
+	e.envAlternate = false
+	e.envAttack = false
+	e.envHoldRequest = false
+	e.envHoldActive = false
+	e.updateEnvPeriodSamples()
+}
+
 func (e *PSGEngine) SetSNStream(snEvents []SNEvent, chip *SN76489Chip, clockHz uint32) {
 	e.mutex.Lock()
 	defer e.mutex.Unlock()
@@ -251,6 +300,9 @@ func (e *PSGEngine) SetForceLoop(enable bool) {
 		e.loopSample = 0
 		e.loopEventIndex = 0
 		e.snLoopEventIndex = 0
+		if e.stream != nil {
+			e.stream.setLoop(true, 0)
+		}
 	}
 }
 
@@ -270,6 +322,7 @@ func (e *PSGEngine) StopPlayback() {
 	e.mutex.Lock()
 	defer e.mutex.Unlock()
 	e.playing = false
+	e.closeStreamLocked()
 	e.events = nil
 	e.eventIndex = 0
 	e.snEvents = nil
@@ -299,7 +352,15 @@ func (e *PSGEngine) TickSample() {
 		return
 	}
 
-	for e.eventIndex < len(e.events) && e.events[e.eventIndex].Sample == e.currentSample {
+	// Streamed chunks may arrive late after a producer stall, so anything at
+	// or before the current sample is applied rather than skipped.
+	for {
+		if e.eventIndex >= len(e.events) && !e.refillFromStreamLocked() {
+			break
+		}
+		if e.events[e.eventIndex].Sample > e.currentSample {
+			break
+		}
 		ev := e.events[e.eventIndex]
 		if ev.Reg < PSG_REG_COUNT {
 			e.regs[ev.Reg] = ev.Value
@@ -331,6 +392,11 @@ func (e *PSGEngine) TickSample() {
 			e.currentSample = e.loopSample
 			e.eventIndex = e.loopEventIndex
 			e.snEventIndex = e.snLoopEventIndex
+			if e.stream != nil {
+				e.events = nil
+				e.eventIndex = 0
+				e.streamPass++
+			}
 		} else {
 			e.playing = false
 			e.silenceSNLocked()
@@ -27,6 +27,8 @@ type PSGPlayer struct {
 	renderInstructions uint64
 	renderCPU          string
 	renderExecNanos    uint64
+	stream             *musicEventStream[PSGEvent] // non-nil while streaming render is active
+	renderCacheHit     bool                        // events came from the on-disk render cache
 }
 
 func NewPSGPlayer(engine *PSGEngine) *PSGPlayer {
@@ -50,17 +52,16 @@ func (p *PSGPlayer) Load(path string) error {
 	p.renderInstructions = 0
 	p.renderCPU = ""
 	p.renderExecNanos = 0
+	p.stream = nil
+	p.renderCacheHit = false
 	ext := strings.ToLower(filepath.Ext(path))
 	switch ext {
 	case ".ym":
-		file, err := ParseYMFile(path)
+		data, err := os.ReadFile(path)
 		if err != nil {
 			return err
 		}
-		p.metadata = PSGMetadata{Title: file.Title, Author: file.Author, System: "Atari ST"}
-		p.frameRate = file.FrameRate
-		p.clockHz = file.ClockHz
-		return p.loadFrames(file.Frames, file.FrameRate, file.ClockHz, file.LoopFrame)
+		return p.loadYM(data)
 	case ".ay":
 		data, err := os.ReadFile(path)
 		if err != nil {
@@ -70,21 +71,7 @@ func (p *PSGPlayer) Load(path string) error {
 			if p.engine == nil {
 				return fmt.Errorf("psg engine not configured")
 			}
-			meta, events, total, clockHz, frameRate, loop, loopSample, instrCount, execNanos, err := renderAYZ80(data, p.engine.sampleRate)
-			if err != nil {
-				return err
-			}
-			p.metadata = meta
-			p.frameRate = frameRate
-			p.clockHz = clockHz
-			p.loop = loop
-			p.loopSample = loopSample
-			p.renderInstructions = instrCount
-			p.renderCPU = "Z80"
-			p.renderExecNanos = execNanos
-			p.engine.SetClockHz(clockHz)
-			p.engine.SetEvents(events, total, loop, loopSample)
-			return nil
+			return p.loadAYZ80(data)
 		}
 		file, err := ParseAYFile(path)
 		if err != nil {
@@ -138,6 +125,8 @@ func (p *PSGPlayer) Load(path string) error {
 // Tracker formats (.pt3, .pt2, .pt1, .stc, .sqt, .asc, .ftc) require the extension
 // since they lack reliable magic bytes for content-based detection.
 func (p *PSGPlayer) LoadDataWithHint(data []byte, ext string) error {
+	p.stream = nil
+	p.renderCacheHit = false
 	switch ext {
 	case ".pt3", ".pt2", ".pt1", ".stc", ".sqt", ".asc", ".ftc":
 		return p.loadTracker(ext, data)
@@ -155,6 +144,8 @@ func (p *PSGPlayer) LoadData(data []byte) error {
 	p.renderInstructions = 0
 	p.renderCPU = ""
 	p.renderExecNanos = 0
+	p.stream = nil
+	p.renderCacheHit = false
 	if len(data) == 0 {
 		return fmt.Errorf("psg data empty")
 	}
@@ -195,20 +186,13 @@ func (p *PSGPlayer) LoadData(data []byte) error {
 		return nil
 	}
 	if len(data) >= 4 && (string(data[:4]) == "YM5!" || string(data[:4]) == "YM6!") {
-		file, err := parseYMData(data)
-		if err != nil {
-			return err
-		}
-		p.metadata = PSGMetadata{Title: file.Title, Author: file.Author, System: "Atari ST"}
-		p.frameRate = file.FrameRate
-		p.clockHz = file.ClockHz
-		return p.loadFrames(file.Frames, file.FrameRate, file.ClockHz, file.LoopFrame)
+		return p.loadYM(data)
 	}
 	if isVTXData(data) {
 		return p.loadVTX(data)
 	}
 	if isLHAData(data) {
-		decompressed, err := DecompressLHAData(data)
+		decompressed, err := UnpackAsset(data)
 		if err != nil {
 			return err
 		}
@@ -218,21 +202,7 @@ func (p *PSGPlayer) LoadData(data []byte) error {
 		if p.engine == nil {
 			return fmt.Errorf("psg engine not configured")
 		}
-		meta, events, total, clockHz, frameRate, loop, loopSample, instrCount, execNanos, err := renderAYZ80(data, p.engine.sampleRate)
-		if err != nil {
-			return err
-		}
-		p.metadata = meta
-		p.frameRate = frameRate
-		p.clockHz = clockHz
-		p.loop = loop
-		p.loopSample = loopSample
-		p.renderInstructions = instrCount
-		p.renderCPU = "Z80"
-		p.renderExecNanos = execNanos
-		p.engine.SetClockHz(clockHz)
-		p.engine.SetEvents(events, total, loop, loopSample)
-		return nil
+		return p.loadAYZ80(data)
 	}
 	if isSNDHData(data) {
 		return p.loadSNDH(data)
@@ -272,39 +242,83 @@ func (p *PSGPlayer) Metadata() PSGMetadata {
 	return p.metadata
 }
 
-func (p *PSGPlayer) loadSNDH(data []byte) error {
-	if p.engine == nil {
-		return fmt.Errorf("psg engine not configured")
+// loadAYZ80 renders (or streams, with streaming render enabled) a ZXAYEMUL
+// file through the Z80 player.
+func (p *PSGPlayer) loadAYZ80(data []byte) error {
+	if musicStreamRenderActive() {
+		meta, stream, total, clockHz, frameRate, loop, loopSample, err := streamAYZ80(data, p.engine.sampleRate)
+		if err != nil {
+			return err
+		}
+		p.applyStream(meta, stream, total, clockHz, frameRate, loop, loopSample, "Z80")
+		return nil
 	}
-	meta, events, total, clockHz, frameRate, loop, loopSample, instrCount, execNanos, err := renderSNDH(data, p.engine.sampleRate)
+	return p.loadCached(renderCachePSGAYZ80, renderAYZ80, data, "Z80")
+}
+
+// loadCached renders data with render through the on-disk render cache and
+// installs the events. cpu names the guest CPU for render stats, or is empty
+// for renderers that run natively.
+func (p *PSGPlayer) loadCached(format uint64, render psgGuestRenderFunc, data []byte, cpu string) error {
+	meta, events, total, clockHz, frameRate, loop, loopSample, instrCount, execNanos, cacheHit, err := renderPSGCached(format, render, data, p.engine.sampleRate)
 	if err != nil {
 		return err
 	}
+	p.renderCacheHit = cacheHit
 	p.metadata = meta
 	p.frameRate = frameRate
 	p.clockHz = clockHz
 	p.loop = loop
 	p.loopSample = loopSample
 	p.renderInstructions = instrCount
-	p.renderCPU = "68K"
+	p.renderCPU = cpu
 	p.renderExecNanos = execNanos
 	p.engine.SetClockHz(clockHz)
 	p.engine.SetEvents(events, total, loop, loopSample)
 	return nil
 }
 
+// applyStream installs a background render stream on the engine.
+func (p *PSGPlayer) applyStream(meta PSGMetadata, stream *musicEventStream[PSGEvent], total uint64, clockHz uint32, frameRate uint16, loop bool, loopSample uint64, cpu string) {
+	p.metadata = meta
+	p.frameRate = frameRate
+	p.clockHz = clockHz
+	p.loop = loop
+	p.loopSample = loopSample
+	p.stream = stream
+	p.renderCPU = cpu
+	p.engine.SetClockHz(clockHz)
+	p.engine.SetEventStream(stream, total, loop, loopSample)
+}
+
+func (p *PSGPlayer) loadSNDH(data []byte) error {
+	if p.engine == nil {
+		return fmt.Errorf("psg engine not configured")
+	}
+	if musicStreamRenderActive() {
+		meta, stream, total, clockHz, frameRate, loop, loopSample, err := streamSNDH(data, p.engine.sampleRate)
+		if err != nil {
+			return err
+		}
+		p.applyStream(meta, stream, total, clockHz, frameRate, loop, loopSample, "68K")
+		return nil
+	}
+	return p.loadCached(renderCachePSGSNDH, renderSNDH, data, "68K")
+}
+
 func (p *PSGPlayer) loadVTX(data []byte) error {
 	if p.engine == nil {
 		return fmt.Errorf("psg engine not configured")
 	}
-	ymFile, meta, err := ParseVTXData(data)
-	if err != nil {
-		return err
+	return p.loadCached(renderCachePSGVTX, psgResultRender(renderVTXPSG), data, "")
+}
+
+// loadYM loads a YM file, unpacking an LHA-compressed one first.
+func (p *PSGPlayer) loadYM(data []byte) error {
+	if p.engine == nil {
+		return fmt.Errorf("psg engine not configured")
 	}
-	p.metadata = meta
-	p.frameRate = ymFile.FrameRate
-	p.clockHz = ymFile.ClockHz
-	return p.loadFrames(ymFile.Frames, ymFile.FrameRate, ymFile.ClockHz, ymFile.LoopFrame)
+	return p.loadCached(renderCachePSGYM, psgResultRender(renderYMPSG), data, "")
 }
 
 func (p *PSGPlayer) loadTracker(ext string, data []byte) error {
@@ -315,11 +329,11 @@ func (p *PSGPlayer) loadTracker(ext string, data []byte) error {
 	// PT1, ASC, FTC use native Go players (no Z80 emulation)
 	switch ext {
 	case ".pt1":
-		return p.loadTrackerNative(ext, data, renderPT1Native)
+		return p.loadCached(renderCachePSGPT1, trackerNativePSGRender(ext, renderPT1Native), data, "")
 	case ".asc":
-		return p.loadTrackerNative(ext, data, renderASCNative)
+		return p.loadCached(renderCachePSGASC, trackerNativePSGRender(ext, renderASCNative), data, "")
 	case ".ftc":
-		return p.loadTrackerNative(ext, data, renderFTCNative)
+		return p.loadCached(renderCachePSGFTC, trackerNativePSGRender(ext, renderFTCNative), data, "")
 	}
 
 	// PT3, PT2, STC, SQT use Z80 emulation
@@ -327,51 +341,76 @@ func (p *PSGPlayer) loadTracker(ext string, data []byte) error {
 	if !ok {
 		return fmt.Errorf("unsupported tracker format: %s", ext)
 	}
-	info, err := parseTrackerModule(ext, data)
-	if err != nil {
-		return err
-	}
-	meta, events, totalSamples, err := renderTrackerZ80(config, data, p.engine.sampleRate, info.frameCount)
-	if err != nil {
-		return err
-	}
-	meta.Title = info.title
-	meta.Author = info.author
-	if meta.System == "" {
-		meta.System = "ZX Spectrum"
+	var format uint64
+	switch ext {
+	case ".pt3":
+		format = renderCachePSGPT3
+	case ".pt2":
+		format = renderCachePSGPT2
+	case ".stc":
+		format = renderCachePSGSTC
+	case ".sqt":
+		format = renderCachePSGSQT
+	default:
+		return fmt.Errorf("unsupported tracker format: %s", ext)
 	}
-	p.metadata = meta
-	p.frameRate = config.frameRate
-	p.clockHz = config.clockHz
-	p.loop = true
-	p.loopSample = 0
-	p.renderCPU = "Z80"
-	p.engine.SetClockHz(config.clockHz)
-	p.engine.SetEvents(events, totalSamples, true, 0)
-	return nil
+	return p.loadCached(format, trackerZ80PSGRender(ext, config), data, "Z80")
 }
 
-// loadTrackerNative loads a tracker module using a native Go renderer.
-func (p *PSGPlayer) loadTrackerNative(ext string, data []byte, renderFunc func([]byte) ([][]uint8, uint32, error)) error {
-	info, err := parseTrackerModule(ext, data)
-	if err != nil {
-		// Metadata parsing failed — still try to render
-		info = trackerModuleInfo{format: ext}
+// trackerZ80PSGRender adapts a Z80 tracker player to renderPSGCached.
+func trackerZ80PSGRender(ext string, config trackerFormatConfig) psgGuestRenderFunc {
+	return func(data []byte, sampleRate int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+		info, err := parseTrackerModule(ext, data)
+		if err != nil {
+			return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, err
+		}
+		meta, events, totalSamples, err := renderTrackerZ80(config, data, sampleRate, info.frameCount)
+		if err != nil {
+			return meta, nil, 0, 0, 0, false, 0, 0, 0, err
+		}
+		meta.Title = info.title
+		meta.Author = info.author
+		if meta.System == "" {
+			meta.System = "ZX Spectrum"
+		}
+		return meta, events, totalSamples, config.clockHz, config.frameRate, true, 0, 0, 0, nil
 	}
+}
 
-	frames, loopFrame, err := renderFunc(data)
-	if err != nil {
-		return err
-	}
+// trackerNativePSGRender adapts a native Go tracker player to renderPSGCached.
+func trackerNativePSGRender(ext string, renderFunc func([]byte) ([][]uint8, uint32, error)) psgGuestRenderFunc {
+	return psgResultRender(func(data []byte, sampleRate int) (psgRenderResult, error) {
+		var res psgRenderResult
+		info, err := parseTrackerModule(ext, data)
+		if err != nil {
+			// Metadata parsing failed — still try to render
+			info = trackerModuleInfo{format: ext}
+		}
+		frames, loopFrame, err := renderFunc(data)
+		if err != nil {
+			return res, err
+		}
+		events, total, loop, loopSample, err := buildPSGEventsFromFrames(frames, trackerFrameRate, sampleRate, loopFrame)
+		if err != nil {
+			return res, err
+		}
+		res.metadata = PSGMetadata{Title: info.title, Author: info.author, System: "ZX Spectrum"}
+		res.frameRate = trackerFrameRate
+		res.clockHz = zxSpectrumClock
+		res.loop = loop
+		res.loopSample = loopSample
+		res.events = events
+		res.totalSamples = total
+		return res, nil
+	})
+}
 
-	p.metadata = PSGMetadata{
-		Title:  info.title,
-		Author: info.author,
-		System: "ZX Spectrum",
+// psgResultRender adapts a psgRenderResult renderer to renderPSGCached.
+func psgResultRender(render func([]byte, int) (psgRenderResult, error)) psgGuestRenderFunc {
+	return func(data []byte, sampleRate int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+		res, err := render(data, sampleRate)
+		return res.metadata, res.events, res.totalSamples, res.clockHz, res.frameRate, res.loop, res.loopSample, res.renderInstructions, res.renderExecNanos, err
 	}
-	p.frameRate = trackerFrameRate
-	p.clockHz = zxSpectrumClock
-	return p.loadFrames(frames, trackerFrameRate, zxSpectrumClock, loopFrame)
 }
 
 func renderVTXPSG(data []byte, sampleRate int) (psgRenderResult, error) {
@@ -394,6 +433,32 @@ func renderVTXPSG(data []byte, sampleRate int) (psgRenderResult, error) {
 	return res, nil
 }
 
+func renderYMPSG(data []byte, sampleRate int) (psgRenderResult, error) {
+	var res psgRenderResult
+	file, err := parseYMData(data)
+	if err != nil {
+		decompressed, decErr := DecompressLHAData(data)
+		if decErr != nil {
+			return res, decErr
+		}
+		if file, err = parseYMData(decompressed); err != nil {
+			return res, err
+		}
+	}
+	events, total, loop, loopSample, err := buildPSGEventsFromFrames(file.Frames, file.FrameRate, sampleRate, file.LoopFrame)
+	if err != nil {
+		return res, err
+	}
+	res.metadata = PSGMetadata{Title: file.Title, Author: file.Author, System: "Atari ST"}
+	res.frameRate = file.FrameRate
+	res.clockHz = file.ClockHz
+	res.loop = loop
+	res.loopSample = loopSample
+	res.events = events
+	res.totalSamples = total
+	return res, nil
+}
+
 func (p *PSGPlayer) loadFrames(frames [][]uint8, frameRate uint16, clockHz uint32, loopFrame uint32) error {
 	if frameRate == 0 {
 		return fmt.Errorf("invalid frame rate")
@@ -449,9 +514,18 @@ func (p *PSGPlayer) loadFrames(frames [][]uint8, frameRate uint16, clockHz uint3
 }
 
 func (p *PSGPlayer) RenderPerf() (uint64, string, uint64) {
+	if p.stream != nil {
+		instr, nanos := p.stream.perf()
+		return instr, p.renderCPU, nanos
+	}
 	return p.renderInstructions, p.renderCPU, p.renderExecNanos
 }
 
+// RenderCacheHit reports whether the last load was served from the render cache.
+func (p *PSGPlayer) RenderCacheHit() bool {
+	return p.renderCacheHit
+}
+
 func (p *PSGPlayer) DurationSeconds() float64 {
 	if p.engine == nil || p.engine.totalSamples == 0 {
 		return 0
@@ -487,6 +561,29 @@ type psgRenderResult struct {
 	renderInstructions uint64
 	renderCPU          string
 	renderExecNanos    uint64
+	cacheHit           bool
+}
+
+// renderPSGResultCached runs render through renderPSGCached for the async
+// start path.
+func renderPSGResultCached(format uint64, render psgGuestRenderFunc, data []byte, sampleRate int, cpu string) (psgRenderResult, error) {
+	var res psgRenderResult
+	meta, events, total, clockHz, frameRate, loop, loopSample, instrCount, execNanos, cacheHit, err := renderPSGCached(format, render, data, sampleRate)
+	if err != nil {
+		return res, err
+	}
+	res.metadata = meta
+	res.frameRate = frameRate
+	res.clockHz = clockHz
+	res.loop = loop
+	res.loopSample = loopSample
+	res.events = events
+	res.totalSamples = total
+	res.renderInstructions = instrCount
+	res.renderCPU = cpu
+	res.renderExecNanos = execNanos
+	res.cacheHit = cacheHit
+	return res, nil
 }
 
 func buildPSGEventsFromFrames(frames [][]uint8, frameRate uint16, sampleRate int, loopFrame uint32) ([]PSGEvent, uint64, bool, uint64, error) {
@@ -571,66 +668,23 @@ func renderPSGData(data []byte, sampleRate int) (psgRenderResult, error) {
 		return res, nil
 	}
 	if len(data) >= 4 && (string(data[:4]) == "YM5!" || string(data[:4]) == "YM6!") {
-		file, err := parseYMData(data)
-		if err != nil {
-			return res, err
-		}
-		events, total, loop, loopSample, err := buildPSGEventsFromFrames(file.Frames, file.FrameRate, sampleRate, file.LoopFrame)
-		if err != nil {
-			return res, err
-		}
-		res.metadata = PSGMetadata{Title: file.Title, Author: file.Author, System: "Atari ST"}
-		res.frameRate = file.FrameRate
-		res.clockHz = file.ClockHz
-		res.loop = loop
-		res.loopSample = loopSample
-		res.events = events
-		res.totalSamples = total
-		return res, nil
+		return renderPSGResultCached(renderCachePSGYM, psgResultRender(renderYMPSG), data, sampleRate, "")
 	}
 	if isVTXData(data) {
-		return renderVTXPSG(data, sampleRate)
+		return renderPSGResultCached(renderCachePSGVTX, psgResultRender(renderVTXPSG), data, sampleRate, "")
 	}
 	if isLHAData(data) {
-		decompressed, err := DecompressLHAData(data)
+		decompressed, err := UnpackAsset(data)
 		if err != nil {
 			return res, err
 		}
 		return renderPSGData(decompressed, sampleRate)
 	}
 	if isZXAYEMUL(data) {
-		meta, events, total, clockHz, frameRate, loop, loopSample, instrCount, execNanos, err := renderAYZ80(data, sampleRate)
-		if err != nil {
-			return res, err
-		}
-		res.metadata = meta
-		res.frameRate = frameRate
-		res.clockHz = clockHz
-		res.loop = loop
-		res.loopSample = loopSample
-		res.events = events
-		res.totalSamples = total
-		res.renderInstructions = instrCount
-		res.renderCPU = "Z80"
-		res.renderExecNanos = execNanos
-		return res, nil
+		return renderPSGResultCached(renderCachePSGAYZ80, renderAYZ80, data, sampleRate, "Z80")
 	}
 	if isSNDHData(data) {
-		meta, events, total, clockHz, frameRate, loop, loopSample, instrCount, execNanos, err := renderSNDH(data, sampleRate)
-		if err != nil {
-			return res, err
-		}
-		res.metadata = meta
-		res.frameRate = frameRate
-		res.clockHz = clockHz
-		res.loop = loop
-		res.loopSample = loopSample
-		res.events = events
-		res.totalSamples = total
-		res.renderInstructions = instrCount
-		res.renderCPU = "68K"
-		res.renderExecNanos = execNanos
-		return res, nil
+		return renderPSGResultCached(renderCachePSGSNDH, renderSNDH, data, sampleRate, "68K")
 	}
 
 	file, err := ParseAYData(data)
@@ -657,6 +711,8 @@ func (p *PSGPlayer) applyRenderResult(res psgRenderResult) {
 	p.clockHz = res.clockHz
 	p.loop = res.loop
 	p.loopSample = res.loopSample
+	p.stream = nil
+	p.renderCacheHit = res.cacheHit
 	p.renderInstructions = res.renderInstructions
 	p.renderCPU = res.renderCPU
 	p.renderExecNanos = res.renderExecNanos
@@ -3,6 +3,7 @@ package main
 import (
 	"os"
 	"path/filepath"
+	"reflect"
 	"testing"
 )
 
@@ -305,6 +306,46 @@ func TestPSGPlayer_LoadRealSQT(t *testing.T) {
 	}
 }
 
+func TestPSGPlayer_TrackerAndVTXLoadsUseRenderCache(t *testing.T) {
+	renderCacheShared = newRenderCache(t.TempDir(), 1<<24)
+	renderCacheOnce.Do(func() {})
+	t.Cleanup(func() { renderCacheShared = nil })
+
+	pt3 := make([]byte, 0x100)
+	copy(pt3[0:13], "ProTracker 3.")
+	pt3[0x0D] = '5'
+	pt3[0x63] = 3
+	pt3[0x64] = 1
+
+	for _, tc := range []struct {
+		ext  string
+		data []byte
+	}{
+		{".pt3", pt3},
+		{".vtx", buildTestVTXFile(t)},
+	} {
+		player := newTestPSGPlayer(t)
+		if err := player.LoadDataWithHint(tc.data, tc.ext); err != nil {
+			t.Fatalf("%s first load: %v", tc.ext, err)
+		}
+		if player.RenderCacheHit() {
+			t.Fatalf("%s first load hit an empty cache", tc.ext)
+		}
+		first, total := player.engine.events, player.engine.totalSamples
+
+		player = newTestPSGPlayer(t)
+		if err := player.LoadDataWithHint(tc.data, tc.ext); err != nil {
+			t.Fatalf("%s second load: %v", tc.ext, err)
+		}
+		if !player.RenderCacheHit() {
+			t.Fatalf("%s second load missed the cache", tc.ext)
+		}
+		if player.engine.totalSamples != total || !reflect.DeepEqual(player.engine.events, first) {
+			t.Fatalf("%s cached render differs: %d/%d events", tc.ext, len(player.engine.events), len(first))
+		}
+	}
+}
+
 // buildTestVTXFile creates a minimal valid VTX file for testing.
 func buildTestVTXFile(t *testing.T) []byte {
 	t.Helper()
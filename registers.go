@@ -81,7 +81,7 @@ Video Chip (0xF0000-0xF0054) - video_chip.go
   VIDEO_RASTER_* (Raster effect registers)
 
 Audio Chip (0xF0800-0xF0B7F) - audio_chip.go
-  0xF0800-0xF08FF: Global control (AUDIO_CTRL, ENV_SHAPE, FILTER_*)
+  0xF0800-0xF08FF: Global control (AUDIO_CTRL, ENV_SHAPE, FILTER_*, AUDIO_PLUS_BANDLIMIT)
   0xF0900-0xF093F: Square wave (SQUARE_*)
   0xF0940-0xF097F: Triangle wave (TRI_*)
   0xF0980-0xF09BF: Sine wave (SINE_*)
@@ -285,6 +285,14 @@ const (
 	SYSINFO_ACTIVE_RAM_LO = 0xF2408 // low 32 bits of active CPU/profile visible RAM
 	SYSINFO_ACTIVE_RAM_HI = 0xF240C // high 32 bits of active CPU/profile visible RAM
 
+	// Audio output telemetry (live; zero without an audio backend).
+	SYSINFO_AUDIO_UNDERRUNS  = 0xF2410 // output ring underruns observed while playing
+	SYSINFO_AUDIO_MISSES     = 0xF2414 // render callbacks slower than the audio they produced
+	SYSINFO_AUDIO_RENDER_P99 = 0xF2418 // 99th percentile callback render time (µs, bucketed)
+	SYSINFO_AUDIO_LATENCY_US = 0xF241C // estimated output latency (µs)
+	SYSINFO_AUDIO_BUFFER     = 0xF2420 // output buffer target (frames; 0 = backend default)
+	SYSINFO_AUDIO_JITTER_US  = 0xF2424 // average callback spacing jitter (µs)
+
 	// AROS host socket bridge. The planning draft proposed 0xF2400, but
 	// that range is occupied by SYSINFO, so sockets use the next 128-byte gap.
 	AROS_HOST_SOCKET_REGION_BASE = 0xF2500
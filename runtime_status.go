@@ -73,6 +73,7 @@ func runtimeAudioStatusIndicators(s runtimeStatusSnapshot) []runtimeStatusIndica
 	paulaOn := s.paulaDMA != nil && s.paulaDMA.enabled.Load()
 	midiOn := (s.midiPlayer != nil && s.midiPlayer.IsPlaying()) ||
 		(s.midiEngine != nil && s.midiEngine.LiveActive())
+	xrunOn := s.sound != nil && s.sound.telemetry.troubleRecently()
 
 	return []runtimeStatusIndicator{
 		{name: "IESND", enabled: soundOn},
@@ -94,6 +95,8 @@ func runtimeAudioStatusIndicators(s runtimeStatusSnapshot) []runtimeStatusIndica
 		{name: "PAULA", enabled: paulaOn},
 		{name: "|", enabled: false},
 		{name: "MIDI", enabled: midiOn},
+		{name: "|", enabled: false},
+		{name: "XRUN", enabled: xrunOn},
 	}
 }
 
@@ -264,6 +264,11 @@ func (p *SAP6502Player) GetTotalCycles() uint64 {
 	return p.totalCycles
 }
 
+// renderPerf returns the guest instruction count and CPU time spent so far
+func (p *SAP6502Player) renderPerf() (uint64, uint64) {
+	return p.instructionCount, p.cpuExecNanos
+}
+
 // Reset resets the player to initial state
 func (p *SAP6502Player) Reset() {
 	p.bus.Reset()
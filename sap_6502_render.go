@@ -44,12 +44,22 @@ func renderSAP(data []byte, sampleRate int) (SAPMetadata, []SAPPOKEYEvent, uint6
 	return renderSAPWithLimit(data, sampleRate, 0, 0)
 }
 
-// renderSAPWithLimit renders SAP data with optional frame limit and subsong selection
-func renderSAPWithLimit(data []byte, sampleRate int, maxFrames int, subsong int) (SAPMetadata, []SAPPOKEYEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+// sapRenderPlan holds a primed 6502 player and the frame budget for one subsong
+type sapRenderPlan struct {
+	meta       SAPMetadata
+	player     *SAP6502Player
+	frameCount int
+	frameRate  uint16
+	loop       bool
+	loopSample uint64
+}
+
+// prepareSAPRender parses SAP data, runs INIT and works out the frame budget
+func prepareSAPRender(data []byte, sampleRate int, maxFrames int, subsong int) (sapRenderPlan, error) {
 	// Parse SAP file
 	file, err := ParseSAPData(data)
 	if err != nil {
-		return SAPMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("parse SAP: %w", err)
+		return sapRenderPlan{}, fmt.Errorf("parse SAP: %w", err)
 	}
 
 	// Validate subsong
@@ -60,7 +70,7 @@ func renderSAPWithLimit(data []byte, sampleRate int, maxFrames int, subsong int)
 	// Create player
 	player, err := newSAP6502Player(file, subsong, sampleRate)
 	if err != nil {
-		return SAPMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("create SAP player: %w", err)
+		return sapRenderPlan{}, fmt.Errorf("create SAP player: %w", err)
 	}
 
 	// Build metadata
@@ -107,13 +117,48 @@ func renderSAPWithLimit(data []byte, sampleRate int, maxFrames int, subsong int)
 		frameCount = sapMaxFrames
 	}
 
-	// Render frames - returns native POKEY events
-	pokeyEvents, totalSamples := player.RenderFrames(frameCount)
+	return sapRenderPlan{
+		meta:       meta,
+		player:     player,
+		frameCount: frameCount,
+		frameRate:  frameRate,
+		loop:       loop,
+		loopSample: loopSample,
+	}, nil
+}
 
-	// Calculate loop sample if looping
-	if loop && frameCount > 0 {
-		loopSample = 0
+// renderSAPWithLimit renders SAP data with optional frame limit and subsong selection
+func renderSAPWithLimit(data []byte, sampleRate int, maxFrames int, subsong int) (SAPMetadata, []SAPPOKEYEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+	plan, err := prepareSAPRender(data, sampleRate, maxFrames, subsong)
+	if err != nil {
+		return SAPMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, err
 	}
+	player := plan.player
 
-	return meta, pokeyEvents, totalSamples, clockHz, frameRate, loop, loopSample, player.instructionCount, player.cpuExecNanos, nil
+	// Render frames - returns native POKEY events
+	pokeyEvents, totalSamples := player.RenderFrames(plan.frameCount)
+
+	return plan.meta, pokeyEvents, totalSamples, player.GetClockHz(), plan.frameRate, plan.loop, plan.loopSample, player.instructionCount, player.cpuExecNanos, nil
+}
+
+// streamSAPWithLimit prepares a SAP render and starts a background event
+// stream primed with its first chunk instead of rendering the whole tune
+func streamSAPWithLimit(data []byte, sampleRate int, maxFrames int, subsong int) (SAPMetadata, *musicEventStream[SAPPOKEYEvent], uint64, uint32, bool, uint64, error) {
+	plan, err := prepareSAPRender(data, sampleRate, maxFrames, subsong)
+	if err != nil {
+		return SAPMetadata{}, nil, 0, 0, false, 0, err
+	}
+	player := plan.player
+	clockHz := player.GetClockHz()
+	totalSamples := uint64(plan.frameCount) * uint64(player.getSamplesPerFrame())
+	reopen := func() (musicFrameRenderer[SAPPOKEYEvent], error) {
+		next, err := prepareSAPRender(data, sampleRate, maxFrames, subsong)
+		if err != nil {
+			return nil, err
+		}
+		return next.player, nil
+	}
+	stream := newMusicEventStream[SAPPOKEYEvent](player, reopen, plan.frameCount, plan.loop, plan.loopSample, func(ev *SAPPOKEYEvent) uint64 { return ev.Sample })
+	stream.prime()
+	return plan.meta, stream, totalSamples, clockHz, plan.loop, plan.loopSample, nil
 }
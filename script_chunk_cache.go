@@ -0,0 +1,154 @@
+// script_chunk_cache.go - Compiled Lua chunk cache and warm script states
+
+/*
+Starting a script used to build a throwaway sandboxed LState just to parse
+it, then build a second one, register every binding and compile the source
+again; each require recompiled its module in every state. Two things now
+take that off the startup path:
+
+  - scriptChunks caches compiled FunctionProtos process-wide. Source text is
+    keyed by a SHA-256 of chunk name and content; files are keyed by path and
+    revalidated by size and mtime before falling back to the content key, so
+    an edited module recompiles while identical content shared between paths
+    or engines compiles once. Protos are immutable and gopher-lua runs them
+    in any LState via NewFunctionFromProto.
+  - Each ScriptEngine keeps one warm scriptState: a sandboxed LState with all
+    bindings registered and its own run context. runScript takes it and a
+    replacement is built in the background, so back-to-back scripts start
+    without paying for state construction.
+
+Scripts mutate their globals, so states are never reused after a run; only
+fresh ones are pooled. gopher-lua has no bytecode serialiser, so the cache
+lives in memory only.
+*/
+
+package main
+
+import (
+	"context"
+	"crypto/sha256"
+	"os"
+	"strings"
+	"sync"
+	"time"
+
+	lua "github.com/yuin/gopher-lua"
+	"github.com/yuin/gopher-lua/parse"
+)
+
+const scriptChunkCacheMax = 512 // compiled chunks kept before the cache resets
+
+type luaChunkKey [sha256.Size]byte
+
+type luaFileChunk struct {
+	size    int64
+	modTime time.Time
+	proto   *lua.FunctionProto
+}
+
+type luaChunkCache struct {
+	mu     sync.Mutex
+	chunks map[luaChunkKey]*lua.FunctionProto
+	files  map[string]luaFileChunk
+}
+
+var scriptChunks = &luaChunkCache{}
+
+// compile returns the compiled proto for source under chunk name, compiling
+// it on first sight. Errors match lua.LState.LoadString.
+func (c *luaChunkCache) compile(source, name string) (*lua.FunctionProto, error) {
+	h := sha256.New()
+	h.Write([]byte(name))
+	h.Write([]byte{0})
+	h.Write([]byte(source))
+	var key luaChunkKey
+	h.Sum(key[:0])
+
+	c.mu.Lock()
+	proto := c.chunks[key]
+	c.mu.Unlock()
+	if proto != nil {
+		return proto, nil
+	}
+
+	chunk, err := parse.Parse(strings.NewReader(source), name)
+	if err != nil {
+		return nil, err
+	}
+	if proto, err = lua.Compile(chunk, name); err != nil {
+		return nil, err
+	}
+
+	c.mu.Lock()
+	if c.chunks == nil || len(c.chunks) >= scriptChunkCacheMax {
+		c.chunks = make(map[luaChunkKey]*lua.FunctionProto)
+	}
+	c.chunks[key] = proto
+	c.mu.Unlock()
+	return proto, nil
+}
+
+// compileFile is compile for the contents of path, skipping the read
+// entirely while the file's size and mtime are unchanged.
+func (c *luaChunkCache) compileFile(path, name string) (*lua.FunctionProto, error) {
+	info, err := os.Stat(path)
+	if err != nil {
+		return nil, err
+	}
+	fileKey := path + "\x00" + name
+	c.mu.Lock()
+	f, ok := c.files[fileKey]
+	c.mu.Unlock()
+	if ok && f.size == info.Size() && f.modTime.Equal(info.ModTime()) {
+		return f.proto, nil
+	}
+
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, err
+	}
+	proto, err := c.compile(string(data), name)
+	if err != nil {
+		return nil, err
+	}
+	c.mu.Lock()
+	if c.files == nil || len(c.files) >= scriptChunkCacheMax {
+		c.files = make(map[string]luaFileChunk)
+	}
+	c.files[fileKey] = luaFileChunk{size: info.Size(), modTime: info.ModTime(), proto: proto}
+	c.mu.Unlock()
+	return proto, nil
+}
+
+// scriptState is a sandboxed LState with every binding registered, bound to
+// the context its run will use.
+type scriptState struct {
+	L      *lua.LState
+	ctx    context.Context
+	cancel context.CancelFunc
+}
+
+func (se *ScriptEngine) newScriptState() *scriptState {
+	ctx, cancel := context.WithCancel(context.Background())
+	L := se.newSandboxedState(ctx)
+	se.registerModules(L, ctx)
+	se.registerBit32(L)
+	return &scriptState{L: L, ctx: ctx, cancel: cancel}
+}
+
+// takeScriptState returns the warm state if one is ready, else builds one,
+// and starts building the next in the background.
+func (se *ScriptEngine) takeScriptState() *scriptState {
+	st := se.warmState.Swap(nil)
+	if st == nil {
+		st = se.newScriptState()
+	}
+	go func() {
+		next := se.newScriptState()
+		if !se.warmState.CompareAndSwap(nil, next) {
+			next.cancel()
+			next.L.Close()
+		}
+	}()
+	return st
+}
@@ -4,10 +4,10 @@ import (
 	"context"
 	"errors"
 	"fmt"
-	"hash/fnv"
 	"image"
 	"image/color"
 	"image/png"
+	"math"
 	"os"
 	"path/filepath"
 	"runtime"
@@ -39,14 +39,15 @@ type ScriptEngine struct {
 	emutosSentinel string
 	arosSentinel   string
 
-	frameChan chan struct{}
-	faultChan chan BreakpointEvent
+	frameEvent eventSignal
+	faultChan  chan BreakpointEvent
 
 	mu        sync.Mutex
 	cancel    context.CancelFunc
 	done      chan struct{}
 	lastError error
 
+	warmState      atomic.Pointer[scriptState]
 	running        atomic.Bool
 	loadingProgram atomic.Bool
 	freezeCount    atomic.Int32
@@ -85,7 +86,6 @@ func NewScriptEngine(bus *MachineBus, compositor *VideoCompositor, terminal *Ter
 		bus:           bus,
 		compositor:    compositor,
 		terminal:      terminal,
-		frameChan:     make(chan struct{}, 1),
 		faultChan:     make(chan BreakpointEvent, 64),
 		recorder:      NewVideoRecorder(compositor),
 		coprocTickets: make(map[uint32]coprocTicketBuf),
@@ -190,15 +190,19 @@ func (se *ScriptEngine) LastError() error {
 }
 
 func (se *ScriptEngine) RunFile(path string) error {
-	data, err := os.ReadFile(path)
-	if err != nil {
-		return err
-	}
 	absPath, err := filepath.Abs(path)
 	if err != nil {
 		absPath = path
 	}
-	return se.runScript(string(data), absPath)
+	proto, err := scriptChunks.compileFile(path, "<string>")
+	if err != nil {
+		var pathErr *os.PathError
+		if errors.As(err, &pathErr) {
+			return err
+		}
+		return fmt.Errorf("script parse failed (%s): %w", absPath, err)
+	}
+	return se.runProto(proto, absPath)
 }
 
 func (se *ScriptEngine) RunString(script string, name string) error {
@@ -206,24 +210,27 @@ func (se *ScriptEngine) RunString(script string, name string) error {
 }
 
 func (se *ScriptEngine) runScript(script string, scriptName string) error {
-	if err := se.validateScript(script, scriptName); err != nil {
+	proto, err := se.compileScript(script, scriptName)
+	if err != nil {
 		return err
 	}
+	return se.runProto(proto, scriptName)
+}
 
+func (se *ScriptEngine) runProto(proto *lua.FunctionProto, scriptName string) error {
 	se.Cancel()
-	runtime.GC() // Reclaim old Lua state + recorder buffers before new script
 
-	ctx, cancel := context.WithCancel(context.Background())
+	st := se.takeScriptState()
 	done := make(chan struct{})
 
 	se.mu.Lock()
-	se.cancel = cancel
+	se.cancel = st.cancel
 	se.done = done
 	se.lastError = nil
 	se.running.Store(true)
 	se.mu.Unlock()
 
-	go se.run(ctx, done, script, scriptName)
+	go se.run(st, done, proto, scriptName)
 	return nil
 }
 
@@ -245,18 +252,23 @@ func (se *ScriptEngine) Cancel() {
 }
 
 func (se *ScriptEngine) validateScript(script string, name string) error {
-	L := se.newSandboxedState(context.Background(), name)
-	defer L.Close()
-	if _, err := L.LoadString(script); err != nil {
+	_, err := se.compileScript(script, name)
+	return err
+}
+
+// compileScript compiles script through the shared chunk cache.
+func (se *ScriptEngine) compileScript(script string, name string) (*lua.FunctionProto, error) {
+	proto, err := scriptChunks.compile(script, "<string>")
+	if err != nil {
 		if name != "" {
-			return fmt.Errorf("script parse failed (%s): %w", name, err)
+			return nil, fmt.Errorf("script parse failed (%s): %w", name, err)
 		}
-		return fmt.Errorf("script parse failed: %w", err)
+		return nil, fmt.Errorf("script parse failed: %w", err)
 	}
-	return nil
+	return proto, nil
 }
 
-func (se *ScriptEngine) run(ctx context.Context, done chan struct{}, script string, scriptName string) {
+func (se *ScriptEngine) run(st *scriptState, done chan struct{}, proto *lua.FunctionProto, scriptName string) {
 	defer func() {
 		if r := recover(); r != nil {
 			se.mu.Lock()
@@ -277,23 +289,25 @@ func (se *ScriptEngine) run(ctx context.Context, done chan struct{}, script stri
 		}
 		se.mu.Unlock()
 		close(done)
+		// Reclaim the finished Lua state and recorder buffers off the
+		// next script's startup path.
+		go runtime.GC()
 	}()
 
-	L := se.newSandboxedState(ctx, scriptName)
+	L := st.L
 	defer L.Close()
 	se.lastYieldNS.Store(time.Now().UnixNano())
 	se.beginScriptState(scriptName)
-	se.registerModules(L, ctx)
-	se.registerBit32(L)
 
-	if err := L.DoString(script); err != nil {
+	L.Push(L.NewFunctionFromProto(proto))
+	if err := L.PCall(0, lua.MultRet, nil); err != nil {
 		se.mu.Lock()
 		se.lastError = err
 		se.mu.Unlock()
 	}
 }
 
-func (se *ScriptEngine) newSandboxedState(ctx context.Context, scriptName string) *lua.LState {
+func (se *ScriptEngine) newSandboxedState(ctx context.Context) *lua.LState {
 	L := lua.NewState(lua.Options{SkipOpenLibs: true})
 	L.SetContext(ctx)
 	lua.OpenBase(L)
@@ -318,7 +332,7 @@ func (se *ScriptEngine) newSandboxedState(ctx context.Context, scriptName string
 		packageTbl.RawSetString("path", lua.LString(""))
 		packageTbl.RawSetString("cpath", lua.LString(""))
 	}
-	L.SetGlobal("require", L.NewFunction(se.luaRestrictedRequire(scriptName)))
+	L.SetGlobal("require", L.NewFunction(se.luaRestrictedRequire()))
 	return L
 }
 
@@ -336,7 +350,9 @@ func (se *ScriptEngine) scriptAllowedRoots(scriptName string) []string {
 	return roots
 }
 
-func (se *ScriptEngine) luaRestrictedRequire(scriptName string) lua.LGFunction {
+// luaRestrictedRequire resolves modules against the running script's roots
+// (se.scriptName is set by beginScriptState before the chunk runs).
+func (se *ScriptEngine) luaRestrictedRequire() lua.LGFunction {
 	return func(L *lua.LState) int {
 		mod := L.CheckString(1)
 		if mod == "" || strings.Contains(mod, "..") || strings.ContainsAny(mod, `/\`) {
@@ -355,18 +371,18 @@ func (se *ScriptEngine) luaRestrictedRequire(scriptName string) lua.LGFunction {
 			modPath + ".lua",
 			filepath.Join(modPath, "init.lua"),
 		}
-		for _, root := range se.scriptAllowedRoots(scriptName) {
+		for _, root := range se.scriptAllowedRoots(se.scriptName) {
 			for _, rel := range candidates {
 				path, err := validatePathInRoot(root, filepath.Join(root, rel), pathOpRead)
 				if err != nil {
 					continue
 				}
-				fn, err := L.LoadFile(path)
+				proto, err := scriptChunks.compileFile(path, path)
 				if err != nil {
 					L.RaiseError("%v", err)
 					return 0
 				}
-				L.Push(fn)
+				L.Push(L.NewFunctionFromProto(proto))
 				if err := L.PCall(0, 1, nil); err != nil {
 					L.RaiseError("%v", err)
 					return 0
@@ -774,13 +790,11 @@ func (se *ScriptEngine) onFrameComplete() {
 	if se.recorder != nil {
 		se.recorder.OnFrame()
 	}
-	select {
-	case se.frameChan <- struct{}{}:
-	default:
-	}
+	se.frameEvent.fire()
 }
 
 func (se *ScriptEngine) registerModules(L *lua.LState, ctx context.Context) {
+	se.registerBufferTypes(L)
 	sys := L.SetFuncs(L.NewTable(), map[string]lua.LGFunction{
 		"wait_frames":        se.luaSysWaitFrames(ctx),
 		"wait_ms":            se.luaSysWaitMS(ctx),
@@ -827,6 +841,7 @@ func (se *ScriptEngine) registerModules(L *lua.LState, ctx context.Context) {
 		"write16":     se.luaMemWrite16(),
 		"write32":     se.luaMemWrite32(),
 		"read_block":  se.luaMemReadBlock(),
+		"view":        se.luaMemView(),
 		"write_block": se.luaMemWriteBlock(),
 		"fill":        se.luaMemFill(),
 	})
@@ -961,7 +976,9 @@ func (se *ScriptEngine) registerModules(L *lua.LState, ctx context.Context) {
 		"get_pixel":             se.luaVideoGetPixel(),
 		"get_region":            se.luaVideoGetRegion(),
 		"frame_hash":            se.luaVideoFrameHash(),
+		"region_hash":           se.luaVideoRegionHash(),
 		"wait_pixel":            se.luaVideoWaitPixel(ctx),
+		"wait_region_hash":      se.luaVideoWaitRegionHash(ctx),
 		"wait_stable":           se.luaVideoWaitStable(ctx),
 		"wait_condition":        se.luaVideoWaitCondition(ctx),
 	})
@@ -1012,6 +1029,7 @@ func (se *ScriptEngine) registerModules(L *lua.LState, ctx context.Context) {
 		"get_reg":             se.luaDbgGetReg(),
 		"set_reg":             se.luaDbgSetReg(),
 		"get_regs":            se.luaDbgGetRegs(),
+		"regs_snapshot":       se.luaDbgRegsSnapshot(),
 		"get_pc":              se.luaDbgGetPC(),
 		"set_pc":              se.luaDbgSetPC(),
 		"read_mem":            se.luaDbgReadMem(),
@@ -1163,12 +1181,15 @@ func (se *ScriptEngine) luaSysWaitFrames(ctx context.Context) lua.LGFunction {
 			L.ArgError(1, "must be >= 0")
 			return 0
 		}
-		for range n {
-			select {
-			case <-ctx.Done():
+		target := se.frameCount.Load() + uint64(n)
+		for {
+			wake := se.frameEvent.wait()
+			if se.frameCount.Load() >= target {
+				break
+			}
+			if awaitEvent(ctx, wake, time.Time{}) == waitCancelled {
 				L.RaiseError("script cancelled")
 				return 0
-			case <-se.frameChan:
 			}
 		}
 		se.lastYieldNS.Store(time.Now().UnixNano())
@@ -2343,32 +2364,25 @@ func (se *ScriptEngine) luaTermWaitOutput(ctx context.Context) lua.LGFunction {
 			return 0
 		}
 
-		var builder strings.Builder
-		builder.WriteString(se.terminal.DrainOutput())
-		if strings.Contains(builder.String(), pattern) {
-			L.Push(lua.LBool(true))
-			return 1
-		}
-
 		deadline := time.Now().Add(time.Duration(timeoutMS) * time.Millisecond)
-		ticker := time.NewTicker(10 * time.Millisecond)
-		defer ticker.Stop()
-
+		var builder strings.Builder
 		for {
-			select {
-			case <-ctx.Done():
+			ready := se.terminal.OutputReady()
+			// Only the new text plus a pattern-length overlap can hold a
+			// first match.
+			from := max(builder.Len()-max(len(pattern)-1, 0), 0)
+			builder.WriteString(se.terminal.DrainOutput())
+			if strings.Contains(builder.String()[from:], pattern) {
+				L.Push(lua.LBool(true))
+				return 1
+			}
+			switch awaitEvent(ctx, ready, deadline) {
+			case waitCancelled:
 				L.RaiseError("script cancelled")
 				return 0
-			case <-ticker.C:
-				builder.WriteString(se.terminal.DrainOutput())
-				if strings.Contains(builder.String(), pattern) {
-					L.Push(lua.LBool(true))
-					return 1
-				}
-				if time.Now().After(deadline) {
-					L.Push(lua.LBool(false))
-					return 1
-				}
+			case waitTimedOut:
+				L.Push(lua.LBool(false))
+				return 1
 			}
 		}
 	}
@@ -3724,19 +3738,13 @@ func (se *ScriptEngine) luaVideoGetPixel() lua.LGFunction {
 	return func(L *lua.LState) int {
 		x := L.CheckInt(1)
 		y := L.CheckInt(2)
-		frame, w, h := se.compositorFrame()
-		if frame == nil || x < 0 || y < 0 || x >= w || y >= h {
-			L.Push(lua.LNumber(0))
-			L.Push(lua.LNumber(0))
-			L.Push(lua.LNumber(0))
-			L.Push(lua.LNumber(0))
-			return 4
+		var px [4]byte
+		if se.compositor != nil {
+			px, _ = se.compositor.PixelAt(x, y)
+		}
+		for _, c := range px {
+			L.Push(lua.LNumber(c))
 		}
-		i := (y*w + x) * 4
-		L.Push(lua.LNumber(frame[i]))
-		L.Push(lua.LNumber(frame[i+1]))
-		L.Push(lua.LNumber(frame[i+2]))
-		L.Push(lua.LNumber(frame[i+3]))
 		return 4
 	}
 }
@@ -3752,8 +3760,12 @@ func (se *ScriptEngine) luaVideoGetRegion() lua.LGFunction {
 			return 1
 		}
 
-		frame, fw, fh := se.compositorFrame()
-		if frame == nil || fw <= 0 || fh <= 0 {
+		if se.compositor == nil {
+			L.Push(lua.LString(""))
+			return 1
+		}
+		fw, fh := se.compositor.GetDimensions()
+		if fw <= 0 || fh <= 0 {
 			L.Push(lua.LString(""))
 			return 1
 		}
@@ -3777,30 +3789,86 @@ func (se *ScriptEngine) luaVideoGetRegion() lua.LGFunction {
 			hr = fh - y
 		}
 
-		out := make([]byte, 0, wr*hr*4)
-		for row := 0; row < hr; row++ {
-			start := ((y+row)*fw + x) * 4
-			out = append(out, frame[start:start+wr*4]...)
-		}
-		L.Push(lua.LString(string(out)))
+		L.Push(lua.LString(string(se.compositor.ReadRegion(x, y, wr, hr))))
 		return 1
 	}
 }
 
 func (se *ScriptEngine) luaVideoFrameHash() lua.LGFunction {
 	return func(L *lua.LState) int {
-		frame, _, _ := se.compositorFrame()
-		if len(frame) == 0 {
+		if se.compositor == nil {
 			L.Push(lua.LNumber(0))
 			return 1
 		}
-		h := fnv.New32a()
-		_, _ = h.Write(frame)
-		L.Push(lua.LNumber(h.Sum32()))
+		// The whole-frame digest, folded to 32 bits so a Lua number holds
+		// it exactly. It is cached until the frame changes.
+		digest, ok := se.compositor.FrameDigest()
+		if !ok {
+			L.Push(lua.LNumber(0))
+			return 1
+		}
+		L.Push(lua.LNumber(uint32(digest ^ digest>>32)))
 		return 1
 	}
 }
 
+// regionArgs reads an optional x, y, w, h starting at argument n; with no
+// arguments the region is the whole frame.
+func (se *ScriptEngine) regionArgs(L *lua.LState, n int) (x, y, w, h int) {
+	if L.GetTop() < n {
+		w, h = se.compositor.GetDimensions()
+		return 0, 0, w, h
+	}
+	return L.CheckInt(n), L.CheckInt(n + 1), L.CheckInt(n + 2), L.CheckInt(n + 3)
+}
+
+func (se *ScriptEngine) luaVideoRegionHash() lua.LGFunction {
+	return func(L *lua.LState) int {
+		if se.compositor == nil {
+			L.Push(lua.LString(""))
+			return 1
+		}
+		x, y, w, h := se.regionArgs(L, 1)
+		digest, ok := se.compositor.RegionDigest(x, y, w, h)
+		if !ok {
+			L.Push(lua.LString(""))
+			return 1
+		}
+		L.Push(lua.LString(fmt.Sprintf("%016x", digest)))
+		return 1
+	}
+}
+
+func (se *ScriptEngine) luaVideoWaitRegionHash(ctx context.Context) lua.LGFunction {
+	return func(L *lua.LState) int {
+		x := L.CheckInt(1)
+		y := L.CheckInt(2)
+		w := L.CheckInt(3)
+		h := L.CheckInt(4)
+		want := L.CheckString(5)
+		timeoutMS := L.CheckInt(6)
+		if timeoutMS < 0 {
+			L.ArgError(6, "must be >= 0")
+			return 0
+		}
+		deadline := time.Now().Add(time.Duration(timeoutMS) * time.Millisecond)
+		var seen uint64
+		return se.waitFrames(L, ctx, deadline, func() bool {
+			if se.compositor == nil {
+				return false
+			}
+			// Re-digest only when a row of the region was redrawn.
+			changed, serial, ok := se.compositor.DamageSince(y, y+h, seen)
+			if !ok || !changed {
+				return false
+			}
+			seen = serial
+			digest, ok := se.compositor.RegionDigest(x, y, w, h)
+			return ok && strings.EqualFold(fmt.Sprintf("%016x", digest), want)
+		})
+	}
+}
+
 func (se *ScriptEngine) luaVideoWaitPixel(ctx context.Context) lua.LGFunction {
 	return func(L *lua.LState) int {
 		x := L.CheckInt(1)
@@ -3814,29 +3882,23 @@ func (se *ScriptEngine) luaVideoWaitPixel(ctx context.Context) lua.LGFunction {
 			return 0
 		}
 		deadline := time.Now().Add(time.Duration(timeoutMS) * time.Millisecond)
-		for {
-			frame, w, h := se.compositorFrame()
-			if frame != nil && x >= 0 && y >= 0 && x < w && y < h {
-				i := (y*w + x) * 4
-				if withinTol(int(frame[i]), r, 2) &&
-					withinTol(int(frame[i+1]), g, 2) &&
-					withinTol(int(frame[i+2]), b, 2) {
-					L.Push(lua.LBool(true))
-					return 1
-				}
+		var seen uint64
+		return se.waitFrames(L, ctx, deadline, func() bool {
+			if se.compositor == nil {
+				return false
 			}
-			if time.Now().After(deadline) {
-				L.Push(lua.LBool(false))
-				return 1
+			// Re-read the pixel only when its row was redrawn.
+			changed, serial, ok := se.compositor.DamageSince(y, y+1, seen)
+			if !ok || !changed {
+				return false
 			}
-			select {
-			case <-ctx.Done():
-				L.RaiseError("script cancelled")
-				return 0
-			case <-se.frameChan:
-			}
-			se.lastYieldNS.Store(time.Now().UnixNano())
-		}
+			seen = serial
+			px, ok := se.compositor.PixelAt(x, y)
+			return ok &&
+				withinTol(int(px[0]), r, 2) &&
+				withinTol(int(px[1]), g, 2) &&
+				withinTol(int(px[2]), b, 2)
+		})
 	}
 }
 
@@ -3853,35 +3915,24 @@ func (se *ScriptEngine) luaVideoWaitStable(ctx context.Context) lua.LGFunction {
 			return 0
 		}
 		deadline := time.Now().Add(time.Duration(timeoutMS) * time.Millisecond)
-		var last uint32
+		var seen uint64
 		stable := 0
-		for {
-			frame, _, _ := se.compositorFrame()
-			if len(frame) > 0 {
-				h := frameHash(frame)
-				if stable == 0 || h != last {
-					last = h
-					stable = 1
-				} else {
-					stable++
-					if stable >= nFrames {
-						L.Push(lua.LBool(true))
-						return 1
-					}
-				}
+		return se.waitFrames(L, ctx, deadline, func() bool {
+			if se.compositor == nil {
+				return false
 			}
-			if time.Now().After(deadline) {
-				L.Push(lua.LBool(false))
-				return 1
+			changed, serial, ok := se.compositor.DamageSince(0, math.MaxInt, seen)
+			if !ok {
+				return false
 			}
-			select {
-			case <-ctx.Done():
-				L.RaiseError("script cancelled")
-				return 0
-			case <-se.frameChan:
+			seen = serial
+			if stable == 0 || changed {
+				stable = 1
+				return false
 			}
-			se.lastYieldNS.Store(time.Now().UnixNano())
-		}
+			stable++
+			return stable >= nFrames
+		})
 	}
 }
 
@@ -3894,48 +3945,39 @@ func (se *ScriptEngine) luaVideoWaitCondition(ctx context.Context) lua.LGFunctio
 			return 0
 		}
 		deadline := time.Now().Add(time.Duration(timeoutMS) * time.Millisecond)
-		for {
+		return se.waitFrames(L, ctx, deadline, func() bool {
 			if err := L.CallByParam(lua.P{Fn: fn, NRet: 1, Protect: true}); err != nil {
 				L.RaiseError("wait_condition callback failed: %v", err)
-				return 0
+				return false
 			}
 			ret := L.Get(-1)
 			L.Pop(1)
-			if lv, ok := ret.(lua.LBool); ok && bool(lv) {
-				L.Push(lua.LBool(true))
-				return 1
-			}
-			if time.Now().After(deadline) {
-				L.Push(lua.LBool(false))
-				return 1
-			}
-			select {
-			case <-ctx.Done():
-				L.RaiseError("script cancelled")
-				return 0
-			case <-se.frameChan:
-			}
-			se.lastYieldNS.Store(time.Now().UnixNano())
-		}
+			lv, ok := ret.(lua.LBool)
+			return ok && bool(lv)
+		})
 	}
 }
 
-func (se *ScriptEngine) compositorFrame() ([]byte, int, int) {
-	if se.compositor == nil {
-		return nil, 0, 0
-	}
-	frame := se.compositor.GetCurrentFrame()
-	w, h := se.compositor.GetDimensions()
-	if len(frame) < w*h*4 {
-		return nil, w, h
+// waitFrames evaluates done now and then once per composited frame until it
+// reports true, the deadline passes or the script is cancelled, pushing the
+// boolean result. Timeouts fire on time even when no frames are arriving.
+func (se *ScriptEngine) waitFrames(L *lua.LState, ctx context.Context, deadline time.Time, done func() bool) int {
+	for {
+		wake := se.frameEvent.wait()
+		if done() {
+			L.Push(lua.LBool(true))
+			return 1
+		}
+		switch awaitEvent(ctx, wake, deadline) {
+		case waitCancelled:
+			L.RaiseError("script cancelled")
+			return 0
+		case waitTimedOut:
+			L.Push(lua.LBool(false))
+			return 1
+		}
+		se.lastYieldNS.Store(time.Now().UnixNano())
 	}
-	return frame, w, h
-}
-
-func frameHash(frame []byte) uint32 {
-	h := fnv.New32a()
-	_, _ = h.Write(frame)
-	return h.Sum32()
 }
 
 func clamp8(v int) int {
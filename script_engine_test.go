@@ -2,6 +2,7 @@ package main
 
 import (
 	"bytes"
+	"fmt"
 	"image/png"
 	"os"
 	"os/exec"
@@ -1760,6 +1761,85 @@ func TestScriptEngine_VideoWaitPixelTimeout(t *testing.T) {
 	}
 }
 
+func TestScriptEngine_VisualWaitTimesOutWithoutFrames(t *testing.T) {
+	se := NewScriptEngine(NewMachineBus(), NewVideoCompositor(nil), NewTerminalMMIO())
+	script := `
+		if video.wait_stable(2, 30) then error("expected timeout") end
+		if video.wait_condition(function() return false end, 30) then error("expected timeout") end
+	`
+	if err := se.RunString(script, "visual_wait_no_frames"); err != nil {
+		t.Fatalf("RunString failed: %v", err)
+	}
+	// No frames are driven: the deadline alone must end both waits.
+	waitScriptStoppedWithin(t, se, time.Second)
+	if err := se.LastError(); err != nil {
+		t.Fatalf("script error: %v", err)
+	}
+}
+
+func TestScriptEngine_WaitFramesCountsOnlyNewFrames(t *testing.T) {
+	se := NewScriptEngine(NewMachineBus(), NewVideoCompositor(nil), NewTerminalMMIO())
+	se.onFrameComplete() // completed before the script starts; must not count
+	if err := se.RunString(`
+		local before = sys.frame_count()
+		sys.wait_frames(2)
+		if sys.frame_count() - before < 2 then error("returned early") end
+	`, "wait_frames_new_only"); err != nil {
+		t.Fatalf("RunString failed: %v", err)
+	}
+	driveFramesUntilStopped(t, se)
+	if err := se.LastError(); err != nil {
+		t.Fatalf("script error: %v", err)
+	}
+}
+
+func TestScriptEngine_TermWaitOutputWakesOnOutput(t *testing.T) {
+	term := NewTerminalMMIO()
+	se := NewScriptEngine(NewMachineBus(), NewVideoCompositor(nil), term)
+	if err := se.RunString(`
+		if not term.wait_output("READY", 5000) then error("timed out") end
+	`, "wait_output_event"); err != nil {
+		t.Fatalf("RunString failed: %v", err)
+	}
+	time.Sleep(10 * time.Millisecond)
+	start := time.Now()
+	for _, ch := range []byte("boot... READY\n") {
+		term.HandleWrite(TERM_OUT, uint32(ch))
+	}
+	waitScriptStoppedWithin(t, se, time.Second)
+	if err := se.LastError(); err != nil {
+		t.Fatalf("script error: %v", err)
+	}
+	if took := time.Since(start); took > 500*time.Millisecond {
+		t.Fatalf("wait_output returned %v after output", took)
+	}
+}
+
+func TestScriptEngine_RegionHashAndWait(t *testing.T) {
+	comp := NewVideoCompositor(nil)
+	comp.SetDimensions(4, 4)
+	src := &scriptTestSource{w: 4, h: 4, enabled: true, frame: solidTestFrame(4, 4, 0, 0, 255, 255)}
+	comp.RegisterSource(src)
+	comp.composite()
+	want, _ := comp.RegionDigest(1, 1, 2, 2)
+
+	se := NewScriptEngine(NewMachineBus(), comp, NewTerminalMMIO())
+	script := fmt.Sprintf(`
+		local h = video.region_hash(1, 1, 2, 2)
+		if h ~= "%016x" then error("region_hash " .. h) end
+		if #video.region_hash() ~= 16 then error("whole-frame hash") end
+		if not video.wait_region_hash(1, 1, 2, 2, h, 500) then error("wait_region_hash") end
+		if video.wait_region_hash(1, 1, 2, 2, "0000000000000000", 30) then error("expected timeout") end
+	`, want)
+	if err := se.RunString(script, "region_hash"); err != nil {
+		t.Fatalf("RunString failed: %v", err)
+	}
+	waitScriptStoppedWithin(t, se, 2*time.Second)
+	if err := se.LastError(); err != nil {
+		t.Fatalf("script error: %v", err)
+	}
+}
+
 func TestScriptEngine_CoprocEnqueuePollWait(t *testing.T) {
 	bus := NewMachineBus()
 	term := NewTerminalMMIO()
@@ -3264,3 +3344,192 @@ func TestScript_MediaType_MODAndWAV(t *testing.T) {
 		})
 	}
 }
+
+func TestScriptChunkCache_ReusesCompiledChunks(t *testing.T) {
+	c := &luaChunkCache{}
+	a, err := c.compile("return 1", "<string>")
+	if err != nil {
+		t.Fatalf("compile: %v", err)
+	}
+	if b, _ := c.compile("return 1", "<string>"); b != a {
+		t.Fatal("identical source recompiled")
+	}
+	if b, _ := c.compile("return 1", "other"); b == a {
+		t.Fatal("chunk name ignored in cache key")
+	}
+	if _, err := c.compile("return (", "<string>"); err == nil {
+		t.Fatal("syntax error not reported")
+	}
+
+	path := filepath.Join(t.TempDir(), "mod.lua")
+	if err := os.WriteFile(path, []byte("return 1"), 0644); err != nil {
+		t.Fatal(err)
+	}
+	f1, err := c.compileFile(path, path)
+	if err != nil {
+		t.Fatalf("compileFile: %v", err)
+	}
+	if f2, _ := c.compileFile(path, path); f2 != f1 {
+		t.Fatal("unchanged file recompiled")
+	}
+	if err := os.WriteFile(path, []byte("return 22"), 0644); err != nil {
+		t.Fatal(err)
+	}
+	if f3, _ := c.compileFile(path, path); f3 == f1 {
+		t.Fatal("edited file served from cache")
+	}
+}
+
+func TestScriptEngine_WarmStateIsFreshPerRun(t *testing.T) {
+	se := NewScriptEngine(NewMachineBus(), NewVideoCompositor(nil), NewTerminalMMIO())
+	for i, script := range []string{
+		`leaked = 1`,
+		`if leaked ~= nil then error("global survived into the next run") end`,
+		`if leaked ~= nil then error("global survived into the next run") end`,
+	} {
+		if err := se.RunString(script, "warm_state"); err != nil {
+			t.Fatalf("run %d: RunString failed: %v", i, err)
+		}
+		waitScriptStopped(t, se)
+		if err := se.LastError(); err != nil {
+			t.Fatalf("run %d: %v", i, err)
+		}
+	}
+}
+
+// BenchmarkScriptEngine_RunStringStartup measures script start-to-finish for
+// a trivial script, which is dominated by startup.
+func BenchmarkScriptEngine_RunStringStartup(b *testing.B) {
+	se := NewScriptEngine(NewMachineBus(), NewVideoCompositor(nil), NewTerminalMMIO())
+	b.ReportAllocs()
+	for range b.N {
+		if err := se.RunString(`local x = 1`, "startup"); err != nil {
+			b.Fatal(err)
+		}
+		if done := se.Done(); done != nil {
+			<-done
+		}
+	}
+}
+
+func TestScriptEngine_MemViewBulkOps(t *testing.T) {
+	bus := NewMachineBus()
+	se := NewScriptEngine(bus, NewVideoCompositor(nil), NewTerminalMMIO())
+
+	err := se.RunString(`
+		local function check(cond, msg) if not cond then error(msg, 2) end end
+		cpu.freeze()
+		mem.write_block(0x4000, "\1\2\3\4HELLO\0HELLO")
+		local v = mem.view(0x4000, 16)
+		check(#v == 16 and v:addr() == 0x4000, "len/addr")
+		check(v:u32(0) == 0x04030201 and v:u32be(0) == 0x01020304, "u32")
+		check(v:u16(1) == 0x0302 and v:u8(4) == 0x48, "u16/u8")
+		check(v:find("HELLO") == 4 and v:find("HELLO", 5) == 10, "find")
+		check(v:find("nope") == nil, "find miss")
+		local all = v:find_all("HELLO")
+		check(#all == 2 and all[2] == 10, "find_all")
+		check(v:sub(4, 5):bytes() == "HELLO", "sub")
+		check(v:sub(4, 5):equal(v:sub(10, 5)), "equal")
+		check(v:checksum() == 0x27DB0814, "crc32")
+
+		local before = v:snapshot()
+		check(not before:is_live(), "snapshot detached")
+		v:write(5, "A")
+		v:fill(0xFF, 14, 2)
+		local n, first = v:compare(before)
+		check(n == 3 and first == 5, "compare " .. n .. " " .. tostring(first))
+		local d = v:diff(before)
+		check(#d == 3 and d[1].offset == 5 and d[1].val1 == 0x41 and d[1].val2 == 0x45, "diff")
+		check(mem.read8(0x4005) == 0x41, "write through")
+		cpu.resume()
+		check(before:bytes(4, 5) == "HELLO", "snapshot readable unfrozen")
+		local ok = pcall(function() return v:bytes() end)
+		check(not ok, "live view must require freeze")
+	`, "memview")
+	if err != nil {
+		t.Fatalf("RunString failed: %v", err)
+	}
+	waitScriptStopped(t, se)
+	if err := se.LastError(); err != nil {
+		t.Fatalf("script error: %v", err)
+	}
+}
+
+func TestScriptEngine_MemViewWriteOverlap(t *testing.T) {
+	bus := NewMachineBus()
+	se := NewScriptEngine(bus, NewVideoCompositor(nil), NewTerminalMMIO())
+
+	err := se.RunString(`
+		local function check(cond, msg) if not cond then error(msg, 2) end end
+		cpu.freeze()
+		mem.write_block(0x4000, "0123456789ABCDEF")
+		local v = mem.view(0x4000, 16)
+		v:write(1, v:sub(0, 15))
+		check(v:bytes() == "00123456789ABCDE", "forward overlap " .. v:bytes())
+		v:write(0, v:sub(1, 15))
+		check(v:bytes() == "0123456789ABCDEE", "backward overlap " .. v:bytes())
+		cpu.resume()
+	`, "memview-overlap")
+	if err != nil {
+		t.Fatalf("RunString failed: %v", err)
+	}
+	waitScriptStopped(t, se)
+	if err := se.LastError(); err != nil {
+		t.Fatalf("script error: %v", err)
+	}
+}
+
+func TestScriptEngine_DbgRegsSnapshot(t *testing.T) {
+	bus := NewMachineBus()
+	se := NewScriptEngine(bus, NewVideoCompositor(nil), NewTerminalMMIO())
+	mon := NewMachineMonitor(bus)
+	cpu := NewCPU(bus)
+	mon.RegisterCPU("IE32", NewDebugIE32(cpu))
+	se.SetMonitor(mon)
+
+	err := se.RunString(`
+		local function check(cond, msg) if not cond then error(msg, 2) end end
+		dbg.open()
+		dbg.set_pc(0x1000)
+		local a = dbg.regs_snapshot()
+		check(#a > 0 and a.PC == 0x1000 and a.pc == 0x1000, "index")
+		check(a.get == nil and a.nosuchreg == nil, "unknown")
+		dbg.set_pc(0x2000)
+		local b = dbg.regs_snapshot()
+		local d = a:diff(b)
+		check(d.PC == 0x2000, "diff pc")
+		local n = 0
+		for _ in pairs(d) do n = n + 1 end
+		check(n == 1, "diff size " .. n)
+		check(b:table().PC == 0x2000 and #b:names() == #b, "table/names")
+		dbg.close()
+	`, "regsnap")
+	if err != nil {
+		t.Fatalf("RunString failed: %v", err)
+	}
+	waitScriptStopped(t, se)
+	if err := se.LastError(); err != nil {
+		t.Fatalf("script error: %v", err)
+	}
+}
+
+// BenchmarkScriptMemBuf_Compare16MB compares two 16 MiB guest ranges from
+// script through membuf views.
+func BenchmarkScriptMemBuf_Compare16MB(b *testing.B) {
+	bus, err := NewMachineBusSized(48 << 20)
+	if err != nil {
+		b.Fatal(err)
+	}
+	se := NewScriptEngine(bus, NewVideoCompositor(nil), NewTerminalMMIO())
+	se.freezeCount.Store(1)
+	st := se.newScriptState()
+	defer st.L.Close()
+	bus.memory[0x2000000+(8<<20)] = 1
+	b.SetBytes(16 << 20)
+	for range b.N {
+		if err := st.L.DoString(`local n = mem.view(0x1000000, 0x1000000):compare(mem.view(0x2000000, 0x1000000))
+			if n ~= 1 then error("diff count " .. n) end`); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
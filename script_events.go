@@ -0,0 +1,83 @@
+// script_events.go - Broadcast wake-ups for event-driven script waits
+
+/*
+Script waits (sys.wait_frames, video.wait_*, term.wait_output) block on
+notifications instead of polling on timers:
+
+  - eventSignal is a broadcast edge. wait() hands out a channel that the next
+    fire() closes, so any number of waiters wake on the same event and no
+    stale token can satisfy a later wait.
+  - The compositor records per-row damage as it composes each frame
+    (VideoCompositor.DamageSince), so pixel and stability waits only re-read
+    the frame when the rows they watch changed instead of copying and hashing
+    the whole frame every frame.
+  - TerminalMMIO.OutputReady closes when TERM_OUT bytes are buffered.
+
+A wait returns on its event, its deadline or script cancellation, whichever
+comes first; it never spins.
+*/
+
+package main
+
+import (
+	"context"
+	"sync"
+	"time"
+)
+
+type eventSignal struct {
+	mu sync.Mutex
+	ch chan struct{}
+}
+
+// wait returns a channel closed by the next fire.
+func (s *eventSignal) wait() <-chan struct{} {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if s.ch == nil {
+		s.ch = make(chan struct{})
+	}
+	return s.ch
+}
+
+// fire wakes every current waiter. It costs nothing when nobody waits.
+func (s *eventSignal) fire() {
+	s.mu.Lock()
+	if s.ch != nil {
+		close(s.ch)
+		s.ch = nil
+	}
+	s.mu.Unlock()
+}
+
+// waitResult is how an awaitEvent call ended.
+type waitResult int
+
+const (
+	waitFired waitResult = iota
+	waitTimedOut
+	waitCancelled
+)
+
+// awaitEvent blocks until ch closes, deadline passes (zero means none) or
+// ctx is cancelled.
+func awaitEvent(ctx context.Context, ch <-chan struct{}, deadline time.Time) waitResult {
+	var timeout <-chan time.Time
+	if !deadline.IsZero() {
+		d := time.Until(deadline)
+		if d <= 0 {
+			return waitTimedOut
+		}
+		timer := time.NewTimer(d)
+		defer timer.Stop()
+		timeout = timer.C
+	}
+	select {
+	case <-ctx.Done():
+		return waitCancelled
+	case <-ch:
+		return waitFired
+	case <-timeout:
+		return waitTimedOut
+	}
+}
@@ -0,0 +1,528 @@
+// script_membuf.go - Bulk memory views and register snapshots for scripts
+
+/*
+mem.view(addr, len) returns a membuf: a userdata view of a guest bus range.
+Slicing, typed reads, searching, comparing and checksumming run in Go over
+the guest RAM slice itself, so scripts can work on megabytes without
+creating one Lua value per byte. A live view reads guest memory at the time
+of each call and follows the same freeze rule as mem.*; ranges that touch
+MMIO pages are read through the bus instead. buf:snapshot() detaches a copy
+for before/after diffs.
+
+dbg.regs_snapshot() captures the focussed CPU's register file as a regsnap
+userdata indexed by register name, replacing a fresh table per call with
+one lookup structure that can be diffed against another snapshot.
+*/
+
+package main
+
+import (
+	"bytes"
+	"encoding/binary"
+	"fmt"
+	"hash/adler32"
+	"hash/crc32"
+	"hash/fnv"
+	"strings"
+
+	lua "github.com/yuin/gopher-lua"
+)
+
+const (
+	luaMemBufType  = "membuf"
+	luaRegSnapType = "regsnap"
+
+	memBufDiffLimit = 256 // default entry cap for buf:diff
+)
+
+// scriptMemBuf is a view of len bytes at a bus address, or a detached copy.
+type scriptMemBuf struct {
+	se       *ScriptEngine
+	addr     uint32
+	n        int
+	data     []byte
+	detached bool
+}
+
+// registerBufferTypes installs the membuf and regsnap metatables in L.
+func (se *ScriptEngine) registerBufferTypes(L *lua.LState) {
+	mt := L.NewTypeMetatable(luaMemBufType)
+	L.SetField(mt, "__index", L.SetFuncs(L.NewTable(), map[string]lua.LGFunction{
+		"len":      memBufLen,
+		"addr":     memBufAddr,
+		"sub":      memBufSub,
+		"u8":       memBufReader(1, false),
+		"u16":      memBufReader(2, false),
+		"u32":      memBufReader(4, false),
+		"u16be":    memBufReader(2, true),
+		"u32be":    memBufReader(4, true),
+		"find":     memBufFind,
+		"find_all": memBufFindAll,
+		"compare":  memBufCompare,
+		"diff":     memBufDiff,
+		"equal":    memBufEqual,
+		"checksum": memBufChecksum,
+		"bytes":    memBufBytes,
+		"snapshot": memBufSnapshot,
+		"write":    memBufWrite,
+		"fill":     memBufFill,
+		"is_live":  memBufIsLive,
+	}))
+	L.SetField(mt, "__len", L.NewFunction(memBufLen))
+	L.SetField(mt, "__tostring", L.NewFunction(func(L *lua.LState) int {
+		b := checkMemBuf(L, 1)
+		kind := "view"
+		if b.detached {
+			kind = "snapshot"
+		}
+		L.Push(lua.LString(fmt.Sprintf("membuf(%s 0x%08X+%d)", kind, b.addr, b.n)))
+		return 1
+	}))
+
+	rt := L.NewTypeMetatable(luaRegSnapType)
+	methods := L.SetFuncs(L.NewTable(), map[string]lua.LGFunction{
+		"names": regSnapNames,
+		"diff":  regSnapDiff,
+		"table": regSnapTable,
+	})
+	L.SetField(rt, "__index", L.NewFunction(func(L *lua.LState) int {
+		s := checkRegSnap(L, 1)
+		key := L.CheckString(2)
+		if m := methods.RawGetString(key); m != lua.LNil {
+			L.Push(m)
+			return 1
+		}
+		if v, ok := s.get(key); ok {
+			L.Push(lua.LNumber(v))
+			return 1
+		}
+		L.Push(lua.LNil)
+		return 1
+	}))
+	L.SetField(rt, "__len", L.NewFunction(func(L *lua.LState) int {
+		L.Push(lua.LNumber(len(checkRegSnap(L, 1).regs)))
+		return 1
+	}))
+}
+
+func pushMemBuf(L *lua.LState, b *scriptMemBuf) {
+	ud := L.NewUserData()
+	ud.Value = b
+	L.SetMetatable(ud, L.GetTypeMetatable(luaMemBufType))
+	L.Push(ud)
+}
+
+func checkMemBuf(L *lua.LState, n int) *scriptMemBuf {
+	if ud, ok := L.Get(n).(*lua.LUserData); ok {
+		if b, ok := ud.Value.(*scriptMemBuf); ok {
+			return b
+		}
+	}
+	L.ArgError(n, "membuf expected")
+	return nil
+}
+
+// bytes returns the buffer contents: the detached copy, the guest RAM
+// slice itself when the range is plain RAM, or a copy read through the bus.
+// The result must not be retained past the current call for live views.
+func (b *scriptMemBuf) bytes(L *lua.LState) []byte {
+	if b.detached || b.n == 0 {
+		return b.data
+	}
+	if !b.se.requireFrozenForRange(L, b.addr, uint32(b.n)) {
+		return nil
+	}
+	if span := b.se.bus.RAMSpan(b.addr, b.n); span != nil {
+		return span
+	}
+	out := make([]byte, b.n)
+	for i := range out {
+		out[i] = b.se.bus.Read8(b.addr + uint32(i))
+	}
+	return out
+}
+
+// byteArg reads argument n as a Lua string or membuf.
+func byteArg(L *lua.LState, n int) []byte {
+	switch v := L.Get(n).(type) {
+	case lua.LString:
+		return []byte(string(v))
+	case *lua.LUserData:
+		if b, ok := v.Value.(*scriptMemBuf); ok {
+			return b.bytes(L)
+		}
+	}
+	L.ArgError(n, "string or membuf expected")
+	return nil
+}
+
+// rangeArgs reads an optional [off [, len]] pair starting at argument n,
+// defaulting to the whole buffer, and checks it lies inside.
+func (b *scriptMemBuf) rangeArgs(L *lua.LState, n int) (int, int) {
+	off := L.OptInt(n, 0)
+	length := L.OptInt(n+1, b.n-off)
+	if off < 0 || length < 0 || off+length > b.n {
+		L.ArgError(n, fmt.Sprintf("range %d+%d outside membuf of %d bytes", off, length, b.n))
+	}
+	return off, length
+}
+
+func (se *ScriptEngine) luaMemView() lua.LGFunction {
+	return func(L *lua.LState) int {
+		addr := uint32(L.CheckInt64(1))
+		n := L.CheckInt(2)
+		if n < 0 {
+			L.ArgError(2, "must be >= 0")
+			return 0
+		}
+		pushMemBuf(L, &scriptMemBuf{se: se, addr: addr, n: n})
+		return 1
+	}
+}
+
+func memBufLen(L *lua.LState) int {
+	L.Push(lua.LNumber(checkMemBuf(L, 1).n))
+	return 1
+}
+
+func memBufAddr(L *lua.LState) int {
+	L.Push(lua.LNumber(checkMemBuf(L, 1).addr))
+	return 1
+}
+
+func memBufIsLive(L *lua.LState) int {
+	L.Push(lua.LBool(!checkMemBuf(L, 1).detached))
+	return 1
+}
+
+func memBufSub(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	off, length := b.rangeArgs(L, 2)
+	sub := &scriptMemBuf{se: b.se, addr: b.addr + uint32(off), n: length, detached: b.detached}
+	if b.detached {
+		sub.data = b.data[off : off+length]
+	}
+	pushMemBuf(L, sub)
+	return 1
+}
+
+// memBufReader returns a typed read of size bytes at a buffer offset.
+func memBufReader(size int, bigEndian bool) lua.LGFunction {
+	return func(L *lua.LState) int {
+		b := checkMemBuf(L, 1)
+		off := L.CheckInt(2)
+		if off < 0 || off+size > b.n {
+			L.ArgError(2, fmt.Sprintf("offset %d outside membuf of %d bytes", off, b.n))
+			return 0
+		}
+		var raw [4]byte
+		if b.detached {
+			copy(raw[:], b.data[off:off+size])
+		} else {
+			addr := b.addr + uint32(off)
+			if !b.se.requireFrozenForRange(L, addr, uint32(size)) {
+				return 0
+			}
+			for i := range size {
+				raw[i] = b.se.bus.Read8(addr + uint32(i))
+			}
+		}
+		var v uint32
+		switch {
+		case size == 1:
+			v = uint32(raw[0])
+		case size == 2 && bigEndian:
+			v = uint32(binary.BigEndian.Uint16(raw[:]))
+		case size == 2:
+			v = uint32(binary.LittleEndian.Uint16(raw[:]))
+		case bigEndian:
+			v = binary.BigEndian.Uint32(raw[:])
+		default:
+			v = binary.LittleEndian.Uint32(raw[:])
+		}
+		L.Push(lua.LNumber(v))
+		return 1
+	}
+}
+
+func memBufFind(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	pat := byteArg(L, 2)
+	from := L.OptInt(3, 0)
+	data := b.bytes(L)
+	if len(pat) == 0 || from < 0 || from > len(data) {
+		L.Push(lua.LNil)
+		return 1
+	}
+	if i := bytes.Index(data[from:], pat); i >= 0 {
+		L.Push(lua.LNumber(from + i))
+		return 1
+	}
+	L.Push(lua.LNil)
+	return 1
+}
+
+func memBufFindAll(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	pat := byteArg(L, 2)
+	limit := L.OptInt(3, 0)
+	out := L.NewTable()
+	data := b.bytes(L)
+	if len(pat) == 0 {
+		L.Push(out)
+		return 1
+	}
+	for at, count := 0, 0; limit <= 0 || count < limit; count++ {
+		i := bytes.Index(data[at:], pat)
+		if i < 0 {
+			break
+		}
+		out.Append(lua.LNumber(at + i))
+		at += i + 1
+	}
+	L.Push(out)
+	return 1
+}
+
+// compareBytes counts differing bytes between a and b, treating bytes past
+// the shorter one as different, and returns the first differing offset or
+// -1. Equal 4 KiB chunks are skipped with one memcmp each.
+func compareBytes(a, b []byte) (int, int) {
+	n := min(len(a), len(b))
+	count := max(len(a), len(b)) - n
+	first := -1
+	const chunk = 4096
+	for off := 0; off < n; off += chunk {
+		end := min(off+chunk, n)
+		if bytes.Equal(a[off:end], b[off:end]) {
+			continue
+		}
+		for i := off; i < end; i++ {
+			if a[i] != b[i] {
+				if first < 0 {
+					first = i
+				}
+				count++
+			}
+		}
+	}
+	if first < 0 && count > 0 {
+		first = n
+	}
+	return count, first
+}
+
+func memBufCompare(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	other := byteArg(L, 2)
+	count, first := compareBytes(b.bytes(L), other)
+	L.Push(lua.LNumber(count))
+	if first < 0 {
+		L.Push(lua.LNil)
+	} else {
+		L.Push(lua.LNumber(first))
+	}
+	return 2
+}
+
+func memBufDiff(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	other := byteArg(L, 2)
+	limit := L.OptInt(3, memBufDiffLimit)
+	data := b.bytes(L)
+	out := L.NewTable()
+	n := min(len(data), len(other))
+	const chunk = 4096
+	for off := 0; off < n && out.Len() < limit; off += chunk {
+		end := min(off+chunk, n)
+		if bytes.Equal(data[off:end], other[off:end]) {
+			continue
+		}
+		for i := off; i < end && out.Len() < limit; i++ {
+			if data[i] != other[i] {
+				e := L.NewTable()
+				e.RawSetString("offset", lua.LNumber(i))
+				e.RawSetString("val1", lua.LNumber(data[i]))
+				e.RawSetString("val2", lua.LNumber(other[i]))
+				out.Append(e)
+			}
+		}
+	}
+	L.Push(out)
+	return 1
+}
+
+func memBufEqual(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	L.Push(lua.LBool(bytes.Equal(b.bytes(L), byteArg(L, 2))))
+	return 1
+}
+
+func memBufChecksum(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	algo := L.OptString(2, "crc32")
+	data := b.bytes(L)
+	var sum uint32
+	switch algo {
+	case "crc32":
+		sum = crc32.ChecksumIEEE(data)
+	case "adler32":
+		sum = adler32.Checksum(data)
+	case "fnv1a":
+		h := fnv.New32a()
+		_, _ = h.Write(data)
+		sum = h.Sum32()
+	default:
+		L.ArgError(2, "checksum must be crc32, adler32 or fnv1a")
+		return 0
+	}
+	L.Push(lua.LNumber(sum))
+	return 1
+}
+
+func memBufBytes(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	off, length := b.rangeArgs(L, 2)
+	L.Push(lua.LString(string(b.bytes(L)[off : off+length])))
+	return 1
+}
+
+func memBufSnapshot(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	data := append([]byte(nil), b.bytes(L)...)
+	if data == nil {
+		data = []byte{}
+	}
+	pushMemBuf(L, &scriptMemBuf{se: b.se, addr: b.addr, n: b.n, data: data, detached: true})
+	return 1
+}
+
+// memBufWrite stores a string or membuf at an offset. Live views write
+// through the bus so MMIO, debug hooks and JIT invalidation still apply.
+func memBufWrite(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	off := L.CheckInt(2)
+	src := byteArg(L, 3)
+	if off < 0 || off+len(src) > b.n {
+		L.ArgError(2, fmt.Sprintf("write of %d bytes at %d outside membuf of %d bytes", len(src), off, b.n))
+		return 0
+	}
+	if b.detached {
+		copy(b.data[off:], src)
+		return 0
+	}
+	addr := b.addr + uint32(off)
+	if !b.se.requireFrozenForRange(L, addr, uint32(len(src))) {
+		return 0
+	}
+	// A live source view can alias the destination; copy it first so
+	// overlapping writes such as v:write(1, v:sub(0, 15)) act as memmove.
+	if ud, ok := L.Get(3).(*lua.LUserData); ok {
+		if sb, ok := ud.Value.(*scriptMemBuf); ok && !sb.detached {
+			src = append([]byte(nil), src...)
+		}
+	}
+	for i, v := range src {
+		b.se.bus.Write8(addr+uint32(i), v)
+	}
+	return 0
+}
+
+func memBufFill(L *lua.LState) int {
+	b := checkMemBuf(L, 1)
+	val := uint8(L.CheckInt(2))
+	off, length := b.rangeArgs(L, 3)
+	if b.detached {
+		for i := off; i < off+length; i++ {
+			b.data[i] = val
+		}
+		return 0
+	}
+	addr := b.addr + uint32(off)
+	if !b.se.requireFrozenForRange(L, addr, uint32(length)) {
+		return 0
+	}
+	for i := range length {
+		b.se.bus.Write8(addr+uint32(i), val)
+	}
+	return 0
+}
+
+// scriptRegSnap is a captured register file.
+type scriptRegSnap struct {
+	regs  []RegisterInfo
+	index map[string]int // upper-cased name -> regs index
+}
+
+func (s *scriptRegSnap) get(name string) (uint64, bool) {
+	if s.index == nil {
+		s.index = make(map[string]int, len(s.regs))
+		for i, r := range s.regs {
+			s.index[strings.ToUpper(r.Name)] = i
+		}
+	}
+	i, ok := s.index[strings.ToUpper(name)]
+	if !ok {
+		return 0, false
+	}
+	return s.regs[i].Value, true
+}
+
+func checkRegSnap(L *lua.LState, n int) *scriptRegSnap {
+	if ud, ok := L.Get(n).(*lua.LUserData); ok {
+		if s, ok := ud.Value.(*scriptRegSnap); ok {
+			return s
+		}
+	}
+	L.ArgError(n, "regsnap expected")
+	return nil
+}
+
+func (se *ScriptEngine) luaDbgRegsSnapshot() lua.LGFunction {
+	return func(L *lua.LState) int {
+		s := &scriptRegSnap{}
+		if _, cpu, err := se.getMonitorAndCPU(); err == nil {
+			s.regs = cpu.GetRegisters()
+		}
+		ud := L.NewUserData()
+		ud.Value = s
+		L.SetMetatable(ud, L.GetTypeMetatable(luaRegSnapType))
+		L.Push(ud)
+		return 1
+	}
+}
+
+func regSnapNames(L *lua.LState) int {
+	s := checkRegSnap(L, 1)
+	out := L.CreateTable(len(s.regs), 0)
+	for _, r := range s.regs {
+		out.Append(lua.LString(r.Name))
+	}
+	L.Push(out)
+	return 1
+}
+
+// regSnapDiff returns {name = new_value} for registers whose value differs
+// in the other snapshot (or that only it has).
+func regSnapDiff(L *lua.LState) int {
+	s := checkRegSnap(L, 1)
+	other := checkRegSnap(L, 2)
+	out := L.NewTable()
+	for _, r := range other.regs {
+		if v, ok := s.get(r.Name); !ok || v != r.Value {
+			out.RawSetString(r.Name, lua.LNumber(r.Value))
+		}
+	}
+	L.Push(out)
+	return 1
+}
+
+func regSnapTable(L *lua.LState) int {
+	s := checkRegSnap(L, 1)
+	out := L.CreateTable(0, len(s.regs))
+	for _, r := range s.regs {
+		out.RawSetString(r.Name, lua.LNumber(r.Value))
+	}
+	L.Push(out)
+	return 1
+}
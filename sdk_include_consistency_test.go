@@ -87,6 +87,7 @@ func TestSDKInclude_32BitConstantParity(t *testing.T) {
 		"SID_PLUS_CTRL":        SID_PLUS_CTRL,
 		"TED_PLUS_CTRL":        TED_PLUS_CTRL,
 		"AHX_PLUS_CTRL":        AHX_PLUS_CTRL,
+		"AUDIO_PLUS_BANDLIMIT": AUDIO_PLUS_BANDLIMIT,
 		"FLEX_CH_BASE":         FLEX_CH_BASE,
 		"FLEX_CH_STRIDE":       FLEX_CH_STRIDE,
 		"FLEX_CH3_BASE":        FLEX_CH3_BASE,
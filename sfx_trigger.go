@@ -109,6 +109,24 @@ func (s *SFXTrigger) TickSample() {
 	s.mixMu.Unlock()
 }
 
+// RenderMixBlock ticks the channels len(out) times, storing each mixed
+// sample, so ReadSamples can render the SFX block on a mix worker.
+func (s *SFXTrigger) RenderMixBlock(out []float32) {
+	if len(out) == 0 {
+		return
+	}
+	for j := range out {
+		var mixed float32
+		for i := range s.channels {
+			mixed += s.tickChannel(&s.channels[i])
+		}
+		out[j] = clampF32(mixed, MIN_SAMPLE, MAX_SAMPLE)
+	}
+	s.mixMu.Lock()
+	s.mix = out[len(out)-1]
+	s.mixMu.Unlock()
+}
+
 func (s *SFXTrigger) MixSample() float32 {
 	s.mixMu.Lock()
 	defer s.mixMu.Unlock()
@@ -321,4 +339,7 @@ func (c *sfxChannel) bytesPerSampleLocked() int {
 	return 1
 }
 
-var _ SampleTicker = (*SFXTrigger)(nil)
+var (
+	_ SampleTicker        = (*SFXTrigger)(nil)
+	_ SampleBlockRenderer = (*SFXTrigger)(nil)
+)
@@ -24,6 +24,14 @@ type SID6502Player struct {
 	eventBuffer      []SIDEvent // Pre-allocated buffer for frame events (zero-allocation path)
 	instructionCount uint64
 	cpuExecNanos     uint64
+
+	// Idiom fusion (cpu_6502_fusion.go): fuse enables stepFused,
+	// fusionLimit bounds the cycles the current instruction may take
+	// before the run loop must look again, and a non-nil profile mines
+	// sequences instead (cpu_6502_fusion_profile.go).
+	fuse        bool
+	fusionLimit int
+	profile     *fusion6502Profile
 }
 
 // maxEventsPerFrame is the initial capacity for the event buffer.
@@ -71,6 +79,7 @@ func newSID6502Player(file *SIDFile, subsong, sampleRate int) (*SID6502Player, e
 		interruptMode:    interruptMode,
 		sampleMultiplier: sampleMultiplier,
 		eventBuffer:      make([]SIDEvent, 0, maxSIDEventsPerFrame),
+		fuse:             true,
 	}
 
 	player.cpu = player.createCPU()
@@ -199,6 +208,7 @@ func (p *SID6502Player) callRoutine(addr uint16, aReg uint8) error {
 		if p.cpu.PC == returnAddr {
 			break
 		}
+		p.fusionLimit = int(maxCycles - (p.cpu.Cycles - startCycles))
 		p.executeInstruction()
 	}
 
@@ -206,9 +216,25 @@ func (p *SID6502Player) callRoutine(addr uint16, aReg uint8) error {
 }
 
 func (p *SID6502Player) executeInstruction() {
+	if p.profile != nil {
+		p.profile.observe(&p.bus.ram, p.cpu.PC) // needs every instruction: no fusion
+	} else if p.fuse {
+		if n := p.cpu.stepFused(p.bus, p.fusionLimit); n > 0 {
+			p.instructionCount += uint64(n)
+			for _, cycles := range p.cpu.fusedCycles[:n] {
+				p.bus.AddCycles(int(cycles))
+			}
+			p.syncIRQ()
+			return
+		}
+	}
 	p.instructionCount++
 	cycles := p.cpu.Step()
 	p.bus.AddCycles(cycles)
+	p.syncIRQ()
+}
+
+func (p *SID6502Player) syncIRQ() {
 	if p.bus.irqPending {
 		p.cpu.irqPending.Store(true)
 		p.bus.irqPending = false
@@ -270,6 +296,7 @@ func (p *SID6502Player) runForCycles(target uint64) {
 	start := time.Now()
 	defer func() { p.cpuExecNanos += uint64(time.Since(start).Nanoseconds()) }()
 	for p.bus.GetFrameCycles() < target && p.cpu.Running() {
+		p.fusionLimit = int(target - p.bus.GetFrameCycles())
 		p.executeInstruction()
 	}
 }
@@ -297,6 +324,10 @@ func (p *SID6502Player) GetTotalCycles() uint64 {
 	return p.totalCycles
 }
 
+func (p *SID6502Player) renderPerf() (uint64, uint64) {
+	return p.instructionCount, p.cpuExecNanos
+}
+
 func (p *SID6502Player) Reset() {
 	p.bus.Reset()
 	p.totalCycles = 0
@@ -45,6 +45,8 @@ type SIDEngine struct {
 	loop           bool
 	loopSample     uint64
 	loopEventIndex int
+	stream         *musicEventStream[SIDEvent] // streaming render source (nil for pre-rendered events)
+	streamPass     uint32
 	playing        bool
 	debugEnabled   bool
 	debugUntil     uint64
@@ -911,6 +913,7 @@ func (e *SIDEngine) Reset() {
 	e.enabled.Store(false)
 	e.channelsInit = false
 	e.playing = false
+	e.closeStreamLocked()
 	e.events = nil
 	e.eventIndex = 0
 	e.currentSample = 0
@@ -932,6 +935,8 @@ func (e *SIDEngine) SetEvents(events []SIDEvent, totalSamples uint64, loop bool,
 	e.mutex.Lock()
 	defer e.mutex.Unlock()
 
+	e.closeStreamLocked()
+
 	if cap(e.events) < len(events) {
 		e.events = make([]SIDEvent, len(events))
 	} else {
@@ -950,6 +955,47 @@ func (e *SIDEngine) SetEvents(events []SIDEvent, totalSamples uint64, loop bool,
 	e.enabled.Store(true)
 }
 
+// SetEventStream starts playback from a background render stream instead of a
+// pre-rendered event slice. The engine takes ownership of the stream.
+func (e *SIDEngine) SetEventStream(stream *musicEventStream[SIDEvent], totalSamples uint64, loop bool, loopSample uint64) {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+
+	e.closeStreamLocked()
+	e.stream = stream
+	e.streamPass = 0
+	e.events = nil
+	e.eventIndex = 0
+	e.currentSample = 0
+	e.totalSamples = totalSamples
+	e.loop = loop
+	e.loopSample = loopSample
+	e.loopEventIndex = 0
+	e.enabled.Store(true)
+}
+
+func (e *SIDEngine) closeStreamLocked() {
+	if e.stream != nil {
+		e.stream.Close()
+		e.stream = nil
+	}
+}
+
+// refillFromStreamLocked swaps in the next streamed chunk once the current
+// one is consumed. Returns false when the producer has nothing ready yet.
+func (e *SIDEngine) refillFromStreamLocked() bool {
+	if e.stream == nil || e.eventIndex < len(e.events) {
+		return false
+	}
+	chunk, ok := e.stream.next(e.streamPass)
+	if !ok {
+		return false
+	}
+	e.events = chunk
+	e.eventIndex = 0
+	return true
+}
+
 // EnableDebugLogging logs timing and ADSR/gate changes for the first N seconds.
 func (e *SIDEngine) EnableDebugLogging(seconds int) {
 	e.mutex.Lock()
@@ -995,12 +1041,16 @@ func (e *SIDEngine) SetForceLoop(enable bool) {
 		e.loop = true
 		e.loopSample = 0
 		e.loopEventIndex = 0
+		if e.stream != nil {
+			e.stream.setLoop(true, 0)
+		}
 	}
 }
 
 func (e *SIDEngine) StopPlayback() {
 	e.mutex.Lock()
 	e.playing = false
+	e.closeStreamLocked()
 	e.events = nil
 	e.eventIndex = 0
 	e.currentSample = 0
@@ -1030,7 +1080,15 @@ func (e *SIDEngine) TickSample() {
 	var plusSound *SoundChip
 	var plusBase int
 	var secondaryEvents []SIDEvent
-	for e.eventIndex < len(e.events) && e.events[e.eventIndex].Sample == e.currentSample {
+	// Streamed chunks may arrive late after a producer stall, so anything at
+	// or before the current sample is applied rather than skipped.
+	for {
+		if e.eventIndex >= len(e.events) && !e.refillFromStreamLocked() {
+			break
+		}
+		if e.events[e.eventIndex].Sample > e.currentSample {
+			break
+		}
 		ev := e.events[e.eventIndex]
 		switch {
 		case ev.Chip == 0:
@@ -1062,6 +1120,11 @@ func (e *SIDEngine) TickSample() {
 		if e.loop {
 			e.currentSample = e.loopSample
 			e.eventIndex = e.loopEventIndex
+			if e.stream != nil {
+				e.events = nil
+				e.eventIndex = 0
+				e.streamPass++
+			}
 		} else {
 			e.playing = false
 			needsSync = false
@@ -1,5 +1,7 @@
 package main
 
+import "math"
+
 const (
 	c64VICBase  = 0xD000
 	c64VICEnd   = 0xD3FF
@@ -60,6 +62,8 @@ type SIDPlaybackBus6502 struct {
 	raster  uint16
 	sidOsc3 byte
 	sidEnv3 byte
+
+	ioPages [256]bool // pages Read/Write route away from ram (fusionRAM)
 }
 
 func newSIDPlaybackBus6502(ntsc bool) *SIDPlaybackBus6502 {
@@ -73,9 +77,49 @@ func newSIDPlaybackBus6502Multi(ntsc bool, sid2Addr, sid3Addr uint16) *SIDPlayba
 		sid3Base: sid3Addr,
 	}
 	bus.installIRQStub()
+	for page := c64VICBase >> 8; page <= c64CIA2End>>8; page++ {
+		bus.ioPages[page] = true
+	}
+	for _, base := range []uint16{sid2Addr, sid3Addr} {
+		if base != 0 {
+			bus.ioPages[base>>8] = true
+			bus.ioPages[(base+c64SIDEnd-c64SIDBase)>>8] = true
+		}
+	}
 	return bus
 }
 
+// fusionRAM exposes the RAM image to CPU_6502.stepFused.
+func (b *SIDPlaybackBus6502) fusionRAM() (*[0x10000]byte, *[256]bool) {
+	return &b.ram, &b.ioPages
+}
+
+// fusionHorizon returns how many cycles AddCycles can absorb before a
+// running CIA timer underflows.
+func (b *SIDPlaybackBus6502) fusionHorizon() int {
+	horizon := math.MaxInt
+	if b.ciaCtrlA&0x01 != 0 {
+		horizon = min(horizon, ciaTimerHorizon(b.ciaTimerA, b.ciaLatchA))
+	}
+	if b.ciaCtrlB&0x01 != 0 {
+		horizon = min(horizon, ciaTimerHorizon(b.ciaTimerB, b.ciaLatchB))
+	}
+	return horizon
+}
+
+// ciaTimerHorizon mirrors advanceTimer: a zero timer reloads from the
+// latch, and the flag is raised once the remaining count is consumed.
+func ciaTimerHorizon(timer, latch uint16) int {
+	if latch == 0 {
+		return math.MaxInt
+	}
+	remaining := int(timer)
+	if remaining == 0 {
+		remaining = int(latch)
+	}
+	return remaining - 1
+}
+
 // Read reads a byte from the given address.
 func (b *SIDPlaybackBus6502) Read(addr uint16) byte {
 	switch {
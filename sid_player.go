@@ -35,6 +35,8 @@ type SIDPlayer struct {
 	renderInstructions uint64
 	renderCPU          string
 	renderExecNanos    uint64
+	stream             *musicEventStream[SIDEvent] // non-nil while streaming render is active
+	renderCacheHit     bool                        // events came from the on-disk render cache
 }
 
 func NewSIDPlayer(engine *SIDEngine) *SIDPlayer {
@@ -63,17 +65,11 @@ func (p *SIDPlayer) LoadDataWithOptions(data []byte, subsong int, forcePAL bool,
 
 	p.engine.StopPlayback()
 
-	meta, events, totalSamples, clockHz, _, loop, loopSample, instrCount, execNanos, err := renderSIDWithLimit(data, p.engine.sampleRate, 0, subsong, forcePAL, forceNTSC)
+	r, err := renderSIDSource(data, p.engine.sampleRate, subsong, forcePAL, forceNTSC)
 	if err != nil {
 		return err
 	}
-
-	p.metadata = meta
-	p.clockHz = clockHz
-	p.loop = loop
-	p.renderInstructions = instrCount
-	p.renderCPU = "6502"
-	p.renderExecNanos = execNanos
+	clockHz := r.clockHz
 
 	// Set up multi-SID engines and apply chip models from header flags
 	if p.engine.sound != nil {
@@ -95,12 +91,58 @@ func (p *SIDPlayer) LoadDataWithOptions(data []byte, subsong int, forcePAL bool,
 		}
 	}
 
-	p.engine.SetClockHz(clockHz)
-	p.engine.SetEvents(events, totalSamples, loop, loopSample)
-
+	p.applyRenderLocked(r)
 	return nil
 }
 
+// sidRender is a rendered or streaming SID tune ready to install.
+type sidRender struct {
+	meta                  SIDMetadata
+	events                []SIDEvent
+	stream                *musicEventStream[SIDEvent]
+	totalSamples          uint64
+	clockHz               uint32
+	loop                  bool
+	loopSample            uint64
+	instrCount, execNanos uint64
+	cacheHit              bool
+}
+
+// renderSIDSource renders data for playback: a background event stream when
+// streaming render is active, otherwise the full render through the on-disk
+// cache. Both the file loaders and SID_PLAY use it.
+func renderSIDSource(data []byte, sampleRate int, subsong int, forcePAL bool, forceNTSC bool) (sidRender, error) {
+	var (
+		r   sidRender
+		err error
+	)
+	if musicStreamRenderActive() {
+		r.meta, r.stream, r.totalSamples, r.clockHz, r.loop, r.loopSample, err = streamSIDWithLimit(data, sampleRate, 0, subsong, forcePAL, forceNTSC)
+	} else {
+		r.meta, r.events, r.totalSamples, r.clockHz, r.loop, r.loopSample, r.instrCount, r.execNanos, r.cacheHit, err = renderSIDCached(data, sampleRate, subsong, forcePAL, forceNTSC)
+	}
+	return r, err
+}
+
+// applyRenderLocked installs r on the engine. Caller holds p.mu.
+func (p *SIDPlayer) applyRenderLocked(r sidRender) {
+	p.metadata = r.meta
+	p.clockHz = r.clockHz
+	p.loop = r.loop
+	p.stream = r.stream
+	p.renderCacheHit = r.cacheHit
+	p.renderInstructions = r.instrCount
+	p.renderCPU = "6502"
+	p.renderExecNanos = r.execNanos
+
+	p.engine.SetClockHz(r.clockHz)
+	if r.stream != nil {
+		p.engine.SetEventStream(r.stream, r.totalSamples, r.loop, r.loopSample)
+	} else {
+		p.engine.SetEvents(r.events, r.totalSamples, r.loop, r.loopSample)
+	}
+}
+
 func (p *SIDPlayer) Play() {
 	if p.engine.sound != nil {
 		p.engine.sound.SetSampleTicker(p.engine)
@@ -126,9 +168,18 @@ func (p *SIDPlayer) Metadata() SIDMetadata {
 }
 
 func (p *SIDPlayer) RenderPerf() (uint64, string, uint64) {
+	if p.stream != nil {
+		instr, nanos := p.stream.perf()
+		return instr, p.renderCPU, nanos
+	}
 	return p.renderInstructions, p.renderCPU, p.renderExecNanos
 }
 
+// RenderCacheHit reports whether the last load was served from the render cache.
+func (p *SIDPlayer) RenderCacheHit() bool {
+	return p.renderCacheHit
+}
+
 func (p *SIDPlayer) DurationSeconds() float64 {
 	p.engine.mutex.Lock()
 	defer p.engine.mutex.Unlock()
@@ -148,14 +199,24 @@ func (p *SIDPlayer) DurationText() string {
 	return fmt.Sprintf("%d:%02d", minutes, seconds)
 }
 
-func renderSIDWithLimit(data []byte, sampleRate int, maxFrames int, subsong int, forcePAL bool, forceNTSC bool) (SIDMetadata, []SIDEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+// sidRenderPlan holds a primed 6502 player and the frame budget for one subsong.
+type sidRenderPlan struct {
+	meta       SIDMetadata
+	player     *SID6502Player
+	frameCount int
+	frameRate  uint16
+	loop       bool
+	loopSample uint64
+}
+
+func prepareSIDRender(data []byte, sampleRate int, maxFrames int, subsong int, forcePAL bool, forceNTSC bool) (sidRenderPlan, error) {
 	file, err := ParseSIDData(data)
 	if err != nil {
-		return SIDMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("parse SID: %w", err)
+		return sidRenderPlan{}, fmt.Errorf("parse SID: %w", err)
 	}
 
 	if forcePAL && forceNTSC {
-		return SIDMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("cannot force both PAL and NTSC")
+		return sidRenderPlan{}, fmt.Errorf("cannot force both PAL and NTSC")
 	}
 	if forcePAL {
 		file.Header.Flags = (file.Header.Flags &^ 0x03) | 0x01
@@ -173,15 +234,10 @@ func renderSIDWithLimit(data []byte, sampleRate int, maxFrames int, subsong int,
 
 	player, err := newSID6502Player(file, subsong, sampleRate)
 	if err != nil {
-		return SIDMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("create player: %w", err)
+		return sidRenderPlan{}, fmt.Errorf("create player: %w", err)
 	}
 
-	frameRate := uint16(math.Round(player.TickHz()))
-
 	frameCount := sidDefaultLoopFrames
-	loop := true
-	loopSample := uint64(0)
-
 	if maxFrames > 0 && frameCount > maxFrames {
 		frameCount = maxFrames
 	}
@@ -189,17 +245,51 @@ func renderSIDWithLimit(data []byte, sampleRate int, maxFrames int, subsong int,
 		frameCount = sidMaxFrames
 	}
 
-	events, totalSamples := player.RenderFrames(frameCount)
+	return sidRenderPlan{
+		meta: SIDMetadata{
+			Title:    file.Header.Name,
+			Author:   file.Header.Author,
+			Released: file.Header.Released,
+		},
+		player:     player,
+		frameCount: frameCount,
+		frameRate:  uint16(math.Round(player.TickHz())),
+		loop:       true,
+		loopSample: 0,
+	}, nil
+}
 
-	meta := SIDMetadata{
-		Title:    file.Header.Name,
-		Author:   file.Header.Author,
-		Released: file.Header.Released,
+func renderSIDWithLimit(data []byte, sampleRate int, maxFrames int, subsong int, forcePAL bool, forceNTSC bool) (SIDMetadata, []SIDEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+	plan, err := prepareSIDRender(data, sampleRate, maxFrames, subsong, forcePAL, forceNTSC)
+	if err != nil {
+		return SIDMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, err
 	}
+	player := plan.player
+	events, totalSamples := player.RenderFrames(plan.frameCount)
+	return plan.meta, events, totalSamples, player.clockHz, plan.frameRate, plan.loop, plan.loopSample, player.instructionCount, player.cpuExecNanos, nil
+}
 
+// streamSIDWithLimit prepares a SID render and starts a background event
+// stream instead of rendering the whole tune. The returned stream is primed
+// with its first chunk.
+func streamSIDWithLimit(data []byte, sampleRate int, maxFrames int, subsong int, forcePAL bool, forceNTSC bool) (SIDMetadata, *musicEventStream[SIDEvent], uint64, uint32, bool, uint64, error) {
+	plan, err := prepareSIDRender(data, sampleRate, maxFrames, subsong, forcePAL, forceNTSC)
+	if err != nil {
+		return SIDMetadata{}, nil, 0, 0, false, 0, err
+	}
+	player := plan.player
 	clockHz := player.clockHz
-
-	return meta, events, totalSamples, clockHz, uint16(frameRate), loop, loopSample, player.instructionCount, player.cpuExecNanos, nil
+	totalSamples := uint64(plan.frameCount) * uint64(player.getSamplesPerTick())
+	reopen := func() (musicFrameRenderer[SIDEvent], error) {
+		next, err := prepareSIDRender(data, sampleRate, maxFrames, subsong, forcePAL, forceNTSC)
+		if err != nil {
+			return nil, err
+		}
+		return next.player, nil
+	}
+	stream := newMusicEventStream[SIDEvent](player, reopen, plan.frameCount, plan.loop, plan.loopSample, func(ev *SIDEvent) uint64 { return ev.Sample })
+	stream.prime()
+	return plan.meta, stream, totalSamples, clockHz, plan.loop, plan.loopSample, nil
 }
 
 func isSIDExtension(path string) bool {
@@ -321,14 +411,15 @@ func (p *SIDPlayer) enqueueStart(req sidAsyncStartRequest) {
 }
 
 func (p *SIDPlayer) startAsync(req sidAsyncStartRequest) {
-	meta, events, totalSamples, clockHz, _, loop, loopSample, instrCount, execNanos, err := renderSIDWithLimit(
-		req.data, p.engine.sampleRate, 0, req.subsong, false, false,
-	)
+	r, err := renderSIDSource(req.data, p.engine.sampleRate, req.subsong, false, false)
 
 	p.mu.Lock()
 	defer p.mu.Unlock()
 
 	if req.gen != p.PlayGen {
+		if r.stream != nil {
+			r.stream.Close()
+		}
 		return
 	}
 
@@ -338,20 +429,12 @@ func (p *SIDPlayer) startAsync(req sidAsyncStartRequest) {
 		p.PlayBusy = false
 		return
 	}
-	if len(events) == 0 || totalSamples == 0 {
-		fmt.Printf("SID PLAY warning: rendered empty stream (events=%d, samples=%d)\n", len(events), totalSamples)
+	if r.stream == nil && (len(r.events) == 0 || r.totalSamples == 0) {
+		fmt.Printf("SID PLAY warning: rendered empty stream (events=%d, samples=%d)\n", len(r.events), r.totalSamples)
 	}
 
-	p.metadata = meta
-	p.clockHz = clockHz
-	p.loop = loop
-	p.renderInstructions = instrCount
-	p.renderCPU = "6502"
-	p.renderExecNanos = execNanos
-
 	p.engine.StopPlayback()
-	p.engine.SetClockHz(clockHz)
-	p.engine.SetEvents(events, totalSamples, loop, loopSample)
+	p.applyRenderLocked(r)
 	if req.forceLoop {
 		p.engine.SetForceLoop(true)
 	}
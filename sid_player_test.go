@@ -23,3 +23,46 @@ func TestSIDPlayerAsyncStartUsesSingleBoundedWorker(t *testing.T) {
 		t.Fatalf("goroutines grew from %d to %d; want bounded worker behavior", baseline, got)
 	}
 }
+
+func TestSIDPlayerAsyncStartUsesLoadRenderSource(t *testing.T) {
+	renderCacheShared = newRenderCache(t.TempDir(), 1<<24)
+	renderCacheOnce.Do(func() {})
+	t.Cleanup(func() { renderCacheShared = nil })
+
+	data := buildSIDHeader("PSID", 2, 0x1000, 0x1000, 0x1001, 1, 1, 0, 0)
+	copy(data[0x7C:], []byte{
+		0x60,             // INIT: RTS
+		0xEE, 0x00, 0x11, // PLAY: INC $1100
+		0xAD, 0x00, 0x11, // LDA $1100
+		0x8D, 0x00, 0xD4, // STA $D400
+		0x60, // RTS
+	})
+
+	player := NewSIDPlayer(NewSIDEngine(nil, 44100))
+	if err := player.LoadData(data); err != nil {
+		t.Fatalf("LoadData: %v", err)
+	}
+	player.mu.Lock()
+	player.PlayGen++
+	gen := player.PlayGen
+	player.mu.Unlock()
+	player.startAsync(sidAsyncStartRequest{gen: gen, data: data})
+	if !player.RenderCacheHit() {
+		t.Fatal("SID_PLAY start missed the render cache filled by LoadData")
+	}
+
+	musicStreamRenderEnabled.Store(true)
+	t.Cleanup(func() { musicStreamRenderEnabled.Store(false) })
+	player.mu.Lock()
+	player.PlayGen++
+	gen = player.PlayGen
+	player.mu.Unlock()
+	player.startAsync(sidAsyncStartRequest{gen: gen, data: data})
+	player.mu.Lock()
+	stream := player.stream
+	player.mu.Unlock()
+	if stream == nil {
+		t.Fatal("SID_PLAY start pre-rendered with -stream-render on")
+	}
+	player.Stop()
+}
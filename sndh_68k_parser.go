@@ -79,7 +79,7 @@ func findSNDHMagic(data []byte) int {
 func ParseSNDHData(data []byte) (*SNDHFile, error) {
 	// Decompress if ICE-packed
 	if isICE(data) {
-		unpacked, err := UnpackICE(data)
+		unpacked, err := UnpackAsset(data)
 		if err != nil {
 			return nil, fmt.Errorf("failed to unpack ICE: %w", err)
 		}
@@ -446,6 +446,11 @@ func (p *sndh68KPlayer) runUntilReturn() error {
 	return fmt.Errorf("exceeded max instructions per frame")
 }
 
+// renderPerf returns the guest instruction count and CPU time spent so far
+func (p *sndh68KPlayer) renderPerf() (uint64, uint64) {
+	return p.instructionCount, p.cpuExecNanos
+}
+
 // collectEvents converts YM2149 writes to PSGEvents
 func (p *sndh68KPlayer) collectEvents(frameBaseSample uint64, startCycle uint64) []PSGEvent {
 	writes := p.bus.GetWrites()
@@ -46,12 +46,22 @@ func renderSNDH(data []byte, sampleRate int) (PSGMetadata, []PSGEvent, uint64, u
 	return renderSNDHWithLimit(data, sampleRate, 0, 1)
 }
 
-// renderSNDHWithLimit renders SNDH data with optional frame limit and subsong selection
-func renderSNDHWithLimit(data []byte, sampleRate int, maxFrames int, subsong int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+// sndhRenderPlan holds a primed 68K player and the frame budget for one subsong
+type sndhRenderPlan struct {
+	meta       PSGMetadata
+	player     *sndh68KPlayer
+	frameCount int
+	frameRate  uint16
+	loop       bool
+	loopSample uint64
+}
+
+// prepareSNDHRender parses SNDH data, runs INIT and works out the frame budget
+func prepareSNDHRender(data []byte, sampleRate int, maxFrames int, subsong int) (sndhRenderPlan, error) {
 	// Parse SNDH file
 	file, err := ParseSNDHData(data)
 	if err != nil {
-		return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("parse SNDH: %w", err)
+		return sndhRenderPlan{}, fmt.Errorf("parse SNDH: %w", err)
 	}
 
 	// Validate subsong
@@ -62,7 +72,7 @@ func renderSNDHWithLimit(data []byte, sampleRate int, maxFrames int, subsong int
 	// Create player
 	player, err := newSNDH68KPlayer(file, subsong, sampleRate)
 	if err != nil {
-		return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, fmt.Errorf("create player: %w", err)
+		return sndhRenderPlan{}, fmt.Errorf("create player: %w", err)
 	}
 
 	// Determine frame count
@@ -90,9 +100,6 @@ func renderSNDHWithLimit(data []byte, sampleRate int, maxFrames int, subsong int
 		frameCount = sndhMaxFrames
 	}
 
-	// Render frames
-	events, totalSamples := player.RenderFrames(frameCount)
-
 	// Build metadata
 	meta := PSGMetadata{
 		Title:  file.Header.Title,
@@ -100,9 +107,50 @@ func renderSNDHWithLimit(data []byte, sampleRate int, maxFrames int, subsong int
 		System: "Atari ST",
 	}
 
+	return sndhRenderPlan{
+		meta:       meta,
+		player:     player,
+		frameCount: frameCount,
+		frameRate:  frameRate,
+		loop:       loop,
+		loopSample: loopSample,
+	}, nil
+}
+
+// renderSNDHWithLimit renders SNDH data with optional frame limit and subsong selection
+func renderSNDHWithLimit(data []byte, sampleRate int, maxFrames int, subsong int) (PSGMetadata, []PSGEvent, uint64, uint32, uint16, bool, uint64, uint64, uint64, error) {
+	plan, err := prepareSNDHRender(data, sampleRate, maxFrames, subsong)
+	if err != nil {
+		return PSGMetadata{}, nil, 0, 0, 0, false, 0, 0, 0, err
+	}
+	player := plan.player
+
+	// Render frames
+	events, totalSamples := player.RenderFrames(plan.frameCount)
+
 	clockHz := uint32(PSG_CLOCK_ATARI_ST)
 
-	return meta, events, totalSamples, clockHz, frameRate, loop, loopSample, player.instructionCount, player.cpuExecNanos, nil
+	return plan.meta, events, totalSamples, clockHz, plan.frameRate, plan.loop, plan.loopSample, player.instructionCount, player.cpuExecNanos, nil
+}
+
+// streamSNDH starts a background event stream for the default subsong,
+// primed with its first chunk, instead of rendering the whole tune
+func streamSNDH(data []byte, sampleRate int) (PSGMetadata, *musicEventStream[PSGEvent], uint64, uint32, uint16, bool, uint64, error) {
+	plan, err := prepareSNDHRender(data, sampleRate, 0, 1)
+	if err != nil {
+		return PSGMetadata{}, nil, 0, 0, 0, false, 0, err
+	}
+	totalSamples := musicStreamTotalSamples(plan.frameCount, sampleRate, plan.frameRate)
+	reopen := func() (musicFrameRenderer[PSGEvent], error) {
+		next, err := prepareSNDHRender(data, sampleRate, 0, 1)
+		if err != nil {
+			return nil, err
+		}
+		return next.player, nil
+	}
+	stream := newMusicEventStream[PSGEvent](plan.player, reopen, plan.frameCount, plan.loop, plan.loopSample, func(ev *PSGEvent) uint64 { return ev.Sample })
+	stream.prime()
+	return plan.meta, stream, totalSamples, uint32(PSG_CLOCK_ATARI_ST), plan.frameRate, plan.loop, plan.loopSample, nil
 }
 
 // SNDHSystemName returns the system name for SNDH files
@@ -5,6 +5,9 @@
 // SYSINFO_REGION block. The values are stable for the lifetime of the
 // emulator process; writes are silently ignored.
 //
+// The SYSINFO_AUDIO_* words that follow are live audio output telemetry read
+// from the running SoundChip.
+//
 // PLAN_MAX_RAM.md slice 2.
 
 package main
@@ -32,7 +35,7 @@ func RegisterSysInfoMMIO(bus *MachineBus, total, active uint64) {
 		case SYSINFO_ACTIVE_RAM_HI:
 			return activeHi
 		default:
-			return 0
+			return readSysInfoAudio(addr)
 		}
 	}
 	write := func(addr uint32, value uint32) {
@@ -42,6 +45,31 @@ func RegisterSysInfoMMIO(bus *MachineBus, total, active uint64) {
 	bus.MapIO(SYSINFO_REGION_BASE, SYSINFO_REGION_END, read, write)
 }
 
+// readSysInfoAudio returns a SYSINFO_AUDIO_* word for the active SoundChip.
+func readSysInfoAudio(addr uint32) uint32 {
+	sound := runtimeStatus.snapshot().sound
+	if sound == nil {
+		return 0
+	}
+	t := sound.AudioTelemetry()
+	sat := func(v uint64) uint32 { return uint32(min(v, 0xFFFFFFFF)) }
+	switch addr {
+	case SYSINFO_AUDIO_UNDERRUNS:
+		return sat(t.Underruns)
+	case SYSINFO_AUDIO_MISSES:
+		return sat(t.DeadlineMisses)
+	case SYSINFO_AUDIO_RENDER_P99:
+		return sat(uint64(t.RenderP99.Microseconds()))
+	case SYSINFO_AUDIO_LATENCY_US:
+		return sat(uint64(t.Latency.Microseconds()))
+	case SYSINFO_AUDIO_BUFFER:
+		return sat(uint64(t.BufferFrames))
+	case SYSINFO_AUDIO_JITTER_US:
+		return sat(uint64(t.Jitter.Microseconds()))
+	}
+	return 0
+}
+
 // RegisterSysInfoMMIOFromBus registers the SYSINFO RAM-size handlers using
 // the bus's published guest RAM sizing as the single source of truth. The
 // values are snapshotted at registration time -- callers must call this
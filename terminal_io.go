@@ -21,7 +21,8 @@ type TerminalMMIO struct {
 	newlines  int // count of '\n' in buffer (for TERM_LINE_STATUS)
 
 	// Output buffer (drained by tests or host adapter)
-	outputBuf []byte
+	outputBuf   []byte
+	outputReady chan struct{} // closed when outputBuf next grows; see OutputReady
 
 	// Echo flag: readable by application code via TERM_ECHO register.
 	// The application (e.g. read_line) decides whether to echo based on this.
@@ -249,6 +250,10 @@ func (tm *TerminalMMIO) HandleWrite(addr uint32, value uint32) {
 			charArg = ch
 		} else {
 			tm.outputBuf = append(tm.outputBuf, ch)
+			if tm.outputReady != nil {
+				close(tm.outputReady)
+				tm.outputReady = nil
+			}
 		}
 
 	case TERM_ECHO:
@@ -406,6 +411,17 @@ func (tm *TerminalMMIO) DrainOutput() string {
 	return s
 }
 
+// OutputReady returns a channel that is closed the next time TERM_OUT output
+// is buffered for DrainOutput.
+func (tm *TerminalMMIO) OutputReady() <-chan struct{} {
+	tm.mu.Lock()
+	defer tm.mu.Unlock()
+	if tm.outputReady == nil {
+		tm.outputReady = make(chan struct{})
+	}
+	return tm.outputReady
+}
+
 func (tm *TerminalMMIO) enqueueInputByteLocked(b byte) {
 	if tm.inputLen >= len(tm.inputBuf) {
 		return
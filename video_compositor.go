@@ -222,6 +222,7 @@ type VideoCompositor struct {
 	lastHardwareLayers []CompositorFrameLayer
 	lastSnapshotFrame  uint64
 	lastSnapshot       []byte
+	damage             frameDamage
 
 	compositorRunning atomic.Bool
 	state             compositorState
@@ -476,17 +477,18 @@ func (c *VideoCompositor) composite() {
 			HasContent:         hasContent,
 			Layers:             layers,
 		}
+		c.noteHardwareLayersLocked(layers)
 		c.storeHardwareSnapshotLayersLocked(frameID, layers)
 	} else {
 		c.renderLayersSoftwareLocked(layers)
 		c.clearHardwareSnapshotLocked()
 		if hasContent {
 			c.prevHasContent = true
-			copy(c.outputBuf, c.finalFrame)
+			c.publishSoftwareFrameLocked()
 			outputFrame = c.outputBuf
 		} else if c.prevHasContent {
 			c.prevHasContent = false
-			copy(c.outputBuf, c.finalFrame)
+			c.publishSoftwareFrameLocked()
 			outputFrame = c.outputBuf
 		}
 	}
@@ -509,11 +511,11 @@ func (c *VideoCompositor) composite() {
 			c.clearHardwareSnapshotLocked()
 			if hasContent {
 				c.prevHasContent = true
-				copy(c.outputBuf, c.finalFrame)
+				c.publishSoftwareFrameLocked()
 				outputFrame = c.outputBuf
 			} else if c.prevHasContent {
 				c.prevHasContent = false
-				copy(c.outputBuf, c.finalFrame)
+				c.publishSoftwareFrameLocked()
 				outputFrame = c.outputBuf
 			}
 			c.mu.Unlock()
@@ -980,30 +982,56 @@ func (c *VideoCompositor) GetCurrentFrame() []byte {
 func (c *VideoCompositor) GetFrameSnapshot() ([]byte, uint64, time.Time) {
 	c.mu.Lock()
 	defer c.mu.Unlock()
+	frame := c.frameSnapshotLocked()
+	if frame == nil {
+		return nil, c.frameCounter, c.frameTimestamp
+	}
+	return append([]byte(nil), frame...), c.frameCounter, c.frameTimestamp
+}
+
+// ReadRegion returns a copy of the RGBA bytes of a region of the latest
+// frame, row-major. The region must lie inside the frame; nil otherwise.
+func (c *VideoCompositor) ReadRegion(x, y, w, h int) []byte {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if x < 0 || y < 0 || w <= 0 || h <= 0 || x+w > c.frameWidth || y+h > c.frameHeight {
+		return nil
+	}
+	frame := c.frameSnapshotLocked()
+	stride := c.frameWidth * BYTES_PER_PIXEL
+	if len(frame) < stride*c.frameHeight {
+		return nil
+	}
+	out := make([]byte, 0, w*h*BYTES_PER_PIXEL)
+	for row := y; row < y+h; row++ {
+		start := row*stride + x*BYTES_PER_PIXEL
+		out = append(out, frame[start:start+w*BYTES_PER_PIXEL]...)
+	}
+	return out
+}
+
+// frameSnapshotLocked returns the latest frame without copying; the slice is
+// only valid while c.mu is held.
+func (c *VideoCompositor) frameSnapshotLocked() []byte {
 	if c.lastHardwareFrame == c.frameCounter && c.lastHardwareFrame != 0 {
 		if c.lastSnapshotFrame == c.lastHardwareFrame && c.lastSnapshot != nil {
-			out := append([]byte(nil), c.lastSnapshot...)
-			return out, c.frameCounter, c.frameTimestamp
+			return c.lastSnapshot
 		}
 		if hw, ok := c.output.(HardwareCompositingOutput); ok {
 			if frame, ok := hw.HardwareCompositorSnapshot(c.lastHardwareFrame); ok {
 				c.lastSnapshotFrame = c.lastHardwareFrame
 				c.lastSnapshot = append(c.lastSnapshot[:0], frame...)
-				out := append([]byte(nil), c.lastSnapshot...)
-				return out, c.frameCounter, c.frameTimestamp
+				return c.lastSnapshot
 			}
 		}
 		c.lastSnapshotFrame = c.lastHardwareFrame
 		c.lastSnapshot = c.renderLayersSnapshotLocked(c.lastHardwareLayers)
-		out := append([]byte(nil), c.lastSnapshot...)
-		return out, c.frameCounter, c.frameTimestamp
+		return c.lastSnapshot
 	}
 	if len(c.finalFrame) == 0 {
-		return nil, c.frameCounter, c.frameTimestamp
+		return nil
 	}
-	out := make([]byte, len(c.finalFrame))
-	copy(out, c.finalFrame)
-	return out, c.frameCounter, c.frameTimestamp
+	return c.finalFrame
 }
 
 // GetDimensions returns the compositor's current output dimensions.
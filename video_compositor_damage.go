@@ -0,0 +1,345 @@
+// video_compositor_damage.go - Frame damage and tile digests for script waits
+
+/*
+The compositor tracks which parts of its output changed so scripted visual
+checks never have to copy or rehash a whole frame:
+
+  - rows: the damage serial of each row's last change (DamageSince)
+  - tiles: a 64-bit hash per 32x32 tile, rehashed only when the tile was
+    marked dirty (RegionDigest, FrameDigest)
+
+Damage is recorded at compose time, by the composite pass that already owns
+c.mu, so readers only look up serials:
+
+  - The software path publishes each frame by copying finalFrame into
+    outputBuf. That copy now compares row by row and copies only the rows
+    that changed, marking those rows and the tiles of their changed 32-pixel
+    segments.
+  - The hardware path never renders a frame. It compares each layer buffer
+    with the previous frame's copy instead, mapping changed source rows to
+    output rows. Rows are marked whole, so a change hidden under an opaque
+    upper layer may still report damage.
+  - The first frame, a resize, a switch between the two paths and a change
+    in the layer set or geometry mark everything.
+
+Tile hashes are refreshed lazily from the frame snapshot on the next digest
+request, so the compositor pays no hashing when no script is looking.
+
+A region digest cuts the region into 32x32 blocks starting at its own
+top-left corner and folds the block hashes in raster order, so it depends
+only on the region's pixels and size: the same image gives the same digest
+wherever it is drawn and in every run, which suits golden-image tests. When
+the corner lies on the tile grid the blocks are the cached tiles, so the cost
+is the number of tiles plus a rehash of the partial blocks along the right
+and bottom edges; any other region is hashed in full.
+*/
+
+package main
+
+import (
+	"bytes"
+	"encoding/binary"
+	"math/bits"
+)
+
+const (
+	damageTileSize = 32
+
+	digestPrime1 = 0x9E3779B185EBCA87
+	digestPrime2 = 0xC2B2AE3D27D4EB4F
+	digestPrime3 = 0x165667B19E3779F9
+)
+
+// frameDamage records which output rows and tiles changed and when.
+type frameDamage struct {
+	rows     []uint64 // serial of each row's last change
+	tiles    []uint64 // hash of each tile, row-major
+	dirty    []bool   // tiles changed since their last hash
+	serial   uint64   // bumped by every frame that changed something
+	width    int
+	height   int
+	tilesX   int
+	hardware bool // the last frame came from the hardware path
+
+	digest       uint64 // whole-frame digest, valid while digestSerial == serial
+	digestSerial uint64
+}
+
+// beginLocked sizes the damage map for a width x height frame from the given
+// path. A new size, a path switch or the first frame marks everything and
+// returns false; otherwise the caller marks what changed.
+func (d *frameDamage) beginLocked(width, height int, hardware bool) bool {
+	if d.rows != nil && d.width == width && d.height == height && d.hardware == hardware {
+		return true
+	}
+	d.width, d.height, d.hardware = width, height, hardware
+	d.tilesX = (width + damageTileSize - 1) / damageTileSize
+	tilesY := (height + damageTileSize - 1) / damageTileSize
+	d.rows = make([]uint64, height)
+	d.tiles = make([]uint64, d.tilesX*tilesY)
+	d.dirty = make([]bool, len(d.tiles))
+	d.markAllLocked()
+	return false
+}
+
+func (d *frameDamage) markAllLocked() {
+	next := d.serial + 1
+	for y := range d.rows {
+		d.rows[y] = next
+	}
+	for i := range d.dirty {
+		d.dirty[i] = true
+	}
+	d.serial = next
+}
+
+// markRowLocked marks row y changed in the frame being published, along with
+// the tiles covering pixels [x0, x1).
+func (d *frameDamage) markRowLocked(y, x0, x1 int) {
+	d.rows[y] = d.serial + 1
+	tileRow := (y / damageTileSize) * d.tilesX
+	for tx := x0 / damageTileSize; tx*damageTileSize < x1; tx++ {
+		d.dirty[tileRow+tx] = true
+	}
+}
+
+// publishSoftwareFrameLocked copies finalFrame into outputBuf, rows that did
+// not change are skipped, and records the changed rows and tiles.
+func (c *VideoCompositor) publishSoftwareFrameLocked() {
+	d := &c.damage
+	stride := c.frameWidth * BYTES_PER_PIXEL
+	if stride <= 0 || c.frameHeight <= 0 || len(c.finalFrame) < stride*c.frameHeight ||
+		len(c.outputBuf) != len(c.finalFrame) || !d.beginLocked(c.frameWidth, c.frameHeight, false) {
+		copy(c.outputBuf, c.finalFrame)
+		return
+	}
+	const segBytes = damageTileSize * BYTES_PER_PIXEL
+	changed := false
+	for y := range c.frameHeight {
+		row := c.finalFrame[y*stride : (y+1)*stride]
+		prev := c.outputBuf[y*stride : (y+1)*stride]
+		if bytes.Equal(row, prev) {
+			continue
+		}
+		tileRow := (y / damageTileSize) * d.tilesX
+		for tx, off := 0, 0; off < stride; tx, off = tx+1, off+segBytes {
+			end := min(off+segBytes, stride)
+			if !bytes.Equal(row[off:end], prev[off:end]) {
+				d.dirty[tileRow+tx] = true
+			}
+		}
+		copy(prev, row)
+		d.rows[y] = d.serial + 1
+		changed = true
+	}
+	if changed {
+		d.serial++
+	}
+}
+
+// noteHardwareLayersLocked records the damage between the previous hardware
+// frame's layers (c.lastHardwareLayers) and layers. Call it before the new
+// layers are stored.
+func (c *VideoCompositor) noteHardwareLayersLocked(layers []CompositorFrameLayer) {
+	d := &c.damage
+	if !d.beginLocked(c.frameWidth, c.frameHeight, true) {
+		return
+	}
+	prev := c.lastHardwareLayers
+	if prev == nil || len(prev) != len(layers) {
+		d.markAllLocked()
+		return
+	}
+	for i := range layers {
+		a, b := &prev[i], &layers[i]
+		if a.SourceID != b.SourceID || a.SourceWidth != b.SourceWidth || a.SourceHeight != b.SourceHeight ||
+			a.DestX != b.DestX || a.DestY != b.DestY || a.DestWidth != b.DestWidth || a.DestHeight != b.DestHeight ||
+			len(a.Buffer) != len(b.Buffer) {
+			d.markAllLocked()
+			return
+		}
+	}
+	changed := false
+	for i := range layers {
+		a, b := &prev[i], &layers[i]
+		srcStride := b.SourceWidth * BYTES_PER_PIXEL
+		if b.DestHeight <= 0 || srcStride <= 0 || len(b.Buffer) < srcStride*b.SourceHeight {
+			continue
+		}
+		x0 := max(b.DestX, 0)
+		x1 := min(b.DestX+b.DestWidth, c.frameWidth)
+		lastSrcY, lastEqual := -1, true
+		for dy := range b.DestHeight {
+			y := b.DestY + dy
+			if y < 0 || y >= c.frameHeight {
+				continue
+			}
+			// Same mapping as blendFrameScaled.
+			if srcY := dy * b.SourceHeight / b.DestHeight; srcY != lastSrcY {
+				lastSrcY = srcY
+				off := srcY * srcStride
+				lastEqual = bytes.Equal(a.Buffer[off:off+srcStride], b.Buffer[off:off+srcStride])
+			}
+			if !lastEqual {
+				d.markRowLocked(y, x0, x1)
+				changed = true
+			}
+		}
+	}
+	if changed {
+		d.serial++
+	}
+}
+
+// rehashDirtyTilesLocked refreshes the hashes of tiles marked dirty since
+// they were last hashed.
+func (c *VideoCompositor) rehashDirtyTilesLocked(frame []byte) {
+	d := &c.damage
+	stride := d.width * BYTES_PER_PIXEL
+	for i, dirty := range d.dirty {
+		if !dirty {
+			continue
+		}
+		x0 := (i % d.tilesX) * damageTileSize
+		y0 := (i / d.tilesX) * damageTileSize
+		d.tiles[i] = hashFrameRect(frame, stride, x0, y0,
+			min(x0+damageTileSize, d.width), min(y0+damageTileSize, d.height))
+		d.dirty[i] = false
+	}
+}
+
+// hashFrameRect hashes the pixels of [x0,x1) x [y0,y1) row by row.
+func hashFrameRect(frame []byte, stride, x0, y0, x1, y1 int) uint64 {
+	h := uint64(digestPrime3) ^ uint64(x1-x0)<<32 ^ uint64(y1-y0)
+	for y := y0; y < y1; y++ {
+		b := frame[y*stride+x0*BYTES_PER_PIXEL : y*stride+x1*BYTES_PER_PIXEL]
+		for ; len(b) >= 8; b = b[8:] {
+			h ^= binary.LittleEndian.Uint64(b) * digestPrime2
+			h = bits.RotateLeft64(h, 31) * digestPrime1
+		}
+		if len(b) == 4 {
+			h ^= uint64(binary.LittleEndian.Uint32(b)) * digestPrime1
+			h = bits.RotateLeft64(h, 23)*digestPrime2 + digestPrime3
+		}
+	}
+	return digestAvalanche(h)
+}
+
+func digestAvalanche(h uint64) uint64 {
+	h ^= h >> 33
+	h *= digestPrime2
+	h ^= h >> 29
+	h *= digestPrime3
+	h ^= h >> 32
+	return h
+}
+
+// DamageSince reports whether any row in [y0, y1) changed after damage
+// serial since, and returns the current serial to pass next time. Serial 0
+// means "never seen", so the first call always reports a change. ok is false
+// while no frame is available.
+func (c *VideoCompositor) DamageSince(y0, y1 int, since uint64) (changed bool, serial uint64, ok bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	d := &c.damage
+	if d.rows == nil {
+		return false, since, false
+	}
+	if d.serial <= since {
+		return false, d.serial, true
+	}
+	for y := max(y0, 0); y < min(y1, len(d.rows)); y++ {
+		if d.rows[y] > since {
+			return true, d.serial, true
+		}
+	}
+	return false, d.serial, true
+}
+
+// damageFrameLocked returns the frame the damage map describes with its tile
+// hashes up to date. ok is false until a frame of the current size has been
+// composited.
+func (c *VideoCompositor) damageFrameLocked() ([]byte, bool) {
+	d := &c.damage
+	if d.rows == nil || d.width != c.frameWidth || d.height != c.frameHeight {
+		return nil, false
+	}
+	frame := c.frameSnapshotLocked()
+	if len(frame) < d.width*d.height*BYTES_PER_PIXEL {
+		return nil, false
+	}
+	c.rehashDirtyTilesLocked(frame)
+	return frame, true
+}
+
+// RegionDigest returns a 64-bit digest of the region clipped to the frame.
+// ok is false when no frame is available or the clipped region is empty.
+func (c *VideoCompositor) RegionDigest(x, y, w, h int) (uint64, bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	frame, ok := c.damageFrameLocked()
+	if !ok {
+		return 0, false
+	}
+	d := &c.damage
+	x0, y0 := max(x, 0), max(y, 0)
+	x1, y1 := min(x+w, d.width), min(y+h, d.height)
+	if x0 >= x1 || y0 >= y1 {
+		return 0, false
+	}
+	whole := x0 == 0 && y0 == 0 && x1 == d.width && y1 == d.height
+	if whole && d.digestSerial == d.serial {
+		return d.digest, true
+	}
+	// Blocks are cut from the region's own corner, so the digest does not
+	// depend on where the region sits. Only a grid-aligned corner lines the
+	// blocks up with the cached tiles.
+	aligned := x0%damageTileSize == 0 && y0%damageTileSize == 0
+	stride := d.width * BYTES_PER_PIXEL
+	sum := uint64(digestPrime1) ^ uint64(x1-x0)<<32 ^ uint64(y1-y0)
+	for by := y0; by < y1; by += damageTileSize {
+		by1 := min(by+damageTileSize, y1)
+		for bx := x0; bx < x1; bx += damageTileSize {
+			bx1 := min(bx+damageTileSize, x1)
+			var th uint64
+			if aligned && bx1 == min(bx+damageTileSize, d.width) && by1 == min(by+damageTileSize, d.height) {
+				th = d.tiles[(by/damageTileSize)*d.tilesX+bx/damageTileSize]
+			} else {
+				th = hashFrameRect(frame, stride, bx, by, bx1, by1)
+			}
+			sum = bits.RotateLeft64(sum^th, 27)*digestPrime1 + digestPrime3
+		}
+	}
+	sum = digestAvalanche(sum)
+	if whole {
+		d.digest, d.digestSerial = sum, d.serial
+	}
+	return sum, true
+}
+
+// FrameDigest returns the whole-frame digest; repeat calls on an unchanged
+// frame are O(1).
+func (c *VideoCompositor) FrameDigest() (uint64, bool) {
+	c.mu.Lock()
+	w, h := c.frameWidth, c.frameHeight
+	c.mu.Unlock()
+	return c.RegionDigest(0, 0, w, h)
+}
+
+// PixelAt returns the RGBA bytes of one pixel of the latest frame without
+// copying the frame.
+func (c *VideoCompositor) PixelAt(x, y int) ([4]byte, bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	var px [4]byte
+	if x < 0 || y < 0 || x >= c.frameWidth || y >= c.frameHeight {
+		return px, false
+	}
+	frame := c.frameSnapshotLocked()
+	i := (y*c.frameWidth + x) * BYTES_PER_PIXEL
+	if i+4 > len(frame) {
+		return px, false
+	}
+	copy(px[:], frame[i:i+4])
+	return px, true
+}
@@ -1643,3 +1643,177 @@ func TestCompositor_FullIntegration_ModeChangePropagatesToOutput(t *testing.T) {
 	cfg := out.GetDisplayConfig()
 	t.Fatalf("expected output config 1024x768 within 200ms, got %dx%d", cfg.Width, cfg.Height)
 }
+
+func TestCompositor_DamageSinceTracksChangedRows(t *testing.T) {
+	comp := NewVideoCompositor(nil)
+	comp.SetDimensions(2, 3)
+	src := &mockOpaqueSource{w: 2, h: 3, frame: solidTestFrame(2, 3, 0x10, 0x20, 0x30, 0xFF)}
+	src.enabled.Store(true)
+	comp.RegisterSource(src)
+
+	comp.composite()
+	changed, serial, ok := comp.DamageSince(0, 3, 0)
+	if !ok || !changed {
+		t.Fatalf("first scan: changed=%v ok=%v, want both true", changed, ok)
+	}
+
+	comp.composite()
+	if changed, _, _ := comp.DamageSince(0, 3, serial); changed {
+		t.Fatal("identical frame reported damage")
+	}
+
+	copy(src.frame[(2*2)*4:], []byte{0xAA, 0xBB, 0xCC, 0xFF})
+	comp.composite()
+	if changed, _, _ := comp.DamageSince(0, 2, serial); changed {
+		t.Fatal("rows 0-1 reported damage after a row 2 change")
+	}
+	if changed, _, _ := comp.DamageSince(2, 3, serial); !changed {
+		t.Fatal("row 2 change not reported")
+	}
+	if px, ok := comp.PixelAt(0, 2); !ok || px != [4]byte{0xAA, 0xBB, 0xCC, 0xFF} {
+		t.Fatalf("PixelAt(0,2) = %v, %v", px, ok)
+	}
+	if _, ok := comp.PixelAt(2, 0); ok {
+		t.Fatal("PixelAt outside the frame succeeded")
+	}
+}
+
+func TestCompositor_DamageSinceTracksHardwareLayers(t *testing.T) {
+	out := newMockHardwareVideoOutput()
+	comp := NewVideoCompositor(out)
+	comp.SetDimensions(4, 4)
+	src := &mockOpaqueSource{w: 4, h: 4, frame: solidTestFrame(4, 4, 0x10, 0x20, 0x30, 0xFF)}
+	src.enabled.Store(true)
+	comp.RegisterSource(src)
+
+	comp.composite()
+	if out.hardwareUpdateCount() != 1 {
+		t.Fatalf("hardware updates = %d, want 1", out.hardwareUpdateCount())
+	}
+	changed, serial, ok := comp.DamageSince(0, 4, 0)
+	if !ok || !changed {
+		t.Fatalf("first frame: changed=%v ok=%v, want both true", changed, ok)
+	}
+
+	comp.composite()
+	if changed, _, _ := comp.DamageSince(0, 4, serial); changed {
+		t.Fatal("identical layers reported damage")
+	}
+
+	copy(src.frame[(3*4+1)*4:], []byte{0xAA, 0xBB, 0xCC, 0xFF})
+	comp.composite()
+	if changed, _, _ := comp.DamageSince(0, 3, serial); changed {
+		t.Fatal("rows 0-2 reported damage after a row 3 change")
+	}
+	if changed, _, _ := comp.DamageSince(3, 4, serial); !changed {
+		t.Fatal("row 3 change not reported")
+	}
+
+	// The digest of the hardware frame matches the software-composited one.
+	sw := NewVideoCompositor(nil)
+	sw.SetDimensions(4, 4)
+	swSrc := &mockOpaqueSource{w: 4, h: 4, frame: append([]byte(nil), src.frame...)}
+	swSrc.enabled.Store(true)
+	sw.RegisterSource(swSrc)
+	sw.composite()
+	hw, ok := comp.FrameDigest()
+	if want, _ := sw.FrameDigest(); !ok || hw != want {
+		t.Fatalf("hardware frame digest = %#x, %v; want %#x", hw, ok, want)
+	}
+}
+
+func TestCompositor_RegionDigestFollowsDamage(t *testing.T) {
+	// 80x50 leaves partial tiles on the right and bottom edges.
+	newComp := func(frame []byte) *VideoCompositor {
+		comp := NewVideoCompositor(nil)
+		comp.SetDimensions(80, 50)
+		src := &mockOpaqueSource{w: 80, h: 50, frame: frame}
+		src.enabled.Store(true)
+		comp.RegisterSource(src)
+		comp.composite()
+		return comp
+	}
+	frame := solidTestFrame(80, 50, 1, 2, 3, 0xFF)
+	comp := newComp(frame)
+	full, ok := comp.FrameDigest()
+	if !ok {
+		t.Fatal("no frame digest")
+	}
+	region, _ := comp.RegionDigest(5, 7, 40, 30)
+
+	copy(frame[(45*80+70)*4:], []byte{9, 9, 9, 0xFF}) // outside the region
+	comp.composite()
+	if got, _ := comp.RegionDigest(5, 7, 40, 30); got != region {
+		t.Fatal("change outside the region altered its digest")
+	}
+	full2, _ := comp.FrameDigest()
+	if full2 == full {
+		t.Fatal("frame digest ignored a change")
+	}
+
+	copy(frame[(10*80+10)*4:], []byte{9, 9, 9, 0xFF}) // inside the region
+	comp.composite()
+	region2, _ := comp.RegionDigest(5, 7, 40, 30)
+	if region2 == region {
+		t.Fatal("change inside the region kept its digest")
+	}
+
+	// Cached tile hashes must agree with a fresh scan of the same pixels.
+	fresh := newComp(append([]byte(nil), frame...))
+	a, _ := comp.FrameDigest()
+	if f, _ := fresh.FrameDigest(); a != f {
+		t.Fatal("incremental frame digest differs from a fresh scan")
+	}
+	if got, _ := fresh.RegionDigest(5, 7, 40, 30); got != region2 {
+		t.Fatal("incremental region digest differs from a fresh scan")
+	}
+	if _, ok := comp.RegionDigest(100, 0, 10, 10); ok {
+		t.Fatal("digest of a region outside the frame succeeded")
+	}
+}
+
+func TestCompositor_RegionDigestIgnoresPosition(t *testing.T) {
+	// The same 40x40 image drawn at a tile-aligned corner (cached tiles) and
+	// at an unaligned one (hashed in full) must digest the same.
+	const w, h, size = 80, 50, 40
+	drawAt := func(ox, oy int) *VideoCompositor {
+		frame := solidTestFrame(w, h, 1, 2, 3, 0xFF)
+		for y := range size {
+			for x := range size {
+				copy(frame[((oy+y)*w+ox+x)*4:], []byte{byte(x * 5), byte(y * 3), byte(x ^ y), 0xFF})
+			}
+		}
+		comp := NewVideoCompositor(nil)
+		comp.SetDimensions(w, h)
+		src := &mockOpaqueSource{w: w, h: h, frame: frame}
+		src.enabled.Store(true)
+		comp.RegisterSource(src)
+		comp.composite()
+		return comp
+	}
+	want, ok := drawAt(0, 0).RegionDigest(0, 0, size, size)
+	if !ok {
+		t.Fatal("no region digest")
+	}
+	for _, at := range [][2]int{{5, 3}, {32, 0}, {17, 10}} {
+		if got, _ := drawAt(at[0], at[1]).RegionDigest(at[0], at[1], size, size); got != want {
+			t.Fatalf("image at %v digests to %#x, want %#x", at, got, want)
+		}
+	}
+}
+
+func BenchmarkCompositor_FrameDigest(b *testing.B) {
+	comp := NewVideoCompositor(nil)
+	comp.SetDimensions(800, 600)
+	frame := solidTestFrame(800, 600, 1, 2, 3, 0xFF)
+	src := &mockOpaqueSource{w: 800, h: 600, frame: frame}
+	src.enabled.Store(true)
+	comp.RegisterSource(src)
+	comp.composite()
+	b.ReportAllocs()
+	for i := range b.N {
+		frame[(i%600*800+i%800)*4]++ // one damaged tile per frame
+		comp.composite()
+		comp.FrameDigest()
+	}
+}
@@ -9,6 +9,8 @@
 //   - Memory:  MOV r32,[mem] / MOV [mem],r32 sequential loop
 //   - Mixed:   Interleaved ALU, memory, and branches
 //   - String:  REP STOSB fill operation
+//   - FPU:     x87 register-stack arithmetic with m64 operands
+//   - Segment: FS/GS-prefixed loads and stores (TLS-style access)
 //
 // Reference results (i5-8365U, same-session 10s runs, with ERMS/BMI2/LZCNT):
 //
@@ -26,6 +28,8 @@
 package main
 
 import (
+	"encoding/binary"
+	"math"
 	"testing"
 	"time"
 )
@@ -202,6 +206,98 @@ func buildX86CallProgram(iterations uint32) (code []byte, totalInstrs int) {
 	return
 }
 
+// buildX86FPUProgram constructs an x86 program: x87 register-stack loop. The
+// constants are stored by the setup code so the program is self-contained.
+//
+//	MOV [data+0..7], 1.5   ; a (two MOV m32,imm32 each)
+//	MOV [data+8..15], 0.25 ; b
+//	MOV [data+16..23], 0.5 ; c
+//	MOV ECX, iter
+//	FLDZ                   ; accumulator
+//	loop:
+//	  FLD   qword [a]      ; DD 05
+//	  FMUL  ST0, ST0       ; D8 C8
+//	  FADD  qword [b]      ; DC 05
+//	  FLD   ST0            ; D9 C0
+//	  FMUL  qword [c]      ; DC 0D
+//	  FSUBP ST1, ST0       ; DE E9
+//	  FADDP ST1, ST0       ; DE C1 (accumulator += 1.25)
+//	  DEC ECX
+//	  JNZ loop
+//	FSTP qword [data+24]
+//	HLT
+//
+// Total: 8 setup + iter * 9 + 2
+func buildX86FPUProgram(iterations uint32) (code []byte, totalInstrs int) {
+	it := le32(iterations)
+	for i, hi := range []uint32{0x3FF80000, 0x3FD00000, 0x3FE00000} {
+		for half, v := range []uint32{0, hi} {
+			addr := le32(x86BenchDataAddr + uint32(i*8+half*4))
+			val := le32(v)
+			code = append(code, 0xC7, 0x05, addr[0], addr[1], addr[2], addr[3], val[0], val[1], val[2], val[3])
+		}
+	}
+	a, b, c := le32(x86BenchDataAddr), le32(x86BenchDataAddr+8), le32(x86BenchDataAddr+16)
+	res := le32(x86BenchDataAddr + 24)
+	code = append(code,
+		0xB9, it[0], it[1], it[2], it[3], // MOV ECX, iter
+		0xD9, 0xEE, // FLDZ
+		// loop:
+		0xDD, 0x05, a[0], a[1], a[2], a[3], // FLD qword [a]     (6)
+		0xD8, 0xC8, // FMUL ST0, ST0     (2)
+		0xDC, 0x05, b[0], b[1], b[2], b[3], // FADD qword [b]    (6)
+		0xD9, 0xC0, // FLD ST0           (2)
+		0xDC, 0x0D, c[0], c[1], c[2], c[3], // FMUL qword [c]    (6)
+		0xDE, 0xE9, // FSUBP ST1, ST0    (2)
+		0xDE, 0xC1, // FADDP ST1, ST0    (2)
+		0x49,       // DEC ECX           (1)
+		0x75, 0xE3, // JNZ -29 (back to loop) (2)
+		0xDD, 0x1D, res[0], res[1], res[2], res[3], // FSTP qword [data+24]
+		0xF4, // HLT
+	)
+	totalInstrs = 8 + int(iterations)*9 + 2
+	return
+}
+
+// buildX86SegmentProgram constructs an x86 program: FS/GS-prefixed memory
+// loop, the TLS-style access pattern of flat 32-bit guests.
+//
+//	MOV ESI, dataAddr
+//	MOV ECX, iter
+//	MOV EBX, 0
+//	loop:
+//	  FS: MOV [ESI+0x20], ECX  ; 64 89 4E 20
+//	  GS: MOV EAX, [ESI+0x20]  ; 65 8B 46 20
+//	  ADD EBX, EAX
+//	  FS: MOV EAX, [moffs32]   ; 64 A1 (dataAddr+0x20)
+//	  ADD EBX, EAX
+//	  DEC ECX
+//	  JNZ loop
+//	HLT
+//
+// Total: 3 setup + iter * 7 + 1 HLT
+func buildX86SegmentProgram(iterations uint32) (code []byte, totalInstrs int) {
+	da := le32(x86BenchDataAddr)
+	mo := le32(x86BenchDataAddr + 0x20)
+	it := le32(iterations)
+	code = []byte{
+		0xBE, da[0], da[1], da[2], da[3], // MOV ESI, dataAddr
+		0xB9, it[0], it[1], it[2], it[3], // MOV ECX, iter
+		0xBB, 0x00, 0x00, 0x00, 0x00, // MOV EBX, 0
+		// loop: (offset 15)
+		0x64, 0x89, 0x4E, 0x20, // FS: MOV [ESI+0x20], ECX (4)
+		0x65, 0x8B, 0x46, 0x20, // GS: MOV EAX, [ESI+0x20] (4)
+		0x01, 0xC3, // ADD EBX, EAX (2)
+		0x64, 0xA1, mo[0], mo[1], mo[2], mo[3], // FS: MOV EAX, [moffs32] (6)
+		0x01, 0xC3, // ADD EBX, EAX (2)
+		0x49,       // DEC ECX (1)
+		0x75, 0xEB, // JNZ -21 (back to offset 15) (2)
+		0xF4, // HLT
+	}
+	totalInstrs = 3 + int(iterations)*7 + 1
+	return
+}
+
 // ===========================================================================
 // Benchmark Harness
 // ===========================================================================
@@ -496,6 +592,100 @@ func BenchmarkX86JIT_String_JIT(b *testing.B) {
 // Correctness validation for benchmark programs
 // ===========================================================================
 
+// ===========================================================================
+// FPU Benchmarks
+// ===========================================================================
+
+func BenchmarkX86JIT_FPU_Interpreter(b *testing.B) {
+	code, totalInstrs := buildX86FPUProgram(x86BenchIterations)
+	cpu, _, _ := setupX86JITBenchCPU()
+	loadX86BenchProgram(cpu, 0x1000, code)
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		resetX86BenchState(cpu, 0x1000)
+		runX86BenchInterpreter(cpu)
+	}
+	b.ReportMetric(float64(totalInstrs), "instructions/op")
+	ReportMIPSHostNormalized(b, totalInstrs)
+}
+
+func BenchmarkX86JIT_FPU_JIT(b *testing.B) {
+	if !x86JitAvailable {
+		b.Skip("x86 JIT not available")
+	}
+	code, totalInstrs := buildX86FPUProgram(x86BenchIterations)
+	cpu, adapter, bus := setupX86JITBenchCPU()
+	loadX86BenchProgram(cpu, 0x1000, code)
+
+	cpu.x86JitEnabled = true
+	cpu.x86JitPersist = true
+	cpu.x86JitIOBitmap = buildX86IOBitmap(adapter, bus)
+
+	resetX86BenchState(cpu, 0x1000)
+	runX86BenchJIT(cpu)
+
+	b.Cleanup(func() {
+		cpu.x86JitPersist = false
+		cpu.freeX86JIT()
+	})
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		resetX86BenchState(cpu, 0x1000)
+		runX86BenchJIT(cpu)
+	}
+	b.ReportMetric(float64(totalInstrs), "instructions/op")
+	ReportMIPSHostNormalized(b, totalInstrs)
+}
+
+// ===========================================================================
+// Segment-Override Benchmarks
+// ===========================================================================
+
+func BenchmarkX86JIT_Segment_Interpreter(b *testing.B) {
+	code, totalInstrs := buildX86SegmentProgram(x86BenchIterations)
+	cpu, _, _ := setupX86JITBenchCPU()
+	loadX86BenchProgram(cpu, 0x1000, code)
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		resetX86BenchState(cpu, 0x1000)
+		runX86BenchInterpreter(cpu)
+	}
+	b.ReportMetric(float64(totalInstrs), "instructions/op")
+	ReportMIPSHostNormalized(b, totalInstrs)
+}
+
+func BenchmarkX86JIT_Segment_JIT(b *testing.B) {
+	if !x86JitAvailable {
+		b.Skip("x86 JIT not available")
+	}
+	code, totalInstrs := buildX86SegmentProgram(x86BenchIterations)
+	cpu, adapter, bus := setupX86JITBenchCPU()
+	loadX86BenchProgram(cpu, 0x1000, code)
+
+	cpu.x86JitEnabled = true
+	cpu.x86JitPersist = true
+	cpu.x86JitIOBitmap = buildX86IOBitmap(adapter, bus)
+
+	resetX86BenchState(cpu, 0x1000)
+	runX86BenchJIT(cpu)
+
+	b.Cleanup(func() {
+		cpu.x86JitPersist = false
+		cpu.freeX86JIT()
+	})
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		resetX86BenchState(cpu, 0x1000)
+		runX86BenchJIT(cpu)
+	}
+	b.ReportMetric(float64(totalInstrs), "instructions/op")
+	ReportMIPSHostNormalized(b, totalInstrs)
+}
+
 func TestX86JIT_BenchALU_Correctness(t *testing.T) {
 	code, _ := buildX86ALUProgram(100) // small iteration count for testing
 
@@ -555,3 +745,39 @@ func TestX86JIT_BenchCall_Correctness(t *testing.T) {
 		t.Errorf("JIT: EAX = %d, want 10 (INC EAX called 10 times)", cpu.EAX)
 	}
 }
+
+func TestX86JIT_BenchFPU_Correctness(t *testing.T) {
+	code, _ := buildX86FPUProgram(100)
+
+	jitCPU := runX86JITProgram(t, 0x1000, code...)
+	interpCPU := runX86InterpreterProgram(t, 0x1000, code...)
+
+	read := func(cpu *CPU_X86) float64 {
+		return math.Float64frombits(binary.LittleEndian.Uint64(cpu.memory[x86BenchDataAddr+24:]))
+	}
+	if got := read(interpCPU); got != 125 {
+		t.Fatalf("Interpreter: result = %v, want 125 (program is broken)", got)
+	}
+	if got := read(jitCPU); got != 125 {
+		t.Errorf("FPU bench result: JIT=%v, want 125", got)
+	}
+	if jitCPU.FPU.top() != interpCPU.FPU.top() || jitCPU.FPU.FTW != interpCPU.FPU.FTW {
+		t.Errorf("FPU bench TOP/FTW: JIT=%d/%04X, Interp=%d/%04X",
+			jitCPU.FPU.top(), jitCPU.FPU.FTW, interpCPU.FPU.top(), interpCPU.FPU.FTW)
+	}
+}
+
+func TestX86JIT_BenchSegment_Correctness(t *testing.T) {
+	code, _ := buildX86SegmentProgram(100)
+
+	jitCPU := runX86JITProgram(t, 0x1000, code...)
+	interpCPU := runX86InterpreterProgram(t, 0x1000, code...)
+
+	// EBX = 2 * (100 + 99 + ... + 1)
+	if interpCPU.EBX != 10100 {
+		t.Fatalf("Interpreter: EBX = %d, want 10100 (program is broken)", interpCPU.EBX)
+	}
+	if jitCPU.EBX != interpCPU.EBX {
+		t.Errorf("Segment bench EBX: JIT=%d, Interp=%d", jitCPU.EBX, interpCPU.EBX)
+	}
+}
@@ -8,6 +8,8 @@
 //   - Memory: Load/store loop via LD A,(HL); LD (DE),A; INC HL; INC DE
 //   - Mixed:  Interleaved ALU + memory + stack (PUSH/POP, LD (HL), ADD)
 //   - Call:   CALL/RET subroutine overhead (256 iterations)
+//   - BankedData: checksum loops over two banks switched through $2000
+//   - BankedCode: two routines in different banks behind the $6000 window
 //
 // Reference results (i5-8365U, benchtime=30s, Phases A-D optimizations):
 //   ALU:    Interp 43.8us (53 MIPS), JIT  5.3us (433 MIPS) → 8.2x
@@ -350,3 +352,165 @@ func BenchmarkZ80_Call_JIT(b *testing.B) {
 	b.ReportMetric(float64(1027), "instrs/op")
 	ReportMIPSHostNormalized(b, 1027)
 }
+
+// ===========================================================================
+// Banked Benchmarks — code and data behind the IE80 bank windows
+// ===========================================================================
+
+// z80BankedImage is guest memory reachable only through a bank window.
+type z80BankedImage struct {
+	phys uint32
+	data []byte
+}
+
+func loadZ80BankedImages(bus *MachineBus, images []z80BankedImage) {
+	for _, img := range images {
+		for i, b := range img.data {
+			bus.Write8(img.phys+uint32(i), b)
+		}
+	}
+}
+
+// buildZ80BankedDataProgram sums the first 256 bytes of banks 8 and 9
+// into C, selecting each through the $2000 window, iters times.
+func buildZ80BankedDataProgram(iters byte) ([]byte, uint16, []z80BankedImage) {
+	prog := make([]byte, 0x2C)
+	copy(prog, []byte{
+		0x1E, iters, // LD E, iters
+		0x3E, 0x08, // outer: LD A, 8
+		0x32, 0x00, 0xF7, // LD ($F700), A  ; bank1 = 8
+		0xCD, 0x20, 0x01, // CALL sum
+		0x3E, 0x09, // LD A, 9
+		0x32, 0x00, 0xF7, // LD ($F700), A  ; bank1 = 9
+		0xCD, 0x20, 0x01, // CALL sum
+		0x1D,       // DEC E
+		0x20, 0xED, // JR NZ, outer
+		0x76, // HALT
+	})
+	copy(prog[0x20:], []byte{
+		0x21, 0x00, 0x20, // sum: LD HL, $2000
+		0x06, 0x00, // LD B, 0
+		0x79,       // loop: LD A, C
+		0x86,       // ADD A, (HL)
+		0x4F,       // LD C, A
+		0x23,       // INC HL
+		0x10, 0xFA, // DJNZ loop
+		0xC9, // RET
+	})
+	bank8 := make([]byte, 256)
+	bank9 := make([]byte, 256)
+	for i := range bank8 {
+		bank8[i] = byte(i)
+		bank9[i] = byte(i*7 + 3)
+	}
+	return prog, 0x0100, []z80BankedImage{
+		{phys: 8 * Z80_BANK_WINDOW_SIZE, data: bank8},
+		{phys: 9 * Z80_BANK_WINDOW_SIZE, data: bank9},
+	}
+}
+
+// z80BankedDataInstrs is the instruction count of one BankedData run.
+func z80BankedDataInstrs(iters int) int {
+	return 2 + iters*(8+2*(2+256*5+1))
+}
+
+// buildZ80BankedCodeProgram calls two different routines that share the
+// address $6000, selecting bank 10 or 11 before each call.
+func buildZ80BankedCodeProgram(iters byte) ([]byte, uint16, []z80BankedImage) {
+	return []byte{
+			0x06, iters, // LD B, iters
+			0x21, 0x04, 0xF7, // LD HL, $F704
+			0x36, 0x0A, // loop: LD (HL), 10  ; bank3 = 10
+			0xCD, 0x00, 0x60, // CALL $6000
+			0x36, 0x0B, // LD (HL), 11  ; bank3 = 11
+			0xCD, 0x00, 0x60, // CALL $6000
+			0x10, 0xF4, // DJNZ loop
+			0x76, // HALT
+		}, 0x0100, []z80BankedImage{
+			{phys: 10 * Z80_BANK_WINDOW_SIZE, data: []byte{
+				0x0E, 0x10, // LD C, 16
+				0x3C,       // INC A
+				0x0D,       // DEC C
+				0x20, 0xFC, // JR NZ, -4
+				0xC9, // RET
+			}},
+			{phys: 11 * Z80_BANK_WINDOW_SIZE, data: []byte{
+				0x0E, 0x10, // LD C, 16
+				0xC6, 0x02, // ADD A, 2
+				0x0D,       // DEC C
+				0x20, 0xFB, // JR NZ, -5
+				0xC9, // RET
+			}},
+		}
+}
+
+// z80BankedCodeInstrs is the instruction count of one BankedCode run.
+func z80BankedCodeInstrs(iters int) int {
+	return 3 + iters*(5+2*(2+16*3))
+}
+
+func benchZ80BankedInterpreter(b *testing.B, prog []byte, startPC uint16, images []z80BankedImage, instrs int) {
+	cpu, bus, _ := setupZ80BenchInterp(prog, startPC)
+	loadZ80BankedImages(bus, images)
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		cpu.PC = startPC
+		cpu.SP = 0x1FFE
+		cpu.A, cpu.C = 0, 0
+		cpu.Halted = false
+		cpu.SetRunning(true)
+		for cpu.running.Load() && !cpu.Halted {
+			cpu.Step()
+		}
+		cpu.SetRunning(false)
+	}
+	b.ReportMetric(float64(instrs), "instrs/op")
+	ReportMIPSHostNormalized(b, instrs)
+}
+
+func benchZ80BankedJIT(b *testing.B, prog []byte, startPC uint16, images []z80BankedImage, instrs int) {
+	if !z80JitAvailable {
+		b.Skip("Z80 JIT not available on this platform")
+	}
+	cpu := setupZ80BenchJIT(b, prog, startPC, func(c *CPU_Z80) {
+		loadZ80BankedImages(c.bus.(*Z80BusAdapter).bus, images)
+		c.PC = startPC
+		c.SP = 0x1FFE
+		c.A, c.C = 0, 0
+		c.Halted = false
+		c.SetRunning(true)
+	})
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		cpu.PC = startPC
+		cpu.SP = 0x1FFE
+		cpu.A, cpu.C = 0, 0
+		cpu.Halted = false
+		cpu.SetRunning(true)
+		cpu.ExecuteJITZ80()
+	}
+	b.ReportMetric(float64(instrs), "instrs/op")
+	ReportMIPSHostNormalized(b, instrs)
+}
+
+func BenchmarkZ80_BankedData_Interpreter(b *testing.B) {
+	prog, startPC, images := buildZ80BankedDataProgram(4)
+	benchZ80BankedInterpreter(b, prog, startPC, images, z80BankedDataInstrs(4))
+}
+
+func BenchmarkZ80_BankedData_JIT(b *testing.B) {
+	prog, startPC, images := buildZ80BankedDataProgram(4)
+	benchZ80BankedJIT(b, prog, startPC, images, z80BankedDataInstrs(4))
+}
+
+func BenchmarkZ80_BankedCode_Interpreter(b *testing.B) {
+	prog, startPC, images := buildZ80BankedCodeProgram(0)
+	benchZ80BankedInterpreter(b, prog, startPC, images, z80BankedCodeInstrs(256))
+}
+
+func BenchmarkZ80_BankedCode_JIT(b *testing.B) {
+	prog, startPC, images := buildZ80BankedCodeProgram(0)
+	benchZ80BankedJIT(b, prog, startPC, images, z80BankedCodeInstrs(256))
+}